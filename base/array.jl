@@ -298,6 +298,24 @@ copyto!(dest::Memory, doffs::Integer, src::Array, soffs::Integer, n::Integer) =
 # this is only needed to avoid possible ambiguities with methods added in some packages
 copyto!(dest::Array{T}, doffs::Integer, src::Array{T}, soffs::Integer, n::Integer) where {T} = _copyto_impl!(dest, doffs, src, soffs, n)
 
+# widening/narrowing copies between Float16 and Float32 arrays go through the
+# bulk conversion entry points in the runtime, which use hardware converters
+# (F16C, ARMv8 fp16) when available instead of one scalar intrinsic call per
+# element; this also covers `Array{Float32}(::Array{Float16})` and `convert`,
+# which funnel through `copyto!`
+for (F, T, S) in ((:jl_half_to_float_bulk, Float32, Float16),
+                  (:jl_float_to_half_bulk, Float16, Float32))
+    @eval function copyto!(dest::Array{$T}, doffs::Integer, src::Array{$S}, soffs::Integer, n::Integer)
+        n == 0 && return dest
+        n > 0 || _throw_argerror("Number of elements to copy must be non-negative.")
+        @boundscheck checkbounds(dest, doffs:doffs+n-1)
+        @boundscheck checkbounds(src, soffs:soffs+n-1)
+        GC.@preserve dest src ccall($(QuoteNode(F)), Cvoid,
+            (Ptr{$S}, Ptr{$T}, Csize_t), pointer(src, soffs), pointer(dest, doffs), n)
+        return dest
+    end
+end
+
 function _copyto_impl!(dest::Union{Array,Memory}, doffs::Integer, src::Union{Array,Memory}, soffs::Integer, n::Integer)
     n == 0 && return dest
     n > 0 || _throw_argerror("Number of elements to copy must be non-negative.")
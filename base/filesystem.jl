@@ -232,6 +232,30 @@ function unsafe_read(f::File, p::Ptr{UInt8}, nel::UInt)
     nothing
 end
 
+# fill each buffer in `bufs` from its explicit file offset, submitting the
+# whole batch to the kernel at once where the OS supports it (io_uring on
+# Linux); returns the per-buffer byte counts
+function read_batch!(f::File, bufs::Vector{Vector{UInt8}}, offsets::Vector{Int64})
+    check_open(f)
+    n = length(bufs)
+    length(offsets) == n || throw(ArgumentError("need one offset per buffer"))
+    handles = fill(f.handle, n)
+    ptrs = Vector{Ptr{UInt8}}(undef, n)
+    lens = Vector{Csize_t}(undef, n)
+    for i = 1:n
+        ptrs[i] = pointer(bufs[i])
+        lens[i] = Csize_t(sizeof(bufs[i]))
+    end
+    results = Vector{Cssize_t}(undef, n)
+    GC.@preserve bufs ccall(:jl_fs_read_batch, Cvoid,
+        (Ptr{OS_HANDLE}, Ptr{Ptr{UInt8}}, Ptr{Csize_t}, Ptr{Int64}, Ptr{Cssize_t}, Cint),
+        handles, ptrs, lens, offsets, results, n)
+    for ret in results
+        uv_error("read", ret)
+    end
+    return results
+end
+
 bytesavailable(f::File) = max(0, filesize(f) - position(f)) # position can be > filesize
 
 eof(f::File) = bytesavailable(f) == 0
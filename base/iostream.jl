@@ -111,6 +111,22 @@ function truncate(s::IOStream, n::Integer)
     return s
 end
 
+"""
+    readahead(s::IOStream, bufsize::Integer)
+
+Put the stream into sequential-scan mode: grow its internal buffer to
+`bufsize` bytes and, where the operating system supports it, hint the kernel
+to read the file ahead of the stream position so the next chunk is already
+cached while the current one is processed. Useful before iterating the lines
+of a very large file. The stream must be backed by a readable file.
+"""
+function readahead(s::IOStream, bufsize::Integer)
+    bufsize > 0 || throw(ArgumentError("readahead buffer size must be positive"))
+    err = @_lock_ios s ccall(:ios_readahead, Cint, (Ptr{Cvoid}, Csize_t), s.ios, bufsize) != 0
+    err && throw(ArgumentError("stream is not backed by a readable file"))
+    return s
+end
+
 """
     seek(s, pos)
 
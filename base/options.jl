@@ -57,6 +57,8 @@ struct JLOptions
     strip_ir::Int8
     permalloc_pkgimg::Int8
     heap_size_hint::UInt64
+    small_function_threshold::UInt32
+    huge_function_threshold::UInt32
 end
 
 # This runs early in the sysimage != is not defined yet
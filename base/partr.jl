@@ -16,12 +16,34 @@ end
 
 # multiqueue minheap state
 const heap_d = UInt32(8)
+# tasks inserted per heap-lock acquisition by multiq_insert_batch; big enough
+# to amortize the locking, small enough to keep a burst spread over many heaps
+const batch_c = 32
 const heaps = [Vector{taskheap}(undef, 0), Vector{taskheap}(undef, 0)]
 const heaps_lock = [SpinLock(), SpinLock()]
 
 
 cong(max::UInt32) = iszero(max) ? UInt32(0) : ccall(:jl_rand_ptls, UInt32, (UInt32,), max) + UInt32(1)
 
+# When the default pool is partitioned by NUMA node (JULIA_NUMA), heap i
+# belongs to node (i - 1) % nnodes; threads of a node insert into and pop from
+# their own node's heaps first. Returns the node of the calling thread, or -1
+# when partitioning is off or the thread is not bound to a node.
+function numa_node(tp::Int)
+    tp == 2 || return Int8(-1) # only the default pool is partitioned
+    ccall(:jl_numa_node_count, Cint, ()) > 1 || return Int8(-1)
+    return ccall(:jl_threadnumanode, Int8, (Int16,), threadid() - 1)
+end
+
+# a random heap index drawn from the given node's heaps (all heaps if node
+# is -1); heap_p must cover at least one heap of every node
+function numa_cong(heap_p::UInt32, node::Int8)
+    node < Int8(0) && return cong(heap_p)
+    nnodes = UInt32(ccall(:jl_numa_node_count, Cint, ()))
+    heap_n = (heap_p - UInt32(node) + nnodes - UInt32(1)) ÷ nnodes
+    return UInt32(node) + UInt32(1) + nnodes * (cong(heap_n) - UInt32(1))
+end
+
 
 function multiq_sift_up(heap::taskheap, idx::Int32)
     while idx > Int32(1)
@@ -94,10 +116,13 @@ function multiq_insert(task::Task, priority::UInt16)
 
     task.priority = priority
 
-    rn = cong(heap_p)
+    # spawn onto the current thread's node's heaps so that same-node threads
+    # find the task first
+    node = numa_node(Int(tp))
+    rn = numa_cong(heap_p, node)
     tpheaps = heaps[tp]
     while !trylock(tpheaps[rn].lock)
-        rn = cong(heap_p)
+        rn = numa_cong(heap_p, node)
     end
 
     heap = tpheaps[rn]
@@ -119,6 +144,55 @@ function multiq_insert(task::Task, priority::UInt16)
 end
 
 
+# Insert a burst of tasks — all from the same threadpool, each carrying its
+# own priority — a chunk per lock acquisition instead of relocking for every
+# task. The caller is expected to issue one coalesced wakeup afterwards (see
+# enq_work_batch) rather than one per task.
+function multiq_insert_batch(tasks::Vector{Task})
+    isempty(tasks) && return true
+    tpid = ccall(:jl_get_task_threadpoolid, Int8, (Any,), tasks[1])
+    @assert tpid > -1
+    heap_p = multiq_size(tpid)
+    tp = tpid + 1
+    node = numa_node(Int(tp))
+    tpheaps = heaps[tp]
+
+    n = length(tasks)
+    i = 1
+    while i <= n
+        chunk = min(batch_c, n - i + 1)
+        rn = numa_cong(heap_p, node)
+        while !trylock(tpheaps[rn].lock)
+            rn = numa_cong(heap_p, node)
+        end
+        heap = tpheaps[rn]
+        ntasks = heap.ntasks
+        while Int(ntasks) + chunk > length(heap.tasks)
+            resize!(heap.tasks, length(heap.tasks) * 2)
+        end
+        minprio = heap.priority
+        for j = i:(i + chunk - 1)
+            task = tasks[j]
+            @assert ccall(:jl_get_task_threadpoolid, Int8, (Any,), task) == tpid
+            ntasks += Int32(1)
+            @atomic :monotonic heap.ntasks = ntasks
+            heap.tasks[ntasks] = task
+            multiq_sift_up(heap, ntasks)
+            if task.priority < minprio
+                minprio = task.priority
+            end
+        end
+        if minprio < heap.priority
+            @atomic :monotonic heap.priority = minprio
+        end
+        unlock(heap.lock)
+        i += chunk
+    end
+
+    return true
+end
+
+
 function multiq_deletemin()
     local rn1, rn2
     local prio1, prio2
@@ -129,31 +203,38 @@ function multiq_deletemin()
         return nothing
     end
     tpheaps = heaps[tp]
+    node = numa_node(Int(tp))
 
     @label retry
     GC.safepoint()
     heap_p = UInt32(length(tpheaps))
-    for i = UInt32(0):heap_p
-        if i == heap_p
-            return nothing
-        end
-        rn1 = cong(heap_p)
-        rn2 = cong(heap_p)
-        prio1 = tpheaps[rn1].priority
-        prio2 = tpheaps[rn2].priority
-        if prio1 > prio2
-            prio1 = prio2
-            rn1 = rn2
-        elseif prio1 == prio2 && prio1 == typemax(UInt16)
-            continue
-        end
-        if trylock(tpheaps[rn1].lock)
-            if prio1 == tpheaps[rn1].priority
-                break
+    found = false
+    # look at the current thread's node's heaps first; steal from other
+    # nodes' heaps only once the local ones all appear empty
+    for pass = (node >= Int8(0) ? 1 : 2):2
+        pnode = pass == 1 ? node : Int8(-1)
+        for i = UInt32(1):heap_p
+            rn1 = numa_cong(heap_p, pnode)
+            rn2 = numa_cong(heap_p, pnode)
+            prio1 = tpheaps[rn1].priority
+            prio2 = tpheaps[rn2].priority
+            if prio1 > prio2
+                prio1 = prio2
+                rn1 = rn2
+            elseif prio1 == prio2 && prio1 == typemax(UInt16)
+                continue
+            end
+            if trylock(tpheaps[rn1].lock)
+                if prio1 == tpheaps[rn1].priority
+                    found = true
+                    break
+                end
+                unlock(tpheaps[rn1].lock)
             end
-            unlock(tpheaps[rn1].lock)
         end
+        found && break
     end
+    found || return nothing
 
     heap = tpheaps[rn1]
     task = heap.tasks[1]
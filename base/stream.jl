@@ -1047,6 +1047,74 @@ uv_write(s::LibuvStream, p::Vector{UInt8}) = GC.@preserve p uv_write(s, pointer(
 # caller must have acquired the iolock
 function uv_write(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
     uvw = uv_write_async(s, p, n)
+    status = uv_write_wait(uvw)
+    if status < 0
+        throw(_UVError("write", status))
+    end
+    return Int(n)
+end
+
+# caller must have acquired the iolock; sends the already-buffered bytes in
+# `arr` and the payload at `p` as a single scatter-gather write, so the
+# payload is not copied into the send buffer first
+function uv_write(s::LibuvStream, arr::Vector{UInt8}, p::Ptr{UInt8}, n::UInt)
+    status = GC.@preserve arr begin
+        bases = Ptr{UInt8}[pointer(arr)]
+        lens = Csize_t[sizeof(arr)]
+        uv_write_chunks!(bases, lens, p, n)
+        uvw = uv_writev_async(s, bases, lens)
+        uv_write_wait(uvw)
+    end
+    if status < 0
+        throw(_UVError("write", status))
+    end
+    return Int(n)
+end
+
+# append a write, split into chunks the OS can handle, to a list of buffers
+function uv_write_chunks!(bases::Vector{Ptr{UInt8}}, lens::Vector{Csize_t}, p::Ptr{UInt8}, n::UInt)
+    while true
+        nwrite = min(n, MAX_OS_WRITE)
+        push!(bases, p)
+        push!(lens, Csize_t(nwrite))
+        n -= nwrite
+        p += nwrite
+        n == 0 && return nothing
+    end
+end
+
+# helper function for uv_write that returns the uv_write_t struct for the write
+# rather than waiting on it, caller must hold the iolock
+function uv_write_async(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
+    bases = Ptr{UInt8}[]
+    lens = Csize_t[]
+    uv_write_chunks!(bases, lens, p, n)
+    return uv_writev_async(s, bases, lens)
+end
+
+# submit all buffers as one scatter-gather request; the caller must keep the
+# memory behind every buffer rooted until the write callback has fired, and
+# must hold the iolock
+function uv_writev_async(s::LibuvStream, bases::Vector{Ptr{UInt8}}, lens::Vector{Csize_t})
+    check_open(s)
+    uvw = Libc.malloc(_sizeof_uv_write)
+    uv_req_set_data(uvw, C_NULL) # in case we get interrupted before arriving at the wait call
+    err = GC.@preserve bases lens ccall(:jl_uv_writev,
+                Int32,
+                (Ptr{Cvoid}, Ptr{Ptr{UInt8}}, Ptr{Csize_t}, Cint, Ptr{Cvoid}, Ptr{Cvoid}),
+                s, bases, lens, length(bases), uvw,
+                @cfunction(uv_writecb_task, Cvoid, (Ptr{Cvoid}, Cint)))
+    if err < 0
+        Libc.free(uvw)
+        uv_error("write", err)
+    end
+    return uvw
+end
+
+# wait for a write submitted with uv_write_async to complete (or error) and
+# release the request; caller must hold the iolock, which is dropped while
+# waiting
+function uv_write_wait(uvw::Ptr{Cvoid})
     ct = current_task()
     preserve_handle(ct)
     sigatomic_begin()
@@ -1054,9 +1122,7 @@ function uv_write(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
     iolock_end()
     status = try
         sigatomic_end()
-        # wait for the last chunk to complete (or error)
-        # assume that any errors would be sticky,
-        # (so we don't need to monitor the error status of the intermediate writes)
+        # wait for the write to complete (or error)
         wait()::Cint
     finally
         # try-finally unwinds the sigatomic level, so need to repeat sigatomic_end
@@ -1074,36 +1140,7 @@ function uv_write(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
         iolock_end()
         unpreserve_handle(ct)
     end
-    if status < 0
-        throw(_UVError("write", status))
-    end
-    return Int(n)
-end
-
-# helper function for uv_write that returns the uv_write_t struct for the write
-# rather than waiting on it, caller must hold the iolock
-function uv_write_async(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
-    check_open(s)
-    while true
-        uvw = Libc.malloc(_sizeof_uv_write)
-        uv_req_set_data(uvw, C_NULL) # in case we get interrupted before arriving at the wait call
-        nwrite = min(n, MAX_OS_WRITE) # split up the write into chunks the OS can handle.
-        # TODO: use writev instead of a loop
-        err = ccall(:jl_uv_write,
-                    Int32,
-                    (Ptr{Cvoid}, Ptr{Cvoid}, UInt, Ptr{Cvoid}, Ptr{Cvoid}),
-                    s, p, nwrite, uvw,
-                    @cfunction(uv_writecb_task, Cvoid, (Ptr{Cvoid}, Cint)))
-        if err < 0
-            Libc.free(uvw)
-            uv_error("write", err)
-        end
-        n -= nwrite
-        p += nwrite
-        if n == 0
-            return uvw
-        end
-    end
+    return status
 end
 
 
@@ -1124,8 +1161,13 @@ function unsafe_write(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
             return nb
         end
         bytesavailable(buf) == 0 && break
-        # perform flush(s)
         arr = take!(buf)
+        if n >= buf.maxsize
+            # the payload cannot be buffered either: send it and the buffered
+            # bytes together as a single scatter-gather write
+            return uv_write(s, arr, p, n)
+        end
+        # perform flush(s)
         uv_write(s, arr)
     end
     # perform the output to the kernel
@@ -1146,6 +1188,30 @@ function flush(s::LibuvStream)
     return
 end
 
+# kernel fast path for copying a disk file into a stream: move the bytes
+# fd-to-fd with sendfile instead of round-tripping them through userspace
+# buffers; anything the kernel copy cannot handle (unseekable source,
+# unsupported platform, trailing growth of the file) goes through the
+# generic byte-copy loop afterwards
+function write(to::LibuvStream, from::IOStream)
+    check_open(to)
+    flush(to) # the kernel copy must not overtake already-queued bytes
+    pos = ccall(:ios_pos, Int64, (Ptr{Cvoid},), from.ios)
+    sz = ccall(:ios_filesize, Int64, (Ptr{Cvoid},), from.ios)
+    total = Int64(0)
+    if pos != -1 && sz != -1
+        while pos + total < sz
+            ret = ccall(:jl_uv_sendfile_stream, Int64, (Ptr{Cvoid}, Cint, Int64, Int64),
+                        to.handle, fd(from), pos + total, sz - pos - total)
+            ret <= 0 && break # unsupported pair, error, or early end-of-file
+            total += ret
+        end
+        total > 0 && seek(from, pos + total)
+    end
+    # copy whatever remains the generic way
+    return Int(total) + invoke(write, Tuple{IO, IO}, to, from)
+end
+
 function buffer_writes(s::LibuvStream, bufsize)
     sendbuf = PipeBuffer(bufsize)
     iolock_begin()
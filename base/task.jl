@@ -814,7 +814,13 @@ function enq_work(t::Task)
             ccall(:jl_set_task_tid, Cint, (Any, Cint), t, tid-1)
             push!(workqueue_for(tid), t)
         else
-            # Otherwise, put the task in the multiqueue.
+            # Otherwise, try to keep the task in the current thread's LIFO
+            # slot, where the scheduler runs it next while its working set is
+            # still hot in cache; fall back to the multiqueue. A slotted task
+            # can only run on this thread, so there is no one to wake.
+            if ccall(:jl_try_lifo_spawn, Cint, (Any,), t) != 0
+                return t
+            end
             Partr.multiq_insert(t, t.priority)
             tid = 0
         end
@@ -823,6 +829,37 @@ function enq_work(t::Task)
     return t
 end
 
+# Bulk version of `enq_work` for spawn bursts: non-sticky tasks bound for the
+# multiqueue are inserted in batches and get a single coalesced wakeup of up
+# to `length(tasks)` sleeping threads, instead of one queue operation and one
+# wake-everyone signal per task. Anything else (sticky tasks, foreign or
+# single-thread pools) falls back to the scalar path.
+function enq_work_batch(tasks::Vector{Task})
+    mq = Task[]
+    mq_tpid = Int8(-1)
+    for t in tasks
+        if !t.sticky && t._state === task_state_runnable && t.queue === nothing
+            tp = Threads.threadpool(t)
+            if tp !== :foreign && Threads.threadpoolsize(tp) > 1
+                tpid = ccall(:jl_get_task_threadpoolid, Int8, (Any,), t)
+                if isempty(mq)
+                    mq_tpid = tpid
+                end
+                if tpid == mq_tpid
+                    push!(mq, t)
+                    continue
+                end
+            end
+        end
+        enq_work(t)
+    end
+    if !isempty(mq)
+        Partr.multiq_insert_batch(mq)
+        ccall(:jl_wakeup_threads, Cvoid, (Int16,), Int16(min(length(mq), Int(typemax(Int16)))))
+    end
+    return tasks
+end
+
 schedule(t::Task) = enq_work(t)
 
 """
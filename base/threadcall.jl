@@ -1,19 +1,45 @@
 # This file is a part of Julia. License is MIT: https://julialang.org/license
 
-const max_ccall_threads = parse(Int, get(ENV, "UV_THREADPOOL_SIZE", "4"))
+# must match WORK_POOL_MAX in jl_uv.c, the hard cap on the runtime's worker pool
+const max_ccall_threads = 128
 const thread_notifiers = Union{Event, Nothing}[nothing for i in 1:max_ccall_threads]
 const threadcall_restrictor = Semaphore(max_ccall_threads)
 const threadcall_lock = Threads.SpinLock()
 
+"""
+    ccall_threadpool_size() -> Int
+
+Return the current number of threads in the worker pool that services
+[`@threadcall`](@ref). The pool grows on demand while calls are queued and
+shrinks back toward its configured floor as workers go idle; see
+[`ccall_threadpool_resize!`](@ref).
+"""
+ccall_threadpool_size() = Int(ccall(:jl_work_pool_size, Cint, ()))
+
+"""
+    ccall_threadpool_resize!(n::Integer) -> Int
+
+Set the floor of the [`@threadcall`](@ref) worker pool to `n` threads,
+starting workers immediately when growing. The pool still expands past the
+floor on demand, up to $max_ccall_threads threads, and excess workers exit
+again once idle. The initial floor is taken from the `UV_THREADPOOL_SIZE`
+environment variable (default 4).
+"""
+function ccall_threadpool_resize!(n::Integer)
+    1 <= n <= max_ccall_threads ||
+        throw(ArgumentError("pool size must be between 1 and $max_ccall_threads"))
+    return Int(ccall(:jl_work_pool_resize, Cint, (Cint,), n))
+end
+
 """
     @threadcall((cfunc, clib), rettype, (argtypes...), argvals...)
 
 The `@threadcall` macro is called in the same way as [`ccall`](@ref) but does the work
 in a different thread. This is useful when you want to call a blocking C
-function without causing the current `julia` thread to become blocked. Concurrency
-is limited by size of the libuv thread pool, which defaults to 4 threads but
-can be increased by setting the `UV_THREADPOOL_SIZE` environment variable and
-restarting the `julia` process.
+function without causing the current `julia` thread to become blocked. The
+worker pool starts at 4 threads (or `UV_THREADPOOL_SIZE`, when set) and grows
+on demand; its floor can be changed at runtime with
+[`Base.ccall_threadpool_resize!`](@ref).
 
 Note that the called function should never call back into Julia.
 """
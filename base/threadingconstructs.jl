@@ -160,8 +160,8 @@ function threading_run(fun, static)
             @assert ccall(:jl_set_task_threadpoolid, Cint, (Any, Int8), t, _sym_to_tpid(:default)) == 1
         end
         tasks[i] = t
-        schedule(t)
     end
+    Base.enq_work_batch(tasks)
     for i = 1:n
         Base._wait(tasks[i])
     end
@@ -181,6 +181,8 @@ function julia_cmd(julia=joinpath(Sys.BINDIR, julia_exename()); cpu_target::Unio
                       "all"
                   elseif opts.compile_enabled == 3
                       "min"
+                  elseif opts.compile_enabled == 4
+                      "tiered"
                   else
                       "" # default = "yes"
                   end
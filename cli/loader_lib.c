@@ -18,6 +18,8 @@ extern "C" {
 static int win_file_exists(wchar_t* wpath) {
   return GetFileAttributesW(wpath) == INVALID_FILE_ATTRIBUTES ? 0 : 1;
 }
+#else
+#include <pthread.h>
 #endif
 
 // Save DEP_LIBS to a variable that is explicitly sized for expansion
@@ -353,6 +355,106 @@ static char *libstdcxxprobe(void)
 }
 #endif
 
+// Load a run of dependency libraries concurrently. The entries between two
+// special (`@`-prefixed) libraries have no load-order constraints among
+// themselves -- any cross-dependencies are resolved by the dynamic linker
+// through each library's rpath -- so they can be dlopened from worker
+// threads. dlopen()/LoadLibrary() are thread-safe, and load_library()
+// panics on failure, so no results need to be reported back.
+#define MAX_PARALLEL_DEP_THREADS 64
+#define DEFAULT_PARALLEL_DEP_THREADS 8
+
+// How many threads to load a run with, overridable with
+// JULIA_LOADER_THREADS (more can pay off on high-latency network
+// filesystems; 1 loads serially).
+static int dep_thread_count(void)
+{
+    static int nthreads = 0;
+    if (nthreads == 0) {
+        nthreads = DEFAULT_PARALLEL_DEP_THREADS;
+        char *env = getenv("JULIA_LOADER_THREADS");
+        if (env && *env) {
+            nthreads = atoi(env);
+            if (nthreads < 1)
+                nthreads = 1;
+            else if (nthreads > MAX_PARALLEL_DEP_THREADS)
+                nthreads = MAX_PARALLEL_DEP_THREADS;
+        }
+    }
+    return nthreads;
+}
+
+typedef struct {
+    const char **deps;
+    int ndeps;
+    int nthreads;
+    int tid;
+    const char *lib_dir;
+} dep_batch_t;
+
+#ifdef _OS_WINDOWS_
+static DWORD WINAPI load_dep_batch(LPVOID arg)
+#else
+static void *load_dep_batch(void *arg)
+#endif
+{
+    dep_batch_t *batch = (dep_batch_t *)arg;
+    for (int i = batch->tid; i < batch->ndeps; i += batch->nthreads)
+        load_library(batch->deps[i], batch->lib_dir, 1);
+    return 0;
+}
+
+static void load_libraries_parallel(const char **deps, int ndeps, const char *lib_dir)
+{
+    if (ndeps == 1) {
+        load_library(deps[0], lib_dir, 1);
+        return;
+    }
+    if (ndeps == 0)
+        return;
+    int nthreads = dep_thread_count();
+    if (nthreads > ndeps)
+        nthreads = ndeps;
+    dep_batch_t batch[MAX_PARALLEL_DEP_THREADS];
+#ifdef _OS_WINDOWS_
+    HANDLE thread[MAX_PARALLEL_DEP_THREADS];
+#else
+    pthread_t thread[MAX_PARALLEL_DEP_THREADS];
+#endif
+    for (int t = 0; t < nthreads; t++) {
+        batch[t].deps = deps;
+        batch[t].ndeps = ndeps;
+        batch[t].nthreads = nthreads;
+        batch[t].tid = t;
+        batch[t].lib_dir = lib_dir;
+    }
+    // this thread takes slice 0; workers take the rest
+    int started = 1;
+    for (int t = 1; t < nthreads; t++) {
+#ifdef _OS_WINDOWS_
+        thread[t] = CreateThread(NULL, 0, load_dep_batch, &batch[t], 0, NULL);
+        if (thread[t] == NULL)
+            break;
+#else
+        if (pthread_create(&thread[t], NULL, load_dep_batch, &batch[t]) != 0)
+            break;
+#endif
+        started++;
+    }
+    // load any slices whose threads could not be started on this thread too
+    for (int t = started; t < nthreads; t++)
+        load_dep_batch(&batch[t]);
+    load_dep_batch(&batch[0]);
+    for (int t = 1; t < started; t++) {
+#ifdef _OS_WINDOWS_
+        WaitForSingleObject(thread[t], INFINITE);
+        CloseHandle(thread[t]);
+#else
+        pthread_join(thread[t], NULL);
+#endif
+    }
+}
+
 void *libjulia_internal = NULL;
 void *libjulia_codegen = NULL;
 __attribute__((constructor)) void jl_load_libjulia_internal(void) {
@@ -416,6 +518,11 @@ __attribute__((constructor)) void jl_load_libjulia_internal(void) {
     // If it's a special library, we do slightly different things, especially
     // for libstdc++, where we actually probe for a system libstdc++ and
     // load that if it's newer.
+    // Runs of consecutive non-special libraries are independent of each
+    // other, so they are collected and loaded concurrently; the special
+    // libraries act as ordering barriers between runs.
+    const char *batched_deps[sizeof(dep_libs) / 2];
+    int n_batched = 0;
     special_idx = 0;
     curr_dep = &dep_libs[1];
     while (1) {
@@ -430,6 +537,10 @@ __attribute__((constructor)) void jl_load_libjulia_internal(void) {
         // If this library name starts with `@`, it's a special library
         // and requires special handling:
         if (curr_dep[0] == '@') {
+            // load the preceding run of ordinary libraries first
+            load_libraries_parallel(batched_deps, n_batched, lib_dir);
+            n_batched = 0;
+
             // Skip the `@` for future function calls.
             curr_dep += 1;
 
@@ -477,13 +588,15 @@ __attribute__((constructor)) void jl_load_libjulia_internal(void) {
             }
             special_idx++;
         } else {
-            // Otherwise, just load it as "normal"
-            load_library(curr_dep, lib_dir, 1);
+            // Otherwise, queue it up to be loaded with its neighbors
+            batched_deps[n_batched++] = curr_dep;
         }
 
         // Skip ahead to next dependency
         curr_dep = colon + 1;
     }
+    // load any trailing run of ordinary libraries
+    load_libraries_parallel(batched_deps, n_batched, lib_dir);
 
     const char * const * codegen_func_names;
     const char *codegen_liberr;
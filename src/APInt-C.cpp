@@ -44,8 +44,79 @@ const unsigned int host_char_bit = 8;
     else \
         memcpy(p##r, a.getRawData(), alignTo(numbits, host_char_bit) / host_char_bit); \
 
+/* Fixed-width fast paths: once a value needs more than one 64-bit word, the
+ * APInt round-trip above heap-allocates, which dominates the cost of these
+ * helpers for the common 65-128 bit (Int128/UInt128) operations. When the
+ * compiler provides __int128 we do all work at numbits <= 128 directly on it
+ * (lowered to add-with-carry/mul chains), falling back to APInt only beyond.
+ * Operands are masked to numbits on load and results stored with the unused
+ * high bits cleared, matching CREATE/ASSIGN. */
+#if defined(_P64) && defined(__SIZEOF_INT128__)
+#define APINT_FAST128 1
+typedef __uint128_t fastint_t;
+typedef __int128_t sfastint_t;
+
+static inline fastint_t fast_mask(unsigned numbits) {
+    return numbits == 128 ? ~(fastint_t)0 : (((fastint_t)1 << numbits) - 1);
+}
+
+static inline fastint_t fast_load(unsigned numbits, const integerPart *p) {
+    fastint_t a = 0;
+    /* TODO: this memcpy assumes little-endian (as does CREATE above) */
+    memcpy(&a, p, alignTo(numbits, host_char_bit) / host_char_bit);
+    return a & fast_mask(numbits);
+}
+
+static inline sfastint_t fast_sload(unsigned numbits, const integerPart *p) {
+    fastint_t a = fast_load(numbits, p);
+    if (numbits < 128 && (a >> (numbits - 1)))
+        a |= ~fast_mask(numbits);
+    return (sfastint_t)a;
+}
+
+static inline void fast_store(unsigned numbits, integerPart *pr, fastint_t r) {
+    r &= fast_mask(numbits);
+    if (numbits <= 8)
+        *(uint8_t*)pr = (uint8_t)r;
+    else if (numbits <= 16)
+        *(uint16_t*)pr = (uint16_t)r;
+    else if (numbits <= 32)
+        *(uint32_t*)pr = (uint32_t)r;
+    else if (numbits <= 64)
+        *(uint64_t*)pr = (uint64_t)r;
+    else
+        memcpy(pr, &r, alignTo(numbits, host_char_bit) / host_char_bit);
+}
+
+#define FAST_OP1(expr) \
+    if (numbits <= 128) { \
+        fastint_t ua = fast_load(numbits, pa); \
+        fast_store(numbits, pr, (expr)); \
+        return; \
+    }
+#define FAST_OP2(expr) \
+    if (numbits <= 128) { \
+        fastint_t ua = fast_load(numbits, pa); \
+        fastint_t ub = fast_load(numbits, pb); \
+        fast_store(numbits, pr, (expr)); \
+        return; \
+    }
+#define FAST_UCMP(op) \
+    if (numbits <= 128) \
+        return fast_load(numbits, pa) op fast_load(numbits, pb);
+#define FAST_SCMP(op) \
+    if (numbits <= 128) \
+        return fast_sload(numbits, pa) op fast_sload(numbits, pb);
+#else
+#define FAST_OP1(expr)
+#define FAST_OP2(expr)
+#define FAST_UCMP(op)
+#define FAST_SCMP(op)
+#endif
+
 extern "C" JL_DLLEXPORT
 void LLVMNeg(unsigned numbits, integerPart *pa, integerPart *pr) {
+    FAST_OP1((fastint_t)0 - ua)
     APInt z(numbits, 0);
     CREATE(a)
     z -= a;
@@ -54,6 +125,7 @@ void LLVMNeg(unsigned numbits, integerPart *pa, integerPart *pr) {
 
 extern "C" JL_DLLEXPORT
 void LLVMAdd(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua + ub)
     CREATE(a)
     CREATE(b)
     a += b;
@@ -62,6 +134,7 @@ void LLVMAdd(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr
 
 extern "C" JL_DLLEXPORT
 void LLVMSub(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua - ub)
     CREATE(a)
     CREATE(b)
     a -= b;
@@ -70,6 +143,7 @@ void LLVMSub(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr
 
 extern "C" JL_DLLEXPORT
 void LLVMMul(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua * ub)
     CREATE(a)
     CREATE(b)
     a *= b;
@@ -102,6 +176,7 @@ void LLVMURem(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *p
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpEQ(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_UCMP(==)
     CREATE(a)
     CREATE(b)
     return a.eq(b);
@@ -109,6 +184,7 @@ int LLVMICmpEQ(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpNE(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_UCMP(!=)
     CREATE(a)
     CREATE(b)
     return a.ne(b);
@@ -116,6 +192,7 @@ int LLVMICmpNE(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpSLT(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_SCMP(<)
     CREATE(a)
     CREATE(b)
     return a.slt(b);
@@ -123,6 +200,7 @@ int LLVMICmpSLT(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpULT(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_UCMP(<)
     CREATE(a)
     CREATE(b)
     return a.ult(b);
@@ -130,6 +208,7 @@ int LLVMICmpULT(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpSLE(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_SCMP(<=)
     CREATE(a)
     CREATE(b)
     return a.sle(b);
@@ -137,6 +216,7 @@ int LLVMICmpSLE(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 int LLVMICmpULE(unsigned numbits, integerPart *pa, integerPart *pb) {
+    FAST_UCMP(<=)
     CREATE(a)
     CREATE(b)
     return a.ule(b);
@@ -144,6 +224,7 @@ int LLVMICmpULE(unsigned numbits, integerPart *pa, integerPart *pb) {
 
 extern "C" JL_DLLEXPORT
 void LLVMAnd(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua & ub)
     CREATE(a)
     CREATE(b)
     a &= b;
@@ -152,6 +233,7 @@ void LLVMAnd(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr
 
 extern "C" JL_DLLEXPORT
 void LLVMOr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua | ub)
     CREATE(a)
     CREATE(b)
     a |= b;
@@ -160,6 +242,7 @@ void LLVMOr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr)
 
 extern "C" JL_DLLEXPORT
 void LLVMXor(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+    FAST_OP2(ua ^ ub)
     CREATE(a)
     CREATE(b)
     a ^= b;
@@ -168,6 +251,14 @@ void LLVMXor(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr
 
 extern "C" JL_DLLEXPORT
 void LLVMShl(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fast_store(numbits, pr, ub < numbits ? ua << (unsigned)ub : 0);
+        return;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     a = a.shl(b);
@@ -176,6 +267,14 @@ void LLVMShl(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr
 
 extern "C" JL_DLLEXPORT
 void LLVMLShr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fast_store(numbits, pr, ub < numbits ? ua >> (unsigned)ub : 0);
+        return;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     a = a.lshr(b);
@@ -183,6 +282,15 @@ void LLVMLShr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *p
 }
 extern "C" JL_DLLEXPORT
 void LLVMAShr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        sfastint_t sa = fast_sload(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fast_store(numbits, pr, ub < numbits ? (fastint_t)(sa >> (unsigned)ub) :
+                                               (sa < 0 ? ~(fastint_t)0 : 0));
+        return;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     a = a.ashr(b);
@@ -191,6 +299,7 @@ void LLVMAShr(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *p
 
 extern "C" JL_DLLEXPORT
 void LLVMFlipAllBits(unsigned numbits, integerPart *pa, integerPart *pr) {
+    FAST_OP1(~ua)
     CREATE(a)
     a.flipAllBits();
     ASSIGN(r, a)
@@ -198,6 +307,15 @@ void LLVMFlipAllBits(unsigned numbits, integerPart *pa, integerPart *pr) {
 
 extern "C" JL_DLLEXPORT
 int LLVMAdd_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fastint_t r = (ua + ub) & fast_mask(numbits);
+        fast_store(numbits, pr, r);
+        return r < ua;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -208,6 +326,16 @@ int LLVMAdd_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMAdd_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fastint_t r = (ua + ub) & fast_mask(numbits);
+        fastint_t signbit = (fastint_t)1 << (numbits - 1);
+        fast_store(numbits, pr, r);
+        return !((ua ^ ub) & signbit) && ((r ^ ua) & signbit) != 0;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -218,6 +346,14 @@ int LLVMAdd_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMSub_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fast_store(numbits, pr, ua - ub);
+        return ub > ua;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -228,6 +364,16 @@ int LLVMSub_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMSub_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fastint_t r = (ua - ub) & fast_mask(numbits);
+        fastint_t signbit = (fastint_t)1 << (numbits - 1);
+        fast_store(numbits, pr, r);
+        return ((ua ^ ub) & signbit) != 0 && ((r ^ ua) & signbit) != 0;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -238,6 +384,23 @@ int LLVMSub_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMMul_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        sfastint_t sa = fast_sload(numbits, pa);
+        sfastint_t sb = fast_sload(numbits, pb);
+        /* work on magnitudes with the unsigned builtin: the signed 128-bit
+         * __builtin_mul_overflow can lower to a compiler-rt libcall */
+        fastint_t au = sa < 0 ? (fastint_t)0 - (fastint_t)sa : (fastint_t)sa;
+        fastint_t bu = sb < 0 ? (fastint_t)0 - (fastint_t)sb : (fastint_t)sb;
+        fastint_t p;
+        bool ov = __builtin_mul_overflow(au, bu, &p);
+        int negative = (sa < 0) != (sb < 0);
+        fastint_t limit = ((fastint_t)1 << (numbits - 1)) - (negative ? 0 : 1);
+        ov |= p > limit;
+        fast_store(numbits, pr, negative ? (fastint_t)0 - p : p);
+        return ov;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -248,6 +411,17 @@ int LLVMMul_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMMul_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        fastint_t p;
+        bool ov = __builtin_mul_overflow(ua, ub, &p);
+        ov |= (p & ~fast_mask(numbits)) != 0;
+        fast_store(numbits, pr, p);
+        return ov;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     bool Overflow;
@@ -258,6 +432,22 @@ int LLVMMul_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMDiv_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        sfastint_t sa = fast_sload(numbits, pa);
+        sfastint_t sb = fast_sload(numbits, pb);
+        if (sb == 0)
+            return true;
+        fastint_t smin = (fastint_t)1 << (numbits - 1);
+        if (sb == -1 && (fastint_t)sa == (fastint_t)0 - smin) {
+            /* typemin(IntN) / -1 wraps back to typemin, as sdiv_ov does */
+            fast_store(numbits, pr, smin);
+            return true;
+        }
+        fast_store(numbits, pr, (fastint_t)(sa / sb));
+        return false;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     if (!b)
@@ -270,6 +460,16 @@ int LLVMDiv_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMDiv_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        if (ub == 0)
+            return true;
+        fast_store(numbits, pr, ua / ub);
+        return false;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     if (!b)
@@ -281,6 +481,17 @@ int LLVMDiv_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMRem_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        sfastint_t sa = fast_sload(numbits, pa);
+        sfastint_t sb = fast_sload(numbits, pb);
+        if (sb == 0)
+            return true;
+        /* typemin % -1 is 0, but the native % would trap on the division */
+        fast_store(numbits, pr, sb == -1 ? 0 : (fastint_t)(sa % sb));
+        return false;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     if (!b)
@@ -292,6 +503,16 @@ int LLVMRem_sov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 int LLVMRem_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        fastint_t ub = fast_load(numbits, pb);
+        if (ub == 0)
+            return true;
+        fast_store(numbits, pr, ua % ub);
+        return false;
+    }
+#endif
     CREATE(a)
     CREATE(b)
     if (!b)
@@ -303,6 +524,17 @@ int LLVMRem_uov(unsigned numbits, integerPart *pa, integerPart *pb, integerPart
 
 extern "C" JL_DLLEXPORT
 void LLVMByteSwap(unsigned numbits, integerPart *pa, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128 && (numbits % host_char_bit) == 0) {
+        unsigned nbytes = numbits / host_char_bit;
+        fastint_t r = 0;
+        /* TODO: this byte order assumes little-endian (as does fast_load) */
+        for (unsigned i = 0; i < nbytes; i++)
+            ((unsigned char*)&r)[i] = ((const unsigned char*)pa)[nbytes - 1 - i];
+        fast_store(numbits, pr, r);
+        return;
+    }
+#endif
     CREATE(a)
     a = a.byteSwap();
     ASSIGN(r, a)
@@ -392,8 +624,16 @@ void LLVMSItoFP(jl_datatype_t *ty, integerPart *pa, jl_datatype_t *oty, integerP
     { // end scope before jl_error call
         unsigned numbytes = jl_datatype_size(ty);
         unsigned numbits = numbytes * host_char_bit;
-        CREATE(a)
-        val = a.roundToDouble(true);
+#ifdef APINT_FAST128
+        if (numbits <= 128) {
+            val = (double)fast_sload(numbits, pa);
+        }
+        else
+#endif
+        {
+            CREATE(a)
+            val = a.roundToDouble(true);
+        }
     }
     if (oty == jl_float16_type)
         *(uint16_t*)pr = julia_float_to_half(val);
@@ -413,8 +653,16 @@ void LLVMUItoFP(jl_datatype_t *ty, integerPart *pa, jl_datatype_t *oty, integerP
     { // end scope before jl_error call
         unsigned numbytes = jl_datatype_size(ty);
         unsigned numbits = numbytes * host_char_bit;
-        CREATE(a)
-        val = a.roundToDouble(false);
+#ifdef APINT_FAST128
+        if (numbits <= 128) {
+            val = (double)fast_load(numbits, pa);
+        }
+        else
+#endif
+        {
+            CREATE(a)
+            val = a.roundToDouble(false);
+        }
     }
     if (oty == jl_float16_type)
         *(uint16_t*)pr = julia_float_to_half(val);
@@ -497,6 +745,19 @@ unsigned countTrailingZeros_64(uint64_t Val) {
 
 extern "C" JL_DLLEXPORT
 void jl_LLVMSMod(unsigned numbits, integerPart *pa, integerPart *pb, integerPart *pr) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        sfastint_t sa = fast_sload(numbits, pa);
+        sfastint_t sb = fast_sload(numbits, pb);
+        if (sb == 0)
+            jl_throw(jl_diverror_exception);
+        sfastint_t r = (sb == -1 || sb == 1) ? 0 : sa % sb;
+        if (r != 0 && (r < 0) != (sb < 0))
+            r += sb;
+        fast_store(numbits, pr, (fastint_t)r);
+        return;
+    }
+#endif
     { // end scope before jl_error call
         CREATE(a)
         CREATE(b)
@@ -525,30 +786,74 @@ void jl_LLVMFlipSign(unsigned numbits, integerPart *pa, integerPart *pb, integer
 
 extern "C" JL_DLLEXPORT
 unsigned LLVMCountPopulation(unsigned numbits, integerPart *pa) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        return __builtin_popcountll((uint64_t)ua) + __builtin_popcountll((uint64_t)(ua >> 64));
+    }
+#endif
     CREATE(a)
     return a.countPopulation();
 }
 
 extern "C" JL_DLLEXPORT
 unsigned LLVMCountTrailingOnes(unsigned numbits, integerPart *pa) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t v = ~fast_load(numbits, pa) & fast_mask(numbits);
+        if (v == 0)
+            return numbits;
+        uint64_t lo = (uint64_t)v;
+        return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((uint64_t)(v >> 64));
+    }
+#endif
     CREATE(a)
     return a.countTrailingOnes();
 }
 
 extern "C" JL_DLLEXPORT
 unsigned LLVMCountTrailingZeros(unsigned numbits, integerPart *pa) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        if (ua == 0)
+            return numbits;
+        uint64_t lo = (uint64_t)ua;
+        return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((uint64_t)(ua >> 64));
+    }
+#endif
     CREATE(a)
     return a.countTrailingZeros();
 }
 
 extern "C" JL_DLLEXPORT
 unsigned LLVMCountLeadingOnes(unsigned numbits, integerPart *pa) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t v = ~fast_load(numbits, pa) & fast_mask(numbits);
+        if (v == 0)
+            return numbits;
+        uint64_t hi = (uint64_t)(v >> 64);
+        unsigned msb = hi ? 127 - __builtin_clzll(hi) : 63 - __builtin_clzll((uint64_t)v);
+        return numbits - 1 - msb;
+    }
+#endif
     CREATE(a)
     return a.countLeadingOnes();
 }
 
 extern "C" JL_DLLEXPORT
 unsigned LLVMCountLeadingZeros(unsigned numbits, integerPart *pa) {
+#ifdef APINT_FAST128
+    if (numbits <= 128) {
+        fastint_t ua = fast_load(numbits, pa);
+        if (ua == 0)
+            return numbits;
+        uint64_t hi = (uint64_t)(ua >> 64);
+        unsigned msb = hi ? 127 - __builtin_clzll(hi) : 63 - __builtin_clzll((uint64_t)ua);
+        return numbits - 1 - msb;
+    }
+#endif
     CREATE(a)
     return a.countLeadingZeros();
 }
@@ -28,6 +28,7 @@
 #include <llvm/Transforms/Instrumentation/ThreadSanitizer.h>
 #include <llvm/Transforms/Scalar/GVN.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/MergeFunctions.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar/InstSimplifyPass.h>
 #include <llvm/Transforms/Scalar/SimpleLoopUnswitch.h>
@@ -256,6 +257,46 @@ static void jl_ci_cache_lookup(const jl_cgparams_t &cgparams, jl_method_instance
     *ci_out = codeinst;
 }
 
+extern "C" void lambda_trampoline(void *arg);
+
+// results handed back by one emission shard of jl_create_native: the shard's
+// modules arrive merged and serialized to bitcode (they were built in the
+// shard's own LLVMContext), and the pointer-valued bookkeeping is recorded by
+// name so it can be rebound after the bitcode is parsed into the toplevel
+// context
+struct jl_emission_shard_t {
+    SmallVector<std::pair<jl_code_instance_t*, jl_llvm_functions_t>, 0> decls;
+    SmallVector<std::pair<void*, std::string>, 0> gvars;
+    SmallVector<std::tuple<jl_code_instance_t*, bool, std::string>, 0> external_fns;
+    SmallVector<char, 0> bitcode;
+};
+
+// how many threads to run codegen on in jl_create_native; honors the same
+// JULIA_IMAGE_THREADS override as the optimization pipeline
+static unsigned compute_emission_thread_count(size_t nitems)
+{
+    // per-item emission is fairly coarse work already; short worklists are
+    // not worth the extra contexts and the serialization round-trip. When
+    // generating output the traced worklist is the bulk of the whole job and
+    // latency is irrelevant, so fan out much earlier and in smaller chunks.
+    size_t serial_limit = jl_generating_output() ? 128 : 1024;
+    size_t min_chunk = jl_generating_output() ? 32 : 256;
+    if (nitems < serial_limit)
+        return 1;
+    unsigned threads = std::max(jl_cpu_threads() / 2, 1);
+    const char *env_threads = getenv("JULIA_IMAGE_THREADS");
+    if (env_threads) {
+        char *endptr;
+        unsigned long requested = strtoul(env_threads, &endptr, 10);
+        if (!*endptr && requested)
+            threads = requested;
+    }
+    unsigned max_threads = nitems / min_chunk;
+    if (threads > max_threads)
+        threads = max_threads;
+    return std::max(threads, 1u);
+}
+
 // takes the running content that has collected in the shadow module and dump it to disk
 // this builds the object file portion of the sysimage files for fast startup, and can
 // also be used be extern consumers like GPUCompiler.jl to obtain a module containing
@@ -276,7 +317,9 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
     bool imaging = imaging_default() || _imaging_mode == 1;
     jl_method_instance_t *mi = NULL;
     jl_code_info_t *src = NULL;
-    JL_GC_PUSH1(&src);
+    jl_array_t *roots = NULL;
+    JL_GC_PUSH2(&src, &roots);
+    roots = jl_alloc_vec_any(0);
     auto ct = jl_current_task;
     bool timed = (ct->reentrant_timing & 1) == 0;
     if (timed)
@@ -306,6 +349,13 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
     params.imaging_mode = imaging;
     params.debug_level = cgparams->debug_info_level;
     params.external_linkage = _external_linkage;
+    jl_aot_shared_emission_t shared_emission;
+    params.shared_emission = &shared_emission;
+    // globals and external function slots emitted by shards for an address
+    // that the toplevel params already track under a different name; they
+    // still need initializers and image slots of their own
+    SmallVector<std::pair<void*, GlobalVariable*>, 0> extra_gvars;
+    SmallVector<std::tuple<jl_code_instance_t*, bool, GlobalVariable*>, 0> extra_external_fns;
     size_t compile_for[] = { jl_typeinf_world, _world };
     for (int worlds = 0; worlds < 2; worlds++) {
         JL_TIMING(NATIVE_AOT, NATIVE_Codegen);
@@ -315,6 +365,10 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
         // Don't emit methods for the typeinf_world with extern policy
         if (policy != CompilationPolicy::Default && params.world == jl_typeinf_world)
             continue;
+        // first walk the methods list and prepare the sources, so that the
+        // expensive emission below runs from a fixed worklist that can be
+        // sharded across threads
+        SmallVector<std::pair<jl_code_instance_t*, jl_code_info_t*>, 0> emission_order;
         size_t i, l;
         for (i = 0, l = jl_array_nrows(methods); i < l; i++) {
             // each item in this list is either a MethodInstance indicating something
@@ -334,28 +388,171 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
                 // find and prepare the source code to compile
                 jl_code_instance_t *codeinst = NULL;
                 jl_ci_cache_lookup(*cgparams, mi, params.world, &codeinst, &src);
-                if (src && !params.compiled_functions.count(codeinst)) {
-                    // now add it to our compilation results
-                    JL_GC_PROMISE_ROOTED(codeinst->rettype);
-                    orc::ThreadSafeModule result_m = jl_create_ts_module(name_from_method_instance(codeinst->def),
-                            params.tsctx, clone.getModuleUnlocked()->getDataLayout(),
-                            Triple(clone.getModuleUnlocked()->getTargetTriple()));
-                    jl_llvm_functions_t decls = jl_emit_code(result_m, mi, src, codeinst->rettype, params);
-                    if (result_m)
-                        params.compiled_functions[codeinst] = {std::move(result_m), std::move(decls)};
+                if (src && !params.compiled_functions.count(codeinst) &&
+                    !shared_emission.decls.count(codeinst)) {
+                    jl_array_ptr_1d_push(roots, (jl_value_t*)codeinst);
+                    jl_array_ptr_1d_push(roots, (jl_value_t*)src);
+                    // mark it in-flight now so no shard emits it as a callee
+                    // of some other method before its turn comes
+                    shared_emission.inflight.insert(codeinst);
+                    emission_order.push_back(std::make_pair(codeinst, src));
+                }
+            }
+        }
+
+        unsigned ethreads = compute_emission_thread_count(emission_order.size());
+        if (ethreads <= 1) {
+            // single-threaded: emit in place with the toplevel params
+            for (auto &job : emission_order) {
+                jl_code_instance_t *codeinst = job.first;
+                // now add it to our compilation results
+                JL_GC_PROMISE_ROOTED(codeinst->rettype);
+                orc::ThreadSafeModule result_m = jl_create_ts_module(name_from_method_instance(codeinst->def),
+                        params.tsctx, clone.getModuleUnlocked()->getDataLayout(),
+                        Triple(clone.getModuleUnlocked()->getTargetTriple()));
+                jl_llvm_functions_t decls = jl_emit_code(result_m, codeinst->def, job.second, codeinst->rettype, params);
+                shared_emission.inflight.erase(codeinst);
+                if (result_m) {
+                    shared_emission.decls[codeinst] = decls;
+                    params.compiled_functions[codeinst] = {std::move(result_m), std::move(decls)};
+                }
+            }
+        }
+        else {
+            // shard the worklist across worker threads, each with its own
+            // LLVMContext and params; the workers enter the runtime as
+            // adopted foreign threads, and this thread parks itself in a
+            // GC-safe state so they can allocate and hit safepoints freely
+            std::vector<uv_thread_t> workers(ethreads);
+            std::vector<jl_emission_shard_t> shards(ethreads);
+            // the workers may re-enter the runtime's compilation paths (for
+            // example through type inference of a callee), and those take the
+            // codegen lock themselves, so it cannot stay held here while they
+            // run
+            JL_UNLOCK(&jl_codegen_lock);
+            for (unsigned t = 0; t < ethreads; t++) {
+                std::function<void()> work = [&, t]() {
+                    jl_adopt_thread();
+                    jl_emission_shard_t &shard = shards[t];
+                    auto ctx = jl_ExecutionEngine->acquireContext();
+                    {
+                        jl_codegen_params_t wparams(ctx, params.DL, params.TargetTriple);
+                        wparams.params = cgparams;
+                        wparams.imaging_mode = imaging;
+                        wparams.debug_level = cgparams->debug_info_level;
+                        wparams.external_linkage = _external_linkage;
+                        wparams.world = params.world;
+                        wparams.shared_emission = &shared_emission;
+                        for (size_t j = t; j < emission_order.size(); j += ethreads) {
+                            jl_code_instance_t *codeinst = emission_order[j].first;
+                            JL_GC_PROMISE_ROOTED(codeinst->rettype);
+                            orc::ThreadSafeModule result_m = jl_create_ts_module(name_from_method_instance(codeinst->def),
+                                    wparams.tsctx, wparams.DL, wparams.TargetTriple);
+                            jl_llvm_functions_t decls = jl_emit_code(result_m, codeinst->def, emission_order[j].second, codeinst->rettype, wparams);
+                            {
+                                std::unique_lock<std::mutex> lock(shared_emission.lock);
+                                shared_emission.inflight.erase(codeinst);
+                                if (result_m)
+                                    shared_emission.decls[codeinst] = decls;
+                            }
+                            shared_emission.cond.notify_all();
+                            if (result_m)
+                                wparams.compiled_functions[codeinst] = {std::move(result_m), std::move(decls)};
+                        }
+                        // resolve this shard's call targets; cross-shard
+                        // targets are renamed to their published names and
+                        // resolved when the shards are linked together below
+                        jl_compile_workqueue(wparams, policy);
+                        // hand everything back as one serialized module
+                        orc::ThreadSafeModule combined = jl_create_ts_module("shard", wparams.tsctx, wparams.DL, wparams.TargetTriple);
+                        for (auto &def : wparams.compiled_functions) {
+                            shard.decls.push_back(std::make_pair(def.first, std::get<1>(def.second)));
+                            jl_merge_module(combined, std::move(std::get<0>(def.second)));
+                        }
+                        if (wparams._shared_module)
+                            jl_merge_module(combined, orc::ThreadSafeModule(std::move(wparams._shared_module), wparams.tsctx));
+                        for (auto &global : wparams.global_targets)
+                            shard.gvars.push_back(std::make_pair(global.first, global.second->getName().str()));
+                        for (auto &extern_fn : wparams.external_fns)
+                            shard.external_fns.push_back(std::make_tuple(std::get<0>(extern_fn.first), std::get<1>(extern_fn.first), extern_fn.second->getName().str()));
+                        combined.withModuleDo([&shard](Module &M) {
+                            BitcodeWriter BCWriter(shard.bitcode);
+                            BCWriter.writeModule(M);
+                            BCWriter.writeSymtab();
+                            BCWriter.writeStrtab();
+                        });
+                    }
+                    jl_ExecutionEngine->releaseContext(std::move(ctx));
+                    // this adopted thread is about to exit; park it in a
+                    // GC-safe state so it never blocks a future collection
+                    jl_gc_safe_enter(jl_current_task->ptls);
+                };
+                uv_thread_create(&workers[t], lambda_trampoline, new std::function<void()>(work)); // Use libuv thread to avoid issues with stack sizes
+            }
+            int8_t gc_state = jl_gc_safe_enter(ct->ptls);
+            for (unsigned t = 0; t < ethreads; t++)
+                uv_thread_join(&workers[t]);
+            jl_gc_safe_leave(ct->ptls, gc_state);
+            JL_LOCK(&jl_codegen_lock);
+
+            // splice the shards back into the toplevel params: parse each
+            // shard's bitcode into the toplevel context and link it into the
+            // output module, then rebind the name-keyed bookkeeping; the
+            // decls entries keep an empty module since their code is already
+            // linked in
+            DenseSet<GlobalVariable*> seen_external_fns;
+            for (unsigned t = 0; t < ethreads; t++) {
+                jl_emission_shard_t &shard = shards[t];
+                auto M = cantFail(parseBitcodeFile(MemoryBufferRef(
+                        StringRef(shard.bitcode.data(), shard.bitcode.size()), "shard"),
+                        *ctxt.getContext()), "Error loading shard module");
+                jl_merge_module(clone, orc::ThreadSafeModule(std::move(M), ctxt));
+                for (auto &d : shard.decls) {
+                    if (!params.compiled_functions.count(d.first))
+                        params.compiled_functions[d.first] = std::make_pair(orc::ThreadSafeModule(), d.second);
+                }
+                //Safe b/c context is locked by params
+                Module *merged = clone.getModuleUnlocked();
+                for (auto &g : shard.gvars) {
+                    GlobalVariable *GV = merged->getNamedGlobal(g.second);
+                    assert(GV);
+                    GlobalVariable *&slot = params.global_targets[g.first];
+                    if (slot == NULL)
+                        slot = GV;
+                    else
+                        extra_gvars.push_back(std::make_pair(g.first, GV));
+                }
+                for (auto &e : shard.external_fns) {
+                    GlobalVariable *GV = merged->getNamedGlobal(std::get<2>(e));
+                    assert(GV);
+                    if (!seen_external_fns.insert(GV).second)
+                        continue; // two shards shared one slot after linking
+                    GlobalVariable *&slot = params.external_fns[std::make_tuple(std::get<0>(e), std::get<1>(e))];
+                    if (slot == NULL)
+                        slot = GV;
+                    else
+                        extra_external_fns.push_back(std::make_tuple(std::get<0>(e), std::get<1>(e), GV));
                 }
             }
         }
 
         // finally, make sure all referenced methods also get compiled or fixed up
         jl_compile_workqueue(params, policy);
+
+        // publish everything emitted for this world, so later worlds (and
+        // their shards) reference it by name instead of emitting another copy
+        for (auto &def : params.compiled_functions) {
+            if (!shared_emission.decls.count(def.first))
+                shared_emission.decls[def.first] = std::get<1>(def.second);
+        }
     }
     JL_UNLOCK(&jl_codegen_lock); // Might GC
     JL_GC_POP();
 
     // process the globals array, before jl_merge_module destroys them
-    SmallVector<std::string, 0> gvars(params.global_targets.size());
-    data->jl_value_to_llvm.resize(params.global_targets.size());
+    size_t ngvars = params.global_targets.size() + extra_gvars.size();
+    SmallVector<std::string, 0> gvars(ngvars);
+    data->jl_value_to_llvm.resize(ngvars);
     StringSet<> gvars_names;
     DenseSet<GlobalValue *> gvars_set;
 
@@ -368,10 +565,18 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
         data->jl_value_to_llvm[idx] = global.first;
         idx++;
     }
+    for (auto &global : extra_gvars) {
+        gvars[idx] = global.second->getName().str();
+        global.second->setInitializer(literal_static_pointer_val(global.first, global.second->getValueType()));
+        assert(gvars_set.insert(global.second).second && "Duplicate gvar in params!");
+        assert(gvars_names.insert(gvars[idx]).second && "Duplicate gvar name in params!");
+        data->jl_value_to_llvm[idx] = global.first;
+        idx++;
+    }
     CreateNativeMethods += params.compiled_functions.size();
 
     size_t offset = gvars.size();
-    data->jl_external_to_llvm.resize(params.external_fns.size());
+    data->jl_external_to_llvm.resize(params.external_fns.size() + extra_external_fns.size());
 
     for (auto &extern_fn : params.external_fns) {
         jl_code_instance_t *this_code = std::get<0>(extern_fn.first);
@@ -387,6 +592,17 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
         assert(gvars_names.insert(F->getName()).second && "Duplicate gvar name in params!");
         gvars.push_back(std::string(F->getName()));
     }
+    for (auto &extern_fn : extra_external_fns) {
+        jl_code_instance_t *this_code = std::get<0>(extern_fn);
+        assert(std::get<1>(extern_fn) && "Error external_fns doesn't handle non-specsig yet");
+        GlobalVariable *F = std::get<2>(extern_fn);
+        size_t idx = gvars.size() - offset;
+        assert(idx < data->jl_external_to_llvm.size());
+        data->jl_external_to_llvm[idx] = this_code;
+        assert(gvars_set.insert(F).second && "Duplicate gvar in params!");
+        assert(gvars_names.insert(F->getName()).second && "Duplicate gvar name in params!");
+        gvars.push_back(std::string(F->getName()));
+    }
 
     // clones the contents of the module `m` to the shadow_output collector
     // while examining and recording what kind of function pointer we have
@@ -394,7 +610,8 @@ void *jl_create_native_impl(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvm
         JL_TIMING(NATIVE_AOT, NATIVE_Merge);
         Linker L(*clone.getModuleUnlocked());
         for (auto &def : params.compiled_functions) {
-            jl_merge_module(clone, std::move(std::get<0>(def.second)));
+            if (std::get<0>(def.second)) // shard modules were already linked in
+                jl_merge_module(clone, std::move(std::get<0>(def.second)));
             jl_code_instance_t *this_code = def.first;
             jl_llvm_functions_t decls = std::get<1>(def.second);
             StringRef func = decls.functionObject;
@@ -1035,6 +1252,20 @@ static AOTOutputs add_output_impl(Module &M, TargetMachine &SourceTM, ShardTimer
         NewPM optimizer{std::move(PMTM), getOptLevel(jl_options.opt_level), OptimizationOptions::defaults(true, true)};
         optimizer.run(M);
         assert(!verifyLLVMIR(M));
+        {
+            // Fold identical function bodies, which are plentiful in images
+            // because structurally equal specializations (e.g. Vector{Int32}
+            // vs Vector{UInt32} kernels) optimize to the same code. Merged
+            // functions are left behind as thunks, so every fvar keeps its
+            // own symbol and the fvar table stays valid. This runs after the
+            // optimizer so that bodies have reached their canonical form.
+            PassBuilder PB;
+            AnalysisManagers AM{*TM, PB, OptimizationLevel::O0};
+            ModulePassManager MPM;
+            MPM.addPass(MergeFunctionsPass());
+            MPM.run(M, AM.MAM);
+            assert(!verifyLLVMIR(M));
+        }
         bool inject_aliases = false;
         for (auto &F : M.functions()) {
             if (!F.isDeclaration() && F.getName() != "_DllMainCRTStartup") {
@@ -1594,6 +1825,13 @@ void jl_dump_native_impl(void *native_code,
         addComdat(new GlobalVariable(sysimgM, len->getType(), true,
                                      GlobalVariable::ExternalLinkage,
                                      len, "jl_system_image_size"), TheTriple);
+        // precompute the image checksum so restoring does not have to scan
+        // the whole image just to derive the build id
+        Constant *checksum = ConstantInt::get(Type::getInt32Ty(Context),
+                                              jl_crc32c(0, z->buf, z->size));
+        addComdat(new GlobalVariable(sysimgM, checksum->getType(), true,
+                                     GlobalVariable::ExternalLinkage,
+                                     checksum, "jl_system_image_checksum"), TheTriple);
         // Free z here, since we've copied out everything into data
         // Results in serious memory savings
         ios_close(z);
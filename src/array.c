@@ -24,6 +24,11 @@ typedef uint64_t wideint_t;
 
 #define MAXINTVAL (((size_t)-1)>>1)
 
+// Buffers at least this large come from mmap (via the system malloc or the
+// GC), so capacity beyond the touched pages is reserved address space rather
+// than committed memory and over-allocating on growth is cheap.
+#define ARRAY_LARGE_BUFFER_NBYTES ((size_t)1 << 22)
+
 JL_DLLEXPORT int jl_array_validate_dims(size_t *nel, uint32_t ndims, size_t *dims)
 {
     size_t i;
@@ -232,6 +237,8 @@ JL_DLLEXPORT void jl_array_grow_end(jl_array_t *a, size_t inc)
             newmaxsize = 4;
         else if (oldmaxsize < 48)
             newmaxsize = oldmaxsize*3/2; // grow by 50%
+        else if (oldmaxsize * elsz >= ARRAY_LARGE_BUFFER_NBYTES)
+            newmaxsize = oldmaxsize*2; // reserve far ahead: the tail pages stay untouched
         else
             newmaxsize = oldmaxsize*6/5; // grow by 20%
         if (newmaxsize < reqmaxsize)
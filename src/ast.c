@@ -133,11 +133,12 @@ typedef struct _jl_ast_context_t {
     value_t ssavalue_sym;
     value_t slot_sym;
     jl_module_t *module; // context module for `current-julia-module-counter`
-    struct _jl_ast_context_t *next; // invasive list pointer for getting free contexts
+    size_t heapsize; // initial flisp semispace size, and the target to shrink
+                     // back toward once transient lowering growth is released
+    int in_use; // active on its owning thread (reentrant users get a spare)
+    struct _jl_ast_context_t *next; // invasive list pointer for the spare list
 } jl_ast_context_t;
 
-static jl_ast_context_t jl_ast_main_ctx;
-
 #ifdef __clang_gcanalyzer__
 jl_ast_context_t *jl_ast_ctx(fl_context_t *fl) JL_GLOBALLY_ROOTED JL_NOTSAFEPOINT;
 #else
@@ -265,7 +266,8 @@ static const builtinspec_t julia_flisp_ast_ext[] = {
 static void jl_init_ast_ctx(jl_ast_context_t *ctx) JL_NOTSAFEPOINT
 {
     fl_context_t *fl_ctx = &ctx->fl;
-    fl_init(fl_ctx, 4*1024*1024);
+    ctx->heapsize = 4*1024*1024;
+    fl_init(fl_ctx, ctx->heapsize);
 
     if (fl_load_system_image_str(fl_ctx, (char*)flisp_system_image,
                                  sizeof(flisp_system_image))) {
@@ -286,48 +288,71 @@ static void jl_init_ast_ctx(jl_ast_context_t *ctx) JL_NOTSAFEPOINT
     set(symbol(fl_ctx, "*scopewarn-opt*"), fixnum(jl_options.warn_scope));
 }
 
-// There should be no GC allocation while holding this lock
+// Each thread caches one context, so the common case - many threads lowering
+// code concurrently, as during parallel include - acquires its context with
+// no shared state at all. The mutex only guards the spare list, which is
+// touched when a thread's cached context is already active (reentrant use)
+// and its replacement is later returned.
+static __thread jl_ast_context_t *jl_ast_tls_ctx = NULL;
 static uv_mutex_t flisp_lock;
-static jl_ast_context_t *jl_ast_ctx_freed = NULL;
+static jl_ast_context_t *jl_ast_ctx_spare = NULL;
 
 static jl_ast_context_t *jl_ast_ctx_enter(jl_module_t *m) JL_GLOBALLY_ROOTED JL_NOTSAFEPOINT
 {
     JL_SIGATOMIC_BEGIN();
-    uv_mutex_lock(&flisp_lock);
-    jl_ast_context_t *ctx = jl_ast_ctx_freed;
-    if (ctx != NULL) {
-        jl_ast_ctx_freed = ctx->next;
-        ctx->next = NULL;
-    }
-    uv_mutex_unlock(&flisp_lock);
-    if (ctx == NULL) {
-        // Construct a new one if we can't find any
-        ctx = (jl_ast_context_t*)calloc(1, sizeof(jl_ast_context_t));
-        jl_init_ast_ctx(ctx);
+    jl_ast_context_t *ctx = jl_ast_tls_ctx;
+    if (ctx == NULL || ctx->in_use) {
+        // first use on this thread, or a reentrant use while this thread's
+        // context is active: grab a spare (or construct a new one)
+        uv_mutex_lock(&flisp_lock);
+        ctx = jl_ast_ctx_spare;
+        if (ctx != NULL) {
+            jl_ast_ctx_spare = ctx->next;
+            ctx->next = NULL;
+        }
+        uv_mutex_unlock(&flisp_lock);
+        if (ctx == NULL) {
+            ctx = (jl_ast_context_t*)calloc(1, sizeof(jl_ast_context_t));
+            jl_init_ast_ctx(ctx);
+        }
+        if (jl_ast_tls_ctx == NULL)
+            jl_ast_tls_ctx = ctx;
     }
+    ctx->in_use = 1;
     ctx->module = m;
     return ctx;
 }
 
 static void jl_ast_ctx_leave(jl_ast_context_t *ctx)
 {
-    uv_mutex_lock(&flisp_lock);
+    // lowering a large input can grow the flisp heap well past its initial
+    // size; trim substantial growth back before the context is parked (the
+    // 4x threshold avoids re-collecting on every leave)
+    if (ctx->fl.heapsize >= 4 * ctx->heapsize)
+        fl_shrink_heap(&ctx->fl, ctx->heapsize);
     ctx->module = NULL;
-    ctx->next = jl_ast_ctx_freed;
-    jl_ast_ctx_freed = ctx;
-    uv_mutex_unlock(&flisp_lock);
+    ctx->in_use = 0;
+    if (ctx != jl_ast_tls_ctx) {
+        // not this thread's cached context: park it on the spare list
+        uv_mutex_lock(&flisp_lock);
+        ctx->next = jl_ast_ctx_spare;
+        jl_ast_ctx_spare = ctx;
+        uv_mutex_unlock(&flisp_lock);
+    }
     JL_SIGATOMIC_END();
 }
 
 void jl_init_flisp(void)
 {
-    if (jl_ast_ctx_freed)
+    // The flisp image itself is loaded lazily: jl_ast_ctx_enter constructs a
+    // context on a thread's first parse or lowering request, so processes
+    // that only run precompiled code never pay for it. Only the spare-list
+    // lock needs to exist up front.
+    static int initialized = 0;
+    if (initialized)
         return;
+    initialized = 1;
     uv_mutex_init(&flisp_lock);
-    jl_init_ast_ctx(&jl_ast_main_ctx);
-    // To match the one in jl_ast_ctx_leave
-    JL_SIGATOMIC_BEGIN();
-    jl_ast_ctx_leave(&jl_ast_main_ctx);
 }
 
 void jl_init_common_symbols(void)
@@ -829,6 +854,77 @@ static value_t julia_to_scm_(fl_context_t *fl_ctx, jl_value_t *v, int check_vali
     return julia_to_scm_noalloc2(fl_ctx, v, check_valid);
 }
 
+// --- content-addressed parse cache ---
+//
+// When JULIA_PARSE_CACHE points at a directory, whole-file parse results are
+// stored there keyed by a hash of the source text (plus the filename and
+// starting line number, which are baked into the returned tree), serialized
+// with jl_compress_ast. Parallel precompilation workers repeatedly re-parse
+// the same heavily-included source trees; with the cache enabled, each
+// distinct file content is parsed only once across all of them. Entries are
+// written to a temporary name and renamed into place, so concurrent writers
+// of the same key are benign.
+
+static const char parse_cache_magic[8] = "jlast001"; // bump when the encoding changes
+
+#define PARSE_CACHE_MIN_LEN 512 // don't bother caching tiny inputs
+
+static int parse_cache_path(char *path, size_t pathsz, const char *text, size_t text_len,
+                            jl_value_t *filename, size_t lineno)
+{
+    const char *dir = getenv("JULIA_PARSE_CACHE");
+    if (dir == NULL || *dir == '\0' || text_len < PARSE_CACHE_MIN_LEN)
+        return 0;
+    uint32_t seed = memhash32_seed(jl_string_data(filename), jl_string_len(filename),
+                                   (uint32_t)lineno);
+    uint64_t h1 = memhash_seed(text, text_len, seed);
+    uint64_t h2 = memhash_seed(text, text_len, ~seed);
+    int n = snprintf(path, pathsz, "%s/%016" PRIx64 "%016" PRIx64 ".ast", dir, h1, h2);
+    return n > 0 && (size_t)n < pathsz;
+}
+
+static jl_value_t *parse_cache_lookup(const char *path)
+{
+    ios_t f;
+    if (ios_file(&f, path, 1, 0, 0, 0) == NULL)
+        return NULL;
+    jl_value_t *result = NULL;
+    char magic[sizeof(parse_cache_magic)];
+    if (ios_readall(&f, magic, sizeof(magic)) == sizeof(magic) &&
+        memcmp(magic, parse_cache_magic, sizeof(magic)) == 0) {
+        ios_t buf;
+        ios_mem(&buf, 0);
+        ios_copyall(&buf, &f);
+        result = jl_uncompress_ast(buf.buf, buf.size);
+        ios_close(&buf);
+    }
+    ios_close(&f);
+    return result;
+}
+
+static void parse_cache_store(const char *path, jl_value_t *result)
+{
+    jl_value_t *data = jl_compress_ast(result);
+    if (data == NULL)
+        return; // not representable standalone
+    JL_GC_PUSH1(&data);
+    char tmp[JL_PATH_MAX + 64];
+    int n = snprintf(tmp, sizeof(tmp), "%s.%" PRIx64 ".tmp", path, jl_hrtime());
+    if (n > 0 && (size_t)n < sizeof(tmp)) {
+        ios_t f;
+        if (ios_file(&f, tmp, 1, 1, 1, 1) != NULL) {
+            ios_write(&f, parse_cache_magic, sizeof(parse_cache_magic));
+            ios_write(&f, jl_string_data(data), jl_string_len(data));
+            int err = ios_close(&f);
+            // atomically publish; if a concurrent writer won the race and the
+            // rename fails, the entry already exists and we just clean up
+            if (err != 0 || rename(tmp, path) != 0)
+                remove(tmp);
+        }
+    }
+    JL_GC_POP();
+}
+
 // Parse `text` starting at 0-based `offset` and attributing the content to
 // `filename`. Return an svec of (parsed_expr, final_offset)
 JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
@@ -850,6 +946,17 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
         jl_error("Parse `all`: offset not supported");
     }
 
+    // whole-file parses are content-addressable: consult the on-disk parse
+    // cache (if enabled) before invoking the parser
+    char cache_path[JL_PATH_MAX + 64];
+    int cacheable = rule == jl_all_sym &&
+        parse_cache_path(cache_path, sizeof(cache_path), text, text_len, filename, lineno);
+    if (cacheable) {
+        jl_value_t *cached = parse_cache_lookup(cache_path);
+        if (cached != NULL && jl_is_svec(cached) && jl_svec_len(cached) == 2)
+            return cached;
+    }
+
     jl_ast_context_t *ctx = jl_ast_ctx_enter(NULL);
     fl_context_t *fl_ctx = &ctx->fl;
     value_t fl_text = cvalue_static_cstrn(fl_ctx, text, text_len);
@@ -882,6 +989,172 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
     jl_ast_ctx_leave(ctx);
     jl_value_t *result = (jl_value_t*)jl_svec2(expr, end_offset);
     JL_GC_POP();
+    if (cacheable) {
+        JL_GC_PUSH1(&result);
+        parse_cache_store(cache_path, result);
+        JL_GC_POP();
+    }
+    return result;
+}
+
+// --- incremental reparse ---
+
+// Return the byte offset in `text` where `line` starts, given that `text`
+// begins on line `lineno`.
+static size_t parse_line_offset(const char *text, size_t text_len, size_t lineno, size_t line)
+{
+    size_t off = 0;
+    while (lineno < line && off < text_len) {
+        if (text[off++] == '\n')
+            lineno++;
+    }
+    return off;
+}
+
+static size_t parse_count_lines(const char *text, size_t len)
+{
+    size_t n = 0, i;
+    for (i = 0; i < len; i++)
+        if (text[i] == '\n')
+            n++;
+    return n;
+}
+
+// Re-parse `text` (attributed to `filename`, starting on line `lineno`) after
+// an edit, reusing toplevel expressions from `prev` - the svec returned by a
+// previous `:all` parse of an earlier revision of the same content - wherever
+// the edit cannot have affected them. `edit_lo`..`edit_hi` bound the changed
+// bytes in the new text and `nlines_delta` is the change in total line count.
+// Expressions before the edit are always reused; expressions after it are
+// reused when the line structure is preserved (`nlines_delta == 0`), so only
+// the affected region goes back through the parser. Reused subtrees are
+// returned by reference, letting Revise-style consumers identify unchanged
+// definitions by identity. Falls back to a full parse whenever the previous
+// tree does not have the expected shape or the edit invalidates the splice.
+// Returns the same (expr, final_offset) svec shape as the `all` parse rule.
+JL_DLLEXPORT jl_value_t *jl_fl_parse_incremental(const char *text, size_t text_len,
+                                                 jl_value_t *filename, size_t lineno,
+                                                 size_t edit_lo, size_t edit_hi,
+                                                 ssize_t nlines_delta, jl_value_t *prev)
+{
+    size_t i;
+    if (edit_lo > edit_hi || edit_hi > text_len ||
+        !jl_is_svec(prev) || jl_svec_len(prev) != 2 ||
+        !jl_is_expr(jl_svecref(prev, 0)) ||
+        ((jl_expr_t*)jl_svecref(prev, 0))->head != jl_toplevel_sym)
+        return jl_fl_parse(text, text_len, filename, lineno, 0, (jl_value_t*)jl_all_sym);
+
+    // the previous toplevel must alternate (LineNumberNode, expr) with
+    // increasing lines (a lone trailing LineNumberNode is allowed)
+    jl_expr_t *ptop = (jl_expr_t*)jl_svecref(prev, 0);
+    size_t nprev = jl_expr_nargs(ptop);
+    size_t lastline = 0;
+    for (i = 0; i < nprev; i += 2) {
+        jl_value_t *ln = jl_exprarg(ptop, i);
+        if (!jl_is_linenode(ln) || (size_t)jl_linenode_line(ln) < lastline ||
+            (i + 1 < nprev && jl_is_linenode(jl_exprarg(ptop, i + 1))))
+            return jl_fl_parse(text, text_len, filename, lineno, 0, (jl_value_t*)jl_all_sym);
+        lastline = jl_linenode_line(ln);
+    }
+
+    JL_TIMING(PARSING, PARSING);
+    jl_timing_show_filename(jl_string_data(filename), JL_TIMING_DEFAULT_BLOCK);
+
+    size_t first_changed = lineno + parse_count_lines(text, edit_lo);
+    size_t last_changed = lineno + parse_count_lines(text, edit_hi);
+
+    // reuse every leading pair that ends strictly before the first changed
+    // line (the next pair's LineNumberNode bounds where it can extend to)
+    size_t prefix = 0;
+    size_t resume_line = lineno;
+    for (i = 0; i + 2 < nprev; i += 2) {
+        size_t nextline = jl_linenode_line(jl_exprarg(ptop, i + 2));
+        if (nextline >= first_changed)
+            break;
+        prefix = i + 2;
+        resume_line = nextline;
+    }
+
+    // when the edit preserves the line structure, everything starting after
+    // the last changed line can be reused too
+    size_t suffix = nprev;
+    if (nlines_delta == 0) {
+        for (i = prefix; i + 1 < nprev; i += 2) {
+            if ((size_t)jl_linenode_line(jl_exprarg(ptop, i)) > last_changed) {
+                suffix = i;
+                break;
+            }
+        }
+    }
+    size_t resume_off = parse_line_offset(text, text_len, lineno, resume_line);
+    size_t suffix_off = text_len;
+    while (suffix < nprev) {
+        suffix_off = parse_line_offset(text, text_len, lineno,
+                                       jl_linenode_line(jl_exprarg(ptop, suffix)));
+        if (suffix_off >= edit_hi)
+            break;
+        suffix += 2; // the edit runs into this candidate; skip past it
+        suffix_off = text_len;
+    }
+
+    // re-parse just the affected slice
+    jl_ast_context_t *ctx = jl_ast_ctx_enter(NULL);
+    fl_context_t *fl_ctx = &ctx->fl;
+    value_t fl_text = cvalue_static_cstrn(fl_ctx, text + resume_off, suffix_off - resume_off);
+    fl_gc_handle(fl_ctx, &fl_text);
+    value_t fl_filename = cvalue_static_cstrn(fl_ctx, jl_string_data(filename),
+                                              jl_string_len(filename));
+    fl_gc_handle(fl_ctx, &fl_filename);
+    value_t e = fl_applyn(fl_ctx, 3, symbol_value(symbol(fl_ctx, "jl-parse-all")),
+                          fl_text, fl_filename, fixnum(resume_line));
+    fl_free_gc_handles(fl_ctx, 2);
+
+    jl_value_t *middle = NULL, *result = NULL, *end_offset = NULL;
+    JL_GC_PUSH3(&middle, &result, &end_offset);
+    middle = e == fl_ctx->FL_EOF ? jl_nothing : scm_to_julia(fl_ctx, e, NULL);
+    jl_ast_ctx_leave(ctx);
+
+    size_t nmid = 0;
+    int bad = 0;
+    if (middle != jl_nothing) {
+        if (jl_is_expr(middle) && ((jl_expr_t*)middle)->head == jl_toplevel_sym) {
+            nmid = jl_expr_nargs(middle);
+            // a parse error in a slice truncated before a reused suffix means
+            // the edit changed how that region ends (e.g. opened a block the
+            // old suffix used to close), so the splice point is invalid
+            if (suffix < nprev) {
+                for (i = 0; i < nmid; i++) {
+                    jl_value_t *ex = jl_exprarg(middle, i);
+                    if (jl_is_expr(ex) && (((jl_expr_t*)ex)->head == jl_error_sym ||
+                                           ((jl_expr_t*)ex)->head == jl_incomplete_sym)) {
+                        bad = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        else {
+            bad = 1;
+        }
+    }
+    if (bad) {
+        JL_GC_POP();
+        return jl_fl_parse(text, text_len, filename, lineno, 0, (jl_value_t*)jl_all_sym);
+    }
+
+    size_t ntotal = prefix + nmid + (nprev - suffix);
+    jl_expr_t *top = jl_exprn(jl_toplevel_sym, ntotal);
+    result = (jl_value_t*)top;
+    size_t k = 0;
+    for (i = 0; i < prefix; i++)
+        jl_exprargset(top, k++, jl_exprarg(ptop, i));
+    for (i = 0; i < nmid; i++)
+        jl_exprargset(top, k++, jl_exprarg(middle, i));
+    for (i = suffix; i < nprev; i++)
+        jl_exprargset(top, k++, jl_exprarg(ptop, i));
+    end_offset = jl_box_long(ntotal == 0 ? text_len : 0);
+    result = (jl_value_t*)jl_svec2(result, end_offset);
+    JL_GC_POP();
     return result;
 }
 
@@ -1102,6 +1375,105 @@ int need_esc_node(jl_value_t *e) JL_NOTSAFEPOINT
     return jl_is_ast_node(e);
 }
 
+// --- opt-in memo table for macro expansion ---
+//
+// Template-style code-generating macros are often expanded with identical
+// literal arguments hundreds of times across a codebase. When
+// JULIA_MACRO_MEMO is set in the environment, jl_invoke_julia_macro
+// memoizes expansions keyed by the resolved method instance, the macro-call
+// module and a structural hash of the argument ASTs, and replays a copy of
+// the stored expansion instead of re-running the macro. Macros whose output
+// depends on expansion state beyond their arguments (__source__, gensym
+// freshness, global counters) will expand wrongly under the memo, which is
+// why it is opt-in.
+
+#define MACRO_MEMO_SZ 256
+
+static uint64_t macro_memo_hashes[MACRO_MEMO_SZ];
+// (method instance, module, argument key, expansion) quadruples, direct-mapped
+jl_array_t *jl_macro_memo = NULL;
+static jl_mutex_t macro_memo_lock;
+
+static int macro_memo_enabled(void)
+{
+    static int enabled = -1;
+    if (enabled == -1) {
+        const char *e = getenv("JULIA_MACRO_MEMO");
+        enabled = (e != NULL && strcmp(e, "0") != 0);
+    }
+    return enabled;
+}
+
+static uint64_t macro_memo_hash(jl_method_instance_t *mfunc, jl_module_t *mod,
+                                jl_value_t **args, size_t nargs)
+{
+    uint64_t h = bitmix((uintptr_t)mfunc, jl_object_id((jl_value_t*)mod));
+    for (size_t i = 0; i < nargs; i++)
+        h = bitmix(h, jl_ast_hash(args[i]));
+    return h;
+}
+
+static jl_value_t *macro_memo_lookup(jl_method_instance_t *mfunc, jl_module_t *mod,
+                                     jl_value_t **args, size_t nargs, uint64_t h)
+{
+    size_t slot = (size_t)(h % MACRO_MEMO_SZ);
+    jl_value_t *expansion = NULL;
+    JL_LOCK_NOGC(&macro_memo_lock);
+    if (jl_macro_memo != NULL && macro_memo_hashes[slot] == h &&
+        jl_array_ptr_ref(jl_macro_memo, 4 * slot) == (jl_value_t*)mfunc &&
+        jl_array_ptr_ref(jl_macro_memo, 4 * slot + 1) == (jl_value_t*)mod) {
+        jl_value_t *key = jl_array_ptr_ref(jl_macro_memo, 4 * slot + 2);
+        if (key != NULL && jl_svec_len(key) == nargs) {
+            size_t i;
+            for (i = 0; i < nargs; i++) {
+                if (!jl_ast_eq(jl_svecref(key, i), args[i]))
+                    break;
+            }
+            if (i == nargs)
+                expansion = jl_array_ptr_ref(jl_macro_memo, 4 * slot + 3);
+        }
+    }
+    JL_UNLOCK_NOGC(&macro_memo_lock);
+    if (expansion == NULL)
+        return NULL;
+    // further expansion and lowering mutate the tree, so hand out a copy
+    JL_GC_PUSH1(&expansion);
+    expansion = jl_copy_ast(expansion);
+    JL_GC_POP();
+    return expansion;
+}
+
+static void macro_memo_store(jl_method_instance_t *mfunc, jl_module_t *mod,
+                             jl_value_t **args, size_t nargs, uint64_t h,
+                             jl_value_t *expansion)
+{
+    // the argument trees and the expansion belong to the caller and are
+    // mutated by further expansion and lowering; cache private copies
+    jl_svec_t *key = NULL;
+    jl_value_t *copy = NULL;
+    JL_GC_PUSH3(&key, &copy, &expansion);
+    key = jl_alloc_svec(nargs);
+    for (size_t i = 0; i < nargs; i++)
+        jl_svecset(key, i, jl_copy_ast(args[i]));
+    copy = jl_copy_ast(expansion);
+    if (jl_macro_memo == NULL) {
+        jl_array_t *a = jl_alloc_vec_any(4 * MACRO_MEMO_SZ);
+        JL_LOCK_NOGC(&macro_memo_lock);
+        if (jl_macro_memo == NULL)
+            jl_macro_memo = a;
+        JL_UNLOCK_NOGC(&macro_memo_lock);
+    }
+    size_t slot = (size_t)(h % MACRO_MEMO_SZ);
+    JL_LOCK_NOGC(&macro_memo_lock);
+    macro_memo_hashes[slot] = h;
+    jl_array_ptr_set(jl_macro_memo, 4 * slot, (jl_value_t*)mfunc);
+    jl_array_ptr_set(jl_macro_memo, 4 * slot + 1, (jl_value_t*)mod);
+    jl_array_ptr_set(jl_macro_memo, 4 * slot + 2, (jl_value_t*)key);
+    jl_array_ptr_set(jl_macro_memo, 4 * slot + 3, copy);
+    JL_UNLOCK_NOGC(&macro_memo_lock);
+    JL_GC_POP();
+}
+
 static jl_value_t *jl_invoke_julia_macro(jl_array_t *args, jl_module_t *inmodule, jl_module_t **ctx, jl_value_t **lineinfo, size_t world, int throw_load_error)
 {
     jl_task_t *ct = jl_current_task;
@@ -1136,7 +1508,17 @@ static jl_value_t *jl_invoke_julia_macro(jl_array_t *args, jl_module_t *inmodule
         }
         jl_timing_show_macro(mfunc, margs[1], inmodule, JL_TIMING_DEFAULT_BLOCK);
         *ctx = mfunc->def.method->module;
-        result = jl_invoke(margs[0], &margs[1], nargs - 1, mfunc);
+        if (macro_memo_enabled()) {
+            uint64_t h = macro_memo_hash(mfunc, inmodule, &margs[3], nargs - 3);
+            result = macro_memo_lookup(mfunc, inmodule, &margs[3], nargs - 3, h);
+            if (result == NULL) {
+                result = jl_invoke(margs[0], &margs[1], nargs - 1, mfunc);
+                macro_memo_store(mfunc, inmodule, &margs[3], nargs - 3, h, result);
+            }
+        }
+        else {
+            result = jl_invoke(margs[0], &margs[1], nargs - 1, mfunc);
+        }
     }
     JL_CATCH {
         if ((jl_loaderror_type == NULL) || !throw_load_error) {
@@ -1254,12 +1636,41 @@ static jl_value_t *jl_expand_macros(jl_value_t *expr, jl_module_t *inmodule, str
     return expr;
 }
 
+// Check whether jl_expand_macros could rewrite any part of expr. It mirrors
+// that function's traversal: anything it would leave untouched does not need
+// the defensive jl_copy_ast of the caller's tree (the copy is a deep
+// temporary that dies as soon as lowering converts it to flisp form, and
+// most toplevel expressions contain no macros at all).
+static int jl_has_macrocalls(jl_value_t *expr) JL_NOTSAFEPOINT
+{
+    if (!expr || !jl_is_expr(expr))
+        return 0;
+    jl_expr_t *e = (jl_expr_t*)expr;
+    if (e->head == jl_inert_sym ||
+        e->head == jl_module_sym ||
+        e->head == jl_meta_sym) {
+        return 0;
+    }
+    if (e->head == jl_macrocall_sym ||
+        (e->head == jl_quote_sym && jl_expr_nargs(e) == 1) ||
+        (e->head == jl_hygienicscope_sym && jl_expr_nargs(e) >= 2)) {
+        return 1;
+    }
+    for (size_t i = 0; i < jl_array_nrows(e->args); i++) {
+        if (jl_has_macrocalls(jl_array_ptr_ref(e->args, i)))
+            return 1;
+    }
+    return 0;
+}
+
 JL_DLLEXPORT jl_value_t *jl_macroexpand(jl_value_t *expr, jl_module_t *inmodule)
 {
     JL_TIMING(LOWERING, LOWERING);
     JL_GC_PUSH1(&expr);
-    expr = jl_copy_ast(expr);
-    expr = jl_expand_macros(expr, inmodule, NULL, 0, jl_atomic_load_acquire(&jl_world_counter), 0);
+    if (jl_has_macrocalls(expr)) {
+        expr = jl_copy_ast(expr);
+        expr = jl_expand_macros(expr, inmodule, NULL, 0, jl_atomic_load_acquire(&jl_world_counter), 0);
+    }
     expr = jl_call_scm_on_ast("jl-expand-macroscope", expr, inmodule);
     JL_GC_POP();
     return expr;
@@ -1269,8 +1680,10 @@ JL_DLLEXPORT jl_value_t *jl_macroexpand1(jl_value_t *expr, jl_module_t *inmodule
 {
     JL_TIMING(LOWERING, LOWERING);
     JL_GC_PUSH1(&expr);
-    expr = jl_copy_ast(expr);
-    expr = jl_expand_macros(expr, inmodule, NULL, 1, jl_atomic_load_acquire(&jl_world_counter), 0);
+    if (jl_has_macrocalls(expr)) {
+        expr = jl_copy_ast(expr);
+        expr = jl_expand_macros(expr, inmodule, NULL, 1, jl_atomic_load_acquire(&jl_world_counter), 0);
+    }
     expr = jl_call_scm_on_ast("jl-expand-macroscope", expr, inmodule);
     JL_GC_POP();
     return expr;
@@ -1296,8 +1709,10 @@ JL_DLLEXPORT jl_value_t *jl_expand_in_world(jl_value_t *expr, jl_module_t *inmod
     JL_TIMING(LOWERING, LOWERING);
     jl_timing_show_location(file, line, inmodule, JL_TIMING_DEFAULT_BLOCK);
     JL_GC_PUSH1(&expr);
-    expr = jl_copy_ast(expr);
-    expr = jl_expand_macros(expr, inmodule, NULL, 0, world, 1);
+    if (jl_has_macrocalls(expr)) {
+        expr = jl_copy_ast(expr);
+        expr = jl_expand_macros(expr, inmodule, NULL, 0, world, 1);
+    }
     expr = jl_call_scm_on_ast_and_loc("jl-expand-to-thunk", expr, inmodule, file, line);
     JL_GC_POP();
     return expr;
@@ -1311,8 +1726,10 @@ JL_DLLEXPORT jl_value_t *jl_expand_with_loc_warn(jl_value_t *expr, jl_module_t *
     jl_timing_show_location(file, line, inmodule, JL_TIMING_DEFAULT_BLOCK);
     jl_array_t *kwargs = NULL;
     JL_GC_PUSH2(&expr, &kwargs);
-    expr = jl_copy_ast(expr);
-    expr = jl_expand_macros(expr, inmodule, NULL, 0, ~(size_t)0, 1);
+    if (jl_has_macrocalls(expr)) {
+        expr = jl_copy_ast(expr);
+        expr = jl_expand_macros(expr, inmodule, NULL, 0, ~(size_t)0, 1);
+    }
     jl_ast_context_t *ctx = jl_ast_ctx_enter(inmodule);
     fl_context_t *fl_ctx = &ctx->fl;
     value_t arg = julia_to_scm(fl_ctx, expr);
@@ -1358,8 +1775,10 @@ JL_DLLEXPORT jl_value_t *jl_expand_stmt_with_loc(jl_value_t *expr, jl_module_t *
 {
     JL_TIMING(LOWERING, LOWERING);
     JL_GC_PUSH1(&expr);
-    expr = jl_copy_ast(expr);
-    expr = jl_expand_macros(expr, inmodule, NULL, 0, ~(size_t)0, 1);
+    if (jl_has_macrocalls(expr)) {
+        expr = jl_copy_ast(expr);
+        expr = jl_expand_macros(expr, inmodule, NULL, 0, ~(size_t)0, 1);
+    }
     expr = jl_call_scm_on_ast_and_loc("jl-expand-to-thunk-stmt", expr, inmodule, file, line);
     JL_GC_POP();
     return expr;
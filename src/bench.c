@@ -0,0 +1,128 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+/*
+  Runtime hot-path microbenchmarks, built and run via `make -C src bench`.
+
+  Each benchmark times a tight loop around one runtime entry point and
+  prints ns per operation next to a reference timing. The references were
+  measured on an idle x86_64 box around 3.5GHz with a release build; treat
+  them as an order of magnitude, not a gate. The point is to make a 2x
+  regression in dispatch, subtyping, pool allocation, task switching or
+  the eqtable visible from a single `make -C src bench` run, without
+  waiting for the full Base test suite.
+
+  This is an embedding-style program: it only uses exported libjulia API.
+  `jl_gc_pool_alloc` is exercised through `jl_box_int64` (boxing a large
+  Int64 is a 16-byte pool allocation) and `ctx_switch` through `jl_yield`
+  with a second runnable task, since neither internal function is exported.
+*/
+
+#include "julia.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+uint64_t jl_hrtime(void); // exported from libjulia-internal (julia_internal.h)
+
+static jl_value_t *bench_sink; // defeat dead-loop elimination
+
+static void bench_report(const char *name, uint64_t t0, uint64_t t1,
+                         uint64_t niters, double ref_ns)
+{
+    double ns = (double)(t1 - t0) / (double)niters;
+    printf("%-22s %9.1f ns/op   (reference %7.1f ns/op)\n", name, ns, ref_ns);
+}
+
+static void bench_apply_generic(void)
+{
+    uint64_t niters = 1000000;
+    jl_value_t *plus = NULL, *a = NULL, *b = NULL;
+    JL_GC_PUSH3(&plus, &a, &b);
+    plus = (jl_value_t*)jl_get_function(jl_base_module, "+");
+    a = jl_box_int64(12345678);
+    b = jl_box_int64(87654321);
+    jl_value_t *argv[2] = {a, b};
+    for (uint64_t i = 0; i < 10000; i++) // warmup: compile +(::Int64, ::Int64)
+        bench_sink = jl_apply_generic(plus, argv, 2);
+    uint64_t t0 = jl_hrtime();
+    for (uint64_t i = 0; i < niters; i++)
+        bench_sink = jl_apply_generic(plus, argv, 2);
+    uint64_t t1 = jl_hrtime();
+    JL_GC_POP();
+    bench_report("jl_apply_generic", t0, t1, niters, 25.0);
+}
+
+static void bench_subtype(void)
+{
+    uint64_t niters = 1000000;
+    jl_value_t *x = NULL, *y = NULL;
+    JL_GC_PUSH2(&x, &y);
+    x = jl_eval_string("Tuple{Int64, Vector{Float64}}");
+    y = jl_eval_string("Tuple{Any, AbstractArray}");
+    uint64_t t0 = jl_hrtime();
+    for (uint64_t i = 0; i < niters; i++)
+        bench_sink = jl_subtype(x, y) ? x : y;
+    uint64_t t1 = jl_hrtime();
+    JL_GC_POP();
+    bench_report("jl_subtype", t0, t1, niters, 120.0);
+}
+
+static void bench_pool_alloc(void)
+{
+    uint64_t niters = 10000000;
+    uint64_t t0 = jl_hrtime();
+    for (uint64_t i = 0; i < niters; i++)
+        bench_sink = jl_box_int64((int64_t)(i | 4096)); // > 1023: not cached, pool-allocates
+    uint64_t t1 = jl_hrtime();
+    bench_report("jl_gc_pool_alloc", t0, t1, niters, 8.0);
+}
+
+static void bench_ctx_switch(void)
+{
+    uint64_t niters = 100000;
+    // A second runnable task, so every jl_yield() switches out and back.
+    jl_eval_string("schedule(Task(() -> while true; yield(); end))");
+    jl_yield(); // warmup: get the partner task running
+    uint64_t t0 = jl_hrtime();
+    for (uint64_t i = 0; i < niters; i++)
+        jl_yield();
+    uint64_t t1 = jl_hrtime();
+    bench_report("ctx_switch (yield)", t0, t1, niters, 400.0);
+}
+
+static void bench_eqtable_get(void)
+{
+    uint64_t niters = 10000000;
+    enum { nkeys = 64 };
+    jl_value_t *keys[nkeys];
+    jl_genericmemory_t *ht = NULL;
+    jl_value_t *v = NULL;
+    JL_GC_PUSH2(&ht, &v);
+    ht = jl_alloc_memory_any(32);
+    v = jl_box_int64(1);
+    for (int i = 0; i < nkeys; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "bench_key_%d", i);
+        keys[i] = (jl_value_t*)jl_symbol(name); // symbols are permanently rooted
+        ht = jl_eqtable_put(ht, keys[i], v, NULL);
+    }
+    uint64_t t0 = jl_hrtime();
+    for (uint64_t i = 0; i < niters; i++)
+        bench_sink = jl_eqtable_get(ht, keys[i & (nkeys - 1)], jl_nothing);
+    uint64_t t1 = jl_hrtime();
+    JL_GC_POP();
+    bench_report("jl_eqtable_get", t0, t1, niters, 12.0);
+}
+
+int main(void)
+{
+    jl_init();
+    printf("julia runtime microbenchmarks (single thread)\n");
+    bench_apply_generic();
+    bench_subtype();
+    bench_pool_alloc();
+    bench_ctx_switch();
+    bench_eqtable_get();
+    jl_atexit_hook(0);
+    return 0;
+}
@@ -40,6 +40,11 @@ static int bits_equal(const void *a, const void *b, int sz) JL_NOTSAFEPOINT
     case 2:  return memcmp(a, b, 2) == 0;
     case 4:  return memcmp(a, b, 4) == 0;
     case 8:  return memcmp(a, b, 8) == 0;
+        // With the size fixed, these unroll into a few vector loads and
+        // compares instead of a libc call.
+    case 16: return memcmp(a, b, 16) == 0;
+    case 32: return memcmp(a, b, 32) == 0;
+    case 64: return memcmp(a, b, 64) == 0;
     default: return memcmp(a, b, sz) == 0;
     }
 }
@@ -115,7 +120,7 @@ static int NOINLINE compare_fields(const jl_value_t *a, const jl_value_t *b, jl_
                     continue; // skip this field (it is #undef)
                 }
             }
-            if (!ft->layout->flags.haspadding) {
+            if (ft->layout->flags.isbitsegal && !ft->layout->flags.haspadding) {
                 if (!bits_equal(ao, bo, ft->layout->size))
                     return 0;
             }
@@ -284,13 +289,34 @@ inline int jl_egal__bits(const jl_value_t *a JL_MAYBE_UNROOTED, const jl_value_t
     if (sz == 0)
         return 1;
     size_t nf = jl_datatype_nfields(dt);
-    if (nf == 0 || !dt->layout->flags.haspadding)
+    if (nf == 0 || (dt->layout->flags.isbitsegal && !dt->layout->flags.haspadding))
         return bits_equal(a, b, sz);
     return compare_fields(a, b, dt);
 }
 
 // object_id ------------------------------------------------------------------
 
+// Hash a byte buffer, preferring the hardware CRC32C kernels (src/crc32c.c)
+// over MurmurHash once the buffer is long enough for the per-call dispatch to
+// pay for itself. The 32-bit crc is spread over the full word with an integer
+// finalizer; note that neither variant is stable across processes.
+static uintptr_t memhash_fast(const char *buf, size_t sz, uint32_t seed) JL_NOTSAFEPOINT
+{
+    if (sz >= 16 && jl_crc32c_hw()) {
+        uint32_t crc = jl_crc32c(seed, buf, sz);
+#ifdef _P64
+        return int64hash(((uint64_t)crc << 32) | sz);
+#else
+        return int32hash(crc ^ (uint32_t)sz);
+#endif
+    }
+#ifdef _P64
+    return memhash_seed(buf, sz, seed);
+#else
+    return memhash32_seed(buf, sz, seed);
+#endif
+}
+
 static uintptr_t bits_hash(const void *b, size_t sz) JL_NOTSAFEPOINT
 {
     switch (sz) {
@@ -303,11 +329,7 @@ static uintptr_t bits_hash(const void *b, size_t sz) JL_NOTSAFEPOINT
     case 8:  return int64to32hash(jl_load_unaligned_i64(b));
 #endif
     default:
-#ifdef _P64
-        return memhash((const char*)b, sz);
-#else
-        return memhash32((const char*)b, sz);
-#endif
+        return memhash_fast((const char*)b, sz, 0);
     }
 }
 
@@ -394,7 +416,7 @@ static uintptr_t immut_id_(jl_datatype_t *dt, jl_value_t *v, uintptr_t h) JL_NOT
     if (sz == 0)
         return ~h;
     size_t f, nf = jl_datatype_nfields(dt);
-    if (nf == 0 || (!dt->layout->flags.haspadding && dt->layout->npointers == 0)) {
+    if (nf == 0 || (dt->layout->flags.isbitsegal && !dt->layout->flags.haspadding && dt->layout->npointers == 0)) {
         // operate element-wise if there are unused bits inside,
         // otherwise just take the whole data block at once
         // a few select pointers (notably symbol) also have special hash values
@@ -439,13 +461,8 @@ static uintptr_t NOINLINE jl_object_id__cold(uintptr_t tv, jl_value_t *v) JL_NOT
 {
     jl_datatype_t *dt = (jl_datatype_t*)jl_to_typeof(tv);
     if (dt->name->mutabl) {
-        if (dt == jl_string_type) {
-#ifdef _P64
-            return memhash_seed(jl_string_data(v), jl_string_len(v), 0xedc3b677);
-#else
-            return memhash32_seed(jl_string_data(v), jl_string_len(v), 0xedc3b677);
-#endif
-        }
+        if (dt == jl_string_type)
+            return memhash_fast(jl_string_data(v), jl_string_len(v), 0xedc3b677);
         if (dt == jl_simplevector_type)
             return hash_svec((jl_svec_t*)v);
         if (dt == jl_datatype_type) {
@@ -629,6 +646,29 @@ static jl_value_t *jl_arrayref(jl_array_t *a, size_t i)
     return jl_memoryrefget(jl_memoryrefindex(a->ref, i));
 }
 
+static size_t copy_exact_args(jl_value_t **newargs, jl_function_t *f, jl_value_t **args, uint32_t nargs)
+{
+    newargs[0] = (jl_value_t*)f;
+    size_t n = 1;
+    for (size_t i = 1; i < nargs; i++) {
+        jl_value_t *ai = args[i];
+        if (jl_is_svec(ai)) {
+            jl_svec_t *t = (jl_svec_t*)ai;
+            size_t j, al = jl_svec_len(t);
+            for (j = 0; j < al; j++)
+                newargs[n++] = jl_svecref(t, j);
+        }
+        else {
+            size_t j, al = jl_nfields(ai);
+            for (j = 0; j < al; j++) {
+                // jl_fieldref may allocate.
+                newargs[n++] = jl_fieldref(ai, j);
+            }
+        }
+    }
+    return n;
+}
+
 static jl_value_t *do_apply(jl_value_t **args, uint32_t nargs, jl_value_t *iterate)
 {
     jl_function_t *f = args[0];
@@ -663,10 +703,52 @@ static jl_value_t *do_apply(jl_value_t **args, uint32_t nargs, jl_value_t *itera
             return args[1];
         }
     }
+    // fast path: if everything being splatted is a tuple or svec, the lengths
+    // are immutable so the argument count is exact and nothing needs to be
+    // iterated, grown, or write-barriered -- copy straight into a stack frame
+    size_t exact = 1;
+    size_t i;
+    int needroots = 0;
+    for (i = 1; i < nargs; i++) {
+        if (jl_is_svec(args[i]))
+            exact += jl_svec_len(args[i]);
+        else if (jl_is_tuple(args[i]) || jl_is_namedtuple(args[i])) {
+            jl_datatype_t *st = (jl_datatype_t*)jl_typeof(args[i]);
+            size_t nf = jl_datatype_nfields(st);
+            exact += nf;
+            if (!needroots) {
+                for (size_t j = 0; j < nf; j++) {
+                    if (!jl_field_isptr(st, j)) {
+                        needroots = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+            break;
+    }
+    if (i == nargs && exact < 2 * jl_page_size / sizeof(jl_value_t*)) {
+        if (!needroots) {
+            // every element is a plain pointer load out of a container the
+            // caller keeps rooted, so the copies stay reachable through
+            // `args` for the whole call and no GC frame is needed here
+            jl_value_t **newargs = (jl_value_t**)alloca(exact * sizeof(jl_value_t*));
+            size_t n = copy_exact_args(newargs, f, args, nargs);
+            assert(n == exact);
+            return jl_apply(newargs, n);
+        }
+        jl_value_t **newargs;
+        JL_GC_PUSHARGS(newargs, exact);
+        size_t n = copy_exact_args(newargs, f, args, nargs);
+        assert(n == exact);
+        jl_value_t *result = jl_apply(newargs, n);
+        JL_GC_POP();
+        return result;
+    }
     // estimate how many real arguments we appear to have
     size_t precount = 1;
     size_t extra = 0;
-    size_t i;
     for (i = 1; i < nargs; i++) {
         if (jl_is_svec(args[i])) {
             precount += jl_svec_len(args[i]);
@@ -692,7 +774,7 @@ static jl_value_t *do_apply(jl_value_t **args, uint32_t nargs, jl_value_t *itera
     // use the stack if we have a good estimate that it is small
     // otherwise, use the heap and grow it incrementally
     // and if there are any extra elements, we'll also need a couple extra roots
-    int onstack = (precount + 32 * extra < jl_page_size / sizeof(jl_value_t*));
+    int onstack = (precount + 32 * extra < 2 * jl_page_size / sizeof(jl_value_t*));
     size_t stackalloc = onstack ? (precount + 4 * extra + (extra ? 16 : 0)) : 1;
     size_t n_alloc;
     jl_value_t **roots;
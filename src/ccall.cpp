@@ -29,6 +29,7 @@ TRANSFORMED_CCALL_STAT(jl_sigatomic_begin);
 TRANSFORMED_CCALL_STAT(jl_sigatomic_end);
 TRANSFORMED_CCALL_STAT(jl_string_ptr);
 TRANSFORMED_CCALL_STAT(jl_symbol_name);
+TRANSFORMED_CCALL_STAT(jl_gc_pin_object);
 TRANSFORMED_CCALL_STAT(jl_genericmemory_owner);
 TRANSFORMED_CCALL_STAT(jl_alloc_genericmemory);
 TRANSFORMED_CCALL_STAT(memcpy);
@@ -40,6 +41,7 @@ extern "C" JL_DLLEXPORT jl_value_t *ijl_genericmemory_owner(jl_genericmemory_t *
 
 STATISTIC(EmittedCCalls, "Number of ccalls emitted");
 STATISTIC(DeferredCCallLookups, "Number of ccalls looked up at runtime");
+STATISTIC(ResolvedCCallLookups, "Number of ccalls resolved to a direct call at compile time");
 STATISTIC(LiteralCCalls, "Number of ccalls directly emitted through a pointer");
 STATISTIC(RetBoxedCCalls, "Number of ccalls that were retboxed");
 STATISTIC(SRetCCalls, "Number of ccalls that were marked sret");
@@ -1022,6 +1024,20 @@ static jl_cgval_t mark_or_box_ccall_result(jl_codectx_t &ctx, Value *result, boo
     return mark_julia_type(ctx, result, isboxed, rt);
 }
 
+// The output of generate_func_sig for one (rt, argtypes, cc) tuple, cached in
+// jl_codegen_params_t::ccall_abi_cache so that repeated ccall emissions with
+// an identical signature skip the ABI classifier entirely.
+struct jl_abi_lowering_t {
+    SmallVector<Type*, 0> fargt;
+    SmallVector<Type*, 0> fargt_sig;
+    SmallVector<bool, 0> fargt_isboxed;
+    SmallVector<bool, 0> byRefList;
+    AttributeList attributes;
+    Type *lrt; // may have been rewritten to void for ghost returns
+    Type *prt;
+    int sret;
+};
+
 class function_sig_t {
 public:
     SmallVector<Type*, 0> fargt; // vector of llvm output types (julia_struct_to_llvm) for arguments
@@ -1073,6 +1089,36 @@ std::string generate_func_sig(const char *fname)
 {
     assert(rt && !jl_is_abstract_ref_type(rt));
 
+    // Identical ccall signatures classify identically, so consult the batch's
+    // cache before re-running the ABI classifier. The key components are
+    // normalized with jl_as_global_root, which both keeps the pointers valid
+    // for the life of the cache and maps egal signatures from different call
+    // sites to the same key. Signatures still containing typevars depend on
+    // the enclosing environment and are not cacheable.
+    std::vector<void*> abi_key;
+    if (unionall_env == NULL) {
+        abi_key.reserve(nccallargs + 3);
+        abi_key.push_back(jl_as_global_root(rt, 1));
+        abi_key.push_back((void*)(uintptr_t)cc);
+        abi_key.push_back((void*)(uintptr_t)((nreqargs << 1) | (uintptr_t)llvmcall));
+        jl_svec_t *kat = (jl_svec_t*)jl_as_global_root((jl_value_t*)at, 1);
+        for (size_t i = 0; i < nccallargs; ++i)
+            abi_key.push_back(jl_svecref(kat, i));
+        auto it = ctx->ccall_abi_cache.find(abi_key);
+        if (it != ctx->ccall_abi_cache.end()) {
+            const jl_abi_lowering_t &lowered = *it->second;
+            fargt = lowered.fargt;
+            fargt_sig = lowered.fargt_sig;
+            fargt_isboxed = lowered.fargt_isboxed;
+            byRefList = lowered.byRefList;
+            attributes = lowered.attributes;
+            lrt = lowered.lrt;
+            prt = lowered.prt;
+            sret = lowered.sret;
+            return "";
+        }
+    }
+
     SmallVector<AttributeSet, 0> paramattrs;
     std::unique_ptr<AbiLayout> abi;
     if (llvmcall)
@@ -1194,6 +1240,18 @@ std::string generate_func_sig(const char *fname)
         FnAttrs = FnAttrs.addAttribute(LLVMCtx, Attribute::NoReturn);
     assert(attributes.isEmpty());
     attributes = AttributeList::get(LLVMCtx, FnAttrs, RetAttrs, paramattrs);
+    if (!abi_key.empty()) {
+        auto lowered = std::make_shared<jl_abi_lowering_t>();
+        lowered->fargt = fargt;
+        lowered->fargt_sig = fargt_sig;
+        lowered->fargt_isboxed = fargt_isboxed;
+        lowered->byRefList = byRefList;
+        lowered->attributes = attributes;
+        lowered->lrt = lrt;
+        lowered->prt = prt;
+        lowered->sret = sret;
+        ctx->ccall_abi_cache[std::move(abi_key)] = std::move(lowered);
+    }
     return "";
 }
 };
@@ -1307,6 +1365,68 @@ static const std::string verify_ccall_sig(jl_value_t *&rt, jl_value_t *at,
     return "";
 }
 
+// Straight-line copies of the integer finalizers in support/hashing.c, so an
+// inlined objectid produces exactly the same value as the runtime jl_object_id_
+// for the same bits.
+static Value *emit_int32hash(jl_codectx_t &ctx, Value *a)
+{
+    Type *T = a->getType();
+    auto K = [&] (uint32_t c) { return ConstantInt::get(T, c); };
+    auto &b = ctx.builder;
+    a = b.CreateAdd(b.CreateAdd(a, K(0x7ed55d16)), b.CreateShl(a, 12));
+    a = b.CreateXor(b.CreateXor(a, K(0xc761c23c)), b.CreateLShr(a, 19));
+    a = b.CreateAdd(b.CreateAdd(a, K(0x165667b1)), b.CreateShl(a, 5));
+    a = b.CreateXor(b.CreateAdd(a, K(0xd3a2646c)), b.CreateShl(a, 9));
+    a = b.CreateAdd(b.CreateAdd(a, K(0xfd7046c5)), b.CreateShl(a, 3));
+    a = b.CreateXor(b.CreateXor(a, K(0xb55a4f09)), b.CreateLShr(a, 16));
+    return a;
+}
+
+static Value *emit_int64hash(jl_codectx_t &ctx, Value *key)
+{
+    auto &b = ctx.builder;
+    key = b.CreateAdd(b.CreateNot(key), b.CreateShl(key, 21));
+    key = b.CreateXor(key, b.CreateLShr(key, 24));
+    key = b.CreateAdd(b.CreateAdd(key, b.CreateShl(key, 3)), b.CreateShl(key, 8));
+    key = b.CreateXor(key, b.CreateLShr(key, 14));
+    key = b.CreateAdd(b.CreateAdd(key, b.CreateShl(key, 2)), b.CreateShl(key, 4));
+    key = b.CreateXor(key, b.CreateLShr(key, 28));
+    key = b.CreateAdd(key, b.CreateShl(key, 31));
+    return key;
+}
+
+static Value *emit_int64to32hash(jl_codectx_t &ctx, Value *key)
+{
+    auto &b = ctx.builder;
+    key = b.CreateAdd(b.CreateNot(key), b.CreateShl(key, 18));
+    key = b.CreateXor(key, b.CreateLShr(key, 31));
+    key = b.CreateMul(key, ConstantInt::get(key->getType(), 21));
+    key = b.CreateXor(key, b.CreateLShr(key, 11));
+    key = b.CreateAdd(key, b.CreateShl(key, 6));
+    key = b.CreateXor(key, b.CreateLShr(key, 22));
+    return b.CreateTrunc(key, getInt32Ty(ctx.builder.getContext()));
+}
+
+// Concrete immutable layouts that the runtime hashes as one bits block (see
+// immut_id_ in builtins.c): for these the objectid ccall can be emitted as
+// straight-line inline code instead of a call into generic field traversal.
+static bool bits_hashable_inline(jl_value_t *t)
+{
+    if (!jl_is_concrete_immutable(t))
+        return false;
+    jl_datatype_t *dt = (jl_datatype_t*)t;
+    if (dt->layout == NULL)
+        return false;
+    size_t sz = jl_datatype_size(dt);
+    if (sz == 0)
+        return true; // ghost: objectid folds to a constant
+    if (jl_datatype_nfields(dt) != 0 &&
+        !(dt->layout->flags.isbitsegal && !dt->layout->flags.haspadding &&
+          dt->layout->npointers == 0))
+        return false;
+    return sz == 1 || sz == 2 || sz == 4 || sz == 8;
+}
+
 const int fc_args_start = 6;
 
 // Expr(:foreigncall, pointer, rettype, (argtypes...), nreq, [cconv | (cconv, effects)], args..., roots...)
@@ -1712,6 +1832,21 @@ static jl_cgval_t emit_ccall(jl_codectx_t &ctx, jl_value_t **args, size_t nargs)
         JL_GC_POP();
         return mark_or_box_ccall_result(ctx, strp, retboxed, rt, unionall, static_rt);
     }
+    else if (is_libjulia_func(jl_gc_pin_object) || is_libjulia_func(jl_gc_unpin_object)) {
+        bool pin = is_libjulia_func(jl_gc_pin_object);
+        ++CCALL_STAT(jl_gc_pin_object);
+        assert(lrt == getVoidTy(ctx.builder.getContext()));
+        assert(!isVa && !llvmcall && nccallargs == 1);
+        Value *obj = boxed(ctx, argv[0]);
+        // pin the allocation that actually holds the data: a Memory object
+        // can be a view whose elements live in another object's allocation
+        if (jl_is_genericmemory_type(jl_unwrap_unionall(argv[0].typ)))
+            obj = emit_genericmemoryowner(ctx, obj);
+        ctx.builder.CreateCall(prepare_call(pin ? jlgcpinobject_func : jlgcunpinobject_func),
+                mark_callee_rooted(ctx, obj));
+        JL_GC_POP();
+        return ghostValue(ctx, jl_nothing_type);
+    }
     else if (is_libjulia_func(jl_genericmemory_owner) || is_libjulia_func(ijl_genericmemory_owner)) {
         ++CCALL_STAT(jl_genericmemory_owner);
         assert(lrt == ctx.types().T_prjlvalue);
@@ -1744,6 +1879,9 @@ static jl_cgval_t emit_ccall(jl_codectx_t &ctx, jl_value_t **args, size_t nargs)
             };
         auto alloc = ctx.builder.CreateCall(prepare_call(jl_allocgenericmemory), { boxed(ctx,typ), emit_unbox(ctx, ctx.types().T_size, nel, (jl_value_t*)jl_ulong_type)});
         setName(ctx.emission_context, alloc, arg_typename);
+        // a freshly allocated Memory cannot alias any other Memory object, so
+        // give it its own alias scope (see note_fresh_memory_allocation)
+        note_fresh_memory_allocation(ctx, alloc);
         JL_GC_POP();
         return mark_julia_type(ctx, alloc, true, jl_any_type);
     }
@@ -1821,6 +1959,47 @@ static jl_cgval_t emit_ccall(jl_codectx_t &ctx, jl_value_t **args, size_t nargs)
             ai.decorateInst(hashval);
             return mark_or_box_ccall_result(ctx, hashval, retboxed, rt, unionall, static_rt);
         }
+        else if (bits_hashable_inline(val.typ)) {
+            // The layout is memcmp-safe, so the runtime hashes the whole data
+            // block at once (immut_id_ falling into bits_hash); emit the same
+            // computation as straight-line code, mixed with the compile-time
+            // constant type hash.
+            jl_datatype_t *vdt = (jl_datatype_t*)val.typ;
+            size_t sz = jl_datatype_size(vdt);
+            if (sz == 0) {
+                JL_GC_POP();
+                Value *ret = ConstantInt::get(ctx.types().T_size, ~(uintptr_t)vdt->hash);
+                return mark_or_box_ccall_result(ctx, ret, retboxed, rt, unionall, static_rt);
+            }
+            if (!val.isghost && !val.ispointer())
+                val = value_to_pointer(ctx, val);
+            Type *T_bits = Type::getIntNTy(ctx.builder.getContext(), 8 * sz);
+            Value *ptr = emit_bitcast(ctx, data_pointer(ctx, val), T_bits->getPointerTo());
+            LoadInst *bits = ctx.builder.CreateAlignedLoad(T_bits, ptr, Align(jl_datatype_align(vdt)));
+            jl_aliasinfo_t ai = jl_aliasinfo_t::fromTBAA(ctx, val.tbaa);
+            ai.decorateInst(bits);
+            Value *h;
+            if (sz == 8) {
+                h = ctx.types().sizeof_ptr == 8 ? emit_int64hash(ctx, bits) :
+                                                  emit_int64to32hash(ctx, bits);
+            }
+            else {
+                // bits_hash widens through (u)int32_t: int8_t sign-extends,
+                // the unsigned 16- and 32-bit loads do not
+                Value *w = bits;
+                Type *T_int32 = getInt32Ty(ctx.builder.getContext());
+                if (sz == 1)
+                    w = ctx.builder.CreateSExt(w, T_int32);
+                else if (sz == 2)
+                    w = ctx.builder.CreateZExt(w, T_int32);
+                h = emit_int32hash(ctx, w);
+            }
+            h = ctx.builder.CreateZExtOrTrunc(h, ctx.types().T_size);
+            Value *ret = ctx.builder.CreateXor(h, ConstantInt::get(ctx.types().T_size, (uintptr_t)vdt->hash));
+            setName(ctx.emission_context, ret, "object_id");
+            JL_GC_POP();
+            return mark_or_box_ccall_result(ctx, ret, retboxed, rt, unionall, static_rt);
+        }
         else if (!val.isboxed) {
             // If the value is not boxed, try to compute the object id without
             // reboxing it.
@@ -2026,14 +2205,29 @@ jl_cgval_t function_sig_t::emit_a_ccall(
             ++DeferredCCallLookups;
             llvmf = runtime_sym_lookup(ctx, funcptype, NULL, symarg.lib_expr, symarg.f_name, ctx.f);
         }
-        else /*if (ctx.emission_context.imaging) */{
-            ++DeferredCCallLookups;
-            // vararg requires musttail,
-            // but musttail is incompatible with noreturn.
-            if (functype->isVarArg())
-                llvmf = runtime_sym_lookup(ctx, funcptype, symarg.f_lib, NULL, symarg.f_name, ctx.f);
-            else
-                llvmf = emit_plt(ctx, functype, attributes, cc, symarg.f_lib, symarg.f_name);
+        else {
+            // When not generating an image, absolute addresses are fine to
+            // embed; if the target library is already loaded and exports the
+            // symbol, emit a direct call instead of the lazily-initialized
+            // PLT entry, saving the GOT load and indirect call each time.
+            // The address it would resolve to later is the one it has now.
+            void *symaddr = NULL;
+            if (!ctx.emission_context.imaging_mode)
+                symaddr = jl_lookup_existing_symbol(symarg.f_lib, symarg.f_name);
+            if (symaddr != NULL) {
+                ++ResolvedCCallLookups;
+                llvmf = literal_static_pointer_val(symaddr, funcptype);
+                setName(ctx.emission_context, llvmf, symarg.f_name);
+            }
+            else {
+                ++DeferredCCallLookups;
+                // vararg requires musttail,
+                // but musttail is incompatible with noreturn.
+                if (functype->isVarArg())
+                    llvmf = runtime_sym_lookup(ctx, funcptype, symarg.f_lib, NULL, symarg.f_name, ctx.f);
+                else
+                    llvmf = emit_plt(ctx, functype, attributes, cc, symarg.f_lib, symarg.f_name);
+            }
         }
     }
 
@@ -35,6 +35,18 @@ static size_t get_block_size(size_t size)
             jl_page_size * 256);
 }
 
+// Size of the huge pages used to back executable blocks.
+static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+// Executable blocks are sized and aligned in huge page units so that code
+// from the same compilation batch is packed contiguously into a few large
+// mappings, keeping the iTLB footprint of long-running JIT sessions low.
+static size_t get_exec_block_size(size_t size)
+{
+    return (size > huge_page_size ? LLT_ALIGN(size, huge_page_size) :
+            huge_page_size);
+}
+
 // Wrapper function to mmap/munmap/mprotect pages...
 static void *map_anon_page(size_t size)
 {
@@ -51,6 +63,32 @@ static void *map_anon_page(size_t size)
     return mem;
 }
 
+// Like `map_anon_page`, but aligned to (and a multiple of) the huge page
+// size and marked for transparent huge pages where supported, so the kernel
+// can actually back the code with 2MB mappings.
+static void *map_anon_exec_page(size_t size)
+{
+#ifdef _OS_LINUX_
+    assert(size % huge_page_size == 0);
+    size_t map_size = size + huge_page_size;
+    char *mem = (char*)mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(mem != MAP_FAILED && "Cannot allocate RW memory");
+    char *aligned = (char*)LLT_ALIGN(uintptr_t(mem), huge_page_size);
+    if (aligned != mem)
+        munmap(mem, aligned - mem);
+    size_t tail = (mem + map_size) - (aligned + size);
+    if (tail)
+        munmap(aligned + size, tail);
+#  ifdef MADV_HUGEPAGE
+    madvise(aligned, size, MADV_HUGEPAGE);
+#  endif
+    return aligned;
+#else
+    return map_anon_page(size);
+#endif
+}
+
 static void unmap_page(void *ptr, size_t size)
 {
 #ifdef _OS_WINDOWS_
@@ -527,6 +565,9 @@ class ROAllocator {
 protected:
     static constexpr int nblocks = 8;
     SplitPtrBlock blocks[nblocks];
+    // whether executable blocks should be huge-page sized; turned off for
+    // the cold-code allocator where large blocks would mostly sit unused
+    bool hugepages;
     // Blocks that are done allocating (removed from `blocks`)
     // but might not have all the permissions set or data copied yet.
     SmallVector<SplitPtrBlock, 16> completed;
@@ -534,6 +575,9 @@ protected:
                              size_t size, size_t align) = 0;
     virtual SplitPtrBlock alloc_block(size_t size) = 0;
 public:
+    ROAllocator(bool hugepages = exec)
+        : hugepages(hugepages)
+    {}
     virtual ~ROAllocator() {}
     virtual void finalize()
     {
@@ -573,7 +617,8 @@ public:
                 min_id = i;
             }
         }
-        size_t block_size = get_block_size(size);
+        size_t block_size = (exec && hugepages) ? get_exec_block_size(size) :
+            get_block_size(size);
         auto &block = blocks[min_id];
         auto new_block = alloc_block(block_size);
         block.swap(new_block);
@@ -620,6 +665,12 @@ protected:
         SplitPtrBlock new_block;
         // use `wr_ptr` to record the id initially
         auto ptr = alloc_shared_page(size, (size_t*)&new_block.wr_ptr, exec);
+#if defined(_OS_LINUX_) && defined(MADV_HUGEPAGE)
+        // shared mappings are only huge-page backed when shmem THP is
+        // enabled; the advice is free when it is not
+        if (exec && this->hugepages)
+            madvise(ptr, size, MADV_HUGEPAGE);
+#endif
         new_block.reset(ptr, size);
         return new_block;
     }
@@ -659,7 +710,8 @@ protected:
         }
     }
 public:
-    DualMapAllocator()
+    DualMapAllocator(bool hugepages = exec)
+        : ROAllocator<exec>(hugepages)
     {
         assert(anon_hdl != -1);
     }
@@ -699,7 +751,8 @@ protected:
     SplitPtrBlock alloc_block(size_t size) override
     {
         SplitPtrBlock new_block;
-        new_block.reset(map_anon_page(size), size);
+        new_block.reset((exec && this->hugepages) ?
+                        map_anon_exec_page(size) : map_anon_page(size), size);
         return new_block;
     }
     void finalize_block(SplitPtrBlock &block, bool reset)
@@ -715,8 +768,8 @@ protected:
         }
     }
 public:
-    SelfMemAllocator()
-        : ROAllocator<exec>(),
+    SelfMemAllocator(bool hugepages = exec)
+        : ROAllocator<exec>(hugepages),
           temp_buff()
     {
         assert(get_self_mem_fd() != -1);
@@ -767,6 +820,9 @@ class RTDyldMemoryManagerJL : public SectionMemoryManager {
     RWAllocator rw_alloc;
     std::unique_ptr<ROAllocator<false>> ro_alloc;
     std::unique_ptr<ROAllocator<true>> exe_alloc;
+    // separate region for rarely-executed split sections, so cold code does
+    // not dilute the icache/iTLB footprint of the hot huge-page blocks
+    std::unique_ptr<ROAllocator<true>> cold_alloc;
     bool code_allocated;
     size_t total_allocated;
 
@@ -777,6 +833,7 @@ public:
           rw_alloc(),
           ro_alloc(),
           exe_alloc(),
+          cold_alloc(),
           code_allocated(false),
           total_allocated(0)
     {
@@ -784,11 +841,13 @@ public:
         if (!ro_alloc && get_self_mem_fd() != -1) {
             ro_alloc.reset(new SelfMemAllocator<false>());
             exe_alloc.reset(new SelfMemAllocator<true>());
+            cold_alloc.reset(new SelfMemAllocator<true>(false));
         }
 #endif
         if (!ro_alloc && init_shared_map() != -1) {
             ro_alloc.reset(new DualMapAllocator<false>());
             exe_alloc.reset(new DualMapAllocator<true>());
+            cold_alloc.reset(new DualMapAllocator<true>(false));
         }
     }
     ~RTDyldMemoryManagerJL() override
@@ -829,6 +888,7 @@ public:
             return;
         mapAddresses(Dyld, ro_alloc);
         mapAddresses(Dyld, exe_alloc);
+        mapAddresses(Dyld, cold_alloc);
     }
 #ifdef _OS_WINDOWS_
     template <typename Alloc>
@@ -849,25 +909,40 @@ public:
             return ptr;
         if (void *ptr = lookupWriteAddressFor(rt_addr, exe_alloc))
             return ptr;
+        if (void *ptr = lookupWriteAddressFor(rt_addr, cold_alloc))
+            return ptr;
         return rt_addr;
     }
 #endif // _OS_WINDOWS_
 };
 
+// Sections holding code the compiler considers rarely executed, which get
+// their own allocation region away from the hot code.
+static bool is_cold_code_section(StringRef name)
+{
+    return name.contains(".text.unlikely") || name.contains(".text.split") ||
+        name.endswith(".cold");
+}
+
 uint8_t *RTDyldMemoryManagerJL::allocateCodeSection(uintptr_t Size,
                                                     unsigned Alignment,
                                                     unsigned SectionID,
                                                     StringRef SectionName)
 {
-    // allocating more than one code section can confuse libunwind.
+    bool cold = exe_alloc && cold_alloc && is_cold_code_section(SectionName);
+    if (!cold) {
+        // allocating more than one hot code section can confuse libunwind.
 #if !defined(_COMPILER_MSAN_ENABLED_) && !defined(_COMPILER_ASAN_ENABLED_)
-    // TODO: Figure out why msan and now asan too need this.
-    assert(!code_allocated);
-    code_allocated = true;
+        // TODO: Figure out why msan and now asan too need this.
+        assert(!code_allocated);
+        code_allocated = true;
 #endif
+    }
     total_allocated += Size;
     jl_timing_counter_inc(JL_TIMING_COUNTER_JITSize, Size);
     jl_timing_counter_inc(JL_TIMING_COUNTER_JITCodeSize, Size);
+    if (cold)
+        return (uint8_t*)cold_alloc->alloc(Size, Alignment);
     if (exe_alloc)
         return (uint8_t*)exe_alloc->alloc(Size, Alignment);
     return SectionMemoryManager::allocateCodeSection(Size, Alignment, SectionID,
@@ -910,6 +985,7 @@ bool RTDyldMemoryManagerJL::finalizeMemory(std::string *ErrMsg)
         ro_alloc->finalize();
         assert(exe_alloc);
         exe_alloc->finalize();
+        cold_alloc->finalize();
         for (auto &frame: pending_eh)
             register_eh_frames(frame.addr, frame.size);
         pending_eh.clear();
@@ -1322,6 +1322,19 @@ static Value *emit_datatype_name(jl_codectx_t &ctx, Value *dt)
 // the error is always thrown. This may cause non dominated use
 // of SSA value error in the verifier.
 
+// Attach `!prof` branch weights marking the error successor (by index) of a
+// guard branch as cold, which is what a runtime profile would invariably
+// conclude about a throw path; block placement then moves the error blocks
+// out of the fall-through path instead of treating the branch as 50/50.
+static void set_error_branch_weights(Instruction *br, unsigned err_succ)
+{
+    MDBuilder MDB(br->getContext());
+    // same likely:unlikely ratio LLVM uses for __builtin_expect
+    br->setMetadata(LLVMContext::MD_prof,
+            err_succ == 0 ? MDB.createBranchWeights(1, 2000)
+                          : MDB.createBranchWeights(2000, 1));
+}
+
 static void just_emit_error(jl_codectx_t &ctx, Function *F, const Twine &txt)
 {
     ++EmittedErrors;
@@ -1347,7 +1360,7 @@ static void error_unless(jl_codectx_t &ctx, Value *cond, const Twine &msg)
     ++EmittedConditionalErrors;
     BasicBlock *failBB = BasicBlock::Create(ctx.builder.getContext(), "fail", ctx.f);
     BasicBlock *passBB = BasicBlock::Create(ctx.builder.getContext(), "pass");
-    ctx.builder.CreateCondBr(cond, passBB, failBB);
+    set_error_branch_weights(ctx.builder.CreateCondBr(cond, passBB, failBB), 1);
     ctx.builder.SetInsertPoint(failBB);
     just_emit_error(ctx, prepare_call(jlerror_func), msg);
     ctx.builder.CreateUnreachable();
@@ -1376,7 +1389,7 @@ static void raise_exception_unless(jl_codectx_t &ctx, Value *cond, Value *exc)
     ++EmittedConditionalExceptions;
     BasicBlock *failBB = BasicBlock::Create(ctx.builder.getContext(),"fail",ctx.f);
     BasicBlock *passBB = BasicBlock::Create(ctx.builder.getContext(),"pass");
-    ctx.builder.CreateCondBr(cond, passBB, failBB);
+    set_error_branch_weights(ctx.builder.CreateCondBr(cond, passBB, failBB), 1);
     ctx.builder.SetInsertPoint(failBB);
     raise_exception(ctx, exc, passBB);
 }
@@ -1744,7 +1757,7 @@ static void emit_typecheck(jl_codectx_t &ctx, const jl_cgval_t &x, jl_value_t *t
         ++EmittedTypechecks;
         BasicBlock *failBB = BasicBlock::Create(ctx.builder.getContext(), "fail", ctx.f);
         BasicBlock *passBB = BasicBlock::Create(ctx.builder.getContext(), "pass");
-        ctx.builder.CreateCondBr(istype, passBB, failBB);
+        set_error_branch_weights(ctx.builder.CreateCondBr(istype, passBB, failBB), 1);
         ctx.builder.SetInsertPoint(failBB);
 
         just_emit_type_error(ctx, x, literal_pointer_val(ctx, type), msg);
@@ -1799,7 +1812,7 @@ static Value *emit_bounds_check(jl_codectx_t &ctx, const jl_cgval_t &ainfo, jl_v
         setName(ctx.emission_context, ok, "boundscheck");
         BasicBlock *failBB = BasicBlock::Create(ctx.builder.getContext(), "fail", ctx.f);
         BasicBlock *passBB = BasicBlock::Create(ctx.builder.getContext(), "pass");
-        ctx.builder.CreateCondBr(ok, passBB, failBB);
+        set_error_branch_weights(ctx.builder.CreateCondBr(ok, passBB, failBB), 1);
         ctx.builder.SetInsertPoint(failBB);
         if (!ty) { // jl_value_t** tuple (e.g. the vararg)
             ctx.builder.CreateCall(prepare_call(jlvboundserror_func), { ainfo.V, len, i });
@@ -2138,7 +2151,8 @@ static jl_cgval_t typed_store(jl_codectx_t &ctx,
             }
             else if (!isboxed) {
                 assert(jl_is_concrete_type(jltype));
-                needloop = ((jl_datatype_t*)jltype)->layout->flags.haspadding;
+                needloop = ((jl_datatype_t*)jltype)->layout->flags.haspadding ||
+                    !((jl_datatype_t*)jltype)->layout->flags.isbitsegal;
                 Value *SameType = emit_isa(ctx, cmp, jltype, Twine()).first;
                 if (SameType != ConstantInt::getTrue(ctx.builder.getContext())) {
                     BasicBlock *SkipBB = BasicBlock::Create(ctx.builder.getContext(), "skip_xchg", ctx.f);
@@ -50,6 +50,16 @@ JL_DLLEXPORT void jl_generate_fptr_for_unspecialized_fallback(jl_code_instance_t
 
 JL_DLLEXPORT void jl_generate_fptr_for_oc_wrapper_fallback(jl_code_instance_t *unspec) UNAVAILABLE
 
+JL_DLLEXPORT void jl_enqueue_tier0_promotion_fallback(jl_code_instance_t *codeinst)
+{
+    (void)codeinst;
+}
+
+JL_DLLEXPORT void jl_enqueue_reoptimization_fallback(jl_code_instance_t *codeinst)
+{
+    (void)codeinst;
+}
+
 JL_DLLEXPORT uint32_t jl_get_LLVM_VERSION_fallback(void)
 {
     return 0;
@@ -75,6 +85,12 @@ JL_DLLEXPORT void jl_dump_compiles_fallback(void *s)
 {
 }
 
+JL_DLLEXPORT jl_value_t *jl_compile_cost_report_fallback(size_t n)
+{
+    (void)n;
+    return (jl_value_t*)jl_alloc_vec_any(0);
+}
+
 JL_DLLEXPORT void jl_dump_emitted_mi_name_fallback(void *s)
 {
 }
@@ -992,6 +992,22 @@ static const auto jlunlockvalue_func = new JuliaFunction<>{
             AttributeSet(),
             {Attributes(C, {Attribute::NoCapture})}); },
 };
+static const auto jlgcpinobject_func = new JuliaFunction<>{
+    XSTR(jl_gc_pin_object),
+    [](LLVMContext &C) { return FunctionType::get(getVoidTy(C),
+            {PointerType::get(JuliaType::get_jlvalue_ty(C), AddressSpace::CalleeRooted)}, false); },
+    // no NoCapture here: the runtime retains the object in the pin table
+    nullptr,
+};
+static const auto jlgcunpinobject_func = new JuliaFunction<>{
+    XSTR(jl_gc_unpin_object),
+    [](LLVMContext &C) { return FunctionType::get(getVoidTy(C),
+            {PointerType::get(JuliaType::get_jlvalue_ty(C), AddressSpace::CalleeRooted)}, false); },
+    [](LLVMContext &C) { return AttributeList::get(C,
+            AttributeSet(),
+            AttributeSet(),
+            {Attributes(C, {Attribute::NoCapture})}); },
+};
 static const auto jlenter_func = new JuliaFunction<>{
     XSTR(jl_enter_handler),
     [](LLVMContext &C) { return FunctionType::get(getVoidTy(C),
@@ -1855,6 +1871,12 @@ public:
     jl_typecache_t type_cache;
     jl_tbaacache_t tbaa_cache;
     jl_noaliascache_t aliasscope_cache;
+    // alias scopes for Memory buffers proven distinct from each other (fresh
+    // allocations in this function); see note_fresh_memory_allocation
+    MDNode *fresh_memory_domain = nullptr;
+    SmallVector<MDNode*, 0> fresh_memory_scopes;
+    DenseMap<Value*, unsigned> fresh_memory_scope_map;
+    SmallVector<std::pair<Instruction*, size_t>, 0> fresh_memory_accesses;
     jl_method_instance_t *linfo = NULL;
     jl_value_t *rettype = NULL;
     jl_code_info_t *source = NULL;
@@ -1988,6 +2010,67 @@ jl_aliasinfo_t jl_aliasinfo_t::fromTBAA(jl_codectx_t &ctx, MDNode *tbaa) {
     return jl_aliasinfo_t(ctx, Region::unknown, tbaa);
 }
 
+// --- alias scopes for provably distinct Memory buffers ---
+
+// A Memory object freshly allocated inside the current function cannot alias
+// any other Memory object, but every element access shares the tbaa_arraybuf
+// domain, so LLVM has to assume that loads from two different buffers in the
+// same loop may interfere. Each fresh allocation therefore gets its own
+// !alias.scope; element accesses through it are tagged while the function is
+// emitted, and once the full set of distinct buffers is known (at the end of
+// emit_function) every tagged access is declared !noalias with all the other
+// buffers' scopes, recovering what `restrict` gives C.
+
+static void note_fresh_memory_allocation(jl_codectx_t &ctx, Value *alloc)
+{
+    MDBuilder mbuilder(ctx.builder.getContext());
+    if (ctx.fresh_memory_domain == nullptr)
+        ctx.fresh_memory_domain = mbuilder.createAliasScopeDomain("jlmem");
+    MDNode *scope = mbuilder.createAliasScope("jlmem" + std::to_string(ctx.fresh_memory_scopes.size()),
+                                              ctx.fresh_memory_domain);
+    ctx.fresh_memory_scope_map[alloc] = (unsigned)ctx.fresh_memory_scopes.size();
+    ctx.fresh_memory_scopes.push_back(scope);
+}
+
+// look up the alias scope index of the Memory object `mem`, or -1 if it is
+// not a provably distinct allocation
+static ssize_t fresh_memory_scope_of(jl_codectx_t &ctx, Value *mem)
+{
+    while (CastInst *CI = dyn_cast<CastInst>(mem))
+        mem = CI->getOperand(0);
+    auto it = ctx.fresh_memory_scope_map.find(mem);
+    if (it == ctx.fresh_memory_scope_map.end())
+        return -1;
+    return (ssize_t)it->second;
+}
+
+// record the element accesses emitted since `startI` (the tail instruction of
+// `startBB` at the start of the emission, exclusive) as belonging to the
+// fresh-Memory alias scope `idx`
+static void note_fresh_memory_accesses(jl_codectx_t &ctx, BasicBlock *startBB, Instruction *startI, size_t idx)
+{
+    BasicBlock *endBB = ctx.builder.GetInsertBlock();
+    MDNode *tbaa_buf = ctx.tbaa().tbaa_arraybuf;
+    MDNode *tbaa_ptrbuf = ctx.tbaa().tbaa_ptrarraybuf;
+    for (BasicBlock *BB = startBB; BB != nullptr; BB = BB->getNextNode()) {
+        Instruction *I = BB == startBB
+            ? (startI ? startI->getNextNode() : (BB->empty() ? nullptr : &BB->front()))
+            : (BB->empty() ? nullptr : &BB->front());
+        for (; I != nullptr; I = I->getNextNode()) {
+            if (isa<LoadInst>(I) || isa<StoreInst>(I) || isa<MemTransferInst>(I) ||
+                isa<AtomicRMWInst>(I) || isa<AtomicCmpXchgInst>(I)) {
+                // the buffer tbaa identifies the element accesses among the
+                // bookkeeping loads emitted alongside them
+                MDNode *tbaa = I->getMetadata(LLVMContext::MD_tbaa);
+                if (tbaa == tbaa_buf || tbaa == tbaa_ptrbuf)
+                    ctx.fresh_memory_accesses.push_back(std::make_pair(I, idx));
+            }
+        }
+        if (BB == endBB)
+            break;
+    }
+}
+
 static Type *julia_type_to_llvm(jl_codectx_t &ctx, jl_value_t *jt, bool *isboxed = NULL);
 static jl_returninfo_t get_specsig_function(jl_codectx_t &ctx, Module *M, Value *fval, StringRef name, jl_value_t *sig, jl_value_t *jlrettype, bool is_opaque_closure, bool gcstack_arg, BitVector *used_arguments=nullptr, size_t *args_begin=nullptr);
 static jl_cgval_t emit_expr(jl_codectx_t &ctx, jl_value_t *expr, ssize_t ssaval = -1);
@@ -2722,13 +2805,28 @@ JL_DLLEXPORT uint64_t *jl_malloc_data_pointer(StringRef filename, int line);
 
 static void visitLine(jl_codectx_t &ctx, uint64_t *ptr, Value *addend, const char *name)
 {
+    // ptr is the stripe-0 replica of the counter (see allocLine in
+    // coverage.cpp); pick this thread's stripe so concurrent increments of
+    // one line land on different cache lines, and use a monotonic atomic add
+    // so parallel runs do not lose counts
     Value *pv = ConstantExpr::getIntToPtr(
         ConstantInt::get(ctx.types().T_size, (uintptr_t)ptr),
         getInt64PtrTy(ctx.builder.getContext()));
-    Value *v = ctx.builder.CreateLoad(getInt64Ty(ctx.builder.getContext()), pv, true, name);
-    v = ctx.builder.CreateAdd(v, addend);
-    ctx.builder.CreateStore(v, pv, true); // volatile, not atomic, so this might be an underestimate,
-                                          // but it's faster this way
+    Value *ct = get_current_task(ctx);
+    Value *ptid = ctx.builder.CreateInBoundsGEP(
+            getInt16Ty(ctx.builder.getContext()),
+            ctx.builder.CreateBitCast(ct, getInt16PtrTy(ctx.builder.getContext())),
+            ConstantInt::get(ctx.types().T_size, offsetof(jl_task_t, tid) / sizeof(int16_t)));
+    Value *tid = ctx.builder.CreateLoad(getInt16Ty(ctx.builder.getContext()), ptid, "tid");
+    Value *stripe = ctx.builder.CreateAnd(
+            ctx.builder.CreateZExt(tid, ctx.types().T_size),
+            ConstantInt::get(ctx.types().T_size, JL_LOGDATA_NSTRIPES - 1));
+    pv = ctx.builder.CreateInBoundsGEP(
+            getInt64Ty(ctx.builder.getContext()), pv,
+            ctx.builder.CreateMul(stripe, ConstantInt::get(ctx.types().T_size, JL_LOGDATA_BLOCKSIZE)),
+            name);
+    ctx.builder.CreateAtomicRMW(AtomicRMWInst::Add, pv, addend, Align(sizeof(uint64_t)),
+                                AtomicOrdering::Monotonic);
 }
 
 // Code coverage
@@ -3247,7 +3345,15 @@ static Value *emit_bits_compare(jl_codectx_t &ctx, jl_cgval_t arg1, jl_cgval_t a
     if (at->isAggregateType()) { // Struct or Array
         jl_datatype_t *sty = (jl_datatype_t*)arg1.typ;
         size_t sz = jl_datatype_size(sty);
-        if (sz > 512 && !sty->layout->flags.haspadding) {
+        // If the layout has no padding and no unions, egal is a flat bitwise
+        // comparison (same condition as jl_egal in the runtime). Emit it as a
+        // single memcmp instead of a field-by-field cmp chain whenever both
+        // operands are already in memory: LLVM expands small constant-size
+        // memcmp into wide integer compares. Structs still held in registers
+        // keep the field-wise path below to avoid spilling them, unless they
+        // are too large for that to matter.
+        bool flat_egal = !sty->layout->flags.haspadding && sty->layout->flags.isbitsegal;
+        if (flat_egal && (sz > 512 || (sz > 16 && arg1.ispointer() && arg2.ispointer()))) {
             Value *varg1 = arg1.ispointer() ? data_pointer(ctx, arg1) :
                 value_to_pointer(ctx, arg1).V;
             Value *varg2 = arg2.ispointer() ? data_pointer(ctx, arg2) :
@@ -3766,13 +3872,18 @@ static bool emit_builtin_call(jl_codectx_t &ctx, jl_cgval_t *ret, jl_value_t *f,
                 *ret = emit_unionload(ctx, data, ptindex, ety, elsz_c, al, ctx.tbaa().tbaa_arraybuf, true, union_max, ctx.tbaa().tbaa_arrayselbyte);
             }
             else {
-                *ret = typed_load(ctx,
-                        emit_memoryref_ptr(ctx, ref, layout),
+                Value *ptr = emit_memoryref_ptr(ctx, ref, layout);
+                ssize_t scope_idx = fresh_memory_scope_of(ctx, mem);
+                BasicBlock *startBB = ctx.builder.GetInsertBlock();
+                Instruction *startI = startBB->empty() ? nullptr : &startBB->back();
+                *ret = typed_load(ctx, ptr,
                         nullptr, ety,
                         isboxed ? ctx.tbaa().tbaa_ptrarraybuf : ctx.tbaa().tbaa_arraybuf,
                         ctx.noalias().aliasscope.current,
                         isboxed,
                         AtomicOrdering::NotAtomic);
+                if (scope_idx >= 0)
+                    note_fresh_memory_accesses(ctx, startBB, startI, (size_t)scope_idx);
             }
             return true;
         }
@@ -3857,8 +3968,12 @@ static bool emit_builtin_call(jl_codectx_t &ctx, jl_cgval_t *ret, jl_value_t *f,
                     }
                 }
                 else {
+                    Value *ptr = emit_memoryref_ptr(ctx, ref, layout);
+                    ssize_t scope_idx = fresh_memory_scope_of(ctx, mem);
+                    BasicBlock *startBB = ctx.builder.GetInsertBlock();
+                    Instruction *startI = startBB->empty() ? nullptr : &startBB->back();
                     typed_store(ctx,
-                                emit_memoryref_ptr(ctx, ref, layout),
+                                ptr,
                                 nullptr, val, jl_cgval_t(), ety,
                                 isboxed ? ctx.tbaa().tbaa_ptrarraybuf : ctx.tbaa().tbaa_arraybuf,
                                 ctx.noalias().aliasscope.current,
@@ -3875,6 +3990,8 @@ static bool emit_builtin_call(jl_codectx_t &ctx, jl_cgval_t *ret, jl_value_t *f,
                                 false,
                                 nullptr,
                                 "");
+                    if (scope_idx >= 0)
+                        note_fresh_memory_accesses(ctx, startBB, startI, (size_t)scope_idx);
                 }
             }
             *ret = ref;
@@ -4906,7 +5023,7 @@ static void undef_var_error_ifnot(jl_codectx_t &ctx, Value *ok, jl_sym_t *name,
     ++EmittedUndefVarErrors;
     BasicBlock *err = BasicBlock::Create(ctx.builder.getContext(), "err", ctx.f);
     BasicBlock *ifok = BasicBlock::Create(ctx.builder.getContext(), "ok");
-    ctx.builder.CreateCondBr(ok, ifok, err);
+    set_error_branch_weights(ctx.builder.CreateCondBr(ok, ifok, err), 1);
     ctx.builder.SetInsertPoint(err);
     ctx.builder.CreateCall(prepare_call(jlundefvarerror_func), {
             mark_callee_rooted(ctx, literal_pointer_val(ctx, (jl_value_t*)name)),
@@ -4922,7 +5039,7 @@ static void emit_hasnofield_error_ifnot(jl_codectx_t &ctx, Value *ok, jl_sym_t *
     assert(name.typ == (jl_value_t*)jl_symbol_type);
     BasicBlock *err = BasicBlock::Create(ctx.builder.getContext(), "err", ctx.f);
     BasicBlock *ifok = BasicBlock::Create(ctx.builder.getContext(), "ok");
-    ctx.builder.CreateCondBr(ok, ifok, err);
+    set_error_branch_weights(ctx.builder.CreateCondBr(ok, ifok, err), 1);
     ctx.builder.SetInsertPoint(err);
     ctx.builder.CreateCall(prepare_call(jlhasnofield_func),
                           {mark_callee_rooted(ctx, literal_pointer_val(ctx, (jl_value_t*)type)),
@@ -7825,6 +7942,14 @@ static jl_llvm_functions_t
         FnAttrs.addAttribute("julia-optimization-level", optLevelStrings[optlevel]);
     }
 
+    // tiered compilation requested a specific level for this batch; it takes
+    // precedence over both the process level and per-module annotations
+    int tierlevel = ctx.emission_context.tier_optlevel;
+    if (tierlevel >= 0 && tierlevel <= 3) {
+        static const char* const optLevelStrings[] = { "0", "1", "2", "3" };
+        FnAttrs.addAttribute("julia-tier-optlevel", optLevelStrings[tierlevel]);
+    }
+
     ctx.f = f;
 
     // Step 4b. determine debug info signature and other type info for locals
@@ -9124,6 +9249,30 @@ static jl_llvm_functions_t
         }
     }
 
+    // Now that the full set of provably distinct Memory buffers is known,
+    // declare each tagged element access noalias with every other buffer's
+    // scope (see note_fresh_memory_allocation).
+    if (!ctx.fresh_memory_accesses.empty()) {
+        auto &mdctx = ctx.builder.getContext();
+        for (auto &access : ctx.fresh_memory_accesses) {
+            Instruction *inst = access.first;
+            size_t idx = access.second;
+            Metadata *self[1] = { ctx.fresh_memory_scopes[idx] };
+            inst->setMetadata(LLVMContext::MD_alias_scope, MDNode::concatenate(
+                    inst->getMetadata(LLVMContext::MD_alias_scope),
+                    MDNode::get(mdctx, self)));
+            SmallVector<Metadata*, 8> others;
+            for (size_t j = 0; j < ctx.fresh_memory_scopes.size(); j++) {
+                if (j != idx)
+                    others.push_back(ctx.fresh_memory_scopes[j]);
+            }
+            if (!others.empty())
+                inst->setMetadata(LLVMContext::MD_noalias, MDNode::concatenate(
+                        inst->getMetadata(LLVMContext::MD_noalias),
+                        MDNode::get(mdctx, others)));
+        }
+    }
+
     // link the dependent llvmcall modules, but switch their function's linkage to internal
     // so that they don't conflict when they show up in the execution engine.
     Linker L(*jl_Module);
@@ -9253,6 +9402,20 @@ jl_llvm_functions_t jl_emit_codeinst(
 
     const std::string &specf = decls.specFunctionObject;
     const std::string &f = decls.functionObject;
+    if (params.tier_optlevel == TIER2_OPT_LEVEL && m) {
+        // This batch re-optimizes code that was promoted out of the tier-0
+        // interpreter, so its invocation counter is known to have reached
+        // TIER0_PROMOTE_THRESHOLD. Attach that as the profiled entry count
+        // (the only execution count tier 0 records) so block frequency
+        // analysis treats this code as measured-hot rather than unprofiled.
+        Module *M = m.getModuleUnlocked();
+        if (!specf.empty())
+            if (Function *F = M->getFunction(specf))
+                F->setEntryCount(TIER0_PROMOTE_THRESHOLD);
+        if (!f.empty() && f != "jl_fptr_args" && f != "jl_fptr_sparam")
+            if (Function *F = M->getFunction(f))
+                F->setEntryCount(TIER0_PROMOTE_THRESHOLD);
+    }
     if (params.cache && !f.empty()) {
         // Prepare debug info to receive this function
         // record that this function name came from this linfo,
@@ -9349,8 +9512,36 @@ void jl_compile_workqueue(
             }
         }
         else {
+            jl_llvm_functions_t *fdecls = NULL;
+            bool claimed = false;
+            jl_aot_shared_emission_t *shared = params.shared_emission;
             auto it = params.compiled_functions.find(codeinst);
-            if (it == params.compiled_functions.end()) {
+            if (it != params.compiled_functions.end())
+                fdecls = &it->second.second;
+            if (fdecls == NULL && shared != NULL) {
+                // when several threads share one emission (jl_create_native),
+                // some other shard may have emitted this code instance already
+                // or be emitting it right now: use its names instead of
+                // emitting a duplicate copy, and claim it for this shard
+                // otherwise
+                jl_ptls_t ptls = jl_current_task->ptls;
+                std::unique_lock<std::mutex> lock(shared->lock);
+                while (shared->inflight.count(codeinst)) {
+                    int8_t gc_state = jl_gc_safe_enter(ptls);
+                    shared->cond.wait(lock);
+                    jl_gc_safe_leave(ptls, gc_state);
+                }
+                auto sit = shared->decls.find(codeinst);
+                if (sit != shared->decls.end()) {
+                    // node-based map: the value stays valid after unlocking
+                    fdecls = &sit->second;
+                }
+                else {
+                    shared->inflight.insert(codeinst);
+                    claimed = true;
+                }
+            }
+            if (fdecls == NULL) {
                 // Reinfer the function. The JIT came along and removed the inferred
                 // method body. See #34993
                 if (policy != CompilationPolicy::Default &&
@@ -9373,14 +9564,23 @@ void jl_compile_workqueue(
                     if (result_m)
                         it = params.compiled_functions.insert(std::make_pair(codeinst, std::make_pair(std::move(result_m), std::move(decls)))).first;
                 }
-            }
-            if (it != params.compiled_functions.end()) {
-                auto &decls = it->second.second;
-                if (decls.functionObject == "jl_fptr_args") {
-                    preal_decl = decls.specFunctionObject;
+                if (it != params.compiled_functions.end())
+                    fdecls = &it->second.second;
+            }
+            if (claimed) {
+                std::unique_lock<std::mutex> lock(shared->lock);
+                shared->inflight.erase(codeinst);
+                if (fdecls)
+                    shared->decls[codeinst] = *fdecls;
+                lock.unlock();
+                shared->cond.notify_all();
+            }
+            if (fdecls) {
+                if (fdecls->functionObject == "jl_fptr_args") {
+                    preal_decl = fdecls->specFunctionObject;
                 }
-                else if (decls.functionObject != "jl_fptr_sparam") {
-                    preal_decl = decls.specFunctionObject;
+                else if (fdecls->functionObject != "jl_fptr_sparam") {
+                    preal_decl = fdecls->specFunctionObject;
                     preal_specsig = true;
                 }
             }
@@ -22,10 +22,17 @@ static int codegen_imaging_mode(void)
 
 // Logging for code coverage and memory allocation
 
-const int logdata_blocksize = 32; // target getting nearby lines in the same general cache area and reducing calls to malloc by chunking
-typedef uint64_t logdata_block[logdata_blocksize];
+const int logdata_blocksize = JL_LOGDATA_BLOCKSIZE; // target getting nearby lines in the same general cache area and reducing calls to malloc by chunking
+const int logdata_nstripes = JL_LOGDATA_NSTRIPES;
+// each block holds logdata_nstripes replicas of its counters: a thread
+// increments the replica at stripe (tid % logdata_nstripes), spacing
+// concurrent writers of the same line onto different cache lines, and the
+// replicas are summed when the log is written out
+typedef uint64_t logdata_block[logdata_nstripes * logdata_blocksize];
 typedef StringMap< SmallVector<logdata_block*, 0> > logdata_t;
 
+// returns the stripe-0 counter; the replica for stripe s is at
+// ptr + s * logdata_blocksize
 static uint64_t *allocLine(SmallVector<logdata_block*, 0> &vec, int line)
 {
     unsigned block = line / logdata_blocksize;
@@ -37,10 +44,18 @@ static uint64_t *allocLine(SmallVector<logdata_block*, 0> &vec, int line)
     }
     logdata_block &data = *vec[block];
     if (data[line] == 0)
-        data[line] = 1;
+        data[line] = 1; // instrumented-line marker, kept in stripe 0 only
     return &data[line];
 }
 
+static uint64_t sumLine(logdata_block &data, int line)
+{
+    uint64_t value = 0;
+    for (int s = 0; s < logdata_nstripes; s++)
+        value += data[s * logdata_blocksize + line];
+    return value;
+}
+
 // Code coverage
 
 static logdata_t coverageData;
@@ -65,7 +80,9 @@ extern "C" JL_DLLEXPORT void jl_coverage_visit_line(const char *filename_, size_
         return;
     SmallVector<logdata_block*, 0> &vec = coverageData[filename];
     uint64_t *ptr = allocLine(vec, line);
-    (*ptr)++;
+    int16_t tid = jl_atomic_load_relaxed(&jl_current_task->tid);
+    ptr += (tid & (logdata_nstripes - 1)) * logdata_blocksize;
+    jl_atomic_fetch_add_relaxed((_Atomic(uint64_t)*)ptr, 1);
 }
 
 // Memory allocation log (malloc_log)
@@ -88,8 +105,11 @@ extern "C" JL_DLLEXPORT void jl_clear_malloc_data(void)
             if (*itb) {
                 logdata_block &data = **itb;
                 for (int i = 0; i < logdata_blocksize; i++) {
-                    if (data[i] > 0)
+                    if (sumLine(data, i) > 0) {
                         data[i] = 1;
+                        for (int s = 1; s < logdata_nstripes; s++)
+                            data[s * logdata_blocksize + i] = 0;
+                    }
                 }
             }
         }
@@ -132,7 +152,7 @@ static void write_log_data(logdata_t &logData, const char *extension)
                     if (block < values.size()) {
                         data = values[block];
                     }
-                    uint64_t value = data ? (*data)[l] : 0;
+                    uint64_t value = data ? sumLine(*data, l) : 0;
                     if (++l >= logdata_blocksize) {
                         l = 0;
                         block++;
@@ -170,7 +190,7 @@ static void write_lcov_data(logdata_t &logData, const std::string &outfile)
                 if (itv) {
                     logdata_block &data = *itv;
                     for (int i = 0; i < logdata_blocksize; i++) {
-                        auto cov = data[i];
+                        auto cov = sumLine(data, i);
                         if (cov > 0) {
                             n_instrumented++;
                             if (cov > 1)
@@ -170,13 +170,154 @@ static uint32_t crc32c_sse42(uint32_t crc, const char *buf, size_t len)
     return (uint32_t)crc0 ^ 0xffffffff;
 }
 
+/* Wide-block kernel folding 256 bytes per iteration with vector carry-less
+   multiplies, about 3-4x faster than crc32c_sse42 on cores with VPCLMULQDQ
+   (Ice Lake and newer). Requires a compiler recent enough for the 512-bit
+   clmul intrinsics. */
+#  if defined(_CPU_X86_64_) && ((defined(_COMPILER_GCC_) && __GNUC__ >= 10) || \
+        (defined(_COMPILER_CLANG_) && __clang_major__ >= 9))
+#    define JL_CRC32C_HAVE_VPCLMUL
+#    include <immintrin.h>
+
+__attribute__((target("avx512f,avx512vl,vpclmulqdq,pclmul,sse4.2")))
+static uint32_t crc32c_vpclmul(uint32_t crc, const char *buf, size_t len)
+{
+    if (len < 256)
+        return crc32c_sse42(crc, buf, len);
+
+    /* fold the (pre-processed) crc into the first 16 bytes of data */
+    __m512i a0 = _mm512_xor_si512(
+        _mm512_loadu_si512((const void*)buf),
+        _mm512_zextsi128_si512(_mm_cvtsi32_si128((int)(crc ^ 0xffffffff))));
+    __m512i a1 = _mm512_loadu_si512((const void*)(buf + 64));
+    __m512i a2 = _mm512_loadu_si512((const void*)(buf + 128));
+    __m512i a3 = _mm512_loadu_si512((const void*)(buf + 192));
+    buf += 256;
+    len -= 256;
+
+    /* fold 256 bytes at a time into the four accumulators; each 128-bit lane
+       folds onto the lane 256 bytes ahead of it (ternarylogic 0x96 is a
+       three-way xor) */
+    const __m512i k256 = _mm512_broadcast_i32x4(
+        _mm_set_epi64x((long long)crc32c_fold[0][1], (long long)crc32c_fold[0][0]));
+    while (len >= 256) {
+        a0 = _mm512_ternarylogic_epi64(
+            _mm512_clmulepi64_epi128(a0, k256, 0x00),
+            _mm512_clmulepi64_epi128(a0, k256, 0x11),
+            _mm512_loadu_si512((const void*)buf), 0x96);
+        a1 = _mm512_ternarylogic_epi64(
+            _mm512_clmulepi64_epi128(a1, k256, 0x00),
+            _mm512_clmulepi64_epi128(a1, k256, 0x11),
+            _mm512_loadu_si512((const void*)(buf + 64)), 0x96);
+        a2 = _mm512_ternarylogic_epi64(
+            _mm512_clmulepi64_epi128(a2, k256, 0x00),
+            _mm512_clmulepi64_epi128(a2, k256, 0x11),
+            _mm512_loadu_si512((const void*)(buf + 128)), 0x96);
+        a3 = _mm512_ternarylogic_epi64(
+            _mm512_clmulepi64_epi128(a3, k256, 0x00),
+            _mm512_clmulepi64_epi128(a3, k256, 0x11),
+            _mm512_loadu_si512((const void*)(buf + 192)), 0x96);
+        buf += 256;
+        len -= 256;
+    }
+
+    /* fold the four accumulators into the last one */
+    const __m512i k192 = _mm512_broadcast_i32x4(
+        _mm_set_epi64x((long long)crc32c_fold[1][1], (long long)crc32c_fold[1][0]));
+    const __m512i k128 = _mm512_broadcast_i32x4(
+        _mm_set_epi64x((long long)crc32c_fold[2][1], (long long)crc32c_fold[2][0]));
+    const __m512i k64 = _mm512_broadcast_i32x4(
+        _mm_set_epi64x((long long)crc32c_fold[3][1], (long long)crc32c_fold[3][0]));
+    a3 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(a0, k192, 0x00),
+        _mm512_clmulepi64_epi128(a0, k192, 0x11), a3, 0x96);
+    a3 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(a1, k128, 0x00),
+        _mm512_clmulepi64_epi128(a1, k128, 0x11), a3, 0x96);
+    a3 = _mm512_ternarylogic_epi64(
+        _mm512_clmulepi64_epi128(a2, k64, 0x00),
+        _mm512_clmulepi64_epi128(a2, k64, 0x11), a3, 0x96);
+
+    /* fold the four 128-bit lanes into the last one */
+    const __m128i k48 = _mm_set_epi64x((long long)crc32c_fold[4][1],
+                                       (long long)crc32c_fold[4][0]);
+    const __m128i k32 = _mm_set_epi64x((long long)crc32c_fold[5][1],
+                                       (long long)crc32c_fold[5][0]);
+    const __m128i k16 = _mm_set_epi64x((long long)crc32c_fold[6][1],
+                                       (long long)crc32c_fold[6][0]);
+    __m128i x = _mm512_extracti32x4_epi32(a3, 3);
+    __m128i l0 = _mm512_extracti32x4_epi32(a3, 0);
+    __m128i l1 = _mm512_extracti32x4_epi32(a3, 1);
+    __m128i l2 = _mm512_extracti32x4_epi32(a3, 2);
+    x = _mm_xor_si128(x, _mm_xor_si128(_mm_clmulepi64_si128(l0, k48, 0x00),
+                                       _mm_clmulepi64_si128(l0, k48, 0x11)));
+    x = _mm_xor_si128(x, _mm_xor_si128(_mm_clmulepi64_si128(l1, k32, 0x00),
+                                       _mm_clmulepi64_si128(l1, k32, 0x11)));
+    x = _mm_xor_si128(x, _mm_xor_si128(_mm_clmulepi64_si128(l2, k16, 0x00),
+                                       _mm_clmulepi64_si128(l2, k16, 0x11)));
+
+    /* fold the remaining full 16-byte blocks */
+    while (len >= 16) {
+        x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)buf),
+                          _mm_xor_si128(_mm_clmulepi64_si128(x, k16, 0x00),
+                                        _mm_clmulepi64_si128(x, k16, 0x11)));
+        buf += 16;
+        len -= 16;
+    }
+
+    /* reduce the 128-bit accumulator with the crc instruction (which computes
+       exactly the linear remainder of its 8 data bytes), then let the scalar
+       kernel re-condition the crc and finish the sub-16-byte tail */
+    uint64_t r = _mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(x));
+    r = _mm_crc32_u64(r, (uint64_t)_mm_extract_epi64(x, 1));
+    return crc32c_sse42((uint32_t)r ^ 0xffffffff, buf, len);
+}
+
+// When used in ifunc, we cannot call external functions (i.e. jl_cpuid)
+static int crc32c_have_vpclmul(void)
+{
+    uint32_t eax, ebx, ecx, edx;
+    eax = 0; ecx = 0;
+    asm ("cpuid" : "+a" (eax), "=b" (ebx), "+c" (ecx), "=d" (edx));
+    if (eax < 7)
+        return 0;
+    eax = 1; ecx = 0;
+    asm ("cpuid" : "+a" (eax), "=b" (ebx), "+c" (ecx), "=d" (edx));
+    if (!(ecx & (1 << 27)) || !(ecx & (1 << 1))) // OSXSAVE, PCLMULQDQ
+        return 0;
+    uint32_t xlo, xhi;
+    asm ("xgetbv" : "=a" (xlo), "=d" (xhi) : "c" (0));
+    if ((xlo & 0xe6) != 0xe6) // XMM, YMM, opmask and ZMM state enabled
+        return 0;
+    eax = 7; ecx = 0;
+    asm ("cpuid" : "+a" (eax), "=b" (ebx), "+c" (ecx), "=d" (edx));
+    if (!(ebx & (1 << 16)) || !(ebx & (1u << 31))) // AVX512F, AVX512VL
+        return 0;
+    return (ecx & (1 << 10)) != 0; // VPCLMULQDQ
+}
+#  endif
+
 // HW feature detection
 #  ifdef __SSE4_2__
+#    ifdef JL_CRC32C_HAVE_VPCLMUL
+// SSE4.2 is compiled in; only the wide-block kernel needs runtime detection.
+static crc32c_func_t crc32c_dispatch(void)
+{
+    if (crc32c_have_vpclmul())
+        return crc32c_vpclmul;
+    return crc32c_sse42;
+}
+// For ifdef detection below
+#      define crc32c_dispatch crc32c_dispatch
+#      define crc32c_dispatch_ifunc "crc32c_dispatch"
+#    else
 // The C code is compiled with SSE42 being required. Skip runtime dispatch.
+#      define JL_CRC32C_HW_COMPILED
 JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len)
 {
     return crc32c_sse42(crc, buf, len);
 }
+#    endif
 #  else
 static crc32c_func_t crc32c_dispatch(void)
 {
@@ -195,8 +336,13 @@ static crc32c_func_t crc32c_dispatch(void)
         "+a" (eax),
         "=c" (ecx),
         "=d" (edx));
-    if ((ecx >> 20) & 1)
+    if ((ecx >> 20) & 1) {
+#ifdef JL_CRC32C_HAVE_VPCLMUL
+        if (crc32c_have_vpclmul())
+            return crc32c_vpclmul;
+#endif
         return crc32c_sse42;
+    }
     return jl_crc32c_sw;
 }
 // For ifdef detection below
@@ -331,6 +477,7 @@ CRC_TARGET static uint32_t crc32c_armv8(uint32_t crc, const char *buf, size_t le
 // HW feature detection
 #  ifdef __ARM_FEATURE_CRC32
 // The C code is compiled with CRC32 being required. Skip runtime dispatch.
+#    define JL_CRC32C_HW_COMPILED
 JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len)
 {
     return crc32c_armv8(crc, buf, len);
@@ -387,6 +534,23 @@ JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len)
 #  endif
 #endif
 
+/* Report whether jl_crc32c is backed by the hardware kernel, so that callers
+   with a faster software alternative (e.g. memhash) can avoid the table-driven
+   fall-back, which is about 15 times slower than the hardware instructions. */
+JL_DLLEXPORT int jl_crc32c_hw(void)
+{
+#if defined(JL_CRC32C_HW_COMPILED)
+    return 1;
+#elif defined(crc32c_dispatch)
+    static int hw = -1; // benign race: the answer never changes
+    if (hw == -1)
+        hw = crc32c_dispatch() != jl_crc32c_sw;
+    return hw;
+#else
+    return 0;
+#endif
+}
+
 /* Table-driven software version as a fall-back.  This is about 15 times slower
    than using the hardware instructions.  This computes a little-endian
    CRC32c, equivalent to the little-endian CRC of the SSE4.2 or ARMv8 instructions,
@@ -444,6 +608,10 @@ JL_DLLEXPORT uint32_t jl_crc32c_sw(uint32_t crci, const char *buf, size_t len)
 
 #else /* ifdef GEN_CRC32C_TABLES */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 /* Table for a quadword-at-a-time software crc. */
 static uint32_t crc32c_table[8][256];
 
@@ -570,7 +738,95 @@ static void crc32c_init_hw(void)
     crc32c_zeros(crc32c_short, SHORT);
 }
 
-#include <stdio.h>
+/* Fold constants for the carry-less-multiply kernel.  crc32c_fold_lens lists
+   the fold distances; for each distance D, the constant pair (K1, K2) is the
+   unique solution of
+       crc(chunk ++ 0^D) == crc(clmul(chunk_lo, K1) ^ clmul(chunk_hi, K2))
+   for all 128-bit chunks (little-endian, linear crc: zero init, no final
+   xor).  Since crc and clmul are both GF(2)-linear in the chunk, each 64-bit
+   constant is found by Gaussian elimination over the chunk's basis bits. */
+
+static const size_t crc32c_fold_lens[7] = { 256, 192, 128, 64, 48, 32, 16 };
+
+/* linear crc (zero init, no pre/post conditioning) of a message */
+static uint32_t crc32c_lin(const unsigned char *buf, size_t len)
+{
+    uint32_t crc = 0;
+    while (len--)
+        crc = crc32c_table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+/* linear crc of a (16 + zeros)-byte message with a single bit set at bit
+   position p of the leading 16 bytes */
+static uint32_t crc32c_lin_bit(int p, size_t zeros)
+{
+    unsigned char msg[16 + 256];
+    memset(msg, 0, 16 + zeros);
+    msg[p / 8] = (unsigned char)(1u << (p % 8));
+    return crc32c_lin(msg, 16 + zeros);
+}
+
+/* Solve for the constant folding the 64-bit half at bit offset `off` of a
+   128-bit chunk across `zeros` trailing zero bytes.  The product K << i of a
+   set chunk bit i stays within 128 bits for any K with bit 63 clear, which
+   holds for the 33-bit solutions below. */
+static uint64_t crc32c_fold_const(size_t zeros, int off)
+{
+    uint64_t rows[64 * 32];
+    unsigned char rhs[64 * 32];
+    int nr = 0, i, j, b, r, c;
+    for (i = 0; i < 64; i++) {
+        uint32_t target = crc32c_lin_bit(off + i, zeros);
+        uint32_t col[64];
+        for (j = 0; j < 64; j++)
+            col[j] = crc32c_lin_bit(i + j, 0);
+        for (b = 0; b < 32; b++) {
+            uint64_t row = 0;
+            for (j = 0; j < 64; j++)
+                if ((col[j] >> b) & 1)
+                    row |= (uint64_t)1 << j;
+            rows[nr] = row;
+            rhs[nr] = (target >> b) & 1;
+            nr++;
+        }
+    }
+    /* Gaussian elimination over GF(2) */
+    r = 0;
+    for (c = 0; c < 64 && r < nr; c++) {
+        int piv = -1;
+        for (i = r; i < nr; i++)
+            if ((rows[i] >> c) & 1) {
+                piv = i;
+                break;
+            }
+        if (piv < 0)
+            continue;
+        uint64_t tr = rows[r]; rows[r] = rows[piv]; rows[piv] = tr;
+        unsigned char tb = rhs[r]; rhs[r] = rhs[piv]; rhs[piv] = tb;
+        for (i = 0; i < nr; i++)
+            if (i != r && ((rows[i] >> c) & 1)) {
+                rows[i] ^= rows[r];
+                rhs[i] ^= rhs[r];
+            }
+        r++;
+    }
+    uint64_t K = 0;
+    for (i = 0; i < r; i++) {
+        /* pivot is the lowest set bit; free columns are taken as zero */
+        c = 0;
+        while (!((rows[i] >> c) & 1))
+            c++;
+        if (rhs[i])
+            K |= (uint64_t)1 << c;
+    }
+    for (i = r; i < nr; i++)
+        if (rhs[i]) {
+            fprintf(stderr, "inconsistent fold system for %d zeros\n", (int)zeros);
+            abort();
+        }
+    return K;
+}
 
 static void print_array(const char *name, int m, int n, const uint32_t *a)
 {
@@ -595,6 +851,17 @@ int main(void)
     printf("\n");
     print_array("crc32c_long", 4, 256, &crc32c_long[0][0]);
     print_array("crc32c_short", 4, 256, &crc32c_short[0][0]);
+    printf("\n/* Carry-less-multiply constants folding the low/high halves of a 128-bit\n"
+           "   chunk across { 256, 192, 128, 64, 48, 32, 16 } trailing bytes. */\n");
+    printf("JL_UNUSED static const uint64_t crc32c_fold[7][2] = {\n");
+    for (int i = 0; i < 7; ++i) {
+        size_t D = crc32c_fold_lens[i];
+        printf("    { 0x%08llx, 0x%08llx }%s /* %3d bytes */\n",
+               (unsigned long long)crc32c_fold_const(D, 0),
+               (unsigned long long)crc32c_fold_const(D, 64),
+               i == 6 ? " " : ",", (int)D);
+    }
+    printf("};\n");
     return 0;
 }
 
@@ -82,6 +82,7 @@ JL_DLLEXPORT jl_typename_t *jl_new_typename_in(jl_sym_t *name, jl_module_t *modu
     tn->atomicfields = NULL;
     tn->constfields = NULL;
     tn->max_methods = 0;
+    jl_atomic_store_relaxed(&tn->fieldindex_cache, NULL);
     return tn;
 }
 
@@ -174,11 +175,67 @@ HTIMPL_R(layoutcache, _hash_layout_djb2, layout_eq)
 static htable_t layoutcache;
 static int layoutcache_initialized = 0;
 
+// Memo for whole-layout computations of parametric families: maps
+// (typename, per-field layout description) to the layout previously computed
+// for a same-shaped instantiation, so e.g. thousands of SVector{3,T}
+// bits-instantiations after the first are a single hash hit in
+// jl_compute_field_offsets instead of a recomputation. The key captures every
+// input of that computation: the typename (which determines the atomic,
+// const and uninitialized field sets), the special vector alignment of
+// homogeneous tuples, and for every field its inlined layout (interned, so
+// pointer comparison suffices), its union/boxed classification, and the flag
+// bits the computation folds into the result.
+typedef struct {
+    jl_typename_t *name;
+    uint32_t nfields;
+    uint32_t vecalign;
+} jl_layout_memo_header_t;
+typedef struct {
+    const jl_datatype_layout_t *layout; // for inlined datatype fields, else NULL
+    size_t fsz;
+    size_t al;
+    uint8_t isptr;
+    uint8_t isunion;
+    uint8_t zeroinit;
+    uint8_t pointer_egal;
+} jl_layout_memo_field_t;
+
+static size_t layout_memo_nbytes(uint32_t nfields) JL_NOTSAFEPOINT
+{
+    return sizeof(jl_layout_memo_header_t) + nfields * sizeof(jl_layout_memo_field_t);
+}
+
+static uint32_t _hash_layout_memo(uintptr_t _key, void *unused) JL_NOTSAFEPOINT
+{
+    (void)unused;
+    jl_layout_memo_header_t *key = (jl_layout_memo_header_t*)_key;
+    return _hash_djb2(5381, (const char*)key, layout_memo_nbytes(key->nfields));
+}
+
+static int layout_memo_eq(void *_k1, void *_k2, void *unused) JL_NOTSAFEPOINT
+{
+    (void)unused;
+    jl_layout_memo_header_t *k1 = (jl_layout_memo_header_t*)_k1;
+    jl_layout_memo_header_t *k2 = (jl_layout_memo_header_t*)_k2;
+    if (k1->nfields != k2->nfields)
+        return 0;
+    return !memcmp(k1, k2, layout_memo_nbytes(k1->nfields));
+}
+
+//HTPROT(layoutmemo)
+static void **layoutmemo_lookup_bp_r(htable_t *h, void *key, void *ctx) JL_NOTSAFEPOINT;
+static void **layoutmemo_peek_bp_r(htable_t *h, void *key, void *ctx) JL_NOTSAFEPOINT;
+HTPROT_R(layoutmemo)
+HTIMPL_R(layoutmemo, _hash_layout_memo, layout_memo_eq)
+static htable_t layoutmemo;
+static int layoutmemo_initialized = 0;
+
 static jl_datatype_layout_t *jl_get_layout(uint32_t sz,
                                            uint32_t nfields,
                                            uint32_t npointers,
                                            uint32_t alignment,
                                            int haspadding,
+                                           int isbitsegal,
                                            int arrayelem,
                                            jl_fielddesc32_t desc[],
                                            uint32_t pointers[]) JL_NOTSAFEPOINT
@@ -225,6 +282,7 @@ static jl_datatype_layout_t *jl_get_layout(uint32_t sz,
     flddesc->nfields = nfields;
     flddesc->alignment = alignment;
     flddesc->flags.haspadding = haspadding;
+    flddesc->flags.isbitsegal = isbitsegal;
     flddesc->flags.fielddesc_type = fielddesc_type;
     flddesc->flags.arrayelem_isboxed = arrayelem == 1;
     flddesc->flags.arrayelem_isunion = arrayelem == 2;
@@ -547,7 +605,7 @@ void jl_get_genericmemory_layout(jl_datatype_t *st)
     else
         arrayelem = 0;
     assert(!st->layout);
-    st->layout = jl_get_layout(elsz, nfields, npointers, al, haspadding, arrayelem, NULL, pointers);
+    st->layout = jl_get_layout(elsz, nfields, npointers, al, haspadding, 0, arrayelem, NULL, pointers);
     st->zeroinit = zi;
     //st->has_concrete_subtype = 1;
     //st->isbitstype = 0;
@@ -615,7 +673,7 @@ void jl_compute_field_offsets(jl_datatype_t *st)
         }
         else {
             // reuse the same layout for all singletons
-            static const jl_datatype_layout_t singleton_layout = {0, 0, 0, -1, 1, {0}};
+            static const jl_datatype_layout_t singleton_layout = {0, 0, 0, -1, 1, {.isbitsegal = 1}};
             st->layout = &singleton_layout;
         }
     }
@@ -642,7 +700,61 @@ void jl_compute_field_offsets(jl_datatype_t *st)
         isidentityfree &= is_type_identityfree(fld);
     }
 
-    // if we didn't reuse the layout above, compute it now
+    // if we didn't reuse the layout above, check whether an earlier
+    // same-shaped instantiation of this family already computed it
+    jl_layout_memo_header_t *memo = NULL;
+    int memo_malloc = 0;
+    int memo_zeroinit = 0;
+    if (st->layout == NULL) {
+        assert(nfields > 0); // the nfields == 0 cases all assigned a layout above
+        size_t memosz = layout_memo_nbytes(nfields);
+        memo_malloc = memosz >= jl_page_size;
+        memo = memo_malloc ? (jl_layout_memo_header_t*)malloc_s(memosz)
+                           : (jl_layout_memo_header_t*)alloca(memosz);
+        memset(memo, 0, memosz); // padding bytes must compare equal
+        memo->name = st->name;
+        memo->nfields = nfields;
+        jl_layout_memo_field_t *mf = (jl_layout_memo_field_t*)(memo + 1);
+        jl_value_t *firstty = jl_field_type(st, 0);
+        int homogeneous = 1;
+        for (i = 0; i < nfields; i++) {
+            jl_value_t *fld = jl_field_type(st, i);
+            size_t fsz = 0, al = 1;
+            if (jl_islayout_inline(fld, &fsz, &al) && (!jl_field_isatomic(st, i) || jl_is_datatype(fld))) {
+                mf[i].fsz = fsz;
+                mf[i].al = al;
+                if (jl_is_uniontype(fld)) {
+                    mf[i].isunion = 1;
+                    memo_zeroinit = 1;
+                }
+                else {
+                    mf[i].layout = ((jl_datatype_t*)fld)->layout;
+                    mf[i].zeroinit = ((jl_datatype_t*)fld)->zeroinit;
+                    memo_zeroinit |= mf[i].zeroinit;
+                }
+            }
+            else {
+                mf[i].isptr = 1;
+                mf[i].pointer_egal = jl_pointer_egal(fld);
+                memo_zeroinit = 1;
+            }
+            homogeneous &= firstty == fld;
+        }
+        if (homogeneous && jl_is_tuple_type(st))
+            memo->vecalign = jl_special_vector_alignment(nfields, firstty);
+        if (__unlikely(!layoutmemo_initialized)) {
+            htable_new(&layoutmemo, 4096);
+            layoutmemo_initialized = 1;
+        }
+        void *cached = layoutmemo_get_r(&layoutmemo, memo, NULL);
+        if (cached != HT_NOTFOUND) {
+            st->layout = (const jl_datatype_layout_t*)cached;
+            st->zeroinit = memo_zeroinit;
+            if (memo_malloc)
+                free(memo);
+        }
+    }
+    // no same-shaped predecessor: compute the layout from scratch
     if (st->layout == NULL) {
         size_t descsz = nfields * sizeof(jl_fielddesc32_t);
         jl_fielddesc32_t *desc;
@@ -656,6 +768,7 @@ void jl_compute_field_offsets(jl_datatype_t *st)
         size_t alignm = 1;
         int zeroinit = 0;
         int haspadding = 0;
+        int isbitsegal = 1;
         int homogeneous = 1;
         int needlock = 0;
         uint32_t npointers = 0;
@@ -671,6 +784,8 @@ void jl_compute_field_offsets(jl_datatype_t *st)
                 desc[i].isptr = 0;
                 if (jl_is_uniontype(fld)) {
                     haspadding = 1;
+                    // TODO: Some unions could be bits comparable.
+                    isbitsegal = 0;
                     fsz += 1; // selector byte
                     zeroinit = 1;
                 }
@@ -678,11 +793,14 @@ void jl_compute_field_offsets(jl_datatype_t *st)
                     uint32_t fld_npointers = ((jl_datatype_t*)fld)->layout->npointers;
                     if (((jl_datatype_t*)fld)->layout->flags.haspadding)
                         haspadding = 1;
+                    if (!((jl_datatype_t*)fld)->layout->flags.isbitsegal)
+                        isbitsegal = 0;
                     if (i >= nfields - st->name->n_uninitialized && fld_npointers &&
                         fld_npointers * sizeof(void*) != fsz) {
                         // field may be undef (may be uninitialized and contains pointer),
-                        // and contains non-pointer fields of non-zero sizes.
-                        haspadding = 1;
+                        // and contains non-pointer fields of non-zero sizes; the data bits
+                        // of an undef field are unspecified, so egal must go field-by-field.
+                        isbitsegal = 0;
                     }
                     if (!zeroinit)
                         zeroinit = ((jl_datatype_t*)fld)->zeroinit;
@@ -698,8 +816,9 @@ void jl_compute_field_offsets(jl_datatype_t *st)
                 zeroinit = 1;
                 npointers++;
                 if (!jl_pointer_egal(fld)) {
-                    // this somewhat poorly named flag says whether some of the bits can be non-unique
-                    haspadding = 1;
+                    // pointed-to objects of this type can be egal without being
+                    // pointer-identical, so comparing the pointer bits is not enough
+                    isbitsegal = 0;
                 }
             }
             if (isatomic && fsz > MAX_ATOMIC_SIZE)
@@ -760,13 +879,21 @@ void jl_compute_field_offsets(jl_datatype_t *st)
             }
         }
         assert(ptr_i == npointers);
-        st->layout = jl_get_layout(sz, nfields, npointers, alignm, haspadding, 0, desc, pointers);
+        st->layout = jl_get_layout(sz, nfields, npointers, alignm, haspadding, isbitsegal, 0, desc, pointers);
         if (should_malloc) {
             free(desc);
             if (npointers)
                 free(pointers);
         }
+        assert(zeroinit == memo_zeroinit); // the memo key must capture every input
         st->zeroinit = zeroinit;
+        // remember the shape for the rest of the family
+        size_t memosz = layout_memo_nbytes(nfields);
+        jl_layout_memo_header_t *permkey = (jl_layout_memo_header_t*)malloc_s(memosz);
+        memcpy(permkey, memo, memosz);
+        layoutmemo_put_r(&layoutmemo, permkey, (void*)st->layout, NULL);
+        if (memo_malloc)
+            free(memo);
     }
     // now finish deciding if this instantiation qualifies for special properties
     assert(!isbitstype || st->layout->npointers == 0); // the definition of isbits
@@ -922,7 +1049,7 @@ JL_DLLEXPORT jl_datatype_t *jl_new_primitivetype(jl_value_t *name, jl_module_t *
     bt->ismutationfree = 1;
     bt->isidentityfree = 1;
     bt->isbitstype = (parameters == jl_emptysvec);
-    bt->layout = jl_get_layout(nbytes, 0, 0, alignm, 0, 0, NULL, NULL);
+    bt->layout = jl_get_layout(nbytes, 0, 0, alignm, 0, 1, 0, NULL, NULL);
     bt->instance = NULL;
     return bt;
 }
@@ -945,6 +1072,7 @@ JL_DLLEXPORT jl_datatype_t * jl_new_foreign_type(jl_sym_t *name,
     layout->alignment = sizeof(void *);
     layout->npointers = haspointers;
     layout->flags.haspadding = 1;
+    layout->flags.isbitsegal = 0;
     layout->flags.fielddesc_type = 3;
     layout->flags.padding = 0;
     layout->flags.arrayelem_isboxed = 0;
@@ -1228,7 +1356,7 @@ JL_DLLEXPORT jl_value_t *jl_atomic_cmpswap_bits(jl_datatype_t *dt, jl_datatype_t
     }
     else if (nb == 1) {
         uint8_t *y8 = (uint8_t*)y;
-        assert(!dt->layout->flags.haspadding);
+        assert(!dt->layout->flags.haspadding && dt->layout->flags.isbitsegal);
         if (dt == et) {
             *y8 = *(uint8_t*)expected;
             uint8_t z8 = *(uint8_t*)src;
@@ -1241,7 +1369,7 @@ JL_DLLEXPORT jl_value_t *jl_atomic_cmpswap_bits(jl_datatype_t *dt, jl_datatype_t
     }
     else if (nb == 2) {
         uint16_t *y16 = (uint16_t*)y;
-        assert(!dt->layout->flags.haspadding);
+        assert(!dt->layout->flags.haspadding && dt->layout->flags.isbitsegal);
         if (dt == et) {
             *y16 = *(uint16_t*)expected;
             uint16_t z16 = *(uint16_t*)src;
@@ -1259,7 +1387,7 @@ JL_DLLEXPORT jl_value_t *jl_atomic_cmpswap_bits(jl_datatype_t *dt, jl_datatype_t
             uint32_t z32 = zext_read32(src, nb);
             while (1) {
                 success = jl_atomic_cmpswap((_Atomic(uint32_t)*)dst, y32, z32);
-                if (success || !dt->layout->flags.haspadding || !jl_egal__bits(y, expected, dt))
+                if (success || (!dt->layout->flags.haspadding && dt->layout->flags.isbitsegal) || !jl_egal__bits(y, expected, dt))
                     break;
             }
         }
@@ -1276,7 +1404,7 @@ JL_DLLEXPORT jl_value_t *jl_atomic_cmpswap_bits(jl_datatype_t *dt, jl_datatype_t
             uint64_t z64 = zext_read64(src, nb);
             while (1) {
                 success = jl_atomic_cmpswap((_Atomic(uint64_t)*)dst, y64, z64);
-                if (success || !dt->layout->flags.haspadding || !jl_egal__bits(y, expected, dt))
+                if (success || (!dt->layout->flags.haspadding && dt->layout->flags.isbitsegal) || !jl_egal__bits(y, expected, dt))
                     break;
             }
         }
@@ -1294,7 +1422,7 @@ JL_DLLEXPORT jl_value_t *jl_atomic_cmpswap_bits(jl_datatype_t *dt, jl_datatype_t
             jl_uint128_t z128 = zext_read128(src, nb);
             while (1) {
                 success = jl_atomic_cmpswap((_Atomic(jl_uint128_t)*)dst, y128, z128);
-                if (success || !dt->layout->flags.haspadding || !jl_egal__bits(y, expected, dt))
+                if (success || (!dt->layout->flags.haspadding && dt->layout->flags.isbitsegal) || !jl_egal__bits(y, expected, dt))
                     break;
             }
         }
@@ -1617,6 +1745,49 @@ JL_DLLEXPORT void jl_unlock_value(jl_value_t *v) JL_NOTSAFEPOINT
     JL_UNLOCK_NOGC((jl_mutex_t*)v);
 }
 
+// Wide types get an open-addressed symbol-hash table mapping name to field
+// index, built lazily on the first lookup, so dynamic getfield on generated
+// record types is not a linear scan of the name svec. Narrower types stay on
+// the scan, which beats the table below this size.
+#define FIELDINDEX_HASH_THRESHOLD 16
+
+static uint32_t fieldindex_ht_size(size_t n) JL_NOTSAFEPOINT
+{
+    // power of two with load factor <= 0.5, so probing always finds an empty slot
+    uint32_t sz = FIELDINDEX_HASH_THRESHOLD;
+    while (sz < 2 * n)
+        sz <<= 1;
+    return sz;
+}
+
+static int32_t *jl_build_fieldindex_cache(jl_typename_t *tn, jl_svec_t *fn) JL_NOTSAFEPOINT
+{
+    size_t i, n = jl_svec_len(fn);
+    uint32_t sz = fieldindex_ht_size(n);
+    int32_t *ht = (int32_t*)malloc(sz * sizeof(int32_t));
+    if (ht == NULL)
+        return NULL;
+    memset(ht, 0xff, sz * sizeof(int32_t)); // all slots -1 (empty)
+    for (i = 0; i < n; i++) {
+        jl_value_t *name = jl_svecref(fn, i);
+        if (!jl_is_symbol(name)) {
+            free(ht);
+            return NULL;
+        }
+        uint32_t slot = ((jl_sym_t*)name)->hash & (sz - 1);
+        while (ht[slot] != -1)
+            slot = (slot + 1) & (sz - 1);
+        ht[slot] = (int32_t)i;
+    }
+    int32_t *expected = NULL;
+    if (!jl_atomic_cmpswap(&tn->fieldindex_cache, &expected, ht)) {
+        // another thread published an identical table first
+        free(ht);
+        ht = expected;
+    }
+    return ht;
+}
+
 JL_DLLEXPORT int jl_field_index(jl_datatype_t *t, jl_sym_t *fld, int err)
 {
     if (jl_is_namedtuple_type(t)) {
@@ -1633,6 +1804,24 @@ JL_DLLEXPORT int jl_field_index(jl_datatype_t *t, jl_sym_t *fld, int err)
     else {
         jl_svec_t *fn = jl_field_names(t);
         size_t i, n = jl_svec_len(fn);
+        if (n >= FIELDINDEX_HASH_THRESHOLD) {
+            int32_t *ht = jl_atomic_load_acquire(&t->name->fieldindex_cache);
+            if (ht == NULL)
+                ht = jl_build_fieldindex_cache(t->name, fn);
+            if (ht != NULL) {
+                uint32_t sz = fieldindex_ht_size(n);
+                uint32_t slot = fld->hash & (sz - 1);
+                int32_t idx;
+                while ((idx = ht[slot]) != -1) {
+                    if (jl_svecref(fn, idx) == (jl_value_t*)fld)
+                        return idx;
+                    slot = (slot + 1) & (sz - 1);
+                }
+                if (err)
+                    jl_has_no_field_error(t->name->name, fld);
+                return -1;
+            }
+        }
         for (i = 0; i < n; i++) {
             if (jl_svecref(fn, i) == (jl_value_t*)fld) {
                 return (int)i;
@@ -1985,7 +2174,7 @@ jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_val
             memcpy((char*)r, (char*)v + offs, fsz); // copy field, including union bits
             if (success) {
                 size_t fsz = jl_datatype_size((jl_datatype_t*)rty); // need to shrink-wrap the final copy
-                if (((jl_datatype_t*)rty)->layout->flags.haspadding)
+                if (((jl_datatype_t*)rty)->layout->flags.haspadding || !((jl_datatype_t*)rty)->layout->flags.isbitsegal)
                     success = jl_egal__bits(r, expected, (jl_datatype_t*)rty);
                 else
                     success = memcmp((char*)r, (char*)expected, fsz) == 0;
@@ -4,7 +4,9 @@
 
 #include "julia.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 
@@ -104,7 +106,9 @@ private:
         size_t SectionSize = 0;
         ptrdiff_t slide = 0;
         llvm::object::SectionRef Section{};
-        llvm::DIContext *context = nullptr;
+        // DWARF context, created on first use and filled in with a single
+        // compare-exchange; shared by every snapshot containing this object
+        std::shared_ptr<std::atomic<llvm::DIContext *>> context{};
     };
 
     template<typename KeyT, typename ValT>
@@ -112,9 +116,17 @@ private:
 
     typedef rev_map<size_t, ObjectInfo> objectmap_t;
     typedef rev_map<uint64_t, objfileentry_t> objfilemap_t;
-
-    objectmap_t objectmap{};
-    rev_map<size_t, std::pair<size_t, jl_method_instance_t *>> linfomap{};
+    typedef rev_map<size_t, std::pair<size_t, jl_method_instance_t *>> linfomap_t;
+
+    // The object and linfo maps are kept as immutable snapshots: lookups
+    // atomically load the current snapshot and may keep using it without any
+    // further synchronization, while registration copies the snapshot, adds
+    // the new entries and publishes the copy under `snapshot_lock`. This way
+    // stack walks and function-info queries neither block nor are blocked by
+    // the JIT emitting new code.
+    std::shared_ptr<const objectmap_t> objectmap;
+    std::shared_ptr<const linfomap_t> linfomap;
+    std::mutex snapshot_lock; // serializes snapshot writers only
 
     // Maintain a mapping of unrealized function names -> linfo objects
     // so that when we see it get emitted, we can add a link back to the linfo
@@ -139,7 +151,7 @@ public:
     void registerJITObject(const llvm::object::ObjectFile &Object,
                         std::function<uint64_t(const llvm::StringRef &)> getLoadAddress,
                         std::function<void*(void*)> lookupWriteAddress);
-    objectmap_t& getObjectMap() JL_NOTSAFEPOINT;
+    std::shared_ptr<const objectmap_t> getObjectMap() JL_NOTSAFEPOINT;
     void add_image_info(image_info_t info) JL_NOTSAFEPOINT;
     bool get_image_info(uint64_t base, image_info_t *info) const JL_NOTSAFEPOINT;
     Locked<objfilemap_t>::LockT get_objfile_map() JL_NOTSAFEPOINT;
@@ -30,11 +30,18 @@ using namespace llvm;
 #include "debuginfo.h"
 #if defined(_OS_LINUX_)
 #  include <link.h>
+#  include <elf.h>
+#  include <fcntl.h>
+#  include <inttypes.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
 #endif
 #include "processor.h"
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <set>
 #include <mutex>
@@ -95,20 +102,19 @@ void JITDebugInfoRegistry::add_code_in_flight(StringRef name, jl_code_instance_t
 
 jl_method_instance_t *JITDebugInfoRegistry::lookupLinfo(size_t pointer)
 {
-    jl_lock_profile();
-    auto region = linfomap.lower_bound(pointer);
+    auto linfomap = std::atomic_load_explicit(&this->linfomap, std::memory_order_acquire);
+    auto region = linfomap->lower_bound(pointer);
     jl_method_instance_t *linfo = NULL;
-    if (region != linfomap.end() && pointer < region->first + region->second.first)
+    if (region != linfomap->end() && pointer < region->first + region->second.first)
         linfo = region->second.second;
-    jl_unlock_profile();
     return linfo;
 }
 
-//Protected by debuginfo_asyncsafe (profile) lock
-JITDebugInfoRegistry::objectmap_t &
+// Returns the current (immutable) snapshot; safe to use without locks
+std::shared_ptr<const JITDebugInfoRegistry::objectmap_t>
 JITDebugInfoRegistry::getObjectMap()
 {
-    return objectmap;
+    return std::atomic_load_explicit(&objectmap, std::memory_order_acquire);
 }
 
 void JITDebugInfoRegistry::add_image_info(image_info_t info) {
@@ -131,7 +137,9 @@ JITDebugInfoRegistry::get_objfile_map() {
     return *this->objfilemap;
 }
 
-JITDebugInfoRegistry::JITDebugInfoRegistry() { }
+JITDebugInfoRegistry::JITDebugInfoRegistry()
+    : objectmap(std::make_shared<objectmap_t>()),
+      linfomap(std::make_shared<linfomap_t>()) { }
 
 struct unw_table_entry
 {
@@ -221,6 +229,148 @@ static void create_PRUNTIME_FUNCTION(uint8_t *Code, size_t Size, StringRef fnnam
 }
 #endif
 
+#if defined(_OS_LINUX_)
+// Emit JIT'd frames in the formats understood by stock Linux perf(1):
+// the jitdump file consumed by `perf inject --jit` and, as a fallback for
+// tools that only read it, the classic /tmp/perf-<pid>.map symbol table.
+// Both are written only when JULIA_PERF_JITDUMP is set, so the steady-state
+// cost is a single predictable branch per registered object.
+
+// matches the layout in tools/perf/util/jitdump.h
+typedef struct {
+    uint32_t magic;      // "JiTD"
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t elf_mach;
+    uint32_t pad1;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+} jitdump_file_header_t;
+
+typedef struct {
+    uint32_t id;         // JIT_CODE_LOAD
+    uint32_t total_size;
+    uint64_t timestamp;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t code_addr;
+    uint64_t code_size;
+    uint64_t code_index;
+} jitdump_code_load_t;
+
+#define JIT_DUMP_MAGIC 0x4A695444
+#define JIT_DUMP_VERSION 1
+#define JIT_CODE_LOAD 0
+
+static uint64_t perf_timestamp(void) JL_NOTSAFEPOINT
+{
+    // perf records are matched against `perf record -k mono`
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+class JITPerfDump {
+    FILE *dumpfile = nullptr;
+    FILE *mapfile = nullptr;
+    uint64_t code_index = 0;
+    std::mutex mutex;
+
+public:
+    JITPerfDump() JL_NOTSAFEPOINT
+    {
+        const char *env = getenv("JULIA_PERF_JITDUMP");
+        if (!env || !atoi(env))
+            return;
+        uint32_t pid = (uint32_t)getpid();
+        char path[64];
+        // perf locates the jitdump through the mmap record below, so the
+        // directory is arbitrary; the conventional place is the cwd.
+        snprintf(path, sizeof(path), "jit-%u.dump", pid);
+        int fd = open(path, O_CREAT | O_TRUNC | O_RDWR, 0666);
+        if (fd == -1)
+            return;
+        dumpfile = fdopen(fd, "w");
+        if (!dumpfile) {
+            close(fd);
+            return;
+        }
+        jitdump_file_header_t header;
+        memset(&header, 0, sizeof(header));
+        header.magic = JIT_DUMP_MAGIC;
+        header.version = JIT_DUMP_VERSION;
+        header.total_size = sizeof(header);
+#if defined(_CPU_X86_64_)
+        header.elf_mach = EM_X86_64;
+#elif defined(_CPU_X86_)
+        header.elf_mach = EM_386;
+#elif defined(_CPU_AARCH64_)
+        header.elf_mach = EM_AARCH64;
+#elif defined(_CPU_ARM_)
+        header.elf_mach = EM_ARM;
+#elif defined(_CPU_PPC64_)
+        header.elf_mach = EM_PPC64;
+#else
+        header.elf_mach = EM_NONE;
+#endif
+        header.pid = pid;
+        header.timestamp = perf_timestamp();
+        fwrite(&header, sizeof(header), 1, dumpfile);
+        fflush(dumpfile);
+        // perf record only keeps jitdump files it sees mapped executable;
+        // the mapping marks the file and is never touched again (it is
+        // intentionally leaked for the life of the process)
+        void *marker = mmap(NULL, jl_getpagesize(), PROT_READ | PROT_EXEC,
+                            MAP_PRIVATE, fd, 0);
+        if (marker == MAP_FAILED) {
+            fclose(dumpfile);
+            dumpfile = nullptr;
+            return;
+        }
+        (void)marker;
+        snprintf(path, sizeof(path), "/tmp/perf-%u.map", pid);
+        mapfile = fopen(path, "w");
+    }
+
+    void add_code(StringRef name, uint64_t addr, uint64_t size) JL_NOTSAFEPOINT
+    {
+        if (!dumpfile || size == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        jitdump_code_load_t rec;
+        rec.id = JIT_CODE_LOAD;
+        rec.total_size = sizeof(rec) + name.size() + 1 + size;
+        rec.timestamp = perf_timestamp();
+        rec.pid = (uint32_t)getpid();
+        rec.tid = (uint32_t)syscall(SYS_gettid);
+        rec.vma = addr;
+        rec.code_addr = addr;
+        rec.code_size = size;
+        rec.code_index = code_index++;
+        fwrite(&rec, sizeof(rec), 1, dumpfile);
+        fwrite(name.data(), 1, name.size(), dumpfile);
+        fputc('\0', dumpfile);
+        // the executable mapping is readable, so the code bytes can be
+        // copied straight out of it
+        fwrite((const void*)(uintptr_t)addr, 1, size, dumpfile);
+        fflush(dumpfile);
+        if (mapfile) {
+            fprintf(mapfile, "%" PRIx64 " %" PRIx64 " %.*s\n",
+                    addr, size, (int)name.size(), name.data());
+            fflush(mapfile);
+        }
+    }
+};
+
+static JITPerfDump &getJITPerfDump() JL_NOTSAFEPOINT
+{
+    static JITPerfDump perf_dump;
+    return perf_dump;
+}
+#endif
+
 void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
                         std::function<uint64_t(const StringRef &)> getLoadAddress,
                         std::function<void*(void*)> lookupWriteAddress)
@@ -337,6 +487,9 @@ void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
 
     auto symbols = object::computeSymbolSizes(Object);
     bool first = true;
+    size_t object_addr = 0;
+    ObjectInfo object_entry{};
+    SmallVector<std::pair<size_t, std::pair<size_t, jl_method_instance_t *>>, 8> new_linfos;
     for (const auto &sym_size : symbols) {
         const object::SymbolRef &sym_iter = sym_size.first;
         object::SymbolRef::Type SymbolType = cantFail(sym_iter.getType());
@@ -361,6 +514,9 @@ void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
         create_PRUNTIME_FUNCTION(
                 (uint8_t*)(uintptr_t)Addr, (size_t)Size, sName,
                 (uint8_t*)(uintptr_t)SectionLoadAddr, (size_t)SectionSize, UnwindData);
+#endif
+#if defined(_OS_LINUX_)
+        getJITPerfDump().add_code(sName, Addr, Size);
 #endif
         jl_code_instance_t *codeinst = NULL;
         {
@@ -382,20 +538,44 @@ void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
             if (jl_is_method(mi->def.value) && mi->def.method->is_for_opaque_closure)
                 mi = (jl_method_instance_t*)jl_as_global_root((jl_value_t*)mi, 1);
         }
-        jl_profile_atomic([&]() JL_NOTSAFEPOINT {
-            if (mi)
-                linfomap[Addr] = std::make_pair(Size, mi);
-            if (first) {
-                objectmap[SectionLoadAddr] = {&Object,
-                    (size_t)SectionSize,
-                    (ptrdiff_t)(SectionAddr - SectionLoadAddr),
-                    *Section,
-                    nullptr,
-                    };
-                first = false;
-            }
-        });
+        if (mi)
+            new_linfos.push_back(std::make_pair((size_t)Addr, std::make_pair((size_t)Size, mi)));
+        if (first) {
+            object_addr = SectionLoadAddr;
+            object_entry = {&Object,
+                (size_t)SectionSize,
+                (ptrdiff_t)(SectionAddr - SectionLoadAddr),
+                *Section,
+                std::make_shared<std::atomic<llvm::DIContext *>>(nullptr),
+                };
+            first = false;
+        }
     }
+    // Publish fresh snapshots containing this object's entries. Concurrent
+    // lookups keep reading the old snapshots; neither side ever blocks the
+    // other, and signal handlers observing either snapshot see a fully
+    // constructed map.
+    std::lock_guard<std::mutex> lock(snapshot_lock);
+    if (!new_linfos.empty()) {
+        auto newmap = std::make_shared<linfomap_t>(
+                *std::atomic_load_explicit(&linfomap, std::memory_order_relaxed));
+        for (auto &entry : new_linfos)
+            (*newmap)[entry.first] = entry.second;
+        std::atomic_store_explicit(&linfomap,
+                std::shared_ptr<const linfomap_t>(std::move(newmap)),
+                std::memory_order_release);
+    }
+    if (!first) {
+        auto newmap = std::make_shared<objectmap_t>(
+                *std::atomic_load_explicit(&objectmap, std::memory_order_relaxed));
+        (*newmap)[object_addr] = std::move(object_entry);
+        std::atomic_store_explicit(&objectmap,
+                std::shared_ptr<const objectmap_t>(std::move(newmap)),
+                std::memory_order_release);
+    }
+    // the addresses covered by this object may have been looked up (and missed)
+    // before; invalidate the per-thread ip lookup caches
+    jl_atomic_fetch_add(&jl_debuginfo_generation, 1);
 }
 
 void jl_register_jit_object(const object::ObjectFile &Object,
@@ -702,6 +882,7 @@ void jl_register_fptrs_impl(uint64_t image_base, const jl_image_fptrs_t *fptrs,
     jl_method_instance_t **linfos, size_t n)
 {
     getJITDebugRegistry().add_image_info({(uintptr_t) image_base, *fptrs, linfos, n});
+    jl_atomic_fetch_add(&jl_debuginfo_generation, 1);
 }
 
 template<typename T>
@@ -1204,25 +1385,35 @@ int jl_DI_for_fptr(uint64_t fptr, uint64_t *symsize, int64_t *slide,
         object::SectionRef *Section, llvm::DIContext **context) JL_NOTSAFEPOINT
 {
     int found = 0;
-    assert(0 == jl_lock_profile_rd_held());
-    jl_lock_profile_wr();
 
     if (symsize)
         *symsize = 0;
 
-    auto &objmap = getJITDebugRegistry().getObjectMap();
-    auto fit = objmap.lower_bound(fptr);
-    if (fit != objmap.end() && fptr < fit->first + fit->second.SectionSize) {
+    auto objmap = getJITDebugRegistry().getObjectMap();
+    auto fit = objmap->lower_bound(fptr);
+    if (fit != objmap->end() && fptr < fit->first + fit->second.SectionSize) {
         *slide = fit->second.slide;
         *Section = fit->second.Section;
         if (context) {
-            if (fit->second.context == nullptr)
-                fit->second.context = DWARFContext::create(*fit->second.object).release();
-            *context = fit->second.context;
+            // the DWARF context is created at most once and shared by every
+            // snapshot holding this object, so losers of the race delete
+            // their copy and use the winner's
+            *context = fit->second.context->load(std::memory_order_acquire);
+            if (*context == nullptr) {
+                llvm::DIContext *ctx = DWARFContext::create(*fit->second.object).release();
+                llvm::DIContext *expected = nullptr;
+                if (fit->second.context->compare_exchange_strong(expected, ctx,
+                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    *context = ctx;
+                }
+                else {
+                    delete ctx;
+                    *context = expected;
+                }
+            }
         }
         found = 1;
     }
-    jl_unlock_profile_wr();
     return found;
 }
 
@@ -1621,13 +1812,11 @@ extern "C" JL_DLLEXPORT_CODEGEN
 uint64_t jl_getUnwindInfo_impl(uint64_t dwAddr)
 {
     // Might be called from unmanaged thread
-    jl_lock_profile();
-    auto &objmap = getJITDebugRegistry().getObjectMap();
-    auto it = objmap.lower_bound(dwAddr);
+    auto objmap = getJITDebugRegistry().getObjectMap();
+    auto it = objmap->lower_bound(dwAddr);
     uint64_t ipstart = 0; // ip of the start of the section (if found)
-    if (it != objmap.end() && dwAddr < it->first + it->second.SectionSize) {
+    if (it != objmap->end() && dwAddr < it->first + it->second.SectionSize) {
         ipstart = (uint64_t)(uintptr_t)(*it).first;
     }
-    jl_unlock_profile();
     return ipstart;
 }
@@ -283,8 +283,10 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
     is_atpath = 0;
 
     JL_TIMING(DL_OPEN, DL_OPEN);
-    if (!(flags & JL_RTLD_NOLOAD))
+    if (!(flags & JL_RTLD_NOLOAD)) {
         jl_timing_puts(JL_TIMING_DEFAULT_BLOCK, modname);
+        jl_startup_trace_enter(modname);
+    }
 
     // Detect if our `modname` is something like `@rpath/libfoo.dylib`
 #ifdef _OS_DARWIN_
@@ -341,8 +343,10 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
                     if (i == 0) { // LoadLibrary already tested the extensions, we just need to check the `stat` result
 #endif
                         handle = jl_dlopen(path, flags);
-                        if (handle && !(flags & JL_RTLD_NOLOAD))
+                        if (handle && !(flags & JL_RTLD_NOLOAD)) {
                             jl_timing_puts(JL_TIMING_DEFAULT_BLOCK, jl_pathname_for_handle(handle));
+                            jl_startup_trace_exit(modname);
+                        }
                         if (handle)
                             return handle;
 #ifdef _OS_WINDOWS_
@@ -363,8 +367,10 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
         path[0] = '\0';
         snprintf(path, PATHBUF, "%s%s", modname, ext);
         handle = jl_dlopen(path, flags);
-        if (handle && !(flags & JL_RTLD_NOLOAD))
+        if (handle && !(flags & JL_RTLD_NOLOAD)) {
             jl_timing_puts(JL_TIMING_DEFAULT_BLOCK, jl_pathname_for_handle(handle));
+            jl_startup_trace_exit(modname);
+        }
         if (handle)
             return handle;
 #ifdef _OS_WINDOWS_
@@ -378,6 +384,8 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
     }
 
 notfound:
+    if (!(flags & JL_RTLD_NOLOAD))
+        jl_startup_trace_exit(modname);
     if (throw_err) {
 #ifdef _OS_WINDOWS_
         char reason[256];
@@ -255,11 +255,49 @@ static symbol_t **symtab_lookup(symbol_t **ptree, const char *str)
     return ptree;
 }
 
+// find the index slot for `str`: either the slot holding its symbol, or the
+// empty slot where it belongs
+static symbol_t **symtab_index_slot(fl_context_t *fl_ctx, const char *str, uint32_t hash)
+{
+    size_t mask = fl_ctx->symtab_index_sz - 1;
+    size_t i = hash & mask;
+    while (1) {
+        symbol_t *s = fl_ctx->symtab_index[i];
+        if (s == NULL || (s->hash == hash && !strcmp(s->name, str)))
+            return &fl_ctx->symtab_index[i];
+        i = (i + 1) & mask;
+    }
+}
+
+static void symtab_index_grow(fl_context_t *fl_ctx, size_t newsz)
+{
+    symbol_t **old = fl_ctx->symtab_index;
+    size_t oldsz = fl_ctx->symtab_index_sz;
+    fl_ctx->symtab_index = (symbol_t**)calloc(newsz, sizeof(symbol_t*));
+    // TODO: if symtab_index == NULL
+    fl_ctx->symtab_index_sz = newsz;
+    for (size_t i = 0; i < oldsz; i++) {
+        symbol_t *s = old[i];
+        if (s != NULL)
+            *symtab_index_slot(fl_ctx, s->name, s->hash) = s;
+    }
+    free(old);
+}
+
 value_t symbol(fl_context_t *fl_ctx, const char *str)
 {
+    uint32_t hash = memhash32(str, strlen(str))^0xAAAAAAAA;
+    if (fl_ctx->symtab_index == NULL)
+        symtab_index_grow(fl_ctx, 1024);
+    symbol_t **slot = symtab_index_slot(fl_ctx, str, hash);
+    if (*slot != NULL)
+        return tagptr(*slot, TAG_SYM);
     symbol_t **pnode = symtab_lookup(&fl_ctx->symtab, str);
     if (*pnode == NULL)
         *pnode = mk_symbol(str);
+    *slot = *pnode;
+    if (++fl_ctx->symtab_nsyms * 2 >= fl_ctx->symtab_index_sz)
+        symtab_index_grow(fl_ctx, fl_ctx->symtab_index_sz * 2);
     return tagptr(*pnode, TAG_SYM);
 }
 
@@ -554,7 +592,7 @@ void gc(fl_context_t *fl_ctx, int mustgrow)
     fl_ctx->tochain = NULL;
     fl_ctx->n_allocd = -100000000000LL;
 #else
-    size_t hsz = fl_ctx->gc_grew ? fl_ctx->heapsize*2 : fl_ctx->heapsize;
+    size_t hsz = fl_ctx->gc_grew ? fl_ctx->heapsize_target : fl_ctx->heapsize;
 #ifdef MEMDEBUG
     fl_ctx->tospace = LLT_ALLOC(hsz);
 #endif
@@ -613,29 +651,48 @@ void gc(fl_context_t *fl_ctx, int mustgrow)
     fl_ctx->tospace = fl_ctx->fromspace;
     fl_ctx->fromspace = (unsigned char*)temp;
 
-    // if we're using > 80% of the space, resize tospace so we have
-    // more space to fill next time. if we grew tospace last time,
-    // grow the other half of the heap this time to catch up.
-    if (fl_ctx->gc_grew || mustgrow
-#ifdef MEMDEBUG
-        // GC more often
-        || ((fl_ctx->lim-fl_ctx->curheap) < (int)(fl_ctx->heapsize/128))
-#else
-        || ((fl_ctx->lim-fl_ctx->curheap) < (int)(fl_ctx->heapsize/5))
-#endif
-        ) {
-        temp = LLT_REALLOC(fl_ctx->tospace, fl_ctx->heapsize*2);
+    if (fl_ctx->gc_grew) {
+        // the space we just evacuated into already has the new size; bring
+        // the other semispace and the cons flags up (or down) to match
+        temp = LLT_REALLOC(fl_ctx->tospace, fl_ctx->heapsize_target);
         if (temp == NULL)
             fl_raise(fl_ctx, fl_ctx->memory_exception_value);
         fl_ctx->tospace = (unsigned char*)temp;
-        if (fl_ctx->gc_grew) {
-            fl_ctx->heapsize*=2;
-            temp = bitvector_resize(fl_ctx->consflags, 0, fl_ctx->heapsize/sizeof(cons_t), 1);
+        fl_ctx->heapsize = fl_ctx->heapsize_target;
+        temp = bitvector_resize(fl_ctx->consflags, 0, fl_ctx->heapsize/sizeof(cons_t), 1);
+        if (temp == NULL)
+            fl_raise(fl_ctx, fl_ctx->memory_exception_value);
+        fl_ctx->consflags = (uint32_t*)temp;
+        fl_ctx->gc_grew = 0;
+    }
+    else {
+        // if we're using > 80% of the space, pick a new semispace size from
+        // the survival rate: grow geometrically until surviving data would
+        // occupy less than 1/4 of a semispace, so heavy workloads (lowering
+        // large generated files) reach a big enough heap in one resize
+        // instead of doubling once per collection. resize the empty tospace
+        // now; the live space follows after the next collection evacuates
+        // into it.
+        size_t live = (size_t)(fl_ctx->curheap - fl_ctx->fromspace);
+        size_t target = fl_ctx->heapsize;
+        if (mustgrow
+#ifdef MEMDEBUG
+            // GC more often
+            || ((fl_ctx->lim-fl_ctx->curheap) < (int)(fl_ctx->heapsize/128))
+#else
+            || ((fl_ctx->lim-fl_ctx->curheap) < (int)(fl_ctx->heapsize/5))
+#endif
+            ) {
+            target *= 2;
+            while (live >= target/4)
+                target *= 2;
+            temp = LLT_REALLOC(fl_ctx->tospace, target);
             if (temp == NULL)
                 fl_raise(fl_ctx, fl_ctx->memory_exception_value);
-            fl_ctx->consflags = (uint32_t*)temp;
+            fl_ctx->tospace = (unsigned char*)temp;
+            fl_ctx->heapsize_target = target;
+            fl_ctx->gc_grew = 1;
         }
-        fl_ctx->gc_grew = !fl_ctx->gc_grew;
     }
 #ifdef MEMDEBUG
     LLT_FREE(fl_ctx->tospace);
@@ -649,6 +706,33 @@ void gc(fl_context_t *fl_ctx, int mustgrow)
 #endif
 }
 
+// Shrink the heap back toward `target_heapsize` bytes per semispace, keeping
+// enough headroom that surviving data occupies at most 1/4 of a semispace.
+// Called between workloads (e.g. by the julia frontend after lowering a large
+// file) to give transient heap growth back to the system.
+void fl_shrink_heap(fl_context_t *fl_ctx, size_t target_heapsize)
+{
+    gc(fl_ctx, 0); // compact so the survival size is known
+#if !defined(MEMDEBUG) && !defined(MEMDEBUG2)
+    size_t live = (size_t)(fl_ctx->curheap - fl_ctx->fromspace);
+    size_t target = target_heapsize;
+    while (target < live*4)
+        target *= 2;
+    if (target >= fl_ctx->heapsize || fl_ctx->gc_grew)
+        return; // nothing to release, or a resize is already in flight
+    void *temp = LLT_REALLOC(fl_ctx->tospace, target);
+    if (temp == NULL)
+        return;
+    fl_ctx->tospace = (unsigned char*)temp;
+    fl_ctx->heapsize_target = target;
+    fl_ctx->gc_grew = 1;
+    // evacuate into the smaller semispace and shrink the other half
+    gc(fl_ctx, 0);
+#else
+    (void)target_heapsize;
+#endif
+}
+
 static void grow_stack(fl_context_t *fl_ctx)
 {
     size_t newsz = fl_ctx->N_STACK + (fl_ctx->N_STACK>>1);
@@ -2322,6 +2406,7 @@ static void lisp_init(fl_context_t *fl_ctx, size_t initial_heapsize)
 #endif
 
     fl_ctx->heapsize = initial_heapsize;
+    fl_ctx->heapsize_target = initial_heapsize;
 
     fl_ctx->fromspace = (unsigned char*)LLT_ALLOC(fl_ctx->heapsize);
 #ifdef MEMDEBUG
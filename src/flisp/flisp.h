@@ -381,6 +381,7 @@ value_t cvalue_byte(fl_context_t *fl_ctx, value_t *args, uint32_t nargs);
 value_t cvalue_wchar(fl_context_t *fl_ctx, value_t *args, uint32_t nargs);
 
 void fl_init(fl_context_t *fl_ctx, size_t initial_heapsize) JL_NOTSAFEPOINT;
+void fl_shrink_heap(fl_context_t *fl_ctx, size_t target_heapsize);
 int fl_load_system_image(fl_context_t *fl_ctx, value_t ios);
 int fl_load_system_image_str(fl_context_t *fl_ctx, char* str, size_t len) JL_NOTSAFEPOINT;
 
@@ -391,6 +392,12 @@ JL_DLLEXPORT int jl_op_suffix_char(uint32_t wc);
 
 struct _fl_context_t {
     symbol_t *symtab;
+    // open-addressing hash index over `symtab`, so interning a token is one
+    // probe instead of a strcmp per tree level; the tree stays the canonical
+    // structure (the GC and global_env_list walk it)
+    symbol_t **symtab_index;
+    size_t symtab_index_sz; // always a power of two
+    size_t symtab_nsyms;
     value_t NIL, T, F, FL_EOF, QUOTE;
     value_t int8sym, uint8sym, int16sym, uint16sym, int32sym, uint32sym;
     value_t int64sym, uint64sym;
@@ -475,6 +482,7 @@ struct _fl_context_t {
     unsigned char *curheap;
     unsigned char *lim;
     size_t heapsize;//bytes
+    size_t heapsize_target; // pending semispace size while gc_grew is set
     uint32_t *consflags;
 
     // error utilities --------------------------------------------------
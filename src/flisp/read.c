@@ -137,13 +137,26 @@ static char nextchar(fl_context_t *fl_ctx)
         }
         c = (char)ch;
         if (c == ';') {
-            // single-line comment
-            do {
-                ch = ios_getc(f);
-                if (ch == IOS_EOF)
-                    return 0;
-            } while ((char)ch != '\n');
-            c = (char)ch;
+            // single-line comment: skip to the newline straight out of the
+            // ios buffer, falling back to ios_getc at buffer boundaries
+            while (1) {
+                if (f->bpos < f->size) {
+                    char *nl = (char*)memchr(f->buf + f->bpos, '\n', f->size - f->bpos);
+                    if (nl != NULL) {
+                        f->bpos = (size_t)(nl - f->buf) + 1;
+                        break;
+                    }
+                    f->bpos = f->size;
+                }
+                else {
+                    ch = ios_getc(f);
+                    if (ch == IOS_EOF)
+                        return 0;
+                    if ((char)ch == '\n')
+                        break;
+                }
+            }
+            c = '\n';
         }
     } while (c==' ' || isspace((unsigned char)c));
     return c;
@@ -170,6 +183,20 @@ static int read_token(fl_context_t *fl_ctx, char c, int digits)
         if (nc != 0) {
             if (nc != 1)
                 (void)ios_getc(readF(fl_ctx)); // consume ch
+            if (!escaped) {
+                // scan ordinary symbol characters straight out of the ios
+                // buffer; escapes, terminators, refills and EOF all fall
+                // through to the peek path below
+                ios_t *f = readF(fl_ctx);
+                while (f->bpos < f->size) {
+                    char bc = (char)f->buf[f->bpos];
+                    if (bc == '|' || bc == '\\' ||
+                        !(symchar(bc) && (!digits || isdigit((unsigned char)bc))))
+                        break;
+                    accumchar(fl_ctx, bc, &i);
+                    f->bpos++;
+                }
+            }
             ch = ios_peekc(readF(fl_ctx));
             if (ch == IOS_EOF)
                 goto terminate;
@@ -7,6 +7,8 @@
 
 #include "llvm/ADT/SmallVector.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 using std::string;
@@ -29,6 +31,13 @@ struct jl_raw_alloc_t {
 // callbacks to store profile results. ==
 struct jl_per_thread_alloc_profile_t {
     SmallVector<jl_raw_alloc_t, 0> allocs;
+
+    // Countdown (in allocations) until the next sample, and the per-thread RNG
+    // used to draw it. Keeping this state per thread makes the common case in
+    // `_maybe_record_alloc_to_profile` a single decrement-and-branch: no shared
+    // state and no per-allocation libc rand() call (which takes a lock).
+    int64_t until_next_sample = 0;
+    uint64_t rng_state = 0;
 };
 
 struct jl_alloc_profile_t {
@@ -47,6 +56,31 @@ jl_alloc_profile_t g_alloc_profile;
 int g_alloc_profile_enabled = false;
 jl_combined_results g_combined_results; // Will live forever.
 
+// === sampling ===
+
+// Draw the number of allocations to skip until the next sample so that each
+// allocation is still sampled independently with probability `rate` (the
+// geometric-skip scheme used by tcmalloc-style heap samplers). This keeps the
+// samples unbiased while moving essentially all of the profiling cost onto the
+// rare sampled path, so low rates are cheap enough for production use.
+static int64_t next_sample_interval(jl_per_thread_alloc_profile_t &profile, double rate) JL_NOTSAFEPOINT {
+    if (rate >= 1.0)
+        return 1;
+    if (rate <= 0.0)
+        return INT64_MAX;
+    // xorshift64: cheap, and plenty good for drawing sampling intervals
+    uint64_t x = profile.rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    profile.rng_state = x;
+    double u = (double)(x >> 11) * 0x1.0p-53; // uniform in [0, 1)
+    double n = floor(log1p(-u) / log1p(-rate)) + 1;
+    if (!(n < (double)INT64_MAX))
+        return INT64_MAX;
+    return (int64_t)n;
+}
+
 // === stack stuff ===
 
 jl_raw_backtrace_t get_raw_backtrace() JL_NOTSAFEPOINT {
@@ -87,6 +121,12 @@ JL_DLLEXPORT void jl_start_alloc_profile(double sample_rate) {
     }
 
     g_alloc_profile.sample_rate = sample_rate;
+    uint64_t seed = cycleclock();
+    for (size_t i = 0; i < g_alloc_profile.per_thread_profiles.size(); i++) {
+        auto &profile = g_alloc_profile.per_thread_profiles[i];
+        profile.rng_state = seed ^ ((i + 1) * 0x9e3779b97f4a7c15ull); // nonzero per-thread seed
+        profile.until_next_sample = next_sample_interval(profile, sample_rate);
+    }
     g_alloc_profile_enabled = true;
 }
 
@@ -129,6 +169,145 @@ JL_DLLEXPORT void jl_free_alloc_profile() {
     g_combined_results.combined_allocs.clear();
 }
 
+// == per-type allocation counters ==
+//
+// The sampling profiler above answers "where are we allocating" at the cost
+// of a backtrace per sample; these counters only answer "what are we
+// allocating", which is usually the first question anyway, and cheaply enough
+// to leave on: each thread owns a fixed-size open-addressing table keyed by
+// type pointer, and a counted allocation is a short probe plus two unshared
+// relaxed increments. The tables are insert-only (a claimed slot never
+// changes type), so merging them from another thread while allocations
+// continue needs no lock — the merge just sees slightly stale counts.
+
+#define TYPE_COUNTS_TABLE_SIZE 4096 // distinct types per thread; power of two
+#define TYPE_COUNTS_MAX_PROBES 32
+
+struct jl_type_count_slot_t {
+    _Atomic(jl_datatype_t*) type;
+    _Atomic(uint64_t) count;
+    _Atomic(uint64_t) bytes;
+};
+
+struct jl_per_thread_type_counts_t {
+    jl_type_count_slot_t slots[TYPE_COUNTS_TABLE_SIZE];
+    _Atomic(uint64_t) dropped; // allocations that lost the probe-limit race
+};
+
+_Atomic(int) g_type_alloc_counters_enabled{0};
+// The recorders index the table-pointer array concurrently with
+// jl_start_type_alloc_counters growing it for newly spawned threads, so the
+// pointer and length are republished together as an immutable snapshot:
+// snapshots and the tables they point to live forever once allocated, and a
+// restart that needs room for more threads swaps in a larger copy with a
+// release store instead of reallocating under the readers.
+struct jl_type_counts_snapshot_t {
+    size_t ntables;
+    jl_per_thread_type_counts_t **tables;
+};
+static _Atomic(jl_type_counts_snapshot_t*) g_type_counts{nullptr};
+static SmallVector<jl_raw_type_alloc_count_t, 0> g_combined_type_counts; // lives forever
+
+JL_DLLEXPORT void jl_start_type_alloc_counters(void) {
+    size_t nthreads = jl_atomic_load_acquire(&jl_n_threads);
+    jl_type_counts_snapshot_t *snap = jl_atomic_load_relaxed(&g_type_counts);
+    if (snap == NULL || snap->ntables < nthreads) {
+        jl_type_counts_snapshot_t *grown =
+            (jl_type_counts_snapshot_t*)malloc_s(sizeof(jl_type_counts_snapshot_t));
+        grown->ntables = nthreads;
+        grown->tables =
+            (jl_per_thread_type_counts_t**)malloc_s(nthreads * sizeof(jl_per_thread_type_counts_t*));
+        size_t i = 0;
+        for (; snap != NULL && i < snap->ntables; i++)
+            grown->tables[i] = snap->tables[i];
+        for (; i < nthreads; i++)
+            grown->tables[i] = (jl_per_thread_type_counts_t*)calloc_s(sizeof(jl_per_thread_type_counts_t));
+        jl_atomic_store_release(&g_type_counts, grown);
+        snap = grown;
+    }
+    if (!jl_atomic_load_relaxed(&g_type_alloc_counters_enabled)) {
+        for (size_t t = 0; t < snap->ntables; t++) {
+            jl_per_thread_type_counts_t *table = snap->tables[t];
+            jl_atomic_store_relaxed(&table->dropped, 0);
+            for (size_t i = 0; i < TYPE_COUNTS_TABLE_SIZE; i++) {
+                jl_atomic_store_relaxed(&table->slots[i].type, (jl_datatype_t*)NULL);
+                jl_atomic_store_relaxed(&table->slots[i].count, 0);
+                jl_atomic_store_relaxed(&table->slots[i].bytes, 0);
+            }
+        }
+    }
+    jl_atomic_store_release(&g_type_alloc_counters_enabled, 1);
+}
+
+JL_DLLEXPORT void jl_stop_type_alloc_counters(void) {
+    jl_atomic_store_relaxed(&g_type_alloc_counters_enabled, 0);
+}
+
+JL_DLLEXPORT jl_profile_type_counts_raw_results_t jl_fetch_type_alloc_counters(void) {
+    g_combined_type_counts.clear();
+    size_t dropped = 0;
+    jl_type_counts_snapshot_t *snap = jl_atomic_load_acquire(&g_type_counts);
+    for (size_t t = 0; snap != NULL && t < snap->ntables; t++) {
+        jl_per_thread_type_counts_t *table = snap->tables[t];
+        dropped += jl_atomic_load_relaxed(&table->dropped);
+        for (size_t i = 0; i < TYPE_COUNTS_TABLE_SIZE; i++) {
+            jl_type_count_slot_t *slot = &table->slots[i];
+            jl_datatype_t *type = jl_atomic_load_acquire(&slot->type);
+            if (type == NULL)
+                continue;
+            uint64_t count = jl_atomic_load_relaxed(&slot->count);
+            if (count == 0)
+                continue; // claimed but not yet counted by its owner
+            uint64_t bytes = jl_atomic_load_relaxed(&slot->bytes);
+            size_t j = 0;
+            for (; j < g_combined_type_counts.size(); j++) {
+                if (g_combined_type_counts[j].type == type)
+                    break;
+            }
+            if (j == g_combined_type_counts.size())
+                g_combined_type_counts.push_back(jl_raw_type_alloc_count_t{type, 0, 0});
+            g_combined_type_counts[j].count += count;
+            g_combined_type_counts[j].bytes += bytes;
+        }
+    }
+    std::sort(g_combined_type_counts.begin(), g_combined_type_counts.end(),
+              [](const jl_raw_type_alloc_count_t &a, const jl_raw_type_alloc_count_t &b) {
+                  return a.count > b.count;
+              });
+    return jl_profile_type_counts_raw_results_t{
+        g_combined_type_counts.data(),
+        g_combined_type_counts.size(),
+        dropped,
+    };
+}
+
+void _record_type_alloc_count(size_t size, jl_datatype_t *type) JL_NOTSAFEPOINT {
+    size_t thread_id = jl_atomic_load_relaxed(&jl_current_task->tid);
+    jl_type_counts_snapshot_t *snap = jl_atomic_load_acquire(&g_type_counts);
+    if (snap == NULL || thread_id >= snap->ntables)
+        return; // thread started after the counters last did
+    jl_per_thread_type_counts_t *table = snap->tables[thread_id];
+    uintptr_t h = (uintptr_t)type >> 4; // types are heap pointers; drop the dead low bits
+    h ^= h >> 17;
+    for (int probe = 0; probe < TYPE_COUNTS_MAX_PROBES; probe++) {
+        jl_type_count_slot_t *slot = &table->slots[(h + probe) & (TYPE_COUNTS_TABLE_SIZE - 1)];
+        jl_datatype_t *t = jl_atomic_load_relaxed(&slot->type);
+        if (t == NULL) {
+            // only the owning thread inserts into its table, so this claim
+            // cannot race with another insertion
+            jl_atomic_store_release(&slot->type, type);
+            t = type;
+        }
+        if (t == type) {
+            // unshared writes; plain read-modify-write avoids locked ops
+            jl_atomic_store_relaxed(&slot->count, jl_atomic_load_relaxed(&slot->count) + 1);
+            jl_atomic_store_relaxed(&slot->bytes, jl_atomic_load_relaxed(&slot->bytes) + size);
+            return;
+        }
+    }
+    jl_atomic_store_relaxed(&table->dropped, jl_atomic_load_relaxed(&table->dropped) + 1);
+}
+
 // == callback called into by the outside ==
 
 void _maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t *type) JL_NOTSAFEPOINT {
@@ -139,11 +318,10 @@ void _maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t
 
     auto& profile = global_profile.per_thread_profiles[thread_id];
 
-    auto sample_val = double(rand()) / double(RAND_MAX);
-    auto should_record = sample_val <= global_profile.sample_rate;
-    if (!should_record) {
+    if (--profile.until_next_sample > 0) {
         return;
     }
+    profile.until_next_sample = next_sample_interval(profile, global_profile.sample_rate);
 
     profile.allocs.emplace_back(jl_raw_alloc_t{
         type,
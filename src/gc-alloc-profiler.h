@@ -27,13 +27,35 @@ JL_DLLEXPORT jl_profile_allocs_raw_results_t jl_fetch_alloc_profile(void);
 JL_DLLEXPORT void jl_stop_alloc_profile(void);
 JL_DLLEXPORT void jl_free_alloc_profile(void);
 
+// Lightweight per-type allocation counters: no backtraces, just "how many
+// objects (and bytes) of each type", cheap enough to leave on in production.
+// Counters accumulate from jl_start_type_alloc_counters; fetching merges the
+// per-thread tables on demand without stopping them.
+typedef struct {
+    jl_datatype_t *type;
+    size_t count;
+    size_t bytes;
+} jl_raw_type_alloc_count_t;
+
+typedef struct {
+    jl_raw_type_alloc_count_t *counts;
+    size_t num_counts;
+    size_t num_dropped; // allocations not counted because a table was full
+} jl_profile_type_counts_raw_results_t;
+
+JL_DLLEXPORT void jl_start_type_alloc_counters(void);
+JL_DLLEXPORT jl_profile_type_counts_raw_results_t jl_fetch_type_alloc_counters(void);
+JL_DLLEXPORT void jl_stop_type_alloc_counters(void);
+
 // ---------------------------------------------------------------------
 // Functions to call from GC when alloc profiling is enabled
 // ---------------------------------------------------------------------
 
 void _maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t *typ) JL_NOTSAFEPOINT;
+void _record_type_alloc_count(size_t size, jl_datatype_t *typ) JL_NOTSAFEPOINT;
 
 extern int g_alloc_profile_enabled;
+extern _Atomic(int) g_type_alloc_counters_enabled;
 
 // This should only be used from _deprecated_ code paths. We shouldn't see UNKNOWN anymore.
 #define jl_gc_unknown_type_tag ((jl_datatype_t*)0xdeadaa03)
@@ -42,6 +64,9 @@ static inline void maybe_record_alloc_to_profile(jl_value_t *val, size_t size, j
     if (__unlikely(g_alloc_profile_enabled)) {
         _maybe_record_alloc_to_profile(val, size, typ);
     }
+    if (__unlikely(jl_atomic_load_relaxed(&g_type_alloc_counters_enabled))) {
+        _record_type_alloc_count(size, typ);
+    }
 }
 
 #ifdef __cplusplus
@@ -10,14 +10,15 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/DenseMap.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <queue>
 #include <vector>
 #include <string>
 #include <sstream>
 #include <iostream>
-#include <set>
 
 using std::string;
-using std::set;
 using std::ostringstream;
 using std::pair;
 using std::make_pair;
@@ -63,24 +64,30 @@ struct Edge {
     size_t to_node;
 };
 
+// On-disk record for an edge. Edges are streamed to a temporary file as the
+// mark loop discovers them and only grouped by `from_node` (as the JSON
+// format requires) in the final serialization pass, so snapshot memory no
+// longer scales with the number of edges in the heap.
+struct StreamedEdge {
+    size_t from_node;
+    Edge edge;
+};
+
 // Nodes
 // "node_fields":
 //   [ "type", "name", "id", "self_size", "edge_count", "trace_node_id", "detachedness" ]
 // mimicking https://github.com/nodejs/node/blob/5fd7a72e1c4fbaf37d3723c4c81dce35c149dc84/deps/v8/src/profiler/heap-snapshot-generator.cc#L2568-L2575
 
 const int k_node_number_of_fields = 7;
+// On-disk record for a node, streamed to a temporary file on creation.
+// `trace_node_id` and `detachedness` are always 0 for us and the edge count is
+// only known once marking is done, so none of them are stored here; the edge
+// count is kept in a per-node in-memory counter instead.
 struct Node {
     size_t type; // index into snapshot->node_types
     size_t name;
     size_t id; // This should be a globally-unique counter, but we use the memory address
     size_t self_size;
-    size_t trace_node_id;  // This is ALWAYS 0 in Javascript heap-snapshots.
-    // whether the from_node is attached or detached from the main application state
-    // https://github.com/nodejs/node/blob/5fd7a72e1c4fbaf37d3723c4c81dce35c149dc84/deps/v8/include/v8-profiler.h#L739-L745
-    int detachedness;  // 0 - unknown, 1 - attached, 2 - detached
-    SmallVector<Edge, 0> edges;
-
-    ~Node() JL_NOTSAFEPOINT = default;
 };
 
 struct StringTable {
@@ -111,15 +118,24 @@ struct StringTable {
 };
 
 struct HeapSnapshot {
-    SmallVector<Node, 0> nodes;
-    // edges are stored on each from_node
+    // `Node` and `StreamedEdge` records are appended to these temporary files
+    // as the mark loop runs; only the dedup map, the string tables and one
+    // 32-bit edge counter per node stay in memory. On a big heap the edges
+    // dominate the snapshot, so this keeps the overhead of taking a snapshot
+    // far below the size of the heap being snapshotted.
+    ios_t nodes_file;
+    ios_t edges_file;
+    char nodes_path[JL_PATH_MAX];
+    char edges_path[JL_PATH_MAX];
+    size_t num_nodes = 0;
+    SmallVector<uint32_t, 0> edge_counts; // outgoing edge count per node
 
     StringTable names;
     StringTable node_types;
     StringTable edge_types;
     DenseMap<void *, size_t> node_ptr_to_index_map;
 
-    size_t num_edges = 0; // For metadata, updated as you add each edge. Needed because edges owned by nodes.
+    size_t num_edges = 0; // For metadata, updated as you add each edge.
     size_t _gc_root_idx = 1; // node index of the GC roots node
     size_t _gc_finlist_root_idx = 2; // node index of the GC finlist roots node
 };
@@ -130,36 +146,127 @@ int gc_heap_snapshot_enabled = 0;
 HeapSnapshot *g_snapshot = nullptr;
 extern jl_mutex_t heapsnapshot_lock;
 
+// Snapshots no longer force the mark loop serial: the parallel mark threads
+// all record into the snapshot concurrently. The dedup map, string tables and
+// streamed node file are guarded by this lock, while edges -- the bulk of the
+// records -- are accumulated in a per-thread buffer and flushed under the
+// lock only when the buffer fills up (and once after marking finishes).
+static uv_mutex_t snapshot_table_lock;
+static const size_t k_edge_buffer_cap = 1 << 14; // records buffered per thread between flushes
+
+struct EdgeBuffer {
+    SmallVector<StreamedEdge, 0> edges;
+};
+// all buffers ever handed out, so the final flush can reach every thread's;
+// they live for the life of their thread and are empty between snapshots
+static SmallVector<EdgeBuffer*, 0> g_edge_buffers;
+static __thread EdgeBuffer *t_edge_buffer = nullptr;
+
+// GC mark threads have no task, so keying the buffer off the C TLS is the
+// only identity that works for every thread that can run the mark loop
+static EdgeBuffer *_get_edge_buffer(void) JL_NOTSAFEPOINT
+{
+    EdgeBuffer *buf = t_edge_buffer;
+    if (buf == nullptr) {
+        buf = new EdgeBuffer;
+        uv_mutex_lock(&snapshot_table_lock);
+        g_edge_buffers.push_back(buf);
+        uv_mutex_unlock(&snapshot_table_lock);
+        t_edge_buffer = buf;
+    }
+    return buf;
+}
+
+// requires snapshot_table_lock
+static void _flush_edge_buffer(HeapSnapshot *snapshot, EdgeBuffer *buf) JL_NOTSAFEPOINT
+{
+    if (buf->edges.empty())
+        return;
+    ios_write(&snapshot->edges_file, (char*)buf->edges.data(),
+              buf->edges.size() * sizeof(StreamedEdge));
+    for (const StreamedEdge &rec : buf->edges)
+        snapshot->edge_counts[rec.from_node] += 1;
+    snapshot->num_edges += buf->edges.size();
+    buf->edges.clear();
+}
+
+static size_t _locked_string_id(StringTable &table, StringRef key) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&snapshot_table_lock);
+    size_t id = table.find_or_create_string_id(key);
+    uv_mutex_unlock(&snapshot_table_lock);
+    return id;
+}
+
 void serialize_heap_snapshot(ios_t *stream, HeapSnapshot &snapshot, char all_one);
 static inline void _record_gc_edge(const char *edge_type,
                                    jl_value_t *a, jl_value_t *b, size_t name_or_index) JL_NOTSAFEPOINT;
-void _record_gc_just_edge(const char *edge_type, Node &from_node, size_t to_idx, size_t name_or_idx) JL_NOTSAFEPOINT;
+void _record_gc_just_edge(const char *edge_type, size_t from_idx, size_t to_idx, size_t name_or_idx) JL_NOTSAFEPOINT;
 void _add_synthetic_root_entries(HeapSnapshot *snapshot);
 
+// Create a temporary file for one of the streamed snapshot tables.
+static void _open_snapshot_tmpfile(ios_t *s, char *path)
+{
+    size_t sz = JL_PATH_MAX;
+    if (uv_os_tmpdir(path, &sz) != 0)
+        strcpy(path, ".");
+    strncat(path, "/julia_heapsnap_XXXXXX", JL_PATH_MAX - strlen(path) - 1);
+    if (ios_mkstemp(s, path) == NULL)
+        jl_errorf("could not create temporary file for heap snapshot: %s", path);
+}
+
+// Append a node record to the streamed node table and return its index.
+static size_t _push_node(HeapSnapshot *snapshot, Node node) JL_NOTSAFEPOINT
+{
+    ios_write(&snapshot->nodes_file, (char*)&node, sizeof(node));
+    snapshot->edge_counts.push_back(0);
+    return snapshot->num_nodes++;
+}
+
 
 JL_DLLEXPORT void jl_gc_take_heap_snapshot(ios_t *stream, char all_one)
 {
     HeapSnapshot snapshot;
+    _open_snapshot_tmpfile(&snapshot.nodes_file, snapshot.nodes_path);
+    _open_snapshot_tmpfile(&snapshot.edges_file, snapshot.edges_path);
     _add_synthetic_root_entries(&snapshot);
 
     jl_mutex_lock(&heapsnapshot_lock);
 
+    static int table_lock_initialized = 0;
+    if (!table_lock_initialized) {
+        uv_mutex_init(&snapshot_table_lock);
+        table_lock_initialized = 1;
+    }
+
     // Enable snapshotting
     g_snapshot = &snapshot;
     gc_heap_snapshot_enabled = true;
 
-    // Do a full GC mark (and incremental sweep), which will invoke our callbacks on `g_snapshot`
+    // Do a full GC mark (and incremental sweep), which will invoke our
+    // callbacks on `g_snapshot` from all of the parallel mark threads
     jl_gc_collect(JL_GC_FULL);
 
     // Disable snapshotting
     gc_heap_snapshot_enabled = false;
+
+    // drain every thread's edge buffer now that marking is done
+    uv_mutex_lock(&snapshot_table_lock);
+    for (EdgeBuffer *buf : g_edge_buffers)
+        _flush_edge_buffer(&snapshot, buf);
+    uv_mutex_unlock(&snapshot_table_lock);
     g_snapshot = nullptr;
 
     jl_mutex_unlock(&heapsnapshot_lock);
 
-    // When we return, the snapshot is full
+    // When we return, the streamed tables are full
     // Dump the snapshot
     serialize_heap_snapshot((ios_t*)stream, snapshot, all_one);
+
+    ios_close(&snapshot.nodes_file);
+    ios_close(&snapshot.edges_file);
+    remove(snapshot.nodes_path);
+    remove(snapshot.edges_path);
 }
 
 // mimicking https://github.com/nodejs/node/blob/5fd7a72e1c4fbaf37d3723c4c81dce35c149dc84/deps/v8/src/profiler/heap-snapshot-generator.cc#L212
@@ -168,53 +275,45 @@ void _add_synthetic_root_entries(HeapSnapshot *snapshot)
 {
     // adds a node at id 0 which is the "uber root":
     // a synthetic node which points to all the GC roots.
-    Node internal_root{
+    _push_node(snapshot, Node{
         snapshot->node_types.find_or_create_string_id("synthetic"),
         snapshot->names.find_or_create_string_id(""), // name
         0, // id
-        0, // size
-        0, // size_t trace_node_id (unused)
-        0, // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
-    };
-    snapshot->nodes.push_back(internal_root);
+        0 // size
+    });
 
     // Add a node for the GC roots
-    snapshot->_gc_root_idx = snapshot->nodes.size();
-    Node gc_roots{
+    snapshot->_gc_root_idx = snapshot->num_nodes;
+    _push_node(snapshot, Node{
         snapshot->node_types.find_or_create_string_id("synthetic"),
         snapshot->names.find_or_create_string_id("GC roots"), // name
         snapshot->_gc_root_idx, // id
-        0, // size
-        0, // size_t trace_node_id (unused)
-        0, // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
-    };
-    snapshot->nodes.push_back(gc_roots);
-    snapshot->nodes.front().edges.push_back(Edge{
+        0 // size
+    });
+    StreamedEdge gc_root_edge{0, Edge{
         snapshot->edge_types.find_or_create_string_id("internal"),
         snapshot->names.find_or_create_string_id("GC roots"), // edge label
         snapshot->_gc_root_idx // to
-    });
+    }};
+    ios_write(&snapshot->edges_file, (char*)&gc_root_edge, sizeof(gc_root_edge));
+    snapshot->edge_counts[0] += 1;
     snapshot->num_edges += 1;
 
     // add a node for the gc finalizer list roots
-    snapshot->_gc_finlist_root_idx = snapshot->nodes.size();
-    Node gc_finlist_roots{
+    snapshot->_gc_finlist_root_idx = snapshot->num_nodes;
+    _push_node(snapshot, Node{
         snapshot->node_types.find_or_create_string_id("synthetic"),
         snapshot->names.find_or_create_string_id("GC finalizer list roots"), // name
         snapshot->_gc_finlist_root_idx, // id
-        0, // size
-        0, // size_t trace_node_id (unused)
-        0, // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
-    };
-    snapshot->nodes.push_back(gc_finlist_roots);
-    snapshot->nodes.front().edges.push_back(Edge{
+        0 // size
+    });
+    StreamedEdge gc_finlist_edge{0, Edge{
         snapshot->edge_types.find_or_create_string_id("internal"),
         snapshot->names.find_or_create_string_id("GC finlist roots"), // edge label
         snapshot->_gc_finlist_root_idx // to
-    });
+    }};
+    ios_write(&snapshot->edges_file, (char*)&gc_finlist_edge, sizeof(gc_finlist_edge));
+    snapshot->edge_counts[0] += 1;
     snapshot->num_edges += 1;
 }
 
@@ -222,9 +321,12 @@ void _add_synthetic_root_entries(HeapSnapshot *snapshot)
 // returns the index of the new node
 size_t record_node_to_gc_snapshot(jl_value_t *a) JL_NOTSAFEPOINT
 {
-    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(a, g_snapshot->nodes.size()));
+    uv_mutex_lock(&snapshot_table_lock);
+    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(a, g_snapshot->num_nodes));
+    size_t node_idx = val.first->second;
     if (!val.second) {
-        return val.first->second;
+        uv_mutex_unlock(&snapshot_table_lock);
+        return node_idx;
     }
 
     ios_t str_;
@@ -292,42 +394,38 @@ size_t record_node_to_gc_snapshot(jl_value_t *a) JL_NOTSAFEPOINT
         name = StringRef((const char*)str_.buf, str_.size);
     }
 
-    g_snapshot->nodes.push_back(Node{
+    _push_node(g_snapshot, Node{
         g_snapshot->node_types.find_or_create_string_id(node_type), // size_t type;
         g_snapshot->names.find_or_create_string_id(name), // size_t name;
         (size_t)a,     // size_t id;
         // We add 1 to self-size for the type tag that all heap-allocated objects have.
         // Also because the Chrome Snapshot viewer ignores size-0 leaves!
-        sizeof(void*) + self_size, // size_t self_size;
-        0,             // size_t trace_node_id (unused)
-        0,             // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
+        sizeof(void*) + self_size // size_t self_size;
     });
+    uv_mutex_unlock(&snapshot_table_lock);
 
     if (ios_need_close)
         ios_close(&str_);
 
-    return val.first->second;
+    return node_idx;
 }
 
 static size_t record_pointer_to_gc_snapshot(void *a, size_t bytes, StringRef name) JL_NOTSAFEPOINT
 {
-    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(a, g_snapshot->nodes.size()));
-    if (!val.second) {
-        return val.first->second;
+    uv_mutex_lock(&snapshot_table_lock);
+    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(a, g_snapshot->num_nodes));
+    size_t node_idx = val.first->second;
+    if (val.second) {
+        _push_node(g_snapshot, Node{
+            g_snapshot->node_types.find_or_create_string_id( "object"), // size_t type;
+            g_snapshot->names.find_or_create_string_id(name), // size_t name;
+            (size_t)a,     // size_t id;
+            bytes          // size_t self_size;
+        });
     }
+    uv_mutex_unlock(&snapshot_table_lock);
 
-    g_snapshot->nodes.push_back(Node{
-        g_snapshot->node_types.find_or_create_string_id( "object"), // size_t type;
-        g_snapshot->names.find_or_create_string_id(name), // size_t name;
-        (size_t)a,     // size_t id;
-        bytes,         // size_t self_size;
-        0,             // size_t trace_node_id (unused)
-        0,             // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
-    });
-
-    return val.first->second;
+    return node_idx;
 }
 
 static string _fieldpath_for_slot(void *obj, void *slot) JL_NOTSAFEPOINT
@@ -364,23 +462,18 @@ static string _fieldpath_for_slot(void *obj, void *slot) JL_NOTSAFEPOINT
 
 void _gc_heap_snapshot_record_root(jl_value_t *root, char *name) JL_NOTSAFEPOINT
 {
-    record_node_to_gc_snapshot(root);
-
-    auto &internal_root = g_snapshot->nodes.front();
-    auto to_node_idx = g_snapshot->node_ptr_to_index_map[root];
-    auto edge_label = g_snapshot->names.find_or_create_string_id(name);
+    auto to_node_idx = record_node_to_gc_snapshot(root);
+    auto edge_label = _locked_string_id(g_snapshot->names, name);
 
-    _record_gc_just_edge("internal", internal_root, to_node_idx, edge_label);
+    _record_gc_just_edge("internal", 0 /* uber root */, to_node_idx, edge_label);
 }
 
 void _gc_heap_snapshot_record_gc_roots(jl_value_t *root, char *name) JL_NOTSAFEPOINT
 {
-    record_node_to_gc_snapshot(root);
-
     auto from_node_idx = g_snapshot->_gc_root_idx;
     auto to_node_idx = record_node_to_gc_snapshot(root);
-    auto edge_label = g_snapshot->names.find_or_create_string_id(name);
-    _record_gc_just_edge("internal", g_snapshot->nodes[from_node_idx], to_node_idx, edge_label);
+    auto edge_label = _locked_string_id(g_snapshot->names, name);
+    _record_gc_just_edge("internal", from_node_idx, to_node_idx, edge_label);
 }
 
 void _gc_heap_snapshot_record_finlist(jl_value_t *obj, size_t index) JL_NOTSAFEPOINT
@@ -389,8 +482,8 @@ void _gc_heap_snapshot_record_finlist(jl_value_t *obj, size_t index) JL_NOTSAFEP
     auto to_node_idx = record_node_to_gc_snapshot(obj);
     ostringstream ss;
     ss << "finlist-" << index;
-    auto edge_label = g_snapshot->names.find_or_create_string_id(ss.str());
-    _record_gc_just_edge("internal", g_snapshot->nodes[from_node_idx], to_node_idx, edge_label);
+    auto edge_label = _locked_string_id(g_snapshot->names, ss.str());
+    _record_gc_just_edge("internal", from_node_idx, to_node_idx, edge_label);
 }
 
 // Add a node to the heap snapshot representing a Julia stack frame.
@@ -399,52 +492,47 @@ void _gc_heap_snapshot_record_finlist(jl_value_t *obj, size_t index) JL_NOTSAFEP
 // Stack frame nodes point at the objects they have as local variables.
 size_t _record_stack_frame_node(HeapSnapshot *snapshot, void *frame) JL_NOTSAFEPOINT
 {
-    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(frame, g_snapshot->nodes.size()));
-    if (!val.second) {
-        return val.first->second;
+    uv_mutex_lock(&snapshot_table_lock);
+    auto val = g_snapshot->node_ptr_to_index_map.insert(make_pair(frame, g_snapshot->num_nodes));
+    size_t node_idx = val.first->second;
+    if (val.second) {
+        _push_node(snapshot, Node{
+            snapshot->node_types.find_or_create_string_id("synthetic"),
+            snapshot->names.find_or_create_string_id("(stack frame)"), // name
+            (size_t)frame, // id
+            1 // size
+        });
     }
+    uv_mutex_unlock(&snapshot_table_lock);
 
-    snapshot->nodes.push_back(Node{
-        snapshot->node_types.find_or_create_string_id("synthetic"),
-        snapshot->names.find_or_create_string_id("(stack frame)"), // name
-        (size_t)frame, // id
-        1, // size
-        0, // size_t trace_node_id (unused)
-        0, // int detachedness;  // 0 - unknown,  1 - attached;  2 - detached
-        SmallVector<Edge, 0>() // outgoing edges
-    });
-
-    return val.first->second;
+    return node_idx;
 }
 
 void _gc_heap_snapshot_record_frame_to_object_edge(void *from, jl_value_t *to) JL_NOTSAFEPOINT
 {
     auto from_node_idx = _record_stack_frame_node(g_snapshot, (jl_gcframe_t*)from);
     auto to_idx = record_node_to_gc_snapshot(to);
-    Node &from_node = g_snapshot->nodes[from_node_idx];
 
-    auto name_idx = g_snapshot->names.find_or_create_string_id("local var");
-    _record_gc_just_edge("internal", from_node, to_idx, name_idx);
+    auto name_idx = _locked_string_id(g_snapshot->names, "local var");
+    _record_gc_just_edge("internal", from_node_idx, to_idx, name_idx);
 }
 
 void _gc_heap_snapshot_record_task_to_frame_edge(jl_task_t *from, void *to) JL_NOTSAFEPOINT
 {
     auto from_node_idx = record_node_to_gc_snapshot((jl_value_t*)from);
     auto to_node_idx = _record_stack_frame_node(g_snapshot, to);
-    Node &from_node = g_snapshot->nodes[from_node_idx];
 
-    auto name_idx = g_snapshot->names.find_or_create_string_id("stack");
-    _record_gc_just_edge("internal", from_node, to_node_idx, name_idx);
+    auto name_idx = _locked_string_id(g_snapshot->names, "stack");
+    _record_gc_just_edge("internal", from_node_idx, to_node_idx, name_idx);
 }
 
 void _gc_heap_snapshot_record_frame_to_frame_edge(jl_gcframe_t *from, jl_gcframe_t *to) JL_NOTSAFEPOINT
 {
     auto from_node_idx = _record_stack_frame_node(g_snapshot, from);
     auto to_node_idx = _record_stack_frame_node(g_snapshot, to);
-    Node &from_node = g_snapshot->nodes[from_node_idx];
 
-    auto name_idx = g_snapshot->names.find_or_create_string_id("next frame");
-    _record_gc_just_edge("internal", from_node, to_node_idx, name_idx);
+    auto name_idx = _locked_string_id(g_snapshot->names, "next frame");
+    _record_gc_just_edge("internal", from_node_idx, to_node_idx, name_idx);
 }
 
 void _gc_heap_snapshot_record_array_edge(jl_value_t *from, jl_value_t *to, size_t index) JL_NOTSAFEPOINT
@@ -456,7 +544,7 @@ void _gc_heap_snapshot_record_object_edge(jl_value_t *from, jl_value_t *to, void
 {
     string path = _fieldpath_for_slot(from, slot);
     _record_gc_edge("property", from, to,
-                    g_snapshot->names.find_or_create_string_id(path));
+                    _locked_string_id(g_snapshot->names, path));
 }
 
 void _gc_heap_snapshot_record_module_to_binding(jl_module_t *module, jl_value_t *bindings, jl_value_t *bindingkeyset) JL_NOTSAFEPOINT
@@ -464,24 +552,23 @@ void _gc_heap_snapshot_record_module_to_binding(jl_module_t *module, jl_value_t
     auto from_node_idx = record_node_to_gc_snapshot((jl_value_t*)module);
     auto to_bindings_idx = record_node_to_gc_snapshot(bindings);
     auto to_bindingkeyset_idx = record_node_to_gc_snapshot(bindingkeyset);
-    auto &from_node = g_snapshot->nodes[from_node_idx];
     if (to_bindings_idx > 0) {
-        _record_gc_just_edge("internal", from_node, to_bindings_idx, g_snapshot->names.find_or_create_string_id("bindings"));
+        _record_gc_just_edge("internal", from_node_idx, to_bindings_idx, _locked_string_id(g_snapshot->names, "bindings"));
     }
     if (to_bindingkeyset_idx > 0) {
-        _record_gc_just_edge("internal", from_node, to_bindingkeyset_idx, g_snapshot->names.find_or_create_string_id("bindingkeyset"));
+        _record_gc_just_edge("internal", from_node_idx, to_bindingkeyset_idx, _locked_string_id(g_snapshot->names, "bindingkeyset"));
     }
  }
 
 void _gc_heap_snapshot_record_internal_array_edge(jl_value_t *from, jl_value_t *to) JL_NOTSAFEPOINT
 {
     _record_gc_edge("internal", from, to,
-                    g_snapshot->names.find_or_create_string_id("<internal>"));
+                    _locked_string_id(g_snapshot->names, "<internal>"));
 }
 
 void _gc_heap_snapshot_record_hidden_edge(jl_value_t *from, void* to, size_t bytes, uint16_t alloc_type) JL_NOTSAFEPOINT
 {
-    size_t name_or_idx = g_snapshot->names.find_or_create_string_id("<native>");
+    size_t name_or_idx = _locked_string_id(g_snapshot->names, "<native>");
 
     auto from_node_idx = record_node_to_gc_snapshot(from);
     const char *alloc_kind;
@@ -501,9 +588,8 @@ void _gc_heap_snapshot_record_hidden_edge(jl_value_t *from, void* to, size_t byt
         break;
     }
     auto to_node_idx = record_pointer_to_gc_snapshot(to, bytes, alloc_kind);
-    auto &from_node = g_snapshot->nodes[from_node_idx];
 
-    _record_gc_just_edge("hidden", from_node, to_node_idx, name_or_idx);
+    _record_gc_just_edge("hidden", from_node_idx, to_node_idx, name_or_idx);
 }
 
 static inline void _record_gc_edge(const char *edge_type, jl_value_t *a,
@@ -512,22 +598,39 @@ static inline void _record_gc_edge(const char *edge_type, jl_value_t *a,
     auto from_node_idx = record_node_to_gc_snapshot(a);
     auto to_node_idx = record_node_to_gc_snapshot(b);
 
-    auto &from_node = g_snapshot->nodes[from_node_idx];
-
-    _record_gc_just_edge(edge_type, from_node, to_node_idx, name_or_idx);
+    _record_gc_just_edge(edge_type, from_node_idx, to_node_idx, name_or_idx);
 }
 
-void _record_gc_just_edge(const char *edge_type, Node &from_node, size_t to_idx, size_t name_or_idx) JL_NOTSAFEPOINT
+void _record_gc_just_edge(const char *edge_type, size_t from_idx, size_t to_idx, size_t name_or_idx) JL_NOTSAFEPOINT
 {
-    from_node.edges.push_back(Edge{
-        g_snapshot->edge_types.find_or_create_string_id(edge_type),
+    StreamedEdge rec{from_idx, Edge{
+        _locked_string_id(g_snapshot->edge_types, edge_type),
         name_or_idx, // edge label
         to_idx // to
-    });
-
-    g_snapshot->num_edges += 1;
+    }};
+    EdgeBuffer *buf = _get_edge_buffer();
+    buf->edges.push_back(rec);
+    if (buf->edges.size() >= k_edge_buffer_cap) {
+        uv_mutex_lock(&snapshot_table_lock);
+        _flush_edge_buffer(g_snapshot, buf);
+        uv_mutex_unlock(&snapshot_table_lock);
+    }
 }
 
+// Number of `StreamedEdge` records sorted in memory per run while grouping the
+// edge file, and the per-run read-back buffer used during the merge. These
+// bound the memory used by serialization regardless of heap size.
+static const size_t k_edge_sort_chunk = 1 << 21; // 64 MB of records per run
+static const size_t k_edge_merge_buf = 1 << 12;
+
+// Cursor over one sorted run in the scratch file, refilled in blocks.
+struct EdgeRun {
+    int64_t offset;   // file offset of the next unread record
+    size_t remaining; // records still on disk
+    size_t buf_pos;
+    SmallVector<StreamedEdge, 0> buf;
+};
+
 void serialize_heap_snapshot(ios_t *stream, HeapSnapshot &snapshot, char all_one)
 {
     // mimicking https://github.com/nodejs/node/blob/5fd7a72e1c4fbaf37d3723c4c81dce35c149dc84/deps/v8/src/profiler/heap-snapshot-generator.cc#L2567-L2567
@@ -544,15 +647,17 @@ void serialize_heap_snapshot(ios_t *stream, HeapSnapshot &snapshot, char all_one
     ios_printf(stream, ",");
     ios_printf(stream, "\"string_or_number\",\"from_node\"]");
     ios_printf(stream, "},\n"); // end "meta"
-    ios_printf(stream, "\"node_count\":%zu,", snapshot.nodes.size());
+    ios_printf(stream, "\"node_count\":%zu,", snapshot.num_nodes);
     ios_printf(stream, "\"edge_count\":%zu", snapshot.num_edges);
     ios_printf(stream, "},\n"); // end "snapshot"
 
+    // stream the node table back in, attaching the now-final edge counts
     ios_printf(stream, "\"nodes\":[");
+    ios_seek(&snapshot.nodes_file, 0);
     bool first_node = true;
-    // use a set to track the nodes that do not have parents
-    set<size_t> orphans;
-    for (const auto &from_node : snapshot.nodes) {
+    for (size_t i = 0; i < snapshot.num_nodes; i++) {
+        Node node;
+        ios_readall(&snapshot.nodes_file, (char*)&node, sizeof(node));
         if (first_node) {
             first_node = false;
         }
@@ -560,48 +665,93 @@ void serialize_heap_snapshot(ios_t *stream, HeapSnapshot &snapshot, char all_one
             ios_printf(stream, ",");
         }
         // ["type","name","id","self_size","edge_count","trace_node_id","detachedness"]
-        ios_printf(stream, "%zu,%zu,%zu,%zu,%zu,%zu,%d\n",
-                            from_node.type,
-                            from_node.name,
-                            from_node.id,
-                            all_one ? (size_t)1 : from_node.self_size,
-                            from_node.edges.size(),
-                            from_node.trace_node_id,
-                            from_node.detachedness);
-        if (from_node.id != snapshot._gc_root_idx && from_node.id != snapshot._gc_finlist_root_idx) {
-            // find the node index from the node object pointer
-            void * ptr = (void*)from_node.id;
-            size_t n_id = snapshot.node_ptr_to_index_map[ptr];
-            orphans.insert(n_id);
-        } else {
-            orphans.insert(from_node.id);
-        }
+        ios_printf(stream, "%zu,%zu,%zu,%zu,%u,%zu,%d\n",
+                            node.type,
+                            node.name,
+                            node.id,
+                            all_one ? (size_t)1 : node.self_size,
+                            snapshot.edge_counts[i],
+                            (size_t)0, // trace_node_id (unused)
+                            0);        // detachedness (0 - unknown)
     }
     ios_printf(stream, "],\n");
 
+    // The JSON format wants edges grouped by from-node in node order, but the
+    // edge file is in discovery order. Group it with an external merge sort:
+    // stable-sort fixed-size chunks in memory, append each as a run to a
+    // scratch file, then stream a k-way merge of the runs straight into the
+    // output. Ties between runs are broken by run index, so the original
+    // discovery order within a from-node is preserved.
+    ios_t runs_file;
+    char runs_path[JL_PATH_MAX];
+    _open_snapshot_tmpfile(&runs_file, runs_path);
+    SmallVector<EdgeRun, 0> runs;
+    {
+        SmallVector<StreamedEdge, 0> chunk;
+        ios_seek(&snapshot.edges_file, 0);
+        size_t nleft = snapshot.num_edges;
+        while (nleft > 0) {
+            size_t n = nleft < k_edge_sort_chunk ? nleft : k_edge_sort_chunk;
+            chunk.resize(n);
+            ios_readall(&snapshot.edges_file, (char*)chunk.data(), n * sizeof(StreamedEdge));
+            std::stable_sort(chunk.begin(), chunk.end(),
+                             [](const StreamedEdge &a, const StreamedEdge &b) {
+                                 return a.from_node < b.from_node;
+                             });
+            EdgeRun run;
+            run.offset = ios_pos(&runs_file);
+            run.remaining = n;
+            run.buf_pos = 0;
+            ios_write(&runs_file, (char*)chunk.data(), n * sizeof(StreamedEdge));
+            runs.push_back(std::move(run));
+            nleft -= n;
+        }
+    }
+    auto refill_run = [&](size_t r) {
+        EdgeRun &run = runs[r];
+        size_t n = run.remaining < k_edge_merge_buf ? run.remaining : k_edge_merge_buf;
+        run.buf.resize(n);
+        ios_seek(&runs_file, run.offset);
+        ios_readall(&runs_file, (char*)run.buf.data(), n * sizeof(StreamedEdge));
+        run.offset += n * sizeof(StreamedEdge);
+        run.remaining -= n;
+        run.buf_pos = 0;
+    };
+    typedef pair<size_t, size_t> merge_key; // (from-node, run index)
+    std::priority_queue<merge_key, std::vector<merge_key>, std::greater<merge_key>> heads;
+    for (size_t r = 0; r < runs.size(); r++) {
+        refill_run(r);
+        if (!runs[r].buf.empty())
+            heads.push(make_pair(runs[r].buf[0].from_node, r));
+    }
+    // track incoming edges so we can check connectivity below
+    SmallVector<uint8_t, 0> has_incoming(snapshot.num_nodes, 0);
     ios_printf(stream, "\"edges\":[");
     bool first_edge = true;
-    for (const auto &from_node : snapshot.nodes) {
-        for (const auto &edge : from_node.edges) {
-            if (first_edge) {
-                first_edge = false;
-            }
-            else {
-                ios_printf(stream, ",");
-            }
-            ios_printf(stream, "%zu,%zu,%zu\n",
-                                edge.type,
-                                edge.name_or_index,
-                                edge.to_node * k_node_number_of_fields);
-            auto n_id = edge.to_node;
-            auto it = orphans.find(n_id);
-            if (it != orphans.end()) {
-                // remove the node from the orphans if it has at least one incoming edge
-                orphans.erase(it);
-            }
+    while (!heads.empty()) {
+        size_t r = heads.top().second;
+        heads.pop();
+        EdgeRun &run = runs[r];
+        StreamedEdge rec = run.buf[run.buf_pos++];
+        if (run.buf_pos == run.buf.size() && run.remaining > 0)
+            refill_run(r);
+        if (run.buf_pos < run.buf.size())
+            heads.push(make_pair(run.buf[run.buf_pos].from_node, r));
+        if (first_edge) {
+            first_edge = false;
+        }
+        else {
+            ios_printf(stream, ",");
         }
+        ios_printf(stream, "%zu,%zu,%zu\n",
+                            rec.edge.type,
+                            rec.edge.name_or_index,
+                            rec.edge.to_node * k_node_number_of_fields);
+        has_incoming[rec.edge.to_node] = 1;
     }
     ios_printf(stream, "],\n"); // end "edges"
+    ios_close(&runs_file);
+    remove(runs_path);
 
     ios_printf(stream, "\"strings\":");
 
@@ -609,7 +759,8 @@ void serialize_heap_snapshot(ios_t *stream, HeapSnapshot &snapshot, char all_one
 
     ios_printf(stream, "}");
 
-    // remove the uber node from the orphans
-    orphans.erase(0);
-    assert(orphans.size() == 0 && "all nodes except the uber node should have at least one incoming edge");
+    // all nodes except the uber node should have at least one incoming edge
+    for (size_t i = 1; i < snapshot.num_nodes; i++)
+        assert(has_incoming[i] && "node without incoming edge in heap snapshot");
+    (void)has_incoming;
 }
@@ -22,6 +22,12 @@
 // number of stacks to always keep available per pool
 #define MIN_STACK_MAPPINGS_PER_POOL 5
 
+// bounds for the per-thread pool of dead task objects kept for reuse by
+// jl_new_task; the pool refills at every sweep, so the cap only needs to
+// cover the task allocations of one collection interval
+#define MIN_POOLED_TASKS 16
+#define MAX_POOLED_TASKS 4096
+
 const size_t jl_guard_size = (4096 * 8);
 static _Atomic(uint32_t) num_stack_mappings = 0;
 
@@ -78,6 +84,74 @@ JL_DLLEXPORT uint32_t jl_get_num_stack_mappings(void)
     return jl_atomic_load_relaxed(&num_stack_mappings);
 }
 
+// Stacks unlinked by sweep_stack_pools inside the stop-the-world window and
+// munmapped afterwards by the concurrent sweep thread (scheduler.c), so the
+// pause does not pay for the syscalls. Entries are only pushed during the
+// pause, but the drain of the previous collection's batch may still be
+// running, so both ends use CAS.
+typedef struct _deferred_stack_t {
+    struct _deferred_stack_t *next;
+    void *stkbuf;
+    size_t bufsz;
+} deferred_stack_t;
+static _Atomic(deferred_stack_t *) deferred_stacks;
+
+static void sweep_free_stack(void *stkbuf, size_t bufsz) JL_NOTSAFEPOINT
+{
+#ifdef _P64
+    if (jl_n_sweepthreads > 0) {
+        deferred_stack_t *node = (deferred_stack_t*)malloc_s(sizeof(deferred_stack_t));
+        node->stkbuf = stkbuf;
+        node->bufsz = bufsz;
+        deferred_stack_t *head = jl_atomic_load_relaxed(&deferred_stacks);
+        do {
+            node->next = head;
+        } while (!jl_atomic_cmpswap(&deferred_stacks, &head, node));
+        return;
+    }
+#endif
+    free_stack(stkbuf, bufsz);
+}
+
+void gc_free_deferred_stacks(void)
+{
+    deferred_stack_t *node = jl_atomic_exchange(&deferred_stacks, NULL);
+    while (node != NULL) {
+        deferred_stack_t *next = node->next;
+        free_stack(node->stkbuf, node->bufsz);
+        free(node);
+        node = next;
+    }
+}
+
+// Release the physical pages backing a pooled stack while keeping the mapping
+// (and the guard page) intact. With `MADV_FREE` the kernel only reclaims the
+// pages under memory pressure and a reused stack just refaults them, so idle
+// pooled stacks stop counting against RSS after a large task fan-out.
+static void shrink_stack(void *stkbuf, size_t bufsz) JL_NOTSAFEPOINT
+{
+    char *p = (char*)stkbuf + jl_guard_size;
+    size_t sz = bufsz - jl_guard_size;
+#ifdef _OS_WINDOWS_
+    // MEM_RESET is the closest analog: the pages stay committed, but the OS
+    // may discard their contents at any time
+    VirtualAlloc(p, sz, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_FREE)
+    static int supports_madv_free = 1;
+    if (supports_madv_free) {
+        if (madvise(p, sz, MADV_FREE) == -1) {
+            assert(errno == EINVAL);
+            supports_madv_free = 0;
+        }
+    }
+    if (!supports_madv_free) {
+        madvise(p, sz, MADV_DONTNEED);
+    }
+#else
+    madvise(p, sz, MADV_DONTNEED);
+#endif
+}
+
 const unsigned pool_sizes[] = {
     128 * 1024,
     192 * 1024,
@@ -124,6 +198,24 @@ static void _jl_free_stack(jl_ptls_t ptls, void *stkbuf, size_t bufsz)
 }
 
 
+// like _jl_free_stack, but the munmap of non-pooled stacks may be handed off
+// to the concurrent sweep thread; only called inside the pause
+static void sweep_release_stack(jl_ptls_t ptls, void *stkbuf, size_t bufsz)
+{
+#ifdef _COMPILER_ASAN_ENABLED_
+    __asan_unpoison_stack_memory((uintptr_t)stkbuf, bufsz);
+#endif
+    if (bufsz <= pool_sizes[JL_N_STACK_POOLS - 1]) {
+        unsigned pool_id = select_pool(bufsz);
+        if (pool_sizes[pool_id] == bufsz) {
+            small_arraylist_push(&ptls->heap.free_stacks[pool_id], stkbuf);
+            return;
+        }
+    }
+    sweep_free_stack(stkbuf, bufsz);
+}
+
+
 JL_DLLEXPORT void jl_free_stack(void *stkbuf, size_t bufsz)
 {
     jl_task_t *ct = jl_current_task;
@@ -221,8 +313,26 @@ void sweep_stack_pools(void)
             }
             for (int n = 0; n < n_to_free; n++) {
                 void *stk = small_arraylist_pop(al);
-                free_stack(stk, pool_sizes[p]);
+                sweep_free_stack(stk, pool_sizes[p]);
             }
+            // drop the physical backing of the stacks we keep pooled, so a
+            // pool that is idle between fan-outs does not pin RSS
+            for (size_t n = 0; n < al->len; n++)
+                shrink_stack(al->items[n], pool_sizes[p]);
+        }
+
+        // retire half of the pooled task objects that remained unused since
+        // the last sweep; dropping them from the pool unroots them, so the
+        // next collection frees them
+        small_arraylist_t *free_tasks = &ptls2->heap.free_tasks;
+        if (jl_atomic_load_relaxed(&ptls2->current_task) == NULL) {
+            free_tasks->len = 0;
+        }
+        else if (free_tasks->len > MIN_POOLED_TASKS) {
+            size_t n_to_free = free_tasks->len / 2;
+            if (n_to_free > free_tasks->len - MIN_POOLED_TASKS)
+                n_to_free = free_tasks->len - MIN_POOLED_TASKS;
+            free_tasks->len -= n_to_free;
         }
 
         small_arraylist_t *live_tasks = &ptls2->heap.live_tasks;
@@ -247,7 +357,7 @@ void sweep_stack_pools(void)
                 size_t bufsz = t->bufsz;
                 if (stkbuf) {
                     t->stkbuf = NULL;
-                    _jl_free_stack(ptls2, stkbuf, bufsz);
+                    sweep_release_stack(ptls2, stkbuf, bufsz);
                 }
 #ifdef _COMPILER_TSAN_ENABLED_
                 if (t->ctx.tsan_state) {
@@ -255,6 +365,15 @@ void sweep_stack_pools(void)
                     t->ctx.tsan_state = NULL;
                 }
 #endif
+                // the task object itself is now known to be unreachable, so
+                // recycle it instead of letting the pool sweep free it; a
+                // later encounter in another thread's list sees it marked
+                // and cannot claim it twice
+                if (free_tasks->len < MAX_POOLED_TASKS &&
+                    jl_atomic_load_relaxed(&ptls2->current_task) != NULL) {
+                    gc_claim_dead_task(t);
+                    small_arraylist_push(free_tasks, (void*)t);
+                }
             }
             if (n >= l - ndel)
                 break;
@@ -8,6 +8,9 @@
 #ifdef __GLIBC__
 #include <malloc.h> // for malloc_trim
 #endif
+#ifdef _OS_LINUX_
+#include <sys/syscall.h> // for SYS_getcpu
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -193,6 +196,9 @@ static _Atomic(int) support_conservative_marking = 0;
  */
 
 jl_gc_num_t gc_num = {0};
+// per-phase record of the most recent collection, see jl_gc_get_last_collection_stats
+static jl_gc_collection_stats_t gc_last_collection_stats;
+static _Atomic(uint64_t) gc_pages_swept_this_gc;
 static size_t last_long_collect_interval;
 int gc_n_threads;
 jl_ptls_t* gc_all_tls_states;
@@ -403,6 +409,14 @@ JL_DLLEXPORT void jl_gc_init_finalizer_rng_state(void)
     jl_rng_split(finalizer_rngState, jl_current_task->rngState);
 }
 
+// Cap on how many finalizers a single `run_finalizers` call drains. When more
+// are pending, `jl_gc_have_pending_finalizers` stays set so the remaining
+// batches are picked up by whichever threads reach a safepoint next; with
+// multiple mutator threads this runs independent finalizers concurrently
+// instead of stalling the triggering task for the entire list. The exit-time
+// path (`finalizers_thread`) always drains everything.
+#define GC_FINALIZER_BATCH 512
+
 static void run_finalizers(jl_task_t *ct, int finalizers_thread)
 {
     // Racy fast path:
@@ -418,12 +432,26 @@ static void run_finalizers(jl_task_t *ct, int finalizers_thread)
         return;
     }
     arraylist_t copied_list;
-    memcpy(&copied_list, &to_finalize, sizeof(copied_list));
-    if (to_finalize.items == to_finalize._space) {
-        copied_list.items = copied_list._space;
+    size_t batch = 2 * GC_FINALIZER_BATCH; // (value, function) pairs
+    if (!finalizers_thread && to_finalize.len > batch) {
+        // take the most recently added entries so that the usual reverse
+        // (LIFO) execution order is preserved across batches when they end
+        // up running sequentially on a single thread
+        arraylist_new(&copied_list, batch);
+        size_t rest = to_finalize.len - batch;
+        memcpy(copied_list.items, to_finalize.items + rest, batch * sizeof(void*));
+        copied_list.len = batch;
+        to_finalize.len = rest;
+        // `jl_gc_have_pending_finalizers` stays set for the remaining batches
+    }
+    else {
+        memcpy(&copied_list, &to_finalize, sizeof(copied_list));
+        if (to_finalize.items == to_finalize._space) {
+            copied_list.items = copied_list._space;
+        }
+        jl_atomic_store_relaxed(&jl_gc_have_pending_finalizers, 0);
+        arraylist_new(&to_finalize, 0);
     }
-    jl_atomic_store_relaxed(&jl_gc_have_pending_finalizers, 0);
-    arraylist_new(&to_finalize, 0);
 
     uint64_t save_rngState[JL_RNG_SIZE];
     memcpy(&save_rngState[0], &ct->rngState[0], sizeof(save_rngState));
@@ -719,9 +747,10 @@ static int mark_reset_age = 0;
 // A quick sweep is a sweep where `!sweep_full`
 // It means we won't touch GC_OLD_MARKED objects (old gen).
 
-// When a reachable object has survived more than PROMOTE_AGE+1 collections
-// it is tagged with GC_OLD during sweep and will be promoted on next mark
-// because at that point we can know easily if it references young objects.
+// When a reachable object has survived `gc_promote_age` quick collections
+// (one by default, see JULIA_GC_PROMOTE_AGE) it is tagged with GC_OLD during
+// sweep and will be promoted on next mark because at that point we can know
+// easily if it references young objects.
 // Marked old objects that reference young ones are kept in the remset.
 
 // When a write barrier triggers, the offending marked object is both queued,
@@ -732,6 +761,19 @@ static int64_t perm_scanned_bytes; // old bytes scanned while marking
 int prev_sweep_full = 1;
 int current_sweep_full = 0;
 int under_pressure = 0;
+// opt-in via `JULIA_GC_LAZY_SWEEP=1`: defer the pool-page sweep of quick
+// collections to allocation time (see gc_sweep_pool)
+int gc_lazy_sweep_enabled = 0;
+// opt-in via `JULIA_GC_TLAB_MB=n`: hand each thread a contiguous run of this
+// many pages per size class and bump-allocate straight through it, deferring
+// the per-page bookkeeping to the start of the next collection
+int gc_tlab_pages = 0;
+// Number of quick collections a pool object must survive before it is
+// promoted to the old generation. The default of 1 (promote on first
+// survival) matches the historical behavior and has no bookkeeping cost;
+// higher values (`JULIA_GC_PROMOTE_AGE`, up to 7) keep medium-lived objects
+// out of the old generation at the price of one age byte per object cell.
+int gc_promote_age = 1;
 
 // Full collection heuristics
 static int64_t live_bytes = 0;
@@ -916,6 +958,40 @@ void gc_setmark_buf(jl_ptls_t ptls, void *o, uint8_t mark_mode, size_t minsz) JL
     gc_setmark_buf_(ptls, o, mark_mode, minsz);
 }
 
+// Claim an unreachable task object discovered by `sweep_stack_pools` so that
+// `jl_new_task` can reuse it instead of allocating a fresh one. This runs
+// after marking (so an unmarked task has no pending finalizer either; those
+// were resurrected before the sweep) but before the pool sweep, so re-marking
+// the object here makes the sweep treat it as a survivor. The mark must go
+// through the regular setmark path: a naked bits write would leave the page
+// metadata unmarked and the sweep could return the whole page to the OS.
+// Every reference the task holds is severed, since its referents are being
+// freed by this same collection.
+void gc_claim_dead_task(jl_task_t *t) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_taggedvalue_t *o = jl_astaggedvalue(t);
+    uint8_t bits = (gc_old(o->header) && !mark_reset_age) ? GC_OLD_MARKED : GC_MARKED;
+    if (gc_try_setmark_tag(o, GC_MARKED))
+        gc_setmark(ptls, o, bits, sizeof(jl_task_t));
+    t->next = jl_nothing;
+    t->queue = jl_nothing;
+    t->tls = jl_nothing;
+    t->donenotify = jl_nothing;
+    t->result = jl_nothing;
+    t->scope = jl_nothing;
+    t->start = jl_nothing;
+    t->gcstack = NULL;
+    t->excstack = NULL;
+    t->eh = NULL;
+    t->ptls = NULL;
+    t->stkbuf = NULL;
+    t->bufsz = 0;
+    t->copy_stack = 0;
+    t->started = 0;
+    jl_atomic_store_relaxed(&t->tid, -1);
+}
+
 STATIC_INLINE void maybe_collect(jl_ptls_t ptls)
 {
     if (jl_atomic_load_relaxed(&gc_heap_stats.heap_size) >= jl_atomic_load_relaxed(&gc_heap_stats.heap_target) || jl_gc_debug_check_other()) {
@@ -1075,9 +1151,9 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
             *pv = nxt;
             if (nxt)
                 nxt->prev = pv;
-            gc_num.freed += v->sz&~3;
-            jl_atomic_store_relaxed(&gc_heap_stats.heap_size,
-                jl_atomic_load_relaxed(&gc_heap_stats.heap_size) - (v->sz&~3));
+            // lists are swept in parallel: the counter updates must be atomic
+            jl_atomic_fetch_add_relaxed((_Atomic(int64_t)*)&gc_num.freed, v->sz&~3);
+            jl_atomic_fetch_add_relaxed(&gc_heap_stats.heap_size, -(v->sz&~3));
 #ifdef MEMDEBUG
             memset(v, 0xbb, v->sz&~3);
 #endif
@@ -1091,15 +1167,51 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
     return pv;
 }
 
+void gc_sweep_wake_all(void);
+
+// nonzero while the parallel GC threads may claim big-object lists;
+// cleared before the master waits for the sweepers to drain
+_Atomic(int) gc_bigval_sweep_pending = 0;
+// next thread id whose big-object list is up for sweeping
+static _Atomic(int) gc_bigval_sweep_tid = 0;
+
+// Parallel sweep of the per-thread big-object lists. The lists are
+// independent, so work is distributed at the granularity of one thread's
+// list, claimed through `gc_bigval_sweep_tid`.
+void gc_sweep_big_parallel(void)
+{
+    jl_atomic_fetch_add(&gc_n_threads_sweeping, 1);
+    if (jl_atomic_load(&gc_bigval_sweep_pending)) {
+        while (1) {
+            int t_i = jl_atomic_fetch_add(&gc_bigval_sweep_tid, 1);
+            if (t_i >= gc_n_threads)
+                break;
+            jl_ptls_t ptls2 = gc_all_tls_states[t_i];
+            if (ptls2 == NULL)
+                continue;
+            sweep_big_list(current_sweep_full, &ptls2->heap.big_objects);
+        }
+    }
+    jl_atomic_fetch_add(&gc_n_threads_sweeping, -1);
+}
+
+static void gc_sweep_big_wait_for_all(void)
+{
+    jl_atomic_store(&gc_bigval_sweep_pending, 0);
+    while (jl_atomic_load_relaxed(&gc_n_threads_sweeping) != 0) {
+        jl_cpu_pause();
+    }
+}
+
 static void sweep_big(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
     gc_time_big_start();
     assert(gc_n_threads);
-    for (int i = 0; i < gc_n_threads; i++) {
-        jl_ptls_t ptls2 = gc_all_tls_states[i];
-        if (ptls2 != NULL)
-            sweep_big_list(sweep_full, &ptls2->heap.big_objects);
-    }
+    jl_atomic_store(&gc_bigval_sweep_tid, 0);
+    jl_atomic_store(&gc_bigval_sweep_pending, 1);
+    gc_sweep_wake_all();
+    gc_sweep_big_parallel();
+    gc_sweep_big_wait_for_all();
     if (sweep_full) {
         bigval_t **last_next = sweep_big_list(sweep_full, &big_objects_marked);
         // Move all survivors from big_objects_marked list to the big_objects list of this thread.
@@ -1213,6 +1325,14 @@ size_t jl_genericmemory_nbytes(jl_genericmemory_t *m) JL_NOTSAFEPOINT
 }
 
 
+static void jl_gc_count_freed_memory(jl_genericmemory_t *m) JL_NOTSAFEPOINT
+{
+    jl_atomic_store_relaxed(&gc_heap_stats.heap_size,
+        jl_atomic_load_relaxed(&gc_heap_stats.heap_size) - jl_genericmemory_nbytes(m));
+    gc_num.freed += jl_genericmemory_nbytes(m);
+    gc_num.freecall++;
+}
+
 static void jl_gc_free_memory(jl_value_t *v, int isaligned) JL_NOTSAFEPOINT
 {
     assert(jl_is_genericmemory(v));
@@ -1223,10 +1343,45 @@ static void jl_gc_free_memory(jl_value_t *v, int isaligned) JL_NOTSAFEPOINT
         jl_free_aligned(d);
     else
         free(d);
-    jl_atomic_store_relaxed(&gc_heap_stats.heap_size,
-        jl_atomic_load_relaxed(&gc_heap_stats.heap_size) - jl_genericmemory_nbytes(m));
-    gc_num.freed += jl_genericmemory_nbytes(m);
-    gc_num.freecall++;
+    jl_gc_count_freed_memory(m);
+}
+
+// Buffers of unreachable Memory unlinked inside the pause and freed
+// afterwards by the concurrent sweep thread (scheduler.c). The accounting
+// reads the object header, which the pool sweep is about to recycle, so it
+// stays in the pause; `ma->a` is repointed at the buffer itself (keeping the
+// alignment bit) and only the free calls are deferred. Pushes happen only
+// during the pause, but the drain of the previous collection's batch may
+// still be running, so both ends use CAS.
+static _Atomic(mallocarray_t *) deferred_mallocarrays;
+
+static void defer_free_memory(mallocarray_t *ma, jl_value_t *v, int isaligned) JL_NOTSAFEPOINT
+{
+    assert(jl_is_genericmemory(v));
+    jl_genericmemory_t *m = (jl_genericmemory_t*)v;
+    jl_gc_count_freed_memory(m);
+    ma->a = (jl_value_t*)((uintptr_t)m->ptr | isaligned);
+    mallocarray_t *head = jl_atomic_load_relaxed(&deferred_mallocarrays);
+    do {
+        ma->next = head;
+    } while (!jl_atomic_cmpswap(&deferred_mallocarrays, &head, ma));
+}
+
+void gc_free_deferred_memory(void)
+{
+    mallocarray_t *ma = jl_atomic_exchange(&deferred_mallocarrays, NULL);
+    while (ma != NULL) {
+        mallocarray_t *nxt = ma->next;
+        char *d = (char*)((uintptr_t)ma->a & ~(uintptr_t)1);
+        if ((uintptr_t)ma->a & 1)
+            jl_free_aligned(d);
+        else
+            free(d);
+        // the node cannot go back on its owner's mafreelist from this
+        // thread, so return it to malloc instead
+        free(ma);
+        ma = nxt;
+    }
 }
 
 static void sweep_malloced_memory(void) JL_NOTSAFEPOINT
@@ -1248,9 +1403,17 @@ static void sweep_malloced_memory(void) JL_NOTSAFEPOINT
                 else {
                     *pma = nxt;
                     int isaligned = (uintptr_t)ma->a & 1;
-                    jl_gc_free_memory(a, isaligned);
-                    ma->next = ptls2->heap.mafreelist;
-                    ptls2->heap.mafreelist = ma;
+#ifdef _P64
+                    if (jl_n_sweepthreads > 0) {
+                        defer_free_memory(ma, a, isaligned);
+                    }
+                    else
+#endif
+                    {
+                        jl_gc_free_memory(a, isaligned);
+                        ma->next = ptls2->heap.mafreelist;
+                        ptls2->heap.mafreelist = ma;
+                    }
                 }
                 gc_time_count_mallocd_memory(bits);
                 ma = nxt;
@@ -1271,16 +1434,32 @@ STATIC_INLINE jl_taggedvalue_t *gc_reset_page(jl_ptls_t ptls2, const jl_gc_pool_
     pg->has_marked = 0;
     pg->prev_nold = 0;
     pg->nold = 0;
+    // a reused page may carry survival counts from a previous tenancy with a
+    // different object size, where they would map to the wrong cells
+    if (pg->ages != NULL)
+        memset(pg->ages, 0, GC_PAGE_SZ / sizeof(void*));
     pg->fl_begin_offset = UINT16_MAX;
     pg->fl_end_offset = UINT16_MAX;
     return beg;
 }
 
-jl_gc_page_stack_t global_page_pool_lazily_freed;
+jl_gc_page_stack_t global_page_pool_lazily_freed[JL_GC_N_NUMA_SHARDS];
 jl_gc_page_stack_t global_page_pool_clean;
 jl_gc_page_stack_t global_page_pool_freed;
 pagetable_t alloc_map;
 
+// NUMA shard of the cpu the caller is running on (node id modulo the shard
+// count); 0 when the platform has no cheap way to tell
+int jl_gc_current_numa_shard(void) JL_NOTSAFEPOINT
+{
+#if defined(_OS_LINUX_) && defined(SYS_getcpu)
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+        return node % JL_GC_N_NUMA_SHARDS;
+#endif
+    return 0;
+}
+
 // Add a new page to the pool. Discards any pages in `p->newpages` before.
 static NOINLINE jl_taggedvalue_t *gc_add_page(jl_gc_pool_t *p) JL_NOTSAFEPOINT
 {
@@ -1304,6 +1483,174 @@ static NOINLINE jl_taggedvalue_t *gc_add_page(jl_gc_pool_t *p) JL_NOTSAFEPOINT
     return fl;
 }
 
+// Register with the GC every page of a pool's bump region (JULIA_GC_TLAB_MB)
+// that the bump pointer has passed through. This must happen before a mark
+// phase can encounter objects in those pages, because marking a pool object
+// dereferences its page metadata (see gc_setmark_pool_). Runs on the owner
+// thread when a region is replaced and, via gc_tlab_materialize_all, for
+// every thread when a collection begins.
+static void gc_tlab_materialize(jl_ptls_t ptls2, jl_gc_pool_t *p) JL_NOTSAFEPOINT
+{
+    if (p->tlab_meta == NULL)
+        return;
+    char *pos = p->tlab_pos;
+    // when the region is exhausted every remaining page has been consumed
+    char *limit = pos != NULL ? pos - GC_PAGE_OFFSET : p->tlab_end;
+    while (p->tlab_base < limit) {
+        jl_gc_pagemeta_t *pg = p->tlab_meta;
+        assert(pg->data == p->tlab_base);
+        pg->osize = p->osize;
+        pg->thread_n = ptls2->tid;
+        gc_reset_page(ptls2, p, pg);
+        // the bump pointer passed through (or into) this page
+        pg->nfree = 0;
+        pg->has_young = 1;
+        gc_alloc_map_set(pg->data, GC_PAGE_ALLOCATED);
+        set_page_metadata(pg);
+        push_lf_back(&ptls2->page_metadata_allocd, pg);
+        jl_atomic_fetch_add_relaxed(&gc_heap_stats.heap_size, GC_PAGE_SZ);
+        p->tlab_base += GC_PAGE_SZ;
+        p->tlab_meta++;
+    }
+    if (pos != NULL && pos != p->tlab_base + GC_PAGE_OFFSET) {
+        // the bump pointer is mid-page: export it through `newpages` so the
+        // sweep puts the cells past it on the freelist (the sweep resets
+        // `newpages` when it is done), and continue the region at the next
+        // untouched page
+        p->newpages = (jl_taggedvalue_t*)pos;
+        char *beg = p->tlab_base + GC_PAGE_OFFSET;
+        p->tlab_pos = beg + p->osize <= p->tlab_end ? beg : NULL;
+    }
+}
+
+// Replace an exhausted bump region with a freshly mapped one, registering
+// the pages of the old region first: they are full of objects the next mark
+// phase must be able to reach. Returns 0 when the mapping fails and the
+// caller should fall back to page-at-a-time allocation.
+static NOINLINE int gc_tlab_refill(jl_ptls_t ptls, jl_gc_pool_t *p) JL_NOTSAFEPOINT
+{
+    jl_gc_pagemeta_t *meta = jl_gc_alloc_page_run(gc_tlab_pages);
+    if (meta == NULL)
+        return 0;
+    gc_tlab_materialize(ptls, p);
+    p->tlab_meta = meta;
+    p->tlab_base = meta[0].data;
+    p->tlab_pos = meta[0].data + GC_PAGE_OFFSET;
+    p->tlab_end = meta[0].data + GC_PAGE_SZ * (size_t)gc_tlab_pages;
+    return 1;
+}
+
+// Called when a collection begins: register the consumed portion of every
+// thread's bump regions so the mark phase can reach their page metadata
+static void gc_tlab_materialize_all(void)
+{
+    if (!gc_tlab_pages)
+        return;
+    for (int t_i = 0; t_i < gc_n_threads; t_i++) {
+        jl_ptls_t ptls2 = gc_all_tls_states[t_i];
+        if (ptls2 == NULL)
+            continue;
+        for (int i = 0; i < JL_GC_N_POOLS; i++)
+            gc_tlab_materialize(ptls2, &ptls2->heap.norm_pools[i]);
+    }
+}
+
+// arena allocation for provably non-escaping temporaries
+//
+// An arena is a per-thread bump allocator with O(1) reset, meant as a
+// compiler target for allocation groups that provably do not escape the
+// region between `open` and `reset`/`close`. Objects allocated here carry a
+// normal type tag but are not tracked by the GC — like the stack allocations
+// produced by the alloc-opt pass — and are tagged `GC_OLD_MARKED` so that,
+// like permanently allocated objects, the mark loop never tries to claim
+// them through the page metadata should a reference leak into a root.
+
+#define GC_ARENA_CHUNK_SZ (256 * 1024)
+
+typedef struct _jl_gc_arena_chunk_t {
+    struct _jl_gc_arena_chunk_t *next;
+    void *_pad; // keep the chunk data 16-byte aligned
+    // chunk data follows
+} jl_gc_arena_chunk_t;
+
+struct _jl_gc_arena_t {
+    char *cur;
+    char *end;
+    jl_gc_arena_chunk_t *chunks;   // chunks in use, most recent first
+    jl_gc_arena_chunk_t *freelist; // retired chunks kept for reuse
+    struct _jl_gc_arena_t *prev;   // enclosing arena of this thread, if any
+};
+
+static void gc_arena_add_chunk(jl_gc_arena_t *a) JL_NOTSAFEPOINT
+{
+    jl_gc_arena_chunk_t *c = a->freelist;
+    if (c != NULL)
+        a->freelist = c->next;
+    else
+        c = (jl_gc_arena_chunk_t*)malloc_s(sizeof(jl_gc_arena_chunk_t) + GC_ARENA_CHUNK_SZ);
+    c->next = a->chunks;
+    a->chunks = c;
+    // values must be 16-byte aligned, with the tag in the word before them
+    a->cur = (char*)(c + 1) + JL_SMALL_BYTE_ALIGNMENT - sizeof(jl_taggedvalue_t);
+    a->end = (char*)(c + 1) + GC_ARENA_CHUNK_SZ;
+}
+
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_arena_open(void)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_gc_arena_t *a = (jl_gc_arena_t*)malloc_s(sizeof(jl_gc_arena_t));
+    a->cur = a->end = NULL;
+    a->chunks = NULL;
+    a->freelist = NULL;
+    a->prev = ptls->heap.current_arena;
+    ptls->heap.current_arena = a;
+    return a;
+}
+
+JL_DLLEXPORT jl_value_t *jl_gc_arena_alloc(jl_gc_arena_t *a, size_t sz, void *ty)
+{
+    size_t allocsz = LLT_ALIGN(sz + sizeof(jl_taggedvalue_t), JL_SMALL_BYTE_ALIGNMENT);
+    if (__unlikely(allocsz > GC_ARENA_CHUNK_SZ - JL_SMALL_BYTE_ALIGNMENT)) {
+        // oversized: fall back to an ordinary (tracked) allocation, which
+        // simply gets collected instead of being reclaimed by the reset
+        return jl_gc_alloc(jl_current_task->ptls, sz, ty);
+    }
+    if (__unlikely(a->cur == NULL || a->cur + allocsz > a->end))
+        gc_arena_add_chunk(a);
+    jl_taggedvalue_t *o = (jl_taggedvalue_t*)a->cur;
+    a->cur += allocsz;
+    o->header = (uintptr_t)ty | GC_OLD_MARKED;
+    return jl_valueof(o);
+}
+
+// Retire every chunk of the arena for reuse; O(1) in the number of objects
+JL_DLLEXPORT void jl_gc_arena_reset(jl_gc_arena_t *a)
+{
+    while (a->chunks != NULL) {
+        jl_gc_arena_chunk_t *c = a->chunks;
+        a->chunks = c->next;
+        c->next = a->freelist;
+        a->freelist = c;
+    }
+    a->cur = a->end = NULL;
+}
+
+JL_DLLEXPORT void jl_gc_arena_close(jl_gc_arena_t *a)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    assert(ptls->heap.current_arena == a);
+    ptls->heap.current_arena = a->prev;
+    jl_gc_arena_reset(a);
+    while (a->freelist != NULL) {
+        jl_gc_arena_chunk_t *c = a->freelist;
+        a->freelist = c->next;
+        free(c);
+    }
+    free(a);
+}
+
+static NOINLINE int gc_lazy_sweep_refill(jl_ptls_t ptls, jl_gc_pool_t *p) JL_NOTSAFEPOINT;
+
 // Size includes the tag and the tag is not cleared!!
 STATIC_INLINE jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset,
                                           int osize)
@@ -1323,6 +1670,7 @@ STATIC_INLINE jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
         jl_atomic_load_relaxed(&ptls->gc_num.pool_live_bytes) + osize);
     jl_atomic_store_relaxed(&ptls->gc_num.poolalloc,
         jl_atomic_load_relaxed(&ptls->gc_num.poolalloc) + 1);
+    p->alloc_bytes += osize; // per-size-class timeline, owner-thread only
     // first try to use the freelist
     jl_taggedvalue_t *v = p->freelist;
     if (v != NULL) {
@@ -1339,6 +1687,19 @@ STATIC_INLINE jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
         msan_allocated_memory(v, osize);
         return jl_valueof(v);
     }
+    // then bump through the multi-page region, when one is active
+    // (JULIA_GC_TLAB_MB); `tlab_pos` stays NULL when the mode is disabled
+    v = (jl_taggedvalue_t*)p->tlab_pos;
+    if (v != NULL) {
+        char *bump = (char*)v + osize;
+        if (__unlikely(bump + osize > gc_page_data((char*)v) + GC_PAGE_SZ))
+            // cells never straddle a page boundary: hop over the metadata
+            // area at the start of the next page
+            bump = gc_page_data((char*)v) + GC_PAGE_SZ + GC_PAGE_OFFSET;
+        p->tlab_pos = bump + osize <= p->tlab_end ? bump : NULL;
+        msan_allocated_memory(v, osize);
+        return jl_valueof(v);
+    }
     // if the freelist is empty we reuse empty but not freed pages
     v = p->newpages;
     jl_taggedvalue_t *next = (jl_taggedvalue_t*)((char*)v + osize);
@@ -1354,6 +1715,31 @@ STATIC_INLINE jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
             pg->nfree = 0;
             pg->has_young = 1;
         }
+        if (__unlikely(gc_lazy_sweep_enabled) && gc_lazy_sweep_refill(ptls, p)) {
+            // a deferred sweep refilled the freelist; allocate from it like
+            // the fast path above
+            v = p->freelist;
+            jl_taggedvalue_t *fl_next = v->next;
+            p->freelist = fl_next;
+            if (__unlikely(gc_page_data(v) != gc_page_data(fl_next))) {
+                jl_gc_pagemeta_t *pg = jl_assume(page_metadata_unsafe(v));
+                assert(pg->osize == p->osize);
+                pg->nfree = 0;
+                pg->has_young = 1;
+            }
+            msan_allocated_memory(v, osize);
+            return jl_valueof(v);
+        }
+        if (__unlikely(gc_tlab_pages) && gc_tlab_refill(ptls, p)) {
+            // the page `newpages` pointed into (if any) was full; its
+            // metadata was updated above
+            p->newpages = NULL;
+            v = (jl_taggedvalue_t*)p->tlab_pos;
+            // the first page of a fresh region always holds several cells
+            p->tlab_pos = (char*)v + osize;
+            msan_allocated_memory(v, osize);
+            return jl_valueof(v);
+        }
         v = gc_add_page(p);
         next = (jl_taggedvalue_t*)((char*)v + osize);
     }
@@ -1500,6 +1886,17 @@ static void gc_sweep_page(gc_page_profiler_serializer_t *s, jl_gc_pool_t *p, jl_
             }
             v = v0;
         }
+        // survivor ages, tracked only above the default tenuring threshold
+        uint8_t *ages = NULL;
+        if (__unlikely(gc_promote_age > 1)) {
+            if (pg->ages == NULL) {
+                // sized for the smallest object class, so any reuse of the
+                // page can keep the array (it is reset in gc_reset_page)
+                pg->ages = (uint8_t*)malloc_s(GC_PAGE_SZ / sizeof(void*));
+                memset(pg->ages, 0, GC_PAGE_SZ / sizeof(void*));
+            }
+            ages = pg->ages;
+        }
         // sweep the page
         while ((char*)v <= lim) {
             int bits = v->bits.gc;
@@ -1509,12 +1906,24 @@ static void gc_sweep_page(gc_page_profiler_serializer_t *s, jl_gc_pool_t *p, jl_
                 pfl = &v->next;
                 pfl_begin = (pfl_begin != NULL) ? pfl_begin : pfl;
                 pg_nfree++;
+                if (__unlikely(ages != NULL))
+                    ages[((char*)v - data) / osize] = 0; // the cell restarts young
             }
             else { // marked young or old
                 if (current_sweep_full || bits == GC_MARKED) { // old enough
-                    bits = v->bits.gc = GC_OLD; // promote
+                    if (__unlikely(ages != NULL) && bits == GC_MARKED &&
+                            ++ages[((char*)v - data) / osize] < gc_promote_age) {
+                        // survived, but not tenured yet: stays young and is
+                        // re-marked from the roots by the next collection
+                        bits = v->bits.gc = GC_CLEAN;
+                        has_young = 1;
+                    }
+                    else {
+                        bits = v->bits.gc = GC_OLD; // promote
+                    }
                 }
-                prev_nold++;
+                if (bits != GC_CLEAN)
+                    prev_nold++;
                 has_marked |= gc_marked(bits);
                 freedall = 0;
             }
@@ -1541,6 +1950,20 @@ static void gc_sweep_page(gc_page_profiler_serializer_t *s, jl_gc_pool_t *p, jl_
     nfree = pg->nfree;
 
 done:
+    // do all the metadata-derived accounting before publishing the page:
+    // once a freed page is pushed to the buffered/global pools another thread
+    // may pop and reinitialize it right away when sweeping lazily
+    gc_update_page_fragmentation_data(pg);
+    gc_time_count_page(freedall, pg_skpd);
+    jl_atomic_fetch_add_relaxed(&gc_pages_swept_this_gc, 1);
+    // `gc_all_tls_states` is only set during a collection; lazy sweeping
+    // (JULIA_GC_LAZY_SWEEP) also runs this between collections
+    jl_ptls_t *all_tls_states = gc_all_tls_states;
+    if (all_tls_states == NULL)
+        all_tls_states = jl_atomic_load_relaxed(&jl_all_tls_states);
+    jl_ptls_t ptls = all_tls_states[pg->thread_n];
+    jl_atomic_fetch_add(&ptls->gc_num.pool_live_bytes, GC_PAGE_SZ - GC_PAGE_OFFSET - nfree * osize);
+    jl_atomic_fetch_add((_Atomic(int64_t) *)&gc_num.freed, (nfree - old_nfree) * osize);
     if (re_use_page) {
         push_lf_back(allocd, pg);
     }
@@ -1551,15 +1974,10 @@ done:
             push_lf_back(buffered, pg);
         }
         else {
-            push_lf_back(&global_page_pool_lazily_freed, pg);
+            push_lf_back(&global_page_pool_lazily_freed[pg->numa_shard], pg);
         }
     }
     gc_page_profile_write_to_file(s);
-    gc_update_page_fragmentation_data(pg);
-    gc_time_count_page(freedall, pg_skpd);
-    jl_ptls_t ptls = gc_all_tls_states[pg->thread_n];
-    jl_atomic_fetch_add(&ptls->gc_num.pool_live_bytes, GC_PAGE_SZ - GC_PAGE_OFFSET - nfree * osize);
-    jl_atomic_fetch_add((_Atomic(int64_t) *)&gc_num.freed, (nfree - old_nfree) * osize);
 }
 
 // the actual sweeping over all allocated pages in a memory pool
@@ -1568,12 +1986,73 @@ STATIC_INLINE void gc_sweep_pool_page(gc_page_profiler_serializer_t *s, jl_gc_pa
 {
     int p_n = pg->pool_n;
     int t_n = pg->thread_n;
-    jl_ptls_t ptls2 = gc_all_tls_states[t_n];
+    jl_ptls_t *all_tls_states = gc_all_tls_states;
+    if (all_tls_states == NULL) // lazy sweeping outside of a collection
+        all_tls_states = jl_atomic_load_relaxed(&jl_all_tls_states);
+    jl_ptls_t ptls2 = all_tls_states[t_n];
     jl_gc_pool_t *p = &ptls2->heap.norm_pools[p_n];
     int osize = pg->osize;
     gc_sweep_page(s, p, allocd, lazily_freed, pg, osize);
 }
 
+// Sweep deferred pages of the calling thread until one of them feeds
+// `p->freelist` (or none are left). Pages whose objects all died are released
+// by the sweep itself; surviving pages land back on our own
+// `page_metadata_allocd` stack, where we can splice their free cells into the
+// owning pool. Returns 1 if `p->freelist` is non-empty on return.
+static NOINLINE int gc_lazy_sweep_refill(jl_ptls_t ptls, jl_gc_pool_t *p) JL_NOTSAFEPOINT
+{
+    int refilled = 0;
+    gc_page_profiler_serializer_t serializer = gc_page_serializer_create();
+    while (!refilled) {
+        jl_gc_pagemeta_t *pg = pop_lf_back(&ptls->page_metadata_lazy_sweep);
+        if (pg == NULL)
+            break;
+        gc_sweep_pool_page(&serializer, &ptls->page_metadata_allocd, &ptls->page_metadata_buffered, pg);
+        // a fully freed page goes to the buffered/global pools inside the
+        // sweep and may be handed to another thread right away: only read
+        // its metadata back if it survived onto our own allocd stack
+        if (jl_atomic_load_relaxed(&ptls->page_metadata_allocd.bottom) != pg)
+            continue;
+        if (pg->fl_begin_offset == UINT16_MAX)
+            continue; // survived with no free cells
+        jl_taggedvalue_t *fl_beg = (jl_taggedvalue_t*)(pg->data + pg->fl_begin_offset);
+        jl_taggedvalue_t *fl_end = (jl_taggedvalue_t*)(pg->data + pg->fl_end_offset);
+        jl_gc_pool_t *p2 = &ptls->heap.norm_pools[pg->pool_n];
+        fl_end->next = p2->freelist;
+        p2->freelist = fl_beg;
+        if (p2 == p)
+            refilled = 1;
+    }
+    gc_page_serializer_destroy(&serializer);
+    return refilled;
+}
+
+// Finish any pool sweeping deferred from the previous collection. This must
+// run before the mark phase: the deferred pages still carry the previous
+// cycle's mark bits, which the sweep consumes and clears. The freed cells are
+// not spliced into the pool freelists here; this collection's own sweep
+// rediscovers them.
+static void gc_lazy_sweep_drain_all(void)
+{
+    if (!gc_lazy_sweep_enabled)
+        return;
+    gc_page_profiler_serializer_t serializer = gc_page_serializer_create();
+    assert(gc_n_threads);
+    for (int t_i = 0; t_i < gc_n_threads; t_i++) {
+        jl_ptls_t ptls2 = gc_all_tls_states[t_i];
+        if (ptls2 == NULL)
+            continue;
+        while (1) {
+            jl_gc_pagemeta_t *pg = pop_lf_back(&ptls2->page_metadata_lazy_sweep);
+            if (pg == NULL)
+                break;
+            gc_sweep_pool_page(&serializer, &ptls2->page_metadata_allocd, &ptls2->page_metadata_buffered, pg);
+        }
+    }
+    gc_page_serializer_destroy(&serializer);
+}
+
 // sweep over all memory that is being used and not in a pool
 static void gc_sweep_other(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
@@ -1616,26 +2095,35 @@ void gc_sweep_wait_for_all(void)
     }
 }
 
+// number of pages each sweeper claims from a page stack per CAS round:
+// amortizes contention on `pop_lf_back` when many threads sweep concurrently
+#define GC_SWEEP_PAGE_BATCH 8
+
 void gc_sweep_pool_parallel(void)
 {
-    jl_atomic_fetch_add(&gc_n_threads_sweeping, 1);
+    int sweeper_n = jl_atomic_fetch_add(&gc_n_threads_sweeping, 1);
     jl_gc_page_stack_t *allocd_scratch = jl_atomic_load(&gc_allocd_scratch);
     if (allocd_scratch != NULL) {
         gc_page_profiler_serializer_t serializer = gc_page_serializer_create();
         while (1) {
             int found_pg = 0;
-            for (int t_i = 0; t_i < gc_n_threads; t_i++) {
+            // stagger the scan start so that concurrent sweepers don't all
+            // contend on the page stack of the same thread
+            for (int i = 0; i < gc_n_threads; i++) {
+                int t_i = (i + sweeper_n) % gc_n_threads;
                 jl_ptls_t ptls2 = gc_all_tls_states[t_i];
                 if (ptls2 == NULL) {
                     continue;
                 }
                 jl_gc_page_stack_t *allocd = &allocd_scratch[t_i];
-                jl_gc_pagemeta_t *pg = pop_lf_back(&ptls2->page_metadata_allocd);
-                if (pg == NULL) {
-                    continue;
+                for (int j = 0; j < GC_SWEEP_PAGE_BATCH; j++) {
+                    jl_gc_pagemeta_t *pg = pop_lf_back(&ptls2->page_metadata_allocd);
+                    if (pg == NULL) {
+                        break;
+                    }
+                    gc_sweep_pool_page(&serializer, allocd, &ptls2->page_metadata_buffered, pg);
+                    found_pg = 1;
                 }
-                gc_sweep_pool_page(&serializer, allocd, &ptls2->page_metadata_buffered, pg);
-                found_pg = 1;
             }
             if (!found_pg) {
                 break;
@@ -1646,15 +2134,35 @@ void gc_sweep_pool_parallel(void)
     jl_atomic_fetch_add(&gc_n_threads_sweeping, -1);
 }
 
+// High-water mark for retaining swept pages in memory: pages are returned to
+// the OS only while the resident set exceeds the heap target by 25%. Pages
+// below the mark stay mapped in `global_page_pool_lazily_freed`, where the
+// allocator reuses them without paying a zero-fill fault.
+static uint64_t gc_page_retention_hwm(void) JL_NOTSAFEPOINT
+{
+    uint64_t target = jl_atomic_load_relaxed(&gc_heap_stats.heap_target);
+    uint64_t hwm = target + target / 4;
+    if (hwm > max_total_memory)
+        hwm = max_total_memory;
+    return hwm;
+}
+
 void gc_free_pages(void)
 {
-    while (1) {
-        jl_gc_pagemeta_t *pg = pop_lf_back(&global_page_pool_lazily_freed);
-        if (pg == NULL) {
-            break;
+    uint64_t hwm = gc_page_retention_hwm();
+    for (int shard = 0; shard < JL_GC_N_NUMA_SHARDS; shard++) {
+        while (1) {
+            if ((uint64_t)jl_atomic_load_relaxed(&gc_heap_stats.bytes_resident) <= hwm) {
+                // memory is not under pressure: keep the remaining pages mapped
+                return;
+            }
+            jl_gc_pagemeta_t *pg = pop_lf_back(&global_page_pool_lazily_freed[shard]);
+            if (pg == NULL) {
+                break;
+            }
+            jl_gc_free_page(pg);
+            push_lf_back(&global_page_pool_freed, pg);
         }
-        jl_gc_free_page(pg);
-        push_lf_back(&global_page_pool_freed, pg);
     }
 }
 
@@ -1711,6 +2219,31 @@ static void gc_sweep_pool(void)
         }
     }
 
+    // Lazy mode: for quick collections, park the pages instead of sweeping
+    // them and let `gc_lazy_sweep_refill` sweep them one by one when a pool
+    // runs dry, spreading the sweep cost over mutator allocation. Full sweeps
+    // stay eager: they rewrite the header bits of old objects, which must not
+    // race with mutator write barriers once the world restarts (a quick sweep
+    // only touches GC_MARKED headers, which barriers never write to).
+    if (gc_lazy_sweep_enabled && !current_sweep_full) {
+        for (int t_i = 0; t_i < n_threads; t_i++) {
+            jl_ptls_t ptls2 = gc_all_tls_states[t_i];
+            if (ptls2 == NULL)
+                continue;
+            // the previous deferral was fully drained before this collection's mark
+            assert(jl_atomic_load_relaxed(&ptls2->page_metadata_lazy_sweep.bottom) == NULL);
+            jl_gc_pagemeta_t *pg = jl_atomic_load_relaxed(&ptls2->page_metadata_allocd.bottom);
+            jl_atomic_store_relaxed(&ptls2->page_metadata_allocd.bottom, NULL);
+            jl_atomic_store_relaxed(&ptls2->page_metadata_lazy_sweep.bottom, pg);
+            for (int i = 0; i < JL_GC_N_POOLS; i++) {
+                // freelists were nulled above; newpages pages are parked too
+                ptls2->heap.norm_pools[i].newpages = NULL;
+            }
+        }
+        gc_time_pool_end(current_sweep_full);
+        return;
+    }
+
     // the actual sweeping
     jl_gc_page_stack_t *tmp = (jl_gc_page_stack_t *)alloca(n_threads * sizeof(jl_gc_page_stack_t));
     memset(tmp, 0, n_threads * sizeof(jl_gc_page_stack_t));
@@ -1784,6 +2317,26 @@ static void gc_sweep_perm_alloc(void)
 
 // mark phase
 
+// Nonzero while a concurrent mark window is open, i.e. while the mark loop
+// may run on the GC threads concurrently with the mutators. Mutators must
+// then log overwritten references through `jl_gc_queue_satb_root` so that
+// marking still covers the object graph as it existed at the snapshot.
+_Atomic(int) gc_satb_active = 0;
+// opt-in via `JULIA_GC_CONCURRENT_MARK=1`; experimental
+int gc_concurrent_mark_enabled = 0;
+
+JL_DLLEXPORT void jl_gc_queue_satb_root(const jl_value_t *ptr)
+{
+    if (!jl_atomic_load_relaxed(&gc_satb_active))
+        return;
+    jl_taggedvalue_t *o = jl_astaggedvalue(ptr);
+    // already-marked objects don't need to be snapshotted again
+    if (gc_marked(jl_atomic_load_relaxed((_Atomic(uintptr_t)*)&o->header)))
+        return;
+    jl_ptls_t ptls = jl_current_task->ptls;
+    arraylist_push(&ptls->heap.satb_buffer, (jl_value_t*)ptr);
+}
+
 JL_DLLEXPORT void jl_gc_queue_root(const jl_value_t *ptr)
 {
     jl_ptls_t ptls = jl_current_task->ptls;
@@ -1801,6 +2354,67 @@ JL_DLLEXPORT void jl_gc_queue_root(const jl_value_t *ptr)
     }
 }
 
+// Card-marking is only worthwhile for objects whose full re-scan is much more
+// expensive than a card scan; smaller ones take the regular remset path
+#define GC_CARD_MIN_BYTES 4096
+
+// Slot-aware variant of `jl_gc_queue_root` for stores into the element data
+// of an old GenericMemory object that owns its data. Instead of appending the
+// whole object to the remset (which quick collections then re-scan in full),
+// dirty the card covering the stored slot. Unlike the object barrier this
+// does not clear the age bit, so it fires on every young store; the cost of
+// the hash lookup is what the `GC_CARD_MIN_BYTES` threshold pays for.
+JL_DLLEXPORT void jl_gc_queue_memoryset_root(jl_value_t *owner, void *slot)
+{
+    jl_genericmemory_t *m = (jl_genericmemory_t*)owner;
+    char *data = (char*)m->ptr;
+    size_t nbytes = m->length * sizeof(void*);
+    if (nbytes < GC_CARD_MIN_BYTES || (char*)slot < data || (char*)slot >= data + nbytes) {
+        jl_gc_queue_root(owner);
+        return;
+    }
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_gc_memory_cards_t *c = (jl_gc_memory_cards_t*)ptrhash_get(&ptls->heap.memory_card_table, owner);
+    if (c == HT_NOTFOUND) {
+        size_t ncards = (nbytes + GC_CARD_SZ - 1) >> GC_CARD_SHIFT;
+        c = (jl_gc_memory_cards_t*)calloc_s(sizeof(jl_gc_memory_cards_t) + ncards);
+        c->owner = m;
+        c->ncards = ncards;
+        ptrhash_put(&ptls->heap.memory_card_table, owner, c);
+        arraylist_push(&ptls->heap.memory_cards, c);
+    }
+    c->cards[((char*)slot - data) >> GC_CARD_SHIFT] = 1;
+}
+
+// Range variant of `jl_gc_queue_memoryset_root` for bulk copies into the
+// element data of an old GenericMemory object: dirty every card covered by
+// [slot, slot + nbytes) in one pass so the copy itself does no per-slot
+// barrier work. `nbytes` must be nonzero.
+JL_DLLEXPORT void jl_gc_queue_memoryset_range(jl_value_t *owner, void *slot, size_t nbytes)
+{
+    jl_genericmemory_t *m = (jl_genericmemory_t*)owner;
+    char *data = (char*)m->ptr;
+    size_t ownbytes = m->length * sizeof(void*);
+    if (ownbytes < GC_CARD_MIN_BYTES || (char*)slot < data ||
+        (char*)slot + nbytes > data + ownbytes) {
+        jl_gc_queue_root(owner);
+        return;
+    }
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_gc_memory_cards_t *c = (jl_gc_memory_cards_t*)ptrhash_get(&ptls->heap.memory_card_table, owner);
+    if (c == HT_NOTFOUND) {
+        size_t ncards = (ownbytes + GC_CARD_SZ - 1) >> GC_CARD_SHIFT;
+        c = (jl_gc_memory_cards_t*)calloc_s(sizeof(jl_gc_memory_cards_t) + ncards);
+        c->owner = m;
+        c->ncards = ncards;
+        ptrhash_put(&ptls->heap.memory_card_table, owner, c);
+        arraylist_push(&ptls->heap.memory_cards, c);
+    }
+    size_t first = ((char*)slot - data) >> GC_CARD_SHIFT;
+    size_t last = ((char*)slot + nbytes - 1 - data) >> GC_CARD_SHIFT;
+    memset(&c->cards[first], 1, last - first + 1);
+}
+
 void jl_gc_queue_multiroot(const jl_value_t *parent, const void *ptr, jl_datatype_t *dt) JL_NOTSAFEPOINT
 {
     const jl_datatype_layout_t *ly = dt->layout;
@@ -1933,6 +2547,30 @@ STATIC_INLINE jl_value_t *gc_ptr_queue_pop(jl_gc_markqueue_t *mq) JL_NOTSAFEPOIN
     return v;
 }
 
+// Number of upcoming queue entries whose headers are prefetched after each
+// pop. The mark loop is mostly DRAM-latency bound on large heaps: by the time
+// an object is popped its type tag should already be on its way to cache.
+#define GC_MARK_PREFETCH_DIST 4
+
+// Prefetch the headers of the next few objects at the bottom of our own
+// pointer queue. Entries may be stolen concurrently from the top, but a
+// prefetch of a stale pointer never faults, so no synchronization is needed.
+STATIC_INLINE void gc_ptr_queue_prefetch(jl_gc_markqueue_t *mq) JL_NOTSAFEPOINT
+{
+    ws_queue_t *q = &mq->ptr_queue;
+    int64_t b = jl_atomic_load_relaxed(&q->bottom);
+    int64_t t = jl_atomic_load_relaxed(&q->top);
+    ws_array_t *ary = jl_atomic_load_relaxed(&q->array);
+    int64_t n = b - t;
+    if (n > GC_MARK_PREFETCH_DIST)
+        n = GC_MARK_PREFETCH_DIST;
+    for (int64_t i = 1; i <= n; i++) {
+        jl_value_t *v = ((jl_value_t**)ary->buffer)[(b - i) & ary->mask];
+        if (v != NULL)
+            __builtin_prefetch(jl_astaggedvalue(v));
+    }
+}
+
 // Steal from `mq2`
 STATIC_INLINE jl_value_t *gc_ptr_queue_steal_from(jl_gc_markqueue_t *mq2) JL_NOTSAFEPOINT
 {
@@ -1941,6 +2579,23 @@ STATIC_INLINE jl_value_t *gc_ptr_queue_steal_from(jl_gc_markqueue_t *mq2) JL_NOT
     return v;
 }
 
+// number of pointers a thief tries to take from a victim per steal attempt
+#define GC_PTR_STEAL_BATCH 16
+
+// Steal a batch of pointers from `mq2`: the first one is returned to be marked
+// right away and the rest are pushed onto our own queue `mq`
+STATIC_INLINE jl_value_t *gc_ptr_queue_steal_batch_from(jl_gc_markqueue_t *mq,
+                                                        jl_gc_markqueue_t *mq2) JL_NOTSAFEPOINT
+{
+    jl_value_t *v[GC_PTR_STEAL_BATCH];
+    int32_t n = ws_queue_steal_batch_from(&mq2->ptr_queue, v, sizeof(jl_value_t*), GC_PTR_STEAL_BATCH);
+    if (n == 0)
+        return NULL;
+    for (int32_t i = 1; i < n; i++)
+        gc_ptr_queue_push(mq, v[i]);
+    return v[0];
+}
+
 // Push chunk `*c` into chunk queue
 STATIC_INLINE void gc_chunkqueue_push(jl_gc_markqueue_t *mq, jl_gc_chunk_t *c) JL_NOTSAFEPOINT
 {
@@ -2364,6 +3019,10 @@ STATIC_INLINE void gc_mark_chunk(jl_ptls_t ptls, jl_gc_markqueue_t *mq, jl_gc_ch
             gc_mark_finlist_(mq, fl_parent, fl_begin, fl_end);
             break;
         }
+        case GC_remset_chunk: {
+            gc_mark_remset_(ptls, mq, c->begin, c->end);
+            break;
+        }
         default: {
             // `empty-chunk` should be checked by caller
             jl_safe_printf("GC internal error: chunk mismatch\n");
@@ -2460,6 +3119,12 @@ STATIC_INLINE void gc_mark_module_binding(jl_ptls_t ptls, jl_module_t *mb_parent
     gc_assert_parent_validity((jl_value_t *)mb_parent, bindingkeyset);
     gc_try_claim_and_push(mq, bindingkeyset, &nptr);
     gc_heap_snapshot_record_module_to_binding(mb_parent, bindings, bindingkeyset);
+    jl_value_t *usingindex = (jl_value_t *)jl_atomic_load_relaxed(&mb_parent->usingindex);
+    gc_try_claim_and_push(mq, usingindex, &nptr);
+    jl_value_t *usingnegcache = (jl_value_t *)jl_atomic_load_relaxed(&mb_parent->usingnegcache);
+    gc_try_claim_and_push(mq, usingnegcache, &nptr);
+    jl_value_t *usingnegkeyset = (jl_value_t *)jl_atomic_load_relaxed(&mb_parent->usingnegkeyset);
+    gc_try_claim_and_push(mq, usingnegkeyset, &nptr);
     gc_assert_parent_validity((jl_value_t *)mb_parent, (jl_value_t *)mb_parent->parent);
     gc_try_claim_and_push(mq, (jl_value_t *)mb_parent->parent, &nptr);
     size_t nusings = mb_parent->usings.len;
@@ -2589,7 +3254,7 @@ FORCE_INLINE void gc_mark_outrefs(jl_ptls_t ptls, jl_gc_markqueue_t *mq, void *_
                 else if (foreign_alloc)
                     objprofile_count(jl_module_type, bits == GC_OLD_MARKED, sizeof(jl_module_t));
                 jl_module_t *mb_parent = (jl_module_t *)new_obj;
-                uintptr_t nptr = ((mb_parent->usings.len + 1) << 2) | (bits & GC_OLD);
+                uintptr_t nptr = ((mb_parent->usings.len + 2) << 2) | (bits & GC_OLD);
                 gc_mark_module_binding(ptls, mb_parent, nptr, bits);
             }
             else if (vtag == jl_task_tag << 4) {
@@ -2604,9 +3269,28 @@ FORCE_INLINE void gc_mark_outrefs(jl_ptls_t ptls, jl_gc_markqueue_t *mq, void *_
                     gc_invoke_callbacks(jl_gc_cb_task_scanner_t, gc_cblist_task_scanner,
                                         (ta, tid != -1 && ta == gc_all_tls_states[tid]->root_task));
                 }
+                // Stack scan elision: a parked task that has not run since it
+                // was last scanned cannot have written new references onto
+                // its stack. One scan marks its referents, and a second one
+                // (after the sweep that promoted them) restores their
+                // old-generation mark bits, so from then on quick marks can
+                // skip the stack entirely. The mark after a full sweep must
+                // rescan, since the old generation's mark bits were just
+                // cleared, and age-based promotion (JULIA_GC_PROMOTE_AGE > 1)
+                // can keep referents young, which disables the elision too.
+                int scan_stack = 1;
+                if (ta->ptls == NULL && !mark_reset_age && !gc_verifying &&
+                        !gc_heap_snapshot_enabled && gc_promote_age == 1) {
+                    if (prev_sweep_full)
+                        ta->stack_dirty = 0; // this scan re-marks all referents
+                    else if (ta->stack_dirty == 0)
+                        scan_stack = 0;
+                    else
+                        ta->stack_dirty--;
+                }
         #ifdef COPY_STACKS
                 void *stkbuf = ta->stkbuf;
-                if (stkbuf && ta->copy_stack) {
+                if (scan_stack && stkbuf && ta->copy_stack) {
                     gc_setmark_buf_(ptls, stkbuf, bits, ta->bufsz);
                     // For gc_heap_snapshot_record:
                     // TODO: attribute size of stack
@@ -2629,13 +3313,13 @@ FORCE_INLINE void gc_mark_outrefs(jl_ptls_t ptls, jl_gc_markqueue_t *mq, void *_
                     offset = (uintptr_t)stkbuf - lb;
                 }
         #endif
-                if (s != NULL) {
+                if (scan_stack && s != NULL) {
                     nroots = gc_read_stack(&s->nroots, offset, lb, ub);
                     gc_heap_snapshot_record_task_to_frame_edge(ta, s);
                     assert(nroots <= UINT32_MAX);
                     gc_mark_stack(ptls, s, (uint32_t)nroots, offset, lb, ub);
                 }
-                if (ta->excstack) {
+                if (scan_stack && ta->excstack) {
                     jl_excstack_t *excstack = ta->excstack;
                     gc_heap_snapshot_record_task_to_frame_edge(ta, excstack);
                     size_t itr = ta->excstack->top;
@@ -2842,6 +3526,7 @@ void gc_mark_loop_serial_(jl_ptls_t ptls, jl_gc_markqueue_t *mq)
         if (__unlikely(new_obj == NULL)) {
             return;
         }
+        gc_ptr_queue_prefetch(&ptls->mark_queue);
         gc_mark_outrefs(ptls, mq, new_obj, 0);
     }
 }
@@ -2883,6 +3568,7 @@ void gc_mark_and_steal(jl_ptls_t ptls)
     pop : {
         new_obj = gc_ptr_queue_pop(mq);
         if (new_obj != NULL) {
+            gc_ptr_queue_prefetch(mq);
             goto mark;
         }
         c = gc_chunkqueue_pop(mq);
@@ -2928,24 +3614,24 @@ void gc_mark_and_steal(jl_ptls_t ptls)
                 goto pop;
             }
         }
-        // Try to steal pointer from random GC thread
+        // Try to steal pointers from random GC thread
         for (int i = 0; i < 4 * jl_n_markthreads; i++) {
             uint32_t v = gc_first_tid + cong(jl_n_markthreads, &ptls->rngseed);
             jl_gc_markqueue_t *mq2 = &gc_all_tls_states[v]->mark_queue;
-            new_obj = gc_ptr_queue_steal_from(mq2);
+            new_obj = gc_ptr_queue_steal_batch_from(mq, mq2);
             if (new_obj != NULL)
                 goto mark;
         }
-        // Sequentially walk GC threads to try to steal pointer
+        // Sequentially walk GC threads to try to steal pointers
         for (int i = gc_first_tid; i < gc_first_tid + jl_n_markthreads; i++) {
             jl_gc_markqueue_t *mq2 = &gc_all_tls_states[i]->mark_queue;
-            new_obj = gc_ptr_queue_steal_from(mq2);
+            new_obj = gc_ptr_queue_steal_batch_from(mq, mq2);
             if (new_obj != NULL)
                 goto mark;
         }
-        // Try to steal pointer from master thread
+        // Try to steal pointers from master thread
         if (mq_master != NULL) {
-            new_obj = gc_ptr_queue_steal_from(mq_master);
+            new_obj = gc_ptr_queue_steal_batch_from(mq, mq_master);
             if (new_obj != NULL)
                 goto mark;
         }
@@ -3059,7 +3745,9 @@ void gc_mark_loop_parallel(jl_ptls_t ptls, int master)
 
 void gc_mark_loop(jl_ptls_t ptls)
 {
-    if (jl_n_markthreads == 0 || gc_heap_snapshot_enabled) {
+    // heap-snapshot recording is thread-safe (see gc-heap-snapshot.cpp), so
+    // snapshot collections use the parallel mark threads like any other
+    if (jl_n_markthreads == 0) {
         gc_mark_loop_serial(ptls);
     }
     else {
@@ -3083,8 +3771,7 @@ void gc_mark_clean_reclaim_sets(void)
         arraylist_t *reclaim_set2 = &ptls2->mark_queue.reclaim_set;
         ws_array_t *a = NULL;
         while ((a = (ws_array_t *)arraylist_pop(reclaim_set2)) != NULL) {
-            free(a->buffer);
-            free(a);
+            free_ws_array_chain(a);
         }
     }
     // Reset queue indices
@@ -3097,6 +3784,10 @@ void gc_mark_clean_reclaim_sets(void)
         jl_atomic_store_relaxed(&ptls2->mark_queue.ptr_queue.top, 0);
         jl_atomic_store_relaxed(&ptls2->mark_queue.chunk_queue.bottom, 0);
         jl_atomic_store_relaxed(&ptls2->mark_queue.chunk_queue.top, 0);
+        // drop any older segments left behind by segmented queue growth, so
+        // the reset indices start over in a single segment
+        ws_queue_collapse(&ptls2->mark_queue.ptr_queue);
+        ws_queue_collapse(&ptls2->mark_queue.chunk_queue);
     }
 }
 
@@ -3116,6 +3807,15 @@ static void gc_premark(jl_ptls_t ptls2)
         objprofile_count(jl_typeof(item), 2, 0);
         jl_astaggedvalue(item)->bits.gc = GC_OLD_MARKED;
     }
+    // card-marked objects are handled like remset entries: they stay marked
+    // as long as one of their cards is dirty
+    len = ptls2->heap.memory_cards.len;
+    items = ptls2->heap.memory_cards.items;
+    for (size_t i = 0; i < len; i++) {
+        jl_gc_memory_cards_t *c = (jl_gc_memory_cards_t *)items[i];
+        objprofile_count(jl_typeof((jl_value_t*)c->owner), 2, 0);
+        jl_astaggedvalue(c->owner)->bits.gc = GC_OLD_MARKED;
+    }
 }
 
 static void gc_queue_thread_local(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
@@ -3141,10 +3841,43 @@ static void gc_queue_thread_local(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
         gc_try_claim_and_push(mq, task, NULL);
         gc_heap_snapshot_record_root((jl_value_t*)task, "previous task");
     }
+    task = ptls2->lifo_slot;
+    if (task != NULL) {
+        gc_try_claim_and_push(mq, task, NULL);
+        gc_heap_snapshot_record_root((jl_value_t*)task, "lifo slot task");
+    }
+    // dead task objects pooled for reuse by jl_new_task
+    small_arraylist_t *free_tasks = &ptls2->heap.free_tasks;
+    for (size_t i = 0; i < free_tasks->len; i++) {
+        task = (jl_task_t*)free_tasks->items[i];
+        gc_try_claim_and_push(mq, task, NULL);
+        gc_heap_snapshot_record_root((jl_value_t*)task, "pooled task");
+    }
     if (ptls2->previous_exception) {
         gc_try_claim_and_push(mq, ptls2->previous_exception, NULL);
         gc_heap_snapshot_record_root((jl_value_t*)ptls2->previous_exception, "previous exception");
     }
+    // thread-local dispatch cache
+    for (size_t i = 0; i < JL_DISPATCH_CACHE_SETS; i++) {
+        for (int j = 0; j < JL_DISPATCH_CACHE_WAYS; j++) {
+            if (ptls2->dispatch_cache[i][j] != NULL)
+                gc_try_claim_and_push(mq, ptls2->dispatch_cache[i][j], NULL);
+        }
+    }
+    // spare typemap level nodes pooled for reuse by jl_new_typemap_level
+    for (int i = 0; i < ptls2->typemap_level_pool_len; i++)
+        gc_try_claim_and_push(mq, ptls2->typemap_level_pool[i], NULL);
+    // memoized type-specificity verdicts, keyed by pointer identity
+    for (int i = 0; i < JL_MORESPEC_CACHE_SLOTS; i++) {
+        gc_try_claim_and_push(mq, ptls2->morespec_cache[i].a, NULL);
+        gc_try_claim_and_push(mq, ptls2->morespec_cache[i].b, NULL);
+    }
+    // cached debug info lookups (see jl_lookup_code_address)
+    for (int i = 0; i < JL_IP_LOOKUP_CACHE_SLOTS; i++) {
+        jl_ip_lookup_entry_t *entry = &ptls2->ip_lookup_cache[i];
+        for (int j = 0; j < entry->nframes; j++)
+            gc_try_claim_and_push(mq, entry->frames[j].linfo, NULL);
+    }
 }
 
 static void gc_queue_bt_buf(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
@@ -3161,21 +3894,129 @@ static void gc_queue_bt_buf(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
     }
 }
 
+// Scan the outgoing references of a batch of remset entries. The entries were
+// already marked by `gc_premark`, so they go straight to `gc_mark_outrefs`
+// with `meta_updated` set instead of through `gc_try_claim_and_push`.
+void gc_mark_remset_(jl_ptls_t ptls, jl_gc_markqueue_t *mq, jl_value_t **begin, jl_value_t **end)
+{
+    for (; begin < end; begin++)
+        gc_mark_outrefs(ptls, mq, *begin, 1);
+}
+
 static void gc_queue_remset(jl_ptls_t ptls, jl_ptls_t ptls2)
 {
     size_t len = ptls2->heap.last_remset->len;
-    void **items = ptls2->heap.last_remset->items;
+    jl_value_t **items = (jl_value_t **)ptls2->heap.last_remset->items;
+    // Queue the entries in batches instead of scanning them here, so that the
+    // parallel markers share the rescanning work; with many live tasks the
+    // remset is dominated by task stacks, which are expensive to scan
+    for (size_t i = 0; i < len; i += GC_REMSET_CHUNK_SIZE) {
+        size_t hi = len - i > GC_REMSET_CHUNK_SIZE ? i + GC_REMSET_CHUNK_SIZE : len;
+        jl_gc_chunk_t c = {GC_remset_chunk, NULL, items + i, items + hi, 0, 0, 0, 0};
+        gc_chunkqueue_push(&ptls->mark_queue, &c);
+    }
+}
+
+// Re-scan the dirty cards of card-marked old memory objects. A card stays
+// dirty as long as it still covers a young reference; an entry is dropped
+// once all of its cards are clean (i.e. every recorded child was promoted)
+static void gc_queue_memory_cards(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
+{
+    size_t len = ptls2->heap.memory_cards.len;
+    void **items = ptls2->heap.memory_cards.items;
+    size_t n = 0;
     for (size_t i = 0; i < len; i++) {
-        // Objects in the `remset` are already marked,
-        // so a `gc_try_claim_and_push` wouldn't work here
-        gc_mark_outrefs(ptls, &ptls->mark_queue, (jl_value_t *)items[i], 1);
+        jl_gc_memory_cards_t *c = (jl_gc_memory_cards_t *)items[i];
+        jl_genericmemory_t *m = c->owner;
+        char *data = (char*)m->ptr;
+        size_t nbytes = m->length * sizeof(void*);
+        int any_dirty = 0;
+        for (size_t j = 0; j < c->ncards; j++) {
+            if (!c->cards[j])
+                continue;
+            size_t hi = (j + 1) << GC_CARD_SHIFT;
+            if (hi > nbytes)
+                hi = nbytes;
+            jl_value_t **begin = (jl_value_t**)(data + (j << GC_CARD_SHIFT));
+            jl_value_t **end = (jl_value_t**)(data + hi);
+            int young = 0;
+            for (jl_value_t **slot = begin; slot < end; slot++) {
+                jl_value_t *v = *slot;
+                if (v == NULL)
+                    continue;
+                gc_try_claim_and_push(mq, v, NULL);
+                if (!(jl_astaggedvalue(v)->bits.gc & GC_OLD))
+                    young = 1;
+            }
+            c->cards[j] = young;
+            any_dirty |= young;
+        }
+        if (any_dirty) {
+            items[n++] = c;
+        }
+        else {
+            ptrhash_remove(&ptls2->heap.memory_card_table, (void*)m);
+            free(c);
+        }
     }
+    ptls2->heap.memory_cards.len = n;
+}
+
+static void gc_queue_satb_buffer(jl_gc_markqueue_t *mq, jl_ptls_t ptls2)
+{
+    size_t len = ptls2->heap.satb_buffer.len;
+    void **items = ptls2->heap.satb_buffer.items;
+    for (size_t i = 0; i < len; i++) {
+        // Unlike the remset, entries logged by the SATB barrier have not
+        // been marked yet, so claim them like any other root
+        gc_try_claim_and_push(mq, (jl_value_t *)items[i], NULL);
+    }
+    ptls2->heap.satb_buffer.len = 0;
+}
+
+// object pinning
+//
+// Pinned objects are part of the root set, so a buffer handed to an
+// asynchronous C library (io_uring, CUDA, ...) stays alive even when no
+// reference to it remains reachable from Julia. The collector never moves
+// objects, so keeping the object alive is all that is needed for its data
+// pointer to stay valid. The table maps the object to its pin count.
+static htable_t pinned_objects;
+static uv_mutex_t gc_pinned_lock;
+
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&gc_pinned_lock);
+    // the count is stored offset by one, since (void*)1 is HT_NOTFOUND
+    uintptr_t count = (uintptr_t)ptrhash_get(&pinned_objects, v);
+    if (count == (uintptr_t)HT_NOTFOUND)
+        count = 1;
+    ptrhash_put(&pinned_objects, v, (void*)(count + 1));
+    uv_mutex_unlock(&gc_pinned_lock);
+}
+
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&gc_pinned_lock);
+    uintptr_t count = (uintptr_t)ptrhash_get(&pinned_objects, v);
+    assert(count != (uintptr_t)HT_NOTFOUND && "object is not pinned");
+    if (count <= 2)
+        ptrhash_remove(&pinned_objects, v);
+    else
+        ptrhash_put(&pinned_objects, v, (void*)(count - 1));
+    uv_mutex_unlock(&gc_pinned_lock);
 }
 
 extern jl_value_t *cmpswap_names JL_GLOBALLY_ROOTED;
 extern jl_task_t *wait_empty JL_GLOBALLY_ROOTED;
 
 // mark the initial root set
+static void gc_mark_timeout_task(jl_task_t *t, void *mq)
+{
+    gc_try_claim_and_push((jl_gc_markqueue_t*)mq, t, NULL);
+    gc_heap_snapshot_record_gc_roots((jl_value_t*)t, "timeout wheel");
+}
+
 static void gc_mark_roots(jl_gc_markqueue_t *mq)
 {
     // modules
@@ -3186,6 +4027,10 @@ static void gc_mark_roots(jl_gc_markqueue_t *mq)
     gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_an_empty_vec_any, "an_empty_vec_any");
     gc_try_claim_and_push(mq, jl_module_init_order, NULL);
     gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_module_init_order, "module_init_order");
+    gc_try_claim_and_push(mq, jl_lowered_cache, NULL);
+    gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_lowered_cache, "lowered_cache");
+    gc_try_claim_and_push(mq, jl_macro_memo, NULL);
+    gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_macro_memo, "macro_memo");
     for (size_t i = 0; i < jl_current_modules.size; i += 2) {
         if (jl_current_modules.table[i + 1] != HT_NOTFOUND) {
             gc_try_claim_and_push(mq, jl_current_modules.table[i], NULL);
@@ -3199,6 +4044,40 @@ static void gc_mark_roots(jl_gc_markqueue_t *mq)
         gc_try_claim_and_push(mq, v, NULL);
         gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
     }
+    for (size_t i = 0; i < N_CALLSITE_CACHE; i++) {
+        for (int j = 0; j < 2; j++) {
+            jl_typemap_entry_t *v = jl_atomic_load_relaxed(&callsite_cache[i].ways[j]);
+            gc_try_claim_and_push(mq, v, NULL);
+            gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, 2 * i + j);
+        }
+    }
+    for (size_t i = 0; i < N_SUBTYPE_CACHE; i++) {
+        jl_svec_t *v = jl_atomic_load_relaxed(&subtype_cache[i]);
+        gc_try_claim_and_push(mq, v, NULL);
+        gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
+    }
+    for (size_t i = 0; i < N_INVOKE_CACHE; i++) {
+        jl_svec_t *v = jl_atomic_load_relaxed(&invoke_cache[i]);
+        gc_try_claim_and_push(mq, v, NULL);
+        gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
+    }
+    for (size_t i = 0; i < N_MISSING_METHOD_CACHE; i++) {
+        jl_svec_t *v = jl_atomic_load_relaxed(&missing_method_cache[i]);
+        gc_try_claim_and_push(mq, v, NULL);
+        gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
+    }
+    for (size_t i = 0; i < N_INTERSECT_CACHE; i++) {
+        jl_svec_t *v = jl_atomic_load_relaxed(&intersect_cache[i]);
+        gc_try_claim_and_push(mq, v, NULL);
+        gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
+    }
+    for (size_t i = 0; i < N_OC_SPEC_CACHE; i++) {
+        jl_svec_t *v = jl_atomic_load_relaxed(&oc_spec_cache[i]);
+        gc_try_claim_and_push(mq, v, NULL);
+        gc_heap_snapshot_record_array_edge_index((jl_value_t*)jl_anytuple_type_type, (jl_value_t*)v, i);
+    }
+    // tasks with a pending scheduler timeout (scheduler.c)
+    jl_timeout_foreach_task(gc_mark_timeout_task, (void*)mq);
     gc_try_claim_and_push(mq, jl_all_methods, NULL);
     gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_all_methods, "all_methods");
     gc_try_claim_and_push(mq, _jl_debug_method_invalidation, NULL);
@@ -3212,6 +4091,13 @@ static void gc_mark_roots(jl_gc_markqueue_t *mq)
     gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_global_roots_list, "global_roots_list");
     gc_try_claim_and_push(mq, jl_global_roots_keyset, NULL);
     gc_heap_snapshot_record_gc_roots((jl_value_t*)jl_global_roots_keyset, "global_roots_keyset");
+    // pinned objects (world is stopped, so the table cannot change under us)
+    for (size_t i = 0; i < pinned_objects.size; i += 2) {
+        if (pinned_objects.table[i + 1] != HT_NOTFOUND) {
+            gc_try_claim_and_push(mq, pinned_objects.table[i], NULL);
+            gc_heap_snapshot_record_gc_roots((jl_value_t*)pinned_objects.table[i], "pinned object");
+        }
+    }
 }
 
 // find unmarked objects that need to be finalized from the finalizer list "list".
@@ -3315,6 +4201,13 @@ JL_DLLEXPORT jl_gc_num_t jl_gc_num(void)
     return num;
 }
 
+JL_DLLEXPORT void jl_gc_get_last_collection_stats(jl_gc_collection_stats_t *stats)
+{
+    // copied without synchronization, like jl_gc_num; a collection finishing
+    // concurrently can tear the record, which is acceptable for telemetry
+    *stats = gc_last_collection_stats;
+}
+
 JL_DLLEXPORT void jl_gc_reset_stats(void)
 {
     gc_num.max_pause = 0;
@@ -3360,6 +4253,83 @@ JL_DLLEXPORT int64_t jl_gc_live_bytes(void)
     return live_bytes;
 }
 
+// Live fragmentation summary per size class (see julia.h). Walking the
+// per-thread allocated-page lists concurrently with the mutators is safe:
+// pages are pushed with a CAS and only unlinked by the sweep, which cannot
+// start while the calling thread sits in this safepoint-free walk. A page
+// pushed mid-walk may be missed and `nfree` is stale for pages a pool is
+// actively allocating from; both are fine for a drift signal. Pages parked
+// on the buffered/lazily-freed pools hold no objects and are not counted.
+JL_DLLEXPORT int jl_gc_pool_stats(jl_gc_pool_stats_t *stats, int len) JL_NOTSAFEPOINT
+{
+    int n = len < JL_GC_N_POOLS ? len : JL_GC_N_POOLS;
+    memset(stats, 0, n * sizeof(jl_gc_pool_stats_t));
+    for (int i = 0; i < n; i++)
+        stats[i].osize = jl_gc_sizeclasses[i];
+    int n_threads = jl_atomic_load_acquire(&jl_n_threads);
+    jl_ptls_t *all_tls_states = jl_atomic_load_relaxed(&jl_all_tls_states);
+    for (int t = 0; t < n_threads; t++) {
+        jl_ptls_t ptls2 = all_tls_states[t];
+        if (ptls2 == NULL)
+            continue;
+        jl_gc_pagemeta_t *pg = jl_atomic_load_relaxed(&ptls2->page_metadata_allocd.bottom);
+        while (pg != NULL) {
+            int p = pg->pool_n;
+            if (p < n) {
+                stats[p].npages++;
+                stats[p].nobjs += (GC_PAGE_SZ - GC_PAGE_OFFSET) / pg->osize;
+                stats[p].nfree += pg->nfree;
+                stats[p].nold += pg->nold;
+            }
+            pg = pg->next;
+        }
+    }
+    return JL_GC_N_POOLS;
+}
+
+// Continuous memory timeline (see julia.h): a fixed ring of snapshots of the
+// per-size-class cumulative allocation counters that the pool alloc fast path
+// maintains. Samples are recorded at the end of every collection and whenever
+// a caller asks for one explicitly.
+#define GC_TIMELINE_LEN 256
+static jl_gc_timeline_sample_t gc_timeline[GC_TIMELINE_LEN];
+static uint64_t gc_timeline_head; // samples taken so far; next slot is head % LEN
+static uv_mutex_t gc_timeline_lock;
+
+JL_DLLEXPORT void jl_gc_timeline_sample(void) JL_NOTSAFEPOINT
+{
+    static_assert(JL_GC_N_POOLS <= JL_GC_TIMELINE_NPOOLS,
+                  "jl_gc_timeline_sample_t cannot hold every size class");
+    jl_gc_timeline_sample_t s;
+    memset(&s, 0, sizeof(s));
+    s.t_ns = jl_hrtime();
+    s.live_bytes = live_bytes;
+    int n_threads = jl_atomic_load_acquire(&jl_n_threads);
+    jl_ptls_t *all_tls_states = jl_atomic_load_relaxed(&jl_all_tls_states);
+    for (int t = 0; t < n_threads; t++) {
+        jl_ptls_t ptls2 = all_tls_states[t];
+        if (ptls2 == NULL)
+            continue;
+        for (int p = 0; p < JL_GC_N_POOLS; p++)
+            s.pool_alloc_bytes[p] += ptls2->heap.norm_pools[p].alloc_bytes;
+    }
+    uv_mutex_lock(&gc_timeline_lock);
+    gc_timeline[gc_timeline_head % GC_TIMELINE_LEN] = s;
+    gc_timeline_head++;
+    uv_mutex_unlock(&gc_timeline_lock);
+}
+
+JL_DLLEXPORT int jl_gc_timeline_get(jl_gc_timeline_sample_t *samples, int len) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&gc_timeline_lock);
+    uint64_t have = gc_timeline_head < GC_TIMELINE_LEN ? gc_timeline_head : GC_TIMELINE_LEN;
+    int n = len < (int)have ? len : (int)have;
+    for (int i = 0; i < n; i++)
+        samples[i] = gc_timeline[(gc_timeline_head - 1 - i) % GC_TIMELINE_LEN];
+    uv_mutex_unlock(&gc_timeline_lock);
+    return n;
+}
+
 uint64_t jl_gc_smooth(uint64_t old_val, uint64_t new_val, double factor)
 {
     double est = factor * old_val + (1 - factor) * new_val;
@@ -3370,6 +4340,28 @@ uint64_t jl_gc_smooth(uint64_t old_val, uint64_t new_val, double factor)
     return est;
 }
 
+// pause-target pacing state (see `jl_gc_set_pause_target_ms`)
+static _Atomic(uint64_t) gc_pause_target_ns = 0;
+static uint64_t smoothed_quick_pause = 0;
+static uint64_t smoothed_full_pause = 0;
+// number of consecutive full sweeps deferred to stay under the pause target
+static int deferred_full_sweeps = 0;
+#define GC_MAX_DEFERRED_FULL_SWEEPS 8
+
+// Ask the collector to keep pauses below `ms` milliseconds. This is a best
+// effort target, not a guarantee: the pacer schedules collections earlier
+// (trading throughput) and defers full sweeps while the pause estimate for
+// them overshoots the target. `ms == 0` restores the default heuristics.
+JL_DLLEXPORT void jl_gc_set_pause_target_ms(uint64_t ms)
+{
+    jl_atomic_store_relaxed(&gc_pause_target_ns, ms * 1000000);
+}
+
+JL_DLLEXPORT uint64_t jl_gc_get_pause_target_ms(void)
+{
+    return jl_atomic_load_relaxed(&gc_pause_target_ns) / 1000000;
+}
+
 // an overallocation curve inspired by array allocations
 // grows very fast initially, then much slower at large heaps
 static uint64_t overallocation(uint64_t old_val, uint64_t val, uint64_t max_val)
@@ -3406,6 +4398,14 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
 
     jl_gc_markqueue_t *mq = &ptls->mark_queue;
 
+    // finish any pool sweeping deferred from the previous collection before
+    // we start overwriting mark bits (no-op unless JULIA_GC_LAZY_SWEEP)
+    gc_lazy_sweep_drain_all();
+
+    // register the consumed pages of the per-thread bump regions before the
+    // mark phase needs their metadata (no-op unless JULIA_GC_TLAB_MB)
+    gc_tlab_materialize_all();
+
     uint64_t gc_start_time = jl_hrtime();
     uint64_t mutator_time = gc_end_time == 0 ? old_mut_time : gc_start_time - gc_end_time;
     uint64_t before_free_heap_size = jl_atomic_load_relaxed(&gc_heap_stats.heap_size);
@@ -3424,7 +4424,7 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
         }
 
         assert(gc_n_threads);
-        int single_threaded_mark = (jl_n_markthreads == 0 || gc_heap_snapshot_enabled);
+        int single_threaded_mark = (jl_n_markthreads == 0);
         for (int t_i = 0; t_i < gc_n_threads; t_i++) {
             jl_ptls_t ptls2 = gc_all_tls_states[t_i];
             jl_ptls_t ptls_dest = ptls;
@@ -3441,6 +4441,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
                 gc_queue_bt_buf(mq_dest, ptls2);
                 // 2.3. mark every object in the `last_remsets` and `rem_binding`
                 gc_queue_remset(ptls_dest, ptls2);
+                // 2.4. mark every reference logged by the SATB barrier
+                //      (empty unless a concurrent mark window was open)
+                gc_queue_satb_buffer(mq_dest, ptls2);
+                // 2.5. re-scan the dirty cards of card-marked memory objects
+                gc_queue_memory_cards(mq_dest, ptls2);
             }
         }
 
@@ -3512,6 +4517,7 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     objprofile_printall();
     objprofile_reset();
     gc_num.total_allocd += gc_num.allocd;
+    int64_t promoted_this_gc = prev_sweep_full ? 0 : perm_scanned_bytes - last_perm_scanned_bytes;
     if (!prev_sweep_full)
         promoted_bytes += perm_scanned_bytes - last_perm_scanned_bytes;
     // 5. next collection decision
@@ -3545,6 +4551,7 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     }
     scanned_bytes = 0;
     // 6. start sweeping
+    jl_atomic_store_relaxed(&gc_pages_swept_this_gc, 0);
     uint64_t start_sweep_time = jl_hrtime();
     JL_PROBE_GC_SWEEP_BEGIN(sweep_full);
     {
@@ -3573,6 +4580,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     gc_end_time = jl_hrtime();
     uint64_t pause = gc_end_time - gc_start_time;
     uint64_t sweep_time = gc_end_time - start_sweep_time;
+    // smoothed pause estimates per collection kind, for pause-target pacing
+    if (sweep_full)
+        smoothed_full_pause = jl_gc_smooth(smoothed_full_pause, pause, 0.5);
+    else
+        smoothed_quick_pause = jl_gc_smooth(smoothed_quick_pause, pause, 0.5);
     gc_num.total_sweep_time += sweep_time;
     gc_num.sweep_time = sweep_time;
     if (sweep_full) {
@@ -3588,6 +4600,20 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     uint64_t user_max = max_total_memory * 0.8;
     uint64_t alloc_diff = before_free_heap_size - old_heap_size;
     uint64_t freed_diff = before_free_heap_size - heap_size;
+    // record the per-phase breakdown of this collection for
+    // jl_gc_get_last_collection_stats; finalizers_ns is filled in by
+    // jl_gc_collect once the world has restarted and finalizers have run
+    gc_last_collection_stats.collect_count += 1;
+    gc_last_collection_stats.full = sweep_full;
+    gc_last_collection_stats.total_ns = pause;
+    gc_last_collection_stats.mark_ns = mark_time;
+    gc_last_collection_stats.sweep_ns = sweep_time;
+    gc_last_collection_stats.finalizers_ns = 0;
+    gc_last_collection_stats.time_to_safepoint_ns = gc_num.time_to_safepoint;
+    gc_last_collection_stats.bytes_promoted = promoted_this_gc < 0 ? 0 : promoted_this_gc;
+    gc_last_collection_stats.bytes_freed = freed_diff;
+    gc_last_collection_stats.pages_swept = jl_atomic_load_relaxed(&gc_pages_swept_this_gc);
+    jl_gc_timeline_sample(); // one timeline sample per collection, world still stopped
     uint64_t target_heap;
     const char *reason = ""; (void)reason; // for GC_TIME output stats
     old_heap_size = heap_size; // TODO: Update these values dynamically instead of just during the GC
@@ -3660,6 +4686,21 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
             target_allocs = min_target_allocs;
             reason = " min limit";
         }
+        // pause-target pacing: when the user asked for bounded pauses via
+        // `jl_gc_set_pause_target_ms`, scale the allocation budget down in
+        // proportion to how far the observed pauses overshoot the target,
+        // so collections come earlier and each one has less to scan
+        uint64_t pause_target = jl_atomic_load_relaxed(&gc_pause_target_ns);
+        if (pause_target != 0 && smoothed_quick_pause > pause_target) {
+            uint64_t paced = (uint64_t)(target_allocs *
+                ((double)pause_target / (double)smoothed_quick_pause));
+            if (paced < min_target_allocs)
+                paced = min_target_allocs;
+            if (paced < target_allocs) {
+                target_allocs = paced;
+                reason = " pause target";
+            }
+        }
         // and set the heap detection threshold
         target_heap = target_allocs + heap_size;
         if (target_heap < default_collect_interval) {
@@ -3677,6 +4718,23 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
         next_sweep_full = 1;
     else
         next_sweep_full = 0;
+    // defer full sweeps that would overshoot the pause target, unless the
+    // heap is above the user limit and we have to take the long pause
+    // anyway; bounded so the old generation cannot grow without limit
+    if (next_sweep_full && heap_size <= user_max) {
+        uint64_t pause_target = jl_atomic_load_relaxed(&gc_pause_target_ns);
+        if (pause_target != 0 && smoothed_full_pause > pause_target &&
+            deferred_full_sweeps < GC_MAX_DEFERRED_FULL_SWEEPS) {
+            next_sweep_full = 0;
+            deferred_full_sweeps++;
+        }
+        else {
+            deferred_full_sweeps = 0;
+        }
+    }
+    else if (next_sweep_full) {
+        deferred_full_sweeps = 0;
+    }
     if (heap_size > user_max || thrashing)
         under_pressure = 1;
     // sweeping is over
@@ -3833,7 +4891,9 @@ JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t collection)
     // or wait for finalizers on other threads without dead lock).
     if (!ptls->finalizers_inhibited && ptls->locks.len == 0) {
         JL_TIMING(GC, GC_Finalizers);
+        uint64_t fin_start_time = jl_hrtime();
         run_finalizers(ct, 0);
+        gc_last_collection_stats.finalizers_ns = jl_hrtime() - fin_start_time;
     }
     JL_PROBE_GC_FINALIZER();
 
@@ -3876,18 +4936,27 @@ void jl_init_thread_heap(jl_ptls_t ptls)
         p[i].osize = jl_gc_sizeclasses[i];
         p[i].freelist = NULL;
         p[i].newpages = NULL;
+        p[i].tlab_pos = NULL;
+        p[i].tlab_end = NULL;
+        p[i].tlab_base = NULL;
+        p[i].tlab_meta = NULL;
     }
     small_arraylist_new(&heap->weak_refs, 0);
     small_arraylist_new(&heap->live_tasks, 0);
     for (int i = 0; i < JL_N_STACK_POOLS; i++)
         small_arraylist_new(&heap->free_stacks[i], 0);
+    small_arraylist_new(&heap->free_tasks, 0);
     heap->mallocarrays = NULL;
     heap->mafreelist = NULL;
     heap->big_objects = NULL;
+    heap->current_arena = NULL;
     heap->remset = &heap->_remset[0];
     heap->last_remset = &heap->_remset[1];
     arraylist_new(heap->remset, 0);
     arraylist_new(heap->last_remset, 0);
+    arraylist_new(&heap->satb_buffer, 0);
+    arraylist_new(&heap->memory_cards, 0);
+    htable_new(&heap->memory_card_table, 0);
     arraylist_new(&ptls->finalizers, 0);
     arraylist_new(&ptls->sweep_objs, 0);
 
@@ -3920,16 +4989,46 @@ void jl_gc_init(void)
     JL_MUTEX_INIT(&heapsnapshot_lock, "heapsnapshot_lock");
     JL_MUTEX_INIT(&finalizers_lock, "finalizers_lock");
     uv_mutex_init(&page_profile_lock);
+    uv_mutex_init(&gc_timeline_lock);
     uv_mutex_init(&gc_cache_lock);
     uv_mutex_init(&gc_perm_lock);
     uv_mutex_init(&gc_threads_lock);
     uv_cond_init(&gc_threads_cond);
     uv_sem_init(&gc_sweep_assists_needed, 0);
     uv_mutex_init(&gc_queue_observer_lock);
+    uv_mutex_init(&gc_pinned_lock);
+    htable_new(&pinned_objects, 0);
 
     jl_gc_init_page();
     jl_gc_debug_init();
 
+    char *cm = getenv("JULIA_GC_CONCURRENT_MARK");
+    if (cm && strcmp(cm, "0") != 0)
+        gc_concurrent_mark_enabled = 1;
+
+    char *ls = getenv("JULIA_GC_LAZY_SWEEP");
+    if (ls && strcmp(ls, "0") != 0)
+        gc_lazy_sweep_enabled = 1;
+
+    char *tlab = getenv("JULIA_GC_TLAB_MB");
+    if (tlab) {
+        int mb = atoi(tlab);
+        if (mb > 1024)
+            mb = 1024;
+        if (mb > 0)
+            gc_tlab_pages = mb * (1024 * 1024 / GC_PAGE_SZ);
+    }
+
+    char *pa = getenv("JULIA_GC_PROMOTE_AGE");
+    if (pa) {
+        int age = atoi(pa);
+        if (age < 1)
+            age = 1;
+        else if (age > 7)
+            age = 7;
+        gc_promote_age = age;
+    }
+
     arraylist_new(&finalizer_list_marked, 0);
     arraylist_new(&to_finalize, 0);
     jl_atomic_store_relaxed(&gc_heap_stats.heap_target, default_collect_interval);
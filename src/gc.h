@@ -99,6 +99,7 @@ typedef enum {
     GC_ary8_chunk,      // for chunk of array with 8 bit field descriptors
     GC_ary16_chunk,     // for chunk of array with 16 bit field descriptors
     GC_finlist_chunk,   // for chunk of finalizer list
+    GC_remset_chunk,    // for chunk of already-marked remset entries
 } gc_chunk_id_t;
 
 typedef struct _jl_gc_chunk_t {
@@ -115,6 +116,9 @@ typedef struct _jl_gc_chunk_t {
 #define GC_CHUNK_BATCH_SIZE (1 << 16)       // maximum number of references that can be processed
                                             // without creating a chunk
 
+#define GC_REMSET_CHUNK_SIZE (1 << 8)       // remset entries per work item; kept small because each
+                                            // entry can hide a lot of work (e.g. a task's stack)
+
 #define GC_PTR_QUEUE_INIT_SIZE (1 << 18)    // initial size of queue of `jl_value_t *`
 #define GC_CHUNK_QUEUE_INIT_SIZE (1 << 14)  // initial size of chunk-queue
 
@@ -141,6 +145,19 @@ JL_EXTENSION typedef struct _bigval_t {
     // must be 64-byte aligned here, in 32 & 64 bit modes
 } bigval_t;
 
+// 512-byte cards over the element data of old GenericMemory objects. The
+// slot-aware write barrier dirties the card covering the stored slot, so
+// quick collections re-scan only dirty cards instead of the whole object.
+
+#define GC_CARD_SHIFT 9
+#define GC_CARD_SZ (1 << GC_CARD_SHIFT)
+
+typedef struct {
+    jl_genericmemory_t *owner;
+    size_t ncards;
+    uint8_t cards[]; // one byte per GC_CARD_SZ bytes of element data
+} jl_gc_memory_cards_t;
+
 // data structure for tracking malloc'd arrays and genericmemory.
 
 typedef struct _mallocarray_t {
@@ -183,12 +200,24 @@ typedef struct _jl_gc_pagemeta_t {
     uint16_t fl_begin_offset; // offset of first free object in this page
     uint16_t fl_end_offset;   // offset of last free object in this page
     uint16_t thread_n;        // thread id of the heap that owns this page
+    // NUMA shard this page's memory belongs to, recorded when the page is
+    // handed to a thread (which is also the thread that first touches it)
+    uint8_t numa_shard;
     char *data;
+    // per-cell survival counts, allocated lazily on first sweep and only when
+    // the tenuring threshold is above one (see JULIA_GC_PROMOTE_AGE)
+    uint8_t *ages;
 } jl_gc_pagemeta_t;
 
-extern jl_gc_page_stack_t global_page_pool_lazily_freed;
+// The lazily freed pool is sharded by NUMA node: pages in it are still
+// resident, so handing them back to a thread on the same node avoids
+// remote-memory latency on every later pool allocation. Freed and clean
+// pages take their placement from first touch and need no sharding.
+#define JL_GC_N_NUMA_SHARDS 8
+extern jl_gc_page_stack_t global_page_pool_lazily_freed[JL_GC_N_NUMA_SHARDS];
 extern jl_gc_page_stack_t global_page_pool_clean;
 extern jl_gc_page_stack_t global_page_pool_freed;
+int jl_gc_current_numa_shard(void) JL_NOTSAFEPOINT;
 
 // Lock-free stack implementation taken
 // from Herlihy's "The Art of Multiprocessor Programming"
@@ -467,23 +496,39 @@ extern uv_cond_t gc_threads_cond;
 extern uv_sem_t gc_sweep_assists_needed;
 extern _Atomic(int) gc_n_threads_marking;
 extern _Atomic(int) gc_n_threads_sweeping;
+extern _Atomic(int) gc_satb_active;
+extern int gc_concurrent_mark_enabled;
+JL_DLLEXPORT void jl_gc_queue_satb_root(const jl_value_t *ptr);
 void gc_mark_queue_all_roots(jl_ptls_t ptls, jl_gc_markqueue_t *mq);
 void gc_mark_finlist_(jl_gc_markqueue_t *mq, jl_value_t *fl_parent, jl_value_t **fl_begin, jl_value_t **fl_end) JL_NOTSAFEPOINT;
+void gc_mark_remset_(jl_ptls_t ptls, jl_gc_markqueue_t *mq, jl_value_t **begin, jl_value_t **end) JL_NOTSAFEPOINT;
 void gc_mark_finlist(jl_gc_markqueue_t *mq, arraylist_t *list, size_t start) JL_NOTSAFEPOINT;
 void gc_mark_loop_serial_(jl_ptls_t ptls, jl_gc_markqueue_t *mq);
 void gc_mark_loop_serial(jl_ptls_t ptls);
 void gc_mark_loop_parallel(jl_ptls_t ptls, int master);
 void gc_sweep_pool_parallel(void);
+void gc_sweep_big_parallel(void);
 void gc_free_pages(void);
+// free the stacks and Memory buffers unlinked inside the pause; run by the
+// concurrent sweep thread (scheduler.c) when jl_n_sweepthreads > 0
+void gc_free_deferred_stacks(void);
+void gc_free_deferred_memory(void);
 void sweep_stack_pools(void);
+void gc_claim_dead_task(jl_task_t *t) JL_NOTSAFEPOINT;
 void jl_gc_debug_init(void);
 
 // GC pages
 
 void jl_gc_init_page(void) JL_NOTSAFEPOINT;
 NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT;
+// map `pg_cnt` contiguous pages with contiguous metadata for use as a
+// thread-local bump region; returns NULL when the mapping fails
+NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page_run(int pg_cnt) JL_NOTSAFEPOINT;
 void jl_gc_free_page(jl_gc_pagemeta_t *p) JL_NOTSAFEPOINT;
 
+// number of pages per thread-local bump region (JULIA_GC_TLAB_MB), 0 when disabled
+extern int gc_tlab_pages;
+
 // GC debug
 
 #if defined(GC_TIME) || defined(GC_FINAL_STATS)
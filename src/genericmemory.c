@@ -285,34 +285,13 @@ JL_DLLEXPORT void jl_genericmemory_copyto(jl_genericmemory_t *dest, char* destda
         _Atomic(void*) * dest_p = (_Atomic(void*)*)destdata;
         _Atomic(void*) * src_p = (_Atomic(void*)*)srcdata;
         jl_value_t *owner = jl_genericmemory_owner(dest);
-        if (__unlikely(jl_astaggedvalue(owner)->bits.gc == GC_OLD_MARKED)) {
+        if (__unlikely(n > 0 && jl_astaggedvalue(owner)->bits.gc == GC_OLD_MARKED)) {
             jl_value_t *src_owner = jl_genericmemory_owner(src);
-            ssize_t done = 0;
             if (jl_astaggedvalue(src_owner)->bits.gc != GC_OLD_MARKED) {
-                if (dest_p < src_p || dest_p > src_p + n) {
-                    for (; done < n; done++) { // copy forwards
-                        void *val = jl_atomic_load_relaxed(src_p + done);
-                        jl_atomic_store_release(dest_p + done, val);
-                        // `val` is young or old-unmarked
-                        if (val && !(jl_astaggedvalue(val)->bits.gc & GC_MARKED)) {
-                            jl_gc_queue_root(owner);
-                            break;
-                        }
-                    }
-                    src_p += done;
-                    dest_p += done;
-                } else {
-                    for (; done < n; done++) { // copy backwards
-                        void *val = jl_atomic_load_relaxed(src_p + n - done - 1);
-                        jl_atomic_store_release(dest_p + n - done - 1, val);
-                        // `val` is young or old-unmarked
-                        if (val && !(jl_astaggedvalue(val)->bits.gc & GC_MARKED)) {
-                            jl_gc_queue_root(owner);
-                            break;
-                        }
-                    }
-                }
-                n -= done;
+                // The source may hold young references. Rather than inspecting
+                // the tag of every copied value, dirty the destination range
+                // once and let the next quick collection re-scan it.
+                jl_gc_queue_memoryset_range(owner, (void*)dest_p, n * sizeof(void*));
             }
         }
         return memmove_refs(dest_p, src_p, n);
@@ -408,7 +387,11 @@ JL_DLLEXPORT void jl_genericmemoryset(jl_genericmemory_t *m JL_ROOTING_ARGUMENT,
     const jl_datatype_layout_t *layout = ((jl_datatype_t*)jl_typetagof(m))->layout;
     if (layout->flags.arrayelem_isboxed) {
         jl_atomic_store_release(((_Atomic(jl_value_t*)*)m->ptr) + i, rhs);
-        jl_gc_wb(jl_genericmemory_owner(m), rhs);
+        jl_value_t *owner = jl_genericmemory_owner(m);
+        if (owner == (jl_value_t*)m)
+            jl_gc_wb_memoryset(owner, (jl_value_t**)m->ptr + i, rhs);
+        else
+            jl_gc_wb(owner, rhs);
     }
     else {
         int hasptr;
@@ -569,7 +552,11 @@ JL_DLLEXPORT void jl_memoryrefset(jl_genericmemoryref_t m JL_ROOTING_ARGUMENT, j
     if (layout->flags.arrayelem_isboxed) {
         assert((char*)m.ptr_or_offset - (char*)m.mem->ptr < sizeof(jl_value_t*) * m.mem->length);
         jl_atomic_store_release((_Atomic(jl_value_t*)*)m.ptr_or_offset, rhs);
-        jl_gc_wb(jl_genericmemory_owner(m.mem), rhs);
+        jl_value_t *owner = jl_genericmemory_owner(m.mem);
+        if (owner == (jl_value_t*)m.mem)
+            jl_gc_wb_memoryset(owner, m.ptr_or_offset, rhs);
+        else
+            jl_gc_wb(owner, rhs);
     }
     else {
         int hasptr;
@@ -142,11 +142,20 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
     jl_genericmemory_t *speckeyset = NULL;
     jl_value_t *specializations = NULL;
     size_t i = -1, cl = 0, lastcl;
+    jl_method_instance_t *newmi = mi_insert;
+    JL_GC_PUSH1(&newmi);
     for (int locked = 0; locked < 2; locked++) {
         if (locked) {
-            if (!sparams) // can't insert without knowing this
+            if (!sparams) { // can't insert without knowing this
+                JL_GC_POP();
                 return NULL;
-            JL_LOCK(&m->writelock);
+            }
+            // construct the new instance before acquiring the lock: if another
+            // thread wins the race below the extra object is simply discarded,
+            // and only the rescan and insertion need to serialize
+            if (newmi == NULL)
+                newmi = jl_get_specialized(m, type, sparams);
+            JL_LOCK(&m->speclock);
         }
         lastcl = cl;
         speckeyset = jl_atomic_load_acquire(&m->speckeyset);
@@ -157,7 +166,8 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
             jl_method_instance_t *mi = (jl_method_instance_t*)specializations;
             if (jl_types_equal(mi->specTypes, type)) {
                 if (locked)
-                    JL_UNLOCK(&m->writelock);
+                    JL_UNLOCK(&m->speclock);
+                JL_GC_POP();
                 return mi;
             }
             continue;
@@ -168,7 +178,8 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
             if (idx != -1) {
                 jl_method_instance_t *mi = (jl_method_instance_t*)jl_svecref(specializations, idx);
                 if (locked)
-                    JL_UNLOCK(&m->writelock);
+                    JL_UNLOCK(&m->speclock);
+                JL_GC_POP();
                 return mi;
             }
         }
@@ -182,7 +193,8 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
                     break;
                 if (jl_types_equal(mi->specTypes, type)) {
                     if (locked)
-                        JL_UNLOCK(&m->writelock);
+                        JL_UNLOCK(&m->speclock);
+                    JL_GC_POP();
                     JL_GC_POP();
                     return mi;
                 }
@@ -191,13 +203,12 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
             JL_GC_POP();
         }
     }
-    jl_method_instance_t *mi = mi_insert ? mi_insert : jl_get_specialized(m, type, sparams);
+    jl_method_instance_t *mi = newmi;
     if (specializations == (jl_value_t*)jl_emptysvec) {
         jl_atomic_store_release(&m->specializations, (jl_value_t*)mi);
         jl_gc_wb(m, mi);
     }
     else {
-        JL_GC_PUSH1(&mi);
         if (!jl_is_svec(specializations)) {
             jl_method_instance_t *mi = (jl_method_instance_t*)specializations;
             jl_value_t *type = mi->specTypes;
@@ -243,9 +254,9 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
         jl_svecset(specializations, i, mi);
         if (hv)
             jl_smallintset_insert(&m->speckeyset, (jl_value_t*)m, speccache_hash, i, specializations);
-        JL_GC_POP();
     }
-    JL_UNLOCK(&m->writelock); // may gc
+    JL_UNLOCK(&m->speclock); // may gc
+    JL_GC_POP();
     return mi;
 }
 
@@ -1457,9 +1468,32 @@ static jl_method_instance_t *jl_mt_assoc_by_type(jl_methtable_t *mt JL_PROPAGATE
     JL_TIMING(METHOD_LOOKUP_SLOW, METHOD_LOOKUP_SLOW);
     jl_method_match_t *matc = NULL;
     JL_GC_PUSH2(&tt, &matc);
-    JL_LOCK(&mt->writelock);
     assert(tt->isdispatchtuple || tt->hasfreetypevars);
     jl_method_instance_t *mi = NULL;
+    {
+        // the dispatch cache supports lock-free reads, so check it before
+        // committing to the expensive part of this path
+        struct jl_typemap_assoc search = {(jl_value_t*)tt, world, NULL, 0, ~(size_t)0};
+        jl_typemap_entry_t *entry = jl_typemap_assoc_by_type(jl_atomic_load_relaxed(&mt->cache), &search, jl_cachearg_offset(mt), /*subtype*/1);
+        if (entry) {
+            JL_GC_POP();
+            return entry->func.linfo;
+        }
+    }
+
+    // The match search dominates this path and only reads lock-free
+    // structures, so run it optimistically before taking the lock: threads
+    // populating the cache of a popular function for different signatures
+    // then do their subtyping concurrently and only serialize for the brief
+    // insertion. The result is stale only if a method definition (which
+    // always advances the world counter) landed in between, in which case
+    // the search is redone under the lock, as the whole path used to be.
+    size_t min_valid = 0;
+    size_t max_valid = ~(size_t)0;
+    size_t prematch_world = jl_atomic_load_acquire(&jl_world_counter);
+    matc = _gf_invoke_lookup((jl_value_t*)tt, jl_nothing, world, &min_valid, &max_valid);
+
+    JL_LOCK(&mt->writelock);
     if (tt->isdispatchtuple) {
         jl_genericmemory_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
         jl_typemap_entry_t *entry = lookup_leafcache(leafcache, (jl_value_t*)tt, world);
@@ -1475,9 +1509,11 @@ static jl_method_instance_t *jl_mt_assoc_by_type(jl_methtable_t *mt JL_PROPAGATE
     }
 
     if (!mi) {
-        size_t min_valid = 0;
-        size_t max_valid = ~(size_t)0;
-        matc = _gf_invoke_lookup((jl_value_t*)tt, jl_nothing, world, &min_valid, &max_valid);
+        if (jl_atomic_load_acquire(&jl_world_counter) != prematch_world) {
+            min_valid = 0;
+            max_valid = ~(size_t)0;
+            matc = _gf_invoke_lookup((jl_value_t*)tt, jl_nothing, world, &min_valid, &max_valid);
+        }
         if (matc) {
             jl_method_t *m = matc->method;
             jl_svec_t *env = matc->sparams;
@@ -2205,6 +2241,34 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
     JL_GC_POP();
 }
 
+// Insert a whole batch of methods (possibly spanning several method tables)
+// under a single world increment. Each insertion still runs its own backedge
+// analysis, but every invalidated edge is truncated at the same world
+// boundary, so loading a module's worth of definitions costs one world age
+// instead of one per method. Methods within one batch must have distinct
+// signatures: replacement is detected against the world before the bump,
+// where entries created by earlier batch members are not yet visible.
+JL_DLLEXPORT void jl_method_table_batch_insert(jl_array_t *methods)
+{
+    size_t i, l = jl_array_nrows(methods);
+    size_t world = 0;
+    for (i = 0; i < l; i++) {
+        jl_method_t *method = (jl_method_t*)jl_array_ptr_ref(methods, i);
+        assert(jl_is_method(method));
+        if (method->primary_world == 1) {
+            if (world == 0)
+                world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
+            method->primary_world = world;
+        }
+    }
+    for (i = 0; i < l; i++) {
+        jl_method_t *method = (jl_method_t*)jl_array_ptr_ref(methods, i);
+        jl_methtable_t *mt = jl_method_get_table(method);
+        assert((jl_value_t*)mt != jl_nothing);
+        jl_method_table_insert(mt, method, NULL);
+    }
+}
+
 static void JL_NORETURN jl_method_error_bare(jl_function_t *f, jl_value_t *args, size_t world)
 {
     if (jl_methoderror_type) {
@@ -2345,10 +2409,17 @@ jl_code_instance_t *jl_method_compiled(jl_method_instance_t *mi, size_t world)
 
 jl_mutex_t precomp_statement_out_lock;
 
+static ios_t f_precompile;
+static JL_STREAM *s_precompile = NULL;
+// statements already emitted, keyed by specTypes identity (specializations
+// are unique'd, so the pointer identifies the printed signature)
+static htable_t precomp_statement_set;
+// the emitted statement text, kept so the file can be rewritten in
+// dependency order on exit (see jl_write_trace_compile_sorted)
+static arraylist_t precomp_statement_list;
+
 static void record_precompile_statement(jl_method_instance_t *mi)
 {
-    static ios_t f_precompile;
-    static JL_STREAM* s_precompile = NULL;
     jl_method_t *def = mi->def.method;
     if (jl_options.trace_compile == NULL)
         return;
@@ -2366,19 +2437,148 @@ static void record_precompile_statement(jl_method_instance_t *mi)
                 jl_errorf("cannot open precompile statement file \"%s\" for writing", t);
             s_precompile = (JL_STREAM*) &f_precompile;
         }
+        htable_new(&precomp_statement_set, 0);
+        arraylist_new(&precomp_statement_list, 0);
     }
-    if (!jl_has_free_typevars(mi->specTypes)) {
-        jl_printf(s_precompile, "precompile(");
-        jl_static_show(s_precompile, mi->specTypes);
-        jl_printf(s_precompile, ")\n");
+    if (!jl_has_free_typevars(mi->specTypes) &&
+        ptrhash_get(&precomp_statement_set, mi->specTypes) == HT_NOTFOUND) {
+        ptrhash_put(&precomp_statement_set, mi->specTypes, (void*)mi->specTypes);
+        ios_t sig;
+        ios_mem(&sig, 0);
+        jl_printf((JL_STREAM*)&sig, "precompile(");
+        jl_static_show((JL_STREAM*)&sig, mi->specTypes);
+        jl_printf((JL_STREAM*)&sig, ")");
+        char *stmt = (char*)malloc_s(sig.size + 1);
+        memcpy(stmt, sig.buf, sig.size);
+        stmt[sig.size] = '\0';
+        ios_close(&sig);
+        arraylist_push(&precomp_statement_list, stmt);
+        jl_printf(s_precompile, "%s\n", stmt);
         if (s_precompile != JL_STDERR)
             ios_flush(&f_precompile);
     }
     JL_UNLOCK(&precomp_statement_out_lock);
 }
 
+static int precomp_statement_depth(const char *s) JL_NOTSAFEPOINT
+{
+    int depth = 0, maxdepth = 0;
+    for (; *s; s++) {
+        if (*s == '{' || *s == '(') {
+            if (++depth > maxdepth)
+                maxdepth = depth;
+        }
+        else if (*s == '}' || *s == ')') {
+            depth--;
+        }
+    }
+    return maxdepth;
+}
+
+static int precomp_statement_cmp(const void *ap, const void *bp) JL_NOTSAFEPOINT
+{
+    const char *a = *(const char *const *)ap;
+    const char *b = *(const char *const *)bp;
+    int da = precomp_statement_depth(a);
+    int db = precomp_statement_depth(b);
+    if (da != db)
+        return da < db ? -1 : 1;
+    return strcmp(a, b);
+}
+
+// Rewrite the --trace-compile file with its statements ordered
+// dependency-first: shallowly nested signatures are emitted before the
+// deeper ones that embed them, so replaying the file instantiates most
+// component types before their first use inside a larger signature.
+// Statements were already deduplicated at emission; streaming output is
+// left unsorted so the trace stays observable while the process runs.
+void jl_write_trace_compile_sorted(void)
+{
+    if (jl_options.trace_compile == NULL)
+        return;
+    JL_LOCK(&precomp_statement_out_lock);
+    if (s_precompile != NULL && s_precompile != JL_STDERR && precomp_statement_list.len > 0) {
+        qsort(precomp_statement_list.items, precomp_statement_list.len,
+              sizeof(char*), precomp_statement_cmp);
+        ios_close(&f_precompile);
+        if (ios_file(&f_precompile, jl_options.trace_compile, 1, 1, 1, 1) != NULL) {
+            for (size_t i = 0; i < precomp_statement_list.len; i++)
+                jl_printf((JL_STREAM*)&f_precompile, "%s\n", (char*)precomp_statement_list.items[i]);
+            ios_flush(&f_precompile);
+        }
+        else {
+            s_precompile = NULL; // lost the stream; leave the streamed file as-is
+        }
+    }
+    JL_UNLOCK(&precomp_statement_out_lock);
+}
+
 jl_method_instance_t *jl_normalize_to_compilable_mi(jl_method_instance_t *mi JL_PROPAGATES_ROOT);
 
+// Promote a tier-0 (interpreted) code instance that has become hot: compile
+// its method instance and graft the native entry points onto the interpreted
+// codeinst, so references that cached it start using the compiled code. This
+// runs on the background compiler thread (see jitlayers.cpp), so the thread
+// that detected the hot call keeps interpreting while the compile is pending.
+void jl_tier0_promote(jl_code_instance_t *codeinst)
+{
+    if (jl_atomic_load_relaxed(&codeinst->invoke) != jl_fptr_interpret_call)
+        return; // already promoted by an earlier queue entry
+    jl_method_instance_t *mi = codeinst->def;
+    size_t world = jl_current_task->world_age;
+    jl_code_instance_t *codeinst2 = jl_generate_fptr(mi, world);
+    if (codeinst2 == NULL || codeinst2 == codeinst)
+        return;
+    uint8_t specsigflags = jl_atomic_load_acquire(&codeinst2->specsigflags);
+    jl_callptr_t invoke = jl_atomic_load_acquire(&codeinst2->invoke);
+    void *fptr = jl_atomic_load_relaxed(&codeinst2->specptr.fptr);
+    if (invoke == NULL || invoke == jl_fptr_interpret_call)
+        return;
+    if (codeinst->rettype_const == NULL && codeinst2->rettype_const != NULL) {
+        // must be visible before a jl_fptr_const_return invoke is published
+        codeinst->rettype_const = codeinst2->rettype_const;
+        jl_gc_wb(codeinst, codeinst->rettype_const);
+    }
+    if (fptr != NULL) {
+        while (!(specsigflags & 0b10)) {
+            jl_cpu_pause();
+            specsigflags = jl_atomic_load_acquire(&codeinst2->specsigflags);
+        }
+        invoke = jl_atomic_load_relaxed(&codeinst2->invoke);
+        void *prev_fptr = NULL;
+        // see jitlayers.cpp for the ordering restrictions here
+        if (jl_atomic_cmpswap_acqrel(&codeinst->specptr.fptr, &prev_fptr, fptr)) {
+            jl_atomic_store_release(&codeinst->invoke, invoke);
+            // this codeinst still advertises rettype Any, so it must not claim
+            // the specsig calling convention of the compiled code instance
+            jl_atomic_store_release(&codeinst->specsigflags, specsigflags & ~0b1);
+            // the first compile ran at TIER1_OPT_LEVEL for latency; hand the
+            // compiled instance to the background worker for re-optimization
+            jl_enqueue_reoptimization(codeinst2);
+        }
+    }
+    else {
+        jl_atomic_store_release(&codeinst->invoke, invoke);
+    }
+}
+
+// called by the interpreter entry point under `--compile=tiered`: count this
+// call in the per-thread direct-mapped counter cache and promote once hot
+void jl_tier0_count_call(jl_code_instance_t *codeinst)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    size_t slot = (((uintptr_t)codeinst) / sizeof(void*)) % JL_TIER0_COUNTER_SLOTS;
+    if (ptls->tier0_counters[slot].ci != codeinst) {
+        ptls->tier0_counters[slot].ci = codeinst;
+        ptls->tier0_counters[slot].count = 0;
+    }
+    // exact comparison, so a failed promotion is not retried on every call;
+    // the compile itself happens on the background compiler thread and this
+    // thread continues interpreting until the entry points are replaced
+    if (++ptls->tier0_counters[slot].count == TIER0_PROMOTE_THRESHOLD)
+        jl_enqueue_tier0_promotion(codeinst);
+}
+
 jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *mi, size_t world)
 {
     // quick check if we already have a compiled result
@@ -2471,9 +2671,13 @@ jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *mi, size_t
         }
     }
 
-    // if that didn't work and compilation is off, try running in the interpreter
+    // if that didn't work and compilation is off, try running in the interpreter;
+    // in tiered mode, cold first calls start out interpreted the same way and
+    // jl_tier0_count_call promotes them to the JIT once they get hot
     if (compile_option == JL_OPTIONS_COMPILE_OFF ||
-        compile_option == JL_OPTIONS_COMPILE_MIN) {
+        compile_option == JL_OPTIONS_COMPILE_MIN ||
+        (compile_option == JL_OPTIONS_COMPILE_TIERED &&
+         jl_is_method(def) && def->source != jl_nothing)) {
         jl_code_info_t *src = jl_code_for_interpreter(mi, world);
         if (!jl_code_requires_compiler(src, 0)) {
             jl_code_instance_t *codeinst = jl_new_codeinst(mi,
@@ -2843,11 +3047,24 @@ jl_value_t *jl_argtype_with_function_type(jl_value_t *ft JL_MAYBE_UNROOTED, jl_v
     size_t l = jl_nparams(types);
     jl_value_t *tt = NULL;
     JL_GC_PUSH2(&tt, &ft);
-    tt = (jl_value_t*)jl_alloc_svec(1+l);
-    jl_svecset(tt, 0, ft);
-    for (size_t i = 0; i < l; i++)
-        jl_svecset(tt, i+1, jl_tparam(types,i));
-    tt = (jl_value_t*)jl_apply_tuple_type((jl_svec_t*)tt, 1);
+    if (1 + l < jl_page_size / sizeof(jl_value_t*)) {
+        // build the parameter list on the stack, so that a cache hit for the
+        // prepended tuple type allocates nothing
+        jl_value_t **p;
+        JL_GC_PUSHARGS(p, 1 + l);
+        p[0] = ft;
+        for (size_t i = 0; i < l; i++)
+            p[i+1] = jl_tparam(types, i);
+        tt = jl_apply_tuple_type_v(p, 1 + l);
+        JL_GC_POP();
+    }
+    else {
+        tt = (jl_value_t*)jl_alloc_svec(1+l);
+        jl_svecset(tt, 0, ft);
+        for (size_t i = 0; i < l; i++)
+            jl_svecset(tt, i+1, jl_tparam(types,i));
+        tt = (jl_value_t*)jl_apply_tuple_type((jl_svec_t*)tt, 1);
+    }
     tt = jl_rewrap_unionall_(tt, types0);
     JL_GC_POP();
     return tt;
@@ -2932,8 +3149,102 @@ STATIC_INLINE int sig_match_fast(jl_value_t *arg1t, jl_value_t **args, jl_value_
     return 1;
 }
 
+// Per-method dynamic-dispatch miss profiling
+//
+// With profiling enabled (jl_dispatch_profile_enable, off by default), every
+// lookup that misses all of the associative dispatch caches below and has to
+// consult the method table bumps a counter for the method it ultimately
+// dispatched to; jl_dispatch_profile_counts snapshots them sorted by count,
+// turning "which dynamic dispatch is costing us" into a direct report rather
+// than a profiling expedition. The counter update takes a global lock, which
+// is cheap relative to a path that already does a full typemap lookup, and
+// the disabled case costs a single relaxed load per slow-path miss.
+jl_mutex_t dispatch_profile_lock;
+static _Atomic(int) dispatch_profile_enabled;
+static htable_t dispatch_miss_counts; // jl_method_t* => count + 2 (so a count never collides with HT_NOTFOUND)
+
+JL_DLLEXPORT void jl_dispatch_profile_enable(int enable)
+{
+    JL_LOCK_NOGC(&dispatch_profile_lock);
+    if (dispatch_miss_counts.table == NULL)
+        htable_new(&dispatch_miss_counts, 512);
+    jl_atomic_store_release(&dispatch_profile_enabled, !!enable);
+    JL_UNLOCK_NOGC(&dispatch_profile_lock);
+}
+
+static void dispatch_profile_record(jl_method_instance_t *mfunc) JL_NOTSAFEPOINT
+{
+    if (!jl_is_method(mfunc->def.value))
+        return;
+    // the keys stay valid without rooting: a dispatch target is reachable
+    // from its method table for as long as the counts are interesting
+    jl_method_t *m = mfunc->def.method;
+    JL_LOCK_NOGC(&dispatch_profile_lock);
+    void *val = ptrhash_get(&dispatch_miss_counts, m);
+    uintptr_t n = val == HT_NOTFOUND ? 2 : (uintptr_t)val;
+    ptrhash_put(&dispatch_miss_counts, m, (void*)(n + 1));
+    JL_UNLOCK_NOGC(&dispatch_profile_lock);
+}
+
+typedef struct {
+    jl_method_t *m;
+    size_t n;
+} dispatch_miss_pair_t;
+
+static int dispatch_miss_pair_cmp(const void *a, const void *b) JL_NOTSAFEPOINT
+{
+    size_t na = ((const dispatch_miss_pair_t*)a)->n;
+    size_t nb = ((const dispatch_miss_pair_t*)b)->n;
+    return na < nb ? 1 : na > nb ? -1 : 0; // descending
+}
+
+// Return a Vector{Any} of svec(method, count) pairs, most-missed first.
+JL_DLLEXPORT jl_value_t *jl_dispatch_profile_counts(void)
+{
+    size_t len = 0;
+    dispatch_miss_pair_t *pairs = NULL;
+    JL_LOCK_NOGC(&dispatch_profile_lock);
+    if (dispatch_miss_counts.table != NULL) {
+        pairs = (dispatch_miss_pair_t*)malloc_s(sizeof(dispatch_miss_pair_t) * (dispatch_miss_counts.size / 2 + 1));
+        for (size_t i = 0; i < dispatch_miss_counts.size; i += 2) {
+            void *val = dispatch_miss_counts.table[i + 1];
+            if (val == HT_NOTFOUND)
+                continue;
+            pairs[len].m = (jl_method_t*)dispatch_miss_counts.table[i];
+            pairs[len].n = (uintptr_t)val - 2;
+            len++;
+        }
+    }
+    JL_UNLOCK_NOGC(&dispatch_profile_lock);
+    if (pairs != NULL)
+        qsort(pairs, len, sizeof(dispatch_miss_pair_t), dispatch_miss_pair_cmp);
+    jl_array_t *a = jl_alloc_vec_any(0);
+    jl_value_t *cnt = NULL;
+    jl_value_t *pair = NULL;
+    JL_GC_PUSH3(&a, &cnt, &pair);
+    for (size_t i = 0; i < len; i++) {
+        cnt = jl_box_uint64(pairs[i].n);
+        pair = (jl_value_t*)jl_svec2((jl_value_t*)pairs[i].m, cnt);
+        jl_array_ptr_1d_push(a, pair);
+    }
+    JL_GC_POP();
+    free(pairs);
+    return (jl_value_t*)a;
+}
+
 _Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
 static _Atomic(uint8_t) pick_which[N_CALL_CACHE];
+
+// Per-call-site dispatch cache, addressed by the caller's return address.
+// Unlike `call_cache`, whose probe slots are shared by every call site that
+// hashes onto them, a slot here is owned by a single call site (the key is
+// verified), so a hot site cannot be evicted by unrelated ones. Each site
+// holds two ways with the most recently used signature first, which covers
+// the common mono- and bi-morphic sites; megamorphic sites fall through to
+// `call_cache` and the full lookup as before. A way left behind by a
+// previous owner of the slot is harmless: the signature and world checks
+// fully validate whatever entry is found.
+jl_callsite_cache_t callsite_cache[N_CALLSITE_CACHE] JL_GLOBALLY_ROOTED;
 #ifdef JL_GF_PROFILE
 size_t ncalls;
 void call_cache_stats()
@@ -2952,7 +3263,7 @@ void call_cache_stats()
 #endif
 
 STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t **args, uint32_t nargs,
-                                                       uint32_t callsite, size_t world)
+                                                       uintptr_t callsite, size_t world)
 {
 #ifdef JL_GF_PROFILE
     ncalls++;
@@ -2975,18 +3286,52 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
       if no generic match, use the concrete one even if inexact
       otherwise instantiate the generic method and use it
     */
+    jl_typemap_entry_t *entry = NULL;
+    jl_methtable_t *mt = NULL;
+    int i;
+    int dispatch_missed = 0;
+    // check this call site's private cache slot first (low bits of return
+    // addresses are poorly distributed, hence the shift)
+    jl_callsite_cache_t *sc = &callsite_cache[(callsite >> 4) & (N_CALLSITE_CACHE - 1)];
+    if (jl_atomic_load_relaxed(&sc->callsite) == callsite) {
+        for (i = 0; i < 2; i++) {
+            entry = jl_atomic_load_relaxed(&sc->ways[i]);
+            if (entry && nargs == jl_svec_len(entry->sig->parameters) &&
+                sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) &&
+                world >= entry->min_world && world <= entry->max_world) {
+                if (i != 0) {
+                    // move to front so the hottest signature is checked first
+                    jl_atomic_store_relaxed(&sc->ways[i], jl_atomic_load_relaxed(&sc->ways[0]));
+                    jl_atomic_store_release(&sc->ways[0], entry);
+                }
+                goto have_entry;
+            }
+        }
+    }
+    // then the thread-local set-associative cache: probing it touches no
+    // shared cache lines, and hits refresh the LRU order with plain stores
+    jl_typemap_entry_t **dset = jl_current_task->ptls->dispatch_cache[(callsite >> 4) & (JL_DISPATCH_CACHE_SETS - 1)];
+    for (i = 0; i < JL_DISPATCH_CACHE_WAYS; i++) {
+        entry = dset[i];
+        if (entry && nargs == jl_svec_len(entry->sig->parameters) &&
+            sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) &&
+            world >= entry->min_world && world <= entry->max_world) {
+            for (; i > 0; i--)
+                dset[i] = dset[i - 1];
+            dset[0] = entry;
+            goto have_entry;
+        }
+    }
     // compute the entry hashes
     // use different parts of the value
     // so that a collision across all of
     // them is less likely
+    uint32_t callsite_hash = jl_int32hash_fast(callsite);
     uint32_t cache_idx[4] = {
-        (callsite) & (N_CALL_CACHE - 1),
-        (callsite >> 8) & (N_CALL_CACHE - 1),
-        (callsite >> 16) & (N_CALL_CACHE - 1),
-        (callsite >> 24 | callsite << 8) & (N_CALL_CACHE - 1)};
-    jl_typemap_entry_t *entry = NULL;
-    jl_methtable_t *mt = NULL;
-    int i;
+        (callsite_hash) & (N_CALL_CACHE - 1),
+        (callsite_hash >> 8) & (N_CALL_CACHE - 1),
+        (callsite_hash >> 16) & (N_CALL_CACHE - 1),
+        (callsite_hash >> 24 | callsite_hash << 8) & (N_CALL_CACHE - 1)};
     // check each cache entry to see if it matches
     //#pragma unroll
     //for (i = 0; i < 4; i++) {
@@ -3011,6 +3356,7 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
     int64_t last_alloc = 0;
     if (i == 4) {
         // if no method was found in the associative cache, check the full cache
+        dispatch_missed = 1;
         JL_TIMING(METHOD_LOOKUP_FAST, METHOD_LOOKUP_FAST);
         mt = jl_gf_mtable(F);
         jl_genericmemory_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
@@ -3041,6 +3387,14 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
             int which = jl_atomic_load_relaxed(&pick_which[cache_idx[0]]) + 1;
             jl_atomic_store_relaxed(&pick_which[cache_idx[0]], which);
             jl_atomic_store_release(&call_cache[cache_idx[which & 3]], entry);
+            // also claim (or refresh) this call site's private slot
+            jl_atomic_store_relaxed(&sc->callsite, callsite);
+            jl_atomic_store_relaxed(&sc->ways[1], jl_atomic_load_relaxed(&sc->ways[0]));
+            jl_atomic_store_release(&sc->ways[0], entry);
+            // and the front of the thread-local set, evicting its LRU way
+            for (int j = JL_DISPATCH_CACHE_WAYS - 1; j > 0; j--)
+                dset[j] = dset[j - 1];
+            dset[0] = entry;
         }
     }
 
@@ -3065,6 +3419,9 @@ have_entry:
         }
     }
 
+    if (__unlikely(dispatch_missed && jl_atomic_load_relaxed(&dispatch_profile_enabled)))
+        dispatch_profile_record(mfunc);
+
 #ifdef JL_TRACE
     if (traceen)
         jl_printf(JL_STDOUT, " at %s:%d\n", jl_symbol_name(mfunc->def.method->file), mfunc->def.method->line);
@@ -3076,12 +3433,20 @@ JL_DLLEXPORT jl_value_t *jl_apply_generic(jl_value_t *F, jl_value_t **args, uint
 {
     size_t world = jl_current_task->world_age;
     jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
-                                                     jl_int32hash_fast(jl_return_address()),
+                                                     jl_return_address(),
                                                      world);
     JL_GC_PROMISE_ROOTED(mfunc);
     return _jl_invoke(F, args, nargs, mfunc, world);
 }
 
+// memo table for failed method lookups: hasmethod-style feature probes pose
+// the same absent signatures over and over, each paying a full typemap
+// descent in ml_matches. A slot records the (types, mt) pair, the world
+// bounds ml_matches reported for the miss, and the world counter it was
+// computed under; entries are only trusted at that exact counter, since an
+// open-ended "no method" verdict does not survive a new definition
+_Atomic(jl_svec_t*) missing_method_cache[N_MISSING_METHOD_CACHE] JL_GLOBALLY_ROOTED;
+
 static jl_method_match_t *_gf_invoke_lookup(jl_value_t *types JL_PROPAGATES_ROOT, jl_value_t *mt, size_t world, size_t *min_valid, size_t *max_valid)
 {
     jl_value_t *unw = jl_unwrap_unionall((jl_value_t*)types);
@@ -3093,9 +3458,40 @@ static jl_method_match_t *_gf_invoke_lookup(jl_value_t *types JL_PROPAGATES_ROOT
         mt = (jl_value_t*)jl_method_table_for(unw);
     if (mt == jl_nothing)
         mt = NULL;
+    jl_value_t *mtkey = mt == NULL ? jl_nothing : mt;
+    size_t counter = jl_atomic_load_acquire(&jl_world_counter);
+    int memo_idx = jl_int32hash_fast((uint32_t)((uintptr_t)types ^ ((uintptr_t)mtkey >> 3))) & (N_MISSING_METHOD_CACHE - 1);
+    jl_svec_t *memo = jl_atomic_load_acquire(&missing_method_cache[memo_idx]);
+    if (memo != NULL && jl_svecref(memo, 0) == types && jl_svecref(memo, 1) == mtkey &&
+        jl_unbox_ulong(jl_svecref(memo, 4)) == counter) {
+        size_t cmin = jl_unbox_ulong(jl_svecref(memo, 2));
+        size_t cmax = jl_unbox_ulong(jl_svecref(memo, 3));
+        if (cmin <= world && world <= cmax) {
+            if (cmin > *min_valid)
+                *min_valid = cmin;
+            if (cmax < *max_valid)
+                *max_valid = cmax;
+            return NULL;
+        }
+    }
     jl_value_t *matches = ml_matches((jl_methtable_t*)mt, (jl_tupletype_t*)types, 1, 0, 0, world, 1, min_valid, max_valid, NULL);
-    if (matches == jl_nothing || jl_array_nrows(matches) != 1)
+    if (matches == jl_nothing || jl_array_nrows(matches) != 1) {
+        // only record true empty results: an over-limit bailout may report
+        // bounds for a partially completed search
+        if (matches != jl_nothing && jl_array_nrows(matches) == 0 &&
+            *min_valid <= world && world <= *max_valid &&
+            jl_atomic_load_acquire(&jl_world_counter) == counter) {
+            jl_value_t **roots;
+            JL_GC_PUSHARGS(roots, 3);
+            roots[0] = jl_box_ulong(*min_valid);
+            roots[1] = jl_box_ulong(*max_valid);
+            roots[2] = jl_box_ulong(counter);
+            jl_svec_t *newmemo = jl_svec(5, types, mtkey, roots[0], roots[1], roots[2]);
+            jl_atomic_store_release(&missing_method_cache[memo_idx], newmemo);
+            JL_GC_POP();
+        }
         return NULL;
+    }
     jl_method_match_t *matc = (jl_method_match_t*)jl_array_ptr_ref(matches, 0);
     return matc;
 }
@@ -3129,11 +3525,31 @@ JL_DLLEXPORT jl_value_t *jl_gf_invoke_lookup_worlds(jl_value_t *types, jl_value_
 // every definition has its own private method table for this purpose.
 //
 // NOTE: assumes argument type is a subtype of the lookup type.
+// memo table for dynamic invoke lookups: the method a (types, function type)
+// pair resolves to is deterministic for a fixed world, so a hit only needs
+// pointer-equal keys and an exact world match and never requires invalidation
+_Atomic(jl_svec_t*) invoke_cache[N_INVOKE_CACHE] JL_GLOBALLY_ROOTED;
+
 jl_value_t *jl_gf_invoke(jl_value_t *types0, jl_value_t *gf, jl_value_t **args, size_t nargs)
 {
     size_t world = jl_current_task->world_age;
+    int memo_idx = -1;
+    if (!jl_is_type(gf)) {
+        // the call sig is derived from (typeof(gf), types0), so those two
+        // pointers (plus the world) fully determine the lookup result
+        jl_value_t *ft = jl_typeof(gf);
+        memo_idx = jl_int32hash_fast((uint32_t)((uintptr_t)types0 ^ ((uintptr_t)ft >> 3) ^ world)) & (N_INVOKE_CACHE - 1);
+        jl_svec_t *memo = jl_atomic_load_acquire(&invoke_cache[memo_idx]);
+        if (memo != NULL && jl_svecref(memo, 0) == types0 && jl_svecref(memo, 1) == ft &&
+            jl_unbox_ulong(jl_svecref(memo, 3)) == world) {
+            jl_method_t *method = (jl_method_t*)jl_svecref(memo, 2);
+            JL_GC_PROMISE_ROOTED(method);
+            return jl_gf_invoke_by_method(method, gf, args, nargs);
+        }
+    }
     jl_value_t *types = NULL;
-    JL_GC_PUSH1(&types);
+    jl_value_t *boxedworld = NULL;
+    JL_GC_PUSH2(&types, &boxedworld);
     types = jl_argtype_with_function((jl_value_t*)gf, types0);
     jl_method_t *method = (jl_method_t*)jl_gf_invoke_lookup(types, jl_nothing, world);
     JL_GC_PROMISE_ROOTED(method);
@@ -3143,6 +3559,12 @@ jl_value_t *jl_gf_invoke(jl_value_t *types0, jl_value_t *gf, jl_value_t **args,
         // unreachable
     }
 
+    if (memo_idx >= 0) {
+        boxedworld = jl_box_ulong(world);
+        jl_svec_t *memo = jl_svec(4, types0, jl_typeof(gf), (jl_value_t*)method, boxedworld);
+        jl_atomic_store_release(&invoke_cache[memo_idx], memo);
+    }
+
     // now we have found the matching definition.
     // next look for or create a specialization of this definition.
     JL_GC_POP();
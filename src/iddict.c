@@ -55,24 +55,13 @@ static inline int jl_table_assign_bp(jl_genericmemory_t **pa, jl_value_t *key, j
         do {
             jl_value_t *k2 = jl_atomic_load_relaxed(&tab[index]);
             if (k2 == NULL) {
-                if (empty_slot == -1)
-                    empty_slot = index;
+                empty_slot = index;
                 break;
             }
             if (jl_egal(key, k2)) {
-                if (jl_atomic_load_relaxed(&tab[index + 1]) != NULL) {
-                    jl_atomic_store_release(&tab[index + 1], val);
-                    jl_gc_wb(a, val);
-                    return 0;
-                }
-                // `nothing` is our sentinel value for deletion, so need to keep searching if it's also our search key
-                assert(key == jl_nothing);
-                if (empty_slot == -1)
-                    empty_slot = index;
-            }
-            if (empty_slot == -1 && jl_atomic_load_relaxed(&tab[index + 1]) == NULL) {
-                assert(jl_atomic_load_relaxed(&tab[index]) == jl_nothing);
-                empty_slot = index;
+                jl_atomic_store_release(&tab[index + 1], val);
+                jl_gc_wb(a, val);
+                return 0;
             }
 
             index = (index + 2) & (sz - 1);
@@ -128,9 +117,7 @@ inline _Atomic(jl_value_t*) *jl_table_peek_bp(jl_genericmemory_t *a, jl_value_t
         if (jl_egal(key, k2)) {
             if (jl_atomic_load_relaxed(&tab[index + 1]) != NULL)
                 return &tab[index + 1];
-            // `nothing` is our sentinel value for deletion, so need to keep searching if it's also our search key
-            if (key != jl_nothing)
-                return NULL; // concurrent insertion hasn't completed yet
+            return NULL; // concurrent insertion hasn't completed yet
         }
 
         index = (index + 2) & (sz - 1);
@@ -164,6 +151,38 @@ jl_value_t *jl_eqtable_getkey(jl_genericmemory_t *h, jl_value_t *key, jl_value_t
     return (bp == NULL) ? deflt : jl_atomic_load_relaxed(bp - 1);
 }
 
+// Close the hole left by a deletion at `hole` (a key index) by shifting each
+// following entry back into it whenever the hole lies between the entry's
+// ideal slot and its current one, so the no-NULL-between-ideal-and-actual
+// invariant the probe loops rely on is restored without a tombstone.
+// Note this moves entries, which is why deletion is not permitted concurrently
+// with lookups (see the comment above jl_eqtable_get).
+static void jl_table_backshift(jl_genericmemory_t *a, size_t hole) JL_NOTSAFEPOINT
+{
+    _Atomic(jl_value_t*) *tab = (_Atomic(jl_value_t*)*) a->ptr;
+    size_t sz2 = a->length;
+    size_t i = (hole + 2) & (sz2 - 1);
+    while (i != hole) { // i == hole means the table had no empty slot at all
+        jl_value_t *k2 = jl_atomic_load_relaxed(&tab[i]);
+        if (k2 == NULL)
+            break;
+        size_t ideal = h2index(keyhash(k2), sz2 / 2);
+        // move iff the hole lies cyclically in [ideal, i)
+        if (((i - ideal) & (sz2 - 1)) >= ((i - hole) & (sz2 - 1))) {
+            jl_atomic_store_release(&tab[hole], k2);
+            jl_gc_wb(a, k2);
+            jl_value_t *v2 = jl_atomic_load_relaxed(&tab[i + 1]);
+            jl_atomic_store_release(&tab[hole + 1], v2);
+            if (v2 != NULL)
+                jl_gc_wb(a, v2);
+            hole = i;
+        }
+        i = (i + 2) & (sz2 - 1);
+    }
+    jl_atomic_store_relaxed(&tab[hole + 1], NULL);
+    jl_atomic_store_relaxed(&tab[hole], NULL);
+}
+
 JL_DLLEXPORT
 jl_value_t *jl_eqtable_pop(jl_genericmemory_t *h, jl_value_t *key, jl_value_t *deflt, int *found)
 {
@@ -173,8 +192,7 @@ jl_value_t *jl_eqtable_pop(jl_genericmemory_t *h, jl_value_t *key, jl_value_t *d
     if (bp == NULL)
         return deflt;
     jl_value_t *val = jl_atomic_load_relaxed(bp);
-    jl_atomic_store_relaxed(bp - 1, jl_nothing); // clear the key
-    jl_atomic_store_relaxed(bp, NULL); // and the value (briefly corrupting the table)
+    jl_table_backshift(h, (size_t)((bp - 1) - (_Atomic(jl_value_t*)*) h->ptr));
     return val;
 }
 
@@ -241,6 +241,9 @@ JL_DLLEXPORT void jl_atexit_hook(int exitcode) JL_NOTSAFEPOINT_ENTER
 {
     uv_tty_reset_mode();
 
+    jl_startup_trace_flush();
+    jl_image_layout_profile_write();
+
     if (jl_atomic_load_relaxed(&jl_all_tls_states) == NULL)
         return;
 
@@ -284,6 +287,8 @@ JL_DLLEXPORT void jl_atexit_hook(int exitcode) JL_NOTSAFEPOINT_ENTER
     if (ct && exitcode == 0)
         jl_write_compiler_output();
 
+    if (jl_options.trace_compile)
+        jl_write_trace_compile_sorted();
     jl_print_gc_stats(JL_STDERR);
     if (jl_options.code_coverage)
         jl_write_coverage_data(jl_options.output_code_coverage);
@@ -719,7 +724,10 @@ extern jl_mutex_t jl_modules_mutex;
 extern jl_mutex_t precomp_statement_out_lock;
 extern jl_mutex_t newly_inferred_mutex;
 extern jl_mutex_t global_roots_lock;
+extern jl_mutex_t lazy_fptrs_lock;
 extern jl_mutex_t profile_show_peek_cond_lock;
+extern jl_mutex_t lowered_cache_lock;
+extern jl_mutex_t dispatch_profile_lock;
 
 static void restore_fp_env(void)
 {
@@ -737,9 +745,12 @@ static void init_global_mutexes(void) {
     JL_MUTEX_INIT(&precomp_statement_out_lock, "precomp_statement_out_lock");
     JL_MUTEX_INIT(&newly_inferred_mutex, "newly_inferred_mutex");
     JL_MUTEX_INIT(&global_roots_lock, "global_roots_lock");
+    JL_MUTEX_INIT(&lazy_fptrs_lock, "lazy_fptrs_lock");
     JL_MUTEX_INIT(&jl_codegen_lock, "jl_codegen_lock");
     JL_MUTEX_INIT(&typecache_lock, "typecache_lock");
     JL_MUTEX_INIT(&profile_show_peek_cond_lock, "profile_show_peek_cond_lock");
+    JL_MUTEX_INIT(&lowered_cache_lock, "lowered_cache_lock");
+    JL_MUTEX_INIT(&dispatch_profile_lock, "dispatch_profile_lock");
 }
 
 JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
@@ -748,6 +759,8 @@ JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
     // but generally running from simple platform things to optional
     // configuration features
     jl_init_timing();
+    jl_startup_trace_init();
+    jl_startup_trace_enter("julia_init");
     // Make sure we finalize the tls callback before starting any threads.
     (void)jl_get_pgcstack();
 
@@ -774,10 +787,12 @@ JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
     init_global_mutexes();
     jl_precompile_toplevel_module = NULL;
     ios_set_io_wait_func = jl_set_io_wait;
+    jl_startup_trace_enter("uv/stdio init");
     jl_io_loop = uv_default_loop(); // this loop will internal events (spawning process etc.),
                                     // best to call this first, since it also initializes libuv
     jl_init_uv();
     init_stdio();
+    jl_startup_trace_exit("uv/stdio init");
     restore_fp_env();
     if (jl_options.handle_signals == JL_OPTIONS_HANDLE_SIGNALS_ON)
         restore_signals();
@@ -822,7 +837,9 @@ JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
     if (jl_options.handle_signals == JL_OPTIONS_HANDLE_SIGNALS_ON)
         jl_install_default_signal_handlers();
 
+    jl_startup_trace_enter("gc init");
     jl_gc_init();
+    jl_startup_trace_exit("gc init");
 
     arraylist_new(&jl_linkage_blobs, 0);
     arraylist_new(&jl_image_relocs, 0);
@@ -854,11 +871,15 @@ static NOINLINE void _finish_julia_init(JL_IMAGE_SEARCH rel, jl_ptls_t ptls, jl_
         jl_preload_sysimg_so(jl_options.image_file);
     if (jl_options.cpu_target == NULL)
         jl_options.cpu_target = "native";
+    jl_startup_trace_enter("codegen init");
     jl_init_codegen();
+    jl_startup_trace_exit("codegen init");
 
     jl_init_common_symbols();
     if (jl_options.image_file) {
+        jl_startup_trace_enter("sysimg restore");
         jl_restore_system_image(jl_options.image_file);
+        jl_startup_trace_exit("sysimg restore");
     } else {
         jl_init_types();
         jl_global_roots_list = (jl_genericmemory_t*)jl_an_empty_memory_any;
@@ -899,13 +920,17 @@ static NOINLINE void _finish_julia_init(JL_IMAGE_SEARCH rel, jl_ptls_t ptls, jl_
         int i, l = jl_array_nrows(init_order);
         for (i = 0; i < l; i++) {
             jl_value_t *mod = jl_array_ptr_ref(init_order, i);
+            const char *name = jl_symbol_name(((jl_module_t*)mod)->name);
+            jl_startup_trace_enter(name);
             jl_module_run_initializer((jl_module_t*)mod);
+            jl_startup_trace_exit(name);
         }
         JL_GC_POP();
     }
 
     if (jl_options.handle_signals == JL_OPTIONS_HANDLE_SIGNALS_ON)
         jl_install_sigint_handler();
+    jl_startup_trace_exit("julia_init");
 }
 
 #ifdef __cplusplus
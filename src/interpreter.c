@@ -8,6 +8,7 @@
 #include "julia.h"
 #include "julia_internal.h"
 #include "builtin_proto.h"
+#include "intrinsics.h"
 #include "julia_assert.h"
 
 #ifdef __cplusplus
@@ -20,6 +21,7 @@ typedef struct {
     jl_module_t *module; // context for globals
     jl_value_t **locals; // slots for holding local slots and ssavalues
     jl_svec_t *sparam_vals; // method static parameters, if eval-ing a method body
+    uint8_t *ops; // memoized statement opcodes for eval_body dispatch (see stmt_opcode)
     size_t ip; // Leak the currently-evaluating statement index to backtrace capture
     int preevaluation; // use special rules for pre-evaluating expressions (deprecated--only for ccall handling)
     int continue_at; // statement index to jump to after leaving exception handler (0 if none)
@@ -74,6 +76,76 @@ extern void JL_GC_ENABLEFRAME(interpreter_state*) JL_NOTSAFEPOINT;
 static jl_value_t *eval_value(jl_value_t *e, interpreter_state *s);
 static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip, int toplevel);
 
+// statement opcodes for the eval_body dispatch loop. classifying a statement
+// means walking a chain of type (and for Expr, head) comparisons, so the
+// result is memoized per-statement in `s->ops`: loops and exception re-entry
+// then dispatch with a single byte load instead of re-running the chain.
+enum stmt_opcodes {
+    STMT_GOTONODE = 0,
+    STMT_GOTOIFNOT,
+    STMT_RETURNNODE,
+    STMT_UPSILONNODE,
+    STMT_ENTERNODE,
+    STMT_ASSIGN,
+    STMT_LEAVE,
+    STMT_POP_EXCEPTION,
+    STMT_EXPR,
+    STMT_NEWVARNODE,
+    STMT_LINENODE,
+    STMT_VALUE,
+    N_STMT_OPCODES
+};
+#define STMT_UNKNOWN 0xff
+
+static uint8_t stmt_opcode(jl_value_t *stmt) JL_NOTSAFEPOINT
+{
+    if (jl_is_gotonode(stmt))
+        return STMT_GOTONODE;
+    if (jl_is_gotoifnot(stmt))
+        return STMT_GOTOIFNOT;
+    if (jl_is_returnnode(stmt))
+        return STMT_RETURNNODE;
+    if (jl_is_upsilonnode(stmt))
+        return STMT_UPSILONNODE;
+    if (jl_is_enternode(stmt))
+        return STMT_ENTERNODE;
+    if (jl_is_expr(stmt)) {
+        jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+        if (head == jl_assign_sym)
+            return STMT_ASSIGN;
+        if (head == jl_leave_sym)
+            return STMT_LEAVE;
+        if (head == jl_pop_exception_sym)
+            return STMT_POP_EXCEPTION;
+        return STMT_EXPR;
+    }
+    if (jl_is_newvarnode(stmt))
+        return STMT_NEWVARNODE;
+    if (jl_is_linenode(stmt))
+        return STMT_LINENODE;
+    return STMT_VALUE;
+}
+
+// direct-threaded dispatch for eval_body, following the same pattern as the
+// flisp VM (see flisp/opcodes.h). the GC analyzer does not understand
+// computed goto, so it always gets the switch form.
+#if defined(USE_COMPUTED_GOTO) && !defined(__clang_gcanalyzer__)
+#define STMT_LABELS \
+    static const void *stmt_labels[] = { \
+        &&L_STMT_GOTONODE, &&L_STMT_GOTOIFNOT, &&L_STMT_RETURNNODE, \
+        &&L_STMT_UPSILONNODE, &&L_STMT_ENTERNODE, &&L_STMT_ASSIGN, \
+        &&L_STMT_LEAVE, &&L_STMT_POP_EXCEPTION, &&L_STMT_EXPR, \
+        &&L_STMT_NEWVARNODE, &&L_STMT_LINENODE, &&L_STMT_VALUE \
+    }
+#define STMT_OP(x) L_##x:
+#define STMT_DISPATCH(op) goto *stmt_labels[op];
+#else
+#define STMT_LABELS
+#define STMT_OP(x) case x:
+#define STMT_DISPATCH(op) switch (op)
+#endif
+#define STMT_NEXT() goto next_stmt
+
 // method definition form
 
 static jl_value_t *eval_methoddef(jl_expr_t *ex, interpreter_state *s)
@@ -115,6 +187,74 @@ static jl_value_t *eval_methoddef(jl_expr_t *ex, interpreter_state *s)
 
 // expression evaluator
 
+// Inline execution of the intrinsics that dominate numeric tier-0 code when
+// the operands are Int64 or Float64, skipping jl_f_intrinsic_call's
+// argument-count check and runtime-table indirection; comparisons return the
+// interned booleans without allocating at all. Lowered first-run sources
+// rarely carry inferred ssavalue types, so leafness is checked on the
+// evaluated operands themselves. Returns NULL when the (intrinsic, operand
+// type) pair is not recognized and the caller falls back to the generic
+// builtin path; division and shifts are left there for their error and
+// clamping semantics. Wrapping arithmetic is done unsigned to avoid C
+// signed-overflow UB.
+static jl_value_t *do_intrinsic_fast(jl_value_t *f, jl_value_t **args, size_t nargs)
+{
+    enum intrinsic fi = (enum intrinsic)*(uint32_t*)jl_data_ptr(f);
+    if (nargs == 1) {
+        jl_value_t *a = args[0];
+        if (jl_typeis(a, jl_int64_type)) {
+            uint64_t x = (uint64_t)jl_unbox_int64(a);
+            if (fi == neg_int)
+                return jl_box_int64((int64_t)(0 - x));
+            if (fi == not_int)
+                return jl_box_int64((int64_t)~x);
+            return NULL;
+        }
+        if (jl_typeis(a, jl_float64_type) && fi == neg_float)
+            return jl_box_float64(-jl_unbox_float64(a));
+        return NULL;
+    }
+    if (nargs != 2 || jl_typeof(args[0]) != jl_typeof(args[1]))
+        return NULL;
+    jl_value_t *a = args[0];
+    jl_value_t *b = args[1];
+    if (jl_typeis(a, jl_int64_type)) {
+        uint64_t x = (uint64_t)jl_unbox_int64(a);
+        uint64_t y = (uint64_t)jl_unbox_int64(b);
+        switch (fi) {
+        case add_int: return jl_box_int64((int64_t)(x + y));
+        case sub_int: return jl_box_int64((int64_t)(x - y));
+        case mul_int: return jl_box_int64((int64_t)(x * y));
+        case and_int: return jl_box_int64((int64_t)(x & y));
+        case or_int:  return jl_box_int64((int64_t)(x | y));
+        case xor_int: return jl_box_int64((int64_t)(x ^ y));
+        case eq_int:  return x == y ? jl_true : jl_false;
+        case ne_int:  return x != y ? jl_true : jl_false;
+        case slt_int: return (int64_t)x < (int64_t)y ? jl_true : jl_false;
+        case sle_int: return (int64_t)x <= (int64_t)y ? jl_true : jl_false;
+        case ult_int: return x < y ? jl_true : jl_false;
+        case ule_int: return x <= y ? jl_true : jl_false;
+        default: return NULL;
+        }
+    }
+    if (jl_typeis(a, jl_float64_type)) {
+        double x = jl_unbox_float64(a);
+        double y = jl_unbox_float64(b);
+        switch (fi) {
+        case add_float: return jl_box_float64(x + y);
+        case sub_float: return jl_box_float64(x - y);
+        case mul_float: return jl_box_float64(x * y);
+        case div_float: return jl_box_float64(x / y);
+        case eq_float: return x == y ? jl_true : jl_false;
+        case ne_float: return x != y ? jl_true : jl_false;
+        case lt_float: return x < y ? jl_true : jl_false;
+        case le_float: return x <= y ? jl_true : jl_false;
+        default: return NULL;
+        }
+    }
+    return NULL;
+}
+
 static jl_value_t *do_call(jl_value_t **args, size_t nargs, interpreter_state *s)
 {
     jl_value_t **argv;
@@ -123,7 +263,22 @@ static jl_value_t *do_call(jl_value_t **args, size_t nargs, interpreter_state *s
     size_t i;
     for (i = 0; i < nargs; i++)
         argv[i] = eval_value(args[i], s);
-    jl_value_t *result = jl_apply(argv, nargs);
+    jl_value_t *result = NULL;
+    jl_datatype_t *ft = (jl_datatype_t*)jl_typeof(argv[0]);
+    if (ft == jl_intrinsic_type)
+        result = do_intrinsic_fast(argv[0], &argv[1], nargs - 1);
+    if (result == NULL) {
+        if (ft->super == jl_builtin_type) {
+            // fast path for builtins (and intrinsics): they have exactly one
+            // method, with an `Any` signature valid in every world, and methods
+            // can never be added to them, so generic dispatch always resolves to
+            // the C entry point and we can call it directly
+            result = jl_get_builtin_fptr(ft)(argv[0], &argv[1], nargs - 1);
+        }
+        else {
+            result = jl_apply(argv, nargs);
+        }
+    }
     JL_GC_POP();
     return result;
 }
@@ -451,6 +606,7 @@ static size_t eval_phi(jl_array_t *stmts, interpreter_state *s, size_t ns, size_
 
 static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip, int toplevel)
 {
+    STMT_LABELS;
     jl_handler_t __eh;
     size_t ns = jl_array_nrows(stmts);
     jl_task_t *ct = jl_current_task;
@@ -465,10 +621,15 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
         assert(!jl_is_phinode(stmt));
         size_t next_ip = ip + 1;
         assert(!jl_is_phinode(stmt) && !jl_is_phicnode(stmt) && "malformed IR");
-        if (jl_is_gotonode(stmt)) {
+        uint8_t op = s->ops[ip];
+        if (op == STMT_UNKNOWN)
+            op = s->ops[ip] = stmt_opcode(stmt);
+        STMT_DISPATCH(op) {
+        STMT_OP(STMT_GOTONODE) {
             next_ip = jl_gotonode_label(stmt) - 1;
+            STMT_NEXT();
         }
-        else if (jl_is_gotoifnot(stmt)) {
+        STMT_OP(STMT_GOTOIFNOT) {
             jl_value_t *cond = eval_value(jl_gotoifnot_cond(stmt), s);
             if (cond == jl_false) {
                 next_ip = jl_gotoifnot_label(stmt) - 1;
@@ -476,11 +637,12 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             else if (cond != jl_true) {
                 jl_type_error("if", (jl_value_t*)jl_bool_type, cond);
             }
+            STMT_NEXT();
         }
-        else if (jl_is_returnnode(stmt)) {
+        STMT_OP(STMT_RETURNNODE) {
             return eval_value(jl_returnnode_value(stmt), s);
         }
-        else if (jl_is_upsilonnode(stmt)) {
+        STMT_OP(STMT_UPSILONNODE) {
             jl_value_t *val = jl_fieldref_noalloc(stmt, 0);
             if (val)
                 val = eval_value(val, s);
@@ -488,8 +650,9 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             assert(jl_is_ssavalue(phic));
             ssize_t id = ((jl_ssavalue_t*)phic)->id - 1;
             s->locals[jl_source_nslots(s->src) + id] = val;
+            STMT_NEXT();
         }
-        else if (jl_is_enternode(stmt)) {
+        STMT_OP(STMT_ENTERNODE) {
             jl_enter_handler(&__eh);
             // This is a bit tricky, but supports the implementation of PhiC nodes.
             // They are conceptually slots, but the slot to store to doesn't get explicitly
@@ -552,66 +715,69 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
                 continue;
             }
         }
-        else if (jl_is_expr(stmt)) {
-            // Most exprs are allowed to end a BB by fall through
-            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
-            if (head == jl_assign_sym) {
-                jl_value_t *lhs = jl_exprarg(stmt, 0);
-                jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
-                if (jl_is_slotnumber(lhs)) {
-                    ssize_t n = jl_slot_number(lhs);
-                    assert(n <= jl_source_nslots(s->src) && n > 0);
-                    s->locals[n - 1] = rhs;
+        STMT_OP(STMT_ASSIGN) {
+            jl_value_t *lhs = jl_exprarg(stmt, 0);
+            jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
+            if (jl_is_slotnumber(lhs)) {
+                ssize_t n = jl_slot_number(lhs);
+                assert(n <= jl_source_nslots(s->src) && n > 0);
+                s->locals[n - 1] = rhs;
+            }
+            else {
+                jl_module_t *modu;
+                jl_sym_t *sym;
+                if (jl_is_globalref(lhs)) {
+                    modu = jl_globalref_mod(lhs);
+                    sym = jl_globalref_name(lhs);
                 }
                 else {
-                    jl_module_t *modu;
-                    jl_sym_t *sym;
-                    if (jl_is_globalref(lhs)) {
-                        modu = jl_globalref_mod(lhs);
-                        sym = jl_globalref_name(lhs);
-                    }
-                    else {
-                        assert(jl_is_symbol(lhs));
-                        modu = s->module;
-                        sym = (jl_sym_t*)lhs;
-                    }
-                    JL_GC_PUSH1(&rhs);
-                    jl_binding_t *b = jl_get_binding_wr(modu, sym);
-                    jl_checked_assignment(b, modu, sym, rhs);
-                    JL_GC_POP();
+                    assert(jl_is_symbol(lhs));
+                    modu = s->module;
+                    sym = (jl_sym_t*)lhs;
                 }
+                JL_GC_PUSH1(&rhs);
+                jl_binding_t *b = jl_get_binding_wr(modu, sym);
+                jl_checked_assignment(b, modu, sym, rhs);
+                JL_GC_POP();
             }
-            else if (head == jl_leave_sym) {
-                int hand_n_leave = 0;
-                for (int i = 0; i < jl_expr_nargs(stmt); ++i) {
-                    jl_value_t *arg = jl_exprarg(stmt, i);
-                    if (arg == jl_nothing)
-                        continue;
-                    assert(jl_is_ssavalue(arg));
-                    jl_value_t *enter_stmt = jl_array_ptr_ref(stmts, ((jl_ssavalue_t*)arg)->id - 1);
-                    if (enter_stmt == jl_nothing)
-                        continue;
-                    hand_n_leave += 1;
-                }
-                if (hand_n_leave > 0) {
-                    assert(hand_n_leave > 0);
-                    // equivalent to jl_pop_handler(hand_n_leave), longjmping
-                    // to the :enter code above instead, which handles cleanup
-                    jl_handler_t *eh = ct->eh;
-                    while (--hand_n_leave > 0)
-                        eh = eh->prev;
-                    // leave happens during normal control flow, but we must
-                    // longjmp to pop the eval_body call for each enter.
-                    s->continue_at = next_ip;
-                    asan_unpoison_task_stack(ct, &eh->eh_ctx);
-                    jl_longjmp(eh->eh_ctx, 1);
-                }
+            STMT_NEXT();
+        }
+        STMT_OP(STMT_LEAVE) {
+            int hand_n_leave = 0;
+            for (int i = 0; i < jl_expr_nargs(stmt); ++i) {
+                jl_value_t *arg = jl_exprarg(stmt, i);
+                if (arg == jl_nothing)
+                    continue;
+                assert(jl_is_ssavalue(arg));
+                jl_value_t *enter_stmt = jl_array_ptr_ref(stmts, ((jl_ssavalue_t*)arg)->id - 1);
+                if (enter_stmt == jl_nothing)
+                    continue;
+                hand_n_leave += 1;
             }
-            else if (head == jl_pop_exception_sym) {
-                size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
-                jl_restore_excstack(prev_state);
+            if (hand_n_leave > 0) {
+                assert(hand_n_leave > 0);
+                // equivalent to jl_pop_handler(hand_n_leave), longjmping
+                // to the :enter code above instead, which handles cleanup
+                jl_handler_t *eh = ct->eh;
+                while (--hand_n_leave > 0)
+                    eh = eh->prev;
+                // leave happens during normal control flow, but we must
+                // longjmp to pop the eval_body call for each enter.
+                s->continue_at = next_ip;
+                asan_unpoison_task_stack(ct, &eh->eh_ctx);
+                jl_longjmp(eh->eh_ctx, 1);
             }
-            else if (toplevel) {
+            STMT_NEXT();
+        }
+        STMT_OP(STMT_POP_EXCEPTION) {
+            size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
+            jl_restore_excstack(prev_state);
+            STMT_NEXT();
+        }
+        STMT_OP(STMT_EXPR) {
+            // Most exprs are allowed to end a BB by fall through
+            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+            if (toplevel) {
                 if (head == jl_method_sym && jl_expr_nargs(stmt) > 1) {
                     eval_methoddef((jl_expr_t*)stmt, s);
                 }
@@ -660,20 +826,29 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             else {
                 eval_stmt_value(stmt, s);
             }
+            STMT_NEXT();
         }
-        else if (jl_is_newvarnode(stmt)) {
+        STMT_OP(STMT_NEWVARNODE) {
             jl_value_t *var = jl_fieldref(stmt, 0);
             assert(jl_is_slotnumber(var));
             ssize_t n = jl_slot_number(var);
             assert(n <= jl_source_nslots(s->src) && n > 0);
             s->locals[n - 1] = NULL;
+            STMT_NEXT();
         }
-        else if (toplevel && jl_is_linenode(stmt)) {
-            jl_lineno = jl_linenode_line(stmt);
+        STMT_OP(STMT_LINENODE) {
+            if (toplevel)
+                jl_lineno = jl_linenode_line(stmt);
+            else
+                eval_stmt_value(stmt, s);
+            STMT_NEXT();
         }
-        else {
+        STMT_OP(STMT_VALUE) {
             eval_stmt_value(stmt, s);
+            STMT_NEXT();
+        }
         }
+    next_stmt:
         ip = eval_phi(stmts, s, ns, next_ip);
     }
     abort();
@@ -712,6 +887,8 @@ jl_code_info_t *jl_code_for_interpreter(jl_method_instance_t *mi, size_t world)
 
 jl_value_t *NOINLINE jl_fptr_interpret_call(jl_value_t *f, jl_value_t **args, uint32_t nargs, jl_code_instance_t *codeinst)
 {
+    if (jl_options.compile_enabled == JL_OPTIONS_COMPILE_TIERED)
+        jl_tier0_count_call(codeinst);
     interpreter_state *s;
     jl_method_instance_t *mi = codeinst->def;
     jl_task_t *ct = jl_current_task;
@@ -726,6 +903,8 @@ jl_value_t *NOINLINE jl_fptr_interpret_call(jl_value_t *f, jl_value_t **args, ui
     locals[1] = (jl_value_t*)stmts;
     s->locals = locals + 2;
     s->src = src;
+    JL_CPPALLOCA(s->ops, jl_array_nrows(stmts));
+    memset(s->ops, STMT_UNKNOWN, jl_array_nrows(stmts));
     if (jl_is_module(mi->def.value)) {
         s->module = mi->def.module;
     }
@@ -773,6 +952,8 @@ jl_value_t *jl_interpret_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **ar
     locals[2] = (jl_value_t*)oc->captures;
     s->locals = locals + 2;
     s->src = code;
+    JL_CPPALLOCA(s->ops, jl_array_nrows(code->code));
+    memset(s->ops, STMT_UNKNOWN, jl_array_nrows(code->code));
     s->module = source->module;
     s->sparam_vals = NULL;
     s->preevaluation = 0;
@@ -805,6 +986,8 @@ jl_value_t *NOINLINE jl_interpret_toplevel_thunk(jl_module_t *m, jl_code_info_t
     jl_array_t *stmts = src->code;
     assert(jl_typetagis(stmts, jl_array_any_type));
     s->src = src;
+    JL_CPPALLOCA(s->ops, jl_array_nrows(stmts));
+    memset(s->ops, STMT_UNKNOWN, jl_array_nrows(stmts));
     s->module = m;
     s->sparam_vals = jl_emptysvec;
     s->continue_at = 0;
@@ -828,6 +1011,7 @@ jl_value_t *NOINLINE jl_interpret_toplevel_expr_in(jl_module_t *m, jl_value_t *e
     JL_GC_PUSHFRAME(s, locals, 0);
     (void)locals;
     s->src = src;
+    s->ops = NULL; // eval_value does not dispatch statements
     s->module = m;
     s->sparam_vals = sparam_vals;
     s->preevaluation = (sparam_vals != NULL);
@@ -21,12 +21,16 @@
 extern "C" {
 #endif
 
+typedef struct _jl_ir_symtab_t jl_ir_symtab_t;
+
 typedef struct {
     ios_t *s;
     // method we're compressing for
     jl_method_t *method;
     jl_ptls_t ptls;
     uint8_t relocatability;
+    // adaptive symbol table this IR is encoded against, or NULL
+    jl_ir_symtab_t *symtab;
 } jl_ircode_state;
 
 // type => tag hash for a few core types (e.g., Expr, PhiNode, etc)
@@ -57,6 +61,202 @@ jl_value_t *jl_deser_symbol(uint8_t tag)
     return deser_symbols[tag];
 }
 
+// --- adaptive per-pkgimage symbol tables ---
+
+// The common_symbols tables above are generated from Base (see
+// gen_sysimg_symtab.jl), so other packages' hot symbols miss the short
+// encodings entirely and fall back to method roots. When
+// JULIA_PKGIMAGE_SYMTAB is set in the environment, we count those misses
+// while IR is compressed, and incremental image output builds a per-image
+// table of the hottest ones, recompresses the image's new methods against it,
+// and emits the table into the image (see staticdata.c). Each table is
+// identified by a content hash stamped into every blob encoded against it, so
+// blobs written during precompilation can be decoded by any later process
+// that has loaded the image carrying their table.
+
+struct _jl_ir_symtab_t {
+    uint64_t hash;    // content hash of the symbol names, in table order
+    jl_array_t *syms; // the symbols, rooted via the global roots list
+    htable_t index;   // symbol => index + 2 (ptrhash cannot store 0 or 1)
+    jl_ir_symtab_t *next;
+};
+
+#define IR_SYMTAB_MAX_SYMS 255
+
+// append-only registry of all tables seen by this process
+static _Atomic(jl_ir_symtab_t*) ir_symtab_registry = NULL;
+// table new IR is compressed against, or NULL outside of image output
+static _Atomic(jl_ir_symtab_t*) ir_symtab_current = NULL;
+// guards registry insertion and ir_symbol_freq
+static jl_mutex_t ir_symtab_lock;
+// symbol => 1 + number of times it fell back to the method-root encoding
+static htable_t ir_symbol_freq;
+
+static int ir_symtab_enabled(void)
+{
+    static int enabled = -1;
+    if (enabled == -1) {
+        const char *e = getenv("JULIA_PKGIMAGE_SYMTAB");
+        enabled = (e != NULL && strcmp(e, "0") != 0);
+    }
+    return enabled;
+}
+
+static uint64_t ir_symtab_hash(jl_array_t *syms) JL_NOTSAFEPOINT
+{
+    uint64_t h = 0;
+    size_t i, n = jl_array_nrows(syms);
+    for (i = 0; i < n; i++) {
+        char *name = jl_symbol_name((jl_sym_t*)jl_array_ptr_ref(syms, i));
+        h = bitmix(h, memhash(name, strlen(name)));
+    }
+    return h;
+}
+
+static jl_ir_symtab_t *ir_symtab_find(uint64_t hash) JL_NOTSAFEPOINT
+{
+    jl_ir_symtab_t *t = jl_atomic_load_acquire(&ir_symtab_registry);
+    for (; t != NULL; t = t->next) {
+        if (t->hash == hash)
+            return t;
+    }
+    return NULL;
+}
+
+static void ir_symtab_count_miss(jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    JL_LOCK_NOGC(&ir_symtab_lock);
+    void *count = ptrhash_get(&ir_symbol_freq, sym);
+    if (count == HT_NOTFOUND)
+        count = (void*)1;
+    ptrhash_put(&ir_symbol_freq, sym, (void*)((size_t)count + 1));
+    JL_UNLOCK_NOGC(&ir_symtab_lock);
+}
+
+// Register `syms` (an array of at most IR_SYMTAB_MAX_SYMS Symbols) as an IR
+// symbol table. If `make_current` is set, new IR is subsequently compressed
+// against it; otherwise it only becomes available for decoding.
+JL_DLLEXPORT void jl_install_ir_symbol_table(jl_array_t *syms, int make_current)
+{
+    size_t i, n = jl_array_nrows(syms);
+    if (n == 0 || n > IR_SYMTAB_MAX_SYMS)
+        jl_error("IR symbol table must hold between 1 and 255 symbols");
+    uint64_t hash = ir_symtab_hash(syms);
+    jl_ir_symtab_t *t = ir_symtab_find(hash);
+    if (t == NULL) {
+        // copy the table and root it permanently before publishing it
+        jl_array_t *copy = jl_alloc_vec_any(n);
+        JL_GC_PUSH1(&copy);
+        for (i = 0; i < n; i++) {
+            jl_value_t *sym = jl_array_ptr_ref(syms, i);
+            if (!jl_is_symbol(sym))
+                jl_type_error("IR symbol table", (jl_value_t*)jl_symbol_type, sym);
+            jl_array_ptr_set(copy, i, sym);
+        }
+        jl_as_global_root((jl_value_t*)copy, 1);
+        JL_GC_POP();
+        jl_ir_symtab_t *newt = (jl_ir_symtab_t*)malloc_s(sizeof(jl_ir_symtab_t));
+        newt->hash = hash;
+        newt->syms = copy;
+        htable_new(&newt->index, n);
+        for (i = 0; i < n; i++)
+            ptrhash_put(&newt->index, jl_array_ptr_ref(copy, i), (void*)(i + 2));
+        JL_LOCK_NOGC(&ir_symtab_lock);
+        t = ir_symtab_find(hash);
+        if (t == NULL) {
+            newt->next = jl_atomic_load_relaxed(&ir_symtab_registry);
+            jl_atomic_store_release(&ir_symtab_registry, newt);
+            t = newt;
+            newt = NULL;
+        }
+        JL_UNLOCK_NOGC(&ir_symtab_lock);
+        if (newt != NULL) { // lost the race to an identical table
+            htable_free(&newt->index);
+            free(newt);
+        }
+    }
+    if (make_current)
+        jl_atomic_store_release(&ir_symtab_current, t);
+}
+
+typedef struct {
+    jl_sym_t *sym;
+    size_t count;
+} ir_symbol_count_t;
+
+static int ir_symbol_count_cmp(const void *a, const void *b)
+{
+    size_t ca = ((const ir_symbol_count_t*)a)->count;
+    size_t cb = ((const ir_symbol_count_t*)b)->count;
+    return ca < cb ? 1 : ca > cb ? -1 : 0;
+}
+
+// Return the symbols that most often missed the short encodings while this
+// process compressed IR, hottest first (at most `max` of them). Empty unless
+// JULIA_PKGIMAGE_SYMTAB is set.
+JL_DLLEXPORT jl_array_t *jl_ir_symbol_candidates(size_t max)
+{
+    JL_LOCK_NOGC(&ir_symtab_lock);
+    size_t i, n = 0;
+    ir_symbol_count_t *counts = (ir_symbol_count_t*)malloc_s(
+            (ir_symbol_freq.size / 2 + 1) * sizeof(ir_symbol_count_t));
+    for (i = 0; i < ir_symbol_freq.size; i += 2) {
+        if (ir_symbol_freq.table[i + 1] != HT_NOTFOUND) {
+            counts[n].sym = (jl_sym_t*)ir_symbol_freq.table[i];
+            counts[n].count = (size_t)ir_symbol_freq.table[i + 1] - 1;
+            n++;
+        }
+    }
+    JL_UNLOCK_NOGC(&ir_symtab_lock);
+    qsort(counts, n, sizeof(ir_symbol_count_t), ir_symbol_count_cmp);
+    if (n > max)
+        n = max;
+    jl_array_t *syms = jl_alloc_vec_any(n);
+    for (i = 0; i < n; i++)
+        jl_array_ptr_set(syms, i, (jl_value_t*)counts[i].sym);
+    free(counts);
+    return syms;
+}
+
+// Append the symbol table new IR is currently compressed against (if any) to
+// an incremental image stream, as a count followed by the symbol names.
+void jl_write_ir_symtab(ios_t *f)
+{
+    jl_ir_symtab_t *t = jl_atomic_load_acquire(&ir_symtab_current);
+    size_t i, n = t == NULL ? 0 : jl_array_nrows(t->syms);
+    write_uint32(f, n);
+    for (i = 0; i < n; i++) {
+        char *name = jl_symbol_name((jl_sym_t*)jl_array_ptr_ref(t->syms, i));
+        size_t l = strlen(name);
+        write_uint32(f, l);
+        ios_write(f, name, l);
+    }
+}
+
+// Inverse of jl_write_ir_symtab: register the table carried by an incremental
+// image so its method IR can be decompressed in this process.
+void jl_read_ir_symtab(ios_t *f)
+{
+    size_t i, n = read_uint32(f);
+    if (n == 0)
+        return;
+    if (n > IR_SYMTAB_MAX_SYMS)
+        jl_error("corrupt image: invalid IR symbol table");
+    jl_array_t *syms = jl_alloc_vec_any(n);
+    JL_GC_PUSH1(&syms);
+    for (i = 0; i < n; i++) {
+        size_t l = read_uint32(f);
+        char buf[256];
+        char *name = l <= sizeof(buf) ? buf : (char*)malloc_s(l);
+        ios_readall(f, name, l);
+        jl_array_ptr_set(syms, i, (jl_value_t*)jl_symbol_n(name, l));
+        if (name != buf)
+            free(name);
+    }
+    jl_install_ir_symbol_table(syms, 0);
+    JL_GC_POP();
+}
+
 // --- encoding ---
 
 static void jl_encode_value_(jl_ircode_state *s, jl_value_t *v, int as_literal) JL_GC_DISABLED;
@@ -104,6 +304,8 @@ static void jl_encode_as_indexed_root(jl_ircode_state *s, jl_value_t *v)
 {
     rle_reference rr;
 
+    if (jl_is_symbol(v) && ir_symtab_enabled())
+        ir_symtab_count_miss((jl_sym_t*)v);
     if (jl_is_string(v))
         v = jl_as_global_root(v, 1);
     literal_val_id(&rr, s, v);
@@ -182,6 +384,11 @@ static void jl_encode_value_(jl_ircode_state *s, jl_value_t *v, int as_literal)
         write_uint8(s->s, TAG_COMMONSYM);
         write_uint8(s->s, (uint8_t)(size_t)tag);
     }
+    else if (jl_is_symbol(v) && s->symtab != NULL &&
+             (tag = ptrhash_get(&s->symtab->index, v)) != HT_NOTFOUND) {
+        write_uint8(s->s, TAG_DYNAMICSYM);
+        write_uint8(s->s, (uint8_t)((size_t)tag - 2));
+    }
     else if (v == (jl_value_t*)jl_core_module) {
         write_uint8(s->s, TAG_CORE);
     }
@@ -191,9 +398,28 @@ static void jl_encode_value_(jl_ircode_state *s, jl_value_t *v, int as_literal)
     else if (jl_typetagis(v, jl_string_tag << 4) && jl_string_len(v) == 0) {
         jl_encode_value(s, jl_an_empty_string);
     }
-    else if (v == (jl_value_t*)s->method->module) {
+    else if (s->method && v == (jl_value_t*)s->method->module) {
         write_uint8(s->s, TAG_NEARBYMODULE);
     }
+    else if (s->method == NULL && jl_is_symbol(v)) {
+        // standalone mode (no method roots): write the symbol name inline
+        size_t l = strlen(jl_symbol_name((jl_sym_t*)v));
+        if (l <= 255) {
+            write_uint8(s->s, TAG_SYMBOL);
+            write_uint8(s->s, (uint8_t)l);
+        }
+        else {
+            write_uint8(s->s, TAG_LONG_SYMBOL);
+            write_int32(s->s, l);
+        }
+        ios_write(s->s, jl_symbol_name((jl_sym_t*)v), l);
+    }
+    else if (s->method == NULL && jl_is_datatype(v) && ((jl_datatype_t*)v)->name->wrapper == v) {
+        // standalone mode: refer to a plain nominal type by name
+        write_uint8(s->s, TAG_DATATYPE);
+        jl_encode_value(s, ((jl_datatype_t*)v)->name->module);
+        jl_encode_value(s, ((jl_datatype_t*)v)->name->name);
+    }
     else if (jl_is_datatype(v) && ((jl_datatype_t*)v)->name == jl_array_typename &&
              jl_is_long(jl_tparam1(v)) && jl_unbox_long(jl_tparam1(v)) == 1 &&
              !((jl_datatype_t*)v)->hasfreetypevars) {
@@ -220,7 +446,7 @@ static void jl_encode_value_(jl_ircode_state *s, jl_value_t *v, int as_literal)
         }
     }
     else if (jl_is_globalref(v)) {
-        if (jl_globalref_mod(v) == s->method->module) {
+        if (s->method && jl_globalref_mod(v) == s->method->module) {
             write_uint8(s->s, TAG_NEARBYGLOBAL);
             jl_encode_value(s, jl_globalref_name(v));
         }
@@ -452,6 +678,20 @@ static void jl_encode_value_(jl_ircode_state *s, jl_value_t *v, int as_literal)
         if (ptr > last)
             ios_write(s->s, last, ptr - last);
     }
+    else if (s->method == NULL) {
+        // standalone mode: there is no roots array to point into, so inline
+        // plain data values and flag anything else (modules, parameterized
+        // types, closures, ...) so the caller can discard the stream
+        jl_datatype_t *t = (jl_datatype_t*)jl_typeof(v);
+        if (!jl_is_type(v) && !jl_is_module(v) && !jl_is_typevar(v) &&
+            t->layout && !jl_is_layout_opaque(t->layout)) {
+            jl_encode_value_(s, v, 1);
+        }
+        else {
+            s->relocatability = 0;
+            write_uint8(s->s, TAG_NULL);
+        }
+    }
     else {
         jl_encode_as_indexed_root(s, v);
     }
@@ -691,6 +931,27 @@ static jl_value_t *jl_decode_value(jl_ircode_state *s) JL_GC_DISABLED
         return jl_decode_value_svec(s, tag);
     case TAG_COMMONSYM:
         return jl_deser_symbol(read_uint8(s->s));
+    case TAG_DYNAMICSYM: {
+        size_t i = read_uint8(s->s);
+        assert(s->symtab != NULL && i < jl_array_nrows(s->symtab->syms));
+        return jl_array_ptr_ref(s->symtab->syms, i);
+    }
+    case TAG_SYMBOL: JL_FALLTHROUGH; case TAG_LONG_SYMBOL: {
+        n = (tag == TAG_SYMBOL ? read_uint8(s->s) : (size_t)read_int32(s->s));
+        char buf[256];
+        char *name = n <= sizeof(buf) ? buf : (char*)malloc_s(n);
+        ios_readall(s->s, name, n);
+        v = (jl_value_t*)jl_symbol_n(name, n);
+        if (name != buf)
+            free(name);
+        return v;
+    }
+    case TAG_DATATYPE: {
+        // written only in standalone mode: a plain nominal type by name
+        jl_value_t *mod = jl_decode_value(s);
+        jl_value_t *name = jl_decode_value(s);
+        return jl_get_global((jl_module_t*)mod, (jl_sym_t*)name);
+    }
     case TAG_SSAVALUE:
         v = jl_box_ssavalue(read_uint8(s->s));
         return v;
@@ -802,6 +1063,165 @@ typedef enum {
     ir_offset_slotflags     = 0 + IR_DATASIZE_FLAGS + IR_DATASIZE_PURITY + IR_DATASIZE_INLINING_COST + IR_DATASIZE_NSLOTS
 } ir_offset;
 
+// --- compression of the encoded stream ---
+//
+// The variable-length part of the blob (everything after the fixed-layout header
+// that the jl_ir_* accessors peek at, and before the trailing relocatability byte
+// that codegen reads directly) is stored behind a one-byte encoding marker:
+// 0 means the encoded stream follows verbatim, 1 means a 4-byte decompressed size
+// followed by an LZ77-compressed copy of it. The compressed stream is a sequence
+// of sequences: a token whose high nibble is the literal-run length and whose low
+// nibble is the match length minus IR_LZ_MIN_MATCH (each saturating at 15 and
+// extended by 255-continuation bytes), the literals themselves, and a 2-byte
+// little-endian offset into the previous 64K of output. The final sequence is
+// literals only, terminated by exhausting the input. The common-symbol and
+// core-type tag tables already act as the shared dictionary for the encoded
+// stream, so the match finder only has to pick up method-local repetition.
+
+#define IR_LZ_MIN_MATCH 4
+#define IR_LZ_HASH_BITS 12
+// don't bother compressing tiny bodies; they are dominated by the header anyway
+#define IR_COMPRESS_THRESHOLD 128
+
+static uint32_t ir_lz_hash(const uint8_t *p) JL_NOTSAFEPOINT
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - IR_LZ_HASH_BITS);
+}
+
+// greedy hash-table match finder; returns the compressed size, or 0 if the
+// result would not fit in `cap` (in which case the body is stored verbatim)
+static size_t ir_lz_compress(const uint8_t *src, size_t n, uint8_t *dst, size_t cap) JL_NOTSAFEPOINT
+{
+    uint32_t table[1 << IR_LZ_HASH_BITS];
+    if (n < IR_LZ_MIN_MATCH + 1)
+        return 0;
+    memset(table, 0, sizeof(table));
+    const uint8_t *iend = src + n;
+    const uint8_t *mflimit = iend - IR_LZ_MIN_MATCH;
+    const uint8_t *ip = src + 1; // offset 0 doubles as the empty table entry
+    const uint8_t *anchor = src;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + cap;
+    while (ip < mflimit) {
+        uint32_t h = ir_lz_hash(ip);
+        const uint8_t *match = src + table[h];
+        table[h] = (uint32_t)(ip - src);
+        if (match == src || ip - match > 0xFFFF || memcmp(match, ip, IR_LZ_MIN_MATCH) != 0) {
+            ip++;
+            continue;
+        }
+        const uint8_t *mp = match + IR_LZ_MIN_MATCH;
+        const uint8_t *cp = ip + IR_LZ_MIN_MATCH;
+        while (cp < iend && *mp == *cp) {
+            mp++;
+            cp++;
+        }
+        size_t litlen = ip - anchor;
+        size_t m = (cp - ip) - IR_LZ_MIN_MATCH;
+        if ((size_t)(oend - op) < 1 + litlen / 255 + 1 + litlen + 2 + m / 255 + 1)
+            return 0;
+        uint8_t *token = op++;
+        size_t l = litlen;
+        *token = (l < 15 ? l : 15) << 4;
+        if (l >= 15) {
+            l -= 15;
+            while (l >= 255) {
+                *op++ = 255;
+                l -= 255;
+            }
+            *op++ = (uint8_t)l;
+        }
+        memcpy(op, anchor, litlen);
+        op += litlen;
+        uint16_t off = (uint16_t)(ip - match);
+        *op++ = off & 0xFF;
+        *op++ = off >> 8;
+        *token |= (m < 15 ? m : 15);
+        if (m >= 15) {
+            m -= 15;
+            while (m >= 255) {
+                *op++ = 255;
+                m -= 255;
+            }
+            *op++ = (uint8_t)m;
+        }
+        ip = cp;
+        anchor = ip;
+    }
+    size_t litlen = iend - anchor;
+    if ((size_t)(oend - op) < 1 + litlen / 255 + 1 + litlen)
+        return 0;
+    uint8_t *token = op++;
+    size_t l = litlen;
+    *token = (l < 15 ? l : 15) << 4;
+    if (l >= 15) {
+        l -= 15;
+        while (l >= 255) {
+            *op++ = 255;
+            l -= 255;
+        }
+        *op++ = (uint8_t)l;
+    }
+    memcpy(op, anchor, litlen);
+    op += litlen;
+    return op - dst;
+}
+
+// returns 1 on success; 0 indicates a corrupt stream
+static int ir_lz_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t rawlen) JL_NOTSAFEPOINT
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + n;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + rawlen;
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t l = token >> 4;
+        if (l == 15) {
+            uint8_t c;
+            do {
+                if (ip >= iend)
+                    return 0;
+                c = *ip++;
+                l += c;
+            } while (c == 255);
+        }
+        if (l > (size_t)(iend - ip) || l > (size_t)(oend - op))
+            return 0;
+        memcpy(op, ip, l);
+        op += l;
+        ip += l;
+        if (ip == iend)
+            break; // final sequence carries no match
+        if (iend - ip < 2)
+            return 0;
+        size_t off = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (off == 0 || off > (size_t)(op - dst))
+            return 0;
+        size_t m = token & 15;
+        if (m == 15) {
+            uint8_t c;
+            do {
+                if (ip >= iend)
+                    return 0;
+                c = *ip++;
+                m += c;
+            } while (c == 255);
+        }
+        m += IR_LZ_MIN_MATCH;
+        if (m > (size_t)(oend - op))
+            return 0;
+        const uint8_t *mp = op - off;
+        for (size_t k = 0; k < m; k++) // may overlap; must copy forwards
+            op[k] = mp[k];
+        op += m;
+    }
+    return op == oend;
+}
+
 JL_DLLEXPORT jl_string_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
 {
     JL_TIMING(AST_COMPRESS, AST_COMPRESS);
@@ -821,7 +1241,8 @@ JL_DLLEXPORT jl_string_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
         &dest,
         m,
         jl_current_task->ptls,
-        1
+        1,
+        jl_atomic_load_acquire(&ir_symtab_current)
     };
 
     jl_code_info_flags_t flags = code_info_flags(code->inferred, code->propagate_inbounds, code->has_fcall,
@@ -843,6 +1264,11 @@ JL_DLLEXPORT jl_string_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
     // by the various jl_ir_ accessors. Make sure to adjust those if you change
     // the data layout.
 
+    // adaptive symbol table reference (must match jl_uncompress_ir)
+    write_uint8(s.s, s.symtab != NULL);
+    if (s.symtab != NULL)
+        write_uint64(s.s, s.symtab->hash);
+
     for (i = 0; i < 6; i++) {
         int copy = 1;
         if (i == 1) { // skip codelocs
@@ -886,7 +1312,35 @@ JL_DLLEXPORT jl_string_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
     write_uint8(s.s, s.relocatability);
 
     ios_flush(s.s);
-    jl_string_t *v = jl_pchar_to_string(s.s->buf, s.s->size);
+    // compress the encoded body, keeping the fixed-layout header and the
+    // trailing relocatability byte directly accessible (see above)
+    size_t header_size = ir_offset_slotflags + nslots;
+    size_t body_size = s.s->size - header_size - 1;
+    jl_string_t *v = NULL;
+    if (body_size >= IR_COMPRESS_THRESHOLD && body_size < UINT32_MAX) {
+        // only worthwhile if it saves more than ~6% of the body
+        uint8_t *cbuf = (uint8_t*)malloc_s(body_size);
+        size_t csize = ir_lz_compress((uint8_t*)s.s->buf + header_size, body_size,
+                                      cbuf, body_size - body_size / 16);
+        if (csize != 0) {
+            uint32_t rawlen = (uint32_t)body_size;
+            v = jl_alloc_string(header_size + 1 + sizeof(rawlen) + csize + 1);
+            char *vdata = jl_string_data(v);
+            memcpy(vdata, s.s->buf, header_size);
+            vdata[header_size] = 1; // compressed body
+            memcpy(vdata + header_size + 1, &rawlen, sizeof(rawlen));
+            memcpy(vdata + header_size + 1 + sizeof(rawlen), cbuf, csize);
+            vdata[header_size + 1 + sizeof(rawlen) + csize] = (char)s.relocatability;
+        }
+        free(cbuf);
+    }
+    if (v == NULL) {
+        v = jl_alloc_string(s.s->size + 1);
+        char *vdata = jl_string_data(v);
+        memcpy(vdata, s.s->buf, header_size);
+        vdata[header_size] = 0; // stored body
+        memcpy(vdata + header_size + 1, s.s->buf + header_size, s.s->size - header_size);
+    }
     ios_close(s.s);
     if (jl_array_nrows(m->roots) == 0) {
         m->roots = NULL;
@@ -917,7 +1371,8 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
         &src,
         m,
         jl_current_task->ptls,
-        1
+        1,
+        NULL
     };
 
     jl_code_info_t *code = jl_new_code_info_uninit();
@@ -936,6 +1391,30 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     code->slotflags = jl_alloc_array_1d(jl_array_uint8_type, nslots);
     ios_readall(s.s, jl_array_data(code->slotflags, char), nslots);
 
+    // body encoding marker (see jl_compress_ir)
+    uint8_t encoding = read_uint8(s.s);
+    ios_t body;
+    uint8_t *rawbuf = NULL;
+    if (encoding) {
+        uint32_t rawlen;
+        ios_readall(s.s, (char*)&rawlen, sizeof(rawlen));
+        size_t csize = jl_string_len(data) - src.bpos - 1; // trailing relocatability byte
+        rawbuf = (uint8_t*)malloc_s(rawlen);
+        if (!ir_lz_decompress((uint8_t*)jl_string_data(data) + src.bpos, csize, rawbuf, rawlen))
+            abort(); // corrupt compressed code info
+        ios_mem(&body, 0);
+        ios_setbuf(&body, (char*)rawbuf, rawlen, 0);
+        body.size = rawlen;
+        s.s = &body;
+    }
+
+    // adaptive symbol table reference (see jl_compress_ir)
+    if (read_uint8(s.s)) {
+        s.symtab = ir_symtab_find(read_uint64(s.s));
+        if (s.symtab == NULL)
+            abort(); // IR references a symbol table missing from this process
+    }
+
     for (i = 0; i < 6; i++) {
         if (i == 1)  // skip codelocs
             continue;
@@ -967,10 +1446,17 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
         ios_readall(s.s, (char*)jl_array_data(code->codelocs, int32_t), nstmt * sizeof(int32_t));
     }
 
-    (void) read_uint8(s.s);   // relocatability
-
-    assert(ios_getc(s.s) == -1);
-    ios_close(s.s);
+    if (encoding) {
+        // the relocatability byte stays outside the compressed body
+        assert(ios_getc(s.s) == -1);
+        ios_close(&body);
+        free(rawbuf);
+    }
+    else {
+        (void) read_uint8(s.s);   // relocatability
+        assert(ios_getc(s.s) == -1);
+    }
+    ios_close(&src);
     JL_GC_PUSH1(&code);
     jl_gc_enable(en);
     JL_UNLOCK(&m->writelock); // Might GC
@@ -985,6 +1471,56 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     return code;
 }
 
+// Serialize an arbitrary expression tree (e.g. a parse result) into a byte
+// string. Unlike `jl_compress_ir` this requires no enclosing method to hold
+// literal values: symbols, strings and plain data are all stored inline.
+// Returns NULL if `ast` contains a value that cannot be represented
+// standalone (modules, closures, parameterized types, ...).
+JL_DLLEXPORT jl_value_t *jl_compress_ast(jl_value_t *ast)
+{
+    ios_t dest;
+    ios_mem(&dest, 0);
+    int en = jl_gc_enable(0);
+    jl_ircode_state s = {
+        &dest,
+        NULL,
+        jl_current_task->ptls,
+        1,
+        NULL
+    };
+    jl_encode_value(&s, ast);
+    jl_value_t *v = NULL;
+    if (s.relocatability) {
+        ios_flush(s.s);
+        v = jl_pchar_to_string(s.s->buf, s.s->size);
+    }
+    ios_close(s.s);
+    JL_GC_PUSH1(&v);
+    jl_gc_enable(en);
+    JL_GC_POP();
+    return v;
+}
+
+JL_DLLEXPORT jl_value_t *jl_uncompress_ast(const char *data, size_t len)
+{
+    ios_t src;
+    ios_static_buffer(&src, (char*)data, len);
+    int en = jl_gc_enable(0);
+    jl_ircode_state s = {
+        &src,
+        NULL,
+        jl_current_task->ptls,
+        1,
+        NULL
+    };
+    jl_value_t *v = jl_decode_value(&s);
+    ios_close(&src);
+    JL_GC_PUSH1(&v);
+    jl_gc_enable(en);
+    JL_GC_POP();
+    return v;
+}
+
 JL_DLLEXPORT uint8_t jl_ir_flag_inferred(jl_string_t *data)
 {
     if (jl_is_code_info(data))
@@ -1122,6 +1658,7 @@ void jl_init_serializer(void)
     jl_task_t *ct = jl_current_task;
     htable_new(&ser_tag, 0);
     htable_new(&common_symbol_tag, 0);
+    htable_new(&ir_symbol_freq, 0);
 
     void *vals[] = { jl_emptysvec, jl_emptytuple, jl_false, jl_true, jl_nothing, jl_any_type,
                      jl_call_sym, jl_invoke_sym, jl_invoke_modify_sym, jl_goto_ifnot_sym, jl_return_sym, jl_symbol("tuple"),
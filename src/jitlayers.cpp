@@ -4,9 +4,13 @@
 #include "platform.h"
 #include <stdint.h>
 #include <sstream>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 #include "llvm/IR/Mangler.h"
 #include <llvm/ADT/Statistic.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
@@ -17,7 +21,11 @@
 #include <llvm/ExecutionEngine/Orc/ExecutorProcessControl.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -53,6 +61,7 @@ STATISTIC(CompiledCodeinsts, "Number of codeinsts compiled directly");
 STATISTIC(MaxWorkqueueSize, "Maximum number of elements in the workqueue");
 STATISTIC(IndirectCodeinsts, "Number of dependent codeinsts compiled");
 STATISTIC(SpecFPtrCount, "Number of specialized function pointers compiled");
+STATISTIC(ReoptFPtrCount, "Number of code instances re-optimized in the background");
 STATISTIC(UnspecFPtrCount, "Number of specialized function pointers compiled");
 STATISTIC(ModulesAdded, "Number of modules added to the JIT");
 STATISTIC(ModulesOptimized, "Number of modules optimized by the JIT");
@@ -62,6 +71,8 @@ STATISTIC(OptO2, "Number of modules optimized at level -O2");
 STATISTIC(OptO3, "Number of modules optimized at level -O3");
 STATISTIC(ModulesMerged, "Number of modules merged");
 STATISTIC(InternedGlobals, "Number of global constants interned in the string pool");
+STATISTIC(JITCacheHits, "Number of modules loaded from the on-disk JIT object cache");
+STATISTIC(JITCacheMisses, "Number of modules compiled and stored in the on-disk JIT object cache");
 
 #ifdef _COMPILER_MSAN_ENABLED_
 // TODO: This should not be necessary on ELF x86_64, but LLVM's implementation
@@ -127,6 +138,44 @@ void jl_dump_llvm_opt_impl(void *s)
     **jl_ExecutionEngine->get_dump_llvm_opt_stream() = (ios_t*)s;
 }
 
+// Per-code-instance compilation cost accounting: while compile-time
+// measurement is enabled (jl_cumulative_compile_time_ns), we additionally
+// remember how long each code instance took to emit and JIT, so the most
+// expensive compilations can be reported afterwards instead of only one
+// global total. Protected by jl_codegen_lock.
+static DenseMap<jl_code_instance_t*, uint64_t> jl_compile_cost_ns;
+
+// Return up to `n` svec(codeinst, time_ns) pairs for the most expensive
+// compilations recorded so far, sorted by decreasing cost. The raw codeinst
+// pointers stay valid because every compiled code instance remains reachable
+// from its method instance's cache list.
+extern "C" JL_DLLEXPORT_CODEGEN
+jl_value_t *jl_compile_cost_report_impl(size_t n)
+{
+    SmallVector<std::pair<jl_code_instance_t*, uint64_t>, 0> costs;
+    JL_LOCK(&jl_codegen_lock);
+    costs.reserve(jl_compile_cost_ns.size());
+    for (auto &kv : jl_compile_cost_ns)
+        costs.push_back(std::make_pair(kv.first, kv.second));
+    JL_UNLOCK(&jl_codegen_lock);
+    std::sort(costs.begin(), costs.end(),
+              [](const std::pair<jl_code_instance_t*, uint64_t> &a,
+                 const std::pair<jl_code_instance_t*, uint64_t> &b) { return a.second > b.second; });
+    if (n < costs.size())
+        costs.truncate(n);
+    jl_array_t *a = NULL;
+    jl_value_t *t = NULL, *pair = NULL;
+    JL_GC_PUSH3(&a, &t, &pair);
+    a = jl_alloc_vec_any(0);
+    for (auto &kv : costs) {
+        t = jl_box_uint64(kv.second);
+        pair = (jl_value_t*)jl_svec2((jl_value_t*)kv.first, t);
+        jl_array_ptr_1d_push(a, pair);
+    }
+    JL_GC_POP();
+    return (jl_value_t*)a;
+}
+
 static int jl_add_to_ee(
         orc::ThreadSafeModule &M,
         const StringMap<orc::ThreadSafeModule*> &NewExports,
@@ -188,13 +237,15 @@ static jl_callptr_t _jl_compile_codeinst(
         jl_code_info_t *src,
         size_t world,
         orc::ThreadSafeContext context,
-        bool is_recompile)
+        bool is_recompile,
+        bool is_reopt=false)
 {
     // caller must hold codegen_lock
     // and have disabled finalizers
     uint64_t start_time = 0;
     bool timed = !!*jl_ExecutionEngine->get_dump_compiles_stream();
-    if (timed)
+    bool cost_timed = jl_atomic_load_relaxed(&jl_measure_compile_time_enabled);
+    if (timed || cost_timed)
         start_time = jl_hrtime();
 
     assert(jl_is_code_instance(codeinst));
@@ -214,6 +265,8 @@ static jl_callptr_t _jl_compile_codeinst(
     params.world = world;
     params.imaging_mode = imaging_default();
     params.debug_level = jl_options.debug_level;
+    if (jl_options.compile_enabled == JL_OPTIONS_COMPILE_TIERED && !jl_generating_output())
+        params.tier_optlevel = is_reopt ? TIER2_OPT_LEVEL : TIER1_OPT_LEVEL;
     {
         orc::ThreadSafeModule result_m =
             jl_create_ts_module(name_from_method_instance(codeinst->def), params.tsctx, params.DL, params.TargetTriple);
@@ -303,7 +356,17 @@ static jl_callptr_t _jl_compile_codeinst(
             addr = (jl_callptr_t)getAddressForFunction(decls.functionObject);
             isspecsig = true;
         }
-        if (!decls.specFunctionObject.empty()) {
+        if (is_reopt && this_code == codeinst && !decls.specFunctionObject.empty()) {
+            // re-optimization of already-published code: the specsig decision
+            // is a pure function of the signature and rettype, so the new
+            // entry points implement the same ABI as the old ones and can
+            // replace them unconditionally; concurrent callers may observe
+            // either version
+            auto spec = (void*)getAddressForFunction(decls.specFunctionObject);
+            jl_atomic_store_release(&this_code->specptr.fptr, spec);
+            jl_atomic_store_release(&this_code->invoke, addr);
+        }
+        else if (!decls.specFunctionObject.empty()) {
             void *prev_specptr = NULL;
             auto spec = (void*)getAddressForFunction(decls.specFunctionObject);
             if (jl_atomic_cmpswap_acqrel(&this_code->specptr.fptr, &prev_specptr, spec)) {
@@ -337,8 +400,14 @@ static jl_callptr_t _jl_compile_codeinst(
         jl_timing_printf(JL_TIMING_DEFAULT_BLOCK, "... <%d methods truncated>", i - 10);
 
     uint64_t end_time = 0;
-    if (timed)
+    if (timed || cost_timed)
         end_time = jl_hrtime();
+    if (cost_timed) {
+        // attribute the whole emission (including any workqueue dependencies
+        // compiled along the way) to the requested code instance; the caller
+        // holds codegen_lock, which serializes this with jl_compile_cost_report
+        jl_compile_cost_ns[codeinst] += end_time - start_time;
+    }
 
     // If logging of the compilation stream is enabled,
     // then dump the method-instance specialization type to the stream
@@ -605,6 +674,112 @@ void jl_generate_fptr_for_unspecialized_impl(jl_code_instance_t *unspec)
     }
 }
 
+// --- background compilation queue (`--compile=tiered`) ---
+
+// Compile requests are decoupled from the thread that issued them: a hot
+// tier-0 instance is enqueued here and the requesting thread keeps
+// interpreting while a dedicated compiler thread runs inference, codegen and
+// the engine lock on its behalf. The same queue carries re-optimization
+// requests: instances promoted out of the interpreter are first compiled at
+// TIER1_OPT_LEVEL to keep the pause short, then recompiled at TIER2_OPT_LEVEL
+// with their published entry points replaced in place (see the is_reopt
+// branch of _jl_compile_codeinst). Queued instances are reachable through
+// their method instance's cache list, so the queue holds plain pointers
+// without rooting them separately.
+typedef struct {
+    jl_code_instance_t *codeinst;
+    // 0 = initial compile of a promoted tier-0 instance, 1 = re-optimization
+    int reopt;
+} jl_compile_request_t;
+static std::mutex compile_queue_mutex;
+static std::condition_variable compile_queue_cond;
+static std::deque<jl_compile_request_t> compile_queue;
+static bool compile_worker_running = false;
+
+static void jl_reoptimize_codeinst(jl_code_instance_t *codeinst)
+{
+    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    if (codeinst->min_world > world ||
+        (codeinst->max_world < world && codeinst->max_world != 0))
+        return; // invalidated since it was enqueued; not worth re-optimizing
+    jl_code_info_t *src = NULL;
+    JL_GC_PUSH1(&src);
+    JL_LOCK(&jl_codegen_lock); // also disables finalizers, to prevent any unexpected recursion
+    src = (jl_code_info_t*)jl_atomic_load_relaxed(&codeinst->inferred);
+    if ((jl_value_t*)src == jl_nothing)
+        src = NULL;
+    else if (src && jl_is_method(codeinst->def->def.method))
+        src = jl_uncompress_ir(codeinst->def->def.method, codeinst, (jl_value_t*)src);
+    if (src == NULL && jl_is_method(codeinst->def->def.method)) {
+        // the inferred IR was dropped after the first compile; re-infer it
+        src = jl_type_infer(codeinst->def, world, 0);
+    }
+    if (src && jl_is_code_info(src)) {
+        ++ReoptFPtrCount;
+        _jl_compile_codeinst(codeinst, src, world, *jl_ExecutionEngine->getContext(),
+                             /*is_recompile*/true, /*is_reopt*/true);
+    }
+    JL_UNLOCK(&jl_codegen_lock); // Might GC
+    JL_GC_POP();
+}
+
+static void jl_compile_queue_threadfun(void *arg)
+{
+    (void)arg;
+    jl_adopt_thread();
+    jl_task_t *ct = jl_current_task;
+    jl_ptls_t ptls = ct->ptls;
+    while (1) {
+        jl_compile_request_t req = {NULL, 0};
+        int8_t gc_state = jl_gc_safe_enter(ptls);
+        {
+            std::unique_lock<std::mutex> lock(compile_queue_mutex);
+            while (compile_queue.empty())
+                compile_queue_cond.wait(lock);
+            req = compile_queue.front();
+            compile_queue.pop_front();
+        }
+        jl_gc_safe_leave(ptls, gc_state);
+        ct->world_age = jl_atomic_load_acquire(&jl_world_counter);
+        JL_TRY {
+            if (req.reopt)
+                jl_reoptimize_codeinst(req.codeinst);
+            else
+                jl_tier0_promote(req.codeinst);
+        }
+        JL_CATCH {
+            // compilation is best effort; the requester keeps interpreting
+            // (or keeps the first-tier code, for a re-optimization request)
+        }
+    }
+}
+
+static void jl_enqueue_compile_request(jl_code_instance_t *codeinst, int reopt)
+{
+    std::unique_lock<std::mutex> lock(compile_queue_mutex);
+    if (!compile_worker_running) {
+        uv_thread_t tid;
+        if (uv_thread_create(&tid, jl_compile_queue_threadfun, NULL) != 0)
+            return; // no worker; stay at the current tier
+        compile_worker_running = true;
+    }
+    compile_queue.push_back(jl_compile_request_t{codeinst, reopt});
+    lock.unlock();
+    compile_queue_cond.notify_one();
+}
+
+extern "C" JL_DLLEXPORT_CODEGEN
+void jl_enqueue_tier0_promotion_impl(jl_code_instance_t *codeinst)
+{
+    jl_enqueue_compile_request(codeinst, 0);
+}
+
+extern "C" JL_DLLEXPORT_CODEGEN
+void jl_enqueue_reoptimization_impl(jl_code_instance_t *codeinst)
+{
+    jl_enqueue_compile_request(codeinst, 1);
+}
+
 
 // get a native disassembly for a compiled method
 extern "C" JL_DLLEXPORT_CODEGEN
@@ -744,6 +919,25 @@ static Expected<orc::ThreadSafeModule> selectOptLevel(orc::ThreadSafeModule TSM,
                 opt_level = 0;
                 break;
             }
+            // a tiered-compilation batch carries its own level (see
+            // jl_codegen_params_t::tier_optlevel), which takes precedence
+            // over the process level and per-module annotations
+            bool tiered = false;
+            for (auto &F : M) {
+                if (!F.isDeclaration()) {
+                    Attribute attr = F.getFnAttribute("julia-tier-optlevel");
+                    StringRef val = attr.getValueAsString();
+                    if (val != "") {
+                        opt_level = (size_t)val[0] - '0';
+                        tiered = true;
+                    }
+                    // the attribute is uniform across a batch; the first
+                    // definition decides
+                    break;
+                }
+            }
+            if (tiered)
+                break;
             size_t opt_level_min = std::max(static_cast<int>(jl_options.opt_level_min), 0);
             for (auto &F : M) {
                 if (!F.isDeclaration()) {
@@ -1268,6 +1462,58 @@ namespace {
         }
     };
 
+    // Reorder the module's function list along the static call graph before
+    // emission. Functions are emitted — and their memory handed out by the
+    // JIT memory manager — in module order, so a preorder walk that places
+    // each callee right after its first caller keeps hot call chains on the
+    // same pages instead of scattering them in compilation order. Functions
+    // marked cold (the throw paths outlined by the hot-cold-splitting pass,
+    // plus anything else the optimizer proved cold) sink to the end, off the
+    // pages the common paths touch.
+    static void layoutFunctionsForEmission(Module &M) JL_NOTSAFEPOINT
+    {
+        SmallVector<Function *, 16> order;
+        SmallVector<Function *, 16> cold;
+        SmallVector<Function *, 8> stack;
+        SmallPtrSet<Function *, 16> visited;
+        for (auto &Root : M.functions()) {
+            if (Root.isDeclaration() || !visited.insert(&Root).second)
+                continue;
+            stack.push_back(&Root);
+            while (!stack.empty()) {
+                Function *F = stack.pop_back_val();
+                if (F->hasFnAttribute(Attribute::Cold)) {
+                    // don't pull this function's callees into the hot
+                    // prefix; if they are only reachable from cold code
+                    // they are taken as roots later and stay grouped here
+                    cold.push_back(F);
+                    continue;
+                }
+                order.push_back(F);
+                // gather the direct callees in source order; pushing them
+                // in reverse keeps the preorder walk left to right
+                SmallVector<Function *, 8> callees;
+                for (auto &BB : *F) {
+                    for (auto &I : BB) {
+                        auto *CB = dyn_cast<CallBase>(&I);
+                        if (CB == nullptr)
+                            continue;
+                        Function *callee = CB->getCalledFunction();
+                        if (callee && !callee->isDeclaration() && visited.insert(callee).second)
+                            callees.push_back(callee);
+                    }
+                }
+                for (size_t i = callees.size(); i > 0; i--)
+                    stack.push_back(callees[i - 1]);
+            }
+        }
+        auto &list = M.getFunctionList();
+        for (Function *F : order)
+            list.splice(list.end(), list, F->getIterator());
+        for (Function *F : cold)
+            list.splice(list.end(), list, F->getIterator());
+    }
+
     template<size_t N>
     struct OptimizerT {
         OptimizerT(TargetMachine &TM, SmallVector<std::function<void()>, 0> &printers, std::mutex &llvm_printing_mutex) JL_NOTSAFEPOINT {
@@ -1318,6 +1564,8 @@ namespace {
                     //Run the optimization
                     (****PMs[PoolIdx]).run(M);
                     assert(!verifyLLVMIR(M));
+                    // lay the functions out for emission along the call graph
+                    layoutFunctionsForEmission(M);
                 }
 
                 {
@@ -1387,6 +1635,70 @@ namespace {
         std::array<std::unique_ptr<JuliaOJIT::ResourcePool<std::unique_ptr<PassManager>>>, N> PMs;
     };
 
+    // On-disk cache of compiled native objects, shared between processes and
+    // enabled by pointing JULIA_JIT_CACHE_PATH at a (pre-existing) directory.
+    // The cache is keyed by a hash of the module bitcode together with the
+    // target triple, cpu, feature string and optimization level. Hashing the
+    // bitcode (rather than the method instance) makes every hit sound: any
+    // process-specific state the module captures — notably runtime addresses
+    // embedded as integer constants — is part of the key, so workers only
+    // share entries when the emitted code would have been byte-identical
+    // anyway. That is the common case on homogeneous batch farms running the
+    // same sysimage with ASLR disabled, which is what this is for.
+    static const char *jit_object_cache_dir() JL_NOTSAFEPOINT
+    {
+        static const char *dir = getenv("JULIA_JIT_CACHE_PATH");
+        return dir && dir[0] ? dir : nullptr;
+    }
+
+    static void jit_object_cache_path(const Module &M, const TargetMachine &TM,
+                                      size_t optlevel, SmallVectorImpl<char> &path) JL_NOTSAFEPOINT
+    {
+        SmallVector<char, 0> bitcode;
+        raw_svector_ostream OS(bitcode);
+        WriteBitcodeToFile(M, OS);
+        SHA1 hasher;
+        hasher.update(ArrayRef<uint8_t>((uint8_t*)bitcode.data(), bitcode.size()));
+        hasher.update(TM.getTargetTriple().str());
+        hasher.update(TM.getTargetCPU());
+        hasher.update(TM.getTargetFeatureString());
+        hasher.update(ArrayRef<uint8_t>((uint8_t*)&optlevel, sizeof(optlevel)));
+        path.assign(jit_object_cache_dir(), jit_object_cache_dir() + strlen(jit_object_cache_dir()));
+        sys::path::append(path, "jl_" + toHex(hasher.final(), true) + ".o");
+    }
+
+    static std::unique_ptr<MemoryBuffer> jit_object_cache_lookup(ArrayRef<char> path) JL_NOTSAFEPOINT
+    {
+        auto buf = MemoryBuffer::getFile(StringRef(path.data(), path.size()),
+                                         /*IsText*/false, /*RequiresNullTerminator*/false);
+        if (!buf)
+            return nullptr;
+        ++JITCacheHits;
+        return std::move(*buf);
+    }
+
+    static void jit_object_cache_store(ArrayRef<char> path, const MemoryBuffer &obj) JL_NOTSAFEPOINT
+    {
+        // Write to a unique temporary and rename it into place so that
+        // concurrent workers never observe a partially written object.
+        SmallVector<char, 0> tmp;
+        int fd;
+        if (sys::fs::createUniqueFile(StringRef(path.data(), path.size()) + ".tmp%%%%%%", fd, tmp))
+            return;
+        {
+            raw_fd_ostream OS(fd, /*shouldClose*/true);
+            OS << obj.getBuffer();
+            if (OS.has_error()) {
+                OS.clear_error();
+                sys::fs::remove(tmp);
+                return;
+            }
+        }
+        if (sys::fs::rename(tmp, StringRef(path.data(), path.size())))
+            sys::fs::remove(tmp);
+        ++JITCacheMisses;
+    }
+
     template<size_t N>
     struct CompilerT : orc::IRCompileLayer::IRCompiler {
 
@@ -1406,7 +1718,18 @@ namespace {
                 PoolIdx = jl_options.opt_level;
             }
             assert(PoolIdx < N && "Invalid optimization level for compiler!");
-            return orc::SimpleCompiler(****TMs[PoolIdx])(M);
+            auto TM = **TMs[PoolIdx];
+            if (jit_object_cache_dir()) {
+                SmallVector<char, 128> path;
+                jit_object_cache_path(M, **TM, PoolIdx, path);
+                if (auto cached = jit_object_cache_lookup(path))
+                    return std::move(cached);
+                auto obj = orc::SimpleCompiler(**TM)(M);
+                if (obj)
+                    jit_object_cache_store(path, **obj);
+                return obj;
+            }
+            return orc::SimpleCompiler(**TM)(M);
         }
 
         std::array<std::unique_ptr<JuliaOJIT::ResourcePool<std::unique_ptr<TargetMachine>>>, N> TMs;
@@ -28,6 +28,11 @@
 #include "llvm-codegen-shared.h"
 #include <stack>
 #include <queue>
+#include <set>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 
 
 // As of LLVM 13, there are two runtime JIT linker implementations, the older
@@ -197,6 +202,20 @@ typedef SmallVector<std::pair<jl_code_instance_t*, jl_codegen_call_target_t>, 0>
 // TODO DenseMap?
 typedef std::map<jl_code_instance_t*, std::pair<orc::ThreadSafeModule, jl_llvm_functions_t>> jl_compiled_functions_t;
 
+// State shared between the threads emitting code for one jl_create_native
+// request. Emitted function names are globally unique, so a shard that needs
+// a code instance some other shard owns can simply reference it by name and
+// let the final link resolve the declaration, instead of emitting a duplicate
+// copy into its own module.
+struct jl_aot_shared_emission_t {
+    std::mutex lock;
+    std::condition_variable cond;
+    // function names for every code instance emitted so far
+    std::map<jl_code_instance_t*, jl_llvm_functions_t> decls;
+    // code instances currently being emitted by some shard
+    std::set<jl_code_instance_t*> inflight;
+};
+
 struct jl_codegen_params_t {
     orc::ThreadSafeContext tsctx;
     orc::ThreadSafeContext::Lock tsctx_lock;
@@ -232,6 +251,11 @@ struct jl_codegen_params_t {
     DenseMap<AttributeList, std::map<
         std::tuple<GlobalVariable*, FunctionType*, CallingConv::ID>,
         GlobalVariable*>> allPltMap;
+    // Cache of computed ccall ABI classifications, keyed by the globally
+    // rooted (return type, calling convention, flags, argument types...)
+    // tuple (see generate_func_sig in ccall.cpp). The lowered LLVM types are
+    // tied to tsctx, so this cannot be shared across emission batches.
+    std::map<std::vector<void*>, std::shared_ptr<const struct jl_abi_lowering_t>> ccall_abi_cache;
     std::unique_ptr<Module> _shared_module;
     inline Module &shared_module();
     // inputs
@@ -241,6 +265,11 @@ struct jl_codegen_params_t {
     bool external_linkage = false;
     bool imaging_mode;
     int debug_level;
+    // optimization level this batch was requested at by tiered compilation,
+    // or -1 to let selectOptLevel pick the process level
+    int tier_optlevel = -1;
+    // set when several threads share one jl_create_native emission
+    jl_aot_shared_emission_t *shared_emission = nullptr;
     jl_codegen_params_t(orc::ThreadSafeContext ctx, DataLayout DL, Triple triple)
         : tsctx(std::move(ctx)), tsctx_lock(tsctx.getLock()),
             DL(std::move(DL)), TargetTriple(std::move(triple)), imaging_mode(imaging_default()) {}
@@ -14,6 +14,7 @@
 #else
 #include "errno.h"
 #include <unistd.h>
+#include <poll.h>
 #include <sys/socket.h>
 #endif
 
@@ -24,6 +25,20 @@
 
 #include "julia_assert.h"
 
+// io_uring is used for batched positional file I/O when the kernel headers
+// and syscall numbers are available; see jl_fs_read_batch below
+#ifdef _OS_LINUX_
+#include <sys/syscall.h>
+#if defined(__has_include) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#if __has_include(<linux/io_uring.h>)
+#define JL_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
+#endif
+#endif
+
 #ifdef __cplusplus
 #include <cstring>
 extern "C" {
@@ -32,6 +47,10 @@ extern "C" {
 static uv_async_t signal_async;
 static uv_timer_t wait_empty_worker;
 
+static void jl_uv_coalesce_drain(uv_stream_t *stream, int release) JL_NOTSAFEPOINT;
+static void jl_uv_coalesce_discard(uv_stream_t *stream) JL_NOTSAFEPOINT;
+static void jl_uv_coalesce_drain_all(void) JL_NOTSAFEPOINT;
+
 static void walk_print_cb(uv_handle_t *h, void *arg)
 {
     if (!uv_is_active(h) || !uv_has_ref(h))
@@ -114,11 +133,21 @@ void jl_wake_libuv(void)
 
 jl_mutex_t jl_uv_mutex;
 
+#ifdef JL_HAVE_IO_URING
+static uv_mutex_t fs_uring_lock;
+#endif
+
+static void jl_init_work_pool(void);
+
 void jl_init_uv(void)
 {
     uv_async_init(jl_io_loop, &signal_async, jl_signal_async_cb);
     uv_unref((uv_handle_t*)&signal_async);
     JL_MUTEX_INIT(&jl_uv_mutex, "jl_uv_mutex"); // a file-scope initializer can be used instead
+#ifdef JL_HAVE_IO_URING
+    uv_mutex_init(&fs_uring_lock);
+#endif
+    jl_init_work_pool();
 }
 
 _Atomic(int) jl_uv_n_waiters = 0;
@@ -153,6 +182,176 @@ JL_DLLEXPORT void jl_iolock_end(void)
 }
 
 
+// Private event loops.
+//
+// Handles on the global loop all serialize on jl_uv_mutex, so heavily threaded
+// I/O bottlenecks on one lock. A private loop made by jl_new_event_loop
+// carries its own lock and wake-up async (stored behind loop->data), letting
+// handles bound to it run I/O without touching the global loop at all. The
+// scheduler's sleep protocol only knows about the global loop; a private loop
+// makes progress only when some thread drives it with jl_uv_loop_run.
+
+typedef struct {
+    uv_loop_t *loop; // back-pointer; identifies loops made by jl_new_event_loop
+    jl_mutex_t lock;
+    uv_async_t wake;
+    _Atomic(int) nwaiters;
+} jl_uv_loop_data_t;
+
+static jl_uv_loop_data_t *jl_uv_loop_data(uv_loop_t *loop)
+{
+    if (loop == NULL || loop == jl_io_loop)
+        return NULL;
+    jl_uv_loop_data_t *data = (jl_uv_loop_data_t*)loop->data;
+    if (data == NULL || data->loop != loop)
+        return NULL; // a foreign loop; fall back to the global lock
+    return data;
+}
+
+static void jl_uv_loop_wake_cb(uv_async_t *hdl)
+{
+    // same job as jl_signal_async_cb, for a private loop: kick the loop out of
+    // uv_run so that a waiter can take the lock
+    uv_stop(hdl->loop);
+}
+
+/**
+ * @brief Lock the event loop owning a handle.
+ *
+ * Takes the private loop's own lock, or jl_uv_mutex for the global loop (and
+ * for loops Julia did not create). Interrupts a concurrent uv_run on the loop
+ * the same way JL_UV_LOCK does for the global one.
+ *
+ * @param loop A pointer to `uv_loop_t` whose lock to acquire.
+ */
+JL_DLLEXPORT void jl_uv_loop_lock(uv_loop_t *loop)
+{
+    jl_uv_loop_data_t *data = jl_uv_loop_data(loop);
+    if (data == NULL) {
+        JL_UV_LOCK();
+    }
+    else if (!jl_mutex_trylock(&data->lock)) {
+        jl_atomic_fetch_add_relaxed(&data->nwaiters, 1);
+        jl_fence(); // [^store_buffering_2]
+        uv_async_send(&data->wake);
+        JL_LOCK(&data->lock);
+        jl_atomic_fetch_add_relaxed(&data->nwaiters, -1);
+    }
+}
+
+/**
+ * @brief Unlock the event loop owning a handle.
+ *
+ * @param loop A pointer to `uv_loop_t` whose lock to release.
+ */
+JL_DLLEXPORT void jl_uv_loop_unlock(uv_loop_t *loop)
+{
+    jl_uv_loop_data_t *data = jl_uv_loop_data(loop);
+    if (data == NULL)
+        JL_UV_UNLOCK();
+    else
+        JL_UNLOCK(&data->lock);
+}
+
+/**
+ * @brief Create a private event loop.
+ *
+ * Handles bound to the returned loop use its own lock instead of jl_uv_mutex,
+ * so I/O on them does not contend with the global loop. The caller is
+ * responsible for driving the loop with jl_uv_loop_run (the scheduler will
+ * not) and for destroying it with jl_uv_loop_destroy once all of its handles
+ * have been closed.
+ *
+ * @return A pointer to the new `uv_loop_t`, or NULL on failure.
+ */
+JL_DLLEXPORT uv_loop_t *jl_new_event_loop(void)
+{
+    uv_loop_t *loop = (uv_loop_t*)malloc_s(sizeof(uv_loop_t));
+    jl_uv_loop_data_t *data = (jl_uv_loop_data_t*)malloc_s(sizeof(jl_uv_loop_data_t));
+    if (uv_loop_init(loop)) {
+        free(data);
+        free(loop);
+        return NULL;
+    }
+    JL_MUTEX_INIT(&data->lock, "jl_uv_loop");
+    jl_atomic_store_relaxed(&data->nwaiters, 0);
+    uv_async_init(loop, &data->wake, jl_uv_loop_wake_cb);
+    uv_unref((uv_handle_t*)&data->wake);
+    data->loop = loop;
+    loop->data = data;
+    return loop;
+}
+
+/**
+ * @brief Run a private event loop once.
+ *
+ * Processes pending events on a loop made by jl_new_event_loop, blocking for
+ * new events when `wait` is nonzero (the GC can run while the thread is
+ * blocked here; another thread wanting the lock interrupts the wait). Falls
+ * back to jl_process_events for the global loop.
+ *
+ * @param loop A pointer to `uv_loop_t` to run.
+ * @param wait Nonzero to block until at least one event has been processed.
+ * @return The `uv_run` status, or 0 if the loop was busy.
+ */
+JL_DLLEXPORT int jl_uv_loop_run(uv_loop_t *loop, int wait)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_uv_loop_data_t *data = jl_uv_loop_data(loop);
+    if (data == NULL)
+        return jl_process_events();
+    jl_gc_safepoint_(ct->ptls);
+    if (jl_atomic_load_relaxed(&data->nwaiters) == 0 && jl_mutex_trylock(&data->lock)) {
+        int r;
+        loop->stop_flag = 0;
+        uv_ref((uv_handle_t*)&data->wake); // force the loop alive
+        if (wait) {
+            int8_t gc_state = jl_gc_safe_enter(ct->ptls);
+            r = uv_run(loop, UV_RUN_ONCE);
+            jl_gc_safe_leave(ct->ptls, gc_state);
+        }
+        else {
+            r = uv_run(loop, UV_RUN_NOWAIT);
+        }
+        uv_unref((uv_handle_t*)&data->wake);
+        JL_UNLOCK(&data->lock);
+        return r;
+    }
+    return 0;
+}
+
+/**
+ * @brief Destroy a private event loop.
+ *
+ * All handles bound to the loop must already be closed, and no other thread
+ * may still be using the loop.
+ *
+ * @param loop A pointer to `uv_loop_t` made by jl_new_event_loop.
+ * @return 0 on success, or a libuv error code (e.g. UV_EBUSY if handles
+ *         remain open); the global loop is rejected with UV_EINVAL.
+ */
+JL_DLLEXPORT int jl_uv_loop_destroy(uv_loop_t *loop)
+{
+    jl_uv_loop_data_t *data = jl_uv_loop_data(loop);
+    if (data == NULL)
+        return UV_EINVAL;
+    uv_close((uv_handle_t*)&data->wake, NULL);
+    uv_run(loop, UV_RUN_NOWAIT); // deliver the close callback
+    int r = uv_loop_close(loop);
+    if (r == 0) {
+        loop->data = NULL;
+        free(data);
+        free(loop);
+    }
+    else {
+        // handles remain open: keep the loop usable until they are closed
+        uv_async_init(loop, &data->wake, jl_uv_loop_wake_cb);
+        uv_unref((uv_handle_t*)&data->wake);
+    }
+    return r;
+}
+
+
 static void jl_uv_call_close_callback(jl_value_t *val)
 {
     jl_value_t **args;
@@ -253,7 +452,9 @@ JL_DLLEXPORT void jl_uv_flush(uv_stream_t *stream)
         stream->type != UV_TCP &&
         stream->type != UV_NAMED_PIPE)
         return;
-    JL_UV_LOCK();
+    jl_uv_loop_lock(stream->loop);
+    if (stream->loop == jl_io_loop)
+        jl_uv_coalesce_drain(stream, 0);
     while (uv_is_writable(stream) && stream->write_queue_size != 0) {
         int fired = 0;
         uv_buf_t buf;
@@ -262,14 +463,14 @@ JL_DLLEXPORT void jl_uv_flush(uv_stream_t *stream)
         uv_write_t *write_req = (uv_write_t*)malloc_s(sizeof(uv_write_t));
         write_req->data = (void*)&fired;
         if (uv_write(write_req, stream, &buf, 1, uv_flush_callback) != 0) {
-            JL_UV_UNLOCK();
+            jl_uv_loop_unlock(stream->loop);
             return;
         }
         while (!fired) {
-            uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+            uv_run(stream->loop, UV_RUN_DEFAULT);
         }
     }
-    JL_UV_UNLOCK();
+    jl_uv_loop_unlock(stream->loop);
 }
 
 // getters and setters
@@ -387,12 +588,19 @@ JL_DLLEXPORT int jl_process_events(void)
     if (loop && (jl_atomic_load_relaxed(&_threadedregion) || jl_atomic_load_relaxed(&ct->tid) == 0)) {
         if (jl_atomic_load_relaxed(&jl_uv_n_waiters) == 0 && jl_mutex_trylock(&jl_uv_mutex)) {
             JL_PROBE_RT_START_PROCESS_EVENTS(ct);
+            // batch the wakeups the completion callbacks request, so one
+            // delivery after the pass amortizes over all of them
+            jl_uv_wake_batch_begin();
+            // a loop pass is a natural yield boundary for coalesced output
+            jl_uv_coalesce_drain_all();
             loop->stop_flag = 0;
             uv_ref((uv_handle_t*)&signal_async); // force the loop alive
             int r = uv_run(loop, UV_RUN_NOWAIT);
             uv_unref((uv_handle_t*)&signal_async);
+            uint32_t pending = jl_uv_wake_batch_close();
             JL_PROBE_RT_FINISH_PROCESS_EVENTS(ct);
             JL_UV_UNLOCK();
+            jl_uv_wake_batch_flush(pending);
             return r;
         }
         jl_gc_safepoint_(ct->ptls);
@@ -412,7 +620,7 @@ static void jl_proc_exit_cleanup_cb(uv_process_t *process, int64_t exit_status,
  */
 JL_DLLEXPORT void jl_close_uv(uv_handle_t *handle)
 {
-    JL_UV_LOCK();
+    jl_uv_loop_lock(handle->loop);
     if (handle->type == UV_PROCESS && ((uv_process_t*)handle)->pid != 0) {
         // take ownership of this handle,
         // so we can waitpid for the resource to exit and avoid leaving zombies
@@ -432,6 +640,8 @@ JL_DLLEXPORT void jl_close_uv(uv_handle_t *handle)
     else if (!uv_is_closing(handle)) { // avoid double-closing the stream
         if (handle->type == UV_NAMED_PIPE || handle->type == UV_TCP || handle->type == UV_TTY) {
             // flush the stream write-queue first
+            if (handle->loop == jl_io_loop)
+                jl_uv_coalesce_drain((uv_stream_t*)handle, 1);
             uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t));
             req->handle = (uv_stream_t*)handle;
             jl_uv_flush_close_callback(req, 0);
@@ -440,7 +650,7 @@ JL_DLLEXPORT void jl_close_uv(uv_handle_t *handle)
             uv_close(handle, &jl_uv_closeHandle);
         }
     }
-    JL_UV_UNLOCK();
+    jl_uv_loop_unlock(handle->loop);
 }
 
 /**
@@ -451,11 +661,13 @@ JL_DLLEXPORT void jl_close_uv(uv_handle_t *handle)
 JL_DLLEXPORT void jl_forceclose_uv(uv_handle_t *handle)
 {
     if (!uv_is_closing(handle)) { // avoid double-closing the stream
-        JL_UV_LOCK();
+        jl_uv_loop_lock(handle->loop);
         if (!uv_is_closing(handle)) { // double-check
+            if (handle->loop == jl_io_loop)
+                jl_uv_coalesce_discard((uv_stream_t*)handle);
             uv_close(handle, &jl_uv_closeHandle);
         }
-        JL_UV_UNLOCK();
+        jl_uv_loop_unlock(handle->loop);
     }
 }
 
@@ -535,9 +747,9 @@ JL_DLLEXPORT int jl_spawn(char *name, char **argv,
         }
     }
     opts.exit_cb = cb;
-    JL_UV_LOCK();
+    jl_uv_loop_lock(loop);
     int r = uv_spawn(loop, proc, &opts);
-    JL_UV_UNLOCK();
+    jl_uv_loop_unlock(loop);
     return r;
 }
 
@@ -689,20 +901,374 @@ JL_DLLEXPORT int jl_fs_close(uv_os_fd_t handle)
     return ret;
 }
 
+// Batched positional file I/O.
+//
+// The jl_fs_* wrappers above issue one synchronous syscall per operation, so
+// workloads that make very many small random reads pay the full dispatch cost
+// every time. jl_fs_read_batch and jl_fs_write_batch take a whole batch of
+// positional operations at once: on Linux kernels with io_uring every
+// operation in a wave is queued on a submission ring and one io_uring_enter
+// call submits them all and waits for their completions; elsewhere (and when
+// the ring cannot be set up) they fall back to a loop of positional
+// reads/writes, which is no worse than the caller looping over jl_fs_read.
+
+#ifdef JL_HAVE_IO_URING
+
+#define FS_URING_ENTRIES 256
+
+// one process-wide ring, set up lazily; batches serialize on fs_uring_lock
+static int fs_uring_fd = -1; // -1 untried, -2 unavailable
+static _Atomic(unsigned) *fs_uring_sq_head;
+static _Atomic(unsigned) *fs_uring_sq_tail;
+static unsigned fs_uring_sq_mask;
+static unsigned *fs_uring_sq_array;
+static struct io_uring_sqe *fs_uring_sqes;
+static _Atomic(unsigned) *fs_uring_cq_head;
+static _Atomic(unsigned) *fs_uring_cq_tail;
+static unsigned fs_uring_cq_mask;
+static struct io_uring_cqe *fs_uring_cqes;
+static struct iovec fs_uring_iovs[FS_URING_ENTRIES];
+
+// caller holds fs_uring_lock; returns the ring fd, or -2 if the kernel does
+// not support io_uring (we also require the single-mmap layout of 5.4+)
+static int fs_uring_init(void)
+{
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = (int)syscall(__NR_io_uring_setup, FS_URING_ENTRIES, &p);
+    if (fd < 0)
+        return -2;
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+        close(fd);
+        return -2;
+    }
+    size_t sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    size_t ring_sz = sq_sz > cq_sz ? sq_sz : cq_sz;
+    char *ring = (char*)mmap(NULL, ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        close(fd);
+        return -2;
+    }
+    struct io_uring_sqe *sqes = (struct io_uring_sqe*)mmap(NULL,
+            p.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        munmap(ring, ring_sz);
+        close(fd);
+        return -2;
+    }
+    fs_uring_sq_head = (_Atomic(unsigned)*)(ring + p.sq_off.head);
+    fs_uring_sq_tail = (_Atomic(unsigned)*)(ring + p.sq_off.tail);
+    fs_uring_sq_mask = *(unsigned*)(ring + p.sq_off.ring_mask);
+    fs_uring_sq_array = (unsigned*)(ring + p.sq_off.array);
+    fs_uring_sqes = sqes;
+    fs_uring_cq_head = (_Atomic(unsigned)*)(ring + p.cq_off.head);
+    fs_uring_cq_tail = (_Atomic(unsigned)*)(ring + p.cq_off.tail);
+    fs_uring_cq_mask = *(unsigned*)(ring + p.cq_off.ring_mask);
+    fs_uring_cqes = (struct io_uring_cqe*)(ring + p.cq_off.cqes);
+    return fd;
+}
+
+// run one wave of at most FS_URING_ENTRIES operations; returns 0, or -1 if
+// the ring failed and the wave must be redone by the fallback path (safe,
+// since positional reads and writes are idempotent)
+static int fs_uring_wave(int op, uv_os_fd_t *fds, char **bufs, size_t *lens,
+                         int64_t *offsets, ssize_t *results, int n)
+{
+    unsigned tail = jl_atomic_load_relaxed(fs_uring_sq_tail);
+    for (int i = 0; i < n; i++) {
+        unsigned idx = (tail + i) & fs_uring_sq_mask;
+        struct io_uring_sqe *sqe = &fs_uring_sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        fs_uring_iovs[idx].iov_base = bufs[i];
+        fs_uring_iovs[idx].iov_len = lens[i];
+        sqe->opcode = op;
+        sqe->fd = fds[i];
+        sqe->addr = (uintptr_t)&fs_uring_iovs[idx];
+        sqe->len = 1;
+        sqe->off = (uint64_t)offsets[i];
+        sqe->user_data = i;
+        fs_uring_sq_array[idx] = idx;
+    }
+    jl_atomic_store_release(fs_uring_sq_tail, tail + n);
+    int submitted = 0;
+    int done = 0;
+    while (done < n) {
+        int ret = (int)syscall(__NR_io_uring_enter, fs_uring_fd, n - submitted,
+                               n - done, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        submitted += ret;
+        unsigned head = jl_atomic_load_relaxed(fs_uring_cq_head);
+        unsigned ctail = jl_atomic_load_acquire(fs_uring_cq_tail);
+        while (head != ctail) {
+            struct io_uring_cqe *cqe = &fs_uring_cqes[head & fs_uring_cq_mask];
+            results[cqe->user_data] = (ssize_t)cqe->res;
+            head++;
+            done++;
+        }
+        jl_atomic_store_release(fs_uring_cq_head, head);
+    }
+    return 0;
+}
+
+#endif // JL_HAVE_IO_URING
+
+// execute a batch of positional reads (op == 0) or writes (op == 1); each
+// results[i] gets the byte count, or a negative (uv-compatible) error code
+static void jl_fs_batch(int op, uv_os_fd_t *fds, char **bufs, size_t *lens,
+                        int64_t *offsets, ssize_t *results, int n)
+{
+    int i = 0;
+#ifdef JL_HAVE_IO_URING
+    uv_mutex_lock(&fs_uring_lock);
+    if (fs_uring_fd == -1)
+        fs_uring_fd = fs_uring_init();
+    if (fs_uring_fd >= 0) {
+        while (i < n) {
+            int wave = n - i < FS_URING_ENTRIES ? n - i : FS_URING_ENTRIES;
+            if (fs_uring_wave(op == 0 ? IORING_OP_READV : IORING_OP_WRITEV,
+                              fds + i, bufs + i, lens + i, offsets + i,
+                              results + i, wave) != 0) {
+                fs_uring_fd = -2; // ring failed; redo this wave below
+                break;
+            }
+            i += wave;
+        }
+    }
+    uv_mutex_unlock(&fs_uring_lock);
+#endif
+    for (; i < n; i++) {
+        uv_fs_t req;
+        uv_buf_t buf[1];
+        buf[0].base = bufs[i];
+        buf[0].len = lens[i];
+        int ret = op == 0 ?
+            uv_fs_read(unused_uv_loop_arg, &req, fds[i], buf, 1, offsets[i], NULL) :
+            uv_fs_write(unused_uv_loop_arg, &req, fds[i], buf, 1, offsets[i], NULL);
+        uv_fs_req_cleanup(&req);
+        results[i] = ret;
+    }
+}
+
+// batched positional reads: read lens[i] bytes from fds[i] at offsets[i] into
+// bufs[i]; offsets must be explicit (>= 0), and the call blocks until every
+// operation has completed
+JL_DLLEXPORT void jl_fs_read_batch(uv_os_fd_t *fds, char **bufs, size_t *lens,
+                                   int64_t *offsets, ssize_t *results, int n)
+{
+    jl_fs_batch(0, fds, bufs, lens, offsets, results, n);
+}
+
+// batched positional writes; see jl_fs_read_batch
+JL_DLLEXPORT void jl_fs_write_batch(uv_os_fd_t *fds, char **bufs, size_t *lens,
+                                    int64_t *offsets, ssize_t *results, int n)
+{
+    jl_fs_batch(1, fds, bufs, lens, offsets, results, n);
+}
+
+static void jl_uv_writecb(uv_write_t *req, int status) JL_NOTSAFEPOINT;
+
+// Coalescing buffers for the runtime's own stream output. jl_printf and the
+// put functions produce a few bytes per call, and issuing a separate write
+// request for each made log-heavy code pay one allocation and one syscall
+// per token. Bytes written to streams on the global event loop accumulate
+// here instead and go out as a single write when the buffer fills, when the
+// stream is written, flushed or closed through any other path (preserving
+// write ordering), and at the start of every jl_process_events pass.
+// Guarded by JL_UV_LOCK, like everything else touching the global loop.
+#define JL_N_COALESCE_BUFFERS 4
+#define JL_COALESCE_BUF_SIZE 4096
+typedef struct {
+    uv_stream_t *stream; // NULL if the slot is free
+    size_t len;
+    char buf[JL_COALESCE_BUF_SIZE];
+} jl_coalesce_buf_t;
+static jl_coalesce_buf_t jl_coalesce_bufs[JL_N_COALESCE_BUFFERS];
+
+// requires JL_UV_LOCK
+static void jl_uv_coalesce_flush(jl_coalesce_buf_t *cb) JL_NOTSAFEPOINT
+{
+    if (cb->len == 0)
+        return;
+    uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + cb->len);
+    char *data = (char*)(req + 1);
+    memcpy(data, cb->buf, cb->len);
+    uv_buf_t buf[1];
+    buf[0].base = data;
+    buf[0].len = cb->len;
+    req->data = NULL;
+    cb->len = 0;
+    int status = uv_write(req, cb->stream, buf, 1, (uv_write_cb)jl_uv_writecb);
+    if (status < 0)
+        jl_uv_writecb(req, status);
+}
+
+// requires JL_UV_LOCK; flush (and with `release`, free the slot of) any
+// coalesced output pending for `stream`
+static void jl_uv_coalesce_drain(uv_stream_t *stream, int release) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < JL_N_COALESCE_BUFFERS; i++) {
+        jl_coalesce_buf_t *cb = &jl_coalesce_bufs[i];
+        if (cb->stream == stream) {
+            jl_uv_coalesce_flush(cb);
+            if (release)
+                cb->stream = NULL;
+            return;
+        }
+    }
+}
+
+// requires JL_UV_LOCK; drop buffered output without writing (forced close)
+static void jl_uv_coalesce_discard(uv_stream_t *stream) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < JL_N_COALESCE_BUFFERS; i++) {
+        jl_coalesce_buf_t *cb = &jl_coalesce_bufs[i];
+        if (cb->stream == stream) {
+            cb->stream = NULL;
+            cb->len = 0;
+            return;
+        }
+    }
+}
+
+// requires JL_UV_LOCK
+static void jl_uv_coalesce_drain_all(void) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < JL_N_COALESCE_BUFFERS; i++) {
+        if (jl_coalesce_bufs[i].stream != NULL)
+            jl_uv_coalesce_flush(&jl_coalesce_bufs[i]);
+    }
+}
+
 JL_DLLEXPORT int jl_uv_write(uv_stream_t *stream, const char *data, size_t n,
                              uv_write_t *uvw, uv_write_cb writecb)
 {
     uv_buf_t buf[1];
     buf[0].base = (char*)data;
     buf[0].len = n;
-    JL_UV_LOCK();
+    jl_uv_loop_lock(stream->loop);
     JL_SIGATOMIC_BEGIN();
+    jl_uv_coalesce_drain(stream, 0);
     int err = uv_write(uvw, stream, buf, 1, writecb);
-    JL_UV_UNLOCK();
+    jl_uv_loop_unlock(stream->loop);
     JL_SIGATOMIC_END();
     return err;
 }
 
+/**
+ * @brief Write several buffers to a UV stream as a single request.
+ *
+ * Scatter-gather analogue of jl_uv_write: the buffers are handed to the
+ * kernel in order without being copied into request-owned memory. The memory
+ * behind every buffer must stay valid (and, for GC-managed memory, rooted)
+ * until `writecb` fires; blocking callers root it on the waiting task's
+ * stack, fire-and-forget callers can pin the owning objects with
+ * jl_gc_pin_object and unpin them from the callback. On Windows each buffer
+ * must be smaller than 4GB; see MAX_OS_WRITE in base/stream.jl.
+ *
+ * @param stream A pointer to `uv_stream_t` representing the stream to write to.
+ * @param bases An array of pointers to the buffers to write.
+ * @param lens An array holding the length of each buffer.
+ * @param nbufs The number of buffers.
+ * @param uvw A pointer to `uv_write_t` tracking the request.
+ * @param writecb A function pointer to `uv_write_cb` called on completion.
+ * @return 0 on success, or a libuv error code.
+ */
+JL_DLLEXPORT int jl_uv_writev(uv_stream_t *stream, char **bases, size_t *lens,
+                              int nbufs, uv_write_t *uvw, uv_write_cb writecb)
+{
+    // uv_write copies the uv_buf_t array into the request, so it can live on
+    // the heap only for the duration of this call
+    uv_buf_t *bufs = (uv_buf_t*)malloc_s(nbufs * sizeof(uv_buf_t));
+    for (int i = 0; i < nbufs; i++) {
+        bufs[i].base = bases[i];
+        bufs[i].len = lens[i];
+    }
+    jl_uv_loop_lock(stream->loop);
+    JL_SIGATOMIC_BEGIN();
+    jl_uv_coalesce_drain(stream, 0);
+    int err = uv_write(uvw, stream, bufs, nbufs, writecb);
+    jl_uv_loop_unlock(stream->loop);
+    JL_SIGATOMIC_END();
+    free(bufs);
+    return err;
+}
+
+/**
+ * @brief Copy bytes from a file descriptor to a UV stream inside the kernel.
+ *
+ * Uses sendfile so the data never round-trips through userspace buffers. The
+ * stream's write queue must be empty (flush it first) and the caller must
+ * ensure no concurrent writer queues data on the stream while the copy runs;
+ * the bytes move directly between the two descriptors, bypassing the libuv
+ * write path. Blocks until `nbytes` bytes have been copied, the source hits
+ * end-of-file, or an error occurs; the GC can run while the call is blocked.
+ *
+ * @param stream A pointer to `uv_stream_t` to copy into.
+ * @param src The source file descriptor.
+ * @param offset The offset in the source file to start from (the source's
+ *        file position is not moved).
+ * @param nbytes The number of bytes to copy.
+ * @return The number of bytes copied (possibly short on end-of-file), or a
+ *         negative error code if nothing was copied (UV_ENOTSUP on Windows).
+ */
+JL_DLLEXPORT int64_t jl_uv_sendfile_stream(uv_stream_t *stream, int src,
+                                           int64_t offset, int64_t nbytes)
+{
+#ifdef _OS_WINDOWS_
+    (void)stream;
+    (void)src;
+    (void)offset;
+    (void)nbytes;
+    return UV_ENOTSUP;
+#else
+    uv_os_fd_t dst;
+    if (stream->type != UV_TCP && stream->type != UV_NAMED_PIPE && stream->type != UV_TTY)
+        return UV_EINVAL;
+    if (uv_fileno((uv_handle_t*)stream, &dst))
+        return UV_EBADF;
+    if (stream->write_queue_size != 0)
+        return UV_EBUSY;
+    jl_task_t *ct = jl_get_current_task();
+    int8_t gc_state = ct ? jl_gc_safe_enter(ct->ptls) : 0;
+    int64_t total = 0;
+    while (total < nbytes) {
+        uv_fs_t req;
+        int ret = uv_fs_sendfile(unused_uv_loop_arg, &req, dst, src,
+                                 offset + total, (size_t)(nbytes - total), NULL);
+        uv_fs_req_cleanup(&req);
+        if (ret > 0) {
+            total += ret;
+            continue;
+        }
+        if (ret == 0)
+            break; // the source hit end-of-file early
+        if (ret == UV_EAGAIN) {
+            // the destination is nonblocking; wait until it can take more
+            struct pollfd pfd;
+            pfd.fd = dst;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, -1) >= 0 || errno == EINTR)
+                continue;
+            ret = -errno;
+        }
+        if (total == 0)
+            total = ret; // report the error if nothing was copied
+        break;
+    }
+    if (ct)
+        jl_gc_safe_leave(ct->ptls, gc_state);
+    return total;
+#endif
+}
+
 static void jl_uv_writecb(uv_write_t *req, int status) JL_NOTSAFEPOINT
 {
     free(req);
@@ -756,19 +1322,49 @@ JL_DLLEXPORT void jl_uv_puts(uv_stream_t *stream, const char *str, size_t n)
     }
     else {
         // Write to libuv stream...
-        uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + n);
-        char *data = (char*)(req + 1);
-        memcpy(data, str, n);
-        uv_buf_t buf[1];
-        buf[0].base = data;
-        buf[0].len = n;
-        req->data = NULL;
-        JL_UV_LOCK();
+        jl_uv_loop_lock(stream->loop);
         JL_SIGATOMIC_BEGIN();
-        int status = uv_write(req, stream, buf, 1, (uv_write_cb)jl_uv_writecb);
-        JL_UV_UNLOCK();
+        // coalesce small writes to streams on the global loop, so that a
+        // burst of jl_printf calls becomes one write request instead of one
+        // allocation and one syscall per fragment
+        jl_coalesce_buf_t *cb = NULL;
+        if (stream->loop == jl_io_loop && n < JL_COALESCE_BUF_SIZE) {
+            jl_coalesce_buf_t *unused = NULL;
+            for (int i = 0; i < JL_N_COALESCE_BUFFERS; i++) {
+                if (jl_coalesce_bufs[i].stream == stream) {
+                    cb = &jl_coalesce_bufs[i];
+                    break;
+                }
+                if (unused == NULL && jl_coalesce_bufs[i].stream == NULL)
+                    unused = &jl_coalesce_bufs[i];
+            }
+            if (cb == NULL && unused != NULL) {
+                unused->stream = stream;
+                unused->len = 0;
+                cb = unused;
+            }
+        }
+        uv_write_t *req = NULL;
+        int status = 0;
+        if (cb != NULL) {
+            if (cb->len + n > JL_COALESCE_BUF_SIZE)
+                jl_uv_coalesce_flush(cb);
+            memcpy(cb->buf + cb->len, str, n);
+            cb->len += n;
+        }
+        else {
+            req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + n);
+            char *data = (char*)(req + 1);
+            memcpy(data, str, n);
+            uv_buf_t buf[1];
+            buf[0].base = data;
+            buf[0].len = n;
+            req->data = NULL;
+            status = uv_write(req, stream, buf, 1, (uv_write_cb)jl_uv_writecb);
+        }
+        jl_uv_loop_unlock(stream->loop);
         JL_SIGATOMIC_END();
-        if (status < 0) {
+        if (req != NULL && status < 0) {
             jl_uv_writecb(req, status);
         }
     }
@@ -1100,20 +1696,20 @@ JL_DLLEXPORT int jl_tcp_reuseport(uv_tcp_t *handle)
 JL_DLLEXPORT int jl_uv_unix_fd_is_watched(int fd, uv_poll_t *handle,
                                           uv_loop_t *loop)
 {
-    JL_UV_LOCK();
+    jl_uv_loop_lock(loop);
     if (fd >= loop->nwatchers) {
-        JL_UV_UNLOCK();
+        jl_uv_loop_unlock(loop);
         return 0;
     }
     if (loop->watchers[fd] == NULL) {
-        JL_UV_UNLOCK();
+        jl_uv_loop_unlock(loop);
         return 0;
     }
     if (handle && loop->watchers[fd] == &handle->io_watcher) {
-        JL_UV_UNLOCK();
+        jl_uv_loop_unlock(loop);
         return 0;
     }
-    JL_UV_UNLOCK();
+    jl_uv_loop_unlock(loop);
     return 1;
 }
 
@@ -1182,7 +1778,7 @@ typedef int (*work_cb_t)(void *, void *, void *);
 typedef void (*notify_cb_t)(int);
 
 struct work_baton {
-    uv_work_t req;
+    struct work_baton *next;
     work_cb_t work_func;
     void      *ccall_fptr;
     void      *work_args;
@@ -1191,28 +1787,171 @@ struct work_baton {
     int       notify_idx;
 };
 
-#ifdef _OS_LINUX_
-#include <sys/syscall.h>
-#endif
+// Resizable worker pool for jl_queue_work (the @threadcall path).
+//
+// libuv's internal threadpool is sized once, from UV_THREADPOOL_SIZE, and
+// cannot change afterwards, so a storm of blocking calls queues up behind a
+// handful of workers. This pool grows on demand -- whenever work is queued
+// and no worker is idle -- up to WORK_POOL_MAX, and workers above the
+// configured floor exit again once they have been idle for a while. The
+// floor can be changed at runtime with jl_work_pool_resize. Completions are
+// delivered on the event-loop thread through an async handle, preserving the
+// uv_queue_work contract the notify callbacks were written for. Note that
+// libuv's own pool still services its internal users (getaddrinfo, uv_fs_*
+// with callbacks); only the runtime's blocking-work path moves off of it.
+
+#define WORK_POOL_MAX 128
+#define WORK_POOL_IDLE_TIMEOUT_NS (10 * (uint64_t)1e9)
+
+struct work_thread {
+    uv_thread_t handle;
+    struct work_thread *next;
+};
 
-void jl_work_wrapper(uv_work_t *req)
+static uv_mutex_t work_pool_lock;
+static uv_cond_t work_pool_cond;
+static uv_async_t work_pool_async;       // wakes the loop thread for completions
+static struct work_baton *work_pool_head; // pending work
+static struct work_baton *work_pool_tail;
+static struct work_baton *work_pool_done; // finished work awaiting notification
+static struct work_thread *work_pool_dead; // exited workers awaiting join
+static int work_pool_nthreads = 0;
+static int work_pool_nidle = 0;
+static int work_pool_floor = 4;
+
+static void work_pool_thread(void *arg)
+{
+    struct work_thread *self = (struct work_thread*)arg;
+    uv_mutex_lock(&work_pool_lock);
+    while (1) {
+        while (work_pool_head == NULL) {
+            work_pool_nidle++;
+            int rc = uv_cond_timedwait(&work_pool_cond, &work_pool_lock,
+                                       WORK_POOL_IDLE_TIMEOUT_NS);
+            work_pool_nidle--;
+            if (work_pool_head == NULL && rc == UV_ETIMEDOUT &&
+                    work_pool_nthreads > work_pool_floor) {
+                // idled out above the floor: shrink the pool
+                work_pool_nthreads--;
+                self->next = work_pool_dead;
+                work_pool_dead = self;
+                uv_mutex_unlock(&work_pool_lock);
+                uv_async_send(&work_pool_async); // have the loop thread join us
+                return;
+            }
+        }
+        struct work_baton *baton = work_pool_head;
+        work_pool_head = baton->next;
+        if (work_pool_head == NULL)
+            work_pool_tail = NULL;
+        uv_mutex_unlock(&work_pool_lock);
+        baton->work_func(baton->ccall_fptr, baton->work_args, baton->work_retval);
+        uv_mutex_lock(&work_pool_lock);
+        baton->next = work_pool_done;
+        work_pool_done = baton;
+        uv_mutex_unlock(&work_pool_lock);
+        uv_async_send(&work_pool_async);
+        uv_mutex_lock(&work_pool_lock);
+    }
+}
+
+// runs on the event-loop thread: deliver completions and reap exited workers
+static void work_pool_async_cb(uv_async_t *hdl)
 {
-    struct work_baton *baton = (struct work_baton*) req->data;
-    baton->work_func(baton->ccall_fptr, baton->work_args, baton->work_retval);
+    (void)hdl;
+    uv_mutex_lock(&work_pool_lock);
+    struct work_baton *baton = work_pool_done;
+    work_pool_done = NULL;
+    struct work_thread *dead = work_pool_dead;
+    work_pool_dead = NULL;
+    uv_mutex_unlock(&work_pool_lock);
+    while (dead) {
+        struct work_thread *next = dead->next;
+        uv_thread_join(&dead->handle);
+        free(dead);
+        dead = next;
+    }
+    while (baton) {
+        struct work_baton *next = baton->next;
+        baton->notify_func(baton->notify_idx);
+        free(baton);
+        baton = next;
+    }
 }
 
-void jl_work_notifier(uv_work_t *req, int status)
+static void jl_init_work_pool(void)
 {
-    struct work_baton *baton = (struct work_baton*) req->data;
-    baton->notify_func(baton->notify_idx);
-    free(baton);
+    uv_mutex_init(&work_pool_lock);
+    uv_cond_init(&work_pool_cond);
+    uv_async_init(jl_io_loop, &work_pool_async, work_pool_async_cb);
+    uv_unref((uv_handle_t*)&work_pool_async);
+    const char *env = getenv("UV_THREADPOOL_SIZE"); // keep the familiar knob
+    if (env) {
+        int n = (int)strtol(env, NULL, 10);
+        if (n >= 1 && n <= WORK_POOL_MAX)
+            work_pool_floor = n;
+    }
+}
+
+// caller holds work_pool_lock; spawn one worker, dropping and retaking the
+// lock around thread creation. Returns 0 on success.
+static int work_pool_spawn(void)
+{
+    struct work_thread *wt = (struct work_thread*)malloc_s(sizeof(struct work_thread));
+    wt->next = NULL;
+    work_pool_nthreads++;
+    uv_mutex_unlock(&work_pool_lock);
+    int err = uv_thread_create(&wt->handle, work_pool_thread, wt);
+    uv_mutex_lock(&work_pool_lock);
+    if (err) {
+        work_pool_nthreads--;
+        free(wt);
+    }
+    return err;
+}
+
+/**
+ * @brief Get the current number of worker-pool threads.
+ */
+JL_DLLEXPORT int jl_work_pool_size(void)
+{
+    uv_mutex_lock(&work_pool_lock);
+    int n = work_pool_nthreads;
+    uv_mutex_unlock(&work_pool_lock);
+    return n;
+}
+
+/**
+ * @brief Resize the worker pool that services jl_queue_work.
+ *
+ * Sets the pool's floor to `n` (clamped to [1, 128]), starting workers
+ * immediately when growing; when shrinking, excess workers exit as they idle
+ * out. The pool still grows past the floor on demand while work is queued.
+ *
+ * @param n The requested pool floor.
+ * @return The new floor.
+ */
+JL_DLLEXPORT int jl_work_pool_resize(int n)
+{
+    if (n < 1)
+        n = 1;
+    if (n > WORK_POOL_MAX)
+        n = WORK_POOL_MAX;
+    uv_mutex_lock(&work_pool_lock);
+    work_pool_floor = n;
+    while (work_pool_nthreads < work_pool_floor) {
+        if (work_pool_spawn())
+            break;
+    }
+    uv_mutex_unlock(&work_pool_lock);
+    return n;
 }
 
 JL_DLLEXPORT int jl_queue_work(work_cb_t work_func, void *ccall_fptr, void *work_args, void *work_retval,
                                notify_cb_t notify_func, int notify_idx)
 {
     struct work_baton *baton = (struct work_baton*)malloc_s(sizeof(struct work_baton));
-    baton->req.data = (void*) baton;
+    baton->next = NULL;
     baton->work_func = work_func;
     baton->ccall_fptr = ccall_fptr;
     baton->work_args = work_args;
@@ -1220,9 +1959,34 @@ JL_DLLEXPORT int jl_queue_work(work_cb_t work_func, void *ccall_fptr, void *work
     baton->notify_func = notify_func;
     baton->notify_idx = notify_idx;
 
-    JL_UV_LOCK();
-    uv_queue_work(jl_io_loop, &baton->req, jl_work_wrapper, jl_work_notifier);
-    JL_UV_UNLOCK();
+    uv_mutex_lock(&work_pool_lock);
+    if (work_pool_tail)
+        work_pool_tail->next = baton;
+    else
+        work_pool_head = baton;
+    work_pool_tail = baton;
+    // auto-scale: nobody is idle to pick this up, so add a worker
+    if (work_pool_nidle == 0 && work_pool_nthreads < WORK_POOL_MAX) {
+        if (work_pool_spawn() && work_pool_nthreads == 0) {
+            // cannot create any worker at all: drain the queue synchronously
+            // rather than letting it hang
+            while (work_pool_head) {
+                struct work_baton *b = work_pool_head;
+                work_pool_head = b->next;
+                if (work_pool_head == NULL)
+                    work_pool_tail = NULL;
+                uv_mutex_unlock(&work_pool_lock);
+                b->work_func(b->ccall_fptr, b->work_args, b->work_retval);
+                b->notify_func(b->notify_idx);
+                free(b);
+                uv_mutex_lock(&work_pool_lock);
+            }
+            uv_mutex_unlock(&work_pool_lock);
+            return 0;
+        }
+    }
+    uv_mutex_unlock(&work_pool_lock);
+    uv_cond_signal(&work_pool_cond);
 
     return 0;
 }
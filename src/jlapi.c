@@ -437,6 +437,178 @@ JL_DLLEXPORT jl_value_t *jl_call3(jl_function_t *f, jl_value_t *a,
     return v;
 }
 
+struct _jl_call_batch_t {
+    jl_gcframe_t *frame; // heap-allocated frame linked into the task's gcstack
+    size_t nroots;
+    size_t last_age;
+    jl_task_t *ct;
+};
+
+/**
+ * @brief Open a batch of Julia calls sharing one rooted frame.
+ *
+ * Each `jl_call` invocation pushes and pops a GC frame and re-reads the world
+ * counter; for embedders making millions of tiny calls that bookkeeping can
+ * dwarf the called code. A batch pays those costs once: it pushes a single
+ * persistent frame with `nroots` rooting slots (see `jl_call_batch_roots`)
+ * and pins the task's world age until `jl_call_batch_end`, so methods defined
+ * after the batch opens are not visible inside it. The batch must be closed
+ * on the same task that opened it, and batches close in LIFO order.
+ *
+ * @param nroots The number of rooting slots to reserve, all initially NULL.
+ * @return A pointer to the open `jl_call_batch_t`.
+ */
+JL_DLLEXPORT jl_call_batch_t *jl_call_batch_begin(size_t nroots)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_call_batch_t *batch = (jl_call_batch_t*)malloc_s(sizeof(jl_call_batch_t));
+    void **frame = (void**)malloc_s((nroots + 2) * sizeof(void*));
+    frame[0] = (void*)(nroots << 2);
+    frame[1] = ct->gcstack;
+    memset(&frame[2], 0, nroots * sizeof(void*));
+    ct->gcstack = (jl_gcframe_t*)frame;
+    batch->frame = (jl_gcframe_t*)frame;
+    batch->nroots = nroots;
+    batch->ct = ct;
+    batch->last_age = ct->world_age;
+    ct->world_age = jl_get_world_counter();
+    return batch;
+}
+
+/**
+ * @brief Get the rooting slots of an open call batch.
+ *
+ * Values stored in these slots are kept alive until `jl_call_batch_end`.
+ * Arguments passed to `jl_call_batch` and `jl_call_batch_invoke` are not
+ * rooted by the call itself, so the embedder must keep them reachable, e.g.
+ * through these slots.
+ *
+ * @param batch A pointer to an open `jl_call_batch_t`.
+ * @return A pointer to the batch's `nroots` slots.
+ */
+JL_DLLEXPORT jl_value_t **jl_call_batch_roots(jl_call_batch_t *batch)
+{
+    return (jl_value_t**)((void**)batch->frame + 2);
+}
+
+/**
+ * @brief Call a Julia function inside an open call batch.
+ *
+ * Like `jl_call`, but without per-call frame or world-age bookkeeping: the
+ * function and arguments must already be rooted (see `jl_call_batch_roots`)
+ * and the call runs at the batch's world age.
+ *
+ * @param batch A pointer to an open `jl_call_batch_t`.
+ * @param f A pointer to `jl_function_t` representing the Julia function to call.
+ * @param args An array of pointers to `jl_value_t` representing the arguments.
+ * @param nargs The number of arguments in the array.
+ * @return A pointer to `jl_value_t` representing the result, or NULL if an
+ *         exception was thrown.
+ */
+JL_DLLEXPORT jl_value_t *jl_call_batch(jl_call_batch_t *batch, jl_function_t *f,
+                                       jl_value_t **args, uint32_t nargs)
+{
+    jl_value_t *v;
+    jl_task_t *ct = batch->ct;
+    JL_TRY {
+        v = jl_apply_generic(f, args, nargs);
+        _jl_exception_clear(ct);
+    }
+    JL_CATCH {
+        ct->ptls->previous_exception = jl_current_exception();
+        v = NULL;
+    }
+    return v;
+}
+
+/**
+ * @brief Resolve the method instance a batch call would dispatch to.
+ *
+ * For monomorphic embedder call sites, resolving once and then calling
+ * through `jl_call_batch_invoke` skips repeated dispatch. The handle is
+ * valid for the given function and argument types as long as no applicable
+ * method is redefined; redefinition invalidates it silently, so embedders
+ * that allow method redefinition should re-resolve per batch.
+ *
+ * @param batch A pointer to an open `jl_call_batch_t`.
+ * @param f A pointer to `jl_function_t` representing the Julia function.
+ * @param args An array of pointers to `jl_value_t` representing prototype
+ *        arguments for the call site.
+ * @param nargs The number of arguments in the array.
+ * @return A pointer to the `jl_method_instance_t` handle, or NULL if no
+ *         method matches.
+ */
+JL_DLLEXPORT jl_method_instance_t *jl_call_batch_resolve(jl_call_batch_t *batch, jl_function_t *f,
+                                                         jl_value_t **args, uint32_t nargs)
+{
+    jl_method_instance_t *mi = NULL;
+    jl_task_t *ct = batch->ct;
+    JL_TRY {
+        jl_value_t **argv;
+        JL_GC_PUSHARGS(argv, nargs + 1);
+        argv[0] = f;
+        for (uint32_t i = 0; i < nargs; i++)
+            argv[i + 1] = args[i];
+        mi = jl_method_lookup(argv, nargs + 1, ct->world_age);
+        JL_GC_POP();
+        _jl_exception_clear(ct);
+    }
+    JL_CATCH {
+        ct->ptls->previous_exception = jl_current_exception();
+        mi = NULL;
+    }
+    return mi;
+}
+
+/**
+ * @brief Call a Julia function through a pre-resolved method instance.
+ *
+ * Like `jl_call_batch`, but bypasses generic dispatch using a handle from
+ * `jl_call_batch_resolve`. The arguments must have the same types as the
+ * prototype arguments the handle was resolved with.
+ *
+ * @param batch A pointer to an open `jl_call_batch_t`.
+ * @param mi The handle returned by `jl_call_batch_resolve`.
+ * @param f A pointer to `jl_function_t` representing the Julia function to call.
+ * @param args An array of pointers to `jl_value_t` representing the arguments.
+ * @param nargs The number of arguments in the array.
+ * @return A pointer to `jl_value_t` representing the result, or NULL if an
+ *         exception was thrown.
+ */
+JL_DLLEXPORT jl_value_t *jl_call_batch_invoke(jl_call_batch_t *batch, jl_method_instance_t *mi,
+                                              jl_function_t *f, jl_value_t **args, uint32_t nargs)
+{
+    jl_value_t *v;
+    jl_task_t *ct = batch->ct;
+    JL_TRY {
+        v = jl_invoke((jl_value_t*)f, args, nargs, mi);
+        _jl_exception_clear(ct);
+    }
+    JL_CATCH {
+        ct->ptls->previous_exception = jl_current_exception();
+        v = NULL;
+    }
+    return v;
+}
+
+/**
+ * @brief Close a call batch.
+ *
+ * Pops the batch's rooted frame and restores the task's world age.
+ *
+ * @param batch A pointer to the open `jl_call_batch_t`; invalid afterwards.
+ */
+JL_DLLEXPORT void jl_call_batch_end(jl_call_batch_t *batch)
+{
+    jl_task_t *ct = batch->ct;
+    assert(ct == jl_current_task);
+    assert(ct->gcstack == batch->frame && "call batches must close in LIFO order");
+    ct->gcstack = batch->frame->prev;
+    ct->world_age = batch->last_age;
+    free(batch->frame);
+    free(batch);
+}
+
 /**
  * @brief Yield to the Julia scheduler.
  *
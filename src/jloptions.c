@@ -90,6 +90,8 @@ JL_DLLEXPORT void jl_init_options(void)
                         0, // strip-ir
                         0, // permalloc_pkgimg
                         0, // heap-size-hint
+                        0, // small-function-threshold
+                        0, // huge-function-threshold
     };
     jl_options_initialized = 1;
 }
@@ -195,8 +197,10 @@ static const char opts[]  =
 static const char opts_hidden[]  =
     "Switches (a '*' marks the default value, if applicable):\n\n"
     // code generation options
-    " --compile={yes*|no|all|min}\n"
-    "                          Enable or disable JIT compiler, or request exhaustive or minimal compilation\n\n"
+    " --compile={yes*|no|all|min|tiered}\n"
+    "                          Enable or disable JIT compiler, or request exhaustive or minimal compilation;\n"
+    "                          `tiered` interprets code on first call, compiles it quickly once it\n"
+    "                          becomes hot, and re-optimizes it in the background\n\n"
 
     // compiler output options
     " --output-o <name>        Generate an object file (including system image data)\n"
@@ -214,6 +218,10 @@ static const char opts_hidden[]  =
     "                          Print precompile statements for methods compiled during execution or save to a path\n"
     " --image-codegen          Force generate code in imaging mode\n"
     " --permalloc-pkgimg={yes|no*} Copy the data section of package images into memory\n"
+    " --small-function-threshold=<n> Run extra optimization passes on functions with fewer\n"
+    "                          than <n> LLVM IR instructions (0*=disabled)\n"
+    " --huge-function-threshold=<n> Skip optimization passes with superlinear cost on functions\n"
+    "                          with more than <n> LLVM IR instructions (0*=disabled)\n"
 ;
 
 JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
@@ -259,7 +267,9 @@ JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
            opt_strip_ir,
            opt_heap_size_hint,
            opt_gc_threads,
-           opt_permalloc_pkgimg
+           opt_permalloc_pkgimg,
+           opt_small_function_threshold,
+           opt_huge_function_threshold
     };
     static const char* const shortopts = "+vhqH:e:E:L:J:C:it:p:O:g:";
     static const struct option longopts[] = {
@@ -321,6 +331,8 @@ JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
         { "strip-ir",        no_argument,       0, opt_strip_ir },
         { "permalloc-pkgimg",required_argument, 0, opt_permalloc_pkgimg },
         { "heap-size-hint",  required_argument, 0, opt_heap_size_hint },
+        { "small-function-threshold", required_argument, 0, opt_small_function_threshold },
+        { "huge-function-threshold",  required_argument, 0, opt_huge_function_threshold },
         { 0, 0, 0, 0 }
     };
 
@@ -579,6 +591,8 @@ restart_switch:
                 jl_options.compile_enabled = JL_OPTIONS_COMPILE_ALL;
             else if (!strcmp(optarg,"min"))
                 jl_options.compile_enabled = JL_OPTIONS_COMPILE_MIN;
+            else if (!strcmp(optarg,"tiered"))
+                jl_options.compile_enabled = JL_OPTIONS_COMPILE_TIERED;
             else
                 jl_errorf("julia: invalid argument to --compile (%s)", optarg);
             break;
@@ -855,6 +869,22 @@ restart_switch:
             else
                 jl_errorf("julia: invalid argument to --permalloc-pkgimg={yes|no} (%s)", optarg);
             break;
+        case opt_small_function_threshold: {
+            errno = 0;
+            long threshold = strtol(optarg, &endptr, 10);
+            if (errno != 0 || optarg == endptr || *endptr != 0 || threshold < 0 || threshold > INT32_MAX)
+                jl_errorf("julia: --small-function-threshold=<n>; n must be a non-negative integer");
+            jl_options.small_function_threshold = (uint32_t)threshold;
+            break;
+        }
+        case opt_huge_function_threshold: {
+            errno = 0;
+            long threshold = strtol(optarg, &endptr, 10);
+            if (errno != 0 || optarg == endptr || *endptr != 0 || threshold < 0 || threshold > INT32_MAX)
+                jl_errorf("julia: --huge-function-threshold=<n>; n must be a non-negative integer");
+            jl_options.huge_function_threshold = (uint32_t)threshold;
+            break;
+        }
         default:
             jl_errorf("julia: unhandled option -- %c\n"
                       "This is a bug, please report it.", c);
@@ -61,6 +61,10 @@ typedef struct {
     int8_t strip_ir;
     int8_t permalloc_pkgimg;
     uint64_t heap_size_hint;
+    // instruction-count thresholds for the size-adaptive LLVM pass
+    // pipeline; 0 disables the respective adaptation
+    uint32_t small_function_threshold;
+    uint32_t huge_function_threshold;
 } jl_options_t;
 
 #endif
@@ -1325,6 +1325,7 @@ typedef struct _jl_typestack_t jl_typestack_t;
 
 static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value_t **iparams, size_t ntp,
                                        jl_typestack_t *stack, jl_typeenv_t *env, int check);
+static jl_value_t *jl_apply_tuple_type_v_(jl_value_t **p, size_t np, jl_svec_t *params, int check);
 
 // Build an environment mapping a TypeName's parameters to parameter values.
 // This is the environment needed for instantiating a type's supertype and field types.
@@ -1845,6 +1846,21 @@ static jl_value_t *normalize_unionalls(jl_value_t *t)
     return t;
 }
 
+// Memo for homogeneous tuple types Tuple{T,T,...,T}. Instantiating NTuple{N,T}
+// for many distinct N goes through the generic typecache, whose key hashes and
+// compares all N parameters; this table answers repeats with one load keyed by
+// (element type, length). Only concrete results are stored, and those are
+// always held in the tuple typename's cache, so entries are rooted elsewhere
+// and the table is not scanned by GC. Entries are validated on lookup (length
+// and first parameter), so a racing store to the same slot is harmless.
+#define NTUPLE_CACHE_LEN 1024
+static _Atomic(jl_value_t*) ntuple_cache[NTUPLE_CACHE_LEN];
+
+static size_t ntuple_cache_slot(jl_value_t *t, size_t n) JL_NOTSAFEPOINT
+{
+    return ((((uintptr_t)t) / sizeof(void*)) ^ (n * 0x9e3779b9u)) % NTUPLE_CACHE_LEN;
+}
+
 // used to expand an NTuple to a flat representation
 static jl_value_t *jl_tupletype_fill(size_t n, jl_value_t *t, int check)
 {
@@ -1864,8 +1880,23 @@ static jl_value_t *jl_tupletype_fill(size_t n, jl_value_t *t, int check)
         p = t;
         check = 0; // remember that checks are already done now
     }
+    size_t slot = 0;
+    int memoizable = n > 0 && jl_is_concrete_type(t);
+    if (memoizable) {
+        slot = ntuple_cache_slot(t, n);
+        jl_value_t *tt = jl_atomic_load_relaxed(&ntuple_cache[slot]);
+        if (tt != NULL) {
+            jl_svec_t *params = ((jl_datatype_t*)tt)->parameters;
+            if (jl_svec_len(params) == n && jl_svecref(params, 0) == t) {
+                JL_GC_POP();
+                return tt;
+            }
+        }
+    }
     p = (jl_value_t*)jl_svec_fill(n, t);
     p = jl_apply_tuple_type((jl_svec_t*)p, check);
+    if (memoizable && jl_is_datatype(p) && ((jl_datatype_t*)p)->isconcretetype)
+        jl_atomic_store_relaxed(&ntuple_cache[slot], p);
     JL_GC_POP();
     return p;
 }
@@ -1994,11 +2025,24 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
                     JL_GC_POP();
                     return jl_tupletype_fill(nt, va0, 0);
                 }
-                size_t i, l;
-                p = jl_alloc_svec(ntp - 1 + nt);
-                for (i = 0, l = ntp - 1; i < l; i++)
+                size_t i, l = ntp - 1 + nt;
+                if (l < jl_page_size / sizeof(jl_value_t*)) {
+                    // build the expanded parameter list on the stack, so that
+                    // a cache hit for the normalized tuple allocates nothing
+                    jl_value_t **fp;
+                    JL_GC_PUSHARGS(fp, l);
+                    for (i = 0; i < ntp - 1; i++)
+                        fp[i] = iparams[i];
+                    for (; i < l; i++)
+                        fp[i] = va0;
+                    jl_value_t *ndt = jl_apply_tuple_type_v_(fp, l, NULL, check);
+                    JL_GC_POP();
+                    JL_GC_POP();
+                    return ndt;
+                }
+                p = jl_alloc_svec(l);
+                for (i = 0; i < ntp - 1; i++)
                     jl_svecset(p, i, iparams[i]);
-                l = ntp - 1 + nt;
                 for (; i < l; i++)
                     jl_svecset(p, i, va0);
                 jl_value_t *ndt = jl_apply_tuple_type(p, check);
@@ -2075,8 +2119,17 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
     // acquire the write lock now that we know we need a new object
     // since we're going to immediately leak it globally via the instantiation stack
     if (cacheable) {
-        JL_LOCK(&typecache_lock); // Might GC
+        // repeat the lock-free lookup first: the allocations above leave a
+        // long window in which another thread may have published this same
+        // instantiation, and skipping the (global) lock entirely keeps
+        // workers that race on one parametric family from convoying on it
         jl_value_t *lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
+        if (lkup) {
+            JL_GC_POP();
+            return lkup;
+        }
+        JL_LOCK(&typecache_lock); // Might GC
+        lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
         if (lkup) {
             JL_UNLOCK(&typecache_lock); // Might GC
             JL_GC_POP();
@@ -2670,26 +2723,27 @@ void jl_init_types(void) JL_GC_DISABLED
     jl_typename_type->name->mt = jl_nonfunction_mt;
     jl_typename_type->super = jl_any_type;
     jl_typename_type->parameters = jl_emptysvec;
-    jl_typename_type->name->n_uninitialized = 15 - 2;
-    jl_typename_type->name->names = jl_perm_symsvec(15, "name", "module",
+    jl_typename_type->name->n_uninitialized = 16 - 2;
+    jl_typename_type->name->names = jl_perm_symsvec(16, "name", "module",
                                                     "names", "atomicfields", "constfields",
                                                     "wrapper", "Typeofwrapper", "cache", "linearcache",
                                                     "mt", "partial",
                                                     "hash", "n_uninitialized",
                                                     "flags", // "abstract", "mutable", "mayinlinealloc",
-                                                    "max_methods");
+                                                    "max_methods", "fieldindex_cache");
     const static uint32_t typename_constfields[1] = { 0x00003a27 }; // (1<<0)|(1<<1)|(1<<2)|(1<<5)|(1<<9)|(1<<11)|(1<<12)|(1<<13) ; TODO: put back (1<<3)|(1<<4) in this list
     const static uint32_t typename_atomicfields[1] = { 0x00000180 }; // (1<<7)|(1<<8)
     jl_typename_type->name->constfields = typename_constfields;
     jl_typename_type->name->atomicfields = typename_atomicfields;
     jl_precompute_memoized_dt(jl_typename_type, 1);
-    jl_typename_type->types = jl_svec(15, jl_symbol_type, jl_any_type /*jl_module_type*/,
+    jl_typename_type->types = jl_svec(16, jl_symbol_type, jl_any_type /*jl_module_type*/,
                                       jl_simplevector_type, jl_any_type/*jl_voidpointer_type*/, jl_any_type/*jl_voidpointer_type*/,
                                       jl_type_type, jl_type_type, jl_simplevector_type, jl_simplevector_type,
                                       jl_methtable_type, jl_any_type,
                                       jl_any_type /*jl_long_type*/, jl_any_type /*jl_int32_type*/,
                                       jl_any_type /*jl_uint8_type*/,
-                                      jl_any_type /*jl_uint8_type*/);
+                                      jl_any_type /*jl_uint8_type*/,
+                                      jl_any_type /*jl_voidpointer_type*/);
 
     jl_methtable_type->name = jl_new_typename_in(jl_symbol("MethodTable"), core, 0, 1);
     jl_methtable_type->name->wrapper = (jl_value_t*)jl_methtable_type;
@@ -3445,11 +3499,12 @@ void jl_init_types(void) JL_GC_DISABLED
     jl_svecset(jl_typename_type->types, 12, jl_int32_type);
     jl_svecset(jl_typename_type->types, 13, jl_uint8_type);
     jl_svecset(jl_typename_type->types, 14, jl_uint8_type);
+    jl_svecset(jl_typename_type->types, 15, jl_voidpointer_type);
     jl_svecset(jl_methtable_type->types, 4, jl_long_type);
     jl_svecset(jl_methtable_type->types, 5, jl_module_type);
     jl_svecset(jl_methtable_type->types, 6, jl_array_any_type);
     jl_svecset(jl_methtable_type->types, 7, jl_long_type); // voidpointer
-    jl_svecset(jl_methtable_type->types, 8, jl_long_type); // uint32_t plus alignment
+    jl_svecset(jl_methtable_type->types, 8, jl_long_type); // count/statsidx/futex words of the lock
     jl_svecset(jl_methtable_type->types, 9, jl_uint8_type);
     jl_svecset(jl_methtable_type->types, 10, jl_uint8_type);
     jl_svecset(jl_method_type->types, 12, jl_method_instance_type);
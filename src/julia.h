@@ -147,8 +147,6 @@ static inline void jl_set_typeof(void *v, void *t) JL_NOTSAFEPOINT
 // The string data is nul-terminated and hangs off the end of the struct.
 typedef struct _jl_sym_t {
     JL_DATA_TYPE
-    _Atomic(struct _jl_sym_t*) left;
-    _Atomic(struct _jl_sym_t*) right;
     uintptr_t hash;    // precomputed hash value
     // JL_ATTRIBUTE_ALIGN_PTRSIZE(char name[]);
 } jl_sym_t;
@@ -374,6 +372,10 @@ typedef struct _jl_method_t {
 // hidden fields:
     // lock for modifications to the method
     jl_mutex_t writelock;
+    // lock for insertions into the specializations table, separate from
+    // writelock so that instantiating specializations during parallel
+    // compilation does not contend with other modifications to the method
+    jl_mutex_t speclock;
 } jl_method_t;
 
 // This type is a placeholder to cache data for a specType signature specialization of a Method
@@ -507,6 +509,9 @@ typedef struct {
     uint8_t mayinlinealloc:1;
     uint8_t _reserved:5;
     uint8_t max_methods; // override for inference's max_methods setting (0 = no additional limit or relaxation)
+    // open-addressed name->field-index table for wide types, built lazily by
+    // jl_field_index (datatype.c) and dropped from serialized images
+    _Atomic(int32_t*) fieldindex_cache;
 } jl_typename_t;
 
 typedef struct {
@@ -542,11 +547,12 @@ typedef struct {
     uint16_t alignment; // strictest alignment over all fields
     struct { // combine these fields into a struct so that we can take addressof them
         uint16_t haspadding : 1; // has internal undefined bytes
+        uint16_t isbitsegal : 1; // whether egal of this layout is implementable as a bitwise comparison
         uint16_t fielddesc_type : 2; // 0 -> 8, 1 -> 16, 2 -> 32, 3 -> foreign type
         // metadata bit only for GenericMemory eltype layout
         uint16_t arrayelem_isboxed : 1;
         uint16_t arrayelem_isunion : 1;
-        uint16_t padding : 11;
+        uint16_t padding : 10;
     } flags;
     // union {
     //     jl_fielddesc8_t field8[nfields];
@@ -621,6 +627,10 @@ typedef struct _jl_module_t {
     _Atomic(jl_svec_t*) bindings;
     _Atomic(jl_genericmemory_t*) bindingkeyset; // index lookup by name into bindings
     // hidden fields:
+    _Atomic(jl_svec_t*) usingindex; // lazily built merged index over the exports of `usings` (see module.c)
+    _Atomic(jl_svec_t*) usingnegcache; // names no used module exported as of `usingneggen` (see module.c)
+    _Atomic(jl_genericmemory_t*) usingnegkeyset; // index lookup by name into usingnegcache
+    _Atomic(uint64_t) usingneggen; // export generation the negative cache was recorded at
     arraylist_t usings;  // modules with all bindings potentially imported
     jl_uuid_t build_id;
     jl_uuid_t uuid;
@@ -1039,6 +1049,66 @@ JL_DLLEXPORT void jl_gc_use(jl_value_t *a);
 // Set GC memory trigger in bytes for greedy memory collecting
 JL_DLLEXPORT void jl_gc_set_max_memory(uint64_t max_mem);
 JL_DLLEXPORT uint64_t jl_gc_get_max_memory(void);
+JL_DLLEXPORT void jl_gc_set_pause_target_ms(uint64_t ms);
+JL_DLLEXPORT uint64_t jl_gc_get_pause_target_ms(void);
+
+// Per-phase breakdown of the most recent collection. All durations are in
+// nanoseconds. This is recorded on every collection, so the pause can be
+// attributed to mark vs sweep vs finalizers without a debug build.
+typedef struct {
+    uint64_t collect_count;        // collections so far; identifies the record
+    uint64_t full;                 // whether the sweep was a full sweep
+    uint64_t total_ns;             // stop-the-world pause (mark + sweep)
+    uint64_t mark_ns;
+    uint64_t sweep_ns;
+    uint64_t finalizers_ns;        // finalizers run after the world restarted
+    uint64_t time_to_safepoint_ns;
+    uint64_t bytes_promoted;       // young bytes promoted to old by this collection
+    uint64_t bytes_freed;          // heap size shrinkage from this collection
+    uint64_t pages_swept;          // pool pages processed by this sweep
+} jl_gc_collection_stats_t;
+JL_DLLEXPORT void jl_gc_get_last_collection_stats(jl_gc_collection_stats_t *stats);
+
+// Live pool-heap fragmentation summary, one record per GC size class, filled
+// from the page metadata the collector already maintains — no collection is
+// triggered. Mutators keep running during the walk, so the numbers are an
+// approximate snapshot: freelist counts are refreshed by sweeps and slightly
+// stale for pages currently being allocated from.
+typedef struct {
+    uint64_t osize;   // object size of this class, in bytes
+    uint64_t npages;  // pool pages currently assigned to the class
+    uint64_t nobjs;   // object cells those pages hold in total
+    uint64_t nfree;   // cells sitting on freelists (live density = 1 - nfree/nobjs)
+    uint64_t nold;    // cells holding old-generation objects
+} jl_gc_pool_stats_t;
+// Fill up to `len` records and return the number of size classes.
+JL_DLLEXPORT int jl_gc_pool_stats(jl_gc_pool_stats_t *stats, int len) JL_NOTSAFEPOINT;
+
+// Continuous memory timeline: snapshots of the live-heap estimate and of the
+// cumulative per-size-class allocation counters, kept in a fixed ring so that
+// allocation velocity between collections is observable. One sample is taken
+// automatically at the end of every collection; call jl_gc_timeline_sample for
+// finer resolution. Velocity per size class is the difference between two
+// samples divided by their timestamp delta.
+#define JL_GC_TIMELINE_NPOOLS 64 // >= the number of pool size classes
+typedef struct {
+    uint64_t t_ns;       // jl_hrtime() timestamp of the sample
+    uint64_t live_bytes; // live-heap estimate (refreshed by collections)
+    // cumulative bytes ever allocated per size class; slots past the count
+    // returned by jl_gc_pool_stats stay zero
+    uint64_t pool_alloc_bytes[JL_GC_TIMELINE_NPOOLS];
+} jl_gc_timeline_sample_t;
+JL_DLLEXPORT void jl_gc_timeline_sample(void) JL_NOTSAFEPOINT;
+// Copy up to `len` of the most recent samples, newest first; returns the
+// number copied.
+JL_DLLEXPORT int jl_gc_timeline_get(jl_gc_timeline_sample_t *samples, int len) JL_NOTSAFEPOINT;
+
+// Object pinning. A pinned object is treated as a GC root, so a buffer handed
+// to an asynchronous C library stays valid even when no reference to it is
+// reachable from Julia. Pins nest: the object is released once every pin has
+// been matched by an unpin.
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *v) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *v) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT void jl_clear_malloc_data(void);
 
@@ -1054,6 +1124,19 @@ STATIC_INLINE void jl_gc_wb(const void *parent, const void *ptr) JL_NOTSAFEPOINT
         jl_gc_queue_root((jl_value_t*)parent);
 }
 
+JL_DLLEXPORT void jl_gc_queue_memoryset_root(jl_value_t *owner, void *slot) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_gc_queue_memoryset_range(jl_value_t *owner, void *slot, size_t nbytes) JL_NOTSAFEPOINT;
+
+// Slot-aware write barrier for stores into the boxed element data of a
+// GenericMemory object that owns its data; large objects are card-marked
+// instead of being appended to the remset wholesale
+STATIC_INLINE void jl_gc_wb_memoryset(const void *owner, void *slot, const void *ptr) JL_NOTSAFEPOINT
+{
+    if (__unlikely(jl_astaggedvalue(owner)->bits.gc == 3 && // owner is old and not in remset
+                   (jl_astaggedvalue(ptr)->bits.gc & 1) == 0)) // ptr is young
+        jl_gc_queue_memoryset_root((jl_value_t*)owner, slot);
+}
+
 STATIC_INLINE void jl_gc_wb_back(const void *ptr) JL_NOTSAFEPOINT // ptr isa jl_value_t*
 {
     // if ptr is old
@@ -1757,7 +1840,6 @@ JL_DLLEXPORT jl_sym_t *jl_symbol_lookup(const char *str) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, size_t len) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_sym_t *jl_gensym(void);
 JL_DLLEXPORT jl_sym_t *jl_tagged_gensym(const char *str, size_t len);
-JL_DLLEXPORT jl_sym_t *jl_get_root_symbol(void);
 JL_DLLEXPORT jl_value_t *jl_generic_function_def(jl_sym_t *name,
                                                  jl_module_t *module,
                                                  _Atomic(jl_value_t*) *bp,
@@ -1949,6 +2031,13 @@ JL_DLLEXPORT long jl_getallocationgranularity(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int jl_is_debugbuild(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_sym_t *jl_get_UNAME(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_sym_t *jl_get_ARCH(void) JL_NOTSAFEPOINT;
+
+// CRC-32C (iSCSI polynomial) checksum, hardware-accelerated when possible.
+// Start with crc == 0; chain calls by passing the previous result back in.
+JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len);
+// whether jl_crc32c is backed by a hardware kernel (rather than the
+// table-driven software fall-back, which is an order of magnitude slower)
+JL_DLLEXPORT int jl_crc32c_hw(void);
 JL_DLLIMPORT jl_value_t *jl_get_libllvm(void) JL_NOTSAFEPOINT;
 extern JL_DLLIMPORT int jl_n_threadpools;
 extern JL_DLLIMPORT _Atomic(int) jl_n_threads;
@@ -2048,6 +2137,7 @@ JL_DLLEXPORT void jl_create_system_image(void **, jl_array_t *worklist, bool_t e
 JL_DLLEXPORT void jl_restore_system_image(const char *fname);
 JL_DLLEXPORT void jl_restore_system_image_data(const char *buf, size_t len);
 JL_DLLEXPORT jl_value_t *jl_restore_incremental(const char *fname, jl_array_t *depmods, int complete, const char *pkgimage);
+JL_DLLEXPORT jl_value_t *jl_apply_system_image_patch(const char *fname);
 
 JL_DLLEXPORT void jl_set_newly_inferred(jl_value_t *newly_inferred);
 JL_DLLEXPORT void jl_push_newly_inferred(jl_value_t *ci);
@@ -2111,6 +2201,8 @@ JL_DLLEXPORT void jl_register_newmeth_tracer(void (*callback)(jl_method_t *trace
 
 // AST access
 JL_DLLEXPORT jl_value_t *jl_copy_ast(jl_value_t *expr JL_MAYBE_UNROOTED);
+JL_DLLEXPORT jl_value_t *jl_compress_ast(jl_value_t *ast);
+JL_DLLEXPORT jl_value_t *jl_uncompress_ast(const char *data, size_t len);
 
 // IR representation
 JL_DLLEXPORT jl_value_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code);
@@ -2160,6 +2252,15 @@ JL_DLLEXPORT jl_value_t *jl_call2(jl_function_t *f JL_MAYBE_UNROOTED, jl_value_t
 JL_DLLEXPORT jl_value_t *jl_call3(jl_function_t *f JL_MAYBE_UNROOTED, jl_value_t *a JL_MAYBE_UNROOTED,
                                   jl_value_t *b JL_MAYBE_UNROOTED, jl_value_t *c JL_MAYBE_UNROOTED);
 
+// batched calls sharing one rooted frame and world age (see jlapi.c)
+typedef struct _jl_call_batch_t jl_call_batch_t;
+JL_DLLEXPORT jl_call_batch_t *jl_call_batch_begin(size_t nroots);
+JL_DLLEXPORT jl_value_t **jl_call_batch_roots(jl_call_batch_t *batch);
+JL_DLLEXPORT jl_value_t *jl_call_batch(jl_call_batch_t *batch, jl_function_t *f, jl_value_t **args, uint32_t nargs);
+JL_DLLEXPORT jl_method_instance_t *jl_call_batch_resolve(jl_call_batch_t *batch, jl_function_t *f, jl_value_t **args, uint32_t nargs);
+JL_DLLEXPORT jl_value_t *jl_call_batch_invoke(jl_call_batch_t *batch, jl_method_instance_t *mi, jl_function_t *f, jl_value_t **args, uint32_t nargs);
+JL_DLLEXPORT void jl_call_batch_end(jl_call_batch_t *batch);
+
 // interfacing with Task runtime
 JL_DLLEXPORT void jl_yield(void);
 
@@ -2220,9 +2321,13 @@ typedef struct _jl_task_t {
     // Bit 1-2: 0-3 counter of how many times we've reentered inference
     // Bit 3: 1 if we are writing the image and inference is illegal
     uint8_t reentrant_timing;
-    // 2 bytes of padding on 32-bit, 6 bytes on 64-bit
-    // uint16_t padding2_32;
-    // uint48_t padding2_64;
+    // number of GC stack scans this task still needs before quick marks may
+    // skip rescanning it; reset whenever the task is switched away from
+    // (see the task branch of gc_mark_outrefs in gc.c)
+    uint8_t stack_dirty;
+    // 1 byte of padding on 32-bit, 5 bytes on 64-bit
+    // uint8_t padding2_32;
+    // uint40_t padding2_64;
     // saved gc stack top for context switches
     jl_gcframe_t *gcstack;
     size_t world_age;
@@ -2251,6 +2356,7 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t*, jl_value_t*, size_t);
 JL_DLLEXPORT void jl_switchto(jl_task_t **pt);
 JL_DLLEXPORT int jl_set_task_tid(jl_task_t *task, int16_t tid) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int jl_set_task_threadpoolid(jl_task_t *task, int8_t tpid) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_try_lifo_spawn(jl_task_t *task) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void JL_NORETURN jl_throw(jl_value_t *e JL_MAYBE_UNROOTED);
 JL_DLLEXPORT void JL_NORETURN jl_rethrow(void);
 JL_DLLEXPORT void JL_NORETURN jl_sig_throw(void);
@@ -2359,6 +2465,14 @@ JL_DLLEXPORT int jl_process_events(void);
 
 JL_DLLEXPORT struct uv_loop_s *jl_global_event_loop(void) JL_NOTSAFEPOINT;
 
+// private event loops: handles bound to one use its own lock instead of the
+// global iolock, and the creator is responsible for driving it (see jl_uv.c)
+JL_DLLEXPORT struct uv_loop_s *jl_new_event_loop(void);
+JL_DLLEXPORT int jl_uv_loop_run(struct uv_loop_s *loop, int wait);
+JL_DLLEXPORT int jl_uv_loop_destroy(struct uv_loop_s *loop);
+JL_DLLEXPORT void jl_uv_loop_lock(struct uv_loop_s *loop);
+JL_DLLEXPORT void jl_uv_loop_unlock(struct uv_loop_s *loop);
+
 JL_DLLEXPORT void jl_close_uv(struct uv_handle_s *handle);
 
 JL_DLLEXPORT jl_array_t *jl_take_buffer(ios_t *s);
@@ -2440,6 +2554,7 @@ JL_DLLEXPORT int jl_generating_output(void) JL_NOTSAFEPOINT;
 #define JL_OPTIONS_COMPILE_ON  1
 #define JL_OPTIONS_COMPILE_ALL 2
 #define JL_OPTIONS_COMPILE_MIN 3
+#define JL_OPTIONS_COMPILE_TIERED 4
 
 #define JL_OPTIONS_COLOR_AUTO 0
 #define JL_OPTIONS_COLOR_ON 1
@@ -2535,7 +2650,12 @@ typedef struct {
                             // limited, standalone
     int debug_info_level;   // equivalent to the -g level from the cli
     int safepoint_on_entry; // Emit a safepoint on entry to each function
-    int gcstack_arg; // Pass the ptls value as an argument with swiftself
+    int gcstack_arg; // Pass the pgcstack value as a swiftself argument, keeping
+                     // it pinned in a (callee-saved) register across specsig
+                     // Julia-to-Julia calls instead of reloading it from TLS in
+                     // every function; the TLS load (via jl_adopt_thread for
+                     // foreign threads) then only happens on entry from
+                     // non-Julia code. See also LowerPTLS in llvm-ptls.cpp.
 
     int use_jlplt; // Whether to use the Julia PLT mechanism or emit symbols directly
     // Cache access. Default: jl_rettype_inferred.
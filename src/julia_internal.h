@@ -337,6 +337,24 @@ extern JL_DLLEXPORT size_t jl_page_size;
 extern jl_function_t *jl_typeinf_func JL_GLOBALLY_ROOTED;
 extern JL_DLLEXPORT size_t jl_typeinf_world;
 extern _Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
+// per-call-site dispatch cache: two ways per site, most recently used first
+typedef struct {
+    _Atomic(uintptr_t) callsite;
+    _Atomic(jl_typemap_entry_t*) ways[2];
+} jl_callsite_cache_t;
+extern jl_callsite_cache_t callsite_cache[N_CALLSITE_CACHE] JL_GLOBALLY_ROOTED;
+// memo table for closed subtype queries; each slot is an svec(x, y, result)
+extern _Atomic(jl_svec_t*) subtype_cache[N_SUBTYPE_CACHE] JL_GLOBALLY_ROOTED;
+// memo table for closed type intersections; each slot is an svec(a, b, ti, issubty)
+extern _Atomic(jl_svec_t*) intersect_cache[N_INTERSECT_CACHE] JL_GLOBALLY_ROOTED;
+// memo table for dynamic invoke lookups; each slot is an svec(types, ft, method, world)
+extern _Atomic(jl_svec_t*) invoke_cache[N_INVOKE_CACHE] JL_GLOBALLY_ROOTED;
+// memo table for opaque closure specializations; see new_opaque_closure for
+// the slot layout
+extern _Atomic(jl_svec_t*) oc_spec_cache[N_OC_SPEC_CACHE] JL_GLOBALLY_ROOTED;
+// memo table for failed method lookups; each slot is an
+// svec(types, mt, min_world, max_world, world_counter)
+extern _Atomic(jl_svec_t*) missing_method_cache[N_MISSING_METHOD_CACHE] JL_GLOBALLY_ROOTED;
 extern jl_array_t *jl_all_methods JL_GLOBALLY_ROOTED;
 
 JL_DLLEXPORT extern int jl_lineno;
@@ -542,6 +560,15 @@ STATIC_INLINE jl_gc_tracked_buffer_t *jl_gc_alloc_buf(jl_ptls_t ptls, size_t sz)
     return jl_gc_alloc(ptls, sz, (void*)jl_buff_tag);
 }
 
+// arena allocation for provably non-escaping temporaries (see gc.c);
+// objects allocated here are not tracked by the GC, so they must not be
+// reachable from any root once the arena is reset or closed
+typedef struct _jl_gc_arena_t jl_gc_arena_t;
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_arena_open(void);
+JL_DLLEXPORT jl_value_t *jl_gc_arena_alloc(jl_gc_arena_t *a, size_t sz, void *ty);
+JL_DLLEXPORT void jl_gc_arena_reset(jl_gc_arena_t *a);
+JL_DLLEXPORT void jl_gc_arena_close(jl_gc_arena_t *a);
+
 STATIC_INLINE jl_value_t *jl_gc_permobj(size_t sz, void *ty) JL_NOTSAFEPOINT
 {
     const size_t allocsz = sz + sizeof(jl_taggedvalue_t);
@@ -643,6 +670,8 @@ typedef union {
 
 JL_DLLEXPORT jl_code_info_t *jl_type_infer(jl_method_instance_t *li, size_t world, int force);
 JL_DLLEXPORT jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *meth JL_PROPAGATES_ROOT, size_t world);
+void jl_tier0_count_call(jl_code_instance_t *codeinst);
+void jl_tier0_promote(jl_code_instance_t *codeinst);
 JL_DLLEXPORT jl_code_instance_t *jl_get_method_inferred(
         jl_method_instance_t *mi JL_PROPAGATES_ROOT, jl_value_t *rettype,
         size_t min_world, size_t max_world);
@@ -684,6 +713,10 @@ JL_DLLEXPORT jl_value_t *jl_apply_2va(jl_value_t *f, jl_value_t **args, uint32_t
 void JL_NORETURN jl_method_error(jl_function_t *f, jl_value_t **args, size_t na, size_t world);
 JL_DLLEXPORT jl_value_t *jl_get_exceptionf(jl_datatype_t *exception_type, const char *fmt, ...);
 
+// per-method dynamic-dispatch miss counters (see gf.c)
+JL_DLLEXPORT void jl_dispatch_profile_enable(int enable);
+JL_DLLEXPORT jl_value_t *jl_dispatch_profile_counts(void);
+
 JL_DLLEXPORT void jl_typeassert(jl_value_t *x, jl_value_t *t);
 
 #define JL_CALLABLE(name)                                               \
@@ -716,6 +749,7 @@ int jl_has_concrete_subtype(jl_value_t *typ);
 jl_tupletype_t *jl_inst_arg_tuple_type(jl_value_t *arg1, jl_value_t **args, size_t nargs, int leaf);
 jl_tupletype_t *jl_lookup_arg_tuple_type(jl_value_t *arg1 JL_PROPAGATES_ROOT, jl_value_t **args, size_t nargs, int leaf);
 JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype);
+JL_DLLEXPORT void jl_method_table_batch_insert(jl_array_t *methods);
 jl_datatype_t *jl_mk_builtin_func(jl_datatype_t *dt, const char *name, jl_fptr_args_t fptr) JL_GC_DISABLED;
 int jl_obviously_unequal(jl_value_t *a, jl_value_t *b);
 JL_DLLEXPORT jl_array_t *jl_find_free_typevars(jl_value_t *v);
@@ -804,6 +838,10 @@ void jl_module_run_initializer(jl_module_t *m);
 JL_DLLEXPORT jl_binding_t *jl_get_module_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var, int alloc);
 JL_DLLEXPORT void jl_binding_deprecation_warning(jl_module_t *m, jl_sym_t *sym, jl_binding_t *b);
 extern jl_array_t *jl_module_init_order JL_GLOBALLY_ROOTED;
+extern jl_array_t *jl_lowered_cache JL_GLOBALLY_ROOTED;
+extern jl_array_t *jl_macro_memo JL_GLOBALLY_ROOTED;
+uint64_t jl_ast_hash(jl_value_t *v);
+int jl_ast_eq(jl_value_t *a, jl_value_t *b) JL_NOTSAFEPOINT;
 extern htable_t jl_current_modules JL_GLOBALLY_ROOTED;
 extern JL_DLLEXPORT jl_module_t *jl_precompile_toplevel_module JL_GLOBALLY_ROOTED;
 extern jl_genericmemory_t *jl_global_roots_list JL_GLOBALLY_ROOTED;
@@ -811,6 +849,14 @@ extern jl_genericmemory_t *jl_global_roots_keyset JL_GLOBALLY_ROOTED;
 JL_DLLEXPORT int jl_is_globally_rooted(jl_value_t *val JL_MAYBE_UNROOTED) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_as_global_root(jl_value_t *val, int insert) JL_GLOBALLY_ROOTED;
 
+// adaptive per-pkgimage IR symbol tables (see ircode.c)
+JL_DLLEXPORT void jl_install_ir_symbol_table(jl_array_t *syms, int make_current);
+JL_DLLEXPORT jl_array_t *jl_ir_symbol_candidates(size_t max);
+void jl_write_ir_symtab(ios_t *f);
+// flush the JULIA_IMAGE_LAYOUT_PROFILE_OUT page-rank profile (see staticdata.c)
+void jl_image_layout_profile_write(void);
+void jl_read_ir_symtab(ios_t *f);
+
 jl_opaque_closure_t *jl_new_opaque_closure(jl_tupletype_t *argt, jl_value_t *rt_lb, jl_value_t *rt_ub,
     jl_value_t *source,  jl_value_t **env, size_t nenv, int do_compile);
 JL_DLLEXPORT int jl_is_valid_oc_argtype(jl_tupletype_t *argt, jl_method_t *source);
@@ -912,7 +958,7 @@ extern char *jl_safepoint_pages;
 STATIC_INLINE int jl_addr_is_safepoint(uintptr_t addr)
 {
     uintptr_t safepoint_addr = (uintptr_t)jl_safepoint_pages;
-    return addr >= safepoint_addr && addr < safepoint_addr + jl_page_size * 4;
+    return addr >= safepoint_addr && addr < safepoint_addr + jl_page_size * 5;
 }
 extern _Atomic(uint32_t) jl_gc_running;
 extern _Atomic(uint32_t) jl_gc_disable_counter;
@@ -921,6 +967,14 @@ extern _Atomic(uint32_t) jl_gc_disable_counter;
 // signal.
 // Initialize the safepoint
 void jl_safepoint_init(void);
+// Set the initial safepoint pointer of a newly registered thread,
+// taking the current arming state of the GC safepoint into account.
+void jl_safepoint_init_thread(jl_ptls_t ptls) JL_NOTSAFEPOINT;
+// Remap a context register that points into the permanently protected armed
+// page back at the thread's regular poll location, so that the poll load
+// faulting there can be re-executed after the GC; returns 0 if `val` does
+// not point into the armed page.
+uintptr_t jl_safepoint_remap_armed_addr(uintptr_t val, int16_t tid) JL_NOTSAFEPOINT;
 // Start the GC, return `1` if the thread should be running the GC.
 // Otherwise, the thread will wait in this function until the GC finishes on
 // another thread and return `0`.
@@ -941,6 +995,27 @@ void jl_safepoint_end_gc(void);
 void jl_safepoint_wait_gc(void) JL_NOTSAFEPOINT;
 void jl_safepoint_wait_thread_resume(void) JL_NOTSAFEPOINT;
 
+// Time-to-safepoint (TTSP) statistics: how long each stop-the-world took to
+// bring every thread to a safepoint, and which thread arrived last. A long
+// pause caused by one thread dawdling toward the safepoint (rather than by
+// GC work itself) shows up here. The histogram is log2-bucketed: hist[i]
+// counts stops whose TTSP was in [2^i, 2^(i+1)) microseconds, with the last
+// bucket open-ended.
+#define JL_TTSP_NHIST 16
+typedef struct {
+    uint64_t nstops;        // stop-the-world events measured
+    uint64_t total_ttsp_ns; // cumulative time-to-safepoint
+    uint64_t max_ttsp_ns;
+    uint64_t hist[JL_TTSP_NHIST];
+    int16_t last_straggler_tid; // -1 if no stop had to wait on a thread yet
+    uint64_t last_straggler_ns; // how long the last straggler took to arrive
+    // straggler's return address into jl_safepoint_wait_gc's caller (resolve
+    // with jl_lookup_code_address); NULL if the thread stopped by sitting in
+    // a GC-safe region, e.g. a blocking ccall
+    void *last_straggler_pc;
+} jl_safepoint_ttsp_stats_t;
+JL_DLLEXPORT void jl_safepoint_ttsp_stats(jl_safepoint_ttsp_stats_t *stats) JL_NOTSAFEPOINT;
+
 // Set pending sigint and enable the mechanisms to deliver the sigint.
 void jl_safepoint_enable_sigint(void);
 // If the safepoint is enabled to deliver sigint, disable it
@@ -953,6 +1028,19 @@ void jl_safepoint_defer_sigint(void);
 int jl_safepoint_consume_sigint(void);
 void jl_wake_libuv(void) JL_NOTSAFEPOINT;
 
+// wakeup batching around event-loop passes (scheduler.c): open a window with
+// the libuv lock held, close it before unlocking, flush after unlocking
+void jl_uv_wake_batch_begin(void) JL_NOTSAFEPOINT;
+uint32_t jl_uv_wake_batch_close(void) JL_NOTSAFEPOINT;
+void jl_uv_wake_batch_flush(uint32_t pending);
+
+// scheduler timer wheel for coarse task timeouts (scheduler.c)
+typedef struct _jl_timeout_t jl_timeout_t;
+JL_DLLEXPORT jl_timeout_t *jl_timeout_start(jl_task_t *task, uint64_t timeout_ns);
+JL_DLLEXPORT int jl_timeout_cancel(jl_timeout_t *timer) JL_NOTSAFEPOINT;
+void jl_timeout_check(void);
+void jl_timeout_foreach_task(void (*visit)(jl_task_t *t, void *ctx), void *ctx) JL_NOTSAFEPOINT;
+
 void jl_set_pgcstack(jl_gcframe_t **) JL_NOTSAFEPOINT;
 #if defined(_OS_DARWIN_)
 typedef pthread_key_t jl_pgcstack_key_t;
@@ -1115,7 +1203,7 @@ STATIC_INLINE size_t jl_bt_entry_size(jl_bt_element_t *bt_entry) JL_NOTSAFEPOINT
 // Stack walking and debug info lookup
 
 // Function metadata arising from debug info lookup of instruction pointer
-typedef struct {
+typedef struct _jl_frame_t {
     char *func_name;
     char *file_name;
     int line;
@@ -1163,6 +1251,13 @@ size_t rec_backtrace(jl_bt_element_t *bt_data, size_t maxsize, int skip) JL_NOTS
 // which was asynchronously interrupted.
 size_t rec_backtrace_ctx(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx,
                          jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT;
+// Record backtrace from a signal handler by chasing frame pointers, validated
+// against the sampled thread's stack bounds. Returns 0 when the frame-pointer
+// chain cannot be walked to completion (e.g. through foreign frames built
+// without frame pointers), in which case the caller should fall back to
+// rec_backtrace_ctx.
+size_t rec_backtrace_ctx_fp(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx,
+                            jl_ptls_t ptls2) JL_NOTSAFEPOINT;
 #ifdef LLVMLIBUNWIND
 size_t rec_backtrace_ctx_dwarf(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx, jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT;
 #endif
@@ -1178,6 +1273,38 @@ JL_DLLEXPORT void jl_refresh_dbg_module_list(void);
 int jl_thread_suspend_and_get_state(int tid, int timeout, bt_context_t *ctx) JL_NOTSAFEPOINT;
 void jl_thread_resume(int tid) JL_NOTSAFEPOINT;
 
+// Minimal assembly fiber switch: suspending and resuming a started task saves
+// only sp, fp and the callee-saved registers in the fixed layout below,
+// instead of routing through sigsetjmp/siglongjmp and the libc jmp_buf
+// (pointer mangling, unwinder hooks, libc interposition). The layout is
+// overlaid on the jmp_buf slot of non-copy task contexts; all save, resume
+// and unwind sites (task.c and jl_rec_backtrace in stackwalk.c) must agree on
+// this choice, so it is made here, once. Sanitizers intercept setjmp/longjmp
+// to track fibers, so they keep the libc path.
+#if defined(JL_HAVE_ASM) && !defined(JL_HAVE_UNW_CONTEXT) && \
+    (defined(_CPU_X86_64_) || defined(_CPU_AARCH64_)) && \
+    !defined(_OS_WINDOWS_) && \
+    !defined(_COMPILER_TSAN_ENABLED_) && !defined(_COMPILER_ASAN_ENABLED_) && \
+    !defined(_COMPILER_MSAN_ENABLED_)
+#define JL_HAVE_FAST_FIBER_SWAP
+typedef struct {
+#if defined(_CPU_X86_64_)
+    uintptr_t rbx, rbp, r12, r13, r14, r15;
+    uintptr_t rsp; // stack pointer after the jl_fastctx_save call returns
+    uintptr_t rip; // return address of the jl_fastctx_save call
+#elif defined(_CPU_AARCH64_)
+    uintptr_t x19, x20, x21, x22, x23, x24, x25, x26, x27, x28;
+    uintptr_t fp; // x29
+    uintptr_t pc; // x30, return address of the jl_fastctx_save call
+    uintptr_t sp;
+    uintptr_t d8, d9, d10, d11, d12, d13, d14, d15;
+#endif
+} jl_fastctx_t;
+// returns 0 when saving, 1 when resumed through jl_fastctx_restore
+int __attribute__((__returns_twice__)) jl_fastctx_save(jl_fastctx_t *ctx) JL_NOTSAFEPOINT;
+void JL_NORETURN jl_fastctx_restore(jl_fastctx_t *ctx) JL_NOTSAFEPOINT;
+#endif
+
 // *to is NULL or malloc'd pointer, from is allowed to be NULL
 STATIC_INLINE char *jl_copy_str(char **to, const char *from) JL_NOTSAFEPOINT
 {
@@ -1278,6 +1405,7 @@ JL_DLLEXPORT void *jl_get_library_(const char *f_lib, int throw_err);
 void *jl_find_dynamic_library_by_addr(void *symbol);
 #define jl_get_library(f_lib) jl_get_library_(f_lib, 1)
 JL_DLLEXPORT void *jl_load_and_lookup(const char *f_lib, const char *f_name, _Atomic(void*) *hnd);
+JL_DLLEXPORT void *jl_lookup_existing_symbol(const char *f_lib, const char *f_name);
 JL_DLLEXPORT void *jl_lazy_load_and_lookup(jl_value_t *lib_val, const char *f_name);
 JL_DLLEXPORT jl_value_t *jl_get_cfunction_trampoline(
     jl_value_t *fobj, jl_datatype_t *result, htable_t *cache, jl_svec_t *fill,
@@ -1626,8 +1754,15 @@ JL_DLLEXPORT enum jl_memory_order jl_get_atomic_order_checked(jl_sym_t *order, c
 
 struct _jl_image_fptrs_t;
 
+// Coverage and malloc-log counters are replicated JL_LOGDATA_NSTRIPES times,
+// with the replicas of one line spaced JL_LOGDATA_BLOCKSIZE counters apart so
+// threads increment disjoint cache lines; stripes are summed at writeout.
+// The layout is shared between coverage.cpp and the codegen of visitLine.
+#define JL_LOGDATA_BLOCKSIZE 32
+#define JL_LOGDATA_NSTRIPES 8
 JL_DLLEXPORT void jl_write_coverage_data(const char*);
 void jl_write_malloc_log(void);
+void jl_write_trace_compile_sorted(void);
 
 #if jl_has_builtin(__builtin_unreachable) || defined(_COMPILER_GCC_) || defined(_COMPILER_INTEL_)
 #  define jl_unreachable() __builtin_unreachable()
@@ -1636,6 +1771,7 @@ void jl_write_malloc_log(void);
 #endif
 
 jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT;
+void _jl_symbols_intern_packed(const char *buf, size_t nbytes, arraylist_t *out);
 
 // Tools for locally disabling spurious compiler warnings
 //
@@ -1685,8 +1821,6 @@ jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT;
 //JL_DLLEXPORT float julia__truncdfbf2(double param) JL_NOTSAFEPOINT;
 //JL_DLLEXPORT double julia__extendhfdf2(half n) JL_NOTSAFEPOINT;
 
-JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len);
-
 // -- exports from codegen -- //
 
 #define IR_FLAG_INBOUNDS 0x01
@@ -1694,6 +1828,8 @@ JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len);
 JL_DLLIMPORT jl_code_instance_t *jl_generate_fptr(jl_method_instance_t *mi JL_PROPAGATES_ROOT, size_t world);
 JL_DLLIMPORT void jl_generate_fptr_for_unspecialized(jl_code_instance_t *unspec);
 JL_DLLIMPORT void jl_generate_fptr_for_oc_wrapper(jl_code_instance_t *unspec);
+JL_DLLIMPORT void jl_enqueue_tier0_promotion(jl_code_instance_t *codeinst);
+JL_DLLIMPORT void jl_enqueue_reoptimization(jl_code_instance_t *codeinst);
 JL_DLLIMPORT int jl_compile_extern_c(LLVMOrcThreadSafeModuleRef llvmmod, void *params, void *sysimg, jl_value_t *declrt, jl_value_t *sigt);
 
 typedef struct {
@@ -1707,6 +1843,9 @@ JL_DLLIMPORT void jl_get_llvmf_defn(jl_llvmf_dump_t* dump, jl_method_instance_t
 JL_DLLIMPORT jl_value_t *jl_dump_fptr_asm(uint64_t fptr, char emit_mc, const char* asm_variant, const char *debuginfo, char binary);
 JL_DLLIMPORT jl_value_t *jl_dump_function_ir(jl_llvmf_dump_t *dump, char strip_ir_metadata, char dump_module, const char *debuginfo);
 JL_DLLIMPORT jl_value_t *jl_dump_function_asm(jl_llvmf_dump_t *dump, char emit_mc, const char* asm_variant, const char *debuginfo, char binary, char raw);
+// top-n most expensive compilations as svec(codeinst, time_ns) pairs, recorded
+// while compile-time measurement is enabled (see jitlayers.cpp)
+JL_DLLIMPORT jl_value_t *jl_compile_cost_report(size_t n);
 
 JL_DLLIMPORT void *jl_create_native(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvmmod, const jl_cgparams_t *cgparams, int policy, int imaging_mode, int cache, size_t world);
 JL_DLLIMPORT void jl_dump_native(void *native_code,
@@ -1722,6 +1861,9 @@ JL_DLLIMPORT void jl_register_fptrs(uint64_t image_base, const struct _jl_image_
 JL_DLLIMPORT void jl_init_codegen(void);
 JL_DLLIMPORT void jl_teardown_codegen(void) JL_NOTSAFEPOINT;
 JL_DLLIMPORT int jl_getFunctionInfo(jl_frame_t **frames, uintptr_t pointer, int skipC, int noInline) JL_NOTSAFEPOINT;
+// bumped (in debuginfo.cpp) whenever newly registered code may change what an
+// address resolves to; stamps the per-thread ip lookup cache (stackwalk.c)
+extern _Atomic(uint64_t) jl_debuginfo_generation;
 // n.b. this might be called from unmanaged thread:
 JL_DLLIMPORT uint64_t jl_getUnwindInfo(uint64_t dwBase);
 
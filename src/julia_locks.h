@@ -22,6 +22,21 @@ JL_DLLEXPORT int _jl_mutex_trylock_nogc(jl_task_t *self, jl_mutex_t *lock) JL_NO
 JL_DLLEXPORT int _jl_mutex_trylock(jl_task_t *self, jl_mutex_t *lock);
 JL_DLLEXPORT void _jl_mutex_unlock(jl_task_t *self, jl_mutex_t *lock);
 JL_DLLEXPORT void _jl_mutex_unlock_nogc(jl_mutex_t *lock) JL_NOTSAFEPOINT;
+// Per-name lock contention statistics (see threading.c). Wait times are
+// log2-bucketed: wait_hist[i] counts slow-path acquires that waited
+// [2^i, 2^(i+1)) microseconds, with the last bucket open-ended.
+#define JL_LOCK_WAIT_NHIST 16
+typedef struct {
+    const char *name;
+    uint64_t nacquired;  // acquisitions (excluding recursive re-entries)
+    uint64_t ncontended; // acquires that had to take the slow path
+    uint64_t nparked;    // times a waiter parked in the kernel
+    uint64_t spin_iters; // cumulative slow-path spin iterations
+    uint64_t wait_hist[JL_LOCK_WAIT_NHIST];
+} jl_lock_stats_t;
+// Copy up to `len` per-name counter buckets into `stats`; returns the
+// number of populated buckets (which may exceed `len`).
+JL_DLLEXPORT size_t jl_lock_stats(jl_lock_stats_t *stats, size_t len) JL_NOTSAFEPOINT;
 
 static inline void jl_mutex_wait(jl_mutex_t *lock, int safepoint)
 {
@@ -18,6 +18,8 @@ extern "C" {
 
 JL_DLLEXPORT int16_t jl_threadid(void);
 JL_DLLEXPORT int8_t jl_threadpoolid(int16_t tid) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_numa_node_count(void) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int8_t jl_threadnumanode(int16_t tid) JL_NOTSAFEPOINT;
 
 // JULIA_ENABLE_THREADING may be controlled by altering JULIA_THREADS in Make.user
 
@@ -116,16 +118,38 @@ typedef pthread_t jl_thread_t;
 
 struct _jl_task_t;
 
-// Recursive spin lock
+// On 64-bit Linux the mutex carries a 32-bit futex word so contended waiters
+// can park in the kernel on a per-lock wait queue. The word lives in what
+// would otherwise be struct padding: the hidden-field layouts in jltypes.c
+// assume a jl_mutex_t is exactly two pointer words.
+#if defined(_OS_LINUX_) && defined(_P64)
+#define JL_MUTEX_FUTEX
+#endif
+
+// Recursive adaptive lock
 typedef struct {
     _Atomic(struct _jl_task_t*) owner;
-    uint32_t count;
+    uint16_t count;
+    uint16_t statsidx; // contention-statistics bucket, see jl_lock_stats
+#ifdef JL_MUTEX_FUTEX
+    // 0 = unlocked, 1 = locked, 2 = locked and waiters may be parked
+    _Atomic(uint32_t) futex;
+#endif
 } jl_mutex_t;
 
 typedef struct {
     jl_taggedvalue_t *freelist;   // root of list of free objects
     jl_taggedvalue_t *newpages;   // root of list of chunks of free objects
     uint16_t osize;      // size of objects in this pool
+    // cumulative bytes allocated from this pool, never reset; only written
+    // by the owning thread, summed across threads by jl_gc_timeline_sample
+    uint64_t alloc_bytes;
+    // multi-page contiguous bump region (JULIA_GC_TLAB_MB); page metadata
+    // for the consumed pages is materialized when a collection begins
+    char *tlab_pos;  // next free cell, or NULL when no region is active
+    char *tlab_end;  // end of the region's last page
+    char *tlab_base; // data of the first page not yet registered with the GC
+    struct _jl_gc_pagemeta_t *tlab_meta; // metadata of the `tlab_base` page
 } jl_gc_pool_t;
 
 typedef struct {
@@ -153,6 +177,20 @@ typedef struct {
     // variables for tracking big objects
     struct _bigval_t *big_objects;
 
+    // buffer of overwritten references logged by the snapshot-at-the-beginning
+    // barrier while a concurrent mark window is active; contains jl_value_t*
+    arraylist_t satb_buffer;
+
+    // innermost open allocation arena of this thread, if any
+    // (see `jl_gc_arena_open` in gc.c)
+    struct _jl_gc_arena_t *current_arena;
+
+    // card-marked old GenericMemory objects, dirtied by the slot-aware write
+    // barrier; contains jl_gc_memory_cards_t*
+    arraylist_t memory_cards;
+    // owner -> jl_gc_memory_cards_t* index over `memory_cards`
+    htable_t memory_card_table;
+
     // variables for tracking "remembered set"
     arraylist_t _remset[2]; // contains jl_value_t*
     // lower bound of the number of pointers inside remembered values
@@ -166,6 +204,10 @@ typedef struct {
 
 #define JL_N_STACK_POOLS 16
     small_arraylist_t free_stacks[JL_N_STACK_POOLS];
+
+    // dead task objects claimed during stack sweeping, kept alive for reuse
+    // by jl_new_task (see gc_claim_dead_task in gc.c)
+    small_arraylist_t free_tasks;
 } jl_thread_heap_t;
 
 typedef struct {
@@ -199,6 +241,16 @@ typedef struct {
     _Atomic(struct _jl_gc_pagemeta_t *) bottom;
 } jl_gc_page_stack_t;
 
+// One slot of the per-thread debug info lookup cache (see
+// jl_lookup_code_address in stackwalk.c)
+typedef struct _jl_ip_lookup_entry_t {
+    uintptr_t ip;  // 0 when the slot is empty
+    uint64_t gen;  // jl_debuginfo_generation the entry was filled under
+    int skipC;
+    int nframes;
+    struct _jl_frame_t *frames; // malloc'd; the strings are owned by the entry
+} jl_ip_lookup_entry_t;
+
 // This includes all the thread local states we care about for a thread.
 // Changes to TLS field types must be reflected in codegen.
 #define JL_MAX_BT_SIZE 80000
@@ -264,6 +316,8 @@ typedef struct _jl_tls_states_t {
     arraylist_t finalizers;
     jl_gc_page_stack_t page_metadata_allocd;
     jl_gc_page_stack_t page_metadata_buffered;
+    // pages whose sweep was deferred to allocation time (JULIA_GC_LAZY_SWEEP)
+    jl_gc_page_stack_t page_metadata_lazy_sweep;
     jl_gc_markqueue_t mark_queue;
     jl_gc_mark_cache_t gc_cache;
     arraylist_t sweep_objs;
@@ -272,6 +326,71 @@ typedef struct _jl_tls_states_t {
     // Access via jl_exception_occurred().
     struct _jl_value_t *previous_exception;
 
+    // Thread-local leaf-type dispatch cache, probed before the shared
+    // `call_cache`. Set-associative with the ways of each set kept in LRU
+    // order; only ever written by the owning thread. Scanned for GC roots.
+#define JL_DISPATCH_CACHE_SETS 256
+#define JL_DISPATCH_CACHE_WAYS 4
+    struct _jl_typemap_entry_t *dispatch_cache[JL_DISPATCH_CACHE_SETS][JL_DISPATCH_CACHE_WAYS];
+
+    // Spare typemap level nodes, refilled in one burst by jl_new_typemap_level
+    // (typemap.c) so the interior nodes of a typemap tree come from the same
+    // freshly carved GC pool page instead of being interleaved with the
+    // entries and svecs allocated between levels. Scanned for GC roots.
+#define JL_TYPEMAP_LEVEL_POOL_LEN 16
+    struct _jl_typemap_level_t *typemap_level_pool[JL_TYPEMAP_LEVEL_POOL_LEN];
+    int typemap_level_pool_len;
+
+    // Memoized jl_type_morespecific verdicts (subtype.c), keyed by the
+    // pointer identity of the signature pair. Specificity is structural, so
+    // a verdict never changes for a given pair of type objects, and both
+    // keys are scanned as GC roots so an entry cannot dangle. Direct-mapped,
+    // only ever written by the owning thread.
+#define JL_MORESPEC_CACHE_SLOTS 256
+    struct {
+        struct _jl_value_t *a;
+        struct _jl_value_t *b;
+        uint8_t result;
+    } morespec_cache[JL_MORESPEC_CACHE_SLOTS];
+
+    // Direct-mapped cache of debug info lookups keyed by instruction pointer
+    // (see jl_lookup_code_address in stackwalk.c). Entries are dropped when
+    // newly registered code could change what an address resolves to; the
+    // `linfo` of each cached frame is scanned as a GC root.
+#define JL_IP_LOOKUP_CACHE_SLOTS 256
+    jl_ip_lookup_entry_t ip_lookup_cache[JL_IP_LOOKUP_CACHE_SLOTS];
+
+    // Approximate invocation counters for tier-0 (interpreted) code instances
+    // under `--compile=tiered`. Direct-mapped by pointer: a collision merely
+    // restarts a count, and entries are compared but never dereferenced, so
+    // stale pointers are harmless. Not scanned for GC roots.
+#define JL_TIER0_COUNTER_SLOTS 256
+    struct {
+        struct _jl_code_instance_t *ci;
+        uint32_t count;
+    } tier0_counters[JL_TIER0_COUNTER_SLOTS];
+
+    // Adaptive spin budget (in ns) the scheduler burns in `jl_task_get_next`
+    // before parking the thread, bounded above by `sleep_threshold`. Grown
+    // when a sleeping thread is woken again quickly (parking was premature)
+    // and shrunk after long sleeps. Only accessed by the owning thread.
+    uint64_t sched_spin_ns;
+
+    // LIFO slot: holds the task most recently spawned by this thread, to be
+    // run ahead of the multiqueue while its working set is still hot in this
+    // core's cache. Never visible to other threads' schedulers (no stealing);
+    // written and consumed only by the owning thread, scanned for GC roots.
+    struct _jl_task_t *lifo_slot;
+    // number of consecutive tasks taken from lifo_slot, for fairness capping
+    uint16_t lifo_streak;
+
+    // time-to-safepoint diagnostics: stamped when this thread blocks in
+    // jl_safepoint_wait_gc, read by the GC thread to attribute stragglers
+    // (see jl_safepoint_ttsp_stats). A thread that stops by sitting in a
+    // GC-safe region (e.g. a blocking ccall) never updates these.
+    uint64_t safepoint_arrival_ns;
+    void *safepoint_arrival_pc;
+
     // currently-held locks, to be released when an exception is thrown
     small_arraylist_t locks;
 
@@ -378,6 +497,7 @@ extern JL_DLLEXPORT _Atomic(int) jl_gc_have_pending_finalizers;
 JL_DLLEXPORT int8_t jl_gc_is_in_finalizer(void) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT void jl_wakeup_thread(int16_t tid);
+JL_DLLEXPORT void jl_wakeup_threads(int16_t n);
 
 #ifdef __cplusplus
 }
@@ -47,6 +47,7 @@ STATISTIC(RemovedAllocs, "Total number of heap allocations elided");
 STATISTIC(DeletedAllocs, "Total number of heap allocations fully deleted");
 STATISTIC(SplitAllocs, "Total number of allocations split into registers");
 STATISTIC(StackAllocs, "Total number of allocations moved to the stack");
+STATISTIC(SunkAllocs, "Total number of allocations sunk into their use blocks");
 STATISTIC(RemovedTypeofs, "Total number of typeofs removed");
 STATISTIC(RemovedWriteBarriers, "Total number of write barriers removed");
 STATISTIC(RemovedGCPreserve, "Total number of GC preserve instructions removed");
@@ -140,6 +141,7 @@ private:
     void replaceIntrinsicUseWith(IntrinsicInst *call, Intrinsic::ID ID,
                                  Instruction *orig_i, Instruction *new_i);
     void removeAlloc(CallInst *orig_inst);
+    bool sinkAlloc(CallInst *orig_inst);
     void moveToStack(CallInst *orig_inst, size_t sz, bool has_ref, AllocFnKind allockind);
     void initializeAlloca(IRBuilder<> &prolog_builder, AllocaInst *buff, AllocFnKind allockind);
     void splitOnStack(CallInst *orig_inst);
@@ -191,6 +193,7 @@ private:
 
     SetVector<std::pair<CallInst*,size_t>> worklist;
     SmallVector<CallInst*,6> removed;
+    bool sunk = false;
     AllocUseInfo use_info;
     CheckInst::Stack check_stack;
     Lifetime::Stack lifetime_stack;
@@ -229,6 +232,7 @@ void Optimizer::optimizeAll()
             });
             if (use_info.hastypeof)
                 optimizeTag(orig);
+            sinkAlloc(orig);
             continue;
         }
         if (use_info.haserror || use_info.returned) {
@@ -238,6 +242,7 @@ void Optimizer::optimizeAll()
             });
             if (use_info.hastypeof)
                 optimizeTag(orig);
+            sinkAlloc(orig);
             continue;
         }
         if (!use_info.addrescaped && !use_info.hasload && (!use_info.haspreserve ||
@@ -273,6 +278,7 @@ void Optimizer::optimizeAll()
             });
             if (use_info.hastypeof)
                 optimizeTag(orig);
+            sinkAlloc(orig);
             continue;
         }
         if (!use_info.hasunknownmem && !use_info.addrescaped) {
@@ -296,7 +302,7 @@ void Optimizer::optimizeAll()
 bool Optimizer::finalize()
 {
     if (removed.empty())
-        return false;
+        return sunk;
     for (auto inst: removed)
         inst->eraseFromParent();
     return true;
@@ -886,6 +892,66 @@ void Optimizer::removeAlloc(CallInst *orig_inst)
     }
 }
 
+// The allocation could not be elided, but if all of its uses sit below a
+// branch (e.g. an object that is only boxed on an error path), sink it down
+// to the nearest common dominator of its users so the paths that never touch
+// it do not pay for it.
+bool Optimizer::sinkAlloc(CallInst *orig_inst)
+{
+    auto orig_bb = orig_inst->getParent();
+    auto &DT = getDomTree();
+    BasicBlock *dest = nullptr;
+    for (auto &use: orig_inst->uses()) {
+        auto user = cast<Instruction>(use.getUser());
+        // a phi uses the value at the end of the incoming block
+        auto bb = isa<PHINode>(user) ?
+            cast<PHINode>(user)->getIncomingBlock(use) : user->getParent();
+        if (!DT.isReachableFromEntry(bb))
+            continue;
+        dest = dest ? DT.findNearestCommonDominator(dest, bb) : bb;
+    }
+    if (!dest || dest == orig_bb)
+        return false;
+    assert(DT.dominates(orig_bb, dest));
+    // Moving the allocation into a cycle that does not also contain its
+    // current block would allocate a fresh object on every iteration; make
+    // sure `dest` cannot re-execute without going through `orig_bb` again.
+    SmallPtrSet<BasicBlock*, 16> visited;
+    SmallVector<BasicBlock*, 16> stack(succ_begin(dest), succ_end(dest));
+    while (!stack.empty()) {
+        auto bb = stack.pop_back_val();
+        if (bb == orig_bb)
+            continue;
+        if (bb == dest)
+            return false;
+        if (visited.insert(bb).second)
+            stack.append(succ_begin(bb), succ_end(bb));
+    }
+    // Insert before the first user in `dest` (phi users count as uses in the
+    // incoming block, so none can precede the insertion point), or before the
+    // terminator when all users live further down.
+    BasicBlock::iterator it = dest->getFirstInsertionPt();
+    for (; &*it != dest->getTerminator(); ++it) {
+        bool isuser = false;
+        for (auto &op: it->operands()) {
+            if (op.get() == orig_inst) {
+                isuser = true;
+                break;
+            }
+        }
+        if (isuser)
+            break;
+    }
+    orig_inst->moveBefore(&*it);
+    ++SunkAllocs;
+    sunk = true;
+    REMARK([&]() {
+        return OptimizationRemark(DEBUG_TYPE, "Sunk Allocation", orig_inst)
+            << "GC allocation sunk into its use block " << ore::NV("GC Allocation", orig_inst);
+    });
+    return true;
+}
+
 // Unable to optimize out the allocation, do store to load forwarding on the tag instead.
 void Optimizer::optimizeTag(CallInst *orig_inst)
 {
@@ -304,14 +304,14 @@ struct JuliaLICM : public JuliaPassContext {
                         });
                         continue;
                     }
-                    if (use_info.addrescaped) {
-                        REMARK([&](){
-                            return OptimizationRemarkMissed(DEBUG_TYPE, "Escape", call)
-                                << "not hoisting gc allocation " << ore::NV("GC Allocation", call)
-                                << " because its address may escape";
-                        });
-                        continue;
-                    }
+                    // If the address is taken and handed to a call (typically a
+                    // buffer filled in by a ccall), the object itself still
+                    // does not escape, so it can be reused across iterations
+                    // the same way alloc-opt reuses a single alloca for it; we
+                    // just have to re-clear it once per iteration instead of
+                    // once in the preheader so stale contents from the
+                    // previous iteration are not observable.
+                    bool reinit_in_loop = use_info.addrescaped;
                     if (use_info.refstore) {
                         // We need to add write barriers to any stores
                         // that may start crossing generations
@@ -327,15 +327,23 @@ struct JuliaLICM : public JuliaPassContext {
                             << "hoisting gc allocation " << ore::NV("GC Allocation", call);
                     });
                     ++HoistedAllocation;
+                    // The clear goes at the start of the block that used to
+                    // allocate when the object must be re-initialized per
+                    // iteration (no use can precede the old allocation point,
+                    // so clearing at the block head is always early enough).
+                    BasicBlock *orig_bb = call->getParent();
                     moveInstructionBefore(*call, *preheader->getTerminator(), MSSAU, SE);
-                    IRBuilder<> builder(preheader->getTerminator());
+                    Instruction *clear_pt = reinit_in_loop ?
+                        &*orig_bb->getFirstInsertionPt() : preheader->getTerminator();
+                    IRBuilder<> builder(clear_pt);
                     builder.SetCurrentDebugLocation(call->getDebugLoc());
                     auto obj_i8 = builder.CreateBitCast(call, Type::getInt8PtrTy(call->getContext(), call->getType()->getPointerAddressSpace()));
                     // Note that this alignment is assuming the GC allocates at least pointer-aligned memory
                     auto align = Align(DL.getPointerSize(0));
                     auto clear_obj = builder.CreateMemSet(obj_i8, ConstantInt::get(Type::getInt8Ty(call->getContext()), 0), call->getArgOperand(1), align);
                     if (MSSAU.getMemorySSA()) {
-                        auto clear_mdef = MSSAU.createMemoryAccessInBB(clear_obj, nullptr, clear_obj->getParent(), MemorySSA::BeforeTerminator);
+                        auto clear_mdef = MSSAU.createMemoryAccessInBB(clear_obj, nullptr, clear_obj->getParent(),
+                                reinit_in_loop ? MemorySSA::Beginning : MemorySSA::BeforeTerminator);
                         MSSAU.insertDef(cast<MemoryDef>(clear_mdef), true);
                     }
                     changed = true;
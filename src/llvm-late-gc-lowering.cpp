@@ -351,6 +351,9 @@ private:
     void PlaceGCFrameStores(State &S, unsigned MinColorRoot, ArrayRef<int> Colors, Value *GCFrame);
     void PlaceRootsAndUpdateCalls(SmallVectorImpl<int> &Colors, State &S, std::map<Value *, std::pair<int, int>>);
     bool CleanupIR(Function &F, State *S, bool *CFGModified);
+    bool MayBeSafepoint(Instruction *I);
+    bool NoSafepointInRange(BasicBlock::iterator begin, BasicBlock::iterator end);
+    bool AllocStillYoungAt(CallInst *Alloc, Instruction *Barrier, Function &F);
     void NoteUseChain(State &S, BBState &BBS, User *TheUser);
     SmallVector<int, 1> GetPHIRefinements(PHINode *phi, State &S);
     void FixUpRefinements(ArrayRef<int> PHINumbers, State &S);
@@ -2306,6 +2309,113 @@ MDNode *createMutableTBAAAccessTag(MDNode *Tag) {
     return MDBuilder(Tag->getContext()).createMutableTBAAAccessTag(Tag);
 }
 
+// Conservatively determine whether `I` might reach a GC safepoint. This runs
+// after the main CleanupIR loop has already rewritten calls, so the safepoint
+// numbering computed during liveness cannot be consulted; instead this mirrors
+// the set of known non-safepoint calls recognized by LocalScan and treats
+// every other call as a potential safepoint.
+bool LateLowerGCFrame::MayBeSafepoint(Instruction *I)
+{
+    auto *CI = dyn_cast<CallInst>(I);
+    if (!CI)
+        return false;
+    if (isa<IntrinsicInst>(CI))
+        return false; // intrinsics are never safepoints
+    if (Function *callee = CI->getCalledFunction()) {
+        if (callee == pointer_from_objref_func || callee == gc_preserve_begin_func ||
+            callee == gc_preserve_end_func || callee == typeof_func ||
+            callee == pgcstack_getter || callee->getName() == XSTR(jl_egal__unboxed) ||
+            callee->getName() == XSTR(jl_lock_value) || callee->getName() == XSTR(jl_unlock_value) ||
+            callee == write_barrier_func || callee == gc_loaded_func ||
+            callee->getName() == "memcmp") {
+            return false;
+        }
+    }
+#if JL_LLVM_VERSION >= 160000
+    if (CI->getMemoryEffects().onlyReadsMemory() ||
+        CI->getMemoryEffects().onlyAccessesArgPointees())
+        return false;
+#else
+    if (CI->hasFnAttr(Attribute::ArgMemOnly) ||
+        CI->hasFnAttr(Attribute::ReadNone) ||
+        CI->hasFnAttr(Attribute::ReadOnly))
+        return false;
+#endif
+    return true;
+}
+
+bool LateLowerGCFrame::NoSafepointInRange(BasicBlock::iterator begin, BasicBlock::iterator end)
+{
+    for (auto it = begin; it != end; ++it) {
+        if (MayBeSafepoint(&*it))
+            return false;
+    }
+    return true;
+}
+
+// Prove that `Alloc` is still a young object when `Barrier` executes, i.e.
+// that no safepoint can run between the allocation and the barrier. A fresh
+// object only becomes old-marked after surviving collections, and collections
+// only happen at safepoints, so on success the barrier's "parent is old"
+// fast-path test is statically false and the barrier can be dropped entirely.
+// Object initialization is frequently spread over several basic blocks
+// (branches for optional/default fields), so this follows the CFG backwards
+// from the barrier instead of requiring the two to sit in the same block.
+bool LateLowerGCFrame::AllocStillYoungAt(CallInst *Alloc, Instruction *Barrier, Function &F)
+{
+    BasicBlock *AB = Alloc->getParent();
+    BasicBlock *BB = Barrier->getParent();
+    if (AB == BB) {
+        // Every execution of the barrier sees the allocation made earlier in
+        // the same iteration of this block, so only the range between the two
+        // matters, even if the block is inside a loop.
+        return Alloc->comesBefore(Barrier) &&
+               NoSafepointInRange(std::next(Alloc->getIterator()), Barrier->getIterator());
+    }
+    // Walk the CFG backwards from the barrier. Paths through the allocation's
+    // block re-execute the allocation and define a fresh object, so the walk
+    // stops there (after checking the block's suffix). Interior blocks must be
+    // entirely safepoint-free. Reaching the entry block some other way means
+    // the allocation does not dominate the barrier; give up in that case.
+    const unsigned MaxRegionBlocks = 64; // keep compile time bounded
+    SmallPtrSet<BasicBlock*, 8> Visited;
+    SmallVector<BasicBlock*, 8> WorkList(pred_begin(BB), pred_end(BB));
+    bool SawAlloc = false;
+    bool BarrierOnCycle = false;
+    while (!WorkList.empty()) {
+        BasicBlock *Cur = WorkList.pop_back_val();
+        if (!Visited.insert(Cur).second)
+            continue;
+        if (Visited.size() > MaxRegionBlocks)
+            return false;
+        if (Cur == AB) {
+            SawAlloc = true;
+            if (!NoSafepointInRange(std::next(Alloc->getIterator()), AB->end()))
+                return false;
+            continue;
+        }
+        if (Cur == BB) {
+            // the barrier re-executes after going around this cycle, so its
+            // block's suffix matters too (checked below)
+            BarrierOnCycle = true;
+            continue;
+        }
+        if (Cur == &F.getEntryBlock())
+            return false;
+        if (!NoSafepointInRange(Cur->begin(), Cur->end()))
+            return false;
+        for (BasicBlock *Pred : predecessors(Cur))
+            WorkList.push_back(Pred);
+    }
+    if (!SawAlloc)
+        return false;
+    if (!NoSafepointInRange(BB->begin(), Barrier->getIterator()))
+        return false;
+    if (BarrierOnCycle && !NoSafepointInRange(Barrier->getIterator(), BB->end()))
+        return false;
+    return true;
+}
+
 bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
     auto T_int32 = Type::getInt32Ty(F.getContext());
     auto T_size = F.getParent()->getDataLayout().getIntPtrType(F.getContext());
@@ -2559,6 +2669,18 @@ bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
             CI->eraseFromParent();
             continue;
         }
+        // The barrier is also dead when the parent is a fresh allocation that
+        // is provably still young here (no intervening safepoint on any path),
+        // which covers initialization spread across several basic blocks.
+        if (Function *alloc_bytes = getOrNull(jl_intrinsics::GCAllocBytes)) {
+            if (auto *AllocCI = dyn_cast<CallInst>(parent->stripPointerCastsAndAliases())) {
+                if (AllocCI->getCalledOperand() == alloc_bytes &&
+                        AllocStillYoungAt(AllocCI, CI, F)) {
+                    CI->eraseFromParent();
+                    continue;
+                }
+            }
+        }
         if (CFGModified) {
             *CFGModified = true;
         }
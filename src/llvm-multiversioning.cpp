@@ -13,6 +13,7 @@
 
 #include <llvm/Pass.h>
 #include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/Statistic.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/IR/Module.h>
@@ -180,6 +181,47 @@ struct TargetSpec {
     }
 };
 
+// Annotation surface for directing the cloning heuristics from Julia code: a
+// call to one of these no-op markers (typically emitted with `llvmcall`), or
+// the function attribute of the same name, forces resp. forbids cloning of
+// the containing function for the feature-gated (non-clone-all) targets.
+// The markers are consumed here and never survive to the cloning phase.
+static const char *const mv_force_marker = "julia.mv.force_clone";
+static const char *const mv_suppress_marker = "julia.mv.suppress_clone";
+
+static bool has_clone_marker(Function &F, StringRef name)
+{
+    if (F.hasFnAttribute(name))
+        return true;
+    for (auto &bb: F) {
+        for (auto &I: bb) {
+            if (auto call = dyn_cast<CallInst>(&I)) {
+                auto callee = call->getCalledFunction();
+                if (callee && callee->getName() == name)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void erase_clone_markers(Module &M)
+{
+    for (auto name: {mv_force_marker, mv_suppress_marker}) {
+        auto marker = M.getFunction(name);
+        if (!marker)
+            continue;
+        for (auto user: make_early_inc_range(marker->users())) {
+            if (auto call = dyn_cast<CallInst>(user)) {
+                if (call->getCalledFunction() == marker)
+                    call->eraseFromParent();
+            }
+        }
+        if (marker->use_empty())
+            marker->eraseFromParent();
+    }
+}
+
 static Optional<SmallVector<TargetSpec, 0>> get_target_specs(Module &M) {
     auto md = M.getModuleFlag("julia.mv.specs");
     if (!md)
@@ -226,8 +268,14 @@ static void annotate_module_clones(Module &M) {
     BitVector subtarget_cloned(orig_funcs.size());
 
     SmallVector<unsigned, 0> func_infos(orig_funcs.size());
+    BitVector forced(orig_funcs.size());
+    std::set<Function*> suppressed;
     for (unsigned i = 0; i < orig_funcs.size(); i++) {
         func_infos[i] = collect_func_info(*orig_funcs[i], TT, has_veccall);
+        if (has_clone_marker(*orig_funcs[i], mv_force_marker))
+            forced.set(i);
+        else if (has_clone_marker(*orig_funcs[i], mv_suppress_marker))
+            suppressed.insert(orig_funcs[i]);
     }
     for (unsigned i = 1; i < specs.size(); i++) {
         if (specs[i].flags & JL_TARGET_CLONE_ALL) {
@@ -238,7 +286,9 @@ static void annotate_module_clones(Module &M) {
             unsigned flag = specs[i].flags & clone_mask;
             std::set<Function*> sets[2];
             for (unsigned j = 0; j < orig_funcs.size(); j++) {
-                if (!(func_infos[j] & flag)) {
+                if (suppressed.count(orig_funcs[j]))
+                    continue;
+                if (!forced[j] && !(func_infos[j] & flag)) {
                     continue;
                 }
                 sets[0].insert(orig_funcs[j]);
@@ -260,6 +310,8 @@ static void annotate_module_clones(Module &M) {
                         // Already cloned
                         if (all_origs.count(orig_child_f))
                             continue;
+                        if (suppressed.count(orig_child_f))
+                            continue;
                         bool calling_clone = false;
                         for (const auto &I2: *child_node) {
                             auto orig_child_f2 = I2.second->getFunction();
@@ -327,6 +379,7 @@ static void annotate_module_clones(Module &M) {
     if (has_veccall) {
         M.addModuleFlag(Module::Max, "julia.mv.veccall", 1);
     }
+    erase_clone_markers(M);
     M.addModuleFlag(Module::Error, "julia.mv.annotated", 1);
 }
 
@@ -324,6 +324,10 @@ bool LowerPTLS::run(bool *CFGModified)
             auto call = cast<CallInst>(*it);
             ++it;
             auto f = call->getCaller();
+            // if the caller receives pgcstack as its swiftself argument
+            // (cgparams.gcstack_arg), it stays pinned in a register across
+            // Julia-to-Julia calls and no TLS access is needed; the TLS
+            // lowering below is only reached at entry from foreign code
             Value *pgcstack = NULL;
             for (Function::arg_iterator arg = f->arg_begin(); arg != f->arg_end();++arg) {
                 if (arg->hasSwiftSelfAttr()){
@@ -41,6 +41,8 @@ STATISTIC(ReductionChainLength, "Total sum of instructions folded from reduction
 STATISTIC(MaxChainLength, "Max length of reduction chain");
 STATISTIC(AddChains, "Addition reduction chains");
 STATISTIC(MulChains, "Multiply reduction chains");
+STATISTIC(MinMaxChains, "Min/max reduction chains");
+STATISTIC(CondAccumChains, "Conditional accumulation reduction chains");
 
 #ifndef __clang_gcanalyzer__
 #define REMARK(remark) ORE.emit(remark)
@@ -70,29 +72,37 @@ static unsigned getReduceOpcode(Instruction *J, Instruction *operand) JL_NOTSAFE
 }
 
 /// If Phi is part of a reduction cycle of FAdd, FSub, FMul or FDiv,
+/// a running min/max (fcmp+select), or a conditional accumulation
+/// (select between the updated and the previous value),
 /// mark the ops as permitting reassociation/commuting.
 /// As of LLVM 4.0, FDiv is not handled by the loop vectorizer
 static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRemarkEmitter &ORE, ScalarEvolution *SE) JL_NOTSAFEPOINT
 {
     typedef SmallVector<Instruction*, 8> chainVector;
     chainVector chain;
+    chainVector minmax; // fcmp/select pairs that additionally need nnan/nsz
     Instruction *J;
     unsigned opcode = 0;
+    bool condaccum = false;
     for (Instruction *I = Phi; ; I=J) {
         J = NULL;
-        // Find the user of instruction I that is within loop L.
+        Instruction *other = NULL;
+        // Find the users of instruction I that are within loop L.
         for (User *UI : I->users()) { /*}*/
             Instruction *U = cast<Instruction>(UI);
             if (L.contains(U)) {
-                if (J) {
-                    LLVM_DEBUG(dbgs() << "LSL: not a reduction var because op has two internal uses: " << *I << "\n");
+                if (!J)
+                    J = U;
+                else if (!other)
+                    other = U;
+                else {
+                    LLVM_DEBUG(dbgs() << "LSL: not a reduction var because op has several internal uses: " << *I << "\n");
                     REMARK([&]() {
                         return OptimizationRemarkMissed(DEBUG_TYPE, "NotReductionVar", U)
-                               << "not a reduction variable because operation has two internal uses";
+                               << "not a reduction variable because operation has several internal uses";
                     });
                     return;
                 }
-                J = U;
             }
         }
         if (!J) {
@@ -103,13 +113,63 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRe
             });
             return;
         }
+        unsigned stepopcode = 0;
+        Instruction *stepextra = NULL;
+        if (other) {
+            // Two internal uses are allowed if they form one of
+            //    select(fcmp(x, a), x, a)    a running min/max
+            //    select(p, x op a, x)        a conditional accumulation
+            // where `x` is the current chain value; the select carries the
+            // chain in both cases.
+            auto *S = dyn_cast<SelectInst>(isa<SelectInst>(J) ? J : other);
+            Instruction *O = (S == J) ? other : J;
+            if (!S || !O->hasOneUse()) {
+                LLVM_DEBUG(dbgs() << "LSL: not a reduction var because op has two internal uses: " << *I << "\n");
+                REMARK([&]() {
+                    return OptimizationRemarkMissed(DEBUG_TYPE, "NotReductionVar", S ? S : O)
+                           << "not a reduction variable because operation has two internal uses";
+                });
+                return;
+            }
+            Value *tv = S->getTrueValue();
+            Value *fv = S->getFalseValue();
+            if (auto *C = dyn_cast<FCmpInst>(O)) {
+                // min/max: the compared values are also the selected ones
+                bool armsmatch = (C->getOperand(0) == tv && C->getOperand(1) == fv) ||
+                                 (C->getOperand(0) == fv && C->getOperand(1) == tv);
+                if (S->getCondition() == C && armsmatch && (tv == I || fv == I)) {
+                    stepopcode = Instruction::Select;
+                    stepextra = C;
+                    minmax.push_back(C);
+                    minmax.push_back(S);
+                }
+            }
+            else if ((tv == O && fv == I) || (tv == I && fv == O)) {
+                // conditional accumulation: one arm applies the op, the
+                // other keeps the previous value
+                stepopcode = getReduceOpcode(O, I);
+                stepextra = O;
+                condaccum = true;
+            }
+            if (!stepopcode) {
+                LLVM_DEBUG(dbgs() << "LSL: chain broke at " << *S << " because of unrecognized select\n");
+                REMARK([&](){
+                    return OptimizationRemarkMissed(DEBUG_TYPE, "ChainBroke", S)
+                           << "chain broke at " << ore::NV("Instruction", S) << " because of unrecognized select";
+                });
+                return;
+            }
+            J = S;
+        }
         if (J == Phi) {
             // Found the entire chain.
             break;
         }
+        if (!other)
+            stepopcode = getReduceOpcode(J, I);
         if (opcode) {
             // Check that arithmetic op matches prior arithmetic ops in the chain.
-            if (getReduceOpcode(J, I) != opcode) {
+            if (stepopcode != opcode) {
                 LLVM_DEBUG(dbgs() << "LSL: chain broke at " << *J << " because of wrong opcode\n");
                 REMARK([&](){
                     return OptimizationRemarkMissed(DEBUG_TYPE, "ChainBroke", J)
@@ -120,7 +180,7 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRe
         }
         else {
             // First arithmetic op in the chain.
-            opcode = getReduceOpcode(J, I);
+            opcode = stepopcode;
             if (!opcode) {
                 LLVM_DEBUG(dbgs() << "LSL: first arithmetic op in chain is uninteresting" << *J << "\n");
                 REMARK([&]() {
@@ -130,6 +190,8 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRe
                 return;
             }
         }
+        if (stepextra)
+            chain.push_back(stepextra);
         chain.push_back(J);
     }
     switch (opcode) {
@@ -139,7 +201,12 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRe
         case Instruction::FMul:
             ++MulChains;
             break;
+        case Instruction::Select:
+            ++MinMaxChains;
+            break;
     }
+    if (condaccum)
+        ++CondAccumChains;
     ++ReductionChains;
     int length = 0;
     for (chainVector::const_iterator K=chain.begin(); K!=chain.end(); ++K) {
@@ -154,6 +221,14 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop &L, OptimizationRe
             SE->forgetValue(*K);
         ++length;
     }
+    // The vectorizer only recognizes an fcmp/select pair as a min/max
+    // recurrence when it also promises not to care about NaNs and signed
+    // zeros; @simd already allows the reduction to be reordered, and for
+    // min/max reordering is only observable in exactly those cases.
+    for (Instruction *K: minmax) {
+        K->setHasNoNaNs(true);
+        K->setHasNoSignedZeros(true);
+    }
     ReductionChainLength += length;
     MaxChainLength.updateMax(length);
 }
@@ -859,6 +859,7 @@ JL_DLLEXPORT jl_method_t *jl_new_method_uninit(jl_module_t *module)
     m->purity.bits = 0;
     m->max_varargs = UINT8_MAX;
     JL_MUTEX_INIT(&m->writelock, "method->writelock");
+    JL_MUTEX_INIT(&m->speclock, "method->speclock");
     return m;
 }
 
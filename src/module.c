@@ -41,6 +41,10 @@ JL_DLLEXPORT jl_module_t *jl_new_module_(jl_sym_t *name, jl_module_t *parent, ui
     JL_MUTEX_INIT(&m->lock, "module->lock");
     jl_atomic_store_relaxed(&m->bindings, jl_emptysvec);
     jl_atomic_store_relaxed(&m->bindingkeyset, (jl_genericmemory_t*)jl_an_empty_memory_any);
+    jl_atomic_store_relaxed(&m->usingindex, NULL);
+    jl_atomic_store_relaxed(&m->usingnegcache, NULL);
+    jl_atomic_store_relaxed(&m->usingnegkeyset, (jl_genericmemory_t*)jl_an_empty_memory_any);
+    jl_atomic_store_relaxed(&m->usingneggen, 0);
     arraylist_new(&m->usings, 0);
     if (jl_core_module && default_names) {
         JL_GC_PUSH1(&m);
@@ -286,16 +290,27 @@ typedef struct _modstack_t {
 
 static jl_binding_t *jl_resolve_owner(jl_binding_t *b/*optional*/, jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var, modstack_t *st);
 
-static inline jl_module_t *module_usings_getidx(jl_module_t *m JL_PROPAGATES_ROOT, size_t i) JL_NOTSAFEPOINT;
+static inline jl_module_t *module_usings_getidx(jl_module_t *m JL_PROPAGATES_ROOT, void **items, size_t i) JL_NOTSAFEPOINT;
 
 #ifndef __clang_gcanalyzer__
 // The analyzer doesn't like looking through the arraylist, so just model the
 // access for it using this function
-static inline jl_module_t *module_usings_getidx(jl_module_t *m JL_PROPAGATES_ROOT, size_t i) JL_NOTSAFEPOINT {
-    return (jl_module_t*)m->usings.items[i];
+static inline jl_module_t *module_usings_getidx(jl_module_t *m JL_PROPAGATES_ROOT, void **items, size_t i) JL_NOTSAFEPOINT {
+    return (jl_module_t*)items[i];
 }
 #endif
 
+// Take a snapshot of m->usings for iteration without the module lock.
+// jl_module_using publishes a grown items array (fully populated with the old
+// entries) before advancing len, so entries [0, len) of an items array loaded
+// after len are always valid; appends made after the snapshot are not seen.
+static inline size_t module_usings_snapshot(jl_module_t *m, void ***items) JL_NOTSAFEPOINT
+{
+    size_t len = jl_atomic_load_acquire((_Atomic(size_t)*)&m->usings.len);
+    *items = jl_atomic_load_acquire((_Atomic(void**)*)&m->usings.items);
+    return len;
+}
+
 static int eq_bindings(jl_binding_t *owner, jl_binding_t *alias)
 {
     assert(owner == jl_atomic_load_relaxed(&owner->owner));
@@ -309,20 +324,209 @@ static int eq_bindings(jl_binding_t *owner, jl_binding_t *alias)
     return 0;
 }
 
+// generation counter for the per-module merged export indexes: bumped on
+// every new `export` and every new `using` edge, anywhere. an index records
+// the generation it was built at and is rebuilt on the next lookup after a
+// mismatch, so invalidation is a single counter increment.
+static _Atomic(uint64_t) jl_export_generation = 1;
+
+static jl_sym_t *usingindex_name(jl_value_t *entry) JL_NOTSAFEPOINT
+{
+    if (jl_is_svec(entry))
+        entry = jl_svecref(entry, 0);
+    return ((jl_binding_t*)entry)->globalref->name;
+}
+
+static uint_t usingindex_hash(size_t idx, jl_value_t *data)
+{
+    return usingindex_name(jl_svecref(data, idx))->hash;
+}
+
+static int usingindex_eq(size_t idx, const void *var, jl_value_t *data, uint_t hv)
+{
+    return (jl_sym_t*)var == usingindex_name(jl_svecref(data, idx));
+}
+
+// build the merged export index for m: svec(generation, keyset, candidates),
+// where candidates[i] is the exported binding for some name, or a svec of
+// such bindings (in scan order: last `using` first) when several used
+// modules export the same name. with the index, resolving an unqualified
+// global is one hash lookup instead of a probe of every used module's
+// binding table, which made first-touch resolution quadratic-ish for
+// namespaces with many `using`s.
+static jl_svec_t *usingindex_build(jl_module_t *m)
+{
+    uint64_t gen = jl_atomic_load_acquire(&jl_export_generation);
+    void **items = NULL;
+    size_t nusings = module_usings_snapshot(m, &items);
+    // count an upper bound on the number of candidate slots
+    size_t maxn = 0;
+    for (size_t i = 0; i < nusings; i++) {
+        jl_module_t *imp = module_usings_getidx(m, items, i);
+        jl_svec_t *table = jl_atomic_load_relaxed(&imp->bindings);
+        for (size_t j = 0; j < jl_svec_len(table); j++) {
+            jl_binding_t *tempb = (jl_binding_t*)jl_svecref(table, j);
+            if ((void*)tempb == jl_nothing)
+                break;
+            if (tempb->exportp)
+                maxn++;
+        }
+    }
+    jl_svec_t *data = NULL;
+    jl_svec_t *merged = NULL;
+    jl_svec_t *index = NULL;
+    jl_value_t *genval = NULL;
+    _Atomic(jl_genericmemory_t*) keyset;
+    jl_atomic_store_relaxed(&keyset, (jl_genericmemory_t*)jl_an_empty_memory_any);
+    JL_GC_PUSH5(&data, &merged, &index, &genval, &keyset);
+    data = jl_alloc_svec(maxn);
+    size_t n = 0;
+    for (size_t i = nusings; i > 0; i--) { // scan order: last `using` first
+        jl_module_t *imp = module_usings_getidx(m, items, i - 1);
+        jl_svec_t *table = jl_atomic_load_relaxed(&imp->bindings);
+        for (size_t j = 0; j < jl_svec_len(table); j++) {
+            jl_binding_t *tempb = (jl_binding_t*)jl_svecref(table, j);
+            if ((void*)tempb == jl_nothing)
+                break;
+            if (!tempb->exportp)
+                continue;
+            if (n >= maxn)
+                // exports were added concurrently; they bumped the
+                // generation, so this index is already stale and will be
+                // rebuilt on the next lookup
+                break;
+            jl_sym_t *var = tempb->globalref->name;
+            ssize_t idx = jl_smallintset_lookup(jl_atomic_load_relaxed(&keyset), usingindex_eq,
+                                                var, (jl_value_t*)data, var->hash, 0);
+            if (idx == -1) {
+                jl_svecset(data, n, tempb);
+                jl_smallintset_insert(&keyset, NULL, usingindex_hash, n, (jl_value_t*)data);
+                n++;
+            }
+            else {
+                // another used module already exports this name; widen the
+                // slot to the list of candidates, preserving scan order
+                jl_value_t *entry = jl_svecref(data, idx);
+                size_t nc = jl_is_svec(entry) ? jl_svec_len(entry) : 1;
+                merged = jl_alloc_svec_uninit(nc + 1);
+                if (jl_is_svec(entry))
+                    memcpy(jl_svec_data(merged), jl_svec_data(entry), nc * sizeof(void*));
+                else
+                    jl_svec_data(merged)[0] = entry;
+                jl_svec_data(merged)[nc] = (jl_value_t*)tempb;
+                jl_svecset(data, idx, merged);
+            }
+        }
+    }
+    genval = jl_box_uint64(gen);
+    index = jl_alloc_svec(3);
+    jl_svecset(index, 0, genval);
+    jl_svecset(index, 1, jl_atomic_load_relaxed(&keyset));
+    jl_svecset(index, 2, data);
+    // a racing builder may publish its own (equivalent) index; last one wins
+    jl_atomic_store_release(&m->usingindex, index);
+    jl_gc_wb(m, index);
+    JL_GC_POP();
+    return index;
+}
+
+static uint_t usingneg_hash(size_t idx, jl_value_t *data)
+{
+    return ((jl_sym_t*)jl_svecref(data, idx))->hash;
+}
+
+static int usingneg_eq(size_t idx, const void *var, jl_value_t *data, uint_t hv)
+{
+    return (jl_sym_t*)var == (jl_sym_t*)jl_svecref(data, idx);
+}
+
+// record that, as of export generation `gen`, no module in m's `usings`
+// exported `var`; readers honor the entry only while the current generation
+// still equals `gen`, so a later `export` or `using` anywhere retires it
+static void usingneg_insert(jl_module_t *m, jl_sym_t *var, uint64_t gen)
+{
+    JL_LOCK(&m->lock);
+    uint64_t cachegen = jl_atomic_load_relaxed(&m->usingneggen);
+    jl_svec_t *syms = jl_atomic_load_relaxed(&m->usingnegcache);
+    if (cachegen > gen) {
+        // the cache was already restarted at a newer generation, where this
+        // result may no longer hold
+        JL_UNLOCK(&m->lock);
+        return;
+    }
+    if (syms == NULL || cachegen != gen) {
+        // start a fresh cache for `gen`, dropping any stale entries
+        syms = jl_alloc_svec_uninit(8);
+        for (size_t j = 0; j < 8; j++)
+            jl_svec_data(syms)[j] = jl_nothing;
+        jl_atomic_store_relaxed(&m->usingnegcache, syms);
+        jl_gc_wb(m, syms);
+        jl_atomic_store_relaxed(&m->usingnegkeyset, (jl_genericmemory_t*)jl_an_empty_memory_any);
+        // publish the empty structures before the generation validating them
+        jl_atomic_store_release(&m->usingneggen, gen);
+    }
+    else if (jl_smallintset_lookup(jl_atomic_load_relaxed(&m->usingnegkeyset), usingneg_eq,
+                                   var, (jl_value_t*)syms, var->hash, 0) != -1) {
+        // lost a race with another thread recording the same name
+        JL_UNLOCK(&m->lock);
+        return;
+    }
+    // find the insertion slot, growing like the binding table does
+    size_t i, cl = jl_svec_len(syms);
+    for (i = cl; i > 0; i--) {
+        jl_value_t *s = jl_svecref(syms, i - 1);
+        if (s != jl_nothing)
+            break;
+    }
+    if (i == cl) {
+        size_t ncl = cl < 8 ? 8 : (cl*3)>>1; // grow 50%
+        jl_svec_t *nc = jl_alloc_svec_uninit(ncl);
+        if (i > 0)
+            memcpy((char*)jl_svec_data(nc), jl_svec_data(syms), sizeof(void*) * i);
+        for (size_t j = i; j < ncl; j++)
+            jl_svec_data(nc)[j] = jl_nothing;
+        jl_atomic_store_release(&m->usingnegcache, nc);
+        jl_gc_wb(m, nc);
+        syms = nc;
+    }
+    jl_svecset(syms, i, (jl_value_t*)var); // relaxed
+    jl_smallintset_insert(&m->usingnegkeyset, (jl_value_t*)m, usingneg_hash, i, (jl_value_t*)syms); // release
+    JL_UNLOCK(&m->lock);
+}
+
 // find a binding from a module's `usings` list
 static jl_binding_t *using_resolve_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var, jl_module_t **from, modstack_t *st, int warn)
 {
     jl_binding_t *b = NULL;
     jl_module_t *owner = NULL;
-    JL_LOCK(&m->lock);
-    int i = (int)m->usings.len - 1;
-    JL_UNLOCK(&m->lock);
-    for (; i >= 0; --i) {
-        JL_LOCK(&m->lock);
-        jl_module_t *imp = module_usings_getidx(m, i);
-        JL_UNLOCK(&m->lock);
-        jl_binding_t *tempb = jl_get_module_binding(imp, var, 0);
-        if (tempb != NULL && tempb->exportp) {
+    // consult the negative cache first: dynamically-generated code probes
+    // many absent names, and each probe would otherwise pay for an index
+    // lookup (or an index rebuild) just to re-answer "nobody exports this"
+    if (jl_atomic_load_acquire(&m->usingneggen) == jl_atomic_load_acquire(&jl_export_generation)) {
+        jl_genericmemory_t *negkeyset = jl_atomic_load_acquire(&m->usingnegkeyset);
+        jl_svec_t *negsyms = jl_atomic_load_relaxed(&m->usingnegcache);
+        if (negsyms != NULL &&
+            jl_smallintset_lookup(negkeyset, usingneg_eq, var, (jl_value_t*)negsyms, var->hash, 0) != -1) {
+            *from = NULL;
+            return NULL;
+        }
+    }
+    jl_svec_t *index = jl_atomic_load_acquire(&m->usingindex);
+    if (index == NULL || jl_unbox_uint64(jl_svecref(index, 0)) != jl_atomic_load_acquire(&jl_export_generation))
+        index = usingindex_build(m);
+    jl_value_t *entry = NULL;
+    JL_GC_PUSH2(&index, &entry);
+    jl_value_t *data = jl_svecref(index, 2);
+    ssize_t idx = jl_smallintset_lookup((jl_genericmemory_t*)jl_svecref(index, 1), usingindex_eq,
+                                        var, data, var->hash, 0);
+    if (idx != -1)
+        entry = jl_svecref(data, idx);
+    size_t ncandidates = entry == NULL ? 0 : (jl_is_svec(entry) ? jl_svec_len(entry) : 1);
+    for (size_t i = 0; i < ncandidates; i++) {
+        jl_binding_t *tempb = (jl_binding_t*)(jl_is_svec(entry) ? jl_svecref(entry, i) : entry);
+        jl_module_t *imp = tempb->globalref->mod;
+        assert(tempb->exportp);
+        {
             tempb = jl_resolve_owner(NULL, imp, var, st); // find the owner for tempb
             if (tempb == NULL)
                 // couldn't resolve; try next using (see issue #6105)
@@ -340,6 +544,7 @@ static jl_binding_t *using_resolve_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl
                               jl_symbol_name(imp->name), jl_symbol_name(var),
                               jl_symbol_name(m->name));
                 }
+                JL_GC_POP();
                 return NULL;
             }
             if (owner == NULL || !tempb->deprecated) {
@@ -348,6 +553,12 @@ static jl_binding_t *using_resolve_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl
             }
         }
     }
+    if (b == NULL && ncandidates == 0)
+        // nobody exports this name as of the generation the consulted index
+        // was built at; candidates that merely failed to resolve are not
+        // cached, since defining them does not bump the export generation
+        usingneg_insert(m, var, jl_unbox_uint64(jl_svecref(index, 0)));
+    JL_GC_POP();
     *from = owner;
     return b;
 }
@@ -633,9 +844,29 @@ JL_DLLEXPORT void jl_module_using(jl_module_t *to, jl_module_t *from)
             return;
         }
     }
-    arraylist_push(&to->usings, from);
+    // append RCU-style so using_resolve_binding can walk the list without the
+    // lock: fully populate a grown items array and publish it before
+    // advancing len, and never free a replaced array (a lock-free reader may
+    // still hold it; usings lists are small and growth doubles, so the
+    // retained garbage is bounded by the list size)
+    arraylist_t *u = &to->usings;
+    size_t ulen = u->len;
+    if (ulen + 1 > u->max) {
+        size_t nm = u->max * 2;
+        void **p = (void**)malloc_s(nm * sizeof(void*));
+        memcpy(p, u->items, ulen * sizeof(void*));
+        p[ulen] = (void*)from;
+        jl_atomic_store_release((_Atomic(void**)*)&u->items, p);
+        u->max = nm;
+    }
+    else {
+        u->items[ulen] = (void*)from;
+    }
+    jl_atomic_store_release((_Atomic(size_t)*)&u->len, ulen + 1);
     jl_gc_wb(to, from);
     JL_UNLOCK(&to->lock);
+    // the new edge may make more exports visible in `to`
+    jl_atomic_fetch_add_relaxed(&jl_export_generation, 1);
 
     // print a warning if something visible via this "using" conflicts with
     // an existing identifier. note that an identifier added later may still
@@ -667,7 +898,11 @@ JL_DLLEXPORT void jl_module_public(jl_module_t *from, jl_sym_t *s, int exported)
 {
     jl_binding_t *b = jl_get_module_binding(from, s, 1);
     b->publicp = 1;
-    b->exportp |= exported;
+    if (exported && !b->exportp) {
+        b->exportp = 1;
+        // invalidate the merged export indexes of any module `using` this one
+        jl_atomic_fetch_add_relaxed(&jl_export_generation, 1);
+    }
 }
 
 JL_DLLEXPORT int jl_boundp(jl_module_t *m, jl_sym_t *var)
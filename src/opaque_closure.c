@@ -27,6 +27,19 @@ JL_DLLEXPORT int jl_is_valid_oc_argtype(jl_tupletype_t *argt, jl_method_t *sourc
     return 1;
 }
 
+// Memoized results of opaque closure specialization. Deriving the closure
+// type and entry points re-runs the specialization lookup, world-bounds scan
+// and return-type checks on every construction, which dominates the cost of
+// building many closures of the same shape in a loop. Everything derived
+// below is a pure function of the key, so each slot caches
+//   svec(source, typeof(captures), argt, rt_lb, rt_ub, world,
+//        oc_type, invoke, specptr, captures_const-or-nothing)
+// and repeat construction is reduced to the closure allocation itself. The
+// world age is part of the key, so redefinitions simply miss. The table is
+// scanned as part of the GC root set (see gc_mark_roots), which also keeps
+// the key objects from being recycled.
+_Atomic(jl_svec_t*) oc_spec_cache[N_OC_SPEC_CACHE] JL_GLOBALLY_ROOTED;
+
 static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t *rt_lb, jl_value_t *rt_ub,
     jl_value_t *source_, jl_value_t *captures, int do_compile)
 {
@@ -45,14 +58,44 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
     }
     if (jl_nparams(argt) + 1 - jl_is_va_tuple(argt) < source->nargs - source->isva)
         jl_error("Argument type tuple has too few required arguments for method");
+    jl_task_t *ct = jl_current_task;
+    size_t world = ct->world_age;
+    jl_value_t *captype = jl_typeof(captures);
+    int memo_idx = -1;
+    if (do_compile) {
+        memo_idx = jl_int32hash_fast((uint32_t)((uintptr_t)source_ ^
+                ((uintptr_t)captype >> 3) ^ ((uintptr_t)argt >> 6) ^
+                (uintptr_t)rt_lb ^ ((uintptr_t)rt_ub >> 3) ^ world)) & (N_OC_SPEC_CACHE - 1);
+        jl_svec_t *memo = jl_atomic_load_acquire(&oc_spec_cache[memo_idx]);
+        if (memo != NULL && jl_svecref(memo, 0) == source_ &&
+                jl_svecref(memo, 1) == captype &&
+                jl_svecref(memo, 2) == (jl_value_t*)argt &&
+                jl_svecref(memo, 3) == rt_lb && jl_svecref(memo, 4) == rt_ub &&
+                jl_unbox_ulong(jl_svecref(memo, 5)) == world) {
+            // read everything out of the slot before allocating; the svec
+            // stays alive through the root set, but the slot may be replaced
+            jl_value_t *oc_type = jl_svecref(memo, 6);
+            JL_GC_PROMISE_ROOTED(oc_type); // cached in the type cache
+            jl_fptr_args_t invoke = (jl_fptr_args_t)jl_unbox_voidpointer(jl_svecref(memo, 7));
+            void *specptr = jl_unbox_voidpointer(jl_svecref(memo, 8));
+            jl_value_t *captures_const = jl_svecref(memo, 9);
+            jl_opaque_closure_t *oc = (jl_opaque_closure_t*)jl_gc_alloc(ct->ptls, sizeof(jl_opaque_closure_t), oc_type);
+            oc->source = source;
+            oc->captures = captures_const == jl_nothing ? captures : captures_const;
+            oc->world = world;
+            oc->invoke = invoke;
+            oc->specptr = specptr;
+            return oc;
+        }
+    }
     jl_value_t *sigtype = NULL;
     jl_value_t *selected_rt = rt_ub;
-    JL_GC_PUSH2(&sigtype, &selected_rt);
+    jl_value_t *captures_const = NULL;
+    jl_value_t *memo_box = NULL;
+    JL_GC_PUSH5(&sigtype, &selected_rt, &captures_const, &memo_box, &captype);
     sigtype = jl_argtype_with_function(captures, (jl_value_t*)argt);
 
     jl_method_instance_t *mi = jl_specializations_get_linfo(source, sigtype, jl_emptysvec);
-    jl_task_t *ct = jl_current_task;
-    size_t world = ct->world_age;
     jl_code_instance_t *ci = NULL;
     if (do_compile) {
         ci = jl_compile_method_internal(mi, world);
@@ -60,6 +103,10 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
 
     jl_fptr_args_t invoke = (jl_fptr_args_t)jl_interpret_opaque_closure;
     void *specptr = NULL;
+    // whether the entry points derived below are final for this world; a
+    // code instance still waiting on the interpreter (`--compile=min`,
+    // tiered tier 0) may upgrade later and must not be memoized
+    int memo_stable = ci != NULL;
 
     if (ci) {
         invoke = (jl_fptr_args_t)jl_atomic_load_relaxed(&ci->invoke);
@@ -85,6 +132,7 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
 
         if (invoke == (jl_fptr_args_t) jl_fptr_interpret_call) {
             invoke = (jl_fptr_args_t)jl_interpret_opaque_closure;
+            memo_stable = 0;
         }
         else if (invoke == (jl_fptr_args_t)jl_fptr_args && specptr) {
             invoke = (jl_fptr_args_t)specptr;
@@ -94,6 +142,7 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
                 (jl_fptr_args_t)jl_fptr_const_opaque_closure :
                 (jl_fptr_args_t)jl_fptr_const_opaque_closure_typeerror;
             captures = ci->rettype_const;
+            captures_const = captures;
         }
     }
 
@@ -117,6 +166,22 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
     oc->invoke = invoke;
     oc->specptr = specptr;
 
+    if (memo_idx >= 0 && memo_stable) {
+        jl_svec_t *memo = jl_alloc_svec(10);
+        memo_box = (jl_value_t*)memo;
+        jl_svecset(memo, 0, source_);
+        jl_svecset(memo, 1, captype);
+        jl_svecset(memo, 2, (jl_value_t*)argt);
+        jl_svecset(memo, 3, rt_lb);
+        jl_svecset(memo, 4, rt_ub);
+        jl_svecset(memo, 5, jl_box_ulong(world));
+        jl_svecset(memo, 6, oc_type);
+        jl_svecset(memo, 7, jl_box_voidpointer((void*)invoke));
+        jl_svecset(memo, 8, jl_box_voidpointer(specptr));
+        jl_svecset(memo, 9, captures_const ? captures_const : jl_nothing);
+        jl_atomic_store_release(&oc_spec_cache[memo_idx], memo);
+    }
+
     JL_GC_POP();
     return oc;
 }
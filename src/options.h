@@ -12,6 +12,41 @@
 
 #define N_CALL_CACHE 4096
 
+// number of direct-mapped slots in the per-call-site dispatch cache; each
+// slot is owned by a single (verified) call site, see jl_lookup_generic_
+#define N_CALLSITE_CACHE 8192
+
+// number of direct-mapped slots in the memo table for closed subtype
+// queries, see jl_subtype_env
+#define N_SUBTYPE_CACHE 2048
+
+// number of direct-mapped slots in the memo table for closed type
+// intersections, see jl_type_intersection_env_s
+#define N_INTERSECT_CACHE 1024
+
+// number of direct-mapped slots in the memo table for dynamic invoke
+// lookups, see jl_gf_invoke
+#define N_INVOKE_CACHE 512
+
+// number of direct-mapped slots in the opaque closure specialization
+// cache, see new_opaque_closure
+#define N_OC_SPEC_CACHE 256
+
+// number of direct-mapped slots in the memo table for failed method
+// lookups, see _gf_invoke_lookup
+#define N_MISSING_METHOD_CACHE 512
+
+// number of interpreted calls of a code instance before it is handed to the
+// JIT when running with `--compile=tiered`, see jl_tier0_count_call
+#define TIER0_PROMOTE_THRESHOLD 32
+
+// optimization levels used by `--compile=tiered`: hot code leaves the
+// interpreter at TIER1_OPT_LEVEL to keep compile latency low, then is
+// recompiled in the background at TIER2_OPT_LEVEL and has its entry points
+// replaced in place, see jl_enqueue_reoptimization
+#define TIER1_OPT_LEVEL 1
+#define TIER2_OPT_LEVEL 3
+
 // object layout options ------------------------------------------------------
 
 // The data for an array this size or below will be allocated within the
@@ -146,6 +181,7 @@
 // affinitization behavior
 #define MACHINE_EXCLUSIVE_NAME          "JULIA_EXCLUSIVE"
 #define DEFAULT_MACHINE_EXCLUSIVE       0
+#define NUMA_PARTITION_NAME             "JULIA_NUMA"
 
 // sanitizer defaults ---------------------------------------------------------
 
@@ -40,6 +40,8 @@
 #include <llvm/Transforms/IPO/ConstantMerge.h>
 #include <llvm/Transforms/IPO/ForceFunctionAttrs.h>
 #include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/Transforms/IPO/HotColdSplitting.h>
+#include <llvm/Transforms/AggressiveInstCombine/AggressiveInstCombine.h>
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Instrumentation/AddressSanitizer.h>
 #include <llvm/Transforms/Instrumentation/MemorySanitizer.h>
@@ -329,10 +331,45 @@ namespace {
 // cleanup as much as possible before trying to slp vectorize)
 //* For optimization
 //? loop sink pass
-//? hot-cold splitting pass
 
 #define JULIA_PASS(ADD_PASS) if (!options.llvm_only) { ADD_PASS; } else do { } while (0)
 
+namespace {
+
+// Pipelines are constructed once per optimization level, so adapting them to
+// the size of each function has to happen at run time. These two adaptors
+// check the instruction count against the thresholds in jl_options when the
+// wrapped pass would run; a threshold of 0 (the default) disables the check.
+
+// Runs the wrapped pass only on functions below --huge-function-threshold,
+// for passes whose cost grows superlinearly with function size.
+template<typename PassT>
+struct SkipOnHugeFunctionPass : PassInfoMixin<SkipOnHugeFunctionPass<PassT>> {
+    PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM) JL_NOTSAFEPOINT {
+        uint32_t threshold = jl_options.huge_function_threshold;
+        if (threshold && F.getInstructionCount() > threshold)
+            return PreservedAnalyses::all();
+        return P.run(F, AM);
+    }
+    PassT P;
+};
+
+// Runs the wrapped pass only on functions below --small-function-threshold,
+// for extra passes that are worthwhile on small hot functions but too
+// expensive to run everywhere.
+template<typename PassT>
+struct SmallFunctionOnlyPass : PassInfoMixin<SmallFunctionOnlyPass<PassT>> {
+    PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM) JL_NOTSAFEPOINT {
+        uint32_t threshold = jl_options.small_function_threshold;
+        if (!threshold || F.getInstructionCount() > threshold)
+            return PreservedAnalyses::all();
+        return P.run(F, AM);
+    }
+    PassT P;
+};
+
+}
+
 static void buildEarlySimplificationPipeline(ModulePassManager &MPM, PassBuilder *PB, OptimizationLevel O, const OptimizationOptions &options) JL_NOTSAFEPOINT {
     MPM.addPass(BeforeEarlySimplificationMarkerPass());
 #ifdef JL_DEBUG_BUILD
@@ -477,7 +514,7 @@ static void buildScalarOptimizerPipeline(FunctionPassManager &FPM, PassBuilder *
         FPM.addPass(SROAPass());
 #endif
         FPM.addPass(InstSimplifyPass());
-        FPM.addPass(GVNPass());
+        FPM.addPass(SkipOnHugeFunctionPass<GVNPass>());
         FPM.addPass(MemCpyOptPass());
         FPM.addPass(SCCPPass());
         FPM.addPass(CorrelatedValuePropagationPass());
@@ -485,9 +522,10 @@ static void buildScalarOptimizerPipeline(FunctionPassManager &FPM, PassBuilder *
         FPM.addPass(IRCEPass());
         FPM.addPass(InstCombinePass());
         FPM.addPass(JumpThreadingPass());
+        FPM.addPass(SmallFunctionOnlyPass<AggressiveInstCombinePass>());
     }
     if (O.getSpeedupLevel() >= 3) {
-        FPM.addPass(GVNPass());
+        FPM.addPass(SkipOnHugeFunctionPass<GVNPass>());
     }
     if (O.getSpeedupLevel() >= 2) {
         FPM.addPass(DSEPass());
@@ -514,7 +552,7 @@ static void buildVectorPipeline(FunctionPassManager &FPM, PassBuilder *PB, Optim
     FPM.addPass(LoopLoadEliminationPass());
     FPM.addPass(InstCombinePass());
     FPM.addPass(SimplifyCFGPass(aggressiveSimplifyCFGOptions()));
-    FPM.addPass(SLPVectorizerPass());
+    FPM.addPass(SkipOnHugeFunctionPass<SLPVectorizerPass>());
     invokeVectorizerCallbacks(FPM, PB, O);
     FPM.addPass(VectorCombinePass());
     FPM.addPass(ADCEPass());
@@ -543,7 +581,7 @@ static void buildIntrinsicLoweringPipeline(ModulePassManager &MPM, PassBuilder *
             JULIA_PASS(FPM.addPass(LateLowerGCPass()));
             JULIA_PASS(FPM.addPass(FinalLowerGCPass()));
             if (O.getSpeedupLevel() >= 2) {
-                FPM.addPass(GVNPass());
+                FPM.addPass(SkipOnHugeFunctionPass<GVNPass>());
                 FPM.addPass(SCCPPass());
                 FPM.addPass(DCEPass());
             }
@@ -578,7 +616,7 @@ static void buildCleanupPipeline(ModulePassManager &MPM, PassBuilder *PB, Optimi
         FunctionPassManager FPM;
         JULIA_PASS(FPM.addPass(DemoteFloat16Pass()));
         if (O.getSpeedupLevel() >= 2) {
-            FPM.addPass(GVNPass());
+            FPM.addPass(SkipOnHugeFunctionPass<GVNPass>());
         }
         MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
     }
@@ -600,6 +638,13 @@ static void buildPipeline(ModulePassManager &MPM, PassBuilder *PB, OptimizationL
         FPM.addPass(WarnMissedTransformationsPass());
         MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
     }
+    if (O.getSpeedupLevel() >= 2) {
+        // Outline cold regions (error and throw paths) into their own
+        // functions before intrinsic lowering, so the outlined paths get
+        // their own GC frames; the JIT then sinks the cold functions to the
+        // end of the emitted code (see layoutFunctionsForEmission)
+        MPM.addPass(HotColdSplittingPass());
+    }
     buildIntrinsicLoweringPipeline(MPM, PB, O, options);
     buildCleanupPipeline(MPM, PB, O, options);
     MPM.addPass(AfterOptimizationMarkerPass());
@@ -16,6 +16,7 @@
 
 #include <map>
 #include <algorithm>
+#include <mutex>
 
 #include "julia_assert.h"
 
@@ -474,6 +475,59 @@ static inline llvm::SmallVector<TargetData<n>, 0> deserialize_target_data(const
     return res;
 }
 
+// Size in bytes of a serialized target data blob, following the layout
+// consumed by `deserialize_target_data` above.
+template<size_t n>
+static inline size_t serialized_target_data_size(const uint8_t *data)
+{
+    const uint8_t *p = data;
+    auto load_u32 = [&] () {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        p += 4;
+        return v;
+    };
+    uint32_t ntarget = load_u32();
+    for (uint32_t i = 0; i < ntarget; i++) {
+        p += 4; // flags
+        uint32_t nfeature = load_u32();
+        assert(nfeature == n);
+        (void)nfeature;
+        p += 8 * n; // enabled and disabled feature lists
+        p += load_u32(); // name
+        p += load_u32(); // ext_features
+    }
+    return p - data;
+}
+
+// Most pkgimages are built with the same CPU target string, and the host
+// target never changes after the JIT targets are initialized, so the result
+// of matching a pkgimage's targets against the host is a pure function of the
+// serialized target blob. Memoize it keyed by a hash of the blob, so loading
+// many images parses and matches each distinct target list only once.
+// Failed matches are not cached: they carry a rejection-reason string we
+// would rather recompute than root.
+static std::mutex pkgimg_match_lock;
+static std::map<uint64_t, uint32_t> pkgimg_match_cache;
+
+template<typename F>
+static inline uint32_t memoize_pkgimg_match(const void *id, size_t blob_sz, F &&compute)
+{
+    uint64_t key = memhash((const char*)id, blob_sz);
+    {
+        std::lock_guard<std::mutex> lock(pkgimg_match_lock);
+        auto it = pkgimg_match_cache.find(key);
+        if (it != pkgimg_match_cache.end())
+            return it->second;
+    }
+    uint32_t best_idx = compute();
+    if (best_idx != (uint32_t)-1) {
+        std::lock_guard<std::mutex> lock(pkgimg_match_lock);
+        pkgimg_match_cache[key] = best_idx;
+    }
+    return best_idx;
+}
+
 // Try getting clone base argument. Return 1-based index. Return 0 if match failed.
 static inline int get_clone_base(const char *start, const char *end)
 {
@@ -608,12 +662,49 @@ parse_cmdline(const char *option, F &&feature_cb)
     }
 }
 
+// Features listed in JULIA_CPU_DISABLE_FEATURES (comma separated) are
+// treated as unavailable process-wide: they are masked out of the JIT target
+// in `arg_target_data` and, through the recomputed disabled set, reject image
+// clones that use them. This gives pinned workers on hybrid-core machines a
+// policy handle -- a process pinned to E-cores can exclude the wide-vector
+// features that are only profitable on P-cores without rebuilding its images
+// or changing the shared cpu-target option.
+template<size_t n, typename F>
+static inline void apply_disabled_features_env(llvm::SmallVector<TargetData<n>, 0> &targets, F &&feature_cb)
+{
+    const char *env = getenv("JULIA_CPU_DISABLE_FEATURES");
+    if (!env || !*env)
+        return;
+    const char *start = env;
+    for (const char *p = env; ; p++) {
+        if (*p == ',' || *p == '\0') {
+            if (p > start) {
+                for (auto &t: targets) {
+                    if (!feature_cb(start, p - start, t.dis.features)) {
+                        // not a known feature name; let LLVM decide
+                        if (!t.ext_features.empty())
+                            t.ext_features += ',';
+                        t.ext_features += '-';
+                        t.ext_features.append(start, p - start);
+                    }
+                }
+            }
+            if (*p == '\0')
+                break;
+            start = p + 1;
+        }
+    }
+}
+
 // Cached version of command line parsing
 template<size_t n, typename F>
 static inline llvm::SmallVector<TargetData<n>, 0> &get_cmdline_targets(F &&feature_cb)
 {
-    static llvm::SmallVector<TargetData<n>, 0> targets =
-        parse_cmdline<n>(jl_options.cpu_target, std::forward<F>(feature_cb));
+    static llvm::SmallVector<TargetData<n>, 0> targets = [&] {
+        auto res = parse_cmdline<n>(jl_options.cpu_target, std::forward<F>(feature_cb));
+        apply_disabled_features_env(res, feature_cb);
+        return res;
+    }();
     return targets;
 }
 
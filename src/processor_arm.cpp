@@ -1590,15 +1590,18 @@ static uint32_t sysimg_init_cb(const void *id, jl_value_t **rejection_reason)
 
 static uint32_t pkgimg_init_cb(const void *id, jl_value_t **rejection_reason JL_REQUIRE_ROOTED_SLOT)
 {
-    TargetData<feature_sz> target = jit_targets.front();
-    auto pkgimg = deserialize_target_data<feature_sz>((const uint8_t*)id);
-    for (auto &t: pkgimg) {
-        if (auto nname = normalize_cpu_name(t.name)) {
-            t.name = nname;
+    size_t blob_sz = serialized_target_data_size<feature_sz>((const uint8_t*)id);
+    return memoize_pkgimg_match(id, blob_sz, [&] () {
+        TargetData<feature_sz> target = jit_targets.front();
+        auto pkgimg = deserialize_target_data<feature_sz>((const uint8_t*)id);
+        for (auto &t: pkgimg) {
+            if (auto nname = normalize_cpu_name(t.name)) {
+                t.name = nname;
+            }
         }
-    }
-    auto match = match_sysimg_targets(pkgimg, target, max_vector_size, rejection_reason);
-    return match.best_idx;
+        auto match = match_sysimg_targets(pkgimg, target, max_vector_size, rejection_reason);
+        return match.best_idx;
+    });
 }
 
 static void ensure_jit_target(bool imaging)
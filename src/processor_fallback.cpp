@@ -56,18 +56,21 @@ static uint32_t sysimg_init_cb(const void *id, jl_value_t **rejection_reason)
 
 static uint32_t pkgimg_init_cb(const void *id, jl_value_t **rejection_reason)
 {
-    TargetData<1> target = jit_targets.front();
-    // Find the last name match or use the default one.
-    uint32_t best_idx = 0;
-    auto pkgimg = deserialize_target_data<1>((const uint8_t*)id);
-    for (uint32_t i = 0; i < pkgimg.size(); i++) {
-        auto &imgt = pkgimg[i];
-        if (imgt.name == target.name) {
-            best_idx = i;
+    size_t blob_sz = serialized_target_data_size<1>((const uint8_t*)id);
+    return memoize_pkgimg_match(id, blob_sz, [&] () {
+        TargetData<1> target = jit_targets.front();
+        // Find the last name match or use the default one.
+        uint32_t best_idx = 0;
+        auto pkgimg = deserialize_target_data<1>((const uint8_t*)id);
+        for (uint32_t i = 0; i < pkgimg.size(); i++) {
+            auto &imgt = pkgimg[i];
+            if (imgt.name == target.name) {
+                best_idx = i;
+            }
         }
-    }
 
-    return best_idx;
+        return best_idx;
+    });
 }
 
 static void ensure_jit_target(bool imaging)
@@ -62,6 +62,31 @@ void *jl_load_and_lookup(const char *f_lib, const char *f_name, _Atomic(void*) *
     return ptr;
 }
 
+// jl_load_and_lookup, but will never load a library and never throws: returns
+// NULL unless `f_lib` is already available and exports `f_name`. Codegen uses
+// this to emit direct calls for ccall sites whose target is already resolvable.
+extern "C" JL_DLLEXPORT
+void *jl_lookup_existing_symbol(const char *f_lib, const char *f_name)
+{
+    void *handle = NULL;
+    if (f_lib == NULL || f_lib == JL_EXE_LIBNAME ||
+        f_lib == JL_LIBJULIA_INTERNAL_DL_LIBNAME || f_lib == JL_LIBJULIA_DL_LIBNAME) {
+        // the sentinel handles always exist and are never loaded on demand
+        handle = jl_get_library_(f_lib, 0);
+    }
+    else {
+        JL_LOCK(&libmap_lock);
+        auto it = libMap.find(f_lib);
+        if (it != libMap.end())
+            handle = it->second;
+        JL_UNLOCK(&libmap_lock);
+    }
+    void *ptr = NULL;
+    if (handle)
+        jl_dlsym(handle, f_name, &ptr, 0);
+    return ptr;
+}
+
 // jl_load_and_lookup, but with library computed at run time on first call
 extern "C" JL_DLLEXPORT
 void *jl_lazy_load_and_lookup(jl_value_t *lib_val, const char *f_name)
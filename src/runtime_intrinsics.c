@@ -387,6 +387,116 @@ JL_DLLEXPORT BFLOAT16_TYPE julia__truncdfbf2(double param) JL_NOTSAFEPOINT
 }
 
 
+// bulk (B)Float16 conversion API
+
+// Converting large Float16/BFloat16 arrays one boxed intrinsic call at a
+// time is far slower than it needs to be; these batch entry points convert
+// whole buffers and use the hardware converters (F16C on x86, the ARMv8
+// fp16 conversion instructions on AArch64) when available. The hardware
+// converters round to nearest even like the soft-float helpers above, so
+// the results are bit-identical (modulo NaN payloads, as usual).
+
+#if defined(_CPU_X86_) || defined(_CPU_X86_64_)
+#include <immintrin.h>
+
+static int have_f16c(void) JL_NOTSAFEPOINT
+{
+    static int cached = -1;
+    if (cached == -1)
+        cached = __builtin_cpu_supports("f16c");
+    return cached;
+}
+
+__attribute__((target("avx,f16c")))
+static void half_to_float_bulk_f16c(const uint16_t *src, float *dst, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(&dst[i],
+                _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&src[i])));
+    for (; i < n; i++)
+        dst[i] = half_to_float(src[i]);
+}
+
+__attribute__((target("avx,f16c")))
+static void float_to_half_bulk_f16c(const float *src, uint16_t *dst, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i*)&dst[i],
+                _mm256_cvtps_ph(_mm256_loadu_ps(&src[i]),
+                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    for (; i < n; i++)
+        dst[i] = float_to_half(src[i]);
+}
+#elif defined(_CPU_AARCH64_)
+#include <arm_neon.h>
+
+// fp16<->fp32 conversion is baseline ARMv8-A, no feature check needed
+static void half_to_float_bulk_neon(const uint16_t *src, float *dst, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(&dst[i], vcvt_f32_f16(vld1_f16((const float16_t*)&src[i])));
+    for (; i < n; i++)
+        dst[i] = half_to_float(src[i]);
+}
+
+static void float_to_half_bulk_neon(const float *src, uint16_t *dst, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1_f16((float16_t*)&dst[i], vcvt_f16_f32(vld1q_f32(&src[i])));
+    for (; i < n; i++)
+        dst[i] = float_to_half(src[i]);
+}
+#endif
+
+JL_DLLEXPORT void jl_half_to_float_bulk(const uint16_t *src, float *dst, size_t n)
+{
+#if defined(_CPU_X86_) || defined(_CPU_X86_64_)
+    if (have_f16c()) {
+        half_to_float_bulk_f16c(src, dst, n);
+        return;
+    }
+#elif defined(_CPU_AARCH64_)
+    half_to_float_bulk_neon(src, dst, n);
+    return;
+#endif
+    for (size_t i = 0; i < n; i++)
+        dst[i] = half_to_float(src[i]);
+}
+
+JL_DLLEXPORT void jl_float_to_half_bulk(const float *src, uint16_t *dst, size_t n)
+{
+#if defined(_CPU_X86_) || defined(_CPU_X86_64_)
+    if (have_f16c()) {
+        float_to_half_bulk_f16c(src, dst, n);
+        return;
+    }
+#elif defined(_CPU_AARCH64_)
+    float_to_half_bulk_neon(src, dst, n);
+    return;
+#endif
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_half(src[i]);
+}
+
+// bfloat16 conversion is a cheap integer shift/round, so plain loops
+// auto-vectorize well; these exist for symmetry with the half entry points
+JL_DLLEXPORT void jl_bfloat_to_float_bulk(const uint16_t *src, float *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = bfloat_to_float(src[i]);
+}
+
+JL_DLLEXPORT void jl_float_to_bfloat_bulk(const float *src, uint16_t *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_bfloat(src[i]);
+}
+
+
 // run time version of bitcast intrinsic
 JL_DLLEXPORT jl_value_t *jl_bitcast(jl_value_t *ty, jl_value_t *v)
 {
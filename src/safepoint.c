@@ -9,6 +9,21 @@
 #define MAP_ANONYMOUS MAP_ANON
 #endif
 #endif
+#ifdef _OS_LINUX_
+#include <unistd.h>
+#include <sys/syscall.h>
+// The membarrier arming mode requires the SEGV handler to rewrite stale poll
+// registers in the interrupted context (see `jl_safepoint_remap_armed_addr`
+// and its callers in signals-unix.c), so it is only available on the
+// architectures where that rewrite is implemented.
+#if defined(SYS_membarrier) && (defined(_CPU_X86_64_) || defined(_CPU_AARCH64_))
+#define JL_SAFEPOINT_MEMBARRIER
+#ifndef MEMBARRIER_CMD_PRIVATE_EXPEDITED
+#define MEMBARRIER_CMD_PRIVATE_EXPEDITED (1 << 3)
+#define MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED (1 << 4)
+#endif
+#endif
+#endif
 #include "julia_assert.h"
 
 #ifdef __cplusplus
@@ -31,8 +46,56 @@ char *jl_safepoint_pages = NULL;
 // The initialization of the `safepoint` pointer is done `ti_initthread`
 // in `threading.c`.
 // The fourth page is the count of suspended threads
+// The fifth page is only used by the membarrier arming mode below: it stays
+// protected for the whole lifetime of the process and threads are stopped by
+// pointing their `safepoint` pointer at it instead of protecting a shared page.
 uint16_t jl_safepoint_enable_cnt[4] = {0, 0, 0, 0};
 
+// Whether the GC pages (1 and 2) are armed by swinging the per-thread
+// `safepoint` pointers at the permanently protected fifth page, with a
+// membarrier(2) handshake, instead of mprotect'ing the shared pages.
+// Changing the protection of a page that every mutator has mapped IPIs
+// every core for a TLB shootdown twice per stop-the-world, which shows up
+// as system-time spikes on large machines. The SIGINT page (0) and the
+// suspend page (3) are rare and keep using mprotect.
+static int jl_safepoint_membarrier_mode = 0;
+
+// the regular (disarmed) poll location of a thread
+static size_t *jl_safepoint_poll_addr(int16_t tid) JL_NOTSAFEPOINT
+{
+    if (tid == 0)
+        return (size_t*)(jl_safepoint_pages + jl_page_size);
+    return (size_t*)(jl_safepoint_pages + jl_page_size * 2 + sizeof(void*));
+}
+
+// the poll location of an armed thread in the membarrier mode; offset so that
+// both the safepoint load and the pending-signal load fall in the fifth page
+static size_t *jl_safepoint_armed_addr(void) JL_NOTSAFEPOINT
+{
+    return (size_t*)(jl_safepoint_pages + jl_page_size * 4 + sizeof(void*));
+}
+
+// Remap a register value that points into the permanently protected armed
+// page at the corresponding offset from the thread's regular poll location.
+// The compiled poll keeps the loaded `ptls->safepoint` value in a register
+// while dereferencing it, so once the signal handler has waited out the GC
+// and returns, the re-executed load would still dereference the armed page
+// and fault right back into the handler forever (the armed page, unlike the
+// mprotect'ed shared pages, is never made readable again). The handler
+// instead rewrites any such register in the interrupted context before
+// resuming. Loading from the regular page can let the thread sail past one
+// poll if a new stop-the-world was requested in the meantime, which merely
+// delays it until its next safepoint. Returns 0 when `val` does not point
+// into the armed page.
+uintptr_t jl_safepoint_remap_armed_addr(uintptr_t val, int16_t tid) JL_NOTSAFEPOINT
+{
+    uintptr_t armed_page = (uintptr_t)jl_safepoint_pages + jl_page_size * 4;
+    if (!jl_safepoint_membarrier_mode || val - armed_page >= jl_page_size)
+        return 0;
+    return (uintptr_t)jl_safepoint_poll_addr(tid) +
+           (val - (uintptr_t)jl_safepoint_armed_addr());
+}
+
 // This lock should be acquired before enabling/disabling the safepoint
 // or accessing one of the following variables:
 //
@@ -58,6 +121,31 @@ static void jl_safepoint_enable(int idx) JL_NOTSAFEPOINT
         assert(jl_safepoint_enable_cnt[idx] <= (idx == 3 ? INT16_MAX : 2));
         return;
     }
+#ifdef JL_SAFEPOINT_MEMBARRIER
+    if (jl_safepoint_membarrier_mode && (idx == 1 || idx == 2)) {
+        // Swing the poll pointer of the affected threads at the permanently
+        // protected page instead of protecting the shared one. The
+        // compare-exchange leaves pointers parked on the suspend page alone;
+        // that page is protected whenever a suspension is active, so those
+        // threads stop either way.
+        size_t *armed = jl_safepoint_armed_addr();
+        int nthreads = jl_atomic_load_acquire(&jl_n_threads);
+        jl_ptls_t *allstates = jl_atomic_load_relaxed(&jl_all_tls_states);
+        for (int i = 0; i < nthreads; i++) {
+            if ((idx == 1) != (i == 0))
+                continue;
+            jl_ptls_t ptls2 = allstates[i];
+            if (ptls2 == NULL)
+                continue;
+            size_t *expect = jl_safepoint_poll_addr((int16_t)i);
+            jl_atomic_cmpswap(&ptls2->safepoint, &expect, armed);
+        }
+        // make sure every running thread observes its new poll pointer before
+        // we start waiting for the world to stop
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        return;
+    }
+#endif
     // Now that we are requested to mprotect the page and it wasn't already.
     char *pageaddr = jl_safepoint_pages + jl_page_size * idx;
 #ifdef _OS_WINDOWS_
@@ -77,6 +165,26 @@ static void jl_safepoint_disable(int idx) JL_NOTSAFEPOINT
         assert(jl_safepoint_enable_cnt[idx] > 0);
         return;
     }
+#ifdef JL_SAFEPOINT_MEMBARRIER
+    if (jl_safepoint_membarrier_mode && (idx == 1 || idx == 2)) {
+        // Swing the poll pointers back. A pointer that is not on the armed
+        // page is owned by the suspend machinery; `jl_safepoint_resume_thread`
+        // restores it with the armed state taken into account.
+        size_t *armed = jl_safepoint_armed_addr();
+        int nthreads = jl_atomic_load_acquire(&jl_n_threads);
+        jl_ptls_t *allstates = jl_atomic_load_relaxed(&jl_all_tls_states);
+        for (int i = 0; i < nthreads; i++) {
+            if ((idx == 1) != (i == 0))
+                continue;
+            jl_ptls_t ptls2 = allstates[i];
+            if (ptls2 == NULL)
+                continue;
+            size_t *expect = armed;
+            jl_atomic_cmpswap(&ptls2->safepoint, &expect, jl_safepoint_poll_addr((int16_t)i));
+        }
+        return;
+    }
+#endif
     // Now that we are requested to un-mprotect the page and no one else
     // want it to be kept protected.
     char *pageaddr = jl_safepoint_pages + jl_page_size * idx;
@@ -97,9 +205,9 @@ void jl_safepoint_init(void)
     // jl_page_size isn't available yet.
     size_t pgsz = jl_getpagesize();
 #ifdef _OS_WINDOWS_
-    char *addr = (char*)VirtualAlloc(NULL, pgsz * 4, MEM_COMMIT, PAGE_READONLY);
+    char *addr = (char*)VirtualAlloc(NULL, pgsz * 5, MEM_COMMIT, PAGE_READONLY);
 #else
-    char *addr = (char*)mmap(0, pgsz * 4, PROT_READ,
+    char *addr = (char*)mmap(0, pgsz * 5, PROT_READ,
                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
     if (addr == MAP_FAILED)
         addr = NULL;
@@ -109,6 +217,18 @@ void jl_safepoint_init(void)
         jl_gc_debug_critical_error();
         abort();
     }
+#ifdef JL_SAFEPOINT_MEMBARRIER
+    // Arm GC safepoints by swinging per-thread poll pointers when the kernel
+    // supports the expedited membarrier handshake, avoiding the TLB shootdown
+    // of an mprotect on every stop-the-world. JULIA_SAFEPOINT_MEMBARRIER=0
+    // falls back to protecting the shared pages.
+    const char *mb = getenv("JULIA_SAFEPOINT_MEMBARRIER");
+    if (!(mb && strcmp(mb, "0") == 0) &&
+        syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0 &&
+        mprotect(addr + pgsz * 4, pgsz, PROT_NONE) == 0) {
+        jl_safepoint_membarrier_mode = 1;
+    }
+#endif
 //    // If we able to skip past the faulting safepoint instruction conditionally,
 //    // then we can make this safepoint page unconditional. But otherwise we
 //    // only enable this page when required, though it gives us less
@@ -126,6 +246,46 @@ void jl_safepoint_init(void)
     jl_safepoint_pages = addr;
 }
 
+// Set the initial safepoint pointer of a newly registered thread. With the
+// membarrier mode the GC pages are armed by swinging the per-thread poll
+// pointers, so a thread that registers while a stop-the-world is being
+// requested must start out pointing at the armed page.
+void jl_safepoint_init_thread(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&safepoint_lock);
+    int idx = ptls->tid == 0 ? 1 : 2;
+    if (jl_safepoint_membarrier_mode && jl_safepoint_enable_cnt[idx])
+        jl_atomic_store_relaxed(&ptls->safepoint, jl_safepoint_armed_addr());
+    else
+        jl_atomic_store_relaxed(&ptls->safepoint, jl_safepoint_poll_addr(ptls->tid));
+    uv_mutex_unlock(&safepoint_lock);
+}
+
+// Time-to-safepoint statistics (see julia_internal.h). Written only by the
+// thread running jl_gc_wait_for_the_world, which is serialized by
+// jl_gc_running; read concurrently by jl_safepoint_ttsp_stats.
+static struct {
+    _Atomic(uint64_t) nstops;
+    _Atomic(uint64_t) total_ttsp_ns;
+    _Atomic(uint64_t) max_ttsp_ns;
+    _Atomic(uint64_t) hist[JL_TTSP_NHIST];
+    _Atomic(int16_t) last_straggler_tid;
+    _Atomic(uint64_t) last_straggler_ns;
+    _Atomic(void *) last_straggler_pc;
+} jl_ttsp_stats = {0, 0, 0, {0}, -1, 0, NULL};
+
+JL_DLLEXPORT void jl_safepoint_ttsp_stats(jl_safepoint_ttsp_stats_t *stats) JL_NOTSAFEPOINT
+{
+    stats->nstops = jl_atomic_load_relaxed(&jl_ttsp_stats.nstops);
+    stats->total_ttsp_ns = jl_atomic_load_relaxed(&jl_ttsp_stats.total_ttsp_ns);
+    stats->max_ttsp_ns = jl_atomic_load_relaxed(&jl_ttsp_stats.max_ttsp_ns);
+    for (int i = 0; i < JL_TTSP_NHIST; i++)
+        stats->hist[i] = jl_atomic_load_relaxed(&jl_ttsp_stats.hist[i]);
+    stats->last_straggler_tid = jl_atomic_load_relaxed(&jl_ttsp_stats.last_straggler_tid);
+    stats->last_straggler_ns = jl_atomic_load_relaxed(&jl_ttsp_stats.last_straggler_ns);
+    stats->last_straggler_pc = jl_atomic_load_relaxed(&jl_ttsp_stats.last_straggler_pc);
+}
+
 void jl_gc_wait_for_the_world(jl_ptls_t* gc_all_tls_states, int gc_n_threads)
 {
     JL_TIMING(GC, GC_Stop);
@@ -136,9 +296,16 @@ void jl_gc_wait_for_the_world(jl_ptls_t* gc_all_tls_states, int gc_n_threads)
     assert(gc_n_threads);
     if (gc_n_threads > 1)
         jl_wake_libuv();
+    uint64_t t0 = jl_hrtime();
+    // the last thread we had to block on; an approximation (in tid order) of
+    // the thread that arrived at the safepoint last
+    jl_ptls_t straggler_ptls = NULL;
+    int16_t straggler_tid = -1;
+    uint64_t straggler_arrival = 0;
     for (int i = 0; i < gc_n_threads; i++) {
         jl_ptls_t ptls2 = gc_all_tls_states[i];
         if (ptls2 != NULL) {
+            int waited = 0;
             // This acquire load pairs with the release stores
             // in the signal handler of safepoint so we are sure that
             // all the stores on those threads are visible.
@@ -153,9 +320,41 @@ void jl_gc_wait_for_the_world(jl_ptls_t* gc_all_tls_states, int gc_n_threads)
                 if (!jl_atomic_load_relaxed(&ptls2->gc_state))
                     uv_cond_wait(&safepoint_cond_begin, &safepoint_lock);
                 uv_mutex_unlock(&safepoint_lock);
+                waited = 1;
+            }
+            if (waited) {
+                straggler_ptls = ptls2;
+                straggler_tid = (int16_t)i;
+                straggler_arrival = jl_hrtime() - t0;
             }
         }
     }
+    uint64_t ttsp = jl_hrtime() - t0;
+    jl_atomic_store_relaxed(&jl_ttsp_stats.nstops,
+                            jl_atomic_load_relaxed(&jl_ttsp_stats.nstops) + 1);
+    jl_atomic_store_relaxed(&jl_ttsp_stats.total_ttsp_ns,
+                            jl_atomic_load_relaxed(&jl_ttsp_stats.total_ttsp_ns) + ttsp);
+    if (ttsp > jl_atomic_load_relaxed(&jl_ttsp_stats.max_ttsp_ns))
+        jl_atomic_store_relaxed(&jl_ttsp_stats.max_ttsp_ns, ttsp);
+    int b = 0;
+    uint64_t us = ttsp / 1000;
+    while (us > 1 && b < JL_TTSP_NHIST - 1) {
+        us >>= 1;
+        b++;
+    }
+    jl_atomic_store_relaxed(&jl_ttsp_stats.hist[b],
+                            jl_atomic_load_relaxed(&jl_ttsp_stats.hist[b]) + 1);
+    if (straggler_tid != -1) {
+        // A thread that went through jl_safepoint_wait_gc left its arrival pc
+        // behind; one that stopped in a GC-safe region (e.g. a blocking
+        // ccall) did not, which is itself the diagnostic.
+        void *pc = NULL;
+        if (jl_atomic_load_relaxed(&straggler_ptls->gc_state) == JL_GC_STATE_WAITING)
+            pc = straggler_ptls->safepoint_arrival_pc;
+        jl_atomic_store_relaxed(&jl_ttsp_stats.last_straggler_tid, straggler_tid);
+        jl_atomic_store_relaxed(&jl_ttsp_stats.last_straggler_ns, straggler_arrival);
+        jl_atomic_store_relaxed(&jl_ttsp_stats.last_straggler_pc, pc);
+    }
 }
 
 int jl_safepoint_start_gc(void)
@@ -235,6 +434,10 @@ void jl_safepoint_wait_gc(void) JL_NOTSAFEPOINT
     JL_TIMING_SUSPEND_TASK(GC_SAFEPOINT, ct);
     // The thread should have set this is already
     assert(jl_atomic_load_relaxed(&ct->ptls->gc_state) != 0);
+    // stamp our safepoint arrival for straggler attribution (see
+    // jl_safepoint_ttsp_stats); plain stores, read only once we are stopped
+    ct->ptls->safepoint_arrival_ns = jl_hrtime();
+    ct->ptls->safepoint_arrival_pc = __builtin_return_address(0);
     // Use normal volatile load in the loop for speed until GC finishes.
     // Then use an acquire load to make sure the GC result is visible on this thread.
     while (jl_atomic_load_relaxed(&jl_gc_running) || jl_atomic_load_acquire(&jl_gc_running)) {
@@ -330,10 +533,14 @@ int jl_safepoint_resume_thread(int tid) JL_NOTSAFEPOINT
     uv_mutex_lock(&ptls2->sleep_lock);
     int16_t suspend_count = jl_atomic_load_relaxed(&ptls2->suspend_count);
     if (suspend_count == 1) { // last to unsuspend
-        if (tid == 0)
-            jl_atomic_store_relaxed(&ptls2->safepoint, (size_t*)(jl_safepoint_pages + jl_page_size));
+        // restore the poll pointer; if the GC page is armed in the
+        // membarrier mode, the thread has to point at the armed page
+        // instead so it cannot escape an in-progress stop-the-world
+        int idx = tid == 0 ? 1 : 2;
+        if (jl_safepoint_membarrier_mode && jl_safepoint_enable_cnt[idx])
+            jl_atomic_store_relaxed(&ptls2->safepoint, jl_safepoint_armed_addr());
         else
-            jl_atomic_store_relaxed(&ptls2->safepoint, (size_t*)(jl_safepoint_pages + jl_page_size * 2 + sizeof(void*)));
+            jl_atomic_store_relaxed(&ptls2->safepoint, jl_safepoint_poll_addr(tid));
         uv_cond_signal(&ptls2->wake_signal);
 #ifdef _OS_DARWIN_
         jl_safepoint_resume_thread_mach(ptls2, tid);
@@ -20,6 +20,9 @@ extern "C" {
 // default to DEFAULT_THREAD_SLEEP_THRESHOLD; set via $JULIA_THREAD_SLEEP_THRESHOLD
 uint64_t sleep_threshold;
 
+// smallest per-thread spin budget, as a divisor of sleep_threshold
+#define SLEEP_SPIN_MIN_DIV 16
+
 // thread should not be sleeping--it might need to do work.
 static const int16_t not_sleeping = 0;
 
@@ -94,6 +97,8 @@ JL_DLLEXPORT uint32_t jl_rand_ptls(uint32_t max)
     return cong(max, &ptls->rngseed);
 }
 
+static void jl_init_timeout_wheel(void) JL_NOTSAFEPOINT;
+
 // initialize the threading infrastructure
 // (called only by the main thread)
 void jl_init_threadinginfra(void)
@@ -107,6 +112,8 @@ void jl_init_threadinginfra(void)
         else
             sleep_threshold = (uint64_t)strtol(cp, NULL, 10);
     }
+
+    jl_init_timeout_wheel();
 }
 
 
@@ -147,6 +154,7 @@ void jl_parallel_gc_threadfun(void *arg)
             gc_mark_loop_parallel(ptls, 0);
         }
         if (may_sweep(ptls)) { // not an else!
+            gc_sweep_big_parallel();
             gc_sweep_pool_parallel();
             jl_atomic_fetch_add(&ptls->gc_sweeps_requested, -1);
         }
@@ -170,6 +178,11 @@ void jl_concurrent_gc_threadfun(void *arg)
 
     while (1) {
         uv_sem_wait(&gc_sweep_assists_needed);
+        // release the memory unlinked inside the pause before the pool
+        // pages: stacks and malloc'd buffers are what task-heavy and
+        // array-heavy workloads are waiting to get back
+        gc_free_deferred_stacks();
+        gc_free_deferred_memory();
         gc_free_pages();
     }
 }
@@ -240,8 +253,42 @@ int jl_running_under_rr(int recheck)
 }
 
 
-//  sleep_check_after_threshold() -- if sleep_threshold ns have passed, return 1
-static int sleep_check_after_threshold(uint64_t *start_cycles) JL_NOTSAFEPOINT
+// the thread's current spin budget, clamped to [0, sleep_threshold]
+// (0 means not yet initialized, i.e. use the full threshold)
+static uint64_t spin_budget(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    uint64_t spin_ns = ptls->sched_spin_ns;
+    if (spin_ns == 0 || spin_ns > sleep_threshold)
+        spin_ns = sleep_threshold;
+    return spin_ns;
+}
+
+// Adjust the spin budget after the thread slept for `slept_ns`: a wakeup
+// arriving within a full sleep_threshold of parking means the wake round-trip
+// cost more than spinning a bit longer would have, so grow the budget; a long
+// sleep means further spinning would have been wasted, so shrink it towards
+// sleep_threshold/SLEEP_SPIN_MIN_DIV. This keeps threads spinning through
+// fine-grained `@spawn` bursts while letting mostly-idle threads park quickly.
+static void update_spin_budget(jl_ptls_t ptls, uint64_t slept_ns) JL_NOTSAFEPOINT
+{
+    if (sleep_threshold == UINT64_MAX) // "infinite": threads never park on the budget
+        return;
+    uint64_t spin_ns = spin_budget(ptls);
+    if (slept_ns < sleep_threshold) {
+        spin_ns *= 2;
+        if (spin_ns > sleep_threshold)
+            spin_ns = sleep_threshold;
+    }
+    else {
+        spin_ns /= 2;
+        if (spin_ns < sleep_threshold / SLEEP_SPIN_MIN_DIV)
+            spin_ns = sleep_threshold / SLEEP_SPIN_MIN_DIV;
+    }
+    ptls->sched_spin_ns = spin_ns;
+}
+
+//  sleep_check_after_threshold() -- if the thread's spin budget has passed, return 1
+static int sleep_check_after_threshold(jl_ptls_t ptls, uint64_t *start_cycles) JL_NOTSAFEPOINT
 {
     JULIA_DEBUG_SLEEPWAKE( return 1 ); // hammer on the sleep/wake logic much harder
     /**
@@ -257,7 +304,7 @@ static int sleep_check_after_threshold(uint64_t *start_cycles) JL_NOTSAFEPOINT
         return 0;
     }
     uint64_t elapsed_cycles = jl_hrtime() - (*start_cycles);
-    if (elapsed_cycles >= sleep_threshold) {
+    if (elapsed_cycles >= spin_budget(ptls)) {
         *start_cycles = 0;
         return 1;
     }
@@ -304,10 +351,75 @@ static void wake_libuv(void) JL_NOTSAFEPOINT
 }
 
 /* ensure thread tid is awake if necessary */
+// Wakeup batching for event-loop passes. While a thread drains the event
+// loop (jl_process_events), each completion callback that schedules a task
+// would normally trigger its own round of thread wakeups under high
+// connection counts. During a batch window the wakeup requests are only
+// recorded here and delivered in one shot after the pass has finished and
+// the libuv lock has been released. Only the window owner touches the
+// fields, so they need no lock of their own; the owner tid is atomic
+// because jl_wakeup_thread reads it from other threads.
+static _Atomic(int16_t) uv_wake_batch_owner = -1;
+static int16_t uv_wake_batch_tid; // -2 none, -1 all threads, >= 0 single tid
+static int uv_wake_batch_count;
+
+// open a batch window; the caller must hold jl_uv_mutex (a nested call --
+// possible because the lock is recursive -- leaves the outer window in place)
+void jl_uv_wake_batch_begin(void) JL_NOTSAFEPOINT
+{
+    jl_task_t *ct = jl_current_task;
+    if (jl_atomic_load_relaxed(&uv_wake_batch_owner) != -1)
+        return;
+    uv_wake_batch_tid = -2;
+    uv_wake_batch_count = 0;
+    jl_atomic_store_relaxed(&uv_wake_batch_owner, jl_atomic_load_relaxed(&ct->tid));
+}
+
+// close the window (still holding jl_uv_mutex) and return the pending
+// wakeups, encoded for jl_uv_wake_batch_flush; a nested close delivers the
+// outer window's requests early rather than dropping them
+uint32_t jl_uv_wake_batch_close(void) JL_NOTSAFEPOINT
+{
+    jl_atomic_store_relaxed(&uv_wake_batch_owner, -1);
+    if (uv_wake_batch_tid == -2 || uv_wake_batch_count == 0)
+        return 0;
+    uint32_t count = uv_wake_batch_count > UINT16_MAX ? UINT16_MAX : (uint32_t)uv_wake_batch_count;
+    uint32_t pending = (count << 16) | (uint16_t)uv_wake_batch_tid;
+    uv_wake_batch_tid = -2;
+    uv_wake_batch_count = 0;
+    return pending;
+}
+
+// deliver the wakeups recorded during a batch window, after releasing
+// jl_uv_mutex
+void jl_uv_wake_batch_flush(uint32_t pending)
+{
+    if (pending == 0)
+        return;
+    int16_t tid = (int16_t)(pending & 0xffff);
+    int16_t count = (int16_t)(pending >> 16);
+    if (tid >= 0)
+        jl_wakeup_thread(tid);
+    else
+        // one task may have been scheduled per recorded wakeup; waking more
+        // threads than that cannot help
+        jl_wakeup_threads(count);
+}
+
 JL_DLLEXPORT void jl_wakeup_thread(int16_t tid) JL_NOTSAFEPOINT
 {
     jl_task_t *ct = jl_current_task;
     int16_t self = jl_atomic_load_relaxed(&ct->tid);
+    if (jl_atomic_load_relaxed(&uv_wake_batch_owner) == self) {
+        // a callback running inside an event-loop pass: record the request
+        // and deliver it when the pass completes (see jl_process_events)
+        if (uv_wake_batch_tid == -2)
+            uv_wake_batch_tid = tid;
+        else if (uv_wake_batch_tid != tid)
+            uv_wake_batch_tid = -1;
+        uv_wake_batch_count++;
+        return;
+    }
     if (tid != self)
         jl_fence(); // [^store_buffering_1]
     jl_task_t *uvlock = jl_atomic_load_relaxed(&jl_uv_mutex.owner);
@@ -361,17 +473,415 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid) JL_NOTSAFEPOINT
     JULIA_DEBUG_SLEEPWAKE( wakeup_leave = cycleclock() );
 }
 
+// Wake up to `n` sleeping threads to pick up a batch of newly enqueued work.
+// Equivalent to jl_wakeup_thread(-1) for the multiqueue, except that the
+// wakeup is issued once for the whole batch instead of once per task, and
+// stops once enough threads have been woken to drain it.
+JL_DLLEXPORT void jl_wakeup_threads(int16_t n) JL_NOTSAFEPOINT
+{
+    jl_task_t *ct = jl_current_task;
+    int16_t self = jl_atomic_load_relaxed(&ct->tid);
+    jl_fence(); // [^store_buffering_1]
+    jl_task_t *uvlock = jl_atomic_load_relaxed(&jl_uv_mutex.owner);
+    JULIA_DEBUG_SLEEPWAKE( wakeup_enter = cycleclock() );
+    // we are awake and count as one runner for the new work, but make sure
+    // we will exit uv_run and that nrunning is updated if this is now
+    // considered in-flight
+    jl_ptls_t ptls = ct->ptls;
+    if (jl_atomic_load_relaxed(&ptls->sleep_check_state) != not_sleeping) {
+        if (jl_atomic_exchange_relaxed(&ptls->sleep_check_state, not_sleeping) != not_sleeping) {
+            int wasrunning = jl_atomic_fetch_add_relaxed(&nrunning, 1);
+            assert(wasrunning); (void)wasrunning;
+            JL_PROBE_RT_SLEEP_CHECK_WAKEUP(ptls);
+        }
+    }
+    if (uvlock == ct)
+        uv_stop(jl_global_event_loop());
+    int anysleep = 0;
+    int woken = 0;
+    int nthreads = jl_atomic_load_acquire(&jl_n_threads);
+    for (int16_t tid = 0; tid < nthreads && woken < n; tid++) {
+        if (tid != self && wake_thread(tid)) {
+            anysleep = 1;
+            woken++;
+        }
+    }
+    // check if we need to notify uv_run too
+    if (uvlock != ct && anysleep) {
+        jl_fence();
+        if (jl_atomic_load_relaxed(&jl_uv_mutex.owner) != NULL)
+            wake_libuv();
+    }
+    JULIA_DEBUG_SLEEPWAKE( wakeup_leave = cycleclock() );
+}
+
+
+// cap on consecutive tasks taken from the LIFO slot, so that a chain of
+// tasks respawning into the slot cannot starve the sticky queue forever
+#define LIFO_SLOT_MAX_STREAK 16
+
+// Try to park a freshly spawned task in this thread's LIFO slot, from where
+// the next call to get_next_task will run it ahead of the multiqueue (its
+// working set is presumably still hot in this core's cache). The slot is
+// invisible to other threads, so the task's tid is claimed here and the
+// caller may skip waking anyone. Returns 0 (and the caller must enqueue the
+// task normally) if the slot is occupied, the task cannot run on this thread,
+// or we are inside the scheduler's sleep protocol (a callback run from
+// jl_task_get_next past the emptiness rechecks could otherwise park a task
+// that no wakeup would ever observe).
+JL_DLLEXPORT int jl_try_lifo_spawn(jl_task_t *task) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    if (ptls->lifo_slot != NULL)
+        return 0;
+    if (jl_atomic_load_relaxed(&ptls->sleep_check_state) != not_sleeping)
+        return 0;
+    if (task->started)
+        return 0; // rescheduled (e.g. yield or notify), not a fresh spawn
+    if (task->threadpoolid != ptls->threadpoolid)
+        return 0;
+    if (!jl_set_task_tid(task, ptls->tid))
+        return 0;
+    ptls->lifo_slot = task;
+    return 1;
+}
+
+// ---- hierarchical timer wheel for coarse task timeouts ----
+//
+// Task timeouts (of the arm-then-usually-cancel kind) do not go through
+// libuv's timer heap, which would serialize 100k connection timeouts behind
+// jl_uv_mutex. Instead they live in a sharded hierarchical wheel: arming and
+// cancelling only take one shard lock, and a single backstop libuv timer --
+// re-armed only when the earliest deadline moves -- wakes the process when
+// everyone is asleep. Expired entries are fired from the scheduler's idle
+// path (jl_timeout_check) by `schedule`ing the registered task.
+
+#define TW_NSHARDS 8            // must be a power of two
+#define TW_NLEVELS 4
+#define TW_SLOT_BITS 6
+#define TW_NSLOTS (1 << TW_SLOT_BITS)
+#define TW_TICK_SHIFT 23        // ~8.4 ms of jl_hrtime ns per level-0 tick
+
+struct _jl_timeout_t {
+    struct _jl_timeout_t *next;
+    struct _jl_timeout_t *prev;
+    jl_task_t *task;            // rooted via jl_timeout_foreach_task
+    uint64_t deadline;          // in jl_hrtime units
+    _Atomic(uint32_t) refc;     // one ref for the wheel, one for the handle
+    uint8_t shard;
+    uint8_t state;              // 0 = armed, 1 = fired or cancelled
+    uint8_t level;
+    uint8_t slot;
+};
+
+typedef struct {
+    uv_mutex_t lock;
+    uint64_t last;              // wheel time: last fully processed tick
+    size_t nentries;            // armed entries in the slots
+    jl_timeout_t *slots[TW_NLEVELS][TW_NSLOTS];
+    jl_timeout_t *firing;       // expired, unlinked, not yet scheduled
+} jl_timeout_shard_t;
+
+static jl_timeout_shard_t timeout_shards[TW_NSHARDS];
+
+static void jl_init_timeout_wheel(void) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < TW_NSHARDS; i++)
+        uv_mutex_init(&timeout_shards[i].lock);
+}
+
+static _Atomic(uint32_t) timeout_shard_cnt = 0;
+// earliest time anything in the wheel might fire; the fast path of
+// jl_timeout_check only reads this
+static _Atomic(uint64_t) timeout_next_wake = UINT64_MAX;
+static uv_timer_t timeout_backstop;
+
+static void tw_release(jl_timeout_t *e) JL_NOTSAFEPOINT
+{
+    if (jl_atomic_fetch_add_relaxed(&e->refc, -1) == 1)
+        free(e);
+}
+
+// place an armed entry in the slot covering its deadline (shard locked)
+static void tw_insert(jl_timeout_shard_t *shard, jl_timeout_t *e) JL_NOTSAFEPOINT
+{
+    uint64_t dt = e->deadline >> TW_TICK_SHIFT;
+    uint64_t last = shard->last;
+    if (dt <= last)
+        dt = last + 1; // already due: fire on the next tick
+    uint64_t delta = dt - last;
+    int level = 0;
+    while (level < TW_NLEVELS - 1 &&
+           (delta >> (TW_SLOT_BITS * (level + 1))) != 0)
+        level++;
+    if ((delta >> (TW_SLOT_BITS * (level + 1))) != 0)
+        // beyond the top level's horizon; park it at the far edge of the top
+        // level, the cascade will move it closer to its true deadline
+        dt = last + ((uint64_t)1 << (TW_SLOT_BITS * TW_NLEVELS)) - 1;
+    int slot = (dt >> (TW_SLOT_BITS * level)) & (TW_NSLOTS - 1);
+    e->level = (uint8_t)level;
+    e->slot = (uint8_t)slot;
+    e->prev = NULL;
+    e->next = shard->slots[level][slot];
+    if (e->next)
+        e->next->prev = e;
+    shard->slots[level][slot] = e;
+}
+
+static void tw_unlink(jl_timeout_t **head, jl_timeout_t *e) JL_NOTSAFEPOINT
+{
+    if (e->prev)
+        e->prev->next = e->next;
+    else
+        *head = e->next;
+    if (e->next)
+        e->next->prev = e->prev;
+}
+
+// advance the wheel to `now` ticks, moving due entries onto the firing list
+// (shard locked)
+static void tw_advance(jl_timeout_shard_t *shard, uint64_t now) JL_NOTSAFEPOINT
+{
+    while (shard->last < now) {
+        if (shard->nentries == 0) {
+            shard->last = now;
+            break;
+        }
+        uint64_t t = ++shard->last;
+        // whenever a level's digit rolls over, re-sort that level's next slot
+        // into the levels below it
+        for (int level = 1; level < TW_NLEVELS; level++) {
+            if ((t & (((uint64_t)1 << (TW_SLOT_BITS * level)) - 1)) != 0)
+                break;
+            int slot = (t >> (TW_SLOT_BITS * level)) & (TW_NSLOTS - 1);
+            jl_timeout_t *e = shard->slots[level][slot];
+            shard->slots[level][slot] = NULL;
+            while (e) {
+                jl_timeout_t *next = e->next;
+                tw_insert(shard, e);
+                e = next;
+            }
+        }
+        int slot = t & (TW_NSLOTS - 1);
+        jl_timeout_t *e = shard->slots[0][slot];
+        shard->slots[0][slot] = NULL;
+        while (e) {
+            jl_timeout_t *next = e->next;
+            e->state = 1;
+            shard->nentries--;
+            e->prev = NULL;
+            e->next = shard->firing;
+            if (e->next)
+                e->next->prev = e;
+            shard->firing = e;
+            e = next;
+        }
+    }
+}
+
+// earliest time (in jl_hrtime units) at which this shard may have something
+// to fire (shard locked)
+static uint64_t tw_next_fire(jl_timeout_shard_t *shard) JL_NOTSAFEPOINT
+{
+    if (shard->nentries == 0)
+        return UINT64_MAX;
+    for (int i = 1; i <= TW_NSLOTS; i++) {
+        uint64_t t = shard->last + i;
+        if (shard->slots[0][t & (TW_NSLOTS - 1)] != NULL)
+            return t << TW_TICK_SHIFT;
+        if ((t & (TW_NSLOTS - 1)) == 0)
+            // entries due later sit in the higher levels and cannot surface
+            // before this cascade boundary
+            return t << TW_TICK_SHIFT;
+    }
+    return UINT64_MAX; // unreachable
+}
+
+static void timeout_schedule_task(jl_task_t *task)
+{
+    static jl_function_t *sched_func = NULL;
+    if (!sched_func)
+        sched_func = (jl_function_t*)jl_get_global(jl_base_module, jl_symbol("schedule"));
+    jl_task_t *ct = jl_current_task;
+    size_t last_age = ct->world_age;
+    ct->world_age = jl_get_world_counter();
+    jl_value_t *args[2] = {(jl_value_t*)sched_func, (jl_value_t*)task};
+    jl_apply(args, 2);
+    ct->world_age = last_age;
+}
+
+static void timeout_arm_backstop(uint64_t now, uint64_t deadline) JL_NOTSAFEPOINT;
+
+static void timeout_backstop_cb(uv_timer_t *t)
+{
+    (void)t;
+    jl_timeout_check();
+    // we run inside uv_run, which holds jl_uv_mutex, so we may re-arm
+    // directly for whatever is due next
+    timeout_arm_backstop(jl_hrtime(), jl_atomic_load_relaxed(&timeout_next_wake));
+}
+
+// (re-)arm the backstop libuv timer; caller must hold jl_uv_mutex
+static void timeout_arm_backstop(uint64_t now, uint64_t deadline) JL_NOTSAFEPOINT
+{
+    if (jl_io_loop == NULL)
+        return;
+    if (deadline == UINT64_MAX) {
+        if (timeout_backstop.type == UV_TIMER)
+            uv_timer_stop(&timeout_backstop);
+        return;
+    }
+    if (timeout_backstop.type != UV_TIMER) {
+        uv_timer_init(jl_io_loop, &timeout_backstop);
+        // hidden from uv_walk reporting; signal_async keeps the loop alive
+        uv_unref((uv_handle_t*)&timeout_backstop);
+    }
+    uint64_t ms = deadline <= now ? 0 : (deadline - now) / 1000000 + 1;
+    uv_update_time(jl_io_loop);
+    uv_timer_start(&timeout_backstop, timeout_backstop_cb, ms, 0);
+}
+
+// fire everything that is due; called from the scheduler's idle path and the
+// backstop timer
+void jl_timeout_check(void)
+{
+    uint64_t now = jl_hrtime();
+    if (now < jl_atomic_load_relaxed(&timeout_next_wake))
+        return;
+    jl_atomic_store_relaxed(&timeout_next_wake, UINT64_MAX);
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < TW_NSHARDS; i++) {
+        jl_timeout_shard_t *shard = &timeout_shards[i];
+        if (shard->nentries == 0 && shard->firing == NULL) // benign racy read
+            continue;
+        jl_timeout_t *e;
+        uv_mutex_lock(&shard->lock);
+        tw_advance(shard, now >> TW_TICK_SHIFT);
+        while ((e = shard->firing) != NULL) {
+            shard->firing = e->next;
+            if (shard->firing)
+                shard->firing->prev = NULL;
+            jl_task_t *task = e->task;
+            uv_mutex_unlock(&shard->lock);
+            tw_release(e); // the wheel's ref; the handle's is still out
+            JL_GC_PUSH1(&task);
+            timeout_schedule_task(task);
+            JL_GC_POP();
+            uv_mutex_lock(&shard->lock);
+        }
+        uint64_t fire = tw_next_fire(shard);
+        uv_mutex_unlock(&shard->lock);
+        if (fire < next)
+            next = fire;
+    }
+    // lower the global wake time; a concurrent jl_timeout_start may race us
+    // to something even earlier
+    uint64_t prev = jl_atomic_load_relaxed(&timeout_next_wake);
+    while (next < prev &&
+           !jl_atomic_cmpswap_relaxed(&timeout_next_wake, &prev, next))
+        ;
+}
+
+// Arm a timeout that `schedule`s `task` about `timeout_ns` from now, unless
+// cancelled first. The returned handle must be released with exactly one call
+// to jl_timeout_cancel; a successful cancel (the common case) never touches
+// the libuv loop. The caller is responsible for ensuring the task can only be
+// made runnable by whichever of cancel/expiry claims the handle.
+JL_DLLEXPORT jl_timeout_t *jl_timeout_start(jl_task_t *task, uint64_t timeout_ns)
+{
+    jl_timeout_t *e = (jl_timeout_t*)malloc_s(sizeof(jl_timeout_t));
+    uint64_t now = jl_hrtime();
+    e->task = task;
+    e->deadline = now + timeout_ns;
+    jl_atomic_store_relaxed(&e->refc, 2);
+    e->state = 0;
+    // round-robin the shards so one hot connection pool spreads out
+    e->shard = jl_atomic_fetch_add_relaxed(&timeout_shard_cnt, 1) & (TW_NSHARDS - 1);
+    jl_timeout_shard_t *shard = &timeout_shards[e->shard];
+    uv_mutex_lock(&shard->lock);
+    tw_advance(shard, now >> TW_TICK_SHIFT); // keep `last` fresh so placement is tight
+    tw_insert(shard, e);
+    shard->nentries++;
+    uv_mutex_unlock(&shard->lock);
+    // if this became the earliest deadline, pull the backstop timer in
+    uint64_t prev = jl_atomic_load_relaxed(&timeout_next_wake);
+    while (e->deadline < prev) {
+        if (jl_atomic_cmpswap_relaxed(&timeout_next_wake, &prev, e->deadline)) {
+            JL_UV_LOCK();
+            timeout_arm_backstop(now, e->deadline);
+            JL_UV_UNLOCK();
+            break;
+        }
+    }
+    return e;
+}
+
+// Release the handle returned by jl_timeout_start. Returns 1 if the timeout
+// was still pending (it will never fire; waking the task is now the caller's
+// job), 0 if it already fired or is firing.
+JL_DLLEXPORT int jl_timeout_cancel(jl_timeout_t *timer) JL_NOTSAFEPOINT
+{
+    jl_timeout_shard_t *shard = &timeout_shards[timer->shard];
+    int won = 0;
+    uv_mutex_lock(&shard->lock);
+    if (timer->state == 0) {
+        tw_unlink(&shard->slots[timer->level][timer->slot], timer);
+        shard->nentries--;
+        timer->state = 1;
+        won = 1;
+    }
+    uv_mutex_unlock(&shard->lock);
+    // the backstop may now fire early once; it will simply find nothing due
+    if (won)
+        tw_release(timer); // the wheel's ref
+    tw_release(timer); // the handle's ref
+    return won;
+}
+
+// walk every task with a pending timeout, for GC root marking; all mutators
+// are stopped, so the shard locks are uncontended except for GC-safe parkers
+void jl_timeout_foreach_task(void (*visit)(jl_task_t *t, void *ctx), void *ctx) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < TW_NSHARDS; i++) {
+        jl_timeout_shard_t *shard = &timeout_shards[i];
+        uv_mutex_lock(&shard->lock);
+        for (int level = 0; level < TW_NLEVELS; level++)
+            for (int slot = 0; slot < TW_NSLOTS; slot++)
+                for (jl_timeout_t *e = shard->slots[level][slot]; e; e = e->next)
+                    visit(e->task, ctx);
+        for (jl_timeout_t *e = shard->firing; e; e = e->next)
+            visit(e->task, ctx);
+        uv_mutex_unlock(&shard->lock);
+    }
+}
 
 // get the next runnable task
 static jl_task_t *get_next_task(jl_value_t *trypoptask, jl_value_t *q)
 {
     jl_gc_safepoint();
-    jl_task_t *task = (jl_task_t*)jl_apply_generic(trypoptask, &q, 1);
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_task_t *task = ptls->lifo_slot;
+    if (task != NULL && ptls->lifo_streak < LIFO_SLOT_MAX_STREAK) {
+        ptls->lifo_slot = NULL;
+        ptls->lifo_streak++;
+        assert(jl_atomic_load_relaxed(&task->tid) == ptls->tid); // claimed at spawn
+        return task;
+    }
+    ptls->lifo_streak = 0;
+    task = (jl_task_t*)jl_apply_generic(trypoptask, &q, 1);
     if (jl_is_task(task)) {
         int self = jl_atomic_load_relaxed(&jl_current_task->tid);
         jl_set_task_tid(task, self);
         return task;
     }
+    // past the streak cap but nothing else is runnable: drain the slot anyway
+    ptls = jl_current_task->ptls; // trypoptask may have yielded
+    task = ptls->lifo_slot;
+    if (task != NULL) {
+        ptls->lifo_slot = NULL;
+        assert(jl_atomic_load_relaxed(&task->tid) == ptls->tid);
+        return task;
+    }
     return NULL;
 }
 
@@ -440,7 +950,7 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
 
         jl_cpu_pause();
         jl_ptls_t ptls = ct->ptls;
-        if (sleep_check_after_threshold(&start_cycles) || (ptls->tid == 0 && (!jl_atomic_load_relaxed(&_threadedregion) || wait_empty))) {
+        if (sleep_check_after_threshold(ptls, &start_cycles) || (ptls->tid == 0 && (!jl_atomic_load_relaxed(&_threadedregion) || wait_empty))) {
             // acquire sleep-check lock
             jl_atomic_store_relaxed(&ptls->sleep_check_state, sleeping);
             jl_fence(); // [^store_buffering_1]
@@ -539,6 +1049,10 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
                 }
             }
 
+            // time the sleep so the spin budget can be retuned on wakeup
+            // (not under rr, where the budget is never consulted anyway)
+            uint64_t sleep_start = jl_running_under_rr(0) ? 0 : jl_hrtime();
+
             // any thread which wants us running again will have to observe
             // sleep_check_state==sleeping and increment nrunning for us
             int wasrunning = jl_atomic_fetch_add_relaxed(&nrunning, -1);
@@ -578,6 +1092,8 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
             assert(jl_atomic_load_relaxed(&nrunning));
             start_cycles = 0;
             uv_mutex_unlock(&ptls->sleep_lock);
+            if (sleep_start)
+                update_spin_budget(ptls, jl_hrtime() - sleep_start);
             JULIA_DEBUG_SLEEPWAKE( ptls->sleep_leave = cycleclock() );
             jl_gc_safe_leave(ptls, gc_state); // contains jl_gc_safepoint
             if (task) {
@@ -588,6 +1104,7 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
         }
         else {
             // maybe check the kernel for new messages too
+            jl_timeout_check();
             jl_process_events();
         }
     }
@@ -614,6 +1131,14 @@ void scheduler_delete_thread(jl_ptls_t ptls) JL_NOTSAFEPOINT
     jl_atomic_fetch_add_relaxed(&nrunning, -1);
 }
 
+// re-arm the scheduler state of a departed thread's ptls before an adopted
+// thread takes it over again (counterpart of scheduler_delete_thread)
+void scheduler_revive_thread(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    jl_atomic_store_relaxed(&ptls->sleep_check_state, not_sleeping);
+    jl_atomic_fetch_add_relaxed(&nrunning, 1);
+}
+
 #ifdef __cplusplus
 }
 #endif
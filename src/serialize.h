@@ -65,8 +65,9 @@ extern "C" {
 #define TAG_RELOC_METHODROOT   57
 #define TAG_BINDING            58
 #define TAG_MEMORYT            59
+#define TAG_DYNAMICSYM         60
 
-#define LAST_TAG 59
+#define LAST_TAG 60
 
 #define write_uint8(s, n) ios_putc((n), (s))
 #define read_uint8(s) ((uint8_t)ios_getc((s)))
@@ -19,7 +19,20 @@ extern "C" {
 
 // Profiler control variables
 // Note: these "static" variables are also used in "signals-*.c"
-static volatile jl_bt_element_t *bt_data_prof = NULL;
+//
+// Samples are collected into per-thread buffers, each with its own cursor and
+// an overflow counter, so a full buffer on one thread neither stops sampling
+// on the others nor goes unnoticed. The legacy single buffer below is only
+// (re)assembled from them when the data is fetched.
+typedef struct {
+    jl_bt_element_t *data;
+    size_t size_max;
+    size_t size_cur;
+    uint64_t noverflow; // samples dropped because this buffer was full
+} jl_profile_thread_buffer_t;
+static jl_profile_thread_buffer_t *profile_buffers = NULL;
+static int profile_buffers_len = 0;
+static volatile jl_bt_element_t *bt_data_prof = NULL; // merged on fetch
 static volatile size_t bt_size_max = 0;
 static volatile size_t bt_size_cur = 0;
 static volatile uint64_t nsecprof = 0;
@@ -42,16 +55,104 @@ JL_DLLEXPORT int jl_profile_init(size_t maxsize, uint64_t delay_nsec)
     if (bt_data_prof == NULL && maxsize > 0)
         return -1;
     bt_size_cur = 0;
+    // per-thread sample buffers, splitting the requested capacity evenly so
+    // the merged result always fits in the legacy buffer above
+    if (profile_buffers != NULL) {
+        for (int i = 0; i < profile_buffers_len; i++)
+            free(profile_buffers[i].data);
+        free(profile_buffers);
+        profile_buffers = NULL;
+        profile_buffers_len = 0;
+    }
+    if (maxsize > 0) {
+        int nthreads = jl_atomic_load_acquire(&jl_n_threads);
+        profile_buffers = (jl_profile_thread_buffer_t*)
+            calloc(nthreads, sizeof(jl_profile_thread_buffer_t));
+        if (profile_buffers == NULL)
+            return -1;
+        size_t per_thread = maxsize / nthreads;
+        for (int i = 0; i < nthreads; i++) {
+            profile_buffers[i].data = (jl_bt_element_t*)calloc(per_thread, sizeof(jl_bt_element_t));
+            if (profile_buffers[i].data == NULL)
+                return -1;
+            profile_buffers[i].size_max = per_thread;
+        }
+        profile_buffers_len = nthreads;
+    }
     return 0;
 }
 
+// Begin one sample for thread `tid`: return where to write backtrace frames
+// (with `*space` frame slots available, leaving room for the metadata
+// trailer) or NULL when the sample does not fit, counting the overflow.
+// Only called by the sampler, which owns every cursor while it holds the
+// profile read-lock with the target thread suspended.
+static jl_bt_element_t *jl_profile_sample_begin(int tid, size_t *space) JL_NOTSAFEPOINT
+{
+    // `+ 6` is for the two block terminator `0`'s plus the 4 metadata entries
+    const size_t trailer = (JL_BT_MAX_ENTRY_SIZE + 1) + 6;
+    if (profile_buffers == NULL || tid < 0 || tid >= profile_buffers_len)
+        return NULL; // e.g. a thread adopted after jl_profile_init
+    jl_profile_thread_buffer_t *buf = &profile_buffers[tid];
+    if (buf->size_cur + trailer > buf->size_max) {
+        buf->noverflow++;
+        return NULL;
+    }
+    *space = buf->size_max - buf->size_cur - 7;
+    return buf->data + buf->size_cur;
+}
+
+// Finish the sample started by jl_profile_sample_begin, appending the
+// metadata entries and the block terminator after the `nframes` frames the
+// caller wrote.
+static void jl_profile_sample_commit(int tid, size_t nframes, jl_ptls_t ptls2) JL_NOTSAFEPOINT
+{
+    jl_profile_thread_buffer_t *buf = &profile_buffers[tid];
+    jl_bt_element_t *data = buf->data;
+    size_t cur = buf->size_cur + nframes;
+    // store threadid but add 1 as 0 is preserved to indicate end of block
+    data[cur++].uintptr = ptls2->tid + 1;
+    // store task id (never null)
+    data[cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls2->current_task);
+    // store cpu cycle clock
+    data[cur++].uintptr = cycleclock();
+    // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
+    data[cur++].uintptr = jl_atomic_load_relaxed(&ptls2->sleep_check_state) + 1;
+    // Mark the end of this block with two 0's
+    data[cur++].uintptr = 0;
+    data[cur++].uintptr = 0;
+    buf->size_cur = cur;
+}
+
+// Concatenate the per-thread buffers into the legacy merged buffer. Takes
+// the profile write-lock, so it cannot run concurrently with the sampler
+// (which holds the read-lock while it writes).
+static void jl_profile_merge_data(void)
+{
+    if (profile_buffers == NULL)
+        return;
+    jl_lock_profile_wr();
+    size_t cur = 0;
+    for (int i = 0; i < profile_buffers_len; i++) {
+        jl_profile_thread_buffer_t *buf = &profile_buffers[i];
+        assert(cur + buf->size_cur <= bt_size_max);
+        memcpy((jl_bt_element_t*)bt_data_prof + cur, buf->data,
+               buf->size_cur * sizeof(jl_bt_element_t));
+        cur += buf->size_cur;
+    }
+    bt_size_cur = cur;
+    jl_unlock_profile_wr();
+}
+
 JL_DLLEXPORT uint8_t *jl_profile_get_data(void)
 {
+    jl_profile_merge_data();
     return (uint8_t*) bt_data_prof;
 }
 
 JL_DLLEXPORT size_t jl_profile_len_data(void)
 {
+    jl_profile_merge_data();
     return bt_size_cur;
 }
 
@@ -60,6 +161,15 @@ JL_DLLEXPORT size_t jl_profile_maxlen_data(void)
     return bt_size_max;
 }
 
+// Total samples dropped because the buffer of the sampled thread was full.
+JL_DLLEXPORT uint64_t jl_profile_overflow_count(void)
+{
+    uint64_t n = 0;
+    for (int i = 0; i < profile_buffers_len; i++)
+        n += profile_buffers[i].noverflow;
+    return n;
+}
+
 JL_DLLEXPORT uint64_t jl_profile_delay_nsec(void)
 {
     return nsecprof;
@@ -68,6 +178,10 @@ JL_DLLEXPORT uint64_t jl_profile_delay_nsec(void)
 JL_DLLEXPORT void jl_profile_clear_data(void)
 {
     bt_size_cur = 0;
+    for (int i = 0; i < profile_buffers_len; i++) {
+        profile_buffers[i].size_cur = 0;
+        profile_buffers[i].noverflow = 0;
+    }
 }
 
 JL_DLLEXPORT int jl_profile_is_running(void)
@@ -181,10 +295,18 @@ static int *profile_get_randperm(int size)
 
 JL_DLLEXPORT int jl_profile_is_buffer_full(void)
 {
-    // Declare buffer full if there isn't enough room to sample even just the
-    // thread metadata and one max-sized frame. The `+ 6` is for the two block
-    // terminator `0`'s plus the 4 metadata entries.
-    return bt_size_cur + ((JL_BT_MAX_ENTRY_SIZE + 1) + 6) > bt_size_max;
+    // Declare a buffer full if there isn't enough room to sample even just
+    // the thread metadata and one max-sized frame. The `+ 6` is for the two
+    // block terminator `0`'s plus the 4 metadata entries. With per-thread
+    // buffers, the profile as a whole is only full once every thread's
+    // buffer is; individual overflows are counted instead of ending sampling.
+    if (profile_buffers == NULL)
+        return bt_size_cur + ((JL_BT_MAX_ENTRY_SIZE + 1) + 6) > bt_size_max;
+    for (int i = 0; i < profile_buffers_len; i++) {
+        if (profile_buffers[i].size_cur + ((JL_BT_MAX_ENTRY_SIZE + 1) + 6) <= profile_buffers[i].size_max)
+            return 0;
+    }
+    return 1;
 }
 
 static uint64_t jl_last_sigint_trigger = 0;
@@ -681,7 +681,10 @@ void *mach_profile_listener(void *arg)
                 _dyld_dlopen_atfork_parent();
             if (!valid_thread)
                 continue;
-            if (running) {
+            size_t space = 0;
+            jl_bt_element_t *dest = running ? jl_profile_sample_begin(i, &space) : NULL;
+            if (dest != NULL) {
+                size_t nframes = 0;
 #ifdef LLVMLIBUNWIND
                 /*
                  *  Unfortunately compact unwind info is incorrectly generated for quite a number of
@@ -702,10 +705,10 @@ void *mach_profile_listener(void *arg)
 
                 if (forceDwarf == 0) {
                     // Save the backtrace
-                    bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                    nframes = rec_backtrace_ctx(dest, space, uc, NULL);
                 }
                 else if (forceDwarf == 1) {
-                    bt_size_cur += rec_backtrace_ctx_dwarf((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                    nframes = rec_backtrace_ctx_dwarf(dest, space, uc, NULL);
                 }
                 else if (forceDwarf == -1) {
                     jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
@@ -713,25 +716,12 @@ void *mach_profile_listener(void *arg)
 
                 forceDwarf = -2;
 #else
-                bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                nframes = rec_backtrace_ctx(dest, space, uc, NULL);
 #endif
                 jl_ptls_t ptls = jl_atomic_load_relaxed(&jl_all_tls_states)[i];
 
-                // store threadid but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = ptls->tid + 1;
-
-                // store task id (never null)
-                bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
-
-                // store cpu cycle clock
-                bt_data_prof[bt_size_cur++].uintptr = cycleclock();
-
-                // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
-
-                // Mark the end of this block with two 0's
-                bt_data_prof[bt_size_cur++].uintptr = 0;
-                bt_data_prof[bt_size_cur++].uintptr = 0;
+                // append the metadata trailer and publish the sample
+                jl_profile_sample_commit(i, nframes, ptls);
             }
             // We're done! Resume the thread.
             jl_thread_resume(i);
@@ -783,6 +773,12 @@ JL_DLLEXPORT int jl_profile_start_timer(void)
     return 0;
 }
 
+// CPU-time sampling is not available through the mach clock service
+JL_DLLEXPORT int jl_profile_start_timer_cputime(void)
+{
+    return -2;
+}
+
 JL_DLLEXPORT void jl_profile_stop_timer(void)
 {
     running = 0;
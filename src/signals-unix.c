@@ -350,6 +350,48 @@ static int jl_is_on_sigstack(jl_ptls_t ptls, void *ptr, void *context)
             is_addr_on_sigstack(ptls, (void*)jl_get_rsp_from_ctx(context)));
 }
 
+// The membarrier stop-the-world mode (see safepoint.c) parks the per-thread
+// poll pointers at a page that stays PROT_NONE for the whole lifetime of the
+// process, so re-executing the faulting poll load with the armed address
+// still live in a register would fault again immediately. Rewrite any
+// general-purpose register holding an armed-page address to the thread's
+// regular (always readable) poll page before resuming.
+#if defined(_OS_LINUX_) && defined(_CPU_X86_64_)
+static void jl_safepoint_remap_context(jl_ptls_t ptls, void *context) JL_NOTSAFEPOINT
+{
+    ucontext_t *ctx = (ucontext_t*)context;
+    // only the data registers; REG_CR2 in particular holds the fault address
+    static const int gp_regs[] = {
+        REG_RAX, REG_RBX, REG_RCX, REG_RDX, REG_RSI, REG_RDI, REG_RBP,
+        REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15};
+    for (size_t i = 0; i < sizeof(gp_regs) / sizeof(gp_regs[0]); i++) {
+        uintptr_t remapped = jl_safepoint_remap_armed_addr(
+                (uintptr_t)ctx->uc_mcontext.gregs[gp_regs[i]], ptls->tid);
+        if (remapped)
+            ctx->uc_mcontext.gregs[gp_regs[i]] = (greg_t)remapped;
+    }
+}
+#elif defined(_OS_LINUX_) && defined(_CPU_AARCH64_)
+static void jl_safepoint_remap_context(jl_ptls_t ptls, void *context) JL_NOTSAFEPOINT
+{
+    ucontext_t *ctx = (ucontext_t*)context;
+    for (int i = 0; i < 31; i++) {
+        uintptr_t remapped = jl_safepoint_remap_armed_addr(
+                (uintptr_t)ctx->uc_mcontext.regs[i], ptls->tid);
+        if (remapped)
+            ctx->uc_mcontext.regs[i] = remapped;
+    }
+}
+#else
+static void jl_safepoint_remap_context(jl_ptls_t ptls, void *context) JL_NOTSAFEPOINT
+{
+    // the membarrier mode is not available here; the mprotect'ed pages become
+    // readable again on disarm, so the faulting load can simply be re-executed
+    (void)ptls;
+    (void)context;
+}
+#endif
+
 JL_NO_ASAN static void segv_handler(int sig, siginfo_t *info, void *context)
 {
     assert(sig == SIGSEGV || sig == SIGBUS);
@@ -363,6 +405,7 @@ JL_NO_ASAN static void segv_handler(int sig, siginfo_t *info, void *context)
         return;
     }
     if (sig == SIGSEGV && info->si_code == SEGV_ACCERR && jl_addr_is_safepoint((uintptr_t)info->si_addr) && !is_write_fault(context)) {
+        jl_safepoint_remap_context(ct->ptls, context);
         jl_set_gc_and_wait();
         // Do not raise sigint on worker thread
         if (jl_atomic_load_relaxed(&ct->tid) != 0)
@@ -578,6 +621,15 @@ int timer_graceperiod_elapsed(void)
 static timer_t timerprof;
 static struct itimerspec itsprof;
 
+// CPU-time profiling mode: one POSIX timer per thread, armed on that
+// thread's CPU clock so that only threads actually burning CPU get sampled.
+// The timers are created centrally (via pthread_getcpuclockid) and all
+// deliver SIGUSR1 to the process; the listener tells them apart from the
+// wall-clock timer by the sival_ptr, which points into this array.
+static timer_t *cpu_timerprofs = NULL;
+static int n_cpu_timerprofs = 0;
+static int profile_cputime = 0;
+
 JL_DLLEXPORT int jl_profile_start_timer(void)
 {
     struct sigevent sigprof;
@@ -606,10 +658,65 @@ JL_DLLEXPORT int jl_profile_start_timer(void)
     return 0;
 }
 
+// Like jl_profile_start_timer, but samples on CPU time instead of wall time:
+// each existing thread gets its own timer armed on its CPU clock, so a thread
+// is only sampled in proportion to the CPU it actually burns. Threads started
+// or adopted after this call are not sampled until profiling is restarted.
+JL_DLLEXPORT int jl_profile_start_timer_cputime(void)
+{
+    int nthreads = jl_atomic_load_acquire(&jl_n_threads);
+    jl_ptls_t *allstates = jl_atomic_load_relaxed(&jl_all_tls_states);
+    // the previous array is kept alive across jl_profile_stop_timer so that a
+    // trailing rearm in the listener never touches freed memory; reclaim it now
+    free(cpu_timerprofs);
+    cpu_timerprofs = (timer_t*)calloc(nthreads, sizeof(timer_t));
+    if (cpu_timerprofs == NULL)
+        return -2;
+    n_cpu_timerprofs = nthreads;
+
+    itsprof.it_interval.tv_sec = 0;
+    itsprof.it_interval.tv_nsec = 0;
+    itsprof.it_value.tv_sec = nsecprof / GIGA;
+    itsprof.it_value.tv_nsec = nsecprof % GIGA;
+
+    // Because SIGUSR1 is multipurpose, set `running` before so that we know that the first SIGUSR1 came from a timer
+    running = 1;
+    profile_cputime = 1;
+    for (int i = 0; i < nthreads; i++) {
+        clockid_t clock;
+        struct sigevent sigprof;
+        memset(&sigprof, 0, sizeof(struct sigevent));
+        sigprof.sigev_notify = SIGEV_SIGNAL;
+        sigprof.sigev_signo = SIGUSR1;
+        sigprof.sigev_value.sival_ptr = &cpu_timerprofs[i];
+        int err = -2;
+        if (pthread_getcpuclockid((pthread_t)allstates[i]->system_id, &clock) != 0 ||
+            timer_create(clock, &sigprof, &cpu_timerprofs[i]) == -1 ||
+            (err = -3, timer_settime(cpu_timerprofs[i], 0, &itsprof, NULL) == -1)) {
+            // all-or-nothing: tear down whatever was created so far
+            for (int j = 0; j < (err == -3 ? i + 1 : i); j++)
+                timer_delete(cpu_timerprofs[j]);
+            n_cpu_timerprofs = 0;
+            profile_cputime = 0;
+            running = 0;
+            return err;
+        }
+    }
+    return 0;
+}
+
 JL_DLLEXPORT void jl_profile_stop_timer(void)
 {
     if (running) {
-        timer_delete(timerprof);
+        if (profile_cputime) {
+            for (int i = 0; i < n_cpu_timerprofs; i++)
+                timer_delete(cpu_timerprofs[i]);
+            n_cpu_timerprofs = 0;
+            profile_cputime = 0;
+        }
+        else {
+            timer_delete(timerprof);
+        }
         last_timer_delete_time = jl_hrtime();
         running = 0;
     }
@@ -721,7 +828,7 @@ void trigger_profile_peek(void)
             return;
         }
     }
-    bt_size_cur = 0; // clear profile buffer
+    jl_profile_clear_data(); // clear profile buffers
     if (jl_profile_start_timer() < 0)
         jl_safe_printf("ERROR: Could not start profile timer\n");
     else
@@ -734,6 +841,7 @@ static void *signal_listener(void *arg)
     static size_t bt_size = 0;
     sigset_t sset;
     int sig, critical, profile;
+    int profile_tid;
     jl_sigsetset(&sset);
 #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
     siginfo_t info;
@@ -788,13 +896,28 @@ static void *signal_listener(void *arg)
             sig = SIGABRT; // this branch can't occur, unless we had stack memory corruption of sset
         }
         profile = 0;
+        profile_tid = -1; // < 0 means sample every thread
 #ifndef HAVE_MACH
 #if defined(HAVE_TIMER)
         profile = (sig == SIGUSR1);
 #if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L
-        if (profile && !(info.si_code == SI_TIMER &&
-                info.si_value.sival_ptr == &timerprof))
+        if (profile && info.si_code == SI_TIMER) {
+            void *sival = info.si_value.sival_ptr;
+            if (sival == &timerprof) {
+                // wall-clock timer: sample all threads
+            }
+            else if (cpu_timerprofs != NULL && sival >= (void*)cpu_timerprofs &&
+                     sival < (void*)(cpu_timerprofs + n_cpu_timerprofs)) {
+                // per-thread CPU timer: sample only the thread that fired
+                profile_tid = (int)((timer_t*)sival - cpu_timerprofs);
+            }
+            else {
+                profile = 0;
+            }
+        }
+        else {
             profile = 0;
+        }
 #endif
 #endif
 #endif
@@ -877,6 +1000,9 @@ static void *signal_listener(void *arg)
             for (int idx = nthreads; idx-- > 0; ) {
                 // Stop the threads in the random or reverse round-robin order.
                 int i = profile ? randperm[idx] : idx;
+                // in CPU-time mode, only the thread whose timer fired is sampled
+                if (profile_tid >= 0 && i != profile_tid)
+                    continue;
                 // notify thread to stop
                 if (!jl_thread_suspend_and_get_state(i, 1, &signal_context))
                     continue;
@@ -892,43 +1018,40 @@ static void *signal_listener(void *arg)
 
                 // do backtrace for profiler
                 if (profile && running) {
-                    if (jl_profile_is_buffer_full()) {
-                        // Buffer full: Delete the timer
-                        jl_profile_stop_timer();
+                    size_t space = 0;
+                    jl_bt_element_t *dest = jl_profile_sample_begin(i, &space);
+                    if (dest == NULL) {
+                        // this thread's buffer is full (the overflow has been
+                        // counted); stop the timer once every buffer is
+                        if (jl_profile_is_buffer_full())
+                            jl_profile_stop_timer();
                     }
                     else {
-                        // unwinding can fail, so keep track of the current state
-                        // and restore from the SEGV handler if anything happens.
-                        jl_jmp_buf *old_buf = jl_get_safe_restore();
-                        jl_jmp_buf buf;
-
-                        jl_set_safe_restore(&buf);
-                        if (jl_setjmp(buf, 0)) {
-                            jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
-                        } else {
-                            // Get backtrace data
-                            bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur,
-                                    bt_size_max - bt_size_cur - 1, &signal_context, NULL);
-                        }
-                        jl_set_safe_restore(old_buf);
-
                         jl_ptls_t ptls2 = jl_atomic_load_relaxed(&jl_all_tls_states)[i];
 
-                        // store threadid but add 1 as 0 is preserved to indicate end of block
-                        bt_data_prof[bt_size_cur++].uintptr = ptls2->tid + 1;
-
-                        // store task id (never null)
-                        bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls2->current_task);
-
-                        // store cpu cycle clock
-                        bt_data_prof[bt_size_cur++].uintptr = cycleclock();
-
-                        // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                        bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls2->sleep_check_state) + 1;
+                        // try chasing the frame-pointer chain first; it fails
+                        // (returns 0) when the sample landed in foreign code
+                        // built without frame pointers, in which case fall
+                        // back to a full libunwind walk
+                        size_t nframes = rec_backtrace_ctx_fp(dest, space, &signal_context, ptls2);
+                        if (nframes == 0) {
+                            // unwinding can fail, so keep track of the current state
+                            // and restore from the SEGV handler if anything happens.
+                            jl_jmp_buf *old_buf = jl_get_safe_restore();
+                            jl_jmp_buf buf;
+
+                            jl_set_safe_restore(&buf);
+                            if (jl_setjmp(buf, 0)) {
+                                jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
+                            } else {
+                                // Get backtrace data
+                                nframes = rec_backtrace_ctx(dest, space, &signal_context, NULL);
+                            }
+                            jl_set_safe_restore(old_buf);
+                        }
 
-                        // Mark the end of this block with two 0's
-                        bt_data_prof[bt_size_cur++].uintptr = 0;
-                        bt_data_prof[bt_size_cur++].uintptr = 0;
+                        // append the metadata trailer and publish the sample
+                        jl_profile_sample_commit(i, nframes, ptls2);
                     }
                 }
 
@@ -941,7 +1064,10 @@ static void *signal_listener(void *arg)
         if (profile && running) {
             jl_check_profile_autostop();
 #if defined(HAVE_TIMER)
-            timer_settime(timerprof, 0, &itsprof, NULL);
+            if (profile_tid >= 0)
+                timer_settime(cpu_timerprofs[profile_tid], 0, &itsprof, NULL);
+            else
+                timer_settime(timerprof, 0, &itsprof, NULL);
 #endif
         }
 #endif
@@ -415,26 +415,16 @@ static DWORD WINAPI profile_bt( LPVOID lparam )
                     break;
                 }
                 // Get backtrace data
-                bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur,
-                        bt_size_max - bt_size_cur - 1, &ctxThread, NULL);
+                size_t space = 0;
+                jl_bt_element_t *dest = jl_profile_sample_begin(0, &space);
+                if (dest != NULL) {
+                    size_t nframes = rec_backtrace_ctx(dest, space, &ctxThread, NULL);
 
-                jl_ptls_t ptls = jl_atomic_load_relaxed(&jl_all_tls_states)[0]; // given only profiling hMainThread
+                    jl_ptls_t ptls = jl_atomic_load_relaxed(&jl_all_tls_states)[0]; // given only profiling hMainThread
 
-                // store threadid but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = ptls->tid + 1;
-
-                // store task id (never null)
-                bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
-
-                // store cpu cycle clock
-                bt_data_prof[bt_size_cur++].uintptr = cycleclock();
-
-                // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
-
-                // Mark the end of this block with two 0's
-                bt_data_prof[bt_size_cur++].uintptr = 0;
-                bt_data_prof[bt_size_cur++].uintptr = 0;
+                    // append the metadata trailer and publish the sample
+                    jl_profile_sample_commit(0, nframes, ptls);
+                }
                 jl_unlock_stackwalk(lockret);
                 jl_thread_resume(0);
                 jl_check_profile_autostop();
@@ -486,6 +476,12 @@ JL_DLLEXPORT int jl_profile_start_timer(void)
     running = 1; // set `running` finally
     return 0;
 }
+// CPU-time sampling is not implemented for the win32 sampler thread
+JL_DLLEXPORT int jl_profile_start_timer_cputime(void)
+{
+    return -2;
+}
+
 JL_DLLEXPORT void jl_profile_stop_timer(void)
 {
     if (running && timecaps.wPeriodMin)
@@ -13,6 +13,18 @@
 #define max_probe(size) ((size) <= 1024 ? 16 : (size) >> 6)
 #define h2index(hv, sz) (size_t)((hv) & ((sz)-1))
 
+// uint8 tables (the overwhelmingly common case) carry a control byte per slot
+// after the slot array, holding a 7-bit fragment of the key hash: 0 for an
+// empty slot, 0xFF for a tombstone, and 1..128 for an occupied one. Probing
+// compares a whole group of 16 control bytes at once, so a lookup touches a
+// single cache line per probe group and only calls `eq` on fragment matches.
+// Tables of other widths are rare and large; they keep the scalar probe.
+#define SMALLINTSET_GROUP 16
+// top bits; the index is taken from the bottom ones
+#define h2_fragment(hv) ((uint8_t)(((hv) >> (8 * sizeof(uint_t) - 7)) + 1))
+#define CTRL_EMPTY ((uint8_t)0)
+#define CTRL_TOMBSTONE ((uint8_t)0xFF)
+
 // a set of small positive integers representing the indices into another set
 // (or dict) where the hash is derived from the keys in the set via the lambdas
 // `hash` and `eq` supports concurrent calls to jl_smallintset_lookup (giving
@@ -86,6 +98,57 @@ static inline size_t jl_max_int(const jl_genericmemory_t *arr) JL_NOTSAFEPOINT
         abort();
 }
 
+static inline int smallintset_has_ctrl(const jl_genericmemory_t *arr) JL_NOTSAFEPOINT
+{
+    return (jl_value_t*)jl_typetagof(arr) == jl_memory_uint8_type;
+}
+
+// number of slots; for uint8 tables half of the memory is the control bytes
+static inline size_t smallintset_capacity(const jl_genericmemory_t *arr) JL_NOTSAFEPOINT
+{
+    return smallintset_has_ctrl(arr) ? arr->length / 2 : arr->length;
+}
+
+static inline _Atomic(uint8_t) *smallintset_ctrl(const jl_genericmemory_t *arr) JL_NOTSAFEPOINT
+{
+    assert(smallintset_has_ctrl(arr));
+    return &((_Atomic(uint8_t)*)arr->ptr)[arr->length / 2];
+}
+
+// Bit i of the result is set when ctrl byte i of the group equals `b`. The
+// group loads are deliberately plain (not atomic): a racing reader may see a
+// stale byte and miss a concurrent insertion, which callers already tolerate
+// by re-checking under their insertion lock, and every fragment match is
+// confirmed against the slot value with an acquire load before use.
+#if defined(_CPU_X86_64_) || (defined(_CPU_X86_) && defined(__SSE2__))
+#include <emmintrin.h>
+static inline uint32_t ctrl_match_mask(const uint8_t *group, uint8_t b) JL_NOTSAFEPOINT
+{
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)b)));
+}
+#elif defined(_CPU_AARCH64_)
+#include <arm_neon.h>
+static inline uint32_t ctrl_match_mask(const uint8_t *group, uint8_t b) JL_NOTSAFEPOINT
+{
+    // NEON has no movemask; shift-accumulate the lane sign bits instead
+    uint8x16_t cmp = vceqq_u8(vld1q_u8(group), vdupq_n_u8(b));
+    uint16x8_t high_bits = vreinterpretq_u16_u8(vshrq_n_u8(cmp, 7));
+    uint32x4_t paired16 = vreinterpretq_u32_u16(vsraq_n_u16(high_bits, high_bits, 7));
+    uint64x2_t paired32 = vreinterpretq_u64_u32(vsraq_n_u32(paired16, paired16, 14));
+    uint8x16_t paired64 = vreinterpretq_u8_u64(vsraq_n_u64(paired32, paired32, 28));
+    return vgetq_lane_u8(paired64, 0) | ((uint32_t)vgetq_lane_u8(paired64, 8) << 8);
+}
+#else
+static inline uint32_t ctrl_match_mask(const uint8_t *group, uint8_t b) JL_NOTSAFEPOINT
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < SMALLINTSET_GROUP; i++)
+        mask |= (uint32_t)(group[i] == b) << i;
+    return mask;
+}
+#endif
+
 void smallintset_empty(const jl_genericmemory_t *a) JL_NOTSAFEPOINT
 {
     size_t elsize;
@@ -106,8 +169,10 @@ void smallintset_empty(const jl_genericmemory_t *a) JL_NOTSAFEPOINT
 static jl_genericmemory_t *jl_alloc_int_1d(size_t np, size_t len)
 {
     jl_value_t *ty;
-    if (np < 0xFF)
+    if (np < 0xFF) {
         ty = jl_memory_uint8_type;
+        len *= 2; // the control bytes follow the slots (see smallintset_ctrl)
+    }
     else if (np < 0xFFFF)
         ty = jl_memory_uint16_type;
     else
@@ -120,10 +185,46 @@ static jl_genericmemory_t *jl_alloc_int_1d(size_t np, size_t len)
 
 ssize_t jl_smallintset_lookup(jl_genericmemory_t *cache, smallintset_eq eq, const void *key, jl_value_t *data, uint_t hv, int pop)
 {
-    size_t sz = cache->length;
+    size_t sz = smallintset_capacity(cache);
     if (sz == 0)
         return -1;
     JL_GC_PUSH1(&cache);
+    if (smallintset_has_ctrl(cache) && sz >= SMALLINTSET_GROUP) {
+        // group probing: scan 16 control bytes at a time, starting from the
+        // group containing the home slot, in the same order the insert uses
+        const uint8_t *ctrl = (const uint8_t*)smallintset_ctrl(cache);
+        uint8_t h2 = h2_fragment(hv);
+        size_t maxprobe = max_probe(sz) / SMALLINTSET_GROUP + 1;
+        size_t g = h2index(hv, sz) & ~(size_t)(SMALLINTSET_GROUP - 1);
+        size_t orig = g;
+        size_t iter = 0;
+        do {
+            uint32_t match = ctrl_match_mask(&ctrl[g], h2);
+            while (match) {
+                size_t index = g + __builtin_ctz(match);
+                match &= match - 1;
+                size_t val1 = jl_intref_acquire(cache, index);
+                // val1 can be 0 or stale if the slot is being written
+                // concurrently; treat that as a miss for this probe
+                if (val1 != 0 && val1 != -1 && eq(val1 - 1, key, data, hv)) {
+                    JL_GC_POP();
+                    if (pop) {
+                        jl_intset_release(cache, index, (size_t)-1); // replace with tombstone
+                        jl_atomic_store_release(&smallintset_ctrl(cache)[index], CTRL_TOMBSTONE);
+                    }
+                    return val1 - 1;
+                }
+            }
+            if (ctrl_match_mask(&ctrl[g], CTRL_EMPTY)) {
+                JL_GC_POP();
+                return -1;
+            }
+            g = (g + SMALLINTSET_GROUP) & (sz - 1);
+            iter++;
+        } while (iter <= maxprobe && g != orig);
+        JL_GC_POP();
+        return -1;
+    }
     size_t maxprobe = max_probe(sz);
     size_t index = h2index(hv, sz);
     size_t orig = index;
@@ -136,8 +237,11 @@ ssize_t jl_smallintset_lookup(jl_genericmemory_t *cache, smallintset_eq eq, cons
         }
         if (val1 != -1 && eq(val1 - 1, key, data, hv)) {
             JL_GC_POP();
-            if (pop)
+            if (pop) {
                 jl_intset_release(cache, index, (size_t)-1); // replace with tombstone
+                if (smallintset_has_ctrl(cache))
+                    jl_atomic_store_release(&smallintset_ctrl(cache)[index], CTRL_TOMBSTONE);
+            }
             return val1 - 1;
         }
         index = (index + 1) & (sz - 1);
@@ -149,9 +253,33 @@ ssize_t jl_smallintset_lookup(jl_genericmemory_t *cache, smallintset_eq eq, cons
 
 static int smallintset_insert_(jl_genericmemory_t *a, uint_t hv, size_t val1) JL_NOTSAFEPOINT
 {
-    size_t sz = a->length;
+    size_t sz = smallintset_capacity(a);
     if (sz <= 1)
         return 0;
+    int has_ctrl = smallintset_has_ctrl(a);
+    if (has_ctrl && sz >= SMALLINTSET_GROUP) {
+        // must claim the first empty slot in the group order the lookup scans,
+        // so that a lookup can stop at the first group with an empty byte
+        const uint8_t *ctrl = (const uint8_t*)smallintset_ctrl(a);
+        size_t maxprobe = max_probe(sz) / SMALLINTSET_GROUP + 1;
+        size_t g = h2index(hv, sz) & ~(size_t)(SMALLINTSET_GROUP - 1);
+        size_t orig = g;
+        size_t iter = 0;
+        do {
+            uint32_t empty = ctrl_match_mask(&ctrl[g], CTRL_EMPTY);
+            if (empty) {
+                size_t index = g + __builtin_ctz(empty);
+                // publish the slot before its control byte, so a fragment
+                // match never observes an unwritten slot as occupied
+                jl_intset_release(a, index, val1);
+                jl_atomic_store_release(&smallintset_ctrl(a)[index], h2_fragment(hv));
+                return 1;
+            }
+            g = (g + SMALLINTSET_GROUP) & (sz - 1);
+            iter++;
+        } while (iter <= maxprobe && g != orig);
+        return 0;
+    }
     size_t orig, index, iter;
     iter = 0;
     index = h2index(hv, sz);
@@ -160,6 +288,8 @@ static int smallintset_insert_(jl_genericmemory_t *a, uint_t hv, size_t val1) JL
     do {
         if (jl_intref(a, index) == 0) {
             jl_intset_release(a, index, val1);
+            if (has_ctrl)
+                jl_atomic_store_release(&smallintset_ctrl(a)[index], h2_fragment(hv));
             return 1;
         }
         index = (index + 1) & (sz - 1);
@@ -173,7 +303,7 @@ void jl_smallintset_insert(_Atomic(jl_genericmemory_t*) *pcache, jl_value_t *par
 {
     jl_genericmemory_t *a = jl_atomic_load_relaxed(pcache);
     if (val + 1 >= jl_max_int(a)) {
-        a = smallintset_rehash(a, hash, data, a->length, val + 1);
+        a = smallintset_rehash(a, hash, data, smallintset_capacity(a), val + 1);
         jl_atomic_store_release(pcache, a);
         if (parent) jl_gc_wb(parent, a);
     }
@@ -187,7 +317,7 @@ void jl_smallintset_insert(_Atomic(jl_genericmemory_t*) *pcache, jl_value_t *par
         /* lots of time rehashing all the keys over and over. */
         size_t newsz;
         a = jl_atomic_load_relaxed(pcache);
-        size_t sz = a->length;
+        size_t sz = smallintset_capacity(a);
         if (sz < HT_N_INLINE)
             newsz = HT_N_INLINE;
         else if (sz >= (1 << 19) || (sz <= (1 << 8)))
@@ -202,7 +332,7 @@ void jl_smallintset_insert(_Atomic(jl_genericmemory_t*) *pcache, jl_value_t *par
 
 jl_genericmemory_t* smallintset_rehash(jl_genericmemory_t* a, smallintset_hash hash, jl_value_t *data, size_t newsz, size_t np)
 {
-    size_t sz = a->length;
+    size_t sz = smallintset_capacity(a);
     size_t i;
     for (i = 0; i < sz; i += 1) {
         size_t val = jl_intref(a, i);
@@ -202,6 +202,80 @@ NOINLINE size_t rec_backtrace_ctx(jl_bt_element_t *bt_data, size_t maxsize,
     return bt_size;
 }
 
+// Fast backtrace for profiler samples: jitted frames (and most of the
+// runtime) are compiled with frame pointers, so the frame-pointer chain can
+// be chased directly, which is far cheaper than a full DWARF unwind. Every
+// dereference is validated against the sampled thread's stack bounds, and
+// any break in the chain -- typically a foreign frame built without frame
+// pointers -- abandons the sample so that the caller redoes it with
+// libunwind. The caller must have suspended the thread described by `ptls2`,
+// with `context` holding its stopped register state.
+#if defined(_OS_LINUX_) && (defined(_CPU_X86_64_) || defined(_CPU_AARCH64_)) && !defined(JL_DISABLE_LIBUNWIND)
+#include <ucontext.h>
+NOINLINE size_t rec_backtrace_ctx_fp(jl_bt_element_t *bt_data, size_t maxsize,
+                                     bt_context_t *context, jl_ptls_t ptls2) JL_NOTSAFEPOINT
+{
+    const ucontext_t *ctx = (const ucontext_t*)context;
+#if defined(_CPU_X86_64_)
+    uintptr_t ip = ctx->uc_mcontext.gregs[REG_RIP];
+    uintptr_t sp = ctx->uc_mcontext.gregs[REG_RSP];
+    uintptr_t fp = ctx->uc_mcontext.gregs[REG_RBP];
+#else
+    uintptr_t ip = ctx->uc_mcontext.pc;
+    uintptr_t sp = ctx->uc_mcontext.sp;
+    uintptr_t fp = ctx->uc_mcontext.regs[29];
+#endif
+    jl_task_t *t = jl_atomic_load_relaxed(&ptls2->current_task);
+    if (t == NULL)
+        return 0;
+    uintptr_t stack_lo, stack_hi;
+    if (t->copy_stack) {
+        stack_hi = (uintptr_t)ptls2->stackbase;
+        stack_lo = stack_hi - ptls2->stacksize;
+    }
+    else {
+        stack_lo = (uintptr_t)t->stkbuf;
+        stack_hi = stack_lo + t->bufsz;
+    }
+    if (sp < stack_lo || sp >= stack_hi)
+        return 0; // running on some other (signal? foreign?) stack
+    // an implausibly high address is not code we can look up (on aarch64 it
+    // may be a pointer-authentication-signed return address)
+    if (ip == 0 || ip == JL_BT_NON_PTR_ENTRY || (ip >> 56) != 0)
+        return 0;
+    size_t n = 0;
+    // asynchronously interrupted, so `ip` is itself the sampled instruction
+    bt_data[n++].uintptr = ip;
+    while (n < maxsize) {
+        if (fp < sp || fp + 2 * sizeof(void*) > stack_hi ||
+                (fp & (sizeof(void*) - 1)))
+            return 0; // chain broke: frame built without a frame pointer
+        uintptr_t return_ip = ((uintptr_t*)fp)[1];
+        uintptr_t next_fp = ((uintptr_t*)fp)[0];
+        if (return_ip == 0)
+            break; // bottom of the call chain
+        uintptr_t call_ip = return_ip - 1;
+        if (call_ip == JL_BT_NON_PTR_ENTRY || (call_ip >> 56) != 0)
+            return 0;
+        bt_data[n++].uintptr = call_ip;
+        if (next_fp == 0)
+            break; // bottom of the call chain
+        if (next_fp <= fp)
+            return 0; // the frame pointer must strictly increase
+        sp = fp + 2 * sizeof(void*);
+        fp = next_fp;
+    }
+    return n;
+}
+#else
+size_t rec_backtrace_ctx_fp(jl_bt_element_t *bt_data, size_t maxsize,
+                            bt_context_t *context, jl_ptls_t ptls2) JL_NOTSAFEPOINT
+{
+    (void)bt_data; (void)maxsize; (void)context; (void)ptls2;
+    return 0;
+}
+#endif
+
 // Record backtrace into buffer `bt_data`, using a maximum of `maxsize`
 // elements, and returning the number of elements written.
 //
@@ -581,13 +655,55 @@ static int jl_unw_step(bt_cursor_t *cursor, int from_signal_handler, uintptr_t *
 }
 #endif
 
+// Bumped by debuginfo.cpp whenever newly registered code could change what
+// an address resolves to; stale cache entries are then refilled on first use.
+_Atomic(uint64_t) jl_debuginfo_generation = 1;
+
+static void ip_lookup_entry_clear(jl_ip_lookup_entry_t *entry) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < entry->nframes; i++) {
+        free(entry->frames[i].func_name);
+        free(entry->frames[i].file_name);
+    }
+    free(entry->frames);
+    entry->frames = NULL;
+    entry->nframes = 0;
+    entry->ip = 0;
+}
+
+// Resolve `ip` through the per-thread direct-mapped cache in front of the
+// debug info search. Code that unwinds the same frames over and over (e.g.
+// exceptions used for control flow) would otherwise re-search the object
+// maps in jl_getFunctionInfo for every materialized stacktrace. The entry
+// owns the returned frames; callers must not free them.
+static int ip_lookup(jl_ptls_t ptls, uintptr_t ip, int skipC, jl_frame_t **frames)
+{
+    uint64_t gen = jl_atomic_load_acquire(&jl_debuginfo_generation);
+    jl_ip_lookup_entry_t *entry =
+        &ptls->ip_lookup_cache[(ip >> 2) & (JL_IP_LOOKUP_CACHE_SLOTS - 1)];
+    if (entry->ip == ip && entry->skipC == skipC && entry->gen == gen) {
+        *frames = entry->frames;
+        return entry->nframes;
+    }
+    jl_frame_t *fresh = NULL;
+    int8_t gc_state = jl_gc_safe_enter(ptls);
+    int n = jl_getFunctionInfo(&fresh, ip, skipC, 0);
+    jl_gc_safe_leave(ptls, gc_state);
+    ip_lookup_entry_clear(entry);
+    entry->ip = ip;
+    entry->gen = gen;
+    entry->skipC = skipC;
+    entry->nframes = n;
+    entry->frames = fresh;
+    *frames = fresh;
+    return n;
+}
+
 JL_DLLEXPORT jl_value_t *jl_lookup_code_address(void *ip, int skipC)
 {
     jl_task_t *ct = jl_current_task;
     jl_frame_t *frames = NULL;
-    int8_t gc_state = jl_gc_safe_enter(ct->ptls);
-    int n = jl_getFunctionInfo(&frames, (uintptr_t)ip, skipC, 0);
-    jl_gc_safe_leave(ct->ptls, gc_state);
+    int n = ip_lookup(ct->ptls, (uintptr_t)ip, skipC, &frames);
     jl_value_t *rs = (jl_value_t*)jl_alloc_svec(n);
     JL_GC_PUSH1(&rs);
     for (int i = 0; i < n; i++) {
@@ -598,18 +714,15 @@ JL_DLLEXPORT jl_value_t *jl_lookup_code_address(void *ip, int skipC)
             jl_svecset(r, 0, jl_symbol(frame.func_name));
         else
             jl_svecset(r, 0, jl_empty_sym);
-        free(frame.func_name);
         if (frame.file_name)
             jl_svecset(r, 1, jl_symbol(frame.file_name));
         else
             jl_svecset(r, 1, jl_empty_sym);
-        free(frame.file_name);
         jl_svecset(r, 2, jl_box_long(frame.line));
         jl_svecset(r, 3, frame.linfo != NULL ? (jl_value_t*)frame.linfo : jl_nothing);
         jl_svecset(r, 4, jl_box_bool(frame.fromC));
         jl_svecset(r, 5, jl_box_bool(frame.inlined));
     }
-    free(frames);
     JL_GC_POP();
     return rs;
 }
@@ -917,7 +1030,98 @@ static void jl_rec_backtrace(jl_task_t *t) JL_NOTSAFEPOINT
         context = jl_to_bt_context(&t->ctx.ctx);
 #elif defined(JL_HAVE_ASM)
         memset(&c, 0, sizeof(c));
-     #if defined(_OS_LINUX_) && defined(__GLIBC__)
+     #if defined(JL_HAVE_FAST_FIBER_SWAP)
+        // the context was stored by jl_fastctx_save in its fixed private
+        // layout: no libc jmp_buf decoding or pointer demangling involved
+        jl_fastctx_t *fctx = (jl_fastctx_t*)&t->ctx.ctx.uc_mcontext;
+      #if defined(_OS_DARWIN_)
+       #if defined(_CPU_X86_64_)
+        x86_thread_state64_t *mc = (x86_thread_state64_t*)&c;
+        mc->__rbx = fctx->rbx;
+        mc->__rbp = fctx->rbp;
+        mc->__r12 = fctx->r12;
+        mc->__r13 = fctx->r13;
+        mc->__r14 = fctx->r14;
+        mc->__r15 = fctx->r15;
+        mc->__rsp = fctx->rsp;
+        mc->__rip = fctx->rip;
+        context = &c;
+       #else // _CPU_AARCH64_
+        arm_thread_state64_t *mc = (arm_thread_state64_t*)&c;
+        mc->__x[19] = fctx->x19;
+        mc->__x[20] = fctx->x20;
+        mc->__x[21] = fctx->x21;
+        mc->__x[22] = fctx->x22;
+        mc->__x[23] = fctx->x23;
+        mc->__x[24] = fctx->x24;
+        mc->__x[25] = fctx->x25;
+        mc->__x[26] = fctx->x26;
+        mc->__x[27] = fctx->x27;
+        mc->__x[28] = fctx->x28;
+        double *mcfp = (double*)&mc[1];
+        memcpy(&mcfp[7], &fctx->d8, 8 * sizeof(uintptr_t)); // d8-d15
+        mc->__fp = fctx->fp;
+        mc->__lr = fctx->pc;
+        mc->__sp = fctx->sp;
+        mc->__pc = fctx->pc;
+        mc->__pad = 0; // aka __ra_sign_state = not signed
+        context = &c;
+       #endif
+      #elif defined(_OS_FREEBSD_) && defined(_CPU_X86_64_)
+        mcontext_t *mc = &c.uc_mcontext;
+        mc->mc_rbx = fctx->rbx;
+        mc->mc_rbp = fctx->rbp;
+        mc->mc_r12 = fctx->r12;
+        mc->mc_r13 = fctx->r13;
+        mc->mc_r14 = fctx->r14;
+        mc->mc_r15 = fctx->r15;
+        mc->mc_rsp = fctx->rsp;
+        mc->mc_rip = fctx->rip;
+        context = &c;
+      #elif defined(_OS_LINUX_) && defined(__GLIBC__)
+        mcontext_t *mc = &c.uc_mcontext;
+       #if defined(_CPU_X86_64_)
+        mc->gregs[REG_RBX] = fctx->rbx;
+        mc->gregs[REG_RBP] = fctx->rbp;
+        mc->gregs[REG_R12] = fctx->r12;
+        mc->gregs[REG_R13] = fctx->r13;
+        mc->gregs[REG_R14] = fctx->r14;
+        mc->gregs[REG_R15] = fctx->r15;
+        mc->gregs[REG_RSP] = fctx->rsp;
+        mc->gregs[REG_RIP] = fctx->rip;
+        context = &c;
+       #else // _CPU_AARCH64_
+        unw_fpsimd_context_t *mcfp = (unw_fpsimd_context_t*)&mc->__reserved;
+        mc->regs[19] = fctx->x19;
+        mc->regs[20] = fctx->x20;
+        mc->regs[21] = fctx->x21;
+        mc->regs[22] = fctx->x22;
+        mc->regs[23] = fctx->x23;
+        mc->regs[24] = fctx->x24;
+        mc->regs[25] = fctx->x25;
+        mc->regs[26] = fctx->x26;
+        mc->regs[27] = fctx->x27;
+        mc->regs[28] = fctx->x28;
+        mc->regs[29] = fctx->fp;
+        mc->regs[30] = fctx->pc;
+        mc->sp = fctx->sp;
+        mcfp->vregs[7] = fctx->d8;
+        mcfp->vregs[8] = fctx->d9;
+        mcfp->vregs[9] = fctx->d10;
+        mcfp->vregs[10] = fctx->d11;
+        mcfp->vregs[11] = fctx->d12;
+        mcfp->vregs[12] = fctx->d13;
+        mcfp->vregs[13] = fctx->d14;
+        mcfp->vregs[14] = fctx->d15;
+        mc->pc = fctx->pc;
+        context = &c;
+       #endif
+      #else
+       #pragma message("jl_rec_backtrace not defined for FAST_FIBER_SWAP on unknown system")
+       (void)fctx;
+       (void)c;
+      #endif
+     #elif defined(_OS_LINUX_) && defined(__GLIBC__)
         __jmp_buf *mctx = &t->ctx.ctx.uc_mcontext->__jmpbuf;
         mcontext_t *mc = &c.uc_mcontext;
       #if defined(_CPU_X86_)
@@ -88,6 +88,16 @@ External links:
 #include "valgrind.h"
 #include "julia_assert.h"
 
+#ifndef _OS_WINDOWS_
+#include <sys/mman.h> // mmap: try to place package images at JL_PRELINK_BASE
+#if defined(_OS_DARWIN_) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+#ifdef _OS_LINUX_
+#include <link.h> // dl_iterate_phdr: locate the sysimage text segment
+#endif
+
 static const size_t WORLD_AGE_REVALIDATION_SENTINEL = 0x1;
 
 #include "staticdata_utils.c"
@@ -317,6 +327,7 @@ static htable_t external_objects;
 
 static htable_t serialization_order; // to break cycles, mark all objects that are serialized
 static htable_t nullptrs;
+static htable_t string_dedup;        // content hash => canonical string in `serialization_order`
 // FIFO queue for objects to be serialized. Anything requiring fixup upon deserialization
 // must be "toplevel" in this queue. For types, parameters and field types must appear
 // before the "wrapper" type so they can be properly recached against the running system.
@@ -502,6 +513,14 @@ typedef struct {
     jl_array_t *link_ids_gctags;
     jl_array_t *link_ids_gvars;
     jl_array_t *link_ids_external_fnvars;
+    // Set only while this state belongs to a helper thread of a parallel
+    // `jl_write_values`: symbols are interned into a worker-local table (and
+    // renumbered during the merge) and `fptr_record` entries are deferred,
+    // since the structures they would otherwise touch are shared. All three
+    // are NULL during normal (single-threaded) operation.
+    htable_t *worker_symbols;       // sym => provisional worker-local SymbolRef
+    arraylist_t *worker_sym_order;  // worker-local symbols, in first-reference order
+    arraylist_t *worker_fptrs;      // deferred (invokeptr_id, specfptr_id, reloc_offset) triples
     jl_ptls_t ptls;
     // Set (implemented has a hasmap of MethodInstances to themselves) of which MethodInstances have (forward) edges
     // to other MethodInstances.
@@ -523,6 +542,18 @@ static jl_sym_t *jl_docmeta_sym = NULL;
 #define DEPS_IDX_OFFSET RELOC_TAG_OFFSET
 #endif
 
+// Preferred load address for the image data. Relocations whose value depends only on
+// the image's own base address are resolved against this address at save time
+// ("prelinked", in the manner of ELF prelinking). When the image is actually mapped
+// here they already hold their final values; at any other address a single constant
+// slide is added per entry (see `jl_read_prelinklist`), which is much cheaper than
+// the tag-decoding done for the remaining relocations.
+#ifdef _P64
+#define JL_PRELINK_BASE ((uintptr_t)0x600000000000)
+#else
+#define JL_PRELINK_BASE ((uintptr_t)0x60000000)
+#endif
+
 
 // Tags of category `t` are located at offsets `t << RELOC_TAG_OFFSET`
 // Consequently there is room for 2^RELOC_TAG_OFFSET pointers, etc
@@ -582,6 +613,8 @@ typedef struct {
 // --- Static Compile ---
 static void *jl_sysimg_handle = NULL;
 static jl_image_t sysimage;
+static void jl_restore_system_image_data_(const char *buf, size_t len, const uint32_t *checksum);
+static void jl_sysimg_text_hugepages(const void *inside);
 
 static inline uintptr_t *sysimg_gvars(uintptr_t *base, const int32_t *offsets, size_t idx)
 {
@@ -602,6 +635,7 @@ static void jl_load_sysimg_so(void)
     // in --build mode only use sysimg data, not precompiled native code
     if (!imaging_mode && jl_options.use_sysimage_native_code==JL_OPTIONS_USE_SYSIMAGE_NATIVE_CODE_YES) {
         assert(sysimage.fptrs.base);
+        jl_sysimg_text_hugepages(sysimage.fptrs.base);
     }
     else {
         memset(&sysimage.fptrs, 0, sizeof(sysimage.fptrs));
@@ -618,7 +652,11 @@ static void jl_load_sysimg_so(void)
         plen = (size_t *)&jl_system_image_size;
     else
         jl_dlsym(jl_sysimg_handle, "jl_system_image_size", (void **)&plen, 1);
-    jl_restore_system_image_data(sysimg_data, *plen);
+    // older images do not carry a precomputed checksum; fall back to scanning
+    uint32_t *pchecksum = NULL;
+    if (jl_sysimg_handle != jl_exe_handle)
+        jl_dlsym(jl_sysimg_handle, "jl_system_image_checksum", (void **)&pchecksum, 0);
+    jl_restore_system_image_data_(sysimg_data, *plen, pchecksum);
 }
 
 
@@ -898,6 +936,33 @@ done_fields: ;
     // We've encountered an item we need to cache
     void **bp = ptrhash_bp(&serialization_order, v);
     assert(*bp == (void*)(uintptr_t)-2);
+
+    if (jl_is_string(v)) {
+        // Strings are compared (`===`) and hashed by content, so byte-identical
+        // strings can share a single entry in the image without observable effect;
+        // compressed method IR in particular repeats heavily across specializations.
+        // One canonical string is recorded per content hash; a hash collision with
+        // different content merely forgoes sharing for the newcomer.
+        uintptr_t hash = (uintptr_t)memhash(jl_string_data(v), jl_string_len(v));
+        if (hash <= 2)
+            hash = 3; // avoid the reserved empty-slot keys
+        void **canonp = ptrhash_bp(&string_dedup, (void*)hash);
+        if (*canonp == HT_NOTFOUND) {
+            *canonp = (void*)v;
+        }
+        else {
+            jl_value_t *canon = (jl_value_t*)*canonp;
+            if (jl_string_len(canon) == jl_string_len(v) &&
+                    !memcmp(jl_string_data(canon), jl_string_data(v), jl_string_len(v))) {
+                // alias this object to the canonical entry instead of queueing it
+                void *idx = ptrhash_get(&serialization_order, canon);
+                assert(idx != HT_NOTFOUND && "canonical string not yet assigned an id");
+                *bp = idx;
+                return;
+            }
+        }
+    }
+
     arraylist_push(&serialization_queue, (void*) v);
     size_t idx = serialization_queue.len - 1;
     assert(serialization_queue.len < ((uintptr_t)1 << RELOC_TAG_OFFSET) && "too many items to serialize");
@@ -1049,16 +1114,31 @@ static uintptr_t _backref_id(jl_serializer_state *s, jl_value_t *v, jl_array_t *
     assert(v != NULL && "cannot get backref to NULL object");
     void *idx = HT_NOTFOUND;
     if (jl_is_symbol(v)) {
-        void **pidx = ptrhash_bp(&symbol_table, v);
-        idx = *pidx;
-        if (idx == HT_NOTFOUND) {
-            size_t l = strlen(jl_symbol_name((jl_sym_t*)v));
-            write_uint32(s->symbols, l);
-            ios_write(s->symbols, jl_symbol_name((jl_sym_t*)v), l + 1);
-            size_t offset = ++nsym_tag;
-            assert(offset < ((uintptr_t)1 << RELOC_TAG_OFFSET) && "too many symbols");
-            idx = (void*)((char*)HT_NOTFOUND + ((uintptr_t)SymbolRef << RELOC_TAG_OFFSET) + offset);
-            *pidx = idx;
+        if (s->worker_symbols) {
+            // parallel write: `symbol_table` and the `s->symbols` stream are shared,
+            // so assign a worker-local id here and let the merge renumber it
+            void **pidx = ptrhash_bp(s->worker_symbols, v);
+            idx = *pidx;
+            if (idx == HT_NOTFOUND) {
+                arraylist_push(s->worker_sym_order, v);
+                size_t offset = s->worker_sym_order->len; // 1-based, like nsym_tag
+                assert(offset < ((uintptr_t)1 << RELOC_TAG_OFFSET) && "too many symbols");
+                idx = (void*)((char*)HT_NOTFOUND + ((uintptr_t)SymbolRef << RELOC_TAG_OFFSET) + offset);
+                *pidx = idx;
+            }
+        }
+        else {
+            void **pidx = ptrhash_bp(&symbol_table, v);
+            idx = *pidx;
+            if (idx == HT_NOTFOUND) {
+                size_t l = strlen(jl_symbol_name((jl_sym_t*)v));
+                write_uint32(s->symbols, l);
+                ios_write(s->symbols, jl_symbol_name((jl_sym_t*)v), l + 1);
+                size_t offset = ++nsym_tag;
+                assert(offset < ((uintptr_t)1 << RELOC_TAG_OFFSET) && "too many symbols");
+                idx = (void*)((char*)HT_NOTFOUND + ((uintptr_t)SymbolRef << RELOC_TAG_OFFSET) + offset);
+                *pidx = idx;
+            }
         }
     }
     else if (v == (jl_value_t*)s->ptls->root_task) {
@@ -1159,6 +1239,13 @@ static void jl_write_module(jl_serializer_state *s, uintptr_t item, jl_module_t
     jl_atomic_store_relaxed(&newm->bindingkeyset, NULL);
     arraylist_push(&s->relocs_list, (void*)(reloc_offset + offsetof(jl_module_t, bindingkeyset)));
     arraylist_push(&s->relocs_list, (void*)backref_id(s, jl_atomic_load_relaxed(&m->bindingkeyset), s->link_ids_relocs));
+    // drop the merged export index and the negative resolution cache: they
+    // are lazily rebuilt caches and their generation stamps are only
+    // meaningful within the process that built them
+    jl_atomic_store_relaxed(&newm->usingindex, NULL);
+    jl_atomic_store_relaxed(&newm->usingnegcache, NULL);
+    jl_atomic_store_relaxed(&newm->usingnegkeyset, NULL);
+    jl_atomic_store_relaxed(&newm->usingneggen, 0);
     newm->primary_world = ~(size_t)0;
 
     // write out the usings list
@@ -1190,6 +1277,39 @@ static void jl_write_module(jl_serializer_state *s, uintptr_t item, jl_module_t
     assert(ios_pos(s->s) - reloc_offset == tot);
 }
 
+// Record the stream position of a compiled CodeInstance in `fptr_record`, keyed by the
+// function ids assigned during native code generation. The record is written at absolute
+// (id-keyed) offsets, so parallel writers defer these entries to the merge, which also
+// knows the final `reloc_offset`.
+static void write_fptr_record(jl_serializer_state *s, int32_t invokeptr_id, int32_t specfptr_id, uintptr_t reloc_offset)
+{
+    if (s->worker_fptrs) {
+        arraylist_push(s->worker_fptrs, (void*)(uintptr_t)(uint32_t)invokeptr_id);
+        arraylist_push(s->worker_fptrs, (void*)(uintptr_t)(uint32_t)specfptr_id);
+        arraylist_push(s->worker_fptrs, (void*)reloc_offset);
+        return;
+    }
+    if (invokeptr_id > 0) {
+        ios_ensureroom(s->fptr_record, invokeptr_id * sizeof(void*));
+        ios_seek(s->fptr_record, (invokeptr_id - 1) * sizeof(void*));
+        write_reloc_t(s->fptr_record, (reloc_t)~reloc_offset);
+#ifdef _P64
+        if (sizeof(reloc_t) < 8)
+            write_padding(s->fptr_record, 8 - sizeof(reloc_t));
+#endif
+    }
+    if (specfptr_id) {
+        assert(specfptr_id > invokeptr_id && specfptr_id > 0);
+        ios_ensureroom(s->fptr_record, specfptr_id * sizeof(void*));
+        ios_seek(s->fptr_record, (specfptr_id - 1) * sizeof(void*));
+        write_reloc_t(s->fptr_record, reloc_offset);
+#ifdef _P64
+        if (sizeof(reloc_t) < 8)
+            write_padding(s->fptr_record, 8 - sizeof(reloc_t));
+#endif
+    }
+}
+
 static void record_memoryref(jl_serializer_state *s, size_t reloc_offset, jl_genericmemoryref_t ref) {
     ios_t *f = s->s;
     // make some header modifications in-place
@@ -1245,19 +1365,14 @@ static void record_external_fns(jl_serializer_state *s, arraylist_t *external_fn
 }
 
 jl_value_t *jl_find_ptr = NULL;
-// The main function for serializing all the items queued in `serialization_order`
-// (They are also stored in `serialization_queue` which is order-preserving, unlike the hash table used
-//  for `serialization_order`).
-static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
+// Serialize the contiguous range [start, end) of `serialization_queue` into the streams
+// of `s`. This is the body of `jl_write_values`; when writing in parallel each helper
+// thread runs it over its own range with worker-owned streams and lists (see
+// `jl_merge_segment` for how the segments are spliced back together).
+static void jl_write_values_range(jl_serializer_state *s, size_t start, size_t end) JL_GC_DISABLED
 {
-    size_t l = serialization_queue.len;
-
-    arraylist_new(&layout_table, 0);
-    arraylist_grow(&layout_table, l * 2);
-    memset(layout_table.items, 0, l * 2 * sizeof(void*));
-
     // Serialize all entries
-    for (size_t item = 0; item < l; item++) {
+    for (size_t item = start; item < end; item++) {
         jl_value_t *v = (jl_value_t*)serialization_queue.items[item];           // the object
         JL_GC_PROMISE_ROOTED(v);
         assert(!(s->incremental && jl_object_in_image(v)));
@@ -1648,24 +1763,8 @@ static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
                                 }
                                 else {
                                     assert(invokeptr_id > 0);
-                                    ios_ensureroom(s->fptr_record, invokeptr_id * sizeof(void*));
-                                    ios_seek(s->fptr_record, (invokeptr_id - 1) * sizeof(void*));
-                                    write_reloc_t(s->fptr_record, (reloc_t)~reloc_offset);
-#ifdef _P64
-                                    if (sizeof(reloc_t) < 8)
-                                        write_padding(s->fptr_record, 8 - sizeof(reloc_t));
-#endif
-                                }
-                                if (specfptr_id) {
-                                    assert(specfptr_id > invokeptr_id && specfptr_id > 0);
-                                    ios_ensureroom(s->fptr_record, specfptr_id * sizeof(void*));
-                                    ios_seek(s->fptr_record, (specfptr_id - 1) * sizeof(void*));
-                                    write_reloc_t(s->fptr_record, reloc_offset);
-#ifdef _P64
-                                    if (sizeof(reloc_t) < 8)
-                                        write_padding(s->fptr_record, 8 - sizeof(reloc_t));
-#endif
                                 }
+                                write_fptr_record(s, invokeptr_id, specfptr_id, reloc_offset);
                             }
                         }
                     }
@@ -1741,6 +1840,8 @@ static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
                     arraylist_push(&s->relocs_list, (void*)(((uintptr_t)ConstDataRef << RELOC_TAG_OFFSET) + layout)); // relocation target
                     ios_write(s->const_data, (char*)tn->constfields, nb);
                 }
+                // the field-name lookup table is rebuilt lazily at runtime
+                jl_atomic_store_relaxed(&newtn->fieldindex_cache, NULL);
             }
             else if (jl_is_globalref(v)) {
                 assert(f == s->s);
@@ -1759,6 +1860,217 @@ static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
             }
         }
     }
+}
+
+// number of queued objects below which `jl_write_values` stays on one thread;
+// the merge has a per-segment cost, so small images do not repay the split
+#define IMAGE_WRITE_PARALLEL_THRESHOLD 262144
+// upper bound on writer threads (including the current thread)
+#define IMAGE_WRITE_MAX_THREADS 8
+
+// One writer thread's share of a parallel `jl_write_values`: a clone of the main
+// serializer state whose streams and position lists are worker-owned, plus the
+// worker-local symbol table and deferred fptr entries (see `jl_serializer_state`).
+typedef struct {
+    jl_serializer_state s;
+    ios_t sysimg;
+    ios_t const_data;
+    htable_t symbol_table;
+    arraylist_t sym_order;
+    arraylist_t fptrs;
+    size_t start;
+    size_t end;
+} jl_write_segment_t;
+
+static void jl_write_values_threadfun(void *arg)
+{
+    jl_write_segment_t *seg = (jl_write_segment_t*)arg;
+    jl_write_values_range(&seg->s, seg->start, seg->end);
+}
+
+// Rebase a list of (position, target) pairs from a parallel segment onto the merged
+// streams and append it to `dest`. Positions are stream-relative, so they move by the
+// segment base. Most targets are stable across the merge (queue indices, tag ids);
+// constant-data offsets move with the segment's constant-data base, and worker-local
+// symbol ids are translated through `symmap`.
+static void jl_merge_reloc_pairs(arraylist_t *dest, arraylist_t *src, size_t base, size_t const_base, uintptr_t *symmap) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < src->len; i += 2) {
+        uintptr_t pos = (uintptr_t)src->items[i] + base;
+        uintptr_t item = (uintptr_t)src->items[i + 1];
+        enum RefTags tag = (enum RefTags)(item >> RELOC_TAG_OFFSET);
+        if (tag == ConstDataRef) {
+            item += const_base / sizeof(void*);
+            assert((enum RefTags)(item >> RELOC_TAG_OFFSET) == ConstDataRef && "offset to constant data too large");
+        }
+        else if (tag == SymbolRef) {
+            item = symmap[item & (((uintptr_t)1 << RELOC_TAG_OFFSET) - 1)];
+        }
+        arraylist_push(dest, (void*)pos);
+        arraylist_push(dest, (void*)item);
+    }
+}
+
+static void jl_merge_position_list(arraylist_t *dest, arraylist_t *src, size_t base) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < src->len; i++)
+        arraylist_push(dest, (void*)((uintptr_t)src->items[i] + base));
+}
+
+// Splice one segment of a parallel `jl_write_values` onto the end of the main streams,
+// rebasing every recorded position and renumbering worker-local symbols. Segments are
+// merged in queue order, so the resulting layout, list ordering and symbol numbering
+// match what a serial write of the whole queue would have produced (up to the padding
+// inserted at the splice points).
+static void jl_merge_segment(jl_serializer_state *s, jl_write_segment_t *seg)
+{
+    // the worker established the gc alignment of its objects (and the cache alignment
+    // of its constant data) relative to position 0, so the splice points must keep it
+    write_padding(s->s, LLT_ALIGN(ios_pos(s->s), 16) - ios_pos(s->s));
+    size_t base = ios_pos(s->s);
+    ios_seek(&seg->sysimg, 0);
+    ios_copyall(s->s, &seg->sysimg);
+    ios_close(&seg->sysimg);
+    write_padding(s->const_data, LLT_ALIGN(ios_pos(s->const_data), JL_CACHE_BYTE_ALIGNMENT) - ios_pos(s->const_data));
+    size_t const_base = ios_pos(s->const_data);
+    ios_seek(&seg->const_data, 0);
+    ios_copyall(s->const_data, &seg->const_data);
+    ios_close(&seg->const_data);
+
+    // intern the worker-local symbols for real; walking the segments in queue order
+    // assigns exactly the ids a serial write would have
+    size_t nsyms = seg->sym_order.len;
+    uintptr_t *symmap = nsyms ? (uintptr_t*)malloc_s(nsyms * sizeof(uintptr_t)) : NULL;
+    for (size_t i = 0; i < nsyms; i++)
+        symmap[i] = backref_id(s, seg->sym_order.items[i], NULL);
+
+    jl_merge_reloc_pairs(&s->gctags_list, &seg->s.gctags_list, base, const_base, symmap);
+    jl_merge_reloc_pairs(&s->relocs_list, &seg->s.relocs_list, base, const_base, symmap);
+    jl_merge_reloc_pairs(&s->memowner_list, &seg->s.memowner_list, base, const_base, symmap);
+    jl_merge_reloc_pairs(&s->memref_list, &seg->s.memref_list, base, const_base, symmap);
+    jl_merge_position_list(&s->fixup_types, &seg->s.fixup_types, base);
+    jl_merge_position_list(&s->fixup_objs, &seg->s.fixup_objs, base);
+    jl_merge_position_list(&s->ccallable_list, &seg->s.ccallable_list, base);
+
+    // rebase this segment's slice of the layout table (the low bit marks entries that
+    // live in the constant data stream, see `jl_write_values`)
+    for (size_t item = seg->start; item < seg->end; item++) {
+        uintptr_t entry = (uintptr_t)layout_table.items[item];
+        assert(entry != 0 && "layout offset missing for queued item");
+        if (entry & 1)
+            entry = ((entry & ~(uintptr_t)1) + const_base) | 1;
+        else
+            entry += base;
+        layout_table.items[item] = (void*)entry;
+    }
+
+    // replay the deferred fptr_record entries now that the final offsets are known
+    for (size_t i = 0; i < seg->fptrs.len; i += 3) {
+        int32_t invokeptr_id = (int32_t)(uint32_t)(uintptr_t)seg->fptrs.items[i];
+        int32_t specfptr_id = (int32_t)(uint32_t)(uintptr_t)seg->fptrs.items[i + 1];
+        uintptr_t reloc_offset = (uintptr_t)seg->fptrs.items[i + 2] + base;
+        write_fptr_record(s, invokeptr_id, specfptr_id, reloc_offset);
+    }
+
+    // uniquing is incremental-only and parallel writing is not (see `jl_write_values`)
+    assert(seg->s.uniquing_types.len == 0);
+    assert(seg->s.uniquing_objs.len == 0);
+    assert(seg->s.uniquing_super.len == 0);
+
+    free(symmap);
+    arraylist_free(&seg->s.memowner_list);
+    arraylist_free(&seg->s.memref_list);
+    arraylist_free(&seg->s.relocs_list);
+    arraylist_free(&seg->s.gctags_list);
+    arraylist_free(&seg->s.uniquing_types);
+    arraylist_free(&seg->s.uniquing_super);
+    arraylist_free(&seg->s.uniquing_objs);
+    arraylist_free(&seg->s.fixup_types);
+    arraylist_free(&seg->s.fixup_objs);
+    arraylist_free(&seg->s.ccallable_list);
+    htable_free(&seg->symbol_table);
+    arraylist_free(&seg->sym_order);
+    arraylist_free(&seg->fptrs);
+}
+
+// The main function for serializing all the items queued in `serialization_order`
+// (They are also stored in `serialization_queue` which is order-preserving, unlike the hash table used
+//  for `serialization_order`).
+// The queue order is fixed before writing starts and cross-references are queue
+// indices rather than stream offsets, so for large non-incremental images the queue is
+// partitioned into contiguous ranges written concurrently into private segments and
+// spliced back together afterwards. The queue phase already visited every field the
+// writers will read (populating the `field_replace` and `nullptrs` caches), so apart
+// from symbol interning and `fptr_record` entries, which the workers divert into
+// worker-local structures, writing a range only touches its own streams and lists.
+// Incremental images always stay on one thread: their uniquing and external-linkage
+// bookkeeping mutates shared state in queue order as a side effect of writing.
+static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
+{
+    size_t l = serialization_queue.len;
+
+    arraylist_new(&layout_table, 0);
+    arraylist_grow(&layout_table, l * 2);
+    memset(layout_table.items, 0, l * 2 * sizeof(void*));
+
+    size_t nthreads = 1;
+    if (!s->incremental && l >= IMAGE_WRITE_PARALLEL_THRESHOLD) {
+        nthreads = jl_cpu_threads();
+        if (nthreads > IMAGE_WRITE_MAX_THREADS)
+            nthreads = IMAGE_WRITE_MAX_THREADS;
+        if (nthreads > l / (IMAGE_WRITE_PARALLEL_THRESHOLD / 2))
+            nthreads = l / (IMAGE_WRITE_PARALLEL_THRESHOLD / 2);
+    }
+    if (nthreads <= 1) {
+        jl_write_values_range(s, 0, l);
+        assert(s->uniquing_super.len == 0);
+        return;
+    }
+
+    jl_write_segment_t *segments = (jl_write_segment_t*)malloc_s(nthreads * sizeof(jl_write_segment_t));
+    uv_thread_t threads[IMAGE_WRITE_MAX_THREADS];
+    size_t chunk = l / nthreads;
+    size_t spawned = 0;
+    for (size_t t = 0; t < nthreads; t++) {
+        jl_write_segment_t *seg = &segments[t];
+        seg->start = t * chunk;
+        seg->end = t == nthreads - 1 ? l : seg->start + chunk;
+        seg->s = *s;
+        ios_mem(&seg->sysimg, 0);
+        ios_mem(&seg->const_data, 0);
+        seg->s.s = &seg->sysimg;
+        seg->s.const_data = &seg->const_data;
+        arraylist_new(&seg->s.memowner_list, 0);
+        arraylist_new(&seg->s.memref_list, 0);
+        arraylist_new(&seg->s.relocs_list, 0);
+        arraylist_new(&seg->s.gctags_list, 0);
+        arraylist_new(&seg->s.uniquing_types, 0);
+        arraylist_new(&seg->s.uniquing_super, 0);
+        arraylist_new(&seg->s.uniquing_objs, 0);
+        arraylist_new(&seg->s.fixup_types, 0);
+        arraylist_new(&seg->s.fixup_objs, 0);
+        arraylist_new(&seg->s.ccallable_list, 0);
+        htable_new(&seg->symbol_table, 0);
+        arraylist_new(&seg->sym_order, 0);
+        arraylist_new(&seg->fptrs, 0);
+        seg->s.worker_symbols = &seg->symbol_table;
+        seg->s.worker_sym_order = &seg->sym_order;
+        seg->s.worker_fptrs = &seg->fptrs;
+        if (t == 0)
+            continue; // the first segment is written on this thread
+        if (uv_thread_create(&threads[spawned], jl_write_values_threadfun, seg))
+            jl_write_values_range(&seg->s, seg->start, seg->end);
+        else
+            spawned++;
+    }
+    jl_write_values_range(&segments[0].s, segments[0].start, segments[0].end);
+    for (size_t t = 0; t < spawned; t++)
+        uv_thread_join(&threads[t]);
+
+    // splice the segments back together, in queue order
+    for (size_t t = 0; t < nthreads; t++)
+        jl_merge_segment(s, &segments[t]);
+    free(segments);
     assert(s->uniquing_super.len == 0);
 }
 
@@ -1767,17 +2079,7 @@ static void jl_write_values(jl_serializer_state *s) JL_GC_DISABLED
 static void jl_read_symbols(jl_serializer_state *s)
 {
     assert(deser_sym.len == 0);
-    uintptr_t base = (uintptr_t)&s->symbols->buf[0];
-    uintptr_t end = base + s->symbols->size;
-    while (base < end) {
-        uint32_t len = jl_load_unaligned_i32((void*)base);
-        base += 4;
-        const char *str = (const char*)base;
-        base += len + 1;
-        //printf("symbol %3d: %s\n", len, str);
-        jl_sym_t *sym = _jl_symbol(str, len);
-        arraylist_push(&deser_sym, (void*)sym);
-    }
+    _jl_symbols_intern_packed(&s->symbols->buf[0], s->symbols->size, &deser_sym);
 }
 
 
@@ -1937,6 +2239,45 @@ static void jl_finish_relocs(char *base, size_t size, arraylist_t *list)
     }
 }
 
+// Prelink: rewrite the relocations whose targets live inside this same image as final
+// pointer values for a load address of JL_PRELINK_BASE. The rewritten entries move
+// (in position order) from `list` to `prelinked`, leaving behind only the entries whose
+// values depend on the state of the loading process (symbols, function pointers,
+// references into other images). Type tags whose target has a small tag are resolved
+// to the address-independent encoding directly, so they never need load-time work.
+static void jl_prelink_relocs(char *base, size_t size, size_t const_data_delta,
+                              arraylist_t *list, arraylist_t *prelinked, uint8_t bits)
+{
+    size_t keep = 0;
+    for (size_t i = 0; i < list->len; i += 2) {
+        size_t pos = (size_t)list->items[i];
+        assert(pos < size && pos != 0);
+        uintptr_t *pv = (uintptr_t*)(base + pos);
+        uintptr_t w = *pv;
+        enum RefTags tag = (enum RefTags)(w >> RELOC_TAG_OFFSET);
+        size_t offset = (w & (((uintptr_t)1 << RELOC_TAG_OFFSET) - 1));
+        if (tag == DataRef) {
+            uintptr_t v;
+            if (bits && ((jl_datatype_t*)(base + offset))->smalltag)
+                v = (uintptr_t)((jl_datatype_t*)(base + offset))->smalltag << 4;
+            else
+                v = JL_PRELINK_BASE + offset;
+            *pv = v | bits;
+        }
+        else if (tag == ConstDataRef && !bits) {
+            *pv = JL_PRELINK_BASE + const_data_delta + offset * sizeof(void*);
+        }
+        else {
+            list->items[keep++] = list->items[i];
+            list->items[keep++] = list->items[i + 1];
+            continue;
+        }
+        arraylist_push(prelinked, (void*)pos);
+        arraylist_push(prelinked, NULL); // unused: jl_write_offsetlist only reads the positions
+    }
+    list->len = keep;
+}
+
 static void jl_write_offsetlist(ios_t *s, size_t size, arraylist_t *list)
 {
     for (size_t i = 0; i < list->len; i += 2) {
@@ -1971,12 +2312,130 @@ static void jl_write_arraylist(ios_t *s, arraylist_t *list)
     ios_write(s, (const char*)list->items, list->len * sizeof(void*));
 }
 
+// number of decoded relocations below which patching stays on one thread;
+// small tables do not repay the thread startup cost
+#define RELOC_PARALLEL_THRESHOLD 65536
+// upper bound on helper threads for relocation patching (including the
+// current thread); pointer patching saturates memory bandwidth quickly
+#define RELOC_MAX_THREADS 8
+
+// apply a decoded range of relocations; ranges are independent once the
+// stream has been decoded, so they can be patched concurrently
+static void jl_apply_reloc_range(jl_serializer_state *s, uintptr_t base, uint8_t bits,
+                                 uintptr_t *positions, size_t npositions) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < npositions; i++) {
+        uintptr_t *pv = (uintptr_t *)(base + positions[i]);
+        uintptr_t v = *pv;
+        v = get_item_for_reloc(s, base, v, NULL, NULL);
+        if (bits && v && ((jl_datatype_t*)v)->smalltag)
+            v = (uintptr_t)((jl_datatype_t*)v)->smalltag << 4; // TODO: should we have a representation that supports sweep without a relocation step?
+        *pv = v | bits;
+    }
+}
+
+typedef struct {
+    jl_serializer_state *s;
+    uintptr_t base;
+    uint8_t bits;
+    uintptr_t *positions;
+    size_t npositions;
+} jl_reloc_work_t;
+
+static void jl_apply_reloc_threadfun(void *arg)
+{
+    jl_reloc_work_t *work = (jl_reloc_work_t*)arg;
+    jl_apply_reloc_range(work->s, work->base, work->bits, work->positions, work->npositions);
+}
+
 static void jl_read_reloclist(jl_serializer_state *s, jl_array_t *link_ids, uint8_t bits)
 {
     uintptr_t base = (uintptr_t)s->s->buf;
     uintptr_t last_pos = 0;
     uint8_t *current = (uint8_t *)(s->relocs->buf + s->relocs->bpos);
     int link_index = 0;
+    // first decode the delta-compressed offset stream; this part is
+    // inherently serial, but cheap, since it only touches the stream itself
+    // and not the relocation targets
+    arraylist_t positions;
+    arraylist_new(&positions, 0);
+    while (1) {
+        // Read the offset of the next object
+        size_t pos_diff = 0;
+        size_t cnt = 0;
+        while (1) {
+            assert(s->relocs->bpos <= s->relocs->size);
+            assert((char *)current <= (char *)(s->relocs->buf + s->relocs->size));
+            int8_t c = *current++;
+            s->relocs->bpos += 1;
+
+            pos_diff |= ((size_t)c & 0x7F) << (7 * cnt++);
+            if ((c >> 7) == 0)
+                break;
+        }
+        if (pos_diff == 0)
+            break;
+
+        uintptr_t pos = last_pos + pos_diff;
+        last_pos = pos;
+        arraylist_push(&positions, (void*)pos);
+    }
+    if ((link_ids == NULL || jl_array_len(link_ids) == 0) &&
+            positions.len >= RELOC_PARALLEL_THRESHOLD) {
+        // the entries are independent once the base address and positions
+        // are known, so partition large tables across a few helper threads;
+        // this is most of the pointer-patching work at process start
+        size_t nthreads = jl_cpu_threads();
+        if (nthreads > RELOC_MAX_THREADS)
+            nthreads = RELOC_MAX_THREADS;
+        uv_thread_t threads[RELOC_MAX_THREADS];
+        jl_reloc_work_t work[RELOC_MAX_THREADS];
+        uintptr_t *items = (uintptr_t*)positions.items;
+        size_t chunk = positions.len / nthreads;
+        size_t spawned = 0;
+        for (size_t t = 1; t < nthreads; t++) {
+            size_t begin = t * chunk;
+            size_t end = t == nthreads - 1 ? positions.len : begin + chunk;
+            work[t].s = s;
+            work[t].base = base;
+            work[t].bits = bits;
+            work[t].positions = items + begin;
+            work[t].npositions = end - begin;
+            if (uv_thread_create(&threads[spawned], jl_apply_reloc_threadfun, &work[t]))
+                jl_apply_reloc_range(s, base, bits, work[t].positions, work[t].npositions);
+            else
+                spawned++;
+        }
+        jl_apply_reloc_range(s, base, bits, items, chunk);
+        for (size_t t = 0; t < spawned; t++)
+            uv_thread_join(&threads[t]);
+    }
+    else {
+        // entries with external linkage consume link_ids in stream order,
+        // so that path stays on the current thread
+        for (size_t i = 0; i < positions.len; i++) {
+            uintptr_t *pv = (uintptr_t *)(base + (uintptr_t)positions.items[i]);
+            uintptr_t v = *pv;
+            v = get_item_for_reloc(s, base, v, link_ids, &link_index);
+            if (bits && v && ((jl_datatype_t*)v)->smalltag)
+                v = (uintptr_t)((jl_datatype_t*)v)->smalltag << 4; // TODO: should we have a representation that supports sweep without a relocation step?
+            *pv = v | bits;
+        }
+    }
+    arraylist_free(&positions);
+    assert(!link_ids || link_index == jl_array_len(link_ids));
+}
+
+// Apply a list of prelinked relocations (see `jl_prelink_relocs`): the image already
+// holds final pointer values for a load address of JL_PRELINK_BASE. When the image is
+// actually mapped there, only the offset stream needs to be skipped; otherwise each
+// entry gets the constant slide added. Small type-tag constants are address-independent
+// and are recognized by their magnitude.
+static void jl_read_prelinklist(jl_serializer_state *s, intptr_t slide)
+{
+    uintptr_t base = (uintptr_t)s->s->buf;
+    uintptr_t last_pos = 0;
+    uint8_t *current = (uint8_t *)(s->relocs->buf + s->relocs->bpos);
     while (1) {
         // Read the offset of the next object
         size_t pos_diff = 0;
@@ -1996,14 +2455,13 @@ static void jl_read_reloclist(jl_serializer_state *s, jl_array_t *link_ids, uint
 
         uintptr_t pos = last_pos + pos_diff;
         last_pos = pos;
+        if (slide == 0)
+            continue; // mapped at the preferred base: the stored value is already final
         uintptr_t *pv = (uintptr_t *)(base + pos);
         uintptr_t v = *pv;
-        v = get_item_for_reloc(s, base, v, link_ids, &link_index);
-        if (bits && v && ((jl_datatype_t*)v)->smalltag)
-            v = (uintptr_t)((jl_datatype_t*)v)->smalltag << 4; // TODO: should we have a representation that supports sweep without a relocation step?
-        *pv = v | bits;
+        if (v >> 16) // skip address-independent small type tags
+            *pv = v + slide;
     }
-    assert(!link_ids || link_index == jl_array_len(link_ids));
 }
 
 static void jl_read_memreflist(jl_serializer_state *s)
@@ -2057,26 +2515,30 @@ void gc_sweep_sysimg(void)
         if (!relocs)
             continue;
         uintptr_t base = (uintptr_t)jl_linkage_blobs.items[i];
-        uintptr_t last_pos = 0;
         uint8_t *current = (uint8_t *)relocs;
-        while (1) {
-            // Read the offset of the next object
-            size_t pos_diff = 0;
-            size_t cnt = 0;
+        // the tags section holds two consecutive offset lists, the prelinked tags
+        // followed by the tag-encoded ones (see jl_save_system_image_to_stream)
+        for (int list = 0; list < 2; list++) {
+            uintptr_t last_pos = 0;
             while (1) {
-                int8_t c = *current++;
-                pos_diff |= ((size_t)c & 0x7F) << (7 * cnt++);
-                if ((c >> 7) == 0)
+                // Read the offset of the next object
+                size_t pos_diff = 0;
+                size_t cnt = 0;
+                while (1) {
+                    int8_t c = *current++;
+                    pos_diff |= ((size_t)c & 0x7F) << (7 * cnt++);
+                    if ((c >> 7) == 0)
+                        break;
+                }
+                if (pos_diff == 0)
                     break;
-            }
-            if (pos_diff == 0)
-                break;
 
-            uintptr_t pos = last_pos + pos_diff;
-            last_pos = pos;
-            jl_taggedvalue_t *o = (jl_taggedvalue_t *)(base + pos);
-            o->bits.gc = GC_OLD;
-            assert(o->bits.in_image == 1);
+                uintptr_t pos = last_pos + pos_diff;
+                last_pos = pos;
+                jl_taggedvalue_t *o = (jl_taggedvalue_t *)(base + pos);
+                o->bits.gc = GC_OLD;
+                assert(o->bits.in_image == 1);
+            }
         }
     }
 }
@@ -2134,6 +2596,81 @@ static jl_value_t *jl_delayed_reloc(jl_serializer_state *s, uintptr_t offset) JL
 }
 
 
+// Lazy materialization of pkgimage function pointers. A package image can
+// carry native code for far more code instances than a session ever calls, so
+// instead of publishing every image code address at load time, pkgimage code
+// instances restore with `invoke` pointing at a stub. The recorded addresses
+// are kept in a per-image table, and the stub publishes them for its code
+// instance on first call, after which calls proceed at full speed. (The text
+// section itself is mapped by the dynamic linker and already pages in on
+// demand; this extends the same pay-as-you-go principle to the per-function
+// fixup work.) The tables live for the lifetime of the process, like the
+// images they describe.
+typedef struct {
+    jl_code_instance_t *ci;
+    void *fptr;               // code address inside the image
+    jl_callptr_t orig_invoke; // entry point displaced by the stub, if any
+    int specfunc;
+} jl_lazy_fptr_t;
+
+typedef struct {
+    jl_lazy_fptr_t *entries;  // sorted by code-instance pointer
+    size_t n;
+} jl_lazy_fptr_table_t;
+
+static arraylist_t lazy_fptr_tables;
+jl_mutex_t lazy_fptrs_lock;
+
+static int lazy_fptr_cmp(const void *a, const void *b) JL_NOTSAFEPOINT
+{
+    jl_code_instance_t *ca = ((const jl_lazy_fptr_t*)a)->ci;
+    jl_code_instance_t *cb = ((const jl_lazy_fptr_t*)b)->ci;
+    return ca < cb ? -1 : ca > cb ? 1 : 0;
+}
+
+// publish the recorded code addresses for `codeinst` and restore its real
+// invoke entry point, which is also returned. Idempotent, so a thread that
+// raced past the stub before the stores landed just resolves again.
+static jl_callptr_t jl_resolve_lazy_fptr(jl_code_instance_t *codeinst)
+{
+    JL_LOCK(&lazy_fptrs_lock);
+    jl_lazy_fptr_t *spec_e = NULL, *inv_e = NULL;
+    for (size_t t = 0; t < lazy_fptr_tables.len && !spec_e && !inv_e; t++) {
+        jl_lazy_fptr_table_t *tab = (jl_lazy_fptr_table_t*)lazy_fptr_tables.items[t];
+        size_t lo = 0, hi = tab->n;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (tab->entries[mid].ci < codeinst)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        // a code instance has up to two adjacent entries: the specsig
+        // function and its jlcall wrapper
+        for (; lo < tab->n && tab->entries[lo].ci == codeinst; lo++) {
+            if (tab->entries[lo].specfunc)
+                spec_e = &tab->entries[lo];
+            else
+                inv_e = &tab->entries[lo];
+        }
+    }
+    assert((spec_e || inv_e) && "no recorded code address for lazy code instance");
+    if (spec_e) {
+        jl_atomic_store_relaxed(&codeinst->specptr.fptr, spec_e->fptr);
+        jl_atomic_store_release(&codeinst->specsigflags, 0b111); // TODO: set only if confirmed to be true
+    }
+    jl_callptr_t invoke = inv_e ? (jl_callptr_t)inv_e->fptr : spec_e->orig_invoke;
+    jl_atomic_store_release(&codeinst->invoke, invoke);
+    JL_UNLOCK(&lazy_fptrs_lock);
+    return invoke;
+}
+
+static jl_value_t *jl_fptr_pkgimg_lazy(jl_value_t *f, jl_value_t **args, uint32_t nargs, jl_code_instance_t *m)
+{
+    jl_callptr_t invoke = jl_resolve_lazy_fptr(m);
+    return invoke(f, args, nargs, m);
+}
+
 static void jl_update_all_fptrs(jl_serializer_state *s, jl_image_t *image)
 {
     jl_image_fptrs_t fvars = image->fptrs;
@@ -2152,6 +2689,11 @@ static void jl_update_all_fptrs(jl_serializer_state *s, jl_image_t *image)
     // offsets into `s` for CodeInstances
     jl_method_instance_t **linfos = (jl_method_instance_t**)&s->fptr_record->buf[0];
     uint32_t clone_idx = 0;
+    // pkgimages defer fptr publication to first call; the sysimage is always
+    // materialized eagerly since nearly all of it runs during startup
+    int lazy = s->incremental != 0;
+    jl_lazy_fptr_t *lazies = lazy ? (jl_lazy_fptr_t*)malloc_s(img_fvars_max * sizeof(jl_lazy_fptr_t)) : NULL;
+    size_t nlazy = 0;
     for (i = 0; i < img_fvars_max; i++) {
         reloc_t offset = *(reloc_t*)&linfos[i];
         linfos[i] = NULL;
@@ -2177,7 +2719,15 @@ static void jl_update_all_fptrs(jl_serializer_state *s, jl_image_t *image)
                 break;
             }
             void *fptr = (void*)(base + offset);
-            if (specfunc) {
+            if (lazy) {
+                lazies[nlazy].ci = codeinst;
+                lazies[nlazy].fptr = fptr;
+                lazies[nlazy].orig_invoke = specfunc ? jl_atomic_load_relaxed(&codeinst->invoke) : NULL;
+                lazies[nlazy].specfunc = specfunc;
+                nlazy++;
+                jl_atomic_store_relaxed(&codeinst->invoke, &jl_fptr_pkgimg_lazy);
+            }
+            else if (specfunc) {
                 jl_atomic_store_relaxed(&codeinst->specptr.fptr, fptr);
                 jl_atomic_store_relaxed(&codeinst->specsigflags, 0b111); // TODO: set only if confirmed to be true
             }
@@ -2186,6 +2736,22 @@ static void jl_update_all_fptrs(jl_serializer_state *s, jl_image_t *image)
             }
         }
     }
+    if (lazy) {
+        if (nlazy == 0) {
+            free(lazies);
+        }
+        else {
+            qsort(lazies, nlazy, sizeof(jl_lazy_fptr_t), lazy_fptr_cmp);
+            jl_lazy_fptr_table_t *tab = (jl_lazy_fptr_table_t*)malloc_s(sizeof(jl_lazy_fptr_table_t));
+            tab->entries = lazies;
+            tab->n = nlazy;
+            JL_LOCK(&lazy_fptrs_lock);
+            if (lazy_fptr_tables.items == NULL)
+                arraylist_new(&lazy_fptr_tables, 0);
+            arraylist_push(&lazy_fptr_tables, tab);
+            JL_UNLOCK(&lazy_fptrs_lock);
+        }
+    }
     // Tell LLVM about the native code
     jl_register_fptrs(image->base, &fvars, linfos, img_fvars_max);
 }
@@ -2447,12 +3013,90 @@ static void jl_strip_all_codeinfos(void)
     jl_foreach_reachable_mtable(strip_all_codeinfos_, NULL);
 }
 
+// --- adaptive IR symbol tables ---
+
+static int recompress_all_codeinfos__(jl_typemap_entry_t *def, void *_env)
+{
+    jl_method_t *m = def->func.method;
+    if (jl_object_in_image((jl_value_t*)m))
+        return 1;
+    if (m->source && jl_is_string(m->source)) {
+        jl_code_info_t *src = jl_uncompress_ir(m, NULL, m->source);
+        JL_GC_PUSH1(&src);
+        m->source = (jl_value_t*)jl_compress_ir(m, src);
+        jl_gc_wb(m, m->source);
+        JL_GC_POP();
+    }
+    return 1;
+}
+
+static int recompress_all_codeinfos_(jl_methtable_t *mt, void *_env)
+{
+    return jl_typemap_visitor(jl_atomic_load_relaxed(&mt->defs), recompress_all_codeinfos__, NULL);
+}
+
+// With JULIA_PKGIMAGE_SYMTAB set, build a symbol table from this session's IR
+// compression statistics and recompress the new methods' IR against it, so
+// the incremental image's hot symbols get the short encodings that the static
+// tables reserve for Base's (see ircode.c). The table itself is emitted into
+// the image alongside the worklist.
+static void jl_recompress_all_codeinfos(void)
+{
+    jl_array_t *syms = jl_ir_symbol_candidates(255);
+    if (jl_array_nrows(syms) == 0)
+        return;
+    JL_GC_PUSH1(&syms);
+    jl_install_ir_symbol_table(syms, 1);
+    JL_GC_POP();
+    jl_foreach_reachable_mtable(recompress_all_codeinfos_, NULL);
+}
+
 // --- entry points ---
 
 jl_genericmemory_t *jl_global_roots_list;
 jl_genericmemory_t *jl_global_roots_keyset;
 jl_mutex_t global_roots_lock;
 
+// Negative filter in front of the global-roots IdSet. jl_as_global_root is
+// consulted for every cacheable type parameter during type instantiation and
+// most of those values are not in the set, so before probing the set proper
+// we test two object-id-derived bits in a fixed Bloom filter: if either bit
+// is clear, the key is definitely absent. Bits are only ever set (the set
+// never shrinks); writers hold global_roots_lock and lock-free readers
+// re-test under the lock before trusting a miss.
+#define GLOBAL_ROOTS_FILTER_BITS 19 // 64 KiB of filter for the whole process
+static _Atomic(uint64_t) global_roots_filter[((size_t)1 << GLOBAL_ROOTS_FILTER_BITS) / 64];
+
+STATIC_INLINE int global_roots_filter_maybe_contains(uintptr_t hv) JL_NOTSAFEPOINT
+{
+    size_t mask = ((size_t)1 << GLOBAL_ROOTS_FILTER_BITS) - 1;
+    size_t b1 = hv & mask;
+    size_t b2 = (hv >> GLOBAL_ROOTS_FILTER_BITS) & mask;
+    uint64_t w1 = jl_atomic_load_relaxed(&global_roots_filter[b1 / 64]);
+    uint64_t w2 = jl_atomic_load_relaxed(&global_roots_filter[b2 / 64]);
+    return ((w1 >> (b1 % 64)) & (w2 >> (b2 % 64)) & 1) != 0;
+}
+
+static void global_roots_filter_add(uintptr_t hv) JL_NOTSAFEPOINT
+{
+    size_t mask = ((size_t)1 << GLOBAL_ROOTS_FILTER_BITS) - 1;
+    size_t b1 = hv & mask;
+    size_t b2 = (hv >> GLOBAL_ROOTS_FILTER_BITS) & mask;
+    jl_atomic_fetch_or_relaxed(&global_roots_filter[b1 / 64], (uint64_t)1 << (b1 % 64));
+    jl_atomic_fetch_or_relaxed(&global_roots_filter[b2 / 64], (uint64_t)1 << (b2 % 64));
+}
+
+// re-derive the filter after the set has been replaced wholesale (sysimage load)
+static void global_roots_filter_rebuild(void)
+{
+    memset((void*)global_roots_filter, 0, sizeof(global_roots_filter));
+    for (size_t i = 0; i < jl_global_roots_list->length; i++) {
+        jl_value_t *val = jl_genericmemory_ptr_ref(jl_global_roots_list, i);
+        if (val != NULL)
+            global_roots_filter_add(jl_object_id(val));
+    }
+}
+
 JL_DLLEXPORT int jl_is_globally_rooted(jl_value_t *val JL_MAYBE_UNROOTED) JL_NOTSAFEPOINT
 {
     if (jl_is_datatype(val)) {
@@ -2496,12 +3140,16 @@ JL_DLLEXPORT jl_value_t *jl_as_global_root(jl_value_t *val, int insert)
         if ((uint64_t)(n+512) < 1024)
             return jl_box_int64(n);
     }
-    // check table before acquiring lock to reduce writer contention
-    jl_value_t *rval = jl_idset_get(jl_global_roots_list, jl_global_roots_keyset, val);
-    if (rval)
-        return rval;
+    uintptr_t hv = jl_object_id(val);
+    // check filter and table before acquiring lock to reduce writer contention
+    if (global_roots_filter_maybe_contains(hv)) {
+        jl_value_t *rval = jl_idset_get(jl_global_roots_list, jl_global_roots_keyset, val);
+        if (rval)
+            return rval;
+    }
     JL_LOCK(&global_roots_lock);
-    rval = jl_idset_get(jl_global_roots_list, jl_global_roots_keyset, val);
+    jl_value_t *rval = global_roots_filter_maybe_contains(hv) ?
+        jl_idset_get(jl_global_roots_list, jl_global_roots_keyset, val) : NULL;
     if (rval) {
         val = rval;
     }
@@ -2509,6 +3157,7 @@ JL_DLLEXPORT jl_value_t *jl_as_global_root(jl_value_t *val, int insert)
         ssize_t idx;
         jl_global_roots_list = jl_idset_put_key(jl_global_roots_list, val, &idx);
         jl_global_roots_keyset = jl_idset_put_idx(jl_global_roots_list, jl_global_roots_keyset, idx);
+        global_roots_filter_add(hv);
     }
     else {
         val = NULL;
@@ -2565,6 +3214,150 @@ static void jl_prepare_serialization_data(jl_array_t *mod_array, jl_array_t *new
     JL_GC_POP();
 }
 
+// Profile-guided image layout
+//
+// Objects land in the image in serialization-discovery order, which scatters
+// the startup-hot ones across the whole mapping. Because cross-references are
+// queue indices that only become stream offsets inside `jl_write_values`, the
+// queue can be permuted freely between the discovery phase and the write
+// phase. Three environment variables drive a training loop around that:
+//
+//   JULIA_IMAGE_LAYOUT_MAP=<file>          at image build time, dump each queue
+//                                          id's final offset in the image data
+//   JULIA_IMAGE_LAYOUT_PROFILE_OUT=<file>  at run time, sample which image
+//                                          pages the workload faults in, and
+//                                          when (jl_image_layout_profile_start)
+//   JULIA_IMAGE_LAYOUT_PROFILE=<file>      at image build time, combine the
+//                                          profile with the previous build's
+//                                          map and lay hot objects out first
+//
+// The rebuild translates the previous build's id => offset map through the
+// profiled page ranks into an approximate first-use rank per object; as long
+// as the sources are unchanged, the discovery order (and hence the ids) of
+// the two builds coincide. Objects on pages the training run never touched
+// keep their discovery order behind everything that was used.
+
+#define LAYOUT_MAP_MAGIC     ((uint64_t)0x70616d31676d696a) // "jimg1map"
+#define LAYOUT_PROFILE_MAGIC ((uint64_t)0x666f727031676d6a) // "jmg1prof"
+
+static void jl_write_layout_map(size_t const_data_delta)
+{
+    const char *path = getenv("JULIA_IMAGE_LAYOUT_MAP");
+    if (path == NULL || path[0] == '\0')
+        return;
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        jl_printf(JL_STDERR, "WARNING: could not write image layout map \"%s\"\n", path);
+        return;
+    }
+    size_t l = serialization_queue.len;
+    uint64_t header[2] = {LAYOUT_MAP_MAGIC, l};
+    fwrite(header, sizeof(uint64_t), 2, fp);
+    for (size_t id = 0; id < l; id++) {
+        uintptr_t entry = (uintptr_t)layout_table.items[id];
+        // main-stream positions coincide with image-blob offsets (the blob
+        // starts with the length word the stream reserved); constant data
+        // follows the main stream at const_data_delta (see the restore code)
+        uint64_t offset = (entry & 1) ? (entry & ~(uintptr_t)1) + const_data_delta : entry;
+        fwrite(&offset, sizeof(uint64_t), 1, fp);
+    }
+    fclose(fp);
+}
+
+typedef struct {
+    uint32_t rank;
+    size_t idx;
+} layout_rank_t;
+
+static int layout_rank_cmp(const void *a, const void *b)
+{
+    const layout_rank_t *ra = (const layout_rank_t*)a;
+    const layout_rank_t *rb = (const layout_rank_t*)b;
+    if (ra->rank != rb->rank)
+        return ra->rank < rb->rank ? -1 : 1;
+    // tie-break on the discovery index to keep the sort stable
+    return ra->idx < rb->idx ? -1 : (ra->idx > rb->idx);
+}
+
+// Permute `serialization_queue` so that the objects the training profile saw
+// faulted in earliest are written (and hence laid out) first. Must run after
+// the discovery phase and before `jl_write_values`; sysimages only, since an
+// incremental image's queue starts with its worklist by construction.
+static void jl_reorder_queue_from_profile(void)
+{
+    const char *profpath = getenv("JULIA_IMAGE_LAYOUT_PROFILE");
+    const char *mappath = getenv("JULIA_IMAGE_LAYOUT_MAP");
+    uint64_t mhdr[2], phdr[4];
+    uint64_t *offsets = NULL;
+    uint32_t *ranks = NULL;
+    layout_rank_t *order = NULL;
+    size_t l = serialization_queue.len;
+    if (profpath == NULL || profpath[0] == '\0' || mappath == NULL || mappath[0] == '\0')
+        return;
+    FILE *mapf = fopen(mappath, "rb");
+    if (mapf == NULL)
+        return; // first build of the cycle: nothing to train against yet
+    FILE *proff = fopen(profpath, "rb");
+    if (proff == NULL) {
+        fclose(mapf);
+        return;
+    }
+    if (fread(mhdr, sizeof(uint64_t), 2, mapf) != 2 || mhdr[0] != LAYOUT_MAP_MAGIC ||
+        fread(phdr, sizeof(uint64_t), 4, proff) != 4 || phdr[0] != LAYOUT_PROFILE_MAGIC ||
+        phdr[1] == 0) {
+        jl_printf(JL_STDERR, "WARNING: ignoring unusable image layout profile \"%s\"\n", profpath);
+        goto done;
+    }
+    size_t nmap = mhdr[1], psz = phdr[1], lead = phdr[2], npages = phdr[3];
+    offsets = (uint64_t*)malloc_s(nmap * sizeof(uint64_t));
+    ranks = (uint32_t*)malloc_s(npages * sizeof(uint32_t));
+    if (fread(offsets, sizeof(uint64_t), nmap, mapf) != nmap ||
+        fread(ranks, sizeof(uint32_t), npages, proff) != npages) {
+        jl_printf(JL_STDERR, "WARNING: ignoring unusable image layout profile \"%s\"\n", profpath);
+        goto done;
+    }
+    order = (layout_rank_t*)malloc_s(l * sizeof(layout_rank_t));
+    for (size_t i = 0; i < l; i++) {
+        uint32_t rank = UINT32_MAX; // cold
+        if (i < nmap) {
+            size_t page = (lead + offsets[i]) / psz;
+            if (page < npages && ranks[page] != 0)
+                rank = ranks[page];
+        }
+        order[i].rank = rank;
+        order[i].idx = i;
+    }
+    qsort(order, l, sizeof(layout_rank_t), layout_rank_cmp);
+    {
+        // apply the permutation, then move every id in `serialization_order`
+        // (including string-dedup aliases, which share the canonical entry's
+        // id) to the object's new queue position
+        void **items = (void**)malloc_s(l * sizeof(void*));
+        size_t *newpos = (size_t*)malloc_s(l * sizeof(size_t));
+        for (size_t j = 0; j < l; j++) {
+            items[j] = serialization_queue.items[order[j].idx];
+            newpos[order[j].idx] = j;
+        }
+        memcpy(serialization_queue.items, items, l * sizeof(void*));
+        free(items);
+        for (size_t i = 0; i < serialization_order.size; i += 2) {
+            char *val = (char*)serialization_order.table[i + 1];
+            if (val == (char*)HT_NOTFOUND)
+                continue;
+            uintptr_t idx = (uintptr_t)(val - ((char*)HT_NOTFOUND + 1));
+            if (idx < l) // skip the transient -1/-2 markers, should any remain
+                serialization_order.table[i + 1] = (void*)((char*)HT_NOTFOUND + 1 + newpos[idx]);
+        }
+        free(newpos);
+    }
+done:
+    free(offsets);
+    free(ranks);
+    free(order);
+    fclose(mapf);
+    fclose(proff);
+}
+
 // In addition to the system image (where `worklist = NULL`), this can also save incremental images with external linkage
 static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
                                            jl_array_t *worklist, jl_array_t *extext_methods,
@@ -2575,6 +3368,10 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
     // strip metadata and IR when requested
     if (jl_options.strip_metadata || jl_options.strip_ir)
         jl_strip_all_codeinfos();
+    // recompress the new methods' IR against an adaptive symbol table (no-op
+    // unless JULIA_PKGIMAGE_SYMTAB is set)
+    if (worklist)
+        jl_recompress_all_codeinfos();
 
     int en = jl_gc_enable(0);
     nsym_tag = 0;
@@ -2586,6 +3383,7 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
     }
     htable_new(&serialization_order, 25000);
     htable_new(&nullptrs, 0);
+    htable_new(&string_dedup, 0);
     arraylist_new(&object_worklist, 0);
     arraylist_new(&serialization_queue, 0);
     ios_t sysimg, const_data, symbols, relocs, gvar_record, fptr_record;
@@ -2727,6 +3525,8 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
 
     uint32_t external_fns_begin = 0;
     { // step 2: build all the sysimg sections
+        if (worklist == NULL)
+            jl_reorder_queue_from_profile();
         write_padding(&sysimg, sizeof(uintptr_t));
         jl_write_values(&s);
         external_fns_begin = write_gvars(&s, &gvars, &external_fns);
@@ -2770,9 +3570,14 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
     write_uint(f, const_data.size);
     // realign stream to max-alignment for data
     write_padding(f, LLT_ALIGN(ios_pos(f), JL_CACHE_BYTE_ALIGNMENT) - ios_pos(f));
+    // distance from the image base to the constant data, identical at load time since
+    // `sysimg_offset` is already JL_CACHE_BYTE_ALIGNMENT-aligned
+    size_t const_data_delta = ios_pos(f) - sysimg_offset;
     ios_seek(&const_data, 0);
     ios_copyall(f, &const_data);
     ios_close(&const_data);
+    if (worklist == NULL)
+        jl_write_layout_map(const_data_delta);
 
     write_uint(f, symbols.size);
     write_padding(f, LLT_ALIGN(ios_pos(f), 8) - ios_pos(f));
@@ -2780,14 +3585,27 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
     ios_copyall(f, &symbols);
     ios_close(&symbols);
 
-    // Prepare and write the relocations sections, now that the rest of the image is laid out
+    // Prepare and write the relocations sections, now that the rest of the image is laid out.
+    // Image-internal relocations get prelinked for JL_PRELINK_BASE and recorded in separate
+    // offset lists, so at load time they need (at most) a constant slide instead of decoding.
+    // The tags section thus holds two consecutive lists (prelinked, then tag-encoded), which
+    // `gc_sweep_sysimg` walks in turn.
     char *base = &f->buf[0];
     jl_finish_relocs(base + sysimg_offset, sysimg_size, &s.gctags_list);
     jl_finish_relocs(base + sysimg_offset, sysimg_size, &s.relocs_list);
+    arraylist_t prelink_gctags, prelink_relocs;
+    arraylist_new(&prelink_gctags, 0);
+    arraylist_new(&prelink_relocs, 0);
+    jl_prelink_relocs(base + sysimg_offset, sysimg_size, const_data_delta, &s.gctags_list, &prelink_gctags, GC_OLD | GC_IN_IMAGE);
+    jl_prelink_relocs(base + sysimg_offset, sysimg_size, const_data_delta, &s.relocs_list, &prelink_relocs, 0);
+    jl_write_offsetlist(s.relocs, sysimg_size, &prelink_gctags);
     jl_write_offsetlist(s.relocs, sysimg_size, &s.gctags_list);
     jl_write_offsetlist(s.relocs, sysimg_size, &s.relocs_list);
+    jl_write_offsetlist(s.relocs, sysimg_size, &prelink_relocs);
     jl_write_offsetlist(s.relocs, sysimg_size, &s.memowner_list);
     jl_write_offsetlist(s.relocs, sysimg_size, &s.memref_list);
+    arraylist_free(&prelink_gctags);
+    arraylist_free(&prelink_relocs);
     if (s.incremental) {
         jl_write_arraylist(s.relocs, &s.uniquing_types);
         jl_write_arraylist(s.relocs, &s.uniquing_objs);
@@ -2844,6 +3662,8 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
             jl_write_value(&s, method_roots_list);
             jl_write_value(&s, ext_targets);
             jl_write_value(&s, edges);
+            // the adaptive symbol table the IR above was compressed against
+            jl_write_ir_symtab(f);
         }
         write_uint32(f, jl_array_len(s.link_ids_gctags));
         ios_write(f, (char*)jl_array_data(s.link_ids_gctags, uint32_t), jl_array_len(s.link_ids_gctags) * sizeof(uint32_t));
@@ -2878,6 +3698,7 @@ static void jl_save_system_image_to_stream(ios_t *f, jl_array_t *mod_array,
         htable_free(&external_objects);
     htable_free(&serialization_order);
     htable_free(&nullptrs);
+    htable_free(&string_dedup);
     htable_free(&symbol_table);
     htable_free(&fptr_to_id);
     nsym_tag = 0;
@@ -3059,6 +3880,8 @@ JL_DLLEXPORT void jl_set_sysimg_so(void *handle)
 extern void rebuild_image_blob_tree(void);
 extern void export_jl_small_typeof(void);
 
+static void jl_image_layout_profile_start(const char *base, size_t size);
+
 static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl_array_t *depmods, uint64_t checksum,
                                 /* outputs */    jl_array_t **restored,         jl_array_t **init_order,
                                                  jl_array_t **extext_methods,
@@ -3084,6 +3907,7 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
     arraylist_new(&deser_sym, 0);
 
     // step 1: read section map
+    jl_startup_trace_enter("image deserialize");
     assert(ios_pos(f) == 0 && f->bm == bm_mem);
     size_t sizeof_sysdata = read_uint(f);
     ios_static_buffer(&sysimg, f->buf, sizeof_sysdata + sizeof(uintptr_t));
@@ -3141,6 +3965,7 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
         jl_global_roots_keyset = (jl_genericmemory_t*)jl_read_value(&s);
         // set typeof extra-special values now that we have the type set by tags above
         jl_astaggedvalue(jl_nothing)->header = (uintptr_t)jl_nothing_type | jl_astaggedvalue(jl_nothing)->header;
+        global_roots_filter_rebuild();
         s.ptls->root_task->tls = jl_read_value(&s);
         jl_gc_wb(s.ptls->root_task, s.ptls->root_task->tls);
         jl_init_int32_int64_cache();
@@ -3160,6 +3985,9 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
         offset_method_roots_list = jl_read_offset(&s);
         offset_ext_targets = jl_read_offset(&s);
         offset_edges = jl_read_offset(&s);
+        // register this image's IR symbol table before any of its method
+        // source can be decompressed
+        jl_read_ir_symtab(f);
     }
     s.buildid_depmods_idxs = depmod_to_imageidx(depmods);
     size_t nlinks_gctags = read_uint32(f);
@@ -3195,8 +4023,10 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
         *edges = (jl_array_t*)jl_delayed_reloc(&s, offset_edges);
     }
     s.s = NULL;
+    jl_startup_trace_exit("image deserialize");
 
     // step 3: apply relocations
+    jl_startup_trace_enter("image relocations");
     assert(!ios_eof(f));
     jl_read_symbols(&s);
     ios_close(&symbols);
@@ -3207,10 +4037,16 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
         *base = image_base;
 
     s.s = &sysimg;
+    // distance between the preferred base the image was prelinked for and where it
+    // actually got mapped; the low bits of the gc tag words must survive the slide
+    intptr_t slide = (intptr_t)((uintptr_t)image_base - JL_PRELINK_BASE);
+    assert(((uintptr_t)slide & 15) == 0);
+    jl_read_prelinklist(&s, slide); // prelinked gctags
     jl_read_reloclist(&s, s.link_ids_gctags, GC_OLD | GC_IN_IMAGE); // gctags
     size_t sizeof_tags = ios_pos(&relocs);
     (void)sizeof_tags;
     jl_read_reloclist(&s, s.link_ids_relocs, 0); // general relocs
+    jl_read_prelinklist(&s, slide); // prelinked image-internal relocs
     jl_read_memreflist(&s); // memowner_list relocs (must come before memref_list reads the pointers and after general relocs computes the pointers)
     jl_read_memreflist(&s); // memref_list relocs
     // s.link_ids_gvars will be processed in `jl_update_all_gvars`
@@ -3531,13 +4367,16 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
         cachesizes->fptrlist = sizeof_fptr_record;
     }
 
+    jl_startup_trace_exit("image relocations");
     s.s = &sysimg;
+    jl_startup_trace_enter("image fptrs");
     jl_update_all_fptrs(&s, image); // fptr relocs and registration
     if (!ccallable_list) {
         // TODO: jl_sysimg_handle or img_handle?
         jl_reinit_ccallable(&s.ccallable_list, image_base, jl_sysimg_handle);
         arraylist_free(&s.ccallable_list);
     }
+    jl_startup_trace_exit("image fptrs");
     s.s = NULL;
 
     ios_close(&fptr_record);
@@ -3554,6 +4393,8 @@ static void jl_restore_system_image_from_stream_(ios_t *f, jl_image_t *image, jl
     arraylist_push(&jl_image_relocs, (void*)relocs_base);
     jl_timing_counter_inc(JL_TIMING_COUNTER_ImageSize, sizeof_sysimg + sizeof(uintptr_t));
     rebuild_image_blob_tree();
+    if (!s.incremental)
+        jl_image_layout_profile_start(image_base, sizeof_sysimg);
 
     // jl_printf(JL_STDOUT, "%ld blobs to link against\n", jl_linkage_blobs.len >> 1);
     jl_gc_enable(en);
@@ -3599,6 +4440,7 @@ static jl_value_t *jl_restore_package_image_from_stream(void* pkgimage_handle, i
         return verify_fail;
 
     assert(datastartpos > 0 && datastartpos < dataendpos);
+    jl_startup_trace_enter(pkgname ? pkgname : "<unknown pkgimage>");
     needs_permalloc = jl_options.permalloc_pkgimg || needs_permalloc;
     jl_value_t *restored = NULL;
     jl_array_t *init_order = NULL, *extext_methods = NULL, *new_ext_cis = NULL, *method_roots_list = NULL, *ext_targets = NULL, *edges = NULL;
@@ -3614,8 +4456,20 @@ static jl_value_t *jl_restore_package_image_from_stream(void* pkgimage_handle, i
         char *sysimg;
         int success = !needs_permalloc;
         ios_seek(f, datastartpos);
-        if (needs_permalloc)
+        if (needs_permalloc) {
+#ifdef _OS_WINDOWS_
             sysimg = (char*)jl_gc_perm_alloc(len, 0, 64, 0);
+#else
+            // try to place the copy at the preferred base, so that the prelinked
+            // relocations already hold their final values; this is only a hint, and
+            // any other (page-aligned) placement takes the constant-slide path in
+            // jl_read_prelinklist instead
+            sysimg = (char*)mmap((void*)JL_PRELINK_BASE, len, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (sysimg == MAP_FAILED)
+                sysimg = (char*)jl_gc_perm_alloc(len, 0, 64, 0);
+#endif
+        }
         else
             sysimg = &f->buf[f->bpos];
         if (needs_permalloc)
@@ -3664,6 +4518,7 @@ static jl_value_t *jl_restore_package_image_from_stream(void* pkgimage_handle, i
         }
     }
 
+    jl_startup_trace_exit(pkgname ? pkgname : "<unknown pkgimage>");
     JL_GC_POP();
     return restored;
 }
@@ -3696,6 +4551,275 @@ JL_DLLEXPORT jl_value_t *jl_restore_incremental(const char *fname, jl_array_t *d
     return ret;
 }
 
+// Apply an incremental cache file as a patch on top of the restored system image.
+// The patch is an ordinary incremental image (as written by `jl_save_incremental`)
+// built with no image dependencies beyond the system image itself; it layers its
+// delta (new modules, methods and type instantiations, plus the resulting
+// invalidations) over the running image, which is much cheaper than rebuilding the
+// system image. Any new module initializers are queued to run with the rest of the
+// image's init order. Returns the restored worklist, or an exception object on
+// failure (like `jl_restore_incremental`).
+JL_DLLEXPORT jl_value_t *jl_apply_system_image_patch(const char *fname)
+{
+    jl_array_t *depmods = jl_alloc_vec_any(0);
+    jl_value_t *ret = NULL;
+    JL_GC_PUSH2(&depmods, &ret);
+    ret = jl_restore_incremental(fname, depmods, 0, fname);
+    if (jl_is_svec(ret)) {
+        jl_array_t *init_order = (jl_array_t*)jl_svecref(ret, 1);
+        if (init_order != NULL && (jl_value_t*)init_order != jl_nothing &&
+                jl_array_nrows(init_order) > 0) {
+            // run these with the other image initializers (see _finish_julia_init)
+            if (jl_module_init_order == NULL)
+                jl_module_init_order = jl_alloc_vec_any(0);
+            jl_array_ptr_1d_append(jl_module_init_order, init_order);
+        }
+    }
+    JL_GC_POP();
+    return ret;
+}
+
+// Layer the patch images listed in JULIA_SYSIMAGE_PATCHES (a path-list in load-order)
+// over the freshly restored system image, so that rebuilding the image itself is not
+// needed to pick up a delta to one of its packages.
+static void jl_apply_system_image_patches(void)
+{
+    char *list = getenv("JULIA_SYSIMAGE_PATCHES");
+    if (!list || !*list)
+        return;
+#ifdef _OS_WINDOWS_
+    char sep = ';';
+#else
+    char sep = ':';
+#endif
+    char *copy = strdup(list);
+    char *path = copy;
+    while (path) {
+        char *next = strchr(path, sep);
+        if (next)
+            *next++ = '\0';
+        if (*path) {
+            jl_value_t *ret = jl_apply_system_image_patch(path);
+            if (!jl_is_svec(ret)) {
+                jl_printf(JL_STDERR, "ERROR: failed to apply system image patch \"%s\":\n", path);
+                jl_static_show(JL_STDERR, ret);
+                jl_printf(JL_STDERR, "\n");
+                jl_exit(1);
+            }
+        }
+        path = next;
+    }
+    free(copy);
+}
+
+#ifndef _OS_WINDOWS_
+typedef struct {
+    const char *base;
+    size_t size;
+} jl_image_prefault_work_t;
+
+static void jl_image_prefault_threadfun(void *arg)
+{
+    jl_image_prefault_work_t *work = (jl_image_prefault_work_t*)arg;
+    size_t psz = jl_page_size ? jl_page_size : (size_t)jl_getpagesize();
+    uintptr_t start = (uintptr_t)work->base & ~(uintptr_t)(psz - 1);
+    size_t size = work->size + ((uintptr_t)work->base - start);
+#ifdef MADV_WILLNEED
+    madvise((void*)start, size, MADV_WILLNEED);
+#endif
+    // touch one byte per page in layout order, so the pages the restore (and the
+    // checksum pass before it) will want first tend to arrive first; the loads may
+    // race with relocation stores from the restoring thread, but the values read
+    // are discarded
+    size_t sum = 0;
+    for (size_t off = 0; off < size; off += psz)
+        sum += ((const volatile char*)start)[off];
+    (void)sum;
+    free(work);
+}
+#endif
+
+// Training half of the profile-guided image layout (see the comment above
+// jl_write_layout_map): with JULIA_IMAGE_LAYOUT_PROFILE_OUT set, a background
+// thread samples mincore(2) over the sysimage data section about once per
+// millisecond and records, per page, the sample index at which it first became
+// resident; jl_image_layout_profile_write dumps the ranks at process exit.
+// Pages the relocation pass writes are resident from the first sample onward,
+// so the ordering within the restore itself is coarse, but the profile still
+// separates everything the workload touched from the pages it never needed
+// and ranks the later faults by time.
+#ifndef _OS_WINDOWS_
+#define LAYOUT_PROFILE_MAX_SAMPLES 30000 // ~30s; steady state long before this
+
+static struct {
+    const char *base; // page aligned
+    size_t lead;      // image offset 0 relative to `base`
+    size_t npages;
+    size_t psz;
+    uint32_t *ranks;  // 0 = never seen resident
+    _Atomic(int) stop;
+} layout_profile;
+
+static void jl_image_layout_profile_threadfun(void *arg)
+{
+    (void)arg;
+    char *vec = (char*)malloc_s(layout_profile.npages);
+    for (uint32_t sample = 1; sample <= LAYOUT_PROFILE_MAX_SAMPLES; sample++) {
+        if (jl_atomic_load_relaxed(&layout_profile.stop))
+            break;
+        if (mincore((void*)layout_profile.base, layout_profile.npages * layout_profile.psz,
+                    (unsigned char*)vec))
+            break;
+        for (size_t i = 0; i < layout_profile.npages; i++)
+            if (layout_profile.ranks[i] == 0 && (vec[i] & 1))
+                layout_profile.ranks[i] = sample;
+        uv_sleep(1);
+    }
+    free(vec);
+}
+#endif
+
+static void jl_image_layout_profile_start(const char *base, size_t size)
+{
+#ifndef _OS_WINDOWS_
+    const char *path = getenv("JULIA_IMAGE_LAYOUT_PROFILE_OUT");
+    if (path == NULL || path[0] == '\0' || size == 0 || layout_profile.ranks != NULL)
+        return;
+    size_t psz = jl_page_size ? jl_page_size : (size_t)jl_getpagesize();
+    uintptr_t start = (uintptr_t)base & ~(uintptr_t)(psz - 1);
+    layout_profile.psz = psz;
+    layout_profile.base = (const char*)start;
+    layout_profile.lead = (uintptr_t)base - start;
+    layout_profile.npages = (size + layout_profile.lead + psz - 1) / psz;
+    layout_profile.ranks = (uint32_t*)calloc_s(layout_profile.npages * sizeof(uint32_t));
+    uv_thread_t thread;
+    if (uv_thread_create(&thread, jl_image_layout_profile_threadfun, NULL)) {
+        free(layout_profile.ranks);
+        layout_profile.ranks = NULL;
+    }
+#else
+    (void)base;
+    (void)size;
+#endif
+}
+
+void jl_image_layout_profile_write(void)
+{
+#ifndef _OS_WINDOWS_
+    if (layout_profile.ranks == NULL)
+        return;
+    jl_atomic_store_release(&layout_profile.stop, 1);
+    const char *path = getenv("JULIA_IMAGE_LAYOUT_PROFILE_OUT");
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        jl_printf(JL_STDERR, "WARNING: could not write image layout profile \"%s\"\n", path);
+        return;
+    }
+    // the sampler may still be storing ranks; those races are benign (each
+    // slot is written at most once, and a torn read mis-ranks a single page)
+    uint64_t header[4] = {LAYOUT_PROFILE_MAGIC, layout_profile.psz,
+                          layout_profile.lead, layout_profile.npages};
+    fwrite(header, sizeof(uint64_t), 4, fp);
+    fwrite(layout_profile.ranks, sizeof(uint32_t), layout_profile.npages, fp);
+    fclose(fp);
+#endif
+}
+
+#ifdef _OS_LINUX_
+// Matches cgmemmgr.cpp, which makes the same request for JIT code mappings.
+#define SYSIMG_HUGE_PAGE_SIZE ((uintptr_t)(2 * 1024 * 1024))
+
+typedef struct {
+    uintptr_t addr; // in: an address inside the segment to find
+    uintptr_t start; // out: segment bounds
+    uintptr_t end;
+} sysimg_text_range_t;
+
+static int sysimg_text_phdr_cb(struct dl_phdr_info *info, size_t size, void *data)
+{
+    sysimg_text_range_t *range = (sysimg_text_range_t*)data;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr) *ph = &info->dlpi_phdr[i];
+        if (ph->p_type != PT_LOAD || !(ph->p_flags & PF_X))
+            continue;
+        uintptr_t start = info->dlpi_addr + ph->p_vaddr;
+        uintptr_t end = start + ph->p_memsz;
+        if (range->addr >= start && range->addr < end) {
+            range->start = start;
+            range->end = end;
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+// Ask the kernel to back the sysimage's executable segment with 2MB pages.
+// The loader maps the sysimage shared object with 4K pages, so the tens of MB
+// of precompiled code it contains occupy thousands of iTLB entries; the JIT
+// already requests huge pages for its own code mappings (cgmemmgr.cpp), and
+// sysimage code deserves the same. MADV_HUGEPAGE lets khugepaged collapse the
+// range in the background (for file-backed text this needs a kernel with
+// READ_ONLY_THP_FOR_FS); MADV_COLLAPSE (6.1+) collapses it synchronously and
+// is simply refused by older kernels. Both are best-effort hints, so failures
+// are ignored; JULIA_SYSIMAGE_HUGEPAGES=0 opts out entirely.
+static void jl_sysimg_text_hugepages(const void *inside)
+{
+#ifdef _OS_LINUX_
+#ifdef MADV_HUGEPAGE
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25
+#endif
+    static int enabled = -1;
+    if (enabled == -1) {
+        char *env = getenv("JULIA_SYSIMAGE_HUGEPAGES");
+        enabled = !env || !env[0] || strcmp(env, "0");
+    }
+    if (!enabled)
+        return;
+    sysimg_text_range_t range = {(uintptr_t)inside, 0, 0};
+    if (!dl_iterate_phdr(sysimg_text_phdr_cb, &range))
+        return;
+    // only the 2MB-aligned interior of the segment can use huge pages
+    uintptr_t start = LLT_ALIGN(range.start, SYSIMG_HUGE_PAGE_SIZE);
+    uintptr_t end = range.end & ~(SYSIMG_HUGE_PAGE_SIZE - 1);
+    if (end <= start)
+        return;
+    madvise((void*)start, end - start, MADV_HUGEPAGE);
+    madvise((void*)start, end - start, MADV_COLLAPSE);
+#endif
+#else
+    (void)inside;
+#endif
+}
+
+// Optionally (JULIA_IMAGE_PREFAULT) kick off a background thread paging in a freshly
+// mapped image, overlapping the demand faults with checksumming and restoring it.
+// Without this, a large mmapped image faults its pages one at a time from the middle
+// of startup-critical code. Only called for mappings that live until process exit,
+// since the thread is left to finish on its own.
+static void jl_image_prefault(const char *base, size_t size)
+{
+#ifndef _OS_WINDOWS_
+    static int enabled = -1;
+    if (enabled == -1) {
+        char *env = getenv("JULIA_IMAGE_PREFAULT");
+        enabled = env && env[0] && strcmp(env, "0");
+    }
+    if (!enabled || size == 0)
+        return;
+    jl_image_prefault_work_t *work = (jl_image_prefault_work_t*)malloc_s(sizeof(jl_image_prefault_work_t));
+    work->base = base;
+    work->size = size;
+    uv_thread_t thread;
+    if (uv_thread_create(&thread, jl_image_prefault_threadfun, work))
+        free(work); // no thread, no prefault; the pages fault on demand as before
+#else
+    (void)base;
+    (void)size;
+#endif
+}
+
 // TODO: need to enforce that the alignment of the buffer is suitable for vectors
 JL_DLLEXPORT void jl_restore_system_image(const char *fname)
 {
@@ -3728,19 +4852,28 @@ JL_DLLEXPORT void jl_restore_system_image(const char *fname)
         ios_close(&f);
         JL_SIGATOMIC_END();
     }
+    jl_apply_system_image_patches();
 }
 
-JL_DLLEXPORT void jl_restore_system_image_data(const char *buf, size_t len)
+static void jl_restore_system_image_data_(const char *buf, size_t len, const uint32_t *checksum)
 {
     ios_t f;
     JL_SIGATOMIC_BEGIN();
+    jl_image_prefault(buf, len);
     ios_static_buffer(&f, (char*)buf, len);
-    uint32_t checksum = jl_crc32c(0, buf, len);
-    jl_restore_system_image_from_stream(&f, &sysimage, checksum);
+    // images built with a jl_system_image_checksum symbol save a full scan of
+    // the image here; it is only used to derive the build id
+    uint32_t crc = checksum != NULL ? *checksum : jl_crc32c(0, buf, len);
+    jl_restore_system_image_from_stream(&f, &sysimage, crc);
     ios_close(&f);
     JL_SIGATOMIC_END();
 }
 
+JL_DLLEXPORT void jl_restore_system_image_data(const char *buf, size_t len)
+{
+    jl_restore_system_image_data_(buf, len, NULL);
+}
+
 JL_DLLEXPORT jl_value_t *jl_restore_package_image_from_file(const char *fname, jl_array_t *depmods, int completeinfo, const char *pkgname, int ignore_native)
 {
     void *pkgimg_handle = jl_dlopen(fname, JL_RTLD_LAZY);
@@ -3759,10 +4892,23 @@ JL_DLLEXPORT jl_value_t *jl_restore_package_image_from_file(const char *fname, j
     jl_dlsym(pkgimg_handle, "jl_system_image_data", (void **)&pkgimg_data, 1);
     size_t *plen;
     jl_dlsym(pkgimg_handle, "jl_system_image_size", (void **)&plen, 1);
+    jl_image_prefault(pkgimg_data, *plen);
 
     jl_image_t pkgimage = jl_init_processor_pkgimg(pkgimg_handle);
 
-    if (ignore_native){
+    // When host specialization is requested, drop the image's precompiled
+    // multiversioned clones so that code is JIT-compiled for the exact local
+    // CPU on first use instead. This is meant to be combined with baseline-only
+    // package images (JULIA_CPU_TARGET=generic) and the per-host on-disk JIT
+    // cache (JULIA_JIT_CACHE_PATH), which amortizes the recompilation across
+    // runs while keeping the images themselves small and target-agnostic.
+    static int host_specialize = -1;
+    if (host_specialize == -1) {
+        char *hs = getenv("JULIA_PKGIMAGE_HOST_SPECIALIZE");
+        host_specialize = hs && hs[0] && strcmp(hs, "0");
+    }
+
+    if (ignore_native || host_specialize) {
         memset(&pkgimage.fptrs, 0, sizeof(pkgimage.fptrs));
     }
 
@@ -830,15 +830,17 @@ static int64_t write_dependency_list(ios_t *s, jl_array_t* worklist, jl_array_t
 // Add methods to external (non-worklist-owned) functions
 static void jl_insert_methods(jl_array_t *list)
 {
+#ifndef NDEBUG
     size_t i, l = jl_array_nrows(list);
     for (i = 0; i < l; i++) {
         jl_method_t *meth = (jl_method_t*)jl_array_ptr_ref(list, i);
         assert(jl_is_method(meth));
         assert(!meth->is_for_opaque_closure);
-        jl_methtable_t *mt = jl_method_get_table(meth);
-        assert((jl_value_t*)mt != jl_nothing);
-        jl_method_table_insert(mt, meth, NULL);
     }
+#endif
+    // the whole list shares the world assigned during deserialization, so
+    // this performs at most one additional world bump
+    jl_method_table_batch_insert(list);
 }
 
 static void jl_copy_roots(jl_array_t *method_roots_list, uint64_t key)
@@ -855,6 +857,10 @@ static void jl_copy_roots(jl_array_t *method_roots_list, uint64_t key)
 }
 
 
+// number of expected methods for one edge above which membership is tested through a
+// hash table instead of a linear scan (see `jl_verify_edges`)
+#define VERIFY_EXPECTED_HASH_THRESHOLD 16
+
 // verify that these edges intersect with the same methods as before
 static jl_array_t *jl_verify_edges(jl_array_t *targets, size_t minworld)
 {
@@ -868,6 +874,15 @@ static jl_array_t *jl_verify_edges(jl_array_t *targets, size_t minworld)
     jl_value_t *loctag = NULL;
     jl_value_t *matches = NULL;
     jl_value_t *sig = NULL;
+    // Index of already-verified invoke targets, keyed by invoke signature. The
+    // serializer dedups targets by object identity, but signatures that were distinct
+    // (merely egal) objects in the build session are interned to one object when the
+    // image is restored, so repeats of the same invoke lookup can surface here; each
+    // one is then a table hit instead of a dispatch query.
+    htable_t invoke_seen;
+    htable_new(&invoke_seen, 0);
+    htable_t expected_set;
+    htable_new(&expected_set, 0);
     JL_GC_PUSH4(&maxvalids, &matches, &sig, &loctag);
     for (i = 0; i < l; i++) {
         jl_value_t *invokesig = jl_array_ptr_ref(targets, i * 3);
@@ -878,6 +893,19 @@ static jl_array_t *jl_verify_edges(jl_array_t *targets, size_t minworld)
         if (invokesig) {
             assert(callee && "unsupported edge");
             jl_method_t *m = ((jl_method_instance_t*)callee)->def.method;
+            void **seen = ptrhash_bp(&invoke_seen, (void*)invokesig);
+            if (*seen != HT_NOTFOUND) {
+                size_t previ = (char*)*seen - 1 - (char*)HT_NOTFOUND;
+                // an invoke edge is determined by its signature and the method it
+                // expects, and `expected` (== the Method) is pointer-comparable
+                if (jl_array_ptr_ref(targets, previ * 3 + 2) == expected) {
+                    jl_array_data(maxvalids, size_t)[i] = jl_array_data(maxvalids, size_t)[previ];
+                    continue;
+                }
+            }
+            else {
+                *seen = (void*)((char*)HT_NOTFOUND + 1 + i);
+            }
             if (jl_egal(invokesig, m->sig)) {
                 // the invoke match is `m` for `m->sig`, unless `m` is invalid
                 if (m->deleted_world < max_valid)
@@ -924,24 +952,40 @@ static jl_array_t *jl_verify_edges(jl_array_t *targets, size_t minworld)
             else {
                 // setdiff!(matches, expected)
                 size_t j, k, ins = 0;
-                if (jl_array_nrows(matches) != jl_array_nrows(expected)) {
+                size_t l = jl_array_nrows(expected);
+                if (jl_array_nrows(matches) != l) {
                     max_valid = 0;
                 }
+                // for long lists, test membership through a hash of the expected
+                // methods instead of rescanning the list for every match
+                int hashed = l > VERIFY_EXPECTED_HASH_THRESHOLD;
+                if (hashed) {
+                    htable_reset(&expected_set, l);
+                    for (j = 0; j < l; j++) {
+                        void *exp = (void*)jl_array_ptr_ref(expected, j);
+                        ptrhash_put(&expected_set, exp, exp);
+                    }
+                }
                 for (k = 0; k < jl_array_nrows(matches); k++) {
                     jl_method_t *match = ((jl_method_match_t*)jl_array_ptr_ref(matches, k))->method;
-                    size_t l = jl_array_nrows(expected);
-                    for (j = 0; j < l; j++)
-                        if (match == (jl_method_t*)jl_array_ptr_ref(expected, j))
-                            break;
-                    if (j == l) {
-                        // intersection has a new method or a method was
-                        // deleted--this is now probably no good, just invalidate
-                        // everything about it now
-                        max_valid = 0;
-                        if (!_jl_debug_method_invalidation)
-                            break;
-                        jl_array_ptr_set(matches, ins++, match);
+                    if (hashed) {
+                        if (ptrhash_get(&expected_set, match) != HT_NOTFOUND)
+                            continue;
                     }
+                    else {
+                        for (j = 0; j < l; j++)
+                            if (match == (jl_method_t*)jl_array_ptr_ref(expected, j))
+                                break;
+                        if (j != l)
+                            continue;
+                    }
+                    // intersection has a new method or a method was
+                    // deleted--this is now probably no good, just invalidate
+                    // everything about it now
+                    max_valid = 0;
+                    if (!_jl_debug_method_invalidation)
+                        break;
+                    jl_array_ptr_set(matches, ins++, match);
                 }
                 if (max_valid != ~(size_t)0 && _jl_debug_method_invalidation)
                     jl_array_del_end((jl_array_t*)matches, jl_array_nrows(matches) - ins);
@@ -960,6 +1004,8 @@ static jl_array_t *jl_verify_edges(jl_array_t *targets, size_t minworld)
         //jl_static_show((JL_STREAM*)ios_stderr, (jl_value_t*)callee);
         //ios_puts(valid ? "valid\n" : "INVALID\n", ios_stderr);
     }
+    htable_free(&invoke_seen);
+    htable_free(&expected_set);
     JL_GC_POP();
     return maxvalids;
 }
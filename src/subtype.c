@@ -2062,6 +2062,14 @@ JL_DLLEXPORT int jl_obvious_subtype(jl_value_t *x, jl_value_t *y, int *subtype)
     return obvious_subtype(x, y, y, subtype);
 }
 
+// Memoized verdicts of subtype queries over closed (typevar-free) types.
+// Such types are immutable, so a cached result never needs invalidation; the
+// table only has to be scanned as part of the GC root set (see gc_mark_roots)
+// so that a slot can never point into recycled memory. Each slot holds a
+// single svec of (x, y, result), so a racing reader either sees the whole
+// triple or none of it.
+_Atomic(jl_svec_t*) subtype_cache[N_SUBTYPE_CACHE] JL_GLOBALLY_ROOTED;
+
 // `env` is NULL if no typevar information is requested, or otherwise
 // points to a rooted array of length `jl_subtype_env_size(y)`.
 // This will be populated with the values of variables from unionall
@@ -2086,6 +2094,13 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
         }
         return 1;
     }
+    int memo_idx = -1;
+    if (envsz == 0 && !jl_has_free_typevars(x) && !jl_has_free_typevars(y)) {
+        memo_idx = jl_int32hash_fast((uint32_t)((uintptr_t)x ^ ((uintptr_t)y >> 3))) & (N_SUBTYPE_CACHE - 1);
+        jl_svec_t *memo = jl_atomic_load_acquire(&subtype_cache[memo_idx]);
+        if (memo != NULL && jl_svecref(memo, 0) == x && jl_svecref(memo, 1) == y)
+            return jl_svecref(memo, 2) == jl_true;
+    }
     int obvious_subtype = 2;
     if (jl_obvious_subtype(x, y, &obvious_subtype)) {
 #ifdef NDEBUG
@@ -2105,6 +2120,11 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
     if (obvious_subtype == 0 || (obvious_subtype == 1 && envsz == 0))
         subtype = obvious_subtype; // this ensures that running in a debugger doesn't change the result
 #endif
+    if (memo_idx >= 0) {
+        // only queries that had to run the solver are worth remembering
+        jl_svec_t *memo = jl_svec(3, x, y, subtype ? jl_true : jl_false);
+        jl_atomic_store_release(&subtype_cache[memo_idx], memo);
+    }
     if (env) {
         jl_unionall_t *ub = (jl_unionall_t*)y;
         int i;
@@ -2345,6 +2365,28 @@ JL_DLLEXPORT int jl_isa(jl_value_t *x, jl_value_t *t)
     }
     if (jl_is_concrete_type(t))
         return 0;
+    if (jl_is_datatype(t)) {
+        // nominal fast path: `typeof(x)` is concrete and fully instantiated,
+        // so if `t` is a closed datatype of a nominally-subtyped family, the
+        // relation holds exactly when `t` appears on the (interned) supertype
+        // chain of `typeof(x)`; pointer equality along that chain then
+        // replaces the subtype solver. Covariant families (tuples and named
+        // tuples) and Type{...} don't follow the nominal rule and fall
+        // through to the general test below.
+        jl_datatype_t *dt = (jl_datatype_t*)t;
+        if (!dt->hasfreetypevars && dt->name != jl_tuple_typename &&
+            dt->name != jl_namedtuple_typename && dt->name != jl_type_typename) {
+            jl_datatype_t *s = (jl_datatype_t*)jl_typeof(x);
+            if (s->name != jl_tuple_typename && s->name != jl_namedtuple_typename) {
+                while (s != jl_any_type && s != NULL) {
+                    if (s == dt)
+                        return 1;
+                    s = s->super;
+                }
+                return 0;
+            }
+        }
+    }
     return jl_subtype(jl_typeof(x), t);
 }
 
@@ -4078,6 +4120,26 @@ static jl_value_t *intersect_types(jl_value_t *x, jl_value_t *y, int emptiness_o
     return intersect_all(x, y, &e);
 }
 
+// Memoized intersections of closed type pairs, in the style of subtype_cache
+// above: method signatures are interned, so the same pairs come up again and
+// again during method insertion and invalidation analysis, and the results
+// (being pure type algebra) never change. Slots are svec(a, b, ti, issubty).
+_Atomic(jl_svec_t*) intersect_cache[N_INTERSECT_CACHE] JL_GLOBALLY_ROOTED;
+
+// look up the memoized intersection of (a, b), also reporting the slot the
+// pair hashes to (or -1 if the pair is not eligible for caching)
+static jl_svec_t *lookup_intersect_memo(jl_value_t *a, jl_value_t *b, int *idx)
+{
+    *idx = -1;
+    if (jl_has_free_typevars(a) || jl_has_free_typevars(b))
+        return NULL;
+    *idx = jl_int32hash_fast((uint32_t)((uintptr_t)a ^ ((uintptr_t)b >> 3))) & (N_INTERSECT_CACHE - 1);
+    jl_svec_t *memo = jl_atomic_load_acquire(&intersect_cache[*idx]);
+    if (memo != NULL && jl_svecref(memo, 0) == a && jl_svecref(memo, 1) == b)
+        return memo;
+    return NULL;
+}
+
 JL_DLLEXPORT jl_value_t *jl_intersect_types(jl_value_t *x, jl_value_t *y)
 {
     return intersect_types(x, y, 0);
@@ -4086,6 +4148,10 @@ JL_DLLEXPORT jl_value_t *jl_intersect_types(jl_value_t *x, jl_value_t *y)
 // TODO: this can probably be done more efficiently
 JL_DLLEXPORT int jl_has_empty_intersection(jl_value_t *x, jl_value_t *y)
 {
+    int memo_idx;
+    jl_svec_t *memo = lookup_intersect_memo(x, y, &memo_idx);
+    if (memo != NULL)
+        return jl_svecref(memo, 2) == jl_bottom_type;
     return intersect_types(x, y, 1) == jl_bottom_type;
 }
 
@@ -4220,6 +4286,16 @@ jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t *
         if (issubty && a == jl_bottom_type) *issubty = 1;
         return jl_bottom_type;
     }
+    int memo_idx = -1;
+    int memo_subty = 0;
+    if (penv == NULL) {
+        jl_svec_t *memo = lookup_intersect_memo(a, b, &memo_idx);
+        if (memo != NULL) {
+            if (issubty)
+                *issubty = jl_svecref(memo, 3) == jl_true;
+            return jl_svecref(memo, 2);
+        }
+    }
     int szb = jl_subtype_env_size(b);
     int sz = 0, i = 0;
     jl_value_t **env, **ans;
@@ -4230,6 +4306,7 @@ jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t *
     int ltb = jl_is_concrete_type(b);
     if (jl_subtype_env(a, b, env, szb)) {
         *ans = a; sz = szb;
+        memo_subty = 1;
         if (issubty) *issubty = 1;
     }
     // else if (lta && ltb) { // !jl_type_equality_is_identity known in this case because obviously_disjoint returned false
@@ -4301,6 +4378,10 @@ jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t *
         *penv = e;
     }
  bot:
+    if (memo_idx >= 0) {
+        jl_svec_t *memo = jl_svec(4, a, b, *ans, memo_subty ? jl_true : jl_false);
+        jl_atomic_store_release(&intersect_cache[memo_idx], memo);
+    }
     JL_GC_POP();
     return *ans;
 }
@@ -5115,11 +5196,32 @@ JL_DLLEXPORT int jl_type_morespecific(jl_value_t *a, jl_value_t *b)
         return 0;
     if (jl_has_free_typevars(a) || jl_has_free_typevars(b))
         return 0;
+    // Method insertion compares the new signature against every method
+    // already in the table and repeats many of the same pairs on every
+    // insertion, so memoize verdicts by pointer identity. Specificity is
+    // purely structural, so an entry stays valid as long as both keys are
+    // alive, which the GC guarantees by scanning the cache as roots.
+    jl_ptls_t ptls = jl_get_pgcstack() == NULL ? NULL : jl_current_task->ptls;
+    size_t slot = 0;
+    if (ptls != NULL) {
+        slot = ((((uintptr_t)a) / sizeof(void*)) ^
+                (((uintptr_t)b) / sizeof(void*) * 0x9e3779b9u)) % JL_MORESPEC_CACHE_SLOTS;
+        if (ptls->morespec_cache[slot].a == a && ptls->morespec_cache[slot].b == b)
+            return ptls->morespec_cache[slot].result;
+    }
+    int result;
     if (jl_subtype(b, a))
-        return 0;
-    if (jl_subtype(a, b))
-        return 1;
-    return type_morespecific_(a, b, a, b, 0, NULL);
+        result = 0;
+    else if (jl_subtype(a, b))
+        result = 1;
+    else
+        result = type_morespecific_(a, b, a, b, 0, NULL);
+    if (ptls != NULL) {
+        ptls->morespec_cache[slot].a = a;
+        ptls->morespec_cache[slot].b = b;
+        ptls->morespec_cache[slot].result = (uint8_t)result;
+    }
+    return result;
 }
 
 JL_DLLEXPORT int jl_type_morespecific_no_subtype(jl_value_t *a, jl_value_t *b)
@@ -33,6 +33,12 @@
 
 #define MOST_OF(x) ((x) - ((x)>>4))
 
+// kernel readahead hints for streams put in sequential-scan mode by
+// ios_readahead (see _fd_prefetch below)
+#if !defined(_OS_WINDOWS_) && defined(POSIX_FADV_WILLNEED)
+#define IOS_HAVE_FADVISE
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -142,6 +148,22 @@ static int _os_read_all(long fd, void *buf, size_t n, size_t *nread)
     return 0;
 }
 
+// after a buffer refill on a stream in sequential-scan mode, ask the kernel
+// to start reading the next buffer-sized chunk in the background, so it is
+// already in the page cache when the caller finishes parsing this one
+static void _fd_prefetch(ios_t *s)
+{
+#ifdef IOS_HAVE_FADVISE
+    if (!s->prefetch)
+        return;
+    int64_t pos = lseek((int)s->fd, 0, SEEK_CUR);
+    if (pos >= 0)
+        posix_fadvise((int)s->fd, pos, s->maxsize, POSIX_FADV_WILLNEED);
+#else
+    (void)s;
+#endif
+}
+
 static int _os_write(long fd, const void *buf, size_t n, size_t *nwritten)
 {
     ssize_t r;
@@ -323,6 +345,7 @@ static size_t _ios_read(ios_t *s, char *dest, size_t n, int all)
                 return tot;
             }
             s->size = got;
+            _fd_prefetch(s);
         }
         didread = 1;
     }
@@ -369,6 +392,8 @@ size_t ios_readprep(ios_t *s, size_t n)
     if (result)
         return space;
     s->size += got;
+    if (got > 0)
+        _fd_prefetch(s);
     return (size_t)(s->size - s->bpos);
 }
 
@@ -775,6 +800,23 @@ int ios_setbuf(ios_t *s, char *buf, size_t size, int own)
     return 0;
 }
 
+// Put a readable file stream into sequential-scan mode: grow its buffer to
+// bufsize bytes (if that is larger than the current buffer) and hint the
+// kernel to read ahead aggressively, prefetching the next buffer-sized chunk
+// whenever the buffer is refilled. Returns 0 on success.
+int ios_readahead(ios_t *s, size_t bufsize)
+{
+    if (s->bm == bm_mem || s->fd == -1 || !s->readable)
+        return -1;
+    if (bufsize > (size_t)s->maxsize && _buf_realloc(s, bufsize) == NULL)
+        return -1;
+#ifdef IOS_HAVE_FADVISE
+    posix_fadvise((int)s->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    s->prefetch = 1;
+#endif
+    return 0;
+}
+
 int ios_bufmode(ios_t *s, bufmode_t mode)
 {
     // no fd; can only do mem-only buffering
@@ -906,6 +948,7 @@ static void _ios_init(ios_t *s)
     s->writable = 1;
     s->rereadable = 0;
     s->growable = 1;
+    s->prefetch = 0;
 }
 
 /* stream object initializers. we do no allocation. */
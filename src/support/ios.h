@@ -78,6 +78,10 @@ JL_ATTRIBUTE_ALIGN_PTRSIZE(typedef struct {
     // attempting to write beyond its current maxsize.
     unsigned char growable:1;
 
+    // sequential-scan mode (see ios_readahead): prefetch the next chunk of
+    // the file whenever the buffer is refilled.
+    unsigned char prefetch:1;
+
     char local[IOS_INLSIZE];
 } ios_t);
 
@@ -102,6 +106,8 @@ JL_DLLEXPORT int ios_isopen(ios_t *s);
 JL_DLLEXPORT char *ios_take_buffer(ios_t *s, size_t *psize);  // nul terminate and release buffer to caller
 // set buffer space to use
 JL_DLLEXPORT int ios_setbuf(ios_t *s, char *buf, size_t size, int own) JL_NOTSAFEPOINT;
+// grow the buffer to at least bufsize bytes and hint the kernel to read ahead
+JL_DLLEXPORT int ios_readahead(ios_t *s, size_t bufsize) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int ios_bufmode(ios_t *s, bufmode_t mode) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int ios_get_readable(ios_t *s);
 JL_DLLEXPORT int ios_get_writable(ios_t *s);
@@ -15,7 +15,21 @@
 extern "C" {
 #endif
 
-static _Atomic(jl_sym_t*) symtab = NULL;
+// Symbols are interned in a global open-addressing hash table. Lookups probe
+// it without any lock; the table pointer and each slot are published with
+// release stores, and a slot never changes once set (symbols are immortal).
+// Insertions and growth are serialized by gc_perm_lock (which the slow path
+// needs anyway to allocate the symbol); a racing reader that probes a table
+// from before an insertion simply misses and retries under the lock.
+typedef struct {
+    size_t size; // power of two
+    _Atomic(jl_sym_t*) slots[];
+} jl_symtab_t;
+
+#define SYMTAB_INIT_SZ (1 << 13)
+
+static _Atomic(jl_symtab_t*) symtab = NULL;
+static size_t symtab_count = 0; // protected by gc_perm_lock
 
 #define MAX_SYM_LEN ((size_t)INTPTR_MAX - sizeof(jl_taggedvalue_t) - sizeof(jl_sym_t) - 1)
 
@@ -31,7 +45,7 @@ static size_t symbol_nbytes(size_t len) JL_NOTSAFEPOINT
     return (sizeof(jl_taggedvalue_t) + sizeof(jl_sym_t) + len + 1 + 7) & -8;
 }
 
-static jl_sym_t *mk_symbol(const char *str, size_t len) JL_NOTSAFEPOINT
+static jl_sym_t *mk_symbol(const char *str, size_t len, uintptr_t h) JL_NOTSAFEPOINT
 {
     jl_sym_t *sym;
     size_t nb = symbol_nbytes(len);
@@ -39,39 +53,77 @@ static jl_sym_t *mk_symbol(const char *str, size_t len) JL_NOTSAFEPOINT
     sym = (jl_sym_t*)jl_valueof(tag);
     // set to old marked so that we won't look at it in the GC or write barrier.
     jl_set_typetagof(sym, jl_symbol_tag, GC_OLD_MARKED);
-    jl_atomic_store_relaxed(&sym->left, NULL);
-    jl_atomic_store_relaxed(&sym->right, NULL);
-    sym->hash = hash_symbol(str, len);
+    sym->hash = h;
     memcpy(jl_symbol_name(sym), str, len);
     jl_symbol_name(sym)[len] = 0;
     return sym;
 }
 
-static jl_sym_t *symtab_lookup(_Atomic(jl_sym_t*) *ptree, const char *str, size_t len, _Atomic(jl_sym_t*) **slot) JL_NOTSAFEPOINT
+static jl_sym_t *symtab_lookup(jl_symtab_t *tab, const char *str, size_t len, uintptr_t h) JL_NOTSAFEPOINT
 {
-    jl_sym_t *node = jl_atomic_load_relaxed(ptree); // consume
-    uintptr_t h = hash_symbol(str, len);
+    if (tab == NULL)
+        return NULL;
+    size_t mask = tab->size - 1;
+    size_t i = h & mask;
+    while (1) {
+        jl_sym_t *sym = jl_atomic_load_acquire(&tab->slots[i]);
+        if (sym == NULL)
+            return NULL;
+        if (sym->hash == h && strncmp(str, jl_symbol_name(sym), len) == 0 &&
+            jl_symbol_name(sym)[len] == 0)
+            return sym;
+        i = (i + 1) & mask;
+    }
+}
+
+// gc_perm_lock must be held and the table must have a free slot
+static void symtab_insert(jl_symtab_t *tab, jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    size_t mask = tab->size - 1;
+    size_t i = sym->hash & mask;
+    while (jl_atomic_load_relaxed(&tab->slots[i]) != NULL)
+        i = (i + 1) & mask;
+    jl_atomic_store_release(&tab->slots[i], sym);
+}
 
-    // Tree nodes sorted by major key of (int(hash)) and minor key of (str).
-    while (node != NULL) {
-        intptr_t x = (intptr_t)(h - node->hash);
-        if (x == 0) {
-            x = strncmp(str, jl_symbol_name(node), len);
-            if (x == 0 && jl_symbol_name(node)[len] == 0) {
-                if (slot != NULL)
-                    *slot = ptree;
-                return node;
-            }
+// gc_perm_lock must be held. Make sure `n` more symbols fit below the 3/4
+// load bound, growing and republishing the table if they do not.
+static void symtab_reserve(size_t n) JL_NOTSAFEPOINT
+{
+    jl_symtab_t *tab = jl_atomic_load_relaxed(&symtab);
+    size_t sz = tab == NULL ? 0 : tab->size;
+    size_t required = symtab_count + n;
+    if (sz != 0 && required * 4 <= sz * 3)
+        return;
+    size_t newsz = sz == 0 ? SYMTAB_INIT_SZ : sz;
+    while (required * 4 > newsz * 3)
+        newsz *= 2;
+    jl_symtab_t *newtab = (jl_symtab_t*)jl_gc_perm_alloc_nolock(
+            sizeof(jl_symtab_t) + newsz * sizeof(jl_sym_t*), 1, sizeof(void*), 0);
+    newtab->size = newsz;
+    if (tab != NULL) {
+        for (size_t i = 0; i < tab->size; i++) {
+            jl_sym_t *sym = jl_atomic_load_relaxed(&tab->slots[i]);
+            if (sym != NULL)
+                symtab_insert(newtab, sym);
         }
-        if (x < 0)
-            ptree = &node->left;
-        else
-            ptree = &node->right;
-        node = jl_atomic_load_relaxed(ptree); // consume
     }
-    if (slot != NULL)
-        *slot = ptree;
-    return node;
+    // readers still probing the old table only miss symbols interned after
+    // this point, and those misses retry under the lock
+    jl_atomic_store_release(&symtab, newtab);
+}
+
+// gc_perm_lock must be held, with a free slot available (see symtab_reserve)
+static jl_sym_t *symtab_lookup_or_insert(const char *str, size_t len, uintptr_t h) JL_NOTSAFEPOINT
+{
+    jl_symtab_t *tab = jl_atomic_load_relaxed(&symtab);
+    jl_sym_t *sym = symtab_lookup(tab, str, len, h);
+    if (sym == NULL) {
+        sym = mk_symbol(str, len, h);
+        symtab_insert(tab, sym);
+        symtab_count++;
+    }
+    return sym;
 }
 
 jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT // (or throw)
@@ -83,20 +135,54 @@ jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT // (or throw)
         jl_exceptionf(jl_argumenterror_type, "Symbol name too long");
 #endif
     assert(!memchr(str, 0, len));
-    _Atomic(jl_sym_t*) *slot;
-    jl_sym_t *node = symtab_lookup(&symtab, str, len, &slot);
-    if (node == NULL) {
+    uintptr_t h = hash_symbol(str, len);
+    jl_sym_t *sym = symtab_lookup(jl_atomic_load_acquire(&symtab), str, len, h);
+    if (sym == NULL) {
         uv_mutex_lock(&gc_perm_lock);
-        // Someone might have updated it, check and look up again
-        if (jl_atomic_load_relaxed(slot) != NULL && (node = symtab_lookup(slot, str, len, &slot))) {
-            uv_mutex_unlock(&gc_perm_lock);
-            return node;
-        }
-        node = mk_symbol(str, len);
-        jl_atomic_store_release(slot, node);
+        symtab_reserve(1);
+        sym = symtab_lookup_or_insert(str, len, h);
         uv_mutex_unlock(&gc_perm_lock);
     }
-    return node;
+    return sym;
+}
+
+// Intern every record of a packed (uint32 length, name bytes, NUL) symbol
+// stream, as laid out in the image symbol section, appending each symbol to
+// `out` in stream order. Sizing the table up front and holding the lock once
+// is noticeably cheaper than interning image symbols one at a time.
+void _jl_symbols_intern_packed(const char *buf, size_t nbytes, arraylist_t *out)
+{
+    // Probe the published table without the lock first. Most of a package
+    // image's blob is usually interned already (by the sysimage or another
+    // package), so those records never contend on gc_perm_lock, and all of
+    // the hashing happens outside it either way.
+    size_t nmiss = 0;
+    size_t base = out->len;
+    const char *p = buf, *end = buf + nbytes;
+    while (p < end) {
+        uint32_t len = jl_load_unaligned_i32(p);
+        const char *str = p + 4;
+        assert(len <= MAX_SYM_LEN && !memchr(str, 0, len));
+        jl_sym_t *sym = symtab_lookup(jl_atomic_load_acquire(&symtab), str, len,
+                                      hash_symbol(str, len));
+        arraylist_push(out, (void*)sym); // NULL marks a miss to intern below
+        if (sym == NULL)
+            nmiss++;
+        p += 4 + len + 1;
+    }
+    if (nmiss == 0)
+        return;
+    uv_mutex_lock(&gc_perm_lock);
+    symtab_reserve(nmiss);
+    p = buf;
+    for (size_t i = base; p < end; i++) {
+        uint32_t len = jl_load_unaligned_i32(p);
+        const char *str = p + 4;
+        if (out->items[i] == NULL)
+            out->items[i] = (void*)symtab_lookup_or_insert(str, len, hash_symbol(str, len));
+        p += 4 + len + 1;
+    }
+    uv_mutex_unlock(&gc_perm_lock);
 }
 
 JL_DLLEXPORT jl_sym_t *jl_symbol(const char *str) JL_NOTSAFEPOINT // (or throw)
@@ -106,7 +192,8 @@ JL_DLLEXPORT jl_sym_t *jl_symbol(const char *str) JL_NOTSAFEPOINT // (or throw)
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_lookup(const char *str) JL_NOTSAFEPOINT
 {
-    return symtab_lookup(&symtab, str, strlen(str), NULL);
+    size_t len = strlen(str);
+    return symtab_lookup(jl_atomic_load_acquire(&symtab), str, len, hash_symbol(str, len));
 }
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, size_t len)
@@ -116,11 +203,6 @@ JL_DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, size_t len)
     return _jl_symbol(str, len);
 }
 
-JL_DLLEXPORT jl_sym_t *jl_get_root_symbol(void)
-{
-    return jl_atomic_load_relaxed(&symtab);
-}
-
 static _Atomic(uint32_t) gs_ctr = 0;  // TODO: per-module?
 uint32_t jl_get_gs_ctr(void) { return jl_atomic_load_relaxed(&gs_ctr); }
 void jl_set_gs_ctr(uint32_t ctr) { jl_atomic_store_relaxed(&gs_ctr, ctr); }
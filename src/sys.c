@@ -283,6 +283,26 @@ JL_DLLEXPORT jl_value_t *jl_readuntil(ios_t *s, uint8_t delim, uint8_t str, uint
         memcpy(jl_array_data(a, uint8_t), s->buf + s->bpos, n - nchomp);
         s->bpos += n;
     }
+    else if (str) {
+        // delimiter not buffered yet: accumulate on the stack (spilling into a
+        // malloc'd buffer for long lines), then copy once into the String.
+        // Going through an Array here would copy the bytes a second time,
+        // since a String always owns its bytes inline.
+        char locbuf[80];
+        ios_t dest;
+        ios_mem(&dest, 0);
+        ios_setbuf(&dest, locbuf, sizeof(locbuf), 0);
+        size_t n = ios_copyuntil(&dest, s, delim, 1);
+        if (chomp && n > 0 && dest.buf[n - 1] == delim) {
+            n--;
+            if (chomp == 2 && n > 0 && dest.buf[n - 1] == '\r') {
+                n--;
+            }
+        }
+        jl_value_t *st = n == 0 ? jl_an_empty_string : jl_pchar_to_string(dest.buf, n);
+        ios_close(&dest);
+        return st;
+    }
     else {
         a = jl_alloc_array_1d(jl_array_uint8_type, 80);
         ios_t dest;
@@ -305,12 +325,6 @@ JL_DLLEXPORT jl_value_t *jl_readuntil(ios_t *s, uint8_t delim, uint8_t str, uint
         else {
             a->dimsize[0] = n;
         }
-        if (str) {
-            JL_GC_PUSH1(&a);
-            jl_value_t *st = jl_array_to_string(a);
-            JL_GC_POP();
-            return st;
-        }
     }
     return (jl_value_t*)a;
 }
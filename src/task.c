@@ -509,6 +509,8 @@ JL_NO_ASAN static void ctx_switch(jl_task_t *lastt)
     jl_signal_fence();
     jl_set_pgcstack(&t->gcstack);
     jl_signal_fence();
+    // the stack mutated while lastt ran; the GC needs to rescan it
+    lastt->stack_dirty = 2;
     lastt->ptls = NULL;
 #ifdef MIGRATE_TASKS
     ptls->previous_task = lastt;
@@ -1093,8 +1095,19 @@ void jl_rng_split(uint64_t dst[JL_RNG_SIZE], uint64_t src[JL_RNG_SIZE]) JL_NOTSA
 JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion_future, size_t ssize)
 {
     jl_task_t *ct = jl_current_task;
-    jl_task_t *t = (jl_task_t*)jl_gc_alloc(ct->ptls, sizeof(jl_task_t), jl_task_type);
-    jl_set_typetagof(t, jl_task_tag, 0);
+    jl_task_t *t;
+    small_arraylist_t *free_tasks = &ct->ptls->heap.free_tasks;
+    if (free_tasks->len > 0) {
+        // reuse a task object that a previous collection proved unreachable
+        // (see gc_claim_dead_task); it may live in the old generation, so
+        // tell the GC it is about to hold young references again
+        t = (jl_task_t*)small_arraylist_pop(free_tasks);
+        jl_gc_wb_back(t);
+    }
+    else {
+        t = (jl_task_t*)jl_gc_alloc(ct->ptls, sizeof(jl_task_t), jl_task_type);
+        jl_set_typetagof(t, jl_task_tag, 0);
+    }
     JL_PROBE_RT_NEW_TASK(ct, t);
     t->copy_stack = 0;
     if (ssize == 0) {
@@ -1141,6 +1154,7 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion
     t->ptls = NULL;
     t->world_age = ct->world_age;
     t->reentrant_timing = 0;
+    t->stack_dirty = 2;
     jl_timing_task_init(t);
 
 #ifdef COPY_STACKS
@@ -1409,16 +1423,107 @@ static void jl_set_fiber(jl_ucontext_t *t)
     unw_resume(&c);
 }
 #elif defined(JL_HAVE_ASM)
+#ifdef JL_HAVE_FAST_FIBER_SWAP
+// register save/restore pair for the jl_fastctx_t layout (julia_internal.h);
+// the save side stores the state a return from the call would have, so that
+// jl_fastctx_restore resumes its caller exactly like a second return from
+// jl_fastctx_save, with a nonzero return value
+static_assert(sizeof(jl_fastctx_t) <= sizeof(jl_jmp_buf),
+              "jl_fastctx_t must fit in the jmp_buf slot of the task context");
+#if defined(_OS_DARWIN_)
+#define FASTCTX_ENTRY(name) \
+    ".text\n" \
+    ".p2align 4\n" \
+    ".globl _" name "\n" \
+    "_" name ":\n"
+#else
+#define FASTCTX_ENTRY(name) \
+    ".text\n" \
+    ".p2align 4\n" \
+    ".globl " name "\n" \
+    ".type " name ",@function\n" \
+    name ":\n"
+#endif
+#if defined(_CPU_X86_64_)
+__asm__(
+    FASTCTX_ENTRY("jl_fastctx_save")
+    "\tmovq %rbx, 0(%rdi)\n"
+    "\tmovq %rbp, 8(%rdi)\n"
+    "\tmovq %r12, 16(%rdi)\n"
+    "\tmovq %r13, 24(%rdi)\n"
+    "\tmovq %r14, 32(%rdi)\n"
+    "\tmovq %r15, 40(%rdi)\n"
+    "\tleaq 8(%rsp), %rax\n" // sp as it will be after returning
+    "\tmovq %rax, 48(%rdi)\n"
+    "\tmovq (%rsp), %rax\n" // return address
+    "\tmovq %rax, 56(%rdi)\n"
+    "\txorl %eax, %eax\n"
+    "\tret\n");
+__asm__(
+    FASTCTX_ENTRY("jl_fastctx_restore")
+    "\tmovq 0(%rdi), %rbx\n"
+    "\tmovq 8(%rdi), %rbp\n"
+    "\tmovq 16(%rdi), %r12\n"
+    "\tmovq 24(%rdi), %r13\n"
+    "\tmovq 32(%rdi), %r14\n"
+    "\tmovq 40(%rdi), %r15\n"
+    "\tmovq 48(%rdi), %rsp\n"
+    "\tmovl $1, %eax\n"
+    "\tjmpq *56(%rdi)\n");
+#elif defined(_CPU_AARCH64_)
+__asm__(
+    FASTCTX_ENTRY("jl_fastctx_save")
+    "\tstp x19, x20, [x0]\n"
+    "\tstp x21, x22, [x0, #16]\n"
+    "\tstp x23, x24, [x0, #32]\n"
+    "\tstp x25, x26, [x0, #48]\n"
+    "\tstp x27, x28, [x0, #64]\n"
+    "\tstp x29, x30, [x0, #80]\n" // fp and the return address
+    "\tmov x9, sp\n"
+    "\tstr x9, [x0, #96]\n"
+    "\tstp d8, d9, [x0, #104]\n"
+    "\tstp d10, d11, [x0, #120]\n"
+    "\tstp d12, d13, [x0, #136]\n"
+    "\tstp d14, d15, [x0, #152]\n"
+    "\tmov w0, #0\n"
+    "\tret\n");
+__asm__(
+    FASTCTX_ENTRY("jl_fastctx_restore")
+    "\tldp x19, x20, [x0]\n"
+    "\tldp x21, x22, [x0, #16]\n"
+    "\tldp x23, x24, [x0, #32]\n"
+    "\tldp x25, x26, [x0, #48]\n"
+    "\tldp x27, x28, [x0, #64]\n"
+    "\tldp x29, x30, [x0, #80]\n"
+    "\tldr x9, [x0, #96]\n"
+    "\tmov sp, x9\n"
+    "\tldp d8, d9, [x0, #104]\n"
+    "\tldp d10, d11, [x0, #120]\n"
+    "\tldp d12, d13, [x0, #136]\n"
+    "\tldp d14, d15, [x0, #152]\n"
+    "\tmov w0, #1\n"
+    "\tret\n"); // to the x30 just restored
+#endif
+#endif
 static void jl_swap_fiber(jl_ucontext_t *lastt, jl_ucontext_t *t)
 {
+#ifdef JL_HAVE_FAST_FIBER_SWAP
+    if (jl_fastctx_save((jl_fastctx_t*)&lastt->ctx.uc_mcontext))
+        return;
+#else
     if (jl_setjmp(lastt->ctx.uc_mcontext, 0))
         return;
+#endif
     tsan_switch_to_ctx(t);
     jl_set_fiber(t); // doesn't return
 }
 static void jl_set_fiber(jl_ucontext_t *t)
 {
+#ifdef JL_HAVE_FAST_FIBER_SWAP
+    jl_fastctx_restore((jl_fastctx_t*)&t->ctx.uc_mcontext);
+#else
     jl_longjmp(t->ctx.uc_mcontext, 1);
+#endif
 }
 #endif
 
@@ -1497,6 +1602,9 @@ JL_NO_ASAN static void jl_start_fiber_swap(jl_ucontext_t *lastt, jl_ucontext_t *
         return;
     if (r != 0 || returns != 1)
         abort();
+#elif defined(JL_HAVE_FAST_FIBER_SWAP)
+    if (jl_fastctx_save((jl_fastctx_t*)&lastt->ctx.uc_mcontext))
+        return;
 #else
     if (jl_setjmp(lastt->ctx.uc_mcontext, 0))
         return;
@@ -1730,6 +1838,7 @@ jl_task_t *jl_init_root_task(jl_ptls_t ptls, void *stack_lo, void *stack_hi)
     ct->name = unique_string;
 #endif
     ct->started = 1;
+    ct->stack_dirty = 2;
     ct->next = jl_nothing;
     ct->queue = jl_nothing;
     ct->tls = jl_nothing;
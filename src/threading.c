@@ -10,6 +10,12 @@
 #include "julia_internal.h"
 #include "julia_assert.h"
 
+#ifdef JL_MUTEX_FUTEX
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
 #ifdef USE_ITTAPI
 #include "ittapi/ittnotify.h"
 #endif
@@ -314,6 +320,11 @@ static uv_mutex_t tls_lock; // controls write-access to these variables:
 _Atomic(jl_ptls_t*) jl_all_tls_states JL_GLOBALLY_ROOTED;
 int jl_all_tls_states_size;
 static uv_cond_t cond;
+// thread-local states of departed adopted threads, retained for reuse so that
+// embedders whose callbacks arrive on many transient threads do not pay full
+// heap and scheduler setup on every adoption (guarded by tls_lock; the
+// entries also remain visible in jl_all_tls_states under their old tid)
+static arraylist_t reusable_tls_states;
 // concurrent reads are permitted, using the same pattern as mtsmall_arraylist
 // it is implemented separately because the API of direct jl_all_tls_states use is already widely prevalent
 void jl_init_thread_scheduler(jl_ptls_t ptls) JL_NOTSAFEPOINT;
@@ -338,6 +349,24 @@ JL_DLLEXPORT int8_t jl_threadpoolid(int16_t tid) JL_NOTSAFEPOINT
     return -1; // everything else uses threadpool -1 (does not belong to any threadpool)
 }
 
+// NUMA partitioning of the default threadpool (NUMA_PARTITION_NAME): when
+// enabled, each default-pool thread is affinity-bound to one NUMA node and
+// the scheduler prefers same-node queues when spawning and stealing
+static int jl_n_numa_nodes = 1;
+static int8_t *jl_thread_numa_node = NULL; // node per tid, -1 if unbound
+
+JL_DLLEXPORT int jl_numa_node_count(void) JL_NOTSAFEPOINT
+{
+    return jl_n_numa_nodes;
+}
+
+JL_DLLEXPORT int8_t jl_threadnumanode(int16_t tid) JL_NOTSAFEPOINT
+{
+    if (jl_thread_numa_node == NULL || tid < 0 || tid >= jl_atomic_load_acquire(&jl_n_threads))
+        return -1;
+    return jl_thread_numa_node[tid];
+}
+
 jl_ptls_t jl_init_threadtls(int16_t tid)
 {
 #ifndef _OS_WINDOWS_
@@ -402,11 +431,50 @@ jl_ptls_t jl_init_threadtls(int16_t tid)
     if (jl_atomic_load_relaxed(&jl_n_threads) < tid + 1)
         jl_atomic_store_release(&jl_n_threads, tid + 1);
     jl_fence();
+    // now that the thread is visible to the safepoint machinery, pick up the
+    // current arming state of the GC safepoint (the provisional pointer set
+    // above does not reflect it)
+    jl_safepoint_init_thread(ptls);
     uv_mutex_unlock(&tls_lock);
 
     return ptls;
 }
 
+void scheduler_revive_thread(jl_ptls_t ptls) JL_NOTSAFEPOINT;
+
+// Reclaim the thread-local state of a departed adopted thread, if one is
+// available. This skips the expensive parts of jl_init_threadtls when
+// callbacks from an embedder arrive on many transient threads: the reused
+// state keeps its backtrace buffer, heap and allocation caches warm, and
+// its tid slot in jl_all_tls_states is still valid. Must be called with the
+// GC disabled, like jl_init_threadtls.
+static jl_ptls_t jl_reclaim_threadtls(void)
+{
+#ifndef _OS_WINDOWS_
+    if (pthread_getspecific(jl_task_exit_key))
+        abort();
+#endif
+    if (jl_get_pgcstack() != NULL)
+        abort();
+    uv_mutex_lock(&tls_lock);
+    jl_ptls_t ptls = reusable_tls_states.len == 0 ? NULL
+        : (jl_ptls_t)arraylist_pop(&reusable_tls_states);
+    if (ptls != NULL) {
+#ifndef _OS_WINDOWS_
+        pthread_setspecific(jl_task_exit_key, (void*)ptls);
+#endif
+        ptls->system_id = uv_thread_self();
+        ptls->rngseed = jl_rand();
+        jl_atomic_store_relaxed(&ptls->gc_state, 0); // GC unsafe
+        scheduler_revive_thread(ptls);
+        jl_fence();
+        // pick up the current arming state of the GC safepoint
+        jl_safepoint_init_thread(ptls);
+    }
+    uv_mutex_unlock(&tls_lock);
+    return ptls;
+}
+
 JL_DLLEXPORT jl_gcframe_t **jl_adopt_thread(void)
 {
     // `jl_init_threadtls` puts us in a GC unsafe region, so ensure GC isn't running.
@@ -419,8 +487,11 @@ JL_DLLEXPORT jl_gcframe_t **jl_adopt_thread(void)
     // this check is coupled with the one in `jl_safepoint_wait_gc`, where we observe if a
     // foreign thread has asked to disable the GC, guaranteeing the order of events.
 
-    // initialize this thread (assign tid, create heap, set up root task)
-    jl_ptls_t ptls = jl_init_threadtls(-1);
+    // initialize this thread (assign tid, create heap, set up root task),
+    // reusing the state of a departed adopted thread when possible
+    jl_ptls_t ptls = jl_reclaim_threadtls();
+    if (ptls == NULL)
+        ptls = jl_init_threadtls(-1);
     void *stack_lo, *stack_hi;
     jl_init_stack_limits(0, &stack_lo, &stack_hi);
 
@@ -510,6 +581,13 @@ static void jl_delete_thread(void *value) JL_NOTSAFEPOINT_ENTER
 #endif
     // then park in safe-region
     (void)jl_gc_safe_enter(ptls);
+    // retain the state of adopted (non-threadpool) threads for reuse by
+    // future adopted threads; threadpool tids must not change owners
+    if (jl_threadpoolid(ptls->tid) == -1) {
+        uv_mutex_lock(&tls_lock);
+        arraylist_push(&reusable_tls_states, ptls);
+        uv_mutex_unlock(&tls_lock);
+    }
 }
 
 //// debugging hack: if we are exiting too fast for error message printing on threads,
@@ -634,6 +712,7 @@ void jl_init_threading(void)
 
     uv_mutex_init(&tls_lock);
     uv_cond_init(&cond);
+    arraylist_new(&reusable_tls_states, 0);
 #ifdef JL_ELF_TLS_VARIANT
     jl_check_tls();
 #endif
@@ -737,6 +816,47 @@ void jl_init_threading(void)
 
 static uv_barrier_t thread_init_done;
 
+#ifdef _OS_LINUX_
+#define JL_NUMA_MAX_NODES 64
+// read each NUMA node's cpu list from sysfs into a byte-per-cpu mask (the
+// format `uv_thread_setaffinity` expects); returns the number of nodes found
+static int jl_get_numa_masks(char *masks, int maxnodes, int cpumasksize)
+{
+    int node = 0;
+    for (; node < maxnodes; node++) {
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *f = fopen(path, "r");
+        if (f == NULL)
+            break;
+        char buf[4096];
+        size_t got = fread(buf, 1, sizeof(buf) - 1, f);
+        fclose(f);
+        buf[got] = '\0';
+        char *mask = &masks[(size_t)node * cpumasksize];
+        char *p = buf;
+        while (*p != '\0' && *p != '\n') {
+            char *end;
+            long lo = strtol(p, &end, 10);
+            if (end == p)
+                return 0; // unexpected format
+            long hi = lo;
+            p = end;
+            if (*p == '-') {
+                hi = strtol(p + 1, &end, 10);
+                p = end;
+            }
+            for (long c = lo; c <= hi; c++)
+                if (0 <= c && c < cpumasksize)
+                    mask[c] = 1;
+            if (*p == ',')
+                p++;
+        }
+    }
+    return node;
+}
+#endif
+
 void jl_start_threads(void)
 {
     int nthreads = jl_atomic_load_relaxed(&jl_n_threads);
@@ -770,6 +890,42 @@ void jl_start_threads(void)
         mask[0] = 0;
     }
 
+    // NUMA partitioning: pin each default-pool thread to one NUMA node,
+    // assigning threads to nodes in contiguous blocks; the Julia scheduler
+    // reads the node ids back (jl_threadnumanode) to keep spawned tasks and
+    // steals on the spawning thread's node when it can
+    int nnuma = 0;
+    char *numa_masks = NULL;
+#ifdef _OS_LINUX_
+    cp = getenv(NUMA_PARTITION_NAME);
+    if (!exclusive && cp && strcmp(cp, "0") != 0) {
+        int ndefault = jl_n_threads_per_pool[1];
+        numa_masks = (char*)calloc_s((size_t)JL_NUMA_MAX_NODES * cpumasksize);
+        nnuma = jl_get_numa_masks(numa_masks, JL_NUMA_MAX_NODES, cpumasksize);
+        if (nnuma > ndefault)
+            nnuma = ndefault; // leave no node without a thread
+        if (nnuma > 1) {
+            int first = jl_n_threads_per_pool[0]; // interactive threads come first
+            jl_thread_numa_node = (int8_t*)malloc_s(nthreads);
+            memset(jl_thread_numa_node, -1, nthreads);
+            for (i = 0; i < ndefault; i++)
+                jl_thread_numa_node[first + i] = (int8_t)((i * nnuma) / ndefault);
+            jl_n_numa_nodes = nnuma;
+        }
+        else {
+            free(numa_masks);
+            numa_masks = NULL;
+            nnuma = 0;
+        }
+    }
+#endif
+    if (nnuma > 1 && jl_thread_numa_node[0] >= 0) {
+        // the master thread is in the default pool only when there is no
+        // interactive pool
+        uvtid = uv_thread_self();
+        uv_thread_setaffinity(&uvtid, &numa_masks[(size_t)jl_thread_numa_node[0] * cpumasksize], NULL, cpumasksize);
+    }
+
     // create threads
     uv_barrier_init(&thread_init_done, nthreads);
 
@@ -787,6 +943,9 @@ void jl_start_threads(void)
                 uv_thread_setaffinity(&uvtid, mask, NULL, cpumasksize);
                 mask[i] = 0;
             }
+            else if (nnuma > 1 && jl_thread_numa_node[i] >= 0) {
+                uv_thread_setaffinity(&uvtid, &numa_masks[(size_t)jl_thread_numa_node[i] * cpumasksize], NULL, cpumasksize);
+            }
         }
         else if (i == nthreads - 1 && jl_n_sweepthreads == 1) {
             uv_thread_create(&uvtid, jl_concurrent_gc_threadfun, t);
@@ -797,6 +956,8 @@ void jl_start_threads(void)
         uv_thread_detach(&uvtid);
     }
 
+    free(numa_masks);
+
     uv_barrier_wait(&thread_init_done);
 }
 
@@ -827,10 +988,112 @@ JL_DLLEXPORT void jl_exit_threaded_region(void)
 
 // Profiling stubs
 
+// The hidden-field layouts in jltypes.c model an embedded jl_mutex_t as two
+// pointer-sized words; the futex word must stay inside that footprint.
+static_assert(sizeof(jl_mutex_t) == 2 * sizeof(void*),
+              "jl_mutex_t must be exactly two pointer words");
+
+// Contention statistics, aggregated by the name a lock was initialized with
+// (so e.g. every `method->writelock` shares one bucket). Locks created by
+// zero-initialization without a name land in bucket 0.
+#define JL_LOCK_STATS_NBUCKETS 128
+static struct {
+    _Atomic(const char *) name;
+    _Atomic(uint64_t) nacquired;  // acquisitions (excluding recursive re-entries)
+    _Atomic(uint64_t) ncontended; // acquires that had to take the slow path
+    _Atomic(uint64_t) nparked;    // times a waiter parked in the kernel
+    _Atomic(uint64_t) spin_iters; // cumulative slow-path spin iterations
+    _Atomic(uint64_t) wait_hist[JL_LOCK_WAIT_NHIST]; // log2(us) of slow-path wait times
+} jl_lock_stats_buckets[JL_LOCK_STATS_NBUCKETS] = {{"<unnamed>"}};
+
+static uint16_t jl_lock_stats_bucket(const char *name) JL_NOTSAFEPOINT
+{
+    if (name == NULL)
+        return 0;
+    for (int i = 1; i < JL_LOCK_STATS_NBUCKETS; i++) {
+        const char *have = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].name);
+        if (have == NULL) {
+            if (jl_atomic_cmpswap(&jl_lock_stats_buckets[i].name, &have, name))
+                return (uint16_t)i;
+            // `have` now holds the winning name; fall through to compare it
+        }
+        if (have == name || strcmp(have, name) == 0)
+            return (uint16_t)i;
+    }
+    return 0; // out of buckets; aggregate with the unnamed locks
+}
+
+STATIC_INLINE void jl_lock_stats_record(jl_mutex_t *lock, int parked) JL_NOTSAFEPOINT
+{
+    if (parked)
+        jl_atomic_fetch_add_relaxed(&jl_lock_stats_buckets[lock->statsidx].nparked, 1);
+    else
+        jl_atomic_fetch_add_relaxed(&jl_lock_stats_buckets[lock->statsidx].ncontended, 1);
+}
+
+STATIC_INLINE void jl_lock_stats_acquired(jl_mutex_t *lock) JL_NOTSAFEPOINT
+{
+    jl_atomic_fetch_add_relaxed(&jl_lock_stats_buckets[lock->statsidx].nacquired, 1);
+}
+
+// Record one slow-path acquisition: its wait time into the log2(us) histogram
+// and its spin iterations into the cumulative total.
+STATIC_INLINE void jl_lock_stats_waited(jl_mutex_t *lock, uint64_t wait_ns,
+                                        uint64_t nspins) JL_NOTSAFEPOINT
+{
+    int i = 0;
+    uint64_t us = wait_ns / 1000;
+    while (us > 1 && i < JL_LOCK_WAIT_NHIST - 1) {
+        us >>= 1;
+        i++;
+    }
+    jl_atomic_fetch_add_relaxed(&jl_lock_stats_buckets[lock->statsidx].wait_hist[i], 1);
+    jl_atomic_fetch_add_relaxed(&jl_lock_stats_buckets[lock->statsidx].spin_iters, nspins);
+}
+
+// Copy up to `len` per-name contention counters into the caller's buffer and
+// return the number of populated buckets (which may exceed `len`).
+JL_DLLEXPORT size_t jl_lock_stats(jl_lock_stats_t *stats, size_t len) JL_NOTSAFEPOINT
+{
+    size_t n = 0;
+    for (int i = 0; i < JL_LOCK_STATS_NBUCKETS; i++) {
+        const char *name = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].name);
+        if (name == NULL)
+            continue;
+        if (n < len) {
+            stats[n].name = name;
+            stats[n].nacquired = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].nacquired);
+            stats[n].ncontended = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].ncontended);
+            stats[n].nparked = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].nparked);
+            stats[n].spin_iters = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].spin_iters);
+            for (int j = 0; j < JL_LOCK_WAIT_NHIST; j++)
+                stats[n].wait_hist[j] = jl_atomic_load_relaxed(&jl_lock_stats_buckets[i].wait_hist[j]);
+        }
+        n++;
+    }
+    return n;
+}
+
+#ifdef JL_MUTEX_FUTEX
+static void jl_futex_wait(_Atomic(uint32_t) *addr, uint32_t val) JL_NOTSAFEPOINT
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void jl_futex_wake_one(_Atomic(uint32_t) *addr) JL_NOTSAFEPOINT
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+#endif
+
 void _jl_mutex_init(jl_mutex_t *lock, const char *name) JL_NOTSAFEPOINT
 {
     jl_atomic_store_relaxed(&lock->owner, (jl_task_t*)NULL);
     lock->count = 0;
+    lock->statsidx = jl_lock_stats_bucket(name);
+#ifdef JL_MUTEX_FUTEX
+    jl_atomic_store_relaxed(&lock->futex, 0);
+#endif
     jl_profile_lock_init(lock, name);
 }
 
@@ -843,15 +1106,86 @@ void _jl_mutex_wait(jl_task_t *self, jl_mutex_t *lock, int safepoint)
     }
     // Don't use JL_TIMING for instant acquires, results in large blowup of events
     jl_profile_lock_start_wait(lock);
+#ifdef JL_MUTEX_FUTEX
+    // The futex word is the lock: 0 = unlocked, 1 = locked, 2 = locked and
+    // waiters may be parked on it; `owner` is bookkeeping written by the
+    // holder. Contended acquires spin with exponential backoff, then park in
+    // the kernel on the per-lock futex.
+    uint32_t state = 0;
+    if (jl_atomic_cmpswap(&lock->futex, &state, 1)) {
+        jl_atomic_store_relaxed(&lock->owner, self);
+        lock->count = 1;
+        jl_lock_stats_acquired(lock);
+        jl_profile_lock_acquired(lock);
+        return;
+    }
+    jl_lock_stats_record(lock, 0);
+    uint64_t wait_t0 = jl_hrtime();
+    uint64_t nspins = 0;
+    JL_TIMING(LOCK_SPIN, LOCK_SPIN);
+    int spins = 0;
+    int parked = 0;
+    while (1) {
+        if (!parked) {
+            state = 0;
+            if (jl_atomic_load_relaxed(&lock->futex) == 0 &&
+                jl_atomic_cmpswap(&lock->futex, &state, 1))
+                break;
+        }
+        else {
+            // once we have parked, peers may still be parked, so we must
+            // acquire in the contended state for unlock to wake them
+            if (jl_atomic_exchange(&lock->futex, 2) == 0)
+                break;
+        }
+        if (safepoint) {
+            jl_gc_safepoint_(self->ptls);
+        }
+        if (spins < 10 && !jl_running_under_rr(0)) {
+            int backoff = 1 << (spins > 6 ? 6 : spins);
+            nspins += backoff;
+            for (int i = backoff; i > 0; i--)
+                jl_cpu_pause();
+            spins++;
+            continue;
+        }
+        // no luck: publish the contention and park until an unlock wakes us
+        if (jl_atomic_exchange(&lock->futex, 2) == 0)
+            break;
+        parked = 1;
+        jl_lock_stats_record(lock, 1);
+        if (safepoint) {
+            // let the GC (and thread suspension) proceed while we are parked
+            int8_t gc_state = jl_gc_safe_enter(self->ptls);
+            jl_futex_wait(&lock->futex, 2);
+            jl_gc_safe_leave(self->ptls, gc_state);
+        }
+        else {
+            jl_futex_wait(&lock->futex, 2);
+        }
+    }
+    jl_atomic_store_relaxed(&lock->owner, self);
+    lock->count = 1;
+    jl_lock_stats_acquired(lock);
+    jl_lock_stats_waited(lock, jl_hrtime() - wait_t0, nspins);
+    jl_profile_lock_acquired(lock);
+#else
     if (owner == NULL && jl_atomic_cmpswap(&lock->owner, &owner, self)) {
         lock->count = 1;
+        jl_lock_stats_acquired(lock);
         jl_profile_lock_acquired(lock);
         return;
     }
+    jl_lock_stats_record(lock, 0);
+    uint64_t wait_t0 = jl_hrtime();
+    uint64_t nspins = 0;
     JL_TIMING(LOCK_SPIN, LOCK_SPIN);
     while (1) {
+        nspins++;
         if (owner == NULL && jl_atomic_cmpswap(&lock->owner, &owner, self)) {
             lock->count = 1;
+            jl_lock_stats_acquired(lock);
+            jl_lock_stats_waited(lock, jl_hrtime() - wait_t0, nspins);
             jl_profile_lock_acquired(lock);
             return;
         }
@@ -868,6 +1202,7 @@ void _jl_mutex_wait(jl_task_t *self, jl_mutex_t *lock, int safepoint)
         jl_cpu_suspend();
         owner = jl_atomic_load_relaxed(&lock->owner);
     }
+#endif
 }
 
 static void jl_lock_frame_push(jl_task_t *self, jl_mutex_t *lock)
@@ -905,10 +1240,19 @@ int _jl_mutex_trylock_nogc(jl_task_t *self, jl_mutex_t *lock)
         lock->count++;
         return 1;
     }
+#ifdef JL_MUTEX_FUTEX
+    uint32_t state = 0;
+    if (jl_atomic_cmpswap(&lock->futex, &state, 1)) {
+        jl_atomic_store_relaxed(&lock->owner, self);
+        lock->count = 1;
+        return 1;
+    }
+#else
     if (owner == NULL && jl_atomic_cmpswap(&lock->owner, &owner, self)) {
         lock->count = 1;
         return 1;
     }
+#endif
     return 0;
 }
 
@@ -930,6 +1274,11 @@ void _jl_mutex_unlock_nogc(jl_mutex_t *lock)
     if (--lock->count == 0) {
         jl_profile_lock_release_start(lock);
         jl_atomic_store_release(&lock->owner, (jl_task_t*)NULL);
+#ifdef JL_MUTEX_FUTEX
+        if (jl_atomic_exchange(&lock->futex, 0) == 2)
+            jl_futex_wake_one(&lock->futex);
+        jl_cpu_wake();
+#else
         jl_cpu_wake();
         if (jl_running_under_rr(0)) {
             // when running under `rr`, use system mutexes rather than spin locking
@@ -937,6 +1286,7 @@ void _jl_mutex_unlock_nogc(jl_mutex_t *lock)
             uv_cond_broadcast(&cond);
             uv_mutex_unlock(&tls_lock);
         }
+#endif
         jl_profile_lock_release_end(lock);
     }
 #endif
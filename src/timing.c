@@ -6,7 +6,10 @@
 #include "options.h"
 #include "stdio.h"
 
-#if defined(USE_TRACY) || defined(USE_ITTAPI)
+// The counts backend wants every zone; the event-stream backends (including
+// the always-built trace rings) disable the highest-frequency subsystems by
+// default to keep overhead and output volume down.
+#if defined(USE_TRACY) || defined(USE_ITTAPI) || !defined(USE_TIMING_COUNTS)
 #define DISABLE_FREQUENT_EVENTS
 #endif
 
@@ -16,6 +19,91 @@ jl_module_t *jl_module_root(jl_module_t *m);
 extern "C" {
 #endif
 
+// Startup phase tracer
+//
+// The zone backends below require an instrumented build (Tracy, ITTAPI or
+// USE_TIMING_COUNTS), which makes them useless for explaining a slow start
+// on a stock binary. This tracer is therefore compiled unconditionally and
+// enabled at runtime by pointing JULIA_TRACE_STARTUP at an output file: it
+// records begin/end timestamps for the coarse phases of `julia_init`, image
+// restore and dynamic library loading, and writes them as chrome-trace JSON
+// (viewable at chrome://tracing or https://ui.perfetto.dev) when the process
+// exits. Recording stops once the fixed event buffer fills up; this is a
+// startup tracer, not a general profiler.
+
+#define STARTUP_TRACE_MAX_EVENTS 2048
+
+typedef struct {
+    const char *name; // owned (strdup'd at record time)
+    uint64_t t;
+    uint64_t tid;
+    uint8_t begin;
+} startup_trace_event_t;
+
+static startup_trace_event_t startup_trace_events[STARTUP_TRACE_MAX_EVENTS];
+static _Atomic(int) startup_trace_nevents;
+static const char *startup_trace_file = NULL;
+static uint64_t startup_trace_t0;
+
+void jl_startup_trace_init(void)
+{
+    const char *file = getenv("JULIA_TRACE_STARTUP");
+    if (file == NULL || file[0] == '\0')
+        return;
+    startup_trace_t0 = jl_hrtime();
+    startup_trace_file = file;
+}
+
+static void startup_trace_record(const char *name, uint8_t begin) JL_NOTSAFEPOINT
+{
+    if (startup_trace_file == NULL)
+        return;
+    int i = jl_atomic_fetch_add_relaxed(&startup_trace_nevents, 1);
+    if (i >= STARTUP_TRACE_MAX_EVENTS)
+        return;
+    startup_trace_events[i].name = strdup(name);
+    startup_trace_events[i].t = jl_hrtime();
+    startup_trace_events[i].tid = (uint64_t)(uintptr_t)uv_thread_self();
+    startup_trace_events[i].begin = begin;
+}
+
+void jl_startup_trace_enter(const char *phase) JL_NOTSAFEPOINT
+{
+    startup_trace_record(phase, 1);
+}
+
+void jl_startup_trace_exit(const char *phase) JL_NOTSAFEPOINT
+{
+    startup_trace_record(phase, 0);
+}
+
+void jl_startup_trace_flush(void)
+{
+    if (startup_trace_file == NULL)
+        return;
+    FILE *f = fopen(startup_trace_file, "w");
+    if (f == NULL) {
+        jl_safe_printf("WARNING: could not write startup trace to \"%s\"\n", startup_trace_file);
+        startup_trace_file = NULL;
+        return;
+    }
+    int n = jl_atomic_load_relaxed(&startup_trace_nevents);
+    if (n > STARTUP_TRACE_MAX_EVENTS)
+        n = STARTUP_TRACE_MAX_EVENTS;
+    fprintf(f, "{\"traceEvents\":[\n");
+    for (int i = 0; i < n; i++) {
+        startup_trace_event_t *ev = &startup_trace_events[i];
+        // timestamps are in microseconds per the chrome-trace format
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"%s\",\"pid\":1,\"tid\":%" PRIu64 ",\"ts\":%.3f}%s\n",
+                ev->name, ev->begin ? "B" : "E", ev->tid,
+                (ev->t - startup_trace_t0) / 1e3, i + 1 < n ? "," : "");
+        free((void*)ev->name);
+    }
+    fprintf(f, "]}\n");
+    fclose(f);
+    startup_trace_file = NULL; // startup is over; drop any later events
+}
+
 #ifdef ENABLE_TIMINGS
 
 #ifndef HAVE_TIMING_SUPPORT
@@ -109,12 +197,111 @@ static int indirect_strcmp(const void *a, const void *b) {
     return strcmp(*(const char **)a, *(const char **)b);
 }
 
+/**
+ * Timing Backend: lock-free trace rings
+ *
+ * Always compiled, unlike the backends above, so a stock binary can be traced
+ * in production: each thread appends zone begin/end records to its own
+ * fixed-size ring buffer, overwriting the oldest once full, and
+ * jl_timing_trace_dump writes whatever the rings still hold as chrome-trace
+ * JSON (chrome://tracing or https://ui.perfetto.dev). With the trace disabled
+ * (the default) a zone pays one relaxed atomic load; enabled, a timestamp and
+ * a store into the owner's ring, so it can stay on in services. The dump may
+ * race with recording threads: a slot overwritten mid-read yields one garbled
+ * record (the names are interned event names, so never a dangling pointer),
+ * and a begin whose end was overwritten shows up unmatched, which the viewers
+ * tolerate.
+ **/
+
+#define TRACE_RING_SIZE (1 << 13) // records per thread; must be a power of two
+
+typedef struct {
+    const char *name; // event name (lives forever, see _jl_timing_event_create)
+    uint64_t t;
+    uint8_t begin;
+} jl_trace_record_t;
+
+typedef struct _jl_trace_ring_t {
+    struct _jl_trace_ring_t *next; // list of all rings, under trace_rings_lock
+    uint64_t tid;
+    _Atomic(uint64_t) head;        // records written; only the owner advances it
+    jl_trace_record_t slots[TRACE_RING_SIZE];
+} jl_trace_ring_t;
+
+static _Atomic(int) jl_trace_enabled;
+static uv_mutex_t trace_rings_lock; // guards the ring list; init in jl_init_timing
+static jl_trace_ring_t *trace_rings = NULL;
+static __thread jl_trace_ring_t *trace_ring = NULL;
+static uint64_t trace_t0;
+
+static jl_trace_ring_t *jl_trace_ring_create(void) JL_NOTSAFEPOINT
+{
+    jl_trace_ring_t *ring = (jl_trace_ring_t*)calloc_s(sizeof(jl_trace_ring_t));
+    ring->tid = (uint64_t)(uintptr_t)uv_thread_self();
+    uv_mutex_lock(&trace_rings_lock);
+    ring->next = trace_rings;
+    trace_rings = ring;
+    uv_mutex_unlock(&trace_rings_lock);
+    trace_ring = ring;
+    return ring;
+}
+
+void _jl_timing_trace_record(jl_timing_event_t *event, uint8_t begin) JL_NOTSAFEPOINT
+{
+    if (!jl_atomic_load_relaxed(&jl_trace_enabled))
+        return;
+    jl_trace_ring_t *ring = trace_ring;
+    if (ring == NULL)
+        ring = jl_trace_ring_create();
+    uint64_t head = jl_atomic_load_relaxed(&ring->head);
+    jl_trace_record_t *rec = &ring->slots[head & (TRACE_RING_SIZE - 1)];
+    rec->name = event->trace_name;
+    rec->t = jl_hrtime();
+    rec->begin = begin;
+    jl_atomic_store_release(&ring->head, head + 1); // publish the record
+}
+
+JL_DLLEXPORT void jl_timing_trace_enable(int enabled)
+{
+    if (enabled && trace_t0 == 0)
+        trace_t0 = jl_hrtime();
+    jl_atomic_store_release(&jl_trace_enabled, !!enabled);
+}
+
+JL_DLLEXPORT int jl_timing_trace_dump(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return -1;
+    fprintf(f, "{\"traceEvents\":[\n");
+    uv_mutex_lock(&trace_rings_lock);
+    int first = 1;
+    for (jl_trace_ring_t *ring = trace_rings; ring != NULL; ring = ring->next) {
+        uint64_t head = jl_atomic_load_acquire(&ring->head);
+        uint64_t lo = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+        for (uint64_t i = lo; i < head; i++) {
+            jl_trace_record_t *rec = &ring->slots[i & (TRACE_RING_SIZE - 1)];
+            // timestamps are in microseconds per the chrome-trace format
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"%s\",\"pid\":1,\"tid\":%" PRIu64 ",\"ts\":%.3f}",
+                    first ? "" : ",\n", rec->name, rec->begin ? "B" : "E",
+                    ring->tid, (rec->t - trace_t0) / 1e3);
+            first = 0;
+        }
+    }
+    uv_mutex_unlock(&trace_rings_lock);
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return 0;
+}
+
 void jl_init_timing(void)
 {
     t0 = cycleclock();
 
     _Static_assert(JL_TIMING_SUBSYSTEM_LAST < sizeof(uint64_t) * CHAR_BIT, "Too many timing subsystems!");
 
+    uv_mutex_init(&trace_rings_lock);
+
 #ifdef USE_TIMING_COUNTS
     JL_MUTEX_INIT(&jl_timing_counts_events_lock, "jl_timing_counts_events_lock");
 
@@ -181,6 +368,12 @@ void jl_init_timing(void)
     // Apply e.g. JULIA_TIMING_SUBSYSTEMS="+GC,-INFERENCE" and
     //            JULIA_TIMING_METADATA_PRINT_LIMIT=20
     jl_timing_apply_env();
+
+    // JULIA_TRACE_EVENTS=<file> keeps the ring trace running for the whole
+    // session; jl_destroy_timing dumps it at exit
+    const char *trace_env = getenv("JULIA_TRACE_EVENTS");
+    if (trace_env && trace_env[0])
+        jl_timing_trace_enable(1);
 }
 
 void jl_destroy_timing(void)
@@ -191,6 +384,13 @@ void jl_destroy_timing(void)
         jl_timing_block_end(stack);
         stack = stack->prev;
     }
+
+    const char *trace_env = getenv("JULIA_TRACE_EVENTS");
+    if (trace_env && trace_env[0] && jl_atomic_load_relaxed(&jl_trace_enabled)) {
+        jl_timing_trace_enable(0);
+        if (jl_timing_trace_dump(trace_env))
+            jl_safe_printf("WARNING: could not write timing trace to \"%s\"\n", trace_env);
+    }
 }
 
 static const int get_timing_subsystem(const char *subsystem) {
@@ -308,6 +508,7 @@ JL_DLLEXPORT jl_timing_event_t *_jl_timing_event_create(const char *subsystem, c
 
     jl_timing_event_t *event = (jl_timing_event_t *) malloc(sizeof(jl_timing_event_t));
     event->subsystem = maybe_subsystem;
+    event->trace_name = name;
 
 #ifdef USE_TIMING_COUNTS
     event->counts_event = _jl_timing_counts_event_create(name);
@@ -348,6 +549,7 @@ JL_DLLEXPORT void _jl_timing_block_start(jl_timing_block_t *block) {
     _COUNTS_START(&block->counts_ctx, t);
     _ITTAPI_START(block);
     _TRACY_START(block);
+    _TRACE_START(block);
 
     jl_timing_block_t **prevp = &jl_current_task->ptls->timing_stack;
     block->prev = *prevp;
@@ -363,6 +565,7 @@ JL_DLLEXPORT void _jl_timing_block_end(jl_timing_block_t *block) {
         uint64_t t = cycleclock(); (void)t;
         _ITTAPI_STOP(block);
         _TRACY_STOP(block->tracy_ctx);
+        _TRACE_STOP(block);
         _COUNTS_STOP(block, t);
 
         jl_task_t *ct = jl_current_task;
@@ -675,6 +878,9 @@ JL_DLLEXPORT void _jl_timing_block_end(jl_timing_block_t *block) { }
 JL_DLLEXPORT int jl_timing_set_enable(const char *subsystem, uint8_t enabled) { return -1; }
 JL_DLLEXPORT uint32_t jl_timing_print_limit = 0;
 
+JL_DLLEXPORT void jl_timing_trace_enable(int enabled) { }
+JL_DLLEXPORT int jl_timing_trace_dump(const char *path) { return -1; }
+
 #endif
 
 #ifdef __cplusplus
@@ -30,6 +30,15 @@ extern "C" {
 void jl_init_timing(void);
 void jl_destroy_timing(void) JL_NOTSAFEPOINT;
 
+// Startup phase tracer (compiled unconditionally, unlike the zone backends
+// below). Enabled by JULIA_TRACE_STARTUP=<file>; records begin/end pairs
+// for the named startup phases and flushes them as chrome-trace JSON at
+// process exit. See timing.c for details.
+void jl_startup_trace_init(void);
+void jl_startup_trace_enter(const char *phase) JL_NOTSAFEPOINT;
+void jl_startup_trace_exit(const char *phase) JL_NOTSAFEPOINT;
+void jl_startup_trace_flush(void);
+
 // Update the enable bit-mask to enable/disable tracing events for
 // the subsystem in `jl_timing_subsystems` matching the provided string.
 //
@@ -47,6 +56,14 @@ JL_DLLEXPORT int jl_timing_set_enable(const char *subsystem, uint8_t enabled);
 //     JULIA_TIMING_METADATA_PRINT_LIMIT=20
 void jl_timing_apply_env(void);
 
+// Runtime-switchable trace of the JL_TIMING zones into per-thread lock-free
+// ring buffers, compiled into every build (unlike the optional backends, which
+// need a rebuild). jl_timing_trace_dump snapshots whatever the rings still
+// hold as chrome-trace JSON; JULIA_TRACE_EVENTS=<file> enables the trace at
+// startup and dumps it at exit. See timing.c for details.
+JL_DLLEXPORT void jl_timing_trace_enable(int enabled);
+JL_DLLEXPORT int jl_timing_trace_dump(const char *path);
+
 // Configurable item limit, runtime code should use this to limit printing
 // when adding potentially many items of metadata to a single timing zone.
 extern JL_DLLEXPORT uint32_t jl_timing_print_limit;
@@ -66,9 +83,10 @@ JL_DLLEXPORT void _jl_timing_block_end(jl_timing_block_t *cur_block);
 #define HAVE_TIMING_SUPPORT
 #endif
 
-#if defined( USE_TRACY ) || defined( USE_ITTAPI ) || defined( USE_TIMING_COUNTS )
+// The trace-ring backend below is always built, so the zone machinery is
+// compiled into every build that supports it; Tracy, ITTAPI and the counts
+// backend remain optional additions on top.
 #define ENABLE_TIMINGS
-#endif
 
 #if !defined( ENABLE_TIMINGS ) || !defined( HAVE_TIMING_SUPPORT )
 
@@ -120,6 +138,8 @@ extern "C" {
 #endif
 void jl_print_timings(void);
 
+void _jl_timing_trace_record(jl_timing_event_t *event, uint8_t begin) JL_NOTSAFEPOINT;
+
 void jl_timing_task_init(jl_task_t *t);
 void jl_timing_block_task_enter(jl_task_t *ct, jl_ptls_t ptls, jl_timing_block_t *prev_blk);
 jl_timing_block_t *jl_timing_block_task_exit(jl_task_t *ct, jl_ptls_t ptls);
@@ -276,6 +296,14 @@ typedef struct _jl_timing_counts_t {
 #define _ITTAPI_STOP(block)
 #endif
 
+/**
+ * Timing Backend: lock-free trace rings (always built; implemented in timing.c)
+ **/
+
+#define _TRACE_EVENT_MEMBER               const char *trace_name;
+#define _TRACE_START(block)               _jl_timing_trace_record((block)->event, 1)
+#define _TRACE_STOP(block)                _jl_timing_trace_record((block)->event, 0)
+
 /**
  * Top-level jl_timing implementation
  **/
@@ -293,6 +321,7 @@ struct _jl_timing_event_t { // typedef in julia.h
     _TRACY_EVENT_MEMBER
     _ITTAPI_EVENT_MEMBER
     _COUNTS_EVENT_MEMBER
+    _TRACE_EVENT_MEMBER
 
     int subsystem;
 };
@@ -572,6 +572,140 @@ int jl_is_toplevel_only_expr(jl_value_t *e) JL_NOTSAFEPOINT
          ((jl_expr_t*)e)->head == jl_incomplete_sym);
 }
 
+// --- cache of lowered toplevel thunks ---
+//
+// Config-style workloads evaluate structurally identical toplevel
+// expressions thousands of times, paying for lowering each time. Lowering is
+// reproducible for macro-free input given the module and source location, so
+// the expansion can be keyed by an AST hash and reused. Thunks that define
+// methods, types or opaque closures are never cached, since their lowering
+// mints fresh per-module names on every expansion.
+
+#define LOWERED_CACHE_SZ 256
+
+typedef struct {
+    uint64_t hash;
+    size_t lineno;
+    jl_sym_t *file; // interned, so needs no rooting
+} lowered_cache_meta_t;
+
+static lowered_cache_meta_t lowered_cache_meta[LOWERED_CACHE_SZ];
+// (expr, module, expansion) triples, direct-mapped; rooted by the GC
+jl_array_t *jl_lowered_cache = NULL;
+jl_mutex_t lowered_cache_lock;
+
+// structural AST hash/equality, shared with the macro-expansion memo table
+// (see ast.c)
+uint64_t jl_ast_hash(jl_value_t *v)
+{
+    if (jl_is_expr(v)) {
+        jl_expr_t *e = (jl_expr_t*)v;
+        uint64_t h = jl_object_id((jl_value_t*)e->head);
+        size_t i, l = jl_expr_nargs(e);
+        for (i = 0; i < l; i++)
+            h = bitmix(h, jl_ast_hash(jl_exprarg(e, i)));
+        return h;
+    }
+    if (jl_is_quotenode(v))
+        return bitmix(0x5bca7c69b794f8ce, jl_ast_hash(jl_quotenode_value(v)));
+    // immutable leaves hash structurally, mutable ones by identity, matching
+    // the jl_egal comparison in jl_ast_eq
+    return jl_object_id(v);
+}
+
+int jl_ast_eq(jl_value_t *a, jl_value_t *b) JL_NOTSAFEPOINT
+{
+    if (a == b)
+        return 1;
+    if (jl_typeof(a) != jl_typeof(b))
+        return 0;
+    if (jl_is_expr(a)) {
+        jl_expr_t *ea = (jl_expr_t*)a, *eb = (jl_expr_t*)b;
+        size_t i, l = jl_expr_nargs(ea);
+        if (ea->head != eb->head || l != jl_expr_nargs(eb))
+            return 0;
+        for (i = 0; i < l; i++)
+            if (!jl_ast_eq(jl_exprarg(ea, i), jl_exprarg(eb, i)))
+                return 0;
+        return 1;
+    }
+    if (jl_is_quotenode(a))
+        return jl_ast_eq(jl_quotenode_value(a), jl_quotenode_value(b));
+    return jl_egal(a, b);
+}
+
+// the expansion of a macro call can change over time, so only macro-free
+// expressions lower reproducibly
+static int lowered_ast_cacheable(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    if (!jl_is_expr(v))
+        return 1;
+    jl_expr_t *e = (jl_expr_t*)v;
+    if (e->head == jl_macrocall_sym)
+        return 0;
+    size_t i, l = jl_expr_nargs(e);
+    for (i = 0; i < l; i++)
+        if (!lowered_ast_cacheable(jl_exprarg(e, i)))
+            return 0;
+    return 1;
+}
+
+static jl_value_t *lowered_cache_lookup(jl_value_t *e, jl_module_t *m, uint64_t h,
+                                        jl_sym_t *file, size_t lineno)
+{
+    size_t slot = (size_t)(h % LOWERED_CACHE_SZ);
+    jl_value_t *expansion = NULL;
+    JL_LOCK_NOGC(&lowered_cache_lock);
+    if (jl_lowered_cache != NULL) {
+        lowered_cache_meta_t *meta = &lowered_cache_meta[slot];
+        jl_value_t *key = jl_array_ptr_ref(jl_lowered_cache, 3 * slot);
+        if (key != NULL && meta->hash == h && meta->lineno == lineno && meta->file == file &&
+            jl_array_ptr_ref(jl_lowered_cache, 3 * slot + 1) == (jl_value_t*)m &&
+            jl_ast_eq(key, e))
+            expansion = jl_array_ptr_ref(jl_lowered_cache, 3 * slot + 2);
+    }
+    JL_UNLOCK_NOGC(&lowered_cache_lock);
+    return expansion;
+}
+
+static void lowered_cache_store(jl_value_t *e, jl_module_t *m, uint64_t h,
+                                jl_sym_t *file, size_t lineno, jl_value_t *expansion)
+{
+    // only plain thunks are reusable (see above)
+    if (!jl_is_expr(expansion) || ((jl_expr_t*)expansion)->head != jl_thunk_sym ||
+        jl_expr_nargs(expansion) != 1)
+        return;
+    jl_value_t *thk = jl_exprarg(expansion, 0);
+    if (!jl_is_code_info(thk) || !jl_typetagis(((jl_code_info_t*)thk)->code, jl_array_any_type))
+        return;
+    int has_ccall = 0, has_defs = 0, has_loops = 0, has_opaque = 0, forced_compile = 0;
+    body_attributes((jl_array_t*)((jl_code_info_t*)thk)->code,
+                    &has_ccall, &has_defs, &has_loops, &has_opaque, &forced_compile);
+    if (has_defs || has_opaque)
+        return;
+    // the caller may mutate its expression after eval; key on a private copy
+    jl_value_t *key = NULL;
+    JL_GC_PUSH2(&key, &expansion);
+    key = jl_copy_ast(e);
+    if (jl_lowered_cache == NULL) {
+        jl_array_t *a = jl_alloc_vec_any(3 * LOWERED_CACHE_SZ);
+        JL_LOCK_NOGC(&lowered_cache_lock);
+        if (jl_lowered_cache == NULL)
+            jl_lowered_cache = a;
+        JL_UNLOCK_NOGC(&lowered_cache_lock);
+    }
+    size_t slot = (size_t)(h % LOWERED_CACHE_SZ);
+    JL_LOCK_NOGC(&lowered_cache_lock);
+    lowered_cache_meta[slot].hash = h;
+    lowered_cache_meta[slot].lineno = lineno;
+    lowered_cache_meta[slot].file = file;
+    jl_array_ptr_set(jl_lowered_cache, 3 * slot, key);
+    jl_array_ptr_set(jl_lowered_cache, 3 * slot + 1, (jl_value_t*)m);
+    jl_array_ptr_set(jl_lowered_cache, 3 * slot + 2, expansion);
+    JL_UNLOCK_NOGC(&lowered_cache_lock);
+    JL_GC_POP();
+}
+
 int jl_needs_lowering(jl_value_t *e) JL_NOTSAFEPOINT
 {
     if (!jl_is_expr(e))
@@ -731,9 +865,25 @@ jl_value_t *jl_toplevel_eval_flex(jl_module_t *JL_NONNULL m, jl_value_t *e, int
 
     size_t last_age = ct->world_age;
     if (!expanded && jl_needs_lowering(e)) {
-        ct->world_age = jl_atomic_load_acquire(&jl_world_counter);
-        ex = (jl_expr_t*)jl_expand_with_loc_warn(e, m, jl_filename, jl_lineno);
-        ct->world_age = last_age;
+        uint64_t ast_hash = 0;
+        jl_sym_t *file = NULL;
+        jl_value_t *expansion = NULL;
+        int cacheable = lowered_ast_cacheable(e);
+        if (cacheable) {
+            ast_hash = jl_ast_hash(e);
+            file = jl_symbol(jl_filename);
+            expansion = lowered_cache_lookup(e, m, ast_hash, file, jl_lineno);
+        }
+        if (expansion != NULL) {
+            ex = (jl_expr_t*)expansion;
+        }
+        else {
+            ct->world_age = jl_atomic_load_acquire(&jl_world_counter);
+            ex = (jl_expr_t*)jl_expand_with_loc_warn(e, m, jl_filename, jl_lineno);
+            ct->world_age = last_age;
+            if (cacheable)
+                lowered_cache_store(e, m, ast_hash, file, jl_lineno, (jl_value_t*)ex);
+        }
     }
     jl_sym_t *head = jl_is_expr(ex) ? ex->head : NULL;
 
@@ -1104,7 +1104,14 @@ jl_typemap_entry_t *jl_typemap_assoc_by_type(
             return jl_typemap_assoc_by_type(jl_atomic_load_relaxed(&cache->any), search, offs + 1, subtype);
         }
         else {
-            return jl_typemap_entry_lookup_by_type(jl_atomic_load_relaxed(&cache->linear), search);
+            jl_typemap_entry_t *li = jl_typemap_entry_lookup_by_type(jl_atomic_load_relaxed(&cache->linear), search);
+            if (li) return li;
+            // entries that constrain this argument may have overflowed into
+            // the `any` subtree (see jl_typemap_level_insert_)
+            jl_typemap_t *cacheany = jl_atomic_load_relaxed(&cache->any);
+            if (cacheany == (jl_typemap_t*)jl_nothing)
+                return NULL;
+            return jl_typemap_assoc_by_type(cacheany, search, offs + 1, subtype);
         }
     }
     else {
@@ -1295,16 +1302,31 @@ static void jl_typemap_level_insert_(jl_typemap_t *map, jl_typemap_level_t *cach
 static jl_typemap_level_t *jl_new_typemap_level(void)
 {
     jl_task_t *ct = jl_current_task;
-    jl_typemap_level_t *cache =
-        (jl_typemap_level_t*)jl_gc_alloc(ct->ptls, sizeof(jl_typemap_level_t),
-                                         jl_typemap_level_type);
-    jl_atomic_store_relaxed(&cache->arg1, (jl_genericmemory_t*)jl_an_empty_memory_any);
-    jl_atomic_store_relaxed(&cache->targ, (jl_genericmemory_t*)jl_an_empty_memory_any);
-    jl_atomic_store_relaxed(&cache->name1, (jl_genericmemory_t*)jl_an_empty_memory_any);
-    jl_atomic_store_relaxed(&cache->tname, (jl_genericmemory_t*)jl_an_empty_memory_any);
-    jl_atomic_store_relaxed(&cache->linear, (jl_typemap_entry_t*)jl_nothing);
-    jl_atomic_store_relaxed(&cache->any, jl_nothing);
-    return cache;
+    jl_ptls_t ptls = ct->ptls;
+    if (ptls->typemap_level_pool_len == 0) {
+        // Refill the per-thread pool in one burst: consecutive allocations of
+        // the same size class come from the same freshly carved GC page, so
+        // the interior nodes of a typemap tree built on this thread end up
+        // adjacent in memory rather than interleaved with the entries and
+        // svecs allocated between levels. The spares are fully initialized
+        // and scanned as thread-local roots (gc_queue_thread_local); dropping
+        // a table still bulk-frees its whole tree in the following sweep.
+        for (int i = 0; i < JL_TYPEMAP_LEVEL_POOL_LEN; i++) {
+            jl_typemap_level_t *node =
+                (jl_typemap_level_t*)jl_gc_alloc(ptls, sizeof(jl_typemap_level_t),
+                                                 jl_typemap_level_type);
+            jl_atomic_store_relaxed(&node->arg1, (jl_genericmemory_t*)jl_an_empty_memory_any);
+            jl_atomic_store_relaxed(&node->targ, (jl_genericmemory_t*)jl_an_empty_memory_any);
+            jl_atomic_store_relaxed(&node->name1, (jl_genericmemory_t*)jl_an_empty_memory_any);
+            jl_atomic_store_relaxed(&node->tname, (jl_genericmemory_t*)jl_an_empty_memory_any);
+            jl_atomic_store_relaxed(&node->linear, (jl_typemap_entry_t*)jl_nothing);
+            jl_atomic_store_relaxed(&node->any, jl_nothing);
+            ptls->typemap_level_pool[i] = node;
+            // extend the scanned range only once the slot holds a valid node
+            ptls->typemap_level_pool_len = i + 1;
+        }
+    }
+    return ptls->typemap_level_pool[--ptls->typemap_level_pool_len];
 }
 
 static void jl_typemap_memory_insert_(
@@ -1477,6 +1499,19 @@ static void jl_typemap_level_insert_(
             return;
         }
     }
+    // The type at `offs` had no usable hash key (a Vararg, or a Union or
+    // TypeVar without a single extractable name), so this entry would go on
+    // the linear list. If that list is already long and the signature has more
+    // arguments past `offs`, send it into the `any` subtree instead: the next
+    // level can then index it by whichever later argument does discriminate.
+    // This is safe since every lookup also searches `any` (entries found there
+    // are still checked against their full signature), but the `!subtype` case
+    // of jl_typemap_assoc_by_type must look there too.
+    if (l > offs + 1 &&
+        jl_typemap_list_count_locked(jl_atomic_load_relaxed(&cache->linear)) >= MAX_METHLIST_COUNT) {
+        jl_typemap_insert_generic(map, &cache->any, (jl_value_t*)cache, newrec, 0, offs+1, NULL);
+        return;
+    }
     jl_typemap_list_insert_(map, &cache->linear, (jl_value_t*)cache, newrec);
 }
 
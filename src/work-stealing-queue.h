@@ -17,12 +17,23 @@ extern "C" {
 // * Chase D., Lev Y. Dynamic Circular Work-Stealing queue
 // * Le N. M. et al. Correct and Efficient Work-Stealing for
 //   Weak Memory Models
+//
+// Growth is segmented instead of copying: when the queue is full, push links
+// a new array in front of the old one rather than copying the live elements
+// over. Each array covers the absolute indices at and above its `split`;
+// lookups for older indices walk the `prev` chain. A segment can only be
+// freed once `top` has passed its covered range (and then only at a point
+// where no thief can still be reading it, see `reclaim_set` in gc.c).
 // =======
 
-typedef struct {
+typedef struct _ws_array_t {
     char *buffer;
     int32_t capacity;
     int32_t mask;
+    // first absolute index covered by this array; older indices live in the
+    // `prev` chain (segmented growth, see ws_queue_push)
+    int64_t split;
+    _Atomic(struct _ws_array_t *) prev;
 } ws_array_t;
 
 static inline ws_array_t *create_ws_array(size_t capacity, int32_t eltsz) JL_NOTSAFEPOINT
@@ -31,9 +42,27 @@ static inline ws_array_t *create_ws_array(size_t capacity, int32_t eltsz) JL_NOT
     a->buffer = (char *)malloc_s(capacity * eltsz);
     a->capacity = capacity;
     a->mask = capacity - 1;
+    a->split = 0;
+    jl_atomic_store_relaxed(&a->prev, NULL);
     return a;
 }
 
+// Locate the slot for absolute index `idx`, walking back through older
+// segments for indices below the newest segment's `split`. Observing a
+// detached `prev` (NULL while `idx` is still below `split`) is only possible
+// for a thief acting on a stale `top`; any valid slot may be returned then,
+// since that thief's CAS on `top` is bound to fail.
+static inline char *ws_array_slot(ws_array_t *ary, int64_t idx, int32_t eltsz) JL_NOTSAFEPOINT
+{
+    while (idx < ary->split) {
+        ws_array_t *prev = jl_atomic_load_relaxed(&ary->prev);
+        if (prev == NULL)
+            break;
+        ary = prev;
+    }
+    return ary->buffer + (idx & ary->mask) * eltsz;
+}
+
 typedef struct {
     _Atomic(int64_t) top;
     _Atomic(int64_t) bottom;
@@ -47,20 +76,52 @@ static inline ws_array_t *ws_queue_push(ws_queue_t *q, void *elt, int32_t eltsz)
     ws_array_t *ary = jl_atomic_load_relaxed(&q->array);
     ws_array_t *old_ary = NULL;
     if (__unlikely(b - t > ary->capacity - 1)) {
+        // grow by linking a new segment in front of the full one instead of
+        // copying; the live elements stay where they are and are consumed in
+        // place, so enqueue cost stays O(1) even during spawn storms
         ws_array_t *new_ary = create_ws_array(2 * ary->capacity, eltsz);
-        for (int i = 0; i < ary->capacity; i++) {
-            memcpy(new_ary->buffer + ((t + i) & new_ary->mask) * eltsz, ary->buffer + ((t + i) & ary->mask) * eltsz, eltsz);
+        new_ary->split = b;
+        jl_atomic_store_relaxed(&new_ary->prev, ary);
+        if (t >= ary->split) {
+            // `top` never decreases, so every index any thread can still
+            // access legitimately is covered by `ary` or newer; hand the
+            // chain behind it to the caller for deferred freeing
+            old_ary = jl_atomic_load_relaxed(&ary->prev);
+            jl_atomic_store_relaxed(&ary->prev, NULL);
         }
         jl_atomic_store_release(&q->array, new_ary);
-        old_ary = ary;
         ary = new_ary;
     }
-    memcpy(ary->buffer + (b & ary->mask) * eltsz, elt, eltsz);
+    memcpy(ws_array_slot(ary, b, eltsz), elt, eltsz);
     jl_fence_release();
     jl_atomic_store_relaxed(&q->bottom, b + 1);
     return old_ary;
 }
 
+// Free a segment chain handed out by ws_queue_push. Must only be called once
+// no thread can still be reading the segments (thieves holding a stale `top`
+// may probe a dead segment until they next synchronize on `top`).
+static inline void free_ws_array_chain(ws_array_t *a) JL_NOTSAFEPOINT
+{
+    while (a != NULL) {
+        ws_array_t *prev = jl_atomic_load_relaxed(&a->prev);
+        free(a->buffer);
+        free(a);
+        a = prev;
+    }
+}
+
+// Collapse the queue back to its newest segment, freeing the older ones.
+// Must only be called while the queue is empty and no other thread is
+// operating on it (e.g. when its indices are reset between GC mark phases).
+static inline void ws_queue_collapse(ws_queue_t *q) JL_NOTSAFEPOINT
+{
+    ws_array_t *ary = jl_atomic_load_relaxed(&q->array);
+    free_ws_array_chain(jl_atomic_load_relaxed(&ary->prev));
+    jl_atomic_store_relaxed(&ary->prev, NULL);
+    ary->split = 0;
+}
+
 static inline void ws_queue_pop(ws_queue_t *q, void *dest, int32_t eltsz) JL_NOTSAFEPOINT
 {
     int64_t b = jl_atomic_load_relaxed(&q->bottom) - 1;
@@ -69,7 +130,7 @@ static inline void ws_queue_pop(ws_queue_t *q, void *dest, int32_t eltsz) JL_NOT
     jl_fence();
     int64_t t = jl_atomic_load_relaxed(&q->top);
     if (__likely(t <= b)) {
-        memcpy(dest, ary->buffer + (b & ary->mask) * eltsz, eltsz);
+        memcpy(dest, ws_array_slot(ary, b, eltsz), eltsz);
         if (t == b) {
             if (!jl_atomic_cmpswap(&q->top, &t, t + 1))
                 memset(dest, 0, eltsz);
@@ -89,12 +150,42 @@ static inline void ws_queue_steal_from(ws_queue_t *q, void *dest, int32_t eltsz)
     int64_t b = jl_atomic_load_acquire(&q->bottom);
     if (t < b) {
         ws_array_t *ary = jl_atomic_load_relaxed(&q->array);
-        memcpy(dest, ary->buffer + (t & ary->mask) * eltsz, eltsz);
+        memcpy(dest, ws_array_slot(ary, t, eltsz), eltsz);
         if (!jl_atomic_cmpswap(&q->top, &t, t + 1))
             memset(dest, 0, eltsz);
     }
 }
 
+// Steal up to `n` elements from `q` into `dest`, but never more than half of
+// what the victim appears to own, so the victim is left with work of its own.
+// Returns the number of elements stolen. Each element is claimed with its own
+// CAS on `top` — claiming a whole range with one CAS is unsound here because
+// the owner's pop only synchronizes through `top` for the very last element —
+// but a batch amortizes victim selection and the failure/empty probes across
+// `n` elements. Stops at the first conflict instead of retrying the victim.
+static inline int32_t ws_queue_steal_batch_from(ws_queue_t *q, void *dest, int32_t eltsz, int32_t n) JL_NOTSAFEPOINT
+{
+    int32_t nstolen = 0;
+    while (nstolen < n) {
+        int64_t t = jl_atomic_load_acquire(&q->top);
+        jl_fence();
+        int64_t b = jl_atomic_load_acquire(&q->bottom);
+        if (t >= b)
+            break;
+        if (nstolen == 0) {
+            int64_t half = (b - t + 1) / 2;
+            if (half < n)
+                n = (int32_t)half;
+        }
+        ws_array_t *ary = jl_atomic_load_relaxed(&q->array);
+        memcpy((char *)dest + nstolen * eltsz, ws_array_slot(ary, t, eltsz), eltsz);
+        if (!jl_atomic_cmpswap(&q->top, &t, t + 1))
+            break;
+        nstolen++;
+    }
+    return nstolen;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,7 @@ end
                             ("--compile=no",    false),
                             ("--compile=all",   false),
                             ("--compile=min",   false),
+                            ("--compile=tiered", false),
                             ("--compile=yes",   true),
 
                             ("--code-coverage=@",    false),
@@ -819,6 +820,29 @@ let exename = `$(Base.julia_cmd()) --startup-file=no --color=no`
         "Bool(Base.JLOptions().use_compiled_modules)"`) == "false"
     @test errors_not_signals(`$exename --compiled-modules=foo -e "exit(0)"`)
 
+    # --compile=tiered: code starts out interpreted and is promoted to the JIT
+    # once it gets hot (TIER0_PROMOTE_THRESHOLD calls, see src/options.h)
+    @test readchomp(`$exename --compile=tiered -E
+        "Int(Base.JLOptions().compile_enabled)"`) == "4"
+    let code = """
+        f(x) = 3x
+        s = 0
+        for i in 1:100
+            global s += f(i)
+        end
+        interp = unsafe_load(cglobal(:jl_fptr_interpret_call_addr, Ptr{Cvoid}))
+        mi = which(f, Tuple{Int}).specializations::Core.MethodInstance
+        promoted = false
+        ci = mi.cache
+        while ci isa Core.CodeInstance
+            promoted |= (ci.invoke != C_NULL && ci.invoke != interp)
+            ci = isdefined(ci, :next) ? ci.next : nothing
+        end
+        println(s, ',', promoted)
+        """
+        @test readchomp(`$exename --compile=tiered -e $code`) == "15150,true"
+    end
+
     # issue #12671, starting from a non-directory
     # rm(dir) fails on windows with Permission denied
     # and was an upstream bug in llvm <= v3.3
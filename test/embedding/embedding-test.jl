@@ -23,7 +23,7 @@ end
     @test readline(err) == "MethodError: no method matching this_function_has_no_methods()"
     @test success(p)
     lines = fetch(out_task)
-    @test length(lines) == 11
+    @test length(lines) == 13
     @test parse(Float64, lines[1]) ≈ sqrt(2)
     @test lines[2] == "sqrt(2.0) in C: 1.414214e+00"
     @test lines[3] == "sqrt(2.0) in C: 1.414214e+00"
@@ -31,5 +31,8 @@ end
     @test lines[9] == "called bar"
     @test lines[10] == "calling new bar"
     @test lines[11] == "      From worker 2:\tTaking over the world..."
+    @test lines[12] == "sum of half(1.0:4.0) = 5.000000"
+    @test lines[13] == "sqrt(2.0) in batch: 1.414214e+00"
+    @test readline(err) == "thrown from batch"
     @test readline(err) == "exception caught from C"
 end
@@ -198,6 +198,47 @@ int main()
         jl_value_t *t = jl_typeof(v);
     }
 
+    {
+        // Batched calls sharing one rooted frame
+
+        checked_eval_string("half(x) = x / 2");
+        checked_eval_string("batch_throws() = error(\"thrown from batch\")");
+        jl_function_t *half = jl_get_function(jl_main_module, "half");
+        jl_function_t *sqrt_func = jl_get_function(jl_base_module, "sqrt");
+        jl_function_t *batch_throws = jl_get_function(jl_main_module, "batch_throws");
+
+        jl_call_batch_t *batch = jl_call_batch_begin(1);
+        jl_value_t **roots = jl_call_batch_roots(batch);
+
+        // arguments are not rooted by the call itself; the batch slots keep
+        // them alive across the allocating calls below
+        double total = 0;
+        for (int i = 1; i <= 4; i++) {
+            roots[0] = jl_box_float64(i);
+            jl_value_t *ret = jl_call_batch(batch, half, &roots[0], 1);
+            total += jl_unbox_float64(ret);
+        }
+        printf("sum of half(1.0:4.0) = %f\n", total);
+
+        // resolve the method instance once, then bypass dispatch
+        roots[0] = jl_box_float64(2.0);
+        jl_method_instance_t *mi = jl_call_batch_resolve(batch, sqrt_func, &roots[0], 1);
+        jl_value_t *ret = jl_call_batch_invoke(batch, mi, sqrt_func, &roots[0], 1);
+        printf("sqrt(2.0) in batch: %e\n", jl_unbox_float64(ret));
+        fflush(stdout);
+
+        // an exception inside a batch surfaces as a NULL result
+        ret = jl_call_batch(batch, batch_throws, NULL, 0);
+        if (ret == NULL && jl_exception_occurred()) {
+            jl_call2(jl_get_function(jl_base_module, "showerror"),
+                     jl_stderr_obj(),
+                     jl_exception_occurred());
+            jl_printf(jl_stderr_stream(), "\n");
+        }
+
+        jl_call_batch_end(batch);
+    }
+
     JL_TRY {
         jl_error("exception thrown");
     }
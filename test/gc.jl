@@ -37,3 +37,36 @@ end
 @testset "Base.GC docstrings" begin
     @test isempty(Docs.undocumented_names(GC))
 end
+
+# mirrors jl_gc_pool_stats_t in julia.h
+struct GCPoolStats
+    osize::UInt64
+    npages::UInt64
+    nobjs::UInt64
+    nfree::UInt64
+    nold::UInt64
+end
+
+@testset "jl_gc_pool_stats" begin
+    # allocate a batch of pool objects and sweep so the freelist counts are
+    # fresh when we take the snapshot
+    objs = [Ref(i) for i in 1:100_000]
+    GC.gc()
+    stats = Vector{GCPoolStats}(undef, 64)
+    n = ccall(:jl_gc_pool_stats, Cint, (Ptr{GCPoolStats}, Cint), stats, length(stats))
+    @test 0 < n <= length(stats)
+    resize!(stats, n)
+    for s in stats
+        @test s.osize > 0
+        # a class can never have more cells on its freelists (or holding old
+        # objects) than its pages provide in total
+        @test s.nobjs >= s.nfree
+        @test s.nobjs >= s.nold
+        @test (s.npages == 0) == (s.nobjs == 0)
+    end
+    # the Refs above came from a pool, so pages are assigned and live cells
+    # (cells not sitting on a freelist) must be visible
+    @test any(s -> s.npages > 0, stats)
+    @test sum(s -> s.nobjs - s.nfree, stats) > 0
+    @test !isempty(objs) # keep the objects live across the query
+end
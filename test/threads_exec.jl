@@ -1108,4 +1108,54 @@ end
 @testset "threadcall + threads" begin
     threadcall_threads() #Shouldn't crash!
 end
+
+# arm, cancel, and expiry of the sharded timeout wheel (scheduler.c)
+@testset "task timeouts" begin
+    timeout_start(t::Task, ns) =
+        ccall(:jl_timeout_start, Ptr{Cvoid}, (Any, UInt64), t, UInt64(ns))
+    timeout_cancel(h::Ptr{Cvoid}) =
+        ccall(:jl_timeout_cancel, Cint, (Ptr{Cvoid},), h)
+
+    # arm-then-cancel: a winning cancel means the timeout will never fire and
+    # waking the task is back in our hands (here: we simply never wait)
+    let h = timeout_start(current_task(), 3_600 * 1_000_000_000)
+        @test timeout_cancel(h) == 1
+    end
+
+    # arm-then-expire: the wheel schedules the task, nothing else wakes it;
+    # the cancel that releases the handle afterwards reports that it lost
+    let h = timeout_start(current_task(), 10_000_000)
+        wait()
+        @test timeout_cancel(h) == 0
+    end
+
+    # cancels racing expiries across threads: the handle arbitration lets
+    # exactly one of the two sides make each task runnable
+    let n = 1000
+        ready = Channel{Nothing}(n)
+        woken = Threads.Atomic{Int}(0)
+        tasks = [Threads.@spawn(begin
+                     put!(ready, nothing)
+                     wait()
+                     Threads.atomic_add!(woken, 1)
+                 end) for _ in 1:n]
+        foreach(_ -> take!(ready), 1:n)
+        handles = [timeout_start(t, rand(0:2_000_000)) for t in tasks]
+        canceller = Threads.@spawn begin
+            nwon = 0
+            for (t, h) in zip(tasks, handles)
+                if timeout_cancel(h) == 1
+                    # the entry was unlinked before it could fire; waking the
+                    # task is now our job
+                    schedule(t)
+                    nwon += 1
+                end
+            end
+            nwon
+        end
+        @test 0 <= fetch(canceller) <= n
+        foreach(wait, tasks)
+        @test woken[] == n
+    end
+end
 end # main testset